@@ -26,7 +26,7 @@
 
 // Version number for shader translation API.
 // It is incremented every time the API changes.
-#define ANGLE_SH_VERSION 245
+#define ANGLE_SH_VERSION 246
 
 enum ShShaderSpec
 {
@@ -348,6 +348,11 @@ const ShCompileOptions SH_FORCE_SHADER_PRECISION_HIGHP_TO_MEDIUMP = UINT64_C(1)
 // Allow compiler to use specialization constant to do pre-rotation and y flip.
 const ShCompileOptions SH_USE_ROTATION_SPECIALIZATION_CONSTANT = UINT64_C(1) << 58;
 
+// Adds the index of the draw within a multi-draw indirect command to the emulated gl_DrawID, so
+// multi-draws can be issued as a single indirect draw.  Currently only implemented for the Vulkan
+// backend, where it requires the SPIR-V DrawParameters capability.
+const ShCompileOptions SH_ADD_DRAW_INDEX_TO_DRAW_ID = UINT64_C(1) << 59;
+
 // Defines alternate strategies for implementing array index clamping.
 enum ShArrayIndexClampingStrategy
 {
@@ -98,6 +98,12 @@ struct FeaturesVk : FeatureSetBase
         "Some drivers have an issue with creating single-layer views on cube map textures",
         &members};
 
+    // Whether glGenerateMipmap should always be done on the CPU, even if the format supports the
+    // compute or blit paths.  Used to test and benchmark the CPU fallback.
+    Feature forceCPUPathForGenerateMipmap = {
+        "forceCPUPathForGenerateMipmap", FeatureCategory::VulkanWorkarounds,
+        "Generate mipmaps on the CPU even if the GPU could do it", &members};
+
     // Whether the VkDevice supports the VK_ANDROID_external_memory_android_hardware_buffer
     // extension, on which the EGL_ANDROID_image_native_buffer extension can be layered.
     Feature supportsAndroidHardwareBuffer = {
@@ -166,6 +172,18 @@ struct FeaturesVk : FeatureSetBase
                                       "VkDevice supports the imageCubeArray feature properly",
                                       &members, "http://anglebug.com/3584"};
 
+    // Whether the VkDevice supports the multiDrawIndirect feature, which is used to turn
+    // ANGLE_multi_draw calls into a single indirect draw.
+    Feature supportsMultiDrawIndirect = {
+        "supportsMultiDrawIndirect", FeatureCategory::VulkanFeatures,
+        "VkDevice supports the multiDrawIndirect feature", &members};
+
+    // Whether the VkDevice supports the VK_KHR_shader_draw_parameters extension, which is used to
+    // read gl_DrawID from the index of the draw in a multi-draw indirect command.
+    Feature supportsShaderDrawParameters = {
+        "supportsShaderDrawParameters", FeatureCategory::VulkanFeatures,
+        "VkDevice supports the VK_KHR_shader_draw_parameters extension", &members};
+
     // Whether the VkDevice supports the VK_EXT_shader_stencil_export extension, which is used to
     // perform multisampled resolve of stencil buffer.  A multi-step workaround is used instead if
     // this extension is not available.
@@ -398,6 +416,41 @@ struct FeaturesVk : FeatureSetBase
         "that support VK_KHR_image_format_list",
         &members, "http://anglebug.com/5281"};
 
+    // Whether the VkDevice supports the VK_KHR_imageless_framebuffer extension.  If so, framebuffer
+    // objects create VkFramebuffers that are independent of the attachments' image views, which are
+    // instead provided when the render pass begins.
+    Feature supportsImagelessFramebuffer = {
+        "supportsImagelessFramebuffer", FeatureCategory::VulkanFeatures,
+        "VkDevice supports the VK_KHR_imageless_framebuffer extension", &members};
+
+    // Whether the VkDevice supports the VK_EXT_extended_dynamic_state extension.  If so, cull
+    // mode, front face, primitive topology and depth/stencil test state are set through the
+    // command buffer instead of being part of the graphics pipeline description.
+    Feature supportsExtendedDynamicState = {
+        "supportsExtendedDynamicState", FeatureCategory::VulkanFeatures,
+        "VkDevice supports the VK_EXT_extended_dynamic_state extension", &members};
+
+    // Create graphics pipelines with VK_PIPELINE_CREATE_DISABLE_OPTIMIZATION_BIT on the draw path
+    // so that first use is cheap, and replace them with fully optimized pipelines compiled on a
+    // worker thread.
+    Feature asyncGraphicsPipelineOptimization = {
+        "asyncGraphicsPipelineOptimization", FeatureCategory::VulkanFeatures,
+        "Create unoptimized graphics pipelines on first use and optimize them on a worker thread",
+        &members};
+
+    // When a program is first drawn with a new surface rotation, create the pipelines it was drawn
+    // with under the previous rotation for the new one on a worker thread.
+    Feature prespecializeGraphicsPipelines = {
+        "prespecializeGraphicsPipelines", FeatureCategory::VulkanFeatures,
+        "Create the graphics pipelines for a program's new surface rotation on a worker thread",
+        &members};
+
+    // Run spirv-opt over the SPIR-V of linked programs.  The optimized SPIR-V is stored in the
+    // program binary, so it ends up in the blob cache along with the rest of the program.
+    Feature optimizeSpirv = {
+        "optimizeSpirv", FeatureCategory::VulkanFeatures,
+        "Optimize the SPIR-V of linked programs with spirv-opt on a worker thread", &members};
+
     // Swiftshader on mac fails to initialize WebGL context when EXT_multisampled_render_to_texture
     // is used by Chromium.
     // http://anglebug.com/4937
@@ -472,6 +525,21 @@ struct FeaturesVk : FeatureSetBase
         "exposeNonConformantExtensionsAndVersions", FeatureCategory::VulkanWorkarounds,
         "Expose GLES versions and extensions that are not conformant.", &members,
         "http://anglebug.com/5375"};
+
+    // Whether default uniform blocks that fit in maxPushConstantsSize are delivered with
+    // vkCmdPushConstants instead of being copied into a dynamic uniform buffer on every update.
+    Feature useDefaultUniformPushConstants = {
+        "useDefaultUniformPushConstants", FeatureCategory::VulkanFeatures,
+        "Use push constants for default uniform blocks that fit in maxPushConstantsSize",
+        &members};
+
+    // Whether ETC1, ETC2 and EAC textures that are emulated with uncompressed formats are staged as
+    // compressed blocks and decoded in a compute shader, instead of being decoded on the CPU.
+    Feature transcodeEtcWithCompute = {
+        "transcodeEtcWithCompute", FeatureCategory::VulkanFeatures,
+        "Decode ETC1, ETC2 and EAC textures that are emulated with uncompressed formats in a "
+        "compute shader",
+        &members};
 };
 
 inline FeaturesVk::FeaturesVk()  = default;
@@ -135,9 +135,8 @@ def gen_libegl_loader():
     write_source(data_source_name, all_cmds, "egl", path, prefix="EGL_")
 
 
-def gen_gles_loader(gles_preamble, path, header_lib, export, internal_prefix, file_prefix):
+def get_gles_commands():
 
-    data_source_name = "gl.xml and gl_angle_ext.xml"
     xml = registry_xml.RegistryXML("gl.xml", "gl_angle_ext.xml")
 
     # First run through the main GLES entry points.  Since ES2+ is the primary use
@@ -164,6 +163,14 @@ def gen_gles_loader(gles_preamble, path, header_lib, export, internal_prefix, fi
     # Ensure there are no duplicates
     assert (len(all_cmds) == len(set(all_cmds))), "Duplicate command names found"
 
+    return all_cmds
+
+
+def gen_gles_loader(gles_preamble, path, header_lib, export, internal_prefix, file_prefix):
+
+    data_source_name = "gl.xml and gl_angle_ext.xml"
+    all_cmds = get_gles_commands()
+
     write_header(
         data_source_name,
         all_cmds,
@@ -237,6 +244,35 @@ def gen_trace_gles_and_egl_loaders():
     gen_egl_loader(trace_egl_preamble, path, lib, export, "t_", "trace_")
 
 
+def gen_util_trace_interpreter_invokers():
+
+    data_source_name = "gl.xml and gl_angle_ext.xml"
+
+    # Captures never record the explicit context entry points.
+    all_cmds = [cmd for cmd in get_gles_commands() if not cmd.endswith("ContextANGLE")]
+
+    path = os.path.join("..", "util")
+    source_path = registry_xml.path_to(path, "trace_interpreter_autogen.cpp")
+
+    def invoker(cmd):
+        entry = "    {\"%s\", &TraceInvoker<PFN%sPROC>::Invoke}," % (cmd, cmd.upper())
+        if len(entry) <= 100:
+            return entry
+        return "    {\"%s\",\n     &TraceInvoker<PFN%sPROC>::Invoke}," % (cmd, cmd.upper())
+
+    # Sorted so the table can be binary searched.
+    invokers = [invoker(cmd) for cmd in sorted(all_cmds)]
+
+    with open(source_path, "w") as out:
+        out.write(
+            template_trace_interpreter_cpp.format(
+                script_name=os.path.basename(sys.argv[0]),
+                data_source_name=data_source_name,
+                year=date.today().year,
+                invokers="\n".join(invokers)))
+        out.close()
+
+
 def gen_util_wgl_loader():
 
     supported_wgl_extensions = [
@@ -284,6 +320,7 @@ def main():
             '../util/egl_loader_autogen.h',
             '../util/gles_loader_autogen.cpp',
             '../util/gles_loader_autogen.h',
+            '../util/trace_interpreter_autogen.cpp',
             '../util/windows/wgl_loader_autogen.cpp',
             '../util/windows/wgl_loader_autogen.h',
             '../src/tests/restricted_traces/trace_egl_loader_autogen.cpp',
@@ -303,6 +340,7 @@ def main():
 
     gen_libegl_loader()
     gen_util_gles_and_egl_loaders()
+    gen_util_trace_interpreter_invokers()
     gen_util_wgl_loader()
     gen_trace_gles_and_egl_loaders()
     return 0
@@ -400,5 +438,54 @@ void {load_fn_name}(LoadProc loadProc)
 }}  // namespace angle
 """
 
+
+template_trace_interpreter_cpp = """// GENERATED FILE - DO NOT EDIT.
+// Generated by {script_name} using data from {data_source_name}.
+//
+// Copyright {year} The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// trace_interpreter_autogen.cpp:
+//   Typed invokers for the GLES entry points replayed by TraceInterpreter.
+
+#include "util/trace_interpreter.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace angle
+{{
+namespace
+{{
+struct TraceInvokerEntry
+{{
+    const char *name;
+    TraceInvokeFunc invoke;
+}};
+
+constexpr TraceInvokerEntry kTraceInvokers[] = {{
+{invokers}
+}};
+
+bool CompareInvokerName(const TraceInvokerEntry &entry, const char *name)
+{{
+    return strcmp(entry.name, name) < 0;
+}}
+}}  // anonymous namespace
+
+TraceInvokeFunc GetTraceInvokeFunc(const char *functionName)
+{{
+    auto iter = std::lower_bound(std::begin(kTraceInvokers), std::end(kTraceInvokers),
+                                 functionName, CompareInvokerName);
+    if (iter == std::end(kTraceInvokers) || strcmp(iter->name, functionName) != 0)
+    {{
+        return nullptr;
+    }}
+    return iter->invoke;
+}}
+}}  // namespace angle
+"""
+
 if __name__ == '__main__':
     sys.exit(main())
@@ -9,6 +9,7 @@
 
 #include "common/PoolAlloc.h"
 
+#include <algorithm>
 #include <assert.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -32,6 +33,7 @@ PoolAllocator::PoolAllocator(int growthIncrement, int allocationAlignment)
       mPageSize(growthIncrement),
       mFreeList(0),
       mInUseList(0),
+      mMaxPageSize(0),
       mNumCalls(0),
       mTotalBytes(0),
 #endif
@@ -148,7 +150,7 @@ void Allocation::checkGuardBlock(unsigned char *blockMem,
 void PoolAllocator::push()
 {
 #if !defined(ANGLE_DISABLE_POOL_ALLOC)
-    AllocState state = {mCurrentPageOffset, mInUseList};
+    AllocState state = {mCurrentPageOffset, mInUseList, mPageSize};
 
     mStack.push_back(state);
 
@@ -176,6 +178,7 @@ void PoolAllocator::pop()
 #if !defined(ANGLE_DISABLE_POOL_ALLOC)
     Header *page       = mStack.back().page;
     mCurrentPageOffset = mStack.back().offset;
+    size_t scopeBytes  = 0;
 
     while (mInUseList != page)
     {
@@ -183,7 +186,8 @@ void PoolAllocator::pop()
         mInUseList->~Header();
 
         Header *nextInUse = mInUseList->nextPage;
-        if (mInUseList->pageCount > 1)
+        scopeBytes += mInUseList->size;
+        if (mInUseList->pageCount > 1 || mInUseList->size != mPageSize)
             delete[] reinterpret_cast<char *>(mInUseList);
         else
         {
@@ -193,7 +197,15 @@ void PoolAllocator::pop()
         mInUseList = nextInUse;
     }
 
+    // If a nested scope grew the page size, the restored offset refers to a page of the old size
+    // (or to no page at all), so make the next allocation come from a new page.
+    if (mStack.back().pageSize != mPageSize)
+    {
+        mCurrentPageOffset = mPageSize;
+    }
+
     mStack.pop_back();
+    adaptPageSize(scopeBytes);
 #else  // !defined(ANGLE_DISABLE_POOL_ALLOC)
     for (auto &alloc : mStack.back())
     {
@@ -229,6 +241,24 @@ void *PoolAllocator::allocate(size_t numBytes)
     // much memory the caller asked for.  allocationSize is the total
     // size including guard blocks.  In release build,
     // kGuardBlockSize=0 and this all gets optimized away.
+#    if !defined(ANGLE_POOL_ALLOC_GUARD_BLOCKS)
+    //
+    // Without guard blocks there is no per-allocation bookkeeping, so the common case is a
+    // plain aligned bump of the current page offset.
+    //
+    if (mInUseList != nullptr && mCurrentPageOffset < mPageSize)
+    {
+        uintptr_t pageBase   = reinterpret_cast<uintptr_t>(mInUseList);
+        uintptr_t aligned    = (pageBase + mCurrentPageOffset + mAlignmentMask) & ~mAlignmentMask;
+        size_t alignedOffset = aligned - pageBase;
+        if (alignedOffset <= mPageSize && numBytes <= mPageSize - alignedOffset)
+        {
+            mCurrentPageOffset = alignedOffset + numBytes;
+            return reinterpret_cast<void *>(aligned);
+        }
+    }
+#    endif
+
     size_t allocationSize = Allocation::AllocationSize(numBytes) + mAlignment;
     // Detect integer overflow.
     if (allocationSize < numBytes)
@@ -266,7 +296,8 @@ void *PoolAllocator::allocate(size_t numBytes)
             return 0;
 
         // Use placement-new to initialize header
-        new (memory) Header(mInUseList, (numBytesToAlloc + mPageSize - 1) / mPageSize);
+        new (memory)
+            Header(mInUseList, (numBytesToAlloc + mPageSize - 1) / mPageSize, numBytesToAlloc);
         mInUseList = memory;
 
         mCurrentPageOffset = mPageSize;  // make next allocation come from a new page
@@ -295,28 +326,74 @@ void *PoolAllocator::allocateNewPage(size_t numBytes, size_t allocationSize)
     //
     // Need a simple page to allocate from.
     //
-    Header *memory;
-    if (mFreeList)
+    Header *memory = nullptr;
+    while (mFreeList && !memory)
     {
-        memory    = mFreeList;
-        mFreeList = mFreeList->nextPage;
+        Header *page = mFreeList;
+        mFreeList    = mFreeList->nextPage;
+        // Pages left over from before the page size grew are not reused.
+        if (page->size == mPageSize)
+            memory = page;
+        else
+            delete[] reinterpret_cast<char *>(page);
     }
-    else
+    if (!memory)
     {
         memory = reinterpret_cast<Header *>(::new char[mPageSize]);
         if (memory == 0)
             return 0;
     }
     // Use placement-new to initialize header
-    new (memory) Header(mInUseList, 1);
+    new (memory) Header(mInUseList, 1, mPageSize);
     mInUseList = memory;
 
     unsigned char *ret = reinterpret_cast<unsigned char *>(mInUseList) + mHeaderSkip;
     mCurrentPageOffset = (mHeaderSkip + allocationSize + mAlignmentMask) & ~mAlignmentMask;
     return ret;
 }
+
+void PoolAllocator::adaptPageSize(size_t scopeBytes)
+{
+    // A scope is considered large when it needed more than this many pages.  The page size is
+    // grown so that a scope of the same footprint would fit in about that many pages.
+    constexpr size_t kAdaptivePageCount = 16;
+
+    if (mMaxPageSize <= mPageSize || scopeBytes <= mPageSize * kAdaptivePageCount)
+    {
+        return;
+    }
+
+    size_t newPageSize = gl::ceilPow2(static_cast<unsigned int>(scopeBytes / kAdaptivePageCount));
+    newPageSize        = std::min(newPageSize, mMaxPageSize);
+    if (newPageSize <= mPageSize)
+    {
+        return;
+    }
+
+    // The restored current page, if any, is smaller than the new page size.  Make the next
+    // allocation come from a new page; stale pages on the free list are released lazily.
+    mPageSize          = newPageSize;
+    mCurrentPageOffset = mPageSize;
+}
 #endif
 
+void PoolAllocator::enableAdaptivePageSize(size_t maxPageSize)
+{
+#if !defined(ANGLE_DISABLE_POOL_ALLOC)
+    ASSERT(mAlignment != 1);
+    mMaxPageSize = maxPageSize;
+#endif
+}
+
+size_t PoolAllocator::getPageSize() const
+{
+#if !defined(ANGLE_DISABLE_POOL_ALLOC)
+    return mPageSize;
+#else
+    return 0;
+#endif
+}
+
 void PoolAllocator::lock()
 {
     ASSERT(!mLocked);
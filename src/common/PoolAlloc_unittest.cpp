@@ -50,6 +50,113 @@ TEST(PoolAllocatorTest, Interface)
     poolAllocator.popAll();
 }
 
+#if !defined(ANGLE_DISABLE_POOL_ALLOC)
+// Verify the page size grows after a large push/pop scope and that the memory remains usable
+TEST(PoolAllocatorTest, AdaptivePageSize)
+{
+    constexpr size_t kMaxPageSize = 64 * 1024;
+    PoolAllocator poolAllocator(4096);
+    poolAllocator.enableAdaptivePageSize(kMaxPageSize);
+    EXPECT_EQ(4096u, poolAllocator.getPageSize());
+
+    void *persistent = poolAllocator.allocate(64);
+    memset(persistent, 0x5a, 64);
+
+    // A small scope doesn't change the page size.
+    poolAllocator.push();
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        memset(poolAllocator.allocate(256), 0xb8, 256);
+    }
+    poolAllocator.pop();
+    EXPECT_EQ(4096u, poolAllocator.getPageSize());
+
+    // A scope spanning many pages grows it, but never past the maximum.
+    for (uint32_t iteration = 0; iteration < 3; ++iteration)
+    {
+        poolAllocator.push();
+        for (uint32_t i = 0; i < 4096; ++i)
+        {
+            void *allocation = poolAllocator.allocate(256);
+            EXPECT_NE(nullptr, allocation);
+            memset(allocation, 0xb8, 256);
+        }
+        poolAllocator.pop();
+        EXPECT_GT(poolAllocator.getPageSize(), 4096u);
+        EXPECT_LE(poolAllocator.getPageSize(), kMaxPageSize);
+    }
+
+    // Memory allocated before the page size changed is untouched.
+    const uint8_t *bytes = static_cast<const uint8_t *>(persistent);
+    for (size_t i = 0; i < 64; ++i)
+    {
+        EXPECT_EQ(0x5a, bytes[i]);
+    }
+    poolAllocator.popAll();
+}
+
+// Verify that an outer scope keeps allocating correctly after a nested scope grew the page size
+TEST(PoolAllocatorTest, AdaptivePageSizeNestedScopes)
+{
+    constexpr size_t kMaxPageSize = 64 * 1024;
+    PoolAllocator poolAllocator(4096);
+    poolAllocator.enableAdaptivePageSize(kMaxPageSize);
+
+    poolAllocator.push();
+    void *outer = poolAllocator.allocate(16);
+    memset(outer, 0x5a, 16);
+
+    // The nested scope spans many pages, so popping it grows the page size.
+    poolAllocator.push();
+    for (uint32_t i = 0; i < 4096; ++i)
+    {
+        memset(poolAllocator.allocate(256), 0xb8, 256);
+    }
+    poolAllocator.pop();
+    EXPECT_GT(poolAllocator.getPageSize(), 4096u);
+
+    void *afterInnerPop = poolAllocator.allocate(256);
+    ASSERT_NE(nullptr, afterInnerPop);
+    memset(afterInnerPop, 0xc3, 256);
+
+    // The outer scope started without a current page; allocations after popping it must come from
+    // a page of the new size.
+    poolAllocator.pop();
+    for (uint32_t i = 0; i < 64; ++i)
+    {
+        void *allocation = poolAllocator.allocate(1024);
+        ASSERT_NE(nullptr, allocation);
+        memset(allocation, 0xd4, 1024);
+    }
+
+    // The same when the outer scope was pushed with a current page.
+    void *persistent = poolAllocator.allocate(64);
+    memset(persistent, 0x5a, 64);
+    poolAllocator.push();
+    poolAllocator.allocate(16);
+    poolAllocator.push();
+    for (uint32_t i = 0; i < 16384; ++i)
+    {
+        memset(poolAllocator.allocate(256), 0xb8, 256);
+    }
+    poolAllocator.pop();
+    poolAllocator.pop();
+    for (uint32_t i = 0; i < 64; ++i)
+    {
+        void *allocation = poolAllocator.allocate(1024);
+        ASSERT_NE(nullptr, allocation);
+        memset(allocation, 0xd4, 1024);
+    }
+
+    const uint8_t *bytes = static_cast<const uint8_t *>(persistent);
+    for (size_t i = 0; i < 64; ++i)
+    {
+        EXPECT_EQ(0x5a, bytes[i]);
+    }
+    poolAllocator.popAll();
+}
+#endif
+
 #if !defined(ANGLE_POOL_ALLOC_GUARD_BLOCKS)
 // Verify allocations are correctly aligned for different alignments
 class PoolAllocatorAlignmentTest : public testing::TestWithParam<int>
@@ -0,0 +1,157 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// frame_capture_binary_format.h:
+//   Layout of the binary call streams written by FrameCapture and consumed by the trace
+//   interpreter in util/. A capture produces one index file ("<prefix>.angletrace") and one call
+//   stream per frame ("<prefix>_frameNNN.anglecalls", gzipped when compression is enabled).
+//
+//   A call stream is laid out as:
+//     BinaryTraceHeader
+//     uint64_t functionNameOffsets[functionCount]  (offsets into the data section)
+//     BinaryTraceCall calls[callCount]
+//     BinaryTraceParam params[paramCount]          (the params of each call, in call order)
+//     uint8_t data[dataSize]                       (aligned to kBinaryTraceDataAlignment)
+//
+//   Everything is stored in host byte order. Scalar values are stored in the low bytes of a
+//   64-bit slot, exactly as they are passed to the GL entry point.
+
+#ifndef COMMON_FRAME_CAPTURE_BINARY_FORMAT_H_
+#define COMMON_FRAME_CAPTURE_BINARY_FORMAT_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace angle
+{
+constexpr uint32_t kBinaryTraceIndexMagic  = 0x49474E41;  // "ANGI"
+constexpr uint32_t kBinaryTraceStreamMagic = 0x53474E41;  // "ANGS"
+constexpr uint32_t kBinaryTraceVersion     = 1;
+
+constexpr char kBinaryTraceIndexExtension[]  = ".angletrace";
+constexpr char kBinaryTraceStreamExtension[] = ".anglecalls";
+
+// Upper bound on the number of resource ID namespaces (buffers, textures, ...) in a trace.
+constexpr uint32_t kBinaryTraceMaxResourceTypes = 16;
+
+// Upper bound on the number of parameters of a single call.
+constexpr uint32_t kBinaryTraceMaxParams = 16;
+
+// Data section entries are aligned to this many bytes.
+constexpr size_t kBinaryTraceDataAlignment = 16;
+
+// Helper calls that don't correspond to a GL entry point. The function name table stores these
+// names verbatim; the interpreter implements them natively.
+constexpr char kBinaryTraceUpdateResourceID[]       = "UpdateResourceID";
+constexpr char kBinaryTraceUpdateUniformLocation[]  = "UpdateUniformLocation";
+constexpr char kBinaryTraceDeleteUniformLocations[] = "DeleteUniformLocations";
+constexpr char kBinaryTraceUpdateCurrentProgram[]   = "UpdateCurrentProgram";
+constexpr char kBinaryTraceUpdateClientArray[]      = "UpdateClientArrayPointer";
+constexpr char kBinaryTraceUpdateClientBuffer[]     = "UpdateClientBufferData";
+
+enum class BinaryTraceSection : uint32_t
+{
+    Setup,
+    Frame,
+    Reset,
+
+    EnumCount,
+};
+
+enum class BinaryTraceParamKind : uint8_t
+{
+    // |value| is passed through unchanged.
+    Value,
+    // |value| is an offset into the data section. Passed as a pointer.
+    Data,
+    // |value| is the offset of |count| uint64_t data offsets, one per string. Passed as a
+    // pointer to an array of string pointers.
+    StringArray,
+    // |value| is a captured ID in namespace |resourceType|. Remapped to the replay ID.
+    ResourceID,
+    // |value| is the offset of |count| captured GLuint IDs in namespace |resourceType|. Remapped
+    // into a scratch array that is passed as a pointer.
+    ResourceIDArray,
+    // |value| is a captured GLsync. Remapped to the replay sync object.
+    Sync,
+    // |value| is a captured uniform location. |count| holds the captured program ID in namespace
+    // |resourceType|, or 0 to use the program made current by the last UpdateCurrentProgram call.
+    UniformLocation,
+    // Pointer to the shared read buffer, which must be at least |count| bytes.
+    ReadBuffer,
+    // Pointer to client array |count|.
+    ClientArray,
+
+    InvalidEnum,
+};
+
+enum class BinaryTraceResultKind : uint8_t
+{
+    Unused,
+    // The returned ID is recorded as the replay ID of |resultKey| in |resultType|.
+    ResourceID,
+    // The returned GLsync is recorded as the replay sync for |resultKey|.
+    Sync,
+    // The returned pointer is recorded as the mapping of captured buffer |resultKey|.
+    MappedBuffer,
+};
+
+struct BinaryTraceIndex
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t frameStart;
+    uint32_t frameEnd;
+    uint32_t drawSurfaceWidth;
+    uint32_t drawSurfaceHeight;
+    uint32_t compressed;
+    uint32_t padding;
+};
+
+struct BinaryTraceRange
+{
+    uint32_t firstCall;
+    uint32_t callCount;
+};
+
+struct BinaryTraceHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t frameIndex;
+    uint32_t functionCount;
+    uint32_t callCount;
+    uint32_t paramCount;
+    BinaryTraceRange sections[static_cast<size_t>(BinaryTraceSection::EnumCount)];
+    uint64_t dataSize;
+    // Size of the whole stream, header included.
+    uint64_t totalSize;
+};
+
+struct BinaryTraceCall
+{
+    uint32_t functionIndex;
+    uint16_t paramCount;
+    BinaryTraceResultKind resultKind;
+    uint8_t resultType;
+    uint64_t resultKey;
+};
+
+struct BinaryTraceParam
+{
+    BinaryTraceParamKind kind;
+    uint8_t resourceType;
+    uint16_t padding;
+    uint32_t count;
+    uint64_t value;
+};
+
+static_assert(sizeof(BinaryTraceIndex) == 32, "Unexpected BinaryTraceIndex size");
+static_assert(sizeof(BinaryTraceHeader) == 64, "Unexpected BinaryTraceHeader size");
+static_assert(sizeof(BinaryTraceCall) == 16, "Unexpected BinaryTraceCall size");
+static_assert(sizeof(BinaryTraceParam) == 16, "Unexpected BinaryTraceParam size");
+}  // namespace angle
+
+#endif  // COMMON_FRAME_CAPTURE_BINARY_FORMAT_H_
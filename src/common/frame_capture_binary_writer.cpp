@@ -0,0 +1,168 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// frame_capture_binary_writer.cpp:
+//   Implements the binary call stream writer.
+//
+
+#include "common/frame_capture_binary_writer.h"
+
+#include <cstring>
+
+#include "common/debug.h"
+#include "common/hash_utils.h"
+#include "common/mathutil.h"
+
+namespace angle
+{
+BinaryDataStore::BinaryDataStore() = default;
+
+BinaryDataStore::~BinaryDataStore() = default;
+
+size_t BinaryDataStore::append(const uint8_t *data, size_t size)
+{
+    mAppendedBytes += size;
+
+    // ComputeGenericHash needs a multiple of 4 bytes. The remaining bytes are hashed along with the
+    // size, so blocks that only differ in their last bytes don't all land in the same bucket.
+    size_t alignedSize = size & ~static_cast<size_t>(3);
+    uint32_t tail[2]   = {0, static_cast<uint32_t>(size)};
+    if (size > alignedSize)
+    {
+        memcpy(&tail[0], data + alignedSize, size - alignedSize);
+    }
+    size_t hash = ComputeGenericHash(data, alignedSize) ^ ComputeGenericHash(tail);
+
+    auto range = mOffsetsByHash.equal_range(hash);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+        size_t existingOffset = iter->second;
+        if (existingOffset + size <= mData.size() &&
+            memcmp(mData.data() + existingOffset, data, size) == 0)
+        {
+            mDeduplicatedBytes += size;
+            return existingOffset;
+        }
+    }
+
+    // Round up to 16-byte boundary for cross ABI safety. Call streams use the same alignment.
+    size_t offset = rx::roundUpPow2(mData.size(), kBinaryTraceDataAlignment);
+    mData.resize(offset + size);
+    if (size > 0)
+    {
+        memcpy(mData.data() + offset, data, size);
+    }
+    mOffsetsByHash.emplace(hash, offset);
+    return offset;
+}
+
+void BinaryDataStore::clear()
+{
+    mData.clear();
+    mOffsetsByHash.clear();
+    mAppendedBytes     = 0;
+    mDeduplicatedBytes = 0;
+}
+
+BinaryTraceStreamWriter::BinaryTraceStreamWriter() : mSections{}, mFirstPendingParam(0) {}
+
+BinaryTraceStreamWriter::~BinaryTraceStreamWriter() = default;
+
+void BinaryTraceStreamWriter::beginSection(BinaryTraceSection section)
+{
+    mSections[static_cast<size_t>(section)].firstCall = static_cast<uint32_t>(mCalls.size());
+}
+
+void BinaryTraceStreamWriter::endSection(BinaryTraceSection section)
+{
+    BinaryTraceRange &range = mSections[static_cast<size_t>(section)];
+    range.callCount         = static_cast<uint32_t>(mCalls.size()) - range.firstCall;
+}
+
+void BinaryTraceStreamWriter::addParam(BinaryTraceParamKind kind,
+                                       uint8_t resourceType,
+                                       uint32_t count,
+                                       uint64_t value)
+{
+    BinaryTraceParam param = {};
+    param.kind             = kind;
+    param.resourceType     = resourceType;
+    param.count            = count;
+    param.value            = value;
+    mParams.push_back(param);
+}
+
+void BinaryTraceStreamWriter::addCall(const std::string &functionName,
+                                      BinaryTraceResultKind resultKind,
+                                      uint8_t resultType,
+                                      uint64_t resultKey)
+{
+    ASSERT(getPendingParamCount() <= kBinaryTraceMaxParams);
+
+    BinaryTraceCall call = {};
+    call.functionIndex   = getFunctionIndex(functionName);
+    call.paramCount      = static_cast<uint16_t>(getPendingParamCount());
+    call.resultKind      = resultKind;
+    call.resultType      = resultType;
+    call.resultKey       = resultKey;
+    mCalls.push_back(call);
+
+    mFirstPendingParam = mParams.size();
+}
+
+uint32_t BinaryTraceStreamWriter::getFunctionIndex(const std::string &name)
+{
+    auto iter = mFunctionIndices.find(name);
+    if (iter != mFunctionIndices.end())
+    {
+        return iter->second;
+    }
+
+    uint32_t index = static_cast<uint32_t>(mFunctionNameOffsets.size());
+    mFunctionNameOffsets.push_back(appendData(name.c_str(), name.size() + 1));
+    mFunctionIndices[name] = index;
+    return index;
+}
+
+uint64_t BinaryTraceStreamWriter::appendData(const void *data, size_t size)
+{
+    // Apps often upload the same vertex or texture data repeatedly, which is stored only once.
+    return mData.append(static_cast<const uint8_t *>(data), size);
+}
+
+void BinaryTraceStreamWriter::serialize(uint32_t frameIndex, std::vector<uint8_t> *streamOut) const
+{
+    ASSERT(getPendingParamCount() == 0);
+
+    size_t namesOffset  = sizeof(BinaryTraceHeader);
+    size_t callsOffset  = namesOffset + mFunctionNameOffsets.size() * sizeof(uint64_t);
+    size_t paramsOffset = callsOffset + mCalls.size() * sizeof(BinaryTraceCall);
+    size_t dataOffset   = rx::roundUpPow2(paramsOffset + mParams.size() * sizeof(BinaryTraceParam),
+                                        kBinaryTraceDataAlignment);
+
+    BinaryTraceHeader header = {};
+    header.magic             = kBinaryTraceStreamMagic;
+    header.version           = kBinaryTraceVersion;
+    header.frameIndex        = frameIndex;
+    header.functionCount     = static_cast<uint32_t>(mFunctionNameOffsets.size());
+    header.callCount         = static_cast<uint32_t>(mCalls.size());
+    header.paramCount        = static_cast<uint32_t>(mParams.size());
+    memcpy(header.sections, mSections, sizeof(mSections));
+    header.dataSize  = mData.getData().size();
+    header.totalSize = dataOffset + mData.getData().size();
+
+    streamOut->assign(static_cast<size_t>(header.totalSize), 0);
+    uint8_t *stream = streamOut->data();
+    memcpy(stream, &header, sizeof(header));
+    memcpy(stream + namesOffset, mFunctionNameOffsets.data(),
+           mFunctionNameOffsets.size() * sizeof(uint64_t));
+    memcpy(stream + callsOffset, mCalls.data(), mCalls.size() * sizeof(BinaryTraceCall));
+    memcpy(stream + paramsOffset, mParams.data(), mParams.size() * sizeof(BinaryTraceParam));
+    if (!mData.empty())
+    {
+        memcpy(stream + dataOffset, mData.getData().data(), mData.getData().size());
+    }
+}
+}  // namespace angle
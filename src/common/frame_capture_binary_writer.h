@@ -0,0 +1,95 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// frame_capture_binary_writer.h:
+//   Builds the binary call streams described in frame_capture_binary_format.h and the binary data
+//   file of the C++ replay. FrameCapture translates captured calls into the stream writer's calls
+//   and params; the writers don't know about GL.
+//
+
+#ifndef COMMON_FRAME_CAPTURE_BINARY_WRITER_H_
+#define COMMON_FRAME_CAPTURE_BINARY_WRITER_H_
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/angleutils.h"
+#include "common/frame_capture_binary_format.h"
+
+namespace angle
+{
+// The binary data file referenced by the C++ replay, or the data section of a call stream. Blocks
+// are content-addressed: a block whose contents were already stored is not stored again and the
+// replay refers to the existing copy by its offset. Re-uploaded atlases and repeated vertex streams
+// are common in captured content.
+class BinaryDataStore final : angle::NonCopyable
+{
+  public:
+    BinaryDataStore();
+    ~BinaryDataStore();
+
+    // Returns the offset of a block with the given contents, storing it if it's new.
+    size_t append(const uint8_t *data, size_t size);
+
+    const std::vector<uint8_t> &getData() const { return mData; }
+    bool empty() const { return mData.empty(); }
+
+    // Drops the data and the statistics, so a new capture starts from scratch.
+    void clear();
+
+    // Bytes passed to append() and bytes that didn't need storing since the last clear(). Used for
+    // capture reporting.
+    uint64_t getAppendedBytes() const { return mAppendedBytes; }
+    uint64_t getDeduplicatedBytes() const { return mDeduplicatedBytes; }
+
+  private:
+    std::vector<uint8_t> mData;
+    std::unordered_multimap<size_t, size_t> mOffsetsByHash;
+    uint64_t mAppendedBytes     = 0;
+    uint64_t mDeduplicatedBytes = 0;
+};
+
+class BinaryTraceStreamWriter final : angle::NonCopyable
+{
+  public:
+    BinaryTraceStreamWriter();
+    ~BinaryTraceStreamWriter();
+
+    // Calls added between these go in |section|.
+    void beginSection(BinaryTraceSection section);
+    void endSection(BinaryTraceSection section);
+
+    // Params are added before the call that takes them.
+    void addParam(BinaryTraceParamKind kind, uint8_t resourceType, uint32_t count, uint64_t value);
+    size_t getPendingParamCount() const { return mParams.size() - mFirstPendingParam; }
+
+    // Adds a call to |functionName| that takes the params added since the previous call.
+    void addCall(const std::string &functionName,
+                 BinaryTraceResultKind resultKind,
+                 uint8_t resultType,
+                 uint64_t resultKey);
+
+    // Returns the offset of |data| in the data section.
+    uint64_t appendData(const void *data, size_t size);
+    const BinaryDataStore &getData() const { return mData; }
+
+    void serialize(uint32_t frameIndex, std::vector<uint8_t> *streamOut) const;
+
+  private:
+    uint32_t getFunctionIndex(const std::string &name);
+
+    BinaryTraceRange mSections[static_cast<size_t>(BinaryTraceSection::EnumCount)];
+    std::vector<BinaryTraceCall> mCalls;
+    std::vector<BinaryTraceParam> mParams;
+    size_t mFirstPendingParam;
+    std::vector<uint64_t> mFunctionNameOffsets;
+    std::map<std::string, uint32_t> mFunctionIndices;
+    BinaryDataStore mData;
+};
+}  // namespace angle
+
+#endif  // COMMON_FRAME_CAPTURE_BINARY_WRITER_H_
@@ -0,0 +1,135 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// frame_capture_binary_writer_unittest:
+//   Tests of the deduplicated binary data and call streams written by frame capture.
+//
+
+#include <gtest/gtest.h>
+
+#include "common/frame_capture_binary_writer.h"
+
+namespace angle
+{
+namespace
+{
+std::vector<uint8_t> MakeBlock(size_t size, uint8_t seed)
+{
+    std::vector<uint8_t> block(size);
+    for (size_t index = 0; index < size; ++index)
+    {
+        block[index] = static_cast<uint8_t>(seed + index * 7);
+    }
+    return block;
+}
+
+// Tests repeated blocks are stored once and counted as deduplicated.
+TEST(BinaryDataStoreTest, RepeatedBlocks)
+{
+    const std::vector<uint8_t> blockA = MakeBlock(256, 1);
+    const std::vector<uint8_t> blockB = MakeBlock(100, 2);
+
+    BinaryDataStore store;
+    size_t offsetA = store.append(blockA.data(), blockA.size());
+    size_t offsetB = store.append(blockB.data(), blockB.size());
+    EXPECT_EQ(offsetA, store.append(blockA.data(), blockA.size()));
+    EXPECT_EQ(offsetB, store.append(blockB.data(), blockB.size()));
+    EXPECT_NE(offsetA, offsetB);
+    EXPECT_EQ(0u, offsetB % 16);
+
+    EXPECT_EQ(2 * (blockA.size() + blockB.size()), store.getAppendedBytes());
+    EXPECT_EQ(blockA.size() + blockB.size(), store.getDeduplicatedBytes());
+    EXPECT_EQ(0, memcmp(store.getData().data() + offsetA, blockA.data(), blockA.size()));
+    EXPECT_EQ(0, memcmp(store.getData().data() + offsetB, blockB.data(), blockB.size()));
+}
+
+// Tests the statistics only cover the data appended since the last clear, so each capture reports
+// its own savings.
+TEST(BinaryDataStoreTest, CountsAfterClear)
+{
+    const std::vector<uint8_t> block = MakeBlock(256, 3);
+
+    BinaryDataStore store;
+    store.append(block.data(), block.size());
+    store.append(block.data(), block.size());
+    store.append(block.data(), block.size());
+    EXPECT_EQ(3 * block.size(), store.getAppendedBytes());
+    EXPECT_EQ(2 * block.size(), store.getDeduplicatedBytes());
+
+    store.clear();
+    EXPECT_TRUE(store.empty());
+    EXPECT_EQ(0u, store.getAppendedBytes());
+    EXPECT_EQ(0u, store.getDeduplicatedBytes());
+
+    // The block was dropped with the data, so it is stored again rather than deduplicated.
+    EXPECT_EQ(0u, store.append(block.data(), block.size()));
+    EXPECT_EQ(block.size(), store.getAppendedBytes());
+    EXPECT_EQ(0u, store.getDeduplicatedBytes());
+    EXPECT_EQ(block.size(), store.getData().size());
+
+    store.append(block.data(), block.size());
+    EXPECT_EQ(2 * block.size(), store.getAppendedBytes());
+    EXPECT_EQ(block.size(), store.getDeduplicatedBytes());
+}
+
+// Tests blocks that aren't a multiple of 4 bytes, down to single bytes, are told apart by their
+// last bytes.
+TEST(BinaryDataStoreTest, UnalignedBlocks)
+{
+    BinaryDataStore store;
+    std::vector<size_t> offsets;
+    for (size_t size : {1, 2, 3, 5, 7})
+    {
+        for (uint8_t last : {0, 1})
+        {
+            std::vector<uint8_t> block(size, 0xAB);
+            block.back() = last;
+            offsets.push_back(store.append(block.data(), block.size()));
+        }
+    }
+
+    for (size_t first = 0; first < offsets.size(); ++first)
+    {
+        for (size_t second = first + 1; second < offsets.size(); ++second)
+        {
+            EXPECT_NE(offsets[first], offsets[second]);
+        }
+    }
+    EXPECT_EQ(0u, store.getDeduplicatedBytes());
+
+    const uint8_t repeated[3] = {0xAB, 0xAB, 1};
+    EXPECT_EQ(offsets[5], store.append(repeated, sizeof(repeated)));
+    EXPECT_EQ(sizeof(repeated), store.getDeduplicatedBytes());
+}
+
+// Tests the call stream data section is deduplicated like the C++ replay's data file.
+TEST(BinaryTraceStreamWriterTest, DeduplicatesData)
+{
+    const std::vector<uint8_t> block = MakeBlock(64, 4);
+
+    BinaryTraceStreamWriter writer;
+    writer.beginSection(BinaryTraceSection::Frame);
+    for (int draw = 0; draw < 3; ++draw)
+    {
+        writer.addParam(BinaryTraceParamKind::Data, 0, 0,
+                        writer.appendData(block.data(), block.size()));
+        writer.addCall("glBufferSubData", BinaryTraceResultKind::Unused, 0, 0);
+    }
+    writer.endSection(BinaryTraceSection::Frame);
+
+    // The function name and the block are stored once each.
+    EXPECT_EQ(2 * block.size(), writer.getData().getDeduplicatedBytes());
+
+    std::vector<uint8_t> stream;
+    writer.serialize(1, &stream);
+    BinaryTraceHeader header;
+    memcpy(&header, stream.data(), sizeof(header));
+    EXPECT_EQ(3u, header.callCount);
+    EXPECT_EQ(3u, header.paramCount);
+    EXPECT_EQ(writer.getData().getData().size(), header.dataSize);
+    EXPECT_LT(header.dataSize, 2 * block.size());
+}
+}  // anonymous namespace
+}  // namespace angle
@@ -166,6 +166,10 @@ inline bool supportsSSE2()
             supports = (info[3] >> 26) & 1;
         }
     }
+#    elif defined(__GNUC__)
+    // May be called before the CPU model is initialized, from a static initializer.
+    __builtin_cpu_init();
+    supports = __builtin_cpu_supports("sse2");
 #    endif  // defined(ANGLE_PLATFORM_WINDOWS) && !defined(_M_ARM) && !defined(_M_ARM64)
     checked = true;
     return supports;
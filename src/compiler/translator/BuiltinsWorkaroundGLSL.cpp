@@ -19,6 +19,8 @@ namespace
 {
 constexpr const ImmutableString kGlInstanceIDString("gl_InstanceID");
 constexpr const ImmutableString kGlVertexIDString("gl_VertexID");
+constexpr const ImmutableString kGlDrawIDARBString("gl_DrawIDARB");
+constexpr const ImmutableString kEmulatedGLDrawIDString("angle_DrawID");
 
 class TBuiltinsWorkaroundGLSL : public TIntermTraverser
 {
@@ -30,8 +32,10 @@ class TBuiltinsWorkaroundGLSL : public TIntermTraverser
 
   private:
     void ensureVersionIsAtLeast(int version);
+    const TVariable *getDrawIndexVariable();
 
     ShCompileOptions mCompileOptions;
+    const TVariable *mDrawIndex = nullptr;
 
     bool isBaseInstanceDeclared = false;
     bool isBaseVertexDeclared   = false;
@@ -71,6 +75,16 @@ void TBuiltinsWorkaroundGLSL::visitSymbol(TIntermSymbol *node)
             queueReplacement(vertexIndexRef, OriginalNode::IS_DROPPED);
         }
     }
+    else if ((mCompileOptions & SH_ADD_DRAW_INDEX_TO_DRAW_ID) != 0 &&
+             node->variable().symbolType() == SymbolType::AngleInternal &&
+             node->getName() == kEmulatedGLDrawIDString)
+    {
+        // Multi-draws issued as separate draws set angle_DrawID, while those issued as a single
+        // indirect draw leave it at zero and get the draw's index from gl_DrawIDARB.
+        TIntermSymbol *drawIndexRef = new TIntermSymbol(getDrawIndexVariable());
+        TIntermBinary *addDrawIndex = new TIntermBinary(EOpAdd, node, drawIndexRef);
+        queueReplacement(addDrawIndex, OriginalNode::BECOMES_CHILD);
+    }
 }
 
 bool TBuiltinsWorkaroundGLSL::visitDeclaration(Visit, TIntermDeclaration *node)
@@ -87,11 +101,28 @@ bool TBuiltinsWorkaroundGLSL::visitDeclaration(Visit, TIntermDeclaration *node)
             {
                 isBaseInstanceDeclared = true;
             }
+            else if (variable->getName() == kEmulatedGLDrawIDString)
+            {
+                // Keep the declaration of angle_DrawID as is.
+                return false;
+            }
         }
     }
     return true;
 }
 
+const TVariable *TBuiltinsWorkaroundGLSL::getDrawIndexVariable()
+{
+    if (mDrawIndex == nullptr)
+    {
+        // gl_DrawID of GL_ARB_shader_draw_parameters, i.e. the DrawIndex builtin in SPIR-V.
+        mDrawIndex = new TVariable(mSymbolTable, kGlDrawIDARBString,
+                                   StaticType::Get<EbtInt, EbpHigh, EvqDrawID, 1, 1>(),
+                                   SymbolType::BuiltIn);
+    }
+    return mDrawIndex;
+}
+
 }  // anonymous namespace
 
 ANGLE_NO_DISCARD bool ShaderBuiltinsWorkaround(TCompiler *compiler,
@@ -279,6 +279,11 @@ bool ValidateFragColorAndFragData(GLenum shaderType,
 
 TShHandleBase::TShHandleBase()
 {
+    // Compiling a large shader grows the pool's page size, so that subsequent compiles with this
+    // handle are served from a few large recycled pages instead of many small ones.
+    constexpr size_t kMaxPoolPageSize = 256 * 1024;
+    allocator.enableAdaptivePageSize(kMaxPoolPageSize);
+
     allocator.push();
     SetGlobalPoolAllocator(&allocator);
 }
@@ -651,6 +651,13 @@ bool TranslatorVulkan::translateImpl(TIntermBlock *root,
 
     sink << "#version 450 core\n";
 
+    // The emulated gl_DrawID includes gl_DrawIDARB, see ShaderBuiltinsWorkaround.
+    if (getShaderType() == GL_VERTEX_SHADER && (compileOptions & SH_ADD_DRAW_INDEX_TO_DRAW_ID) &&
+        IsExtensionEnabled(getExtensionBehavior(), TExtension::ANGLE_multi_draw))
+    {
+        sink << "#extension GL_ARB_shader_draw_parameters : require\n";
+    }
+
     // Write out default uniforms into a uniform block assigned to a specific set/binding.
     int defaultUniformCount           = 0;
     int aggregateTypesUsedForUniforms = 0;
@@ -0,0 +1,125 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// loadimage_unittest:
+//   Unit tests for the image load functions that have vectorized paths.  They must give the same
+//   results as the scalar loops whatever the width and the alignment of the rows, and must not
+//   write past the end of the rows.
+//
+
+#include <array>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "image_util/loadimage.h"
+
+namespace angle
+{
+namespace
+{
+using LoadFunction = void (*)(size_t width,
+                              size_t height,
+                              size_t depth,
+                              const uint8_t *input,
+                              size_t inputRowPitch,
+                              size_t inputDepthPitch,
+                              uint8_t *output,
+                              size_t outputRowPitch,
+                              size_t outputDepthPitch);
+
+// Returns the 4 bytes a source texel is loaded as.
+using ExpectedTexelFunction = std::array<uint8_t, 4> (*)(const uint8_t *source);
+
+constexpr uint8_t kGuardByte = 0xCD;
+
+// Loads 2 slices of 3 rows of |width| texels to an output that starts |outputOffset| bytes after a
+// 16-byte boundary.  The rows are padded by 4 bytes, so each row has a different alignment.
+void CheckLoad(LoadFunction loadFunction,
+               size_t sourceTexelSize,
+               ExpectedTexelFunction expectedTexel,
+               size_t width,
+               size_t outputOffset)
+{
+    constexpr size_t kHeight      = 3;
+    constexpr size_t kDepth       = 2;
+    const size_t inputRowPitch    = width * sourceTexelSize + 4;
+    const size_t inputDepthPitch  = inputRowPitch * kHeight + 4;
+    const size_t outputRowPitch   = width * 4 + 4;
+    const size_t outputDepthPitch = outputRowPitch * kHeight + 4;
+
+    std::vector<uint8_t> input(inputDepthPitch * kDepth);
+    for (size_t index = 0; index < input.size(); ++index)
+    {
+        input[index] = static_cast<uint8_t>(index * 7 + 3);
+    }
+
+    // Leave room to align the output.
+    std::vector<uint8_t> outputStorage(outputDepthPitch * kDepth + 32, kGuardByte);
+    const uintptr_t storageAddress = reinterpret_cast<uintptr_t>(outputStorage.data());
+    uint8_t *output = outputStorage.data() + (16 - storageAddress % 16) % 16 + outputOffset;
+
+    loadFunction(width, kHeight, kDepth, input.data(), inputRowPitch, inputDepthPitch, output,
+                 outputRowPitch, outputDepthPitch);
+
+    for (size_t z = 0; z < kDepth; ++z)
+    {
+        for (size_t y = 0; y < kHeight; ++y)
+        {
+            const uint8_t *sourceRow = input.data() + z * inputDepthPitch + y * inputRowPitch;
+            const uint8_t *destRow   = output + z * outputDepthPitch + y * outputRowPitch;
+            for (size_t x = 0; x < width; ++x)
+            {
+                const std::array<uint8_t, 4> expected =
+                    expectedTexel(sourceRow + x * sourceTexelSize);
+                for (size_t byte = 0; byte < 4; ++byte)
+                {
+                    ASSERT_EQ(expected[byte], destRow[x * 4 + byte])
+                        << "width " << width << ", offset " << outputOffset << ", texel " << x
+                        << ", " << y << ", " << z << ", byte " << byte;
+                }
+            }
+            for (size_t byte = width * 4; byte < outputRowPitch; ++byte)
+            {
+                ASSERT_EQ(kGuardByte, destRow[byte])
+                    << "width " << width << ", offset " << outputOffset << ", row " << y << ", "
+                    << z << " written past its end";
+            }
+        }
+    }
+}
+
+// Covers the scalar loops that align the output and handle the remainder, with and without full
+// vectors in between.
+void CheckLoadAllWidths(LoadFunction loadFunction,
+                        size_t sourceTexelSize,
+                        ExpectedTexelFunction expectedTexel)
+{
+    for (size_t width = 0; width <= 40; ++width)
+    {
+        for (size_t outputOffset : {0, 4, 8, 12})
+        {
+            CheckLoad(loadFunction, sourceTexelSize, expectedTexel, width, outputOffset);
+        }
+    }
+}
+
+// Tests that A8 is loaded to RGBA8 with zero color.
+TEST(LoadImageTest, A8ToRGBA8)
+{
+    CheckLoadAllWidths(LoadA8ToRGBA8, 1, [](const uint8_t *source) {
+        return std::array<uint8_t, 4>{{0, 0, 0, source[0]}};
+    });
+}
+
+// Tests that RGBA8 is loaded to BGRA8 with red and blue swapped.
+TEST(LoadImageTest, RGBA8ToBGRA8)
+{
+    CheckLoadAllWidths(LoadRGBA8ToBGRA8, 4, [](const uint8_t *source) {
+        return std::array<uint8_t, 4>{{source[2], source[1], source[0], source[3]}};
+    });
+}
+}  // anonymous namespace
+}  // namespace angle
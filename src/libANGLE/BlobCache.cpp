@@ -8,8 +8,10 @@
 // disk.  MemoryProgramCache uses this to handle caching of compiled programs.
 
 #include "libANGLE/BlobCache.h"
+#include "common/mathutil.h"
 #include "common/utilities.h"
 #include "libANGLE/Context.h"
+#include "libANGLE/DiskBlobCache.h"
 #include "libANGLE/Display.h"
 #include "libANGLE/histogram_macros.h"
 #include "platform/PlatformMethods.h"
@@ -30,8 +32,14 @@ enum CacheResult
 }  // anonymous namespace
 
 BlobCache::BlobCache(size_t maxCacheSizeBytes)
-    : mBlobCache(maxCacheSizeBytes), mSetBlobFunc(nullptr), mGetBlobFunc(nullptr)
-{}
+    : mShardCount(1),
+      mMaxCacheSizeBytes(0),
+      mTotalSizeBytes(0),
+      mSetBlobFunc(nullptr),
+      mGetBlobFunc(nullptr)
+{
+    resize(maxCacheSizeBytes);
+}
 
 BlobCache::~BlobCache() {}
 
@@ -44,6 +52,10 @@ void BlobCache::put(const BlobCache::Key &key, angle::MemoryBuffer &&value)
     }
     else
     {
+        if (mDiskCache)
+        {
+            mDiskCache->put(key, value.data(), value.size());
+        }
         populate(key, std::move(value), CacheSource::Memory);
     }
 }
@@ -54,6 +66,10 @@ void BlobCache::putApplication(const BlobCache::Key &key, const angle::MemoryBuf
     {
         mSetBlobFunc(key.data(), key.size(), value.data(), value.size());
     }
+    else if (mDiskCache)
+    {
+        mDiskCache->put(key, value.data(), value.size());
+    }
 }
 
 void BlobCache::populate(const BlobCache::Key &key, angle::MemoryBuffer &&value, CacheSource source)
@@ -63,7 +79,18 @@ void BlobCache::populate(const BlobCache::Key &key, angle::MemoryBuffer &&value,
     newEntry.second = source;
 
     // Cache it inside blob cache only if caching inside the application is not possible.
-    mBlobCache.put(key, std::move(newEntry), newEntry.first.size());
+    const size_t shardIndex = getShardIndex(key);
+    {
+        Shard &shard = mShards[shardIndex];
+        std::lock_guard<std::shared_timed_mutex> lock(shard.mutex);
+        const size_t sizeBefore = shard.cache.size();
+        shard.cache.put(key, std::move(newEntry), newEntry.first.size());
+        onShardSizeChanged(sizeBefore, shard.cache.size());
+    }
+
+    // The shard only made room within itself, so the cache as a whole may be over its limit.  Make
+    // room in the other shards first, so the new blob is the last to go.
+    shrinkToTotalSize(maxSize(), shardIndex + 1);
 }
 
 bool BlobCache::get(angle::ScratchBuffer *scratchBuffer,
@@ -102,17 +129,25 @@ bool BlobCache::get(angle::ScratchBuffer *scratchBuffer,
             return false;
         }
 
-        *valueOut      = BlobCache::Value(scratchMemory->data(), scratchMemory->size());
+        // The scratch buffer may be larger than the blob.
+        *valueOut      = BlobCache::Value(scratchMemory->data(), valueSize);
         *bufferSizeOut = valueSize;
         return true;
     }
 
-    // Otherwise we are doing caching internally, so try to find it there
-    const CacheEntry *entry;
-    bool result = mBlobCache.get(key, &entry);
-
-    if (result)
+    // Otherwise we are doing caching internally, so try to find it there.  Readers share the lock,
+    // so the lookup can't update the LRU order.  That is done afterwards if the shard is free.
+    Shard &shard = mShards[getShardIndex(key)];
     {
+        std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+
+        const CacheEntry *entry;
+        if (!shard.cache.peek(key, &entry))
+        {
+            lock.unlock();
+            return getFromDiskCache(scratchBuffer, key, valueOut, bufferSizeOut);
+        }
+
         if (entry->second == CacheSource::Memory)
         {
             ANGLE_HISTOGRAM_ENUMERATION("GPU.ANGLE.ProgramCache.CacheResult", kCacheHitMemory,
@@ -124,32 +159,216 @@ bool BlobCache::get(angle::ScratchBuffer *scratchBuffer,
                                         kCacheResultMax);
         }
 
-        *valueOut      = BlobCache::Value(entry->first.data(), entry->first.size());
+        if (scratchBuffer)
+        {
+            // Copy the blob out while the lock is held, as another thread may evict it as soon as
+            // the lock is released.
+            angle::MemoryBuffer *scratchMemory;
+            if (!scratchBuffer->get(entry->first.size(), &scratchMemory))
+            {
+                ERR() << "Failed to allocate memory for binary blob";
+                return false;
+            }
+            memcpy(scratchMemory->data(), entry->first.data(), entry->first.size());
+            *valueOut = BlobCache::Value(scratchMemory->data(), entry->first.size());
+        }
+        else
+        {
+            *valueOut = BlobCache::Value(entry->first.data(), entry->first.size());
+        }
         *bufferSizeOut = entry->first.size();
     }
-    else
+
+    // Mark the entry as most recently used, unless another thread is using the shard.  Skipping
+    // this under contention only makes eviction slightly less accurate.
+    std::unique_lock<std::shared_timed_mutex> lock(shard.mutex, std::try_to_lock);
+    if (lock.owns_lock())
+    {
+        const CacheEntry *entry;
+        (void)shard.cache.get(key, &entry);
+    }
+
+    return true;
+}
+
+bool BlobCache::getFromDiskCache(angle::ScratchBuffer *scratchBuffer,
+                                 const BlobCache::Key &key,
+                                 BlobCache::Value *valueOut,
+                                 size_t *bufferSizeOut)
+{
+    if (mDiskCache && scratchBuffer && mDiskCache->get(scratchBuffer, key, valueOut))
     {
-        ANGLE_HISTOGRAM_ENUMERATION("GPU.ANGLE.ProgramCache.CacheResult", kCacheMiss,
+        ANGLE_HISTOGRAM_ENUMERATION("GPU.ANGLE.ProgramCache.CacheResult", kCacheHitDisk,
                                     kCacheResultMax);
+        *bufferSizeOut = valueOut->size();
+
+        // Keep a copy in memory, so the next lookup doesn't go to disk.
+        angle::MemoryBuffer copy;
+        if (maxSize() > 0 && copy.resize(valueOut->size()))
+        {
+            memcpy(copy.data(), valueOut->data(), valueOut->size());
+            populate(key, std::move(copy), CacheSource::Disk);
+        }
+        return true;
     }
 
-    return result;
+    ANGLE_HISTOGRAM_ENUMERATION("GPU.ANGLE.ProgramCache.CacheResult", kCacheMiss, kCacheResultMax);
+    return false;
 }
 
 bool BlobCache::getAt(size_t index, const BlobCache::Key **keyOut, BlobCache::Value *valueOut)
 {
-    const CacheEntry *valueBuf;
-    bool result = mBlobCache.getAt(index, keyOut, &valueBuf);
-    if (result)
+    // Entries are numbered shard by shard.
+    const size_t shardCount = mShardCount;
+    for (size_t shardIndex = 0; shardIndex < shardCount; ++shardIndex)
     {
-        *valueOut = BlobCache::Value(valueBuf->first.data(), valueBuf->first.size());
+        Shard &shard = mShards[shardIndex];
+        std::lock_guard<std::shared_timed_mutex> lock(shard.mutex);
+
+        const size_t shardEntryCount = shard.cache.entryCount();
+        if (index >= shardEntryCount)
+        {
+            index -= shardEntryCount;
+            continue;
+        }
+
+        const CacheEntry *valueBuf;
+        bool result = shard.cache.getAt(index, keyOut, &valueBuf);
+        if (result)
+        {
+            *valueOut = BlobCache::Value(valueBuf->first.data(), valueBuf->first.size());
+        }
+        return result;
     }
-    return result;
+
+    return false;
 }
 
 void BlobCache::remove(const BlobCache::Key &key)
 {
-    mBlobCache.eraseByKey(key);
+    // Blobs are removed when they turn out to be unusable, so they must not come back from disk.
+    if (mDiskCache)
+    {
+        mDiskCache->remove(key);
+    }
+
+    Shard &shard = mShards[getShardIndex(key)];
+    std::lock_guard<std::shared_timed_mutex> lock(shard.mutex);
+    const size_t sizeBefore = shard.cache.size();
+    shard.cache.eraseByKey(key);
+    onShardSizeChanged(sizeBefore, shard.cache.size());
+}
+
+void BlobCache::clear()
+{
+    for (Shard &shard : mShards)
+    {
+        std::lock_guard<std::shared_timed_mutex> lock(shard.mutex);
+        onShardSizeChanged(shard.cache.size(), 0);
+        shard.cache.clear();
+    }
+}
+
+void BlobCache::resize(size_t maxCacheSizeBytes)
+{
+    // Hold every shard's lock, always taken in the same order, so that no thread sees a mix of
+    // old and new shard sizes.
+    std::array<std::unique_lock<std::shared_timed_mutex>, kMaxShardCount> locks;
+    for (size_t shardIndex = 0; shardIndex < kMaxShardCount; ++shardIndex)
+    {
+        locks[shardIndex] = std::unique_lock<std::shared_timed_mutex>(mShards[shardIndex].mutex);
+    }
+
+    const size_t shardCount =
+        gl::clamp(maxCacheSizeBytes / kMinShardSizeBytes, size_t(1), kMaxShardCount);
+
+    // Unused shards get a size of zero, so that a thread that picked a shard before the resize
+    // can't add anything to it.
+    for (size_t shardIndex = 0; shardIndex < kMaxShardCount; ++shardIndex)
+    {
+        mShards[shardIndex].cache.resize(shardIndex < shardCount ? maxCacheSizeBytes : 0);
+    }
+
+    mShardCount        = shardCount;
+    mMaxCacheSizeBytes = maxCacheSizeBytes;
+    mTotalSizeBytes    = 0;
+}
+
+size_t BlobCache::entryCount() const
+{
+    size_t entryCount = 0;
+    for (const Shard &shard : mShards)
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+        entryCount += shard.cache.entryCount();
+    }
+    return entryCount;
+}
+
+size_t BlobCache::trim(size_t limit)
+{
+    return shrinkToTotalSize(limit, 0);
+}
+
+size_t BlobCache::size() const
+{
+    size_t size = 0;
+    for (const Shard &shard : mShards)
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+        size += shard.cache.size();
+    }
+    return size;
+}
+
+size_t BlobCache::getShardIndex(const BlobCache::Key &key) const
+{
+    // The keys are SHA-1 hashes, so any byte is as good as a hash of the key.
+    return key[0] % mShardCount;
+}
+
+void BlobCache::onShardSizeChanged(size_t sizeBefore, size_t sizeAfter)
+{
+    if (sizeAfter >= sizeBefore)
+    {
+        mTotalSizeBytes += sizeAfter - sizeBefore;
+    }
+    else
+    {
+        mTotalSizeBytes -= sizeBefore - sizeAfter;
+    }
+}
+
+size_t BlobCache::shrinkToTotalSize(size_t limit, size_t firstShardIndex)
+{
+    // Only one shard is locked at a time.  The total may change in between, so it's checked
+    // again under each lock.
+    const size_t shardCount = mShardCount;
+    size_t bytesFreed       = 0;
+    for (size_t offset = 0; offset < shardCount; ++offset)
+    {
+        Shard &shard = mShards[(firstShardIndex + offset) % shardCount];
+        std::lock_guard<std::shared_timed_mutex> lock(shard.mutex);
+
+        const size_t totalSize = mTotalSizeBytes;
+        if (totalSize <= limit)
+        {
+            break;
+        }
+
+        const size_t excess     = totalSize - limit;
+        const size_t shardSize  = shard.cache.size();
+        const size_t shardLimit = shardSize > excess ? shardSize - excess : 0;
+        const size_t freed      = shard.cache.shrinkToSize(shardLimit);
+        onShardSizeChanged(freed, 0);
+        bytesFreed += freed;
+    }
+    return bytesFreed;
+}
+
+void BlobCache::setDiskCache(std::unique_ptr<DiskBlobCache> &&diskCache)
+{
+    mDiskCache = std::move(diskCache);
 }
 
 void BlobCache::setBlobCacheFuncs(EGLSetBlobFuncANDROID set, EGLGetBlobFuncANDROID get)
@@ -11,7 +11,10 @@
 #define LIBANGLE_BLOB_CACHE_H_
 
 #include <array>
+#include <atomic>
 #include <cstring>
+#include <memory>
+#include <shared_mutex>
 
 #include <anglebase/sha1.h>
 #include "common/MemoryBuffer.h"
@@ -47,6 +50,7 @@ struct hash<egl::BlobCacheKey>
 
 namespace egl
 {
+class DiskBlobCache;
 
 class BlobCache final : angle::NonCopyable
 {
@@ -86,10 +90,12 @@ class BlobCache final : angle::NonCopyable
     ~BlobCache();
 
     // Store a key-blob pair in the cache.  If application callbacks are set, the application cache
-    // will be used.  Otherwise the value is cached in this object.
+    // will be used.  Otherwise the value is cached in this object, and on disk if there is a disk
+    // cache.
     void put(const BlobCache::Key &key, angle::MemoryBuffer &&value);
 
     // Store a key-blob pair in the application cache, only if application callbacks are set.
+    // Without them, the blob goes to the disk cache if there is one.
     void putApplication(const BlobCache::Key &key, const angle::MemoryBuffer &value);
 
     // Store a key-blob pair in the cache without making callbacks to the application.  This is used
@@ -99,51 +105,92 @@ class BlobCache final : angle::NonCopyable
                   CacheSource source = CacheSource::Disk);
 
     // Check if the cache contains the blob corresponding to this key.  If application callbacks are
-    // set, those will be used.  Otherwise they key is looked up in this object's cache.
+    // set, those will be used.  Otherwise they key is looked up in this object's cache, then in the
+    // disk cache.  When |scratchBuffer| is given, the blob is copied into it, so that it stays
+    // valid while other threads modify the cache.  Otherwise |valueOut| points into the cache
+    // itself, and the disk cache isn't used.
     ANGLE_NO_DISCARD bool get(angle::ScratchBuffer *scratchBuffer,
                               const BlobCache::Key &key,
                               BlobCache::Value *valueOut,
                               size_t *bufferSizeOut);
 
-    // For querying the contents of the cache.
+    // For querying the contents of the cache.  The returned key and value point into the cache.
     ANGLE_NO_DISCARD bool getAt(size_t index,
                                 const BlobCache::Key **keyOut,
                                 BlobCache::Value *valueOut);
 
-    // Evict a blob from the binary cache.
+    // Evict a blob from the binary cache, and from the disk cache if there is one.
     void remove(const BlobCache::Key &key);
 
     // Empty the cache.
-    void clear() { mBlobCache.clear(); }
+    void clear();
 
     // Resize the cache. Discards current contents.
-    void resize(size_t maxCacheSizeBytes) { mBlobCache.resize(maxCacheSizeBytes); }
+    void resize(size_t maxCacheSizeBytes);
 
     // Returns the number of entries in the cache.
-    size_t entryCount() const { return mBlobCache.entryCount(); }
+    size_t entryCount() const;
 
     // Reduces the current cache size and returns the number of bytes freed.
-    size_t trim(size_t limit) { return mBlobCache.shrinkToSize(limit); }
+    size_t trim(size_t limit);
 
     // Returns the current cache size in bytes.
-    size_t size() const { return mBlobCache.size(); }
+    size_t size() const;
 
     // Returns whether the cache is empty
-    bool empty() const { return mBlobCache.empty(); }
+    bool empty() const { return entryCount() == 0; }
 
     // Returns the maximum cache size in bytes.
-    size_t maxSize() const { return mBlobCache.maxSize(); }
+    size_t maxSize() const { return mMaxCacheSizeBytes; }
 
     void setBlobCacheFuncs(EGLSetBlobFuncANDROID set, EGLGetBlobFuncANDROID get);
 
     bool areBlobCacheFuncsSet() const;
 
-    bool isCachingEnabled() const { return areBlobCacheFuncsSet() || maxSize() > 0; }
+    // Persist blobs in |diskCache| when the application doesn't provide callbacks.
+    void setDiskCache(std::unique_ptr<DiskBlobCache> &&diskCache);
+    bool hasDiskCache() const { return mDiskCache != nullptr; }
+
+    bool isCachingEnabled() const
+    {
+        return areBlobCacheFuncsSet() || maxSize() > 0 || hasDiskCache();
+    }
 
   private:
-    // This internal cache is used only if the application is not providing caching callbacks
+    // This internal cache is used only if the application is not providing caching callbacks.  It
+    // is split in shards by key, each with its own LRU list and lock, so that threads looking up
+    // different programs don't contend.  Lookups only take the lock in shared mode.  Any shard can
+    // hold a blob as large as the whole cache; the size limit applies to all shards together.
     using CacheEntry = std::pair<angle::MemoryBuffer, CacheSource>;
-    angle::SizedMRUCache<BlobCache::Key, CacheEntry> mBlobCache;
+    struct Shard final : angle::NonCopyable
+    {
+        Shard() : cache(0) {}
+
+        mutable std::shared_timed_mutex mutex;
+        angle::SizedMRUCache<BlobCache::Key, CacheEntry> cache;
+    };
+
+    // Small caches are not split, as there are few blobs to spread between shards.
+    static constexpr size_t kMaxShardCount     = 16;
+    static constexpr size_t kMinShardSizeBytes = 1024 * 1024;
+
+    size_t getShardIndex(const BlobCache::Key &key) const;
+    void onShardSizeChanged(size_t sizeBefore, size_t sizeAfter);
+    // Evicts the least recently used blobs of each shard, starting with |firstShardIndex|, until
+    // the total size is within |limit|.  Returns the number of bytes freed.
+    size_t shrinkToTotalSize(size_t limit, size_t firstShardIndex);
+    bool getFromDiskCache(angle::ScratchBuffer *scratchBuffer,
+                          const BlobCache::Key &key,
+                          BlobCache::Value *valueOut,
+                          size_t *bufferSizeOut);
+
+    std::array<Shard, kMaxShardCount> mShards;
+    std::atomic<size_t> mShardCount;
+    std::atomic<size_t> mMaxCacheSizeBytes;
+    std::atomic<size_t> mTotalSizeBytes;
+
+    // Set once at display initialization.  Does its own synchronization.
+    std::unique_ptr<DiskBlobCache> mDiskCache;
 
     EGLSetBlobFuncANDROID mSetBlobFunc;
     EGLGetBlobFuncANDROID mGetBlobFunc;
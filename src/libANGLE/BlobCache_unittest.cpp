@@ -7,6 +7,9 @@
 
 #include <gtest/gtest.h>
 
+#include <set>
+#include <thread>
+
 #include "libANGLE/BlobCache.h"
 
 namespace egl
@@ -22,9 +25,9 @@ using Key     = BlobCache::Key;
 template <typename T>
 void MakeSequence(T &seq, uint8_t start)
 {
-    for (uint8_t i = 0; i < seq.size(); ++i)
+    for (size_t i = 0; i < seq.size(); ++i)
     {
-        seq[i] = i + start;
+        seq[i] = static_cast<uint8_t>(i + start);
     }
 }
 
@@ -131,4 +134,192 @@ TEST(BlobCacheTest, OversizeValue)
     EXPECT_FALSE(blobCache.get(nullptr, MakeKey(5), &qvalue, &blobSize));
 }
 
+// Tests that a cache large enough to be split in shards still behaves as a single cache.
+TEST(BlobCacheTest, LargeCache)
+{
+    constexpr size_t kSize      = 64 * 1024 * 1024;
+    constexpr size_t kBlobSize  = 1024;
+    constexpr size_t kBlobCount = 256;
+    BlobCache blobCache(kSize);
+    EXPECT_EQ(kSize, blobCache.maxSize());
+
+    for (size_t value = 0; value < kBlobCount; ++value)
+    {
+        blobCache.populate(MakeKey(value), MakeBlob(kBlobSize, value));
+    }
+    EXPECT_EQ(kBlobCount, blobCache.entryCount());
+    EXPECT_EQ(kBlobCount * kBlobSize, blobCache.size());
+
+    for (size_t value = 0; value < kBlobCount; ++value)
+    {
+        Blob qvalue;
+        size_t blobSize;
+        ASSERT_TRUE(blobCache.get(nullptr, MakeKey(value), &qvalue, &blobSize));
+        EXPECT_EQ(kBlobSize, blobSize);
+        EXPECT_EQ(static_cast<uint8_t>(value), qvalue[0]);
+    }
+
+    // Every entry is reachable by index exactly once.
+    std::set<Key> keys;
+    for (size_t index = 0; index < blobCache.entryCount(); ++index)
+    {
+        const Key *key;
+        Blob qvalue;
+        ASSERT_TRUE(blobCache.getAt(index, &key, &qvalue));
+        EXPECT_EQ(kBlobSize, qvalue.size());
+        keys.insert(*key);
+    }
+    EXPECT_EQ(kBlobCount, keys.size());
+
+    const Key *key;
+    Blob qvalue;
+    EXPECT_FALSE(blobCache.getAt(kBlobCount, &key, &qvalue));
+
+    blobCache.remove(MakeKey(0));
+    size_t blobSize;
+    EXPECT_FALSE(blobCache.get(nullptr, MakeKey(0), &qvalue, &blobSize));
+    EXPECT_EQ(kBlobCount - 1, blobCache.entryCount());
+
+    // Trimming frees everything above the limit.
+    EXPECT_EQ((kBlobCount - 1) * kBlobSize, blobCache.trim(0));
+    EXPECT_TRUE(blobCache.empty());
+
+    // Resizing discards the contents and sets the new limit.
+    blobCache.populate(MakeKey(1), MakeBlob(kBlobSize));
+    blobCache.resize(kSize / 2);
+    EXPECT_TRUE(blobCache.empty());
+    EXPECT_EQ(kSize / 2, blobCache.maxSize());
+}
+
+// Tests that a sharded cache takes blobs larger than a shard's share of it, and that its size
+// limit applies to all shards together.
+TEST(BlobCacheTest, LargeCacheSizeLimit)
+{
+    constexpr size_t kSize           = 16 * 1024 * 1024;
+    constexpr size_t kSmallBlobSize  = 1024 * 1024;
+    constexpr size_t kSmallBlobCount = 32;
+    BlobCache blobCache(kSize);
+
+    // Every small blob goes to a different shard.  Together they are twice the size of the cache.
+    for (size_t value = 0; value < kSmallBlobCount; ++value)
+    {
+        blobCache.populate(MakeKey(value), MakeBlob(kSmallBlobSize, value));
+        EXPECT_LE(blobCache.size(), kSize);
+    }
+    EXPECT_EQ(kSize, blobCache.size());
+    EXPECT_EQ(kSize / kSmallBlobSize, blobCache.entryCount());
+
+    // The most recent blobs are kept.
+    Blob qvalue;
+    size_t blobSize;
+    EXPECT_TRUE(blobCache.get(nullptr, MakeKey(kSmallBlobCount - 1), &qvalue, &blobSize));
+    EXPECT_FALSE(blobCache.get(nullptr, MakeKey(0), &qvalue, &blobSize));
+
+    // A blob of most of the cache fits, even though it's much larger than a shard's share, and
+    // evicts blobs from the other shards to make room.
+    constexpr size_t kLargeBlobSize = kSize - 2 * kSmallBlobSize;
+    blobCache.populate(MakeKey(100), MakeBlob(kLargeBlobSize, 100));
+    EXPECT_LE(blobCache.size(), kSize);
+    ASSERT_TRUE(blobCache.get(nullptr, MakeKey(100), &qvalue, &blobSize));
+    EXPECT_EQ(kLargeBlobSize, blobSize);
+    EXPECT_EQ(100u, qvalue[0]);
+
+    // Trimming applies to the total as well.
+    blobCache.trim(kLargeBlobSize);
+    EXPECT_LE(blobCache.size(), kLargeBlobSize);
+
+    blobCache.remove(MakeKey(100));
+    blobCache.clear();
+    EXPECT_EQ(0u, blobCache.size());
+}
+
+// Tests that a blob copied into a scratch buffer survives its eviction from the cache.
+TEST(BlobCacheTest, GetIntoScratchBuffer)
+{
+    constexpr size_t kSize = 32;
+    BlobCache blobCache(kSize);
+    angle::ScratchBuffer scratchBuffer;
+
+    blobCache.populate(MakeKey(0), MakeBlob(kSize, 3));
+
+    Blob qvalue;
+    size_t blobSize;
+    ASSERT_TRUE(blobCache.get(&scratchBuffer, MakeKey(0), &qvalue, &blobSize));
+    EXPECT_EQ(kSize, blobSize);
+
+    blobCache.clear();
+    EXPECT_TRUE(blobCache.empty());
+
+    ASSERT_EQ(kSize, qvalue.size());
+    for (size_t index = 0; index < kSize; ++index)
+    {
+        EXPECT_EQ(index + 3, qvalue[index]);
+    }
+}
+
+// Tests that threads can read from and write to the cache at the same time.
+TEST(BlobCacheTest, ConcurrentAccess)
+{
+    constexpr size_t kSize           = 16 * 1024 * 1024;
+    constexpr size_t kBlobSize       = 256;
+    constexpr size_t kThreadCount    = 4;
+    constexpr size_t kBlobsPerThread = 32;
+    constexpr size_t kIterationCount = 100;
+    BlobCache blobCache(kSize);
+
+    // Blobs that all threads read.
+    for (size_t value = 0; value < kBlobsPerThread; ++value)
+    {
+        blobCache.populate(MakeKey(value), MakeBlob(kBlobSize, value));
+    }
+
+    std::vector<std::thread> threads;
+    std::vector<size_t> failureCounts(kThreadCount, 0);
+    for (size_t threadIndex = 0; threadIndex < kThreadCount; ++threadIndex)
+    {
+        threads.emplace_back([&blobCache, &failureCounts, threadIndex]() {
+            angle::ScratchBuffer scratchBuffer;
+            const uint8_t firstOwnValue = static_cast<uint8_t>((threadIndex + 1) * kBlobsPerThread);
+
+            for (size_t iteration = 0; iteration < kIterationCount; ++iteration)
+            {
+                for (size_t value = 0; value < kBlobsPerThread; ++value)
+                {
+                    // Each thread also writes and removes blobs of its own.
+                    const uint8_t ownValue = static_cast<uint8_t>(firstOwnValue + value);
+                    blobCache.populate(MakeKey(ownValue), MakeBlob(kBlobSize, ownValue));
+
+                    Blob qvalue;
+                    size_t blobSize;
+                    if (!blobCache.get(&scratchBuffer, MakeKey(value), &qvalue, &blobSize) ||
+                        blobSize != kBlobSize || qvalue[0] != value ||
+                        qvalue[kBlobSize - 1] != static_cast<uint8_t>(value + kBlobSize - 1))
+                    {
+                        ++failureCounts[threadIndex];
+                    }
+
+                    if (!blobCache.get(&scratchBuffer, MakeKey(ownValue), &qvalue, &blobSize) ||
+                        qvalue[0] != ownValue)
+                    {
+                        ++failureCounts[threadIndex];
+                    }
+
+                    blobCache.remove(MakeKey(ownValue));
+                }
+            }
+        });
+    }
+
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (size_t failureCount : failureCounts)
+    {
+        EXPECT_EQ(0u, failureCount);
+    }
+    EXPECT_EQ(kBlobsPerThread, blobCache.entryCount());
+}
+
 }  // namespace egl
@@ -15,6 +15,7 @@
 #include <sstream>
 #include <vector>
 
+#include "common/FastVector.h"
 #include "common/PackedEnums.h"
 #include "common/angle_version.h"
 #include "common/matrix_utils.h"
@@ -6144,6 +6145,7 @@ void Context::drawArraysInstancedBaseInstance(PrimitiveMode mode,
     ANGLE_CONTEXT_TRY(mImplementation->drawArraysInstancedBaseInstance(
         this, mode, first, count, instanceCount, baseInstance));
     MarkTransformFeedbackBufferUsage(this, count, 1);
+    MarkShaderStorageUsage(this);
 }
 
 void Context::drawElementsInstancedBaseVertexBaseInstance(PrimitiveMode mode,
@@ -6178,6 +6180,7 @@ void Context::drawElementsInstancedBaseVertexBaseInstance(PrimitiveMode mode,
 
     ANGLE_CONTEXT_TRY(mImplementation->drawElementsInstancedBaseVertexBaseInstance(
         this, mode, count, type, indices, instanceCounts, baseVertex, baseInstance));
+    MarkShaderStorageUsage(this);
 }
 
 void Context::multiDrawArraysInstancedBaseInstance(PrimitiveMode mode,
@@ -6232,38 +6235,64 @@ void Context::deleteBuffers(GLsizei n, const BufferID *buffers)
 {
     for (int i = 0; i < n; i++)
     {
-        deleteBuffer(buffers[i]);
+        Buffer *buffer = mState.mBufferManager->getBuffer(buffers[i]);
+        if (buffer)
+        {
+            detachBuffer(buffer);
+        }
     }
+
+    mState.mBufferManager->deleteObjects(this, n, buffers);
 }
 
 void Context::deleteFramebuffers(GLsizei n, const FramebufferID *framebuffers)
 {
+    // The default framebuffer is kept in the framebuffer manager under handle zero, so zero is
+    // filtered out before the bulk delete.
+    angle::FastVector<FramebufferID, 16> deletedFramebuffers;
     for (int i = 0; i < n; i++)
     {
-        if (framebuffers[i].value != 0)
+        if (framebuffers[i].value == 0)
+        {
+            continue;
+        }
+
+        if (mState.mFramebufferManager->getFramebuffer(framebuffers[i]))
         {
-            deleteFramebuffer(framebuffers[i]);
+            detachFramebuffer(framebuffers[i]);
         }
+        deletedFramebuffers.push_back(framebuffers[i]);
     }
+
+    GLsizei deletedCount = static_cast<GLsizei>(deletedFramebuffers.size());
+    mState.mFramebufferManager->deleteObjects(this, deletedCount, deletedFramebuffers.data());
 }
 
 void Context::deleteRenderbuffers(GLsizei n, const RenderbufferID *renderbuffers)
 {
     for (int i = 0; i < n; i++)
     {
-        deleteRenderbuffer(renderbuffers[i]);
+        if (mState.mRenderbufferManager->getRenderbuffer(renderbuffers[i]))
+        {
+            detachRenderbuffer(renderbuffers[i]);
+        }
     }
+
+    mState.mRenderbufferManager->deleteObjects(this, n, renderbuffers);
 }
 
 void Context::deleteTextures(GLsizei n, const TextureID *textures)
 {
+    // Texture zero is never in the texture manager, so deleteObjects() ignores it.
     for (int i = 0; i < n; i++)
     {
-        if (textures[i].value != 0)
+        if (textures[i].value != 0 && mState.mTextureManager->getTexture(textures[i]))
         {
-            deleteTexture(textures[i]);
+            detachTexture(textures[i]);
         }
     }
+
+    mState.mTextureManager->deleteObjects(this, n, textures);
 }
 
 void Context::detachShader(ShaderProgramID program, ShaderProgramID shader)
@@ -6279,34 +6308,22 @@ void Context::detachShader(ShaderProgramID program, ShaderProgramID shader)
 
 void Context::genBuffers(GLsizei n, BufferID *buffers)
 {
-    for (int i = 0; i < n; i++)
-    {
-        buffers[i] = createBuffer();
-    }
+    mState.mBufferManager->createBuffers(n, buffers);
 }
 
 void Context::genFramebuffers(GLsizei n, FramebufferID *framebuffers)
 {
-    for (int i = 0; i < n; i++)
-    {
-        framebuffers[i] = createFramebuffer();
-    }
+    mState.mFramebufferManager->createFramebuffers(n, framebuffers);
 }
 
 void Context::genRenderbuffers(GLsizei n, RenderbufferID *renderbuffers)
 {
-    for (int i = 0; i < n; i++)
-    {
-        renderbuffers[i] = createRenderbuffer();
-    }
+    mState.mRenderbufferManager->createRenderbuffers(n, renderbuffers);
 }
 
 void Context::genTextures(GLsizei n, TextureID *textures)
 {
-    for (int i = 0; i < n; i++)
-    {
-        textures[i] = createTexture();
-    }
+    mState.mTextureManager->createTextures(n, textures);
 }
 
 void Context::getActiveAttrib(ShaderProgramID program,
@@ -7447,10 +7464,7 @@ void Context::getBufferParameteri64vRobust(BufferBinding target,
 
 void Context::genSamplers(GLsizei count, SamplerID *samplers)
 {
-    for (int i = 0; i < count; i++)
-    {
-        samplers[i] = mState.mSamplerManager->createSampler();
-    }
+    mState.mSamplerManager->createSamplers(count, samplers);
 }
 
 void Context::deleteSamplers(GLsizei count, const SamplerID *samplers)
@@ -7463,9 +7477,9 @@ void Context::deleteSamplers(GLsizei count, const SamplerID *samplers)
         {
             detachSampler(sampler);
         }
-
-        mState.mSamplerManager->deleteObject(this, sampler);
     }
+
+    mState.mSamplerManager->deleteObjects(this, count, samplers);
 }
 
 void Context::minSampleShading(GLfloat value)
@@ -64,6 +64,13 @@ ANGLE_INLINE void MarkShaderStorageUsage(const Context *context)
         if (texture)
         {
             texture->onStateChange(angle::SubjectMessage::ContentsChanged);
+
+            // Image stores to a buffer texture write the buffer.
+            Buffer *buffer = texture->getBuffer().get();
+            if (texture->getType() == TextureType::Buffer && buffer)
+            {
+                buffer->onDataChanged();
+            }
         }
     }
 }
@@ -130,6 +137,7 @@ ANGLE_INLINE void Context::drawArrays(PrimitiveMode mode, GLint first, GLsizei c
     ANGLE_CONTEXT_TRY(prepareForDraw(mode));
     ANGLE_CONTEXT_TRY(mImplementation->drawArrays(this, mode, first, count));
     MarkTransformFeedbackBufferUsage(this, count, 1);
+    MarkShaderStorageUsage(this);
 }
 
 ANGLE_INLINE void Context::drawElements(PrimitiveMode mode,
@@ -145,6 +153,7 @@ ANGLE_INLINE void Context::drawElements(PrimitiveMode mode,
 
     ANGLE_CONTEXT_TRY(prepareForDraw(mode));
     ANGLE_CONTEXT_TRY(mImplementation->drawElements(this, mode, count, type, indices));
+    MarkShaderStorageUsage(this);
 }
 
 ANGLE_INLINE void StateCache::onBufferBindingChange(Context *context)
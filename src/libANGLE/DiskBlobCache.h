@@ -0,0 +1,91 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// DiskBlobCache: Persists BlobCache entries in a directory, for when the application doesn't
+//   provide EGL_ANDROID_blob_cache callbacks.  Only implemented on Linux.
+//
+//   The directory holds an index file that every process using the cache maps in memory, and one
+//   data file per blob.  The index records the size, checksum and last use of every blob and is
+//   protected by an advisory file lock, so several processes can share the cache.  Blobs are
+//   written to a temporary file that is then renamed in place, and their checksum is verified on
+//   every read, so a reader never sees a partially written blob.  Once the blobs take more than
+//   the size limit, the least recently used ones are evicted.
+//
+//   Blobs are kept in files of their own rather than in one mapped data file.  The file system
+//   then does the allocation: evicting a blob frees its space right away, with no compaction of a
+//   shared file while other processes may have it mapped, and the rename makes replacing a blob
+//   atomic.  Blobs are program binaries and pipeline caches, which are few and large enough that
+//   a file each costs little.
+
+#ifndef LIBANGLE_DISK_BLOB_CACHE_H_
+#define LIBANGLE_DISK_BLOB_CACHE_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "common/MemoryBuffer.h"
+#include "common/angleutils.h"
+#include "libANGLE/BlobCache.h"
+
+namespace egl
+{
+class DiskBlobCache final : angle::NonCopyable
+{
+  public:
+    // Opens or creates the cache in |directory|.  Returns null if the cache can't be used, or isn't
+    // supported on this platform.
+    static std::unique_ptr<DiskBlobCache> Open(const std::string &directory, size_t maxSizeBytes);
+
+    ~DiskBlobCache();
+
+    // Store a blob, evicting the least recently used ones as necessary.
+    void put(const BlobCacheKey &key, const uint8_t *data, size_t size);
+
+    // Look a blob up and copy it into |scratchBuffer|.  A blob that fails its checksum is removed
+    // and reported as missing.
+    ANGLE_NO_DISCARD bool get(angle::ScratchBuffer *scratchBuffer,
+                              const BlobCacheKey &key,
+                              BlobCache::Value *valueOut);
+
+    // Remove a blob from the cache and from the disk.
+    void remove(const BlobCacheKey &key);
+
+    // Returns the total size of the blobs in the cache.
+    size_t size() const;
+
+  private:
+    struct IndexHeader;
+    struct IndexEntry;
+
+    DiskBlobCache(const std::string &directory, size_t maxSizeBytes);
+
+    static size_t GetIndexFileSize();
+
+    bool initialize();
+    void removeStaleTempFiles();
+
+    IndexEntry *findEntry(const BlobCacheKey &key);
+    IndexEntry *allocateEntry(const BlobCacheKey &key);
+    void removeEntry(IndexEntry *entry);
+    bool makeRoom(size_t size);
+    std::string getBlobPath(const BlobCacheKey &key) const;
+
+    std::string mDirectory;
+    size_t mMaxSizeBytes;
+
+    // Serializes the threads of this process; the file lock serializes processes.
+    mutable std::mutex mMutex;
+    // Tells apart the temporary files of the threads of this process.
+    std::atomic<uint32_t> mTempFileCounter;
+    int mIndexFd;
+    void *mIndexMapping;
+    IndexHeader *mHeader;
+    IndexEntry *mEntries;
+};
+}  // namespace egl
+
+#endif  // LIBANGLE_DISK_BLOB_CACHE_H_
@@ -0,0 +1,542 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// DiskBlobCache_linux.cpp: Implementation of DiskBlobCache on top of POSIX files, mmap and flock.
+
+#include "libANGLE/DiskBlobCache.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#include "common/debug.h"
+#include "common/hash_utils.h"
+
+namespace egl
+{
+namespace
+{
+constexpr uint32_t kIndexMagic   = 0x43424E41;  // "ANBC"
+constexpr uint32_t kIndexVersion = 1;
+
+// Number of blobs the index can track, and how many slots after the one a key hashes to are
+// searched for it.
+constexpr uint32_t kIndexEntryCount = 4096;
+constexpr uint32_t kMaxProbeCount   = 32;
+
+constexpr unsigned long long kChecksumSeed = 0xABCDEF98;
+
+constexpr char kIndexFileName[]     = "index";
+constexpr char kBlobFileExtension[] = ".blob";
+constexpr char kTempFileExtension[] = ".tmp";
+
+uint64_t ComputeChecksum(const uint8_t *data, size_t size)
+{
+    return XXH64(data, size, kChecksumSeed);
+}
+
+bool WriteFile(const std::string &path, const uint8_t *data, size_t size)
+{
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    size_t written = 0;
+    while (written < size)
+    {
+        ssize_t result = write(fd, data + written, size - written);
+        if (result < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (result <= 0)
+        {
+            break;
+        }
+        written += static_cast<size_t>(result);
+    }
+
+    return close(fd) == 0 && written == size;
+}
+
+bool ReadFile(const std::string &path, uint8_t *data, size_t size)
+{
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    size_t bytesRead = 0;
+    while (bytesRead < size)
+    {
+        ssize_t result = read(fd, data + bytesRead, size - bytesRead);
+        if (result < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (result <= 0)
+        {
+            break;
+        }
+        bytesRead += static_cast<size_t>(result);
+    }
+
+    close(fd);
+    return bytesRead == size;
+}
+
+// Holds an advisory lock on a file.  Locks held through the same file descriptor don't exclude
+// each other, so threads must be serialized separately.
+class ScopedFileLock final : angle::NonCopyable
+{
+  public:
+    ScopedFileLock(int fd, int operation) : mFd(fd), mLocked(false)
+    {
+        int result;
+        do
+        {
+            result = flock(mFd, operation);
+        } while (result != 0 && errno == EINTR);
+
+        mLocked = result == 0;
+        if (!mLocked)
+        {
+            WARN() << "Failed to lock the disk blob cache index: " << strerror(errno);
+        }
+    }
+    ~ScopedFileLock()
+    {
+        if (mLocked)
+        {
+            flock(mFd, LOCK_UN);
+        }
+    }
+
+    bool isLocked() const { return mLocked; }
+
+  private:
+    int mFd;
+    bool mLocked;
+};
+
+// Returns the process that writes a temporary file, or 0 if the name isn't one of a temporary file.
+pid_t GetTempFileWriter(const std::string &fileName)
+{
+    const size_t extension = fileName.find(kTempFileExtension);
+    if (extension == std::string::npos)
+    {
+        return 0;
+    }
+    return static_cast<pid_t>(atoi(fileName.c_str() + extension + strlen(kTempFileExtension)));
+}
+}  // anonymous namespace
+
+// The index file is a header followed by a fixed-size hash table of entries.  Only fixed-size
+// types are used, as the file is shared by every process that uses the cache.
+struct DiskBlobCache::IndexHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t padding;
+    // Total size of the blobs.
+    uint64_t totalSize;
+    // Incremented on every use of a blob, to order the blobs by last use.
+    uint64_t useCounter;
+};
+
+struct DiskBlobCache::IndexEntry
+{
+    BlobCacheKey key;
+    // Zero if the entry is free.
+    uint32_t size;
+    uint64_t checksum;
+    uint64_t lastUse;
+};
+
+// static
+size_t DiskBlobCache::GetIndexFileSize()
+{
+    return sizeof(IndexHeader) + kIndexEntryCount * sizeof(IndexEntry);
+}
+
+// static
+std::unique_ptr<DiskBlobCache> DiskBlobCache::Open(const std::string &directory,
+                                                   size_t maxSizeBytes)
+{
+    std::unique_ptr<DiskBlobCache> cache(new DiskBlobCache(directory, maxSizeBytes));
+    if (!cache->initialize())
+    {
+        WARN() << "Failed to open the blob cache in " << directory;
+        return nullptr;
+    }
+    return cache;
+}
+
+DiskBlobCache::DiskBlobCache(const std::string &directory, size_t maxSizeBytes)
+    : mDirectory(directory),
+      mMaxSizeBytes(maxSizeBytes),
+      mTempFileCounter(0),
+      mIndexFd(-1),
+      mIndexMapping(MAP_FAILED),
+      mHeader(nullptr),
+      mEntries(nullptr)
+{}
+
+DiskBlobCache::~DiskBlobCache()
+{
+    if (mIndexMapping != MAP_FAILED)
+    {
+        munmap(mIndexMapping, GetIndexFileSize());
+    }
+    if (mIndexFd >= 0)
+    {
+        close(mIndexFd);
+    }
+}
+
+bool DiskBlobCache::initialize()
+{
+    if (mkdir(mDirectory.c_str(), 0700) != 0 && errno != EEXIST)
+    {
+        return false;
+    }
+
+    const std::string indexPath = mDirectory + "/" + kIndexFileName;
+    mIndexFd                    = open(indexPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (mIndexFd < 0)
+    {
+        return false;
+    }
+
+    ScopedFileLock fileLock(mIndexFd, LOCK_EX);
+    if (!fileLock.isLocked())
+    {
+        return false;
+    }
+
+    const size_t indexFileSize = GetIndexFileSize();
+    struct stat indexStat;
+    if (fstat(mIndexFd, &indexStat) != 0)
+    {
+        return false;
+    }
+
+    // An index of the wrong size is from another version of ANGLE, or was never written.  Start
+    // over with an empty one.
+    bool resetIndex = static_cast<size_t>(indexStat.st_size) != indexFileSize;
+    if (resetIndex && (ftruncate(mIndexFd, 0) != 0 || ftruncate(mIndexFd, indexFileSize) != 0))
+    {
+        return false;
+    }
+
+    mIndexMapping = mmap(nullptr, indexFileSize, PROT_READ | PROT_WRITE, MAP_SHARED, mIndexFd, 0);
+    if (mIndexMapping == MAP_FAILED)
+    {
+        return false;
+    }
+    mHeader  = reinterpret_cast<IndexHeader *>(mIndexMapping);
+    mEntries = reinterpret_cast<IndexEntry *>(mHeader + 1);
+
+    resetIndex = resetIndex || mHeader->magic != kIndexMagic ||
+                 mHeader->version != kIndexVersion || mHeader->entryCount != kIndexEntryCount;
+    if (resetIndex)
+    {
+        memset(mIndexMapping, 0, indexFileSize);
+        mHeader->magic      = kIndexMagic;
+        mHeader->version    = kIndexVersion;
+        mHeader->entryCount = kIndexEntryCount;
+
+        // Blobs left behind by the old index would never be evicted.  This also catches temporary
+        // files of writers that didn't finish.
+        if (DIR *dir = opendir(mDirectory.c_str()))
+        {
+            while (const dirent *dirEntry = readdir(dir))
+            {
+                const std::string fileName = dirEntry->d_name;
+                if (fileName.find(kBlobFileExtension) != std::string::npos)
+                {
+                    unlink((mDirectory + "/" + fileName).c_str());
+                }
+            }
+            closedir(dir);
+        }
+    }
+    else
+    {
+        removeStaleTempFiles();
+    }
+
+    return true;
+}
+
+void DiskBlobCache::removeStaleTempFiles()
+{
+    // Temporary files are left behind by writers that crashed or were killed before renaming
+    // them.  Those of processes that are still running may be renamed yet.
+    DIR *dir = opendir(mDirectory.c_str());
+    if (dir == nullptr)
+    {
+        return;
+    }
+
+    while (const dirent *dirEntry = readdir(dir))
+    {
+        const std::string fileName = dirEntry->d_name;
+        const pid_t writer         = GetTempFileWriter(fileName);
+        if (writer > 0 && kill(writer, 0) != 0 && errno == ESRCH)
+        {
+            unlink((mDirectory + "/" + fileName).c_str());
+        }
+    }
+    closedir(dir);
+}
+
+void DiskBlobCache::put(const BlobCacheKey &key, const uint8_t *data, size_t size)
+{
+    if (size == 0 || size > mMaxSizeBytes || size > std::numeric_limits<uint32_t>::max())
+    {
+        return;
+    }
+
+    // The temporary file's name tells which process writes it, so that files left behind by
+    // processes that died can be cleaned up.  The counter keeps threads of this process apart.
+    const uint64_t checksum    = ComputeChecksum(data, size);
+    const std::string blobPath = getBlobPath(key);
+    const std::string tempPath = blobPath + kTempFileExtension + std::to_string(getpid()) + "." +
+                                 std::to_string(mTempFileCounter++);
+
+    // Write the blob out before taking any lock, so neither other threads nor other processes are
+    // blocked on it.  It's renamed in place once the index is ready to point at it.
+    if (!WriteFile(tempPath, data, size))
+    {
+        unlink(tempPath.c_str());
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    ScopedFileLock fileLock(mIndexFd, LOCK_EX);
+    if (!fileLock.isLocked())
+    {
+        unlink(tempPath.c_str());
+        return;
+    }
+
+    IndexEntry *entry = findEntry(key);
+    if (entry != nullptr)
+    {
+        removeEntry(entry);
+    }
+
+    if (!makeRoom(size))
+    {
+        unlink(tempPath.c_str());
+        return;
+    }
+
+    entry = allocateEntry(key);
+    if (rename(tempPath.c_str(), blobPath.c_str()) != 0)
+    {
+        unlink(tempPath.c_str());
+        return;
+    }
+
+    entry->key      = key;
+    entry->size     = static_cast<uint32_t>(size);
+    entry->checksum = checksum;
+    entry->lastUse  = ++mHeader->useCounter;
+    mHeader->totalSize += size;
+}
+
+bool DiskBlobCache::get(angle::ScratchBuffer *scratchBuffer,
+                        const BlobCacheKey &key,
+                        BlobCache::Value *valueOut)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    uint64_t checksum = 0;
+    {
+        // Writers rename blobs in place while holding the lock exclusively, so the blob can't
+        // change while it's read.
+        ScopedFileLock fileLock(mIndexFd, LOCK_SH);
+        if (!fileLock.isLocked())
+        {
+            return false;
+        }
+
+        IndexEntry *entry = findEntry(key);
+        if (entry == nullptr)
+        {
+            return false;
+        }
+
+        checksum          = entry->checksum;
+        const size_t size = entry->size;
+
+        // The scratch buffer may be larger than requested.
+        angle::MemoryBuffer *scratchMemory;
+        if (!scratchBuffer->get(size, &scratchMemory))
+        {
+            ERR() << "Failed to allocate memory for binary blob";
+            return false;
+        }
+
+        if (ReadFile(getBlobPath(key), scratchMemory->data(), size) &&
+            ComputeChecksum(scratchMemory->data(), size) == checksum)
+        {
+            // Other processes may be reading too, so the use counter is updated atomically.
+            __atomic_store_n(&entry->lastUse,
+                             __atomic_add_fetch(&mHeader->useCounter, 1, __ATOMIC_RELAXED),
+                             __ATOMIC_RELAXED);
+
+            *valueOut = BlobCache::Value(scratchMemory->data(), size);
+            return true;
+        }
+    }
+
+    // The blob is missing or corrupt; drop it, unless it was replaced in the meantime.
+    WARN() << "Removing corrupt blob from the disk cache";
+    ScopedFileLock fileLock(mIndexFd, LOCK_EX);
+    if (!fileLock.isLocked())
+    {
+        return false;
+    }
+
+    IndexEntry *entry = findEntry(key);
+    if (entry != nullptr && entry->checksum == checksum)
+    {
+        removeEntry(entry);
+    }
+    return false;
+}
+
+void DiskBlobCache::remove(const BlobCacheKey &key)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    ScopedFileLock fileLock(mIndexFd, LOCK_EX);
+    if (!fileLock.isLocked())
+    {
+        return;
+    }
+
+    IndexEntry *entry = findEntry(key);
+    if (entry != nullptr)
+    {
+        removeEntry(entry);
+    }
+}
+
+size_t DiskBlobCache::size() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    ScopedFileLock fileLock(mIndexFd, LOCK_SH);
+    return fileLock.isLocked() ? static_cast<size_t>(mHeader->totalSize) : 0;
+}
+
+DiskBlobCache::IndexEntry *DiskBlobCache::findEntry(const BlobCacheKey &key)
+{
+    // The keys are SHA-1 hashes, so their first bytes are as good as a hash.
+    uint32_t slot;
+    memcpy(&slot, key.data(), sizeof(slot));
+
+    for (uint32_t probe = 0; probe < kMaxProbeCount; ++probe)
+    {
+        IndexEntry *entry = &mEntries[(slot + probe) % kIndexEntryCount];
+        if (entry->size != 0 && entry->key == key)
+        {
+            return entry;
+        }
+    }
+
+    return nullptr;
+}
+
+DiskBlobCache::IndexEntry *DiskBlobCache::allocateEntry(const BlobCacheKey &key)
+{
+    uint32_t slot;
+    memcpy(&slot, key.data(), sizeof(slot));
+
+    // Take the first free slot, or evict the least recently used blob if there is none.
+    IndexEntry *leastRecentlyUsed = nullptr;
+    for (uint32_t probe = 0; probe < kMaxProbeCount; ++probe)
+    {
+        IndexEntry *entry = &mEntries[(slot + probe) % kIndexEntryCount];
+        if (entry->size == 0)
+        {
+            return entry;
+        }
+        if (leastRecentlyUsed == nullptr || entry->lastUse < leastRecentlyUsed->lastUse)
+        {
+            leastRecentlyUsed = entry;
+        }
+    }
+
+    removeEntry(leastRecentlyUsed);
+    return leastRecentlyUsed;
+}
+
+void DiskBlobCache::removeEntry(IndexEntry *entry)
+{
+    ASSERT(entry->size != 0);
+
+    unlink(getBlobPath(entry->key).c_str());
+    mHeader->totalSize -= entry->size;
+    memset(entry, 0, sizeof(*entry));
+}
+
+bool DiskBlobCache::makeRoom(size_t size)
+{
+    while (mHeader->totalSize + size > mMaxSizeBytes)
+    {
+        IndexEntry *leastRecentlyUsed = nullptr;
+        for (uint32_t index = 0; index < kIndexEntryCount; ++index)
+        {
+            IndexEntry *entry = &mEntries[index];
+            if (entry->size != 0 &&
+                (leastRecentlyUsed == nullptr || entry->lastUse < leastRecentlyUsed->lastUse))
+            {
+                leastRecentlyUsed = entry;
+            }
+        }
+
+        if (leastRecentlyUsed == nullptr)
+        {
+            // The index is out of sync with the total; trust the index.
+            mHeader->totalSize = 0;
+            break;
+        }
+
+        removeEntry(leastRecentlyUsed);
+    }
+
+    return size <= mMaxSizeBytes;
+}
+
+std::string DiskBlobCache::getBlobPath(const BlobCacheKey &key) const
+{
+    static constexpr char kHexDigits[] = "0123456789abcdef";
+
+    std::string path = mDirectory + "/";
+    for (uint8_t byte : key)
+    {
+        path.push_back(kHexDigits[byte >> 4]);
+        path.push_back(kHexDigits[byte & 0xF]);
+    }
+    path += kBlobFileExtension;
+    return path;
+}
+}  // namespace egl
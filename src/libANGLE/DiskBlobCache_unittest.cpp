@@ -0,0 +1,422 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// DiskBlobCache_unittest.cpp: Unit tests for the disk blob cache.
+
+#include <gtest/gtest.h>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <thread>
+
+#include "libANGLE/DiskBlobCache.h"
+
+namespace egl
+{
+namespace
+{
+BlobCacheKey MakeKey(uint8_t start)
+{
+    BlobCacheKey key;
+    for (size_t i = 0; i < key.size(); ++i)
+    {
+        key[i] = static_cast<uint8_t>(i + start);
+    }
+    return key;
+}
+
+std::vector<uint8_t> MakeBlob(size_t size, uint8_t start)
+{
+    std::vector<uint8_t> blob(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        blob[i] = static_cast<uint8_t>(i + start);
+    }
+    return blob;
+}
+
+class DiskBlobCacheTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char directory[] = "/tmp/angle_disk_blob_cache_XXXXXX";
+        ASSERT_NE(nullptr, mkdtemp(directory));
+        mDirectory = directory;
+    }
+
+    void TearDown() override
+    {
+        if (DIR *dir = opendir(mDirectory.c_str()))
+        {
+            while (const dirent *dirEntry = readdir(dir))
+            {
+                unlink((mDirectory + "/" + dirEntry->d_name).c_str());
+            }
+            closedir(dir);
+        }
+        rmdir(mDirectory.c_str());
+    }
+
+    std::unique_ptr<DiskBlobCache> openCache(size_t maxSize)
+    {
+        return DiskBlobCache::Open(mDirectory, maxSize);
+    }
+
+    void put(DiskBlobCache *cache, uint8_t keyStart, const std::vector<uint8_t> &blob)
+    {
+        cache->put(MakeKey(keyStart), blob.data(), blob.size());
+    }
+
+    bool matches(DiskBlobCache *cache, uint8_t keyStart, const std::vector<uint8_t> &blob)
+    {
+        BlobCache::Value value;
+        if (!cache->get(&mScratchBuffer, MakeKey(keyStart), &value))
+        {
+            return false;
+        }
+        return value.size() == blob.size() && memcmp(value.data(), blob.data(), blob.size()) == 0;
+    }
+
+    bool fileExists(const std::string &fileName) const
+    {
+        return access((mDirectory + "/" + fileName).c_str(), F_OK) == 0;
+    }
+
+    size_t countFiles(const char *extension) const
+    {
+        size_t count = 0;
+        if (DIR *dir = opendir(mDirectory.c_str()))
+        {
+            while (const dirent *dirEntry = readdir(dir))
+            {
+                if (strstr(dirEntry->d_name, extension) != nullptr)
+                {
+                    ++count;
+                }
+            }
+            closedir(dir);
+        }
+        return count;
+    }
+
+    std::string mDirectory;
+    angle::ScratchBuffer mScratchBuffer;
+};
+
+// Tests that blobs can be read back, including by another instance of the cache.
+TEST_F(DiskBlobCacheTest, PutAndGet)
+{
+    constexpr size_t kSize = 1024 * 1024;
+
+    std::unique_ptr<DiskBlobCache> cache = openCache(kSize);
+    ASSERT_NE(nullptr, cache);
+
+    const std::vector<uint8_t> blob0 = MakeBlob(1000, 0);
+    const std::vector<uint8_t> blob1 = MakeBlob(3000, 1);
+    put(cache.get(), 0, blob0);
+    put(cache.get(), 1, blob1);
+    EXPECT_EQ(blob0.size() + blob1.size(), cache->size());
+
+    EXPECT_TRUE(matches(cache.get(), 0, blob0));
+    EXPECT_TRUE(matches(cache.get(), 1, blob1));
+    EXPECT_FALSE(matches(cache.get(), 2, blob0));
+
+    // Another cache in the same directory, as another process would have, sees the same blobs,
+    // and its writes are visible to the first one.
+    std::unique_ptr<DiskBlobCache> otherCache = openCache(kSize);
+    ASSERT_NE(nullptr, otherCache);
+    EXPECT_TRUE(matches(otherCache.get(), 0, blob0));
+    EXPECT_TRUE(matches(otherCache.get(), 1, blob1));
+
+    const std::vector<uint8_t> blob2 = MakeBlob(500, 2);
+    put(otherCache.get(), 2, blob2);
+    EXPECT_TRUE(matches(cache.get(), 2, blob2));
+
+    // Replacing a blob replaces its size too.
+    const std::vector<uint8_t> newBlob0 = MakeBlob(10, 5);
+    put(cache.get(), 0, newBlob0);
+    EXPECT_TRUE(matches(otherCache.get(), 0, newBlob0));
+    EXPECT_EQ(newBlob0.size() + blob1.size() + blob2.size(), otherCache->size());
+}
+
+// Tests that the blobs survive the cache being closed and opened again.
+TEST_F(DiskBlobCacheTest, Persistence)
+{
+    constexpr size_t kSize = 1024 * 1024;
+
+    const std::vector<uint8_t> blob = MakeBlob(2000, 7);
+
+    {
+        std::unique_ptr<DiskBlobCache> cache = openCache(kSize);
+        ASSERT_NE(nullptr, cache);
+        put(cache.get(), 7, blob);
+    }
+
+    std::unique_ptr<DiskBlobCache> cache = openCache(kSize);
+    ASSERT_NE(nullptr, cache);
+    EXPECT_TRUE(matches(cache.get(), 7, blob));
+}
+
+// Tests that the least recently used blobs are evicted to stay within the size limit.
+TEST_F(DiskBlobCacheTest, Eviction)
+{
+    constexpr size_t kBlobSize = 1000;
+    constexpr size_t kSize     = 3 * kBlobSize;
+
+    std::unique_ptr<DiskBlobCache> cache = openCache(kSize);
+    ASSERT_NE(nullptr, cache);
+
+    std::vector<std::vector<uint8_t>> blobs;
+    for (uint8_t index = 0; index < 4; ++index)
+    {
+        blobs.push_back(MakeBlob(kBlobSize, index));
+    }
+
+    put(cache.get(), 0, blobs[0]);
+    put(cache.get(), 1, blobs[1]);
+    put(cache.get(), 2, blobs[2]);
+
+    // Use blob 0, so blob 1 is the least recently used one.
+    EXPECT_TRUE(matches(cache.get(), 0, blobs[0]));
+
+    put(cache.get(), 3, blobs[3]);
+    EXPECT_EQ(kSize, cache->size());
+    EXPECT_TRUE(matches(cache.get(), 0, blobs[0]));
+    EXPECT_FALSE(matches(cache.get(), 1, blobs[1]));
+    EXPECT_TRUE(matches(cache.get(), 2, blobs[2]));
+    EXPECT_TRUE(matches(cache.get(), 3, blobs[3]));
+
+    // Blobs larger than the cache are not stored.
+    put(cache.get(), 4, MakeBlob(kSize + 1, 4));
+    EXPECT_FALSE(matches(cache.get(), 4, MakeBlob(kSize + 1, 4)));
+    EXPECT_EQ(kSize, cache->size());
+}
+
+// Tests that a blob whose file was corrupted is reported missing and removed.
+TEST_F(DiskBlobCacheTest, Corruption)
+{
+    constexpr size_t kSize = 1024 * 1024;
+
+    std::unique_ptr<DiskBlobCache> cache = openCache(kSize);
+    ASSERT_NE(nullptr, cache);
+
+    const std::vector<uint8_t> blob = MakeBlob(100, 9);
+    put(cache.get(), 9, blob);
+    ASSERT_TRUE(matches(cache.get(), 9, blob));
+
+    // Flip a byte in the blob's file.
+    bool corrupted = false;
+    if (DIR *dir = opendir(mDirectory.c_str()))
+    {
+        while (const dirent *dirEntry = readdir(dir))
+        {
+            const std::string fileName = dirEntry->d_name;
+            if (fileName.find(".blob") == std::string::npos)
+            {
+                continue;
+            }
+
+            int fd = open((mDirectory + "/" + fileName).c_str(), O_WRONLY);
+            ASSERT_GE(fd, 0);
+            const uint8_t byte = static_cast<uint8_t>(~blob[50]);
+            corrupted          = pwrite(fd, &byte, 1, 50) == 1;
+            close(fd);
+        }
+        closedir(dir);
+    }
+    ASSERT_TRUE(corrupted);
+
+    EXPECT_FALSE(matches(cache.get(), 9, blob));
+    EXPECT_EQ(0u, cache->size());
+}
+
+// Tests that removing a blob deletes its file too, so it doesn't come back when the cache is
+// opened again.
+TEST_F(DiskBlobCacheTest, Remove)
+{
+    constexpr size_t kSize = 1024 * 1024;
+
+    const std::vector<uint8_t> blob0 = MakeBlob(100, 0);
+    const std::vector<uint8_t> blob1 = MakeBlob(200, 1);
+
+    {
+        std::unique_ptr<DiskBlobCache> cache = openCache(kSize);
+        ASSERT_NE(nullptr, cache);
+        put(cache.get(), 0, blob0);
+        put(cache.get(), 1, blob1);
+        EXPECT_EQ(2u, countFiles(".blob"));
+
+        cache->remove(MakeKey(0));
+        EXPECT_FALSE(matches(cache.get(), 0, blob0));
+        EXPECT_EQ(blob1.size(), cache->size());
+        EXPECT_EQ(1u, countFiles(".blob"));
+
+        // Removing a blob that isn't there does nothing.
+        cache->remove(MakeKey(0));
+        EXPECT_EQ(blob1.size(), cache->size());
+    }
+
+    std::unique_ptr<DiskBlobCache> cache = openCache(kSize);
+    ASSERT_NE(nullptr, cache);
+    EXPECT_FALSE(matches(cache.get(), 0, blob0));
+    EXPECT_TRUE(matches(cache.get(), 1, blob1));
+}
+
+// Tests that temporary files left behind by processes that died are removed when the cache is
+// opened, and those of running processes are not.
+TEST_F(DiskBlobCacheTest, StaleTempFiles)
+{
+    constexpr size_t kSize = 1024 * 1024;
+
+    {
+        std::unique_ptr<DiskBlobCache> cache = openCache(kSize);
+        ASSERT_NE(nullptr, cache);
+    }
+
+    // A process that has exited.
+    pid_t deadPid = fork();
+    ASSERT_GE(deadPid, 0);
+    if (deadPid == 0)
+    {
+        _exit(0);
+    }
+    ASSERT_EQ(deadPid, waitpid(deadPid, nullptr, 0));
+
+    const std::string staleName = "00.blob.tmp" + std::to_string(deadPid) + ".0";
+    const std::string liveName  = "01.blob.tmp" + std::to_string(getpid()) + ".0";
+    for (const std::string &name : {staleName, liveName})
+    {
+        int fd = open((mDirectory + "/" + name).c_str(), O_WRONLY | O_CREAT, 0600);
+        ASSERT_GE(fd, 0);
+        close(fd);
+    }
+
+    std::unique_ptr<DiskBlobCache> cache = openCache(kSize);
+    ASSERT_NE(nullptr, cache);
+    EXPECT_FALSE(fileExists(staleName));
+    EXPECT_TRUE(fileExists(liveName));
+}
+
+// Tests that threads writing the same and different blobs at the same time don't corrupt each
+// other's blobs or the index.
+TEST_F(DiskBlobCacheTest, ConcurrentWriters)
+{
+    constexpr size_t kSize            = 1024 * 1024;
+    constexpr size_t kThreadCount     = 4;
+    constexpr size_t kIterationCount  = 50;
+    constexpr size_t kSharedBlobSize  = 3000;
+    constexpr size_t kPrivateBlobSize = 1000;
+
+    std::unique_ptr<DiskBlobCache> cache = openCache(kSize);
+    ASSERT_NE(nullptr, cache);
+
+    // Every thread writes the same contents for the shared key, so any complete blob is right.
+    const std::vector<uint8_t> sharedBlob = MakeBlob(kSharedBlobSize, 100);
+
+    std::vector<std::thread> threads;
+    std::vector<size_t> failureCounts(kThreadCount, 0);
+    for (size_t threadIndex = 0; threadIndex < kThreadCount; ++threadIndex)
+    {
+        threads.emplace_back([&, threadIndex]() {
+            angle::ScratchBuffer scratchBuffer;
+            const uint8_t privateKey               = static_cast<uint8_t>(threadIndex);
+            const std::vector<uint8_t> privateBlob = MakeBlob(kPrivateBlobSize, privateKey);
+            for (size_t iteration = 0; iteration < kIterationCount; ++iteration)
+            {
+                cache->put(MakeKey(100), sharedBlob.data(), sharedBlob.size());
+                cache->put(MakeKey(privateKey), privateBlob.data(), privateBlob.size());
+
+                BlobCache::Value value;
+                if (!cache->get(&scratchBuffer, MakeKey(privateKey), &value) ||
+                    value.size() != privateBlob.size() ||
+                    memcmp(value.data(), privateBlob.data(), privateBlob.size()) != 0)
+                {
+                    ++failureCounts[threadIndex];
+                }
+            }
+        });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (size_t failureCount : failureCounts)
+    {
+        EXPECT_EQ(0u, failureCount);
+    }
+    EXPECT_TRUE(matches(cache.get(), 100, sharedBlob));
+    EXPECT_EQ(kSharedBlobSize + kThreadCount * kPrivateBlobSize, cache->size());
+    EXPECT_EQ(0u, countFiles(".tmp"));
+}
+
+// Tests that processes sharing the cache directory see each other's blobs, and that their writes
+// at the same time leave the index consistent.
+TEST_F(DiskBlobCacheTest, ConcurrentProcesses)
+{
+    constexpr size_t kSize            = 1024 * 1024;
+    constexpr size_t kProcessCount    = 4;
+    constexpr size_t kBlobsPerProcess = 16;
+    constexpr size_t kBlobSize        = 2000;
+
+    std::vector<pid_t> children;
+    for (size_t processIndex = 0; processIndex < kProcessCount; ++processIndex)
+    {
+        pid_t pid = fork();
+        ASSERT_GE(pid, 0);
+        if (pid == 0)
+        {
+            // Each process writes blobs of its own and one that every process writes, and reads
+            // them back.  Anything unexpected is reported through the exit code.
+            std::unique_ptr<DiskBlobCache> cache = openCache(kSize);
+            if (cache == nullptr)
+            {
+                _exit(1);
+            }
+
+            const std::vector<uint8_t> sharedBlob = MakeBlob(kBlobSize, 200);
+            for (size_t blobIndex = 0; blobIndex < kBlobsPerProcess; ++blobIndex)
+            {
+                const uint8_t key =
+                    static_cast<uint8_t>(processIndex * kBlobsPerProcess + blobIndex);
+                put(cache.get(), key, MakeBlob(kBlobSize, key));
+                put(cache.get(), 200, sharedBlob);
+                if (!matches(cache.get(), key, MakeBlob(kBlobSize, key)))
+                {
+                    _exit(2);
+                }
+            }
+            _exit(0);
+        }
+        children.push_back(pid);
+    }
+
+    for (pid_t child : children)
+    {
+        int status = 0;
+        ASSERT_EQ(child, waitpid(child, &status, 0));
+        ASSERT_TRUE(WIFEXITED(status));
+        EXPECT_EQ(0, WEXITSTATUS(status));
+    }
+
+    std::unique_ptr<DiskBlobCache> cache = openCache(kSize);
+    ASSERT_NE(nullptr, cache);
+    for (size_t key = 0; key < kProcessCount * kBlobsPerProcess; ++key)
+    {
+        EXPECT_TRUE(matches(cache.get(), static_cast<uint8_t>(key),
+                            MakeBlob(kBlobSize, static_cast<uint8_t>(key))));
+    }
+    EXPECT_TRUE(matches(cache.get(), 200, MakeBlob(kBlobSize, 200)));
+    EXPECT_EQ((kProcessCount * kBlobsPerProcess + 1) * kBlobSize, cache->size());
+    EXPECT_EQ(0u, countFiles(".tmp"));
+}
+}  // anonymous namespace
+}  // namespace egl
@@ -0,0 +1,47 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// DiskBlobCache_unsupported.cpp: DiskBlobCache for platforms without a disk cache implementation.
+
+#include "libANGLE/DiskBlobCache.h"
+
+#include "common/debug.h"
+
+namespace egl
+{
+// static
+std::unique_ptr<DiskBlobCache> DiskBlobCache::Open(const std::string &directory,
+                                                   size_t maxSizeBytes)
+{
+    WARN() << "The disk blob cache is not supported on this platform";
+    return nullptr;
+}
+
+DiskBlobCache::~DiskBlobCache() {}
+
+void DiskBlobCache::put(const BlobCacheKey &key, const uint8_t *data, size_t size)
+{
+    UNREACHABLE();
+}
+
+bool DiskBlobCache::get(angle::ScratchBuffer *scratchBuffer,
+                        const BlobCacheKey &key,
+                        BlobCache::Value *valueOut)
+{
+    UNREACHABLE();
+    return false;
+}
+
+void DiskBlobCache::remove(const BlobCacheKey &key)
+{
+    UNREACHABLE();
+}
+
+size_t DiskBlobCache::size() const
+{
+    UNREACHABLE();
+    return 0;
+}
+}  // namespace egl
@@ -31,6 +31,7 @@
 #include "gpu_info_util/SystemInfo.h"
 #include "libANGLE/Context.h"
 #include "libANGLE/Device.h"
+#include "libANGLE/DiskBlobCache.h"
 #include "libANGLE/EGLSync.h"
 #include "libANGLE/FrameCapture.h"
 #include "libANGLE/Image.h"
@@ -478,6 +479,11 @@ void ANGLESetDefaultDisplayPlatform(angle::EGLDisplayType display)
 
 static constexpr uint32_t kScratchBufferLifetime = 64u;
 
+// Setting this to a directory persists the blob cache there, when the application doesn't provide
+// blob cache callbacks.
+constexpr char kDiskBlobCacheDirVarName[] = "ANGLE_DISK_BLOB_CACHE_DIR";
+constexpr size_t kDiskBlobCacheMaxSize    = 64 * 1024 * 1024;
+
 }  // anonymous namespace
 
 // ShareGroup
@@ -813,6 +819,15 @@ Error Display::initialize()
         mBlobCache.resize(1024 * 1024);
     }
 
+    if (!mBlobCache.hasDiskCache())
+    {
+        std::string diskBlobCacheDir = angle::GetEnvironmentVar(kDiskBlobCacheDirVarName);
+        if (!diskBlobCacheDir.empty())
+        {
+            mBlobCache.setDiskCache(DiskBlobCache::Open(diskBlobCacheDir, kDiskBlobCacheMaxSize));
+        }
+    }
+
     setGlobalDebugAnnotator();
 
     gl::InitializeDebugMutexIfNeeded();
@@ -13,9 +13,13 @@
 #include <cstring>
 #include <fstream>
 #include <string>
+#include <unordered_map>
 
 #include "sys/stat.h"
 
+#include "common/frame_capture_binary_format.h"
+#include "common/frame_capture_binary_writer.h"
+#include "common/hash_utils.h"
 #include "common/mathutil.h"
 #include "common/string_utils.h"
 #include "common/system_utils.h"
@@ -58,13 +62,16 @@ constexpr char kCaptureTriggerVarName[]        = "ANGLE_CAPTURE_TRIGGER";
 constexpr char kCaptureLabel[]                 = "ANGLE_CAPTURE_LABEL";
 constexpr char kCompression[]                  = "ANGLE_CAPTURE_COMPRESSION";
 constexpr char kSerializeStateEnabledVarName[] = "ANGLE_CAPTURE_SERIALIZE_STATE";
+constexpr char kFormatVarName[]                = "ANGLE_CAPTURE_FORMAT";
 
-constexpr size_t kBinaryAlignment   = 16;
 constexpr size_t kFunctionSizeLimit = 5000;
 
 // Limit based on MSVC Compiler Error C2026
 constexpr size_t kStringLengthLimit = 16380;
 
+// Number of captured frames that can wait for the capture worker before capture blocks.
+constexpr size_t kMaxPendingCaptureFrames = 3;
+
 // Android debug properties that correspond to the above environment variables
 constexpr char kAndroidCaptureEnabled[] = "debug.angle.capture.enabled";
 constexpr char kAndroidOutDir[]         = "debug.angle.capture.out_dir";
@@ -73,6 +80,7 @@ constexpr char kAndroidFrameEnd[]       = "debug.angle.capture.frame_end";
 constexpr char kAndroidCaptureTrigger[] = "debug.angle.capture.trigger";
 constexpr char kAndroidCaptureLabel[]   = "debug.angle.capture.label";
 constexpr char kAndroidCompression[]    = "debug.angle.capture.compression";
+constexpr char kAndroidFormat[]         = "debug.angle.capture.format";
 
 std::string GetDefaultOutDirectory()
 {
@@ -471,7 +479,7 @@ void WriteBinaryParamReplay(DataTracker *dataTracker,
                             std::ostream &header,
                             const CallCapture &call,
                             const ParamCapture &param,
-                            std::vector<uint8_t> *binaryData)
+                            BinaryDataStore *binaryData)
 {
     int counter = dataTracker->getCounters().getAndIncrement(call.entryPoint, param.name);
 
@@ -505,10 +513,7 @@ void WriteBinaryParamReplay(DataTracker *dataTracker,
     else
     {
         // Store in binary file if data are not of type string or enum
-        // Round up to 16-byte boundary for cross ABI safety
-        size_t offset = rx::roundUpPow2(binaryData->size(), kBinaryAlignment);
-        binaryData->resize(offset + data.size());
-        memcpy(binaryData->data() + offset, data.data(), data.size());
+        size_t offset = binaryData->append(data.data(), data.size());
         out << "reinterpret_cast<" << ParamTypeToString(overrideType) << ">(&gBinaryData[" << offset
             << "])";
     }
@@ -519,11 +524,33 @@ uintptr_t SyncIndexValue(GLsync sync)
     return reinterpret_cast<uintptr_t>(sync);
 }
 
+// Depending on how a buffer is mapped, we may need to track its location for readback
+bool ShouldTrackMappedBufferPointer(const CallCapture &call)
+{
+    if (call.entryPoint == EntryPoint::GLMapBufferRange ||
+        call.entryPoint == EntryPoint::GLMapBufferRangeEXT)
+    {
+        GLbitfield access =
+            call.params.getParam("access", ParamType::TGLbitfield, 3).value.GLbitfieldVal;
+
+        return (access & GL_MAP_WRITE_BIT) != 0;
+    }
+
+    if (call.entryPoint == EntryPoint::GLMapBuffer || call.entryPoint == EntryPoint::GLMapBufferOES)
+    {
+        GLenum access = call.params.getParam("access", ParamType::TGLenum, 1).value.GLenumVal;
+
+        return access == GL_WRITE_ONLY_OES || access == GL_WRITE_ONLY || access == GL_READ_WRITE;
+    }
+
+    return false;
+}
+
 void WriteCppReplayForCall(const CallCapture &call,
                            DataTracker *dataTracker,
                            std::ostream &out,
                            std::ostream &header,
-                           std::vector<uint8_t> *binaryData)
+                           BinaryDataStore *binaryData)
 {
     std::ostringstream callOut;
 
@@ -540,27 +567,7 @@ void WriteCppReplayForCall(const CallCapture &call,
         callOut << "gSyncMap[" << SyncIndexValue(sync) << "] = ";
     }
 
-    // Depending on how a buffer is mapped, we may need to track its location for readback
-    bool trackBufferPointer = false;
-
-    if (call.entryPoint == EntryPoint::GLMapBufferRange ||
-        call.entryPoint == EntryPoint::GLMapBufferRangeEXT)
-    {
-        GLbitfield access =
-            call.params.getParam("access", ParamType::TGLbitfield, 3).value.GLbitfieldVal;
-
-        trackBufferPointer = access & GL_MAP_WRITE_BIT;
-    }
-
-    if (call.entryPoint == EntryPoint::GLMapBuffer || call.entryPoint == EntryPoint::GLMapBufferOES)
-    {
-        GLenum access = call.params.getParam("access", ParamType::TGLenum, 1).value.GLenumVal;
-
-        trackBufferPointer =
-            access == GL_WRITE_ONLY_OES || access == GL_WRITE_ONLY || access == GL_READ_WRITE;
-    }
-
-    if (trackBufferPointer)
+    if (ShouldTrackMappedBufferPointer(call))
     {
         // Track the returned pointer so we update its data when unmapped
         gl::BufferID bufferID = call.params.getMappedBufferID();
@@ -754,15 +761,10 @@ std::string GetBinaryDataFilePath(bool compression,
     return fnameStream.str();
 }
 
-void SaveBinaryData(bool compression,
-                    const std::string &outDir,
-                    gl::ContextID contextId,
-                    const std::string &captureLabel,
+void SaveDataToFile(bool compression,
+                    const std::string &dataFilepath,
                     const std::vector<uint8_t> &binaryData)
 {
-    std::string binaryDataFileName = GetBinaryDataFilePath(compression, contextId, captureLabel);
-    std::string dataFilepath       = outDir + binaryDataFileName;
-
     SaveFileHelper saveData(dataFilepath);
 
     if (compression)
@@ -791,6 +793,20 @@ void SaveBinaryData(bool compression,
     }
 }
 
+void SaveBinaryData(bool compression,
+                    const std::string &outDir,
+                    gl::ContextID contextId,
+                    const std::string &captureLabel,
+                    const BinaryDataStore &binaryData)
+{
+    std::string binaryDataFileName = GetBinaryDataFilePath(compression, contextId, captureLabel);
+    SaveDataToFile(compression, outDir + binaryDataFileName, binaryData.getData());
+
+    INFO() << "FrameCapture: " << binaryDataFileName << " holds " << binaryData.getData().size()
+           << " bytes of " << binaryData.getAppendedBytes() << " captured, "
+           << binaryData.getDeduplicatedBytes() << " bytes saved by deduplication";
+}
+
 void WriteLoadBinaryDataCall(bool compression,
                              std::ostream &out,
                              gl::ContextID contextId,
@@ -805,7 +821,7 @@ void MaybeResetResources(std::stringstream &out,
                          DataTracker *dataTracker,
                          std::stringstream &header,
                          ResourceTracker *resourceTracker,
-                         std::vector<uint8_t> *binaryData)
+                         BinaryDataStore *binaryData)
 {
     switch (resourceIDType)
     {
@@ -926,11 +942,11 @@ void MaybeResetResources(std::stringstream &out,
     }
 }
 
-void WriteCppReplayFunctionWithParts(const gl::Context *context,
+void WriteCppReplayFunctionWithParts(gl::ContextID contextId,
                                      ReplayFunc replayFunc,
                                      DataTracker *dataTracker,
                                      uint32_t frameIndex,
-                                     std::vector<uint8_t> *binaryData,
+                                     BinaryDataStore *binaryData,
                                      const std::vector<CallCapture> &calls,
                                      std::stringstream &header,
                                      std::stringstream &callStream,
@@ -945,8 +961,8 @@ void WriteCppReplayFunctionWithParts(const gl::Context *context,
     // overflowing the stack
     if (calls.size() > kFunctionSizeLimit)
     {
-        callStreamParts << "void "
-                        << FmtFunction(replayFunc, context->id(), frameIndex, ++partCount) << "\n";
+        callStreamParts << "void " << FmtFunction(replayFunc, contextId, frameIndex, ++partCount)
+                        << "\n";
         callStreamParts << "{\n";
     }
 
@@ -961,8 +977,7 @@ void WriteCppReplayFunctionWithParts(const gl::Context *context,
             callStreamParts << "}\n";
             callStreamParts << "\n";
             callStreamParts << "void "
-                            << FmtFunction(replayFunc, context->id(), frameIndex, ++partCount)
-                            << "\n";
+                            << FmtFunction(replayFunc, contextId, frameIndex, ++partCount) << "\n";
             callStreamParts << "{\n";
         }
     }
@@ -978,7 +993,7 @@ void WriteCppReplayFunctionWithParts(const gl::Context *context,
         // Write out the calls to the parts
         for (int i = 1; i <= partCount; i++)
         {
-            callStream << "    " << FmtFunction(replayFunc, context->id(), frameIndex, i) << ";\n";
+            callStream << "    " << FmtFunction(replayFunc, contextId, frameIndex, i) << ";\n";
         }
     }
     else
@@ -988,24 +1003,37 @@ void WriteCppReplayFunctionWithParts(const gl::Context *context,
     }
 }
 
+void SerializeContextState(const gl::Context *context, std::vector<uint8_t> *stateOut)
+{
+    gl::BinaryOutputStream serializedContextData{};
+    if (SerializeContext(&serializedContextData, const_cast<gl::Context *>(context)) ==
+        Result::Continue)
+    {
+        const uint8_t *data = static_cast<const uint8_t *>(serializedContextData.data());
+        stateOut->assign(data, data + serializedContextData.length());
+    }
+}
+
+// Doesn't touch the context, so it can run on the capture worker. |resourceTracker| is only used
+// for the last frame.
 void WriteCppReplay(bool compression,
                     const std::string &outDir,
-                    const gl::Context *context,
+                    gl::ContextID contextId,
                     const std::string &captureLabel,
                     uint32_t frameIndex,
                     uint32_t frameCount,
                     const std::vector<CallCapture> &frameCalls,
                     const std::vector<CallCapture> &setupCalls,
                     ResourceTracker *resourceTracker,
-                    std::vector<uint8_t> *binaryData,
-                    bool serializeStateEnabled)
+                    BinaryDataStore *binaryData,
+                    const std::vector<uint8_t> &serializedContextState)
 {
     DataTracker dataTracker;
 
     std::stringstream out;
     std::stringstream header;
 
-    header << "#include \"" << FmtCapturePrefix(context->id(), captureLabel) << ".h\"\n";
+    header << "#include \"" << FmtCapturePrefix(contextId, captureLabel) << ".h\"\n";
     header << "#include \"angle_trace_gl.h\"\n";
     header << "";
     header << "\n";
@@ -1022,11 +1050,11 @@ void WriteCppReplay(bool compression,
     {
         std::stringstream setupCallStream;
 
-        setupCallStream << "void " << FmtSetupFunction(context->id(), kNoPartId) << "\n";
+        setupCallStream << "void " << FmtSetupFunction(contextId, kNoPartId) << "\n";
         setupCallStream << "{\n";
 
-        WriteLoadBinaryDataCall(compression, setupCallStream, context->id(), captureLabel);
-        WriteCppReplayFunctionWithParts(context, ReplayFunc::Setup, &dataTracker, frameIndex,
+        WriteLoadBinaryDataCall(compression, setupCallStream, contextId, captureLabel);
+        WriteCppReplayFunctionWithParts(contextId, ReplayFunc::Setup, &dataTracker, frameIndex,
                                         binaryData, setupCalls, header, setupCallStream, out);
 
         out << setupCallStream.str();
@@ -1037,7 +1065,8 @@ void WriteCppReplay(bool compression,
     if (frameIndex == frameCount)
     {
         // Emit code to reset back to starting state
-        out << "void " << FmtResetFunction(context->id()) << "\n";
+        ASSERT(resourceTracker);
+        out << "void " << FmtResetFunction(contextId) << "\n";
         out << "{\n";
 
         std::stringstream restoreCallStream;
@@ -1059,34 +1088,26 @@ void WriteCppReplay(bool compression,
     {
         std::stringstream callStream;
 
-        callStream << "void " << FmtReplayFunction(context->id(), frameIndex) << "\n";
+        callStream << "void " << FmtReplayFunction(contextId, frameIndex) << "\n";
         callStream << "{\n";
 
-        WriteCppReplayFunctionWithParts(context, ReplayFunc::Replay, &dataTracker, frameIndex,
+        WriteCppReplayFunctionWithParts(contextId, ReplayFunc::Replay, &dataTracker, frameIndex,
                                         binaryData, frameCalls, header, callStream, out);
 
         out << callStream.str();
         out << "}\n";
     }
 
-    if (serializeStateEnabled)
+    if (!serializedContextState.empty())
     {
-        gl::BinaryOutputStream serializedContextData{};
-        if (SerializeContext(&serializedContextData, const_cast<gl::Context *>(context)) ==
-            Result::Continue)
-        {
-            size_t serializedContextLength = serializedContextData.length();
-            size_t serializedContextOffset = rx::roundUpPow2(binaryData->size(), kBinaryAlignment);
-            binaryData->resize(serializedContextOffset + serializedContextLength);
-            memcpy(binaryData->data() + serializedContextOffset, serializedContextData.data(),
-                   serializedContextLength);
-            out << "const uint8_t *"
-                << FmtGetSerializedContextStateFunction(context->id(), frameIndex) << "\n";
-            out << "{\n";
-            out << "    return &gBinaryData[" << serializedContextOffset << "];\n";
-            out << "}\n";
-            out << "\n";
-        }
+        size_t serializedContextOffset =
+            binaryData->append(serializedContextState.data(), serializedContextState.size());
+        out << "const uint8_t *" << FmtGetSerializedContextStateFunction(contextId, frameIndex)
+            << "\n";
+        out << "{\n";
+        out << "    return &gBinaryData[" << serializedContextOffset << "];\n";
+        out << "}\n";
+        out << "\n";
     }
 
     if (!captureLabel.empty())
@@ -1101,7 +1122,7 @@ void WriteCppReplay(bool compression,
         std::string headerString = header.str();
 
         std::string cppFilePath =
-            GetCaptureFilePath(outDir, context->id(), captureLabel, frameIndex, ".cpp");
+            GetCaptureFilePath(outDir, contextId, captureLabel, frameIndex, ".cpp");
 
         SaveFileHelper saveCpp(cppFilePath);
         saveCpp << headerString << "\n" << outString;
@@ -1119,8 +1140,7 @@ void WriteCppReplayIndexFiles(bool compression,
                               const HasResourceTypeMap &hasResourceType,
                               bool serializeStateEnabled,
                               bool writeResetContextCall,
-                              const egl::Config *config,
-                              std::vector<uint8_t> &binaryData)
+                              const egl::Config *config)
 {
 
     size_t maxClientArraySize = MaxClientArraySize(clientArraySizes);
@@ -3396,6 +3416,405 @@ bool FindShaderProgramIDInCall(const CallCapture &call, gl::ShaderProgramID *idO
 
     return false;
 }
+
+bool IsResourceIDValueParamType(ParamType paramType)
+{
+    switch (paramType)
+    {
+        case ParamType::TBufferID:
+        case ParamType::TFenceNVID:
+        case ParamType::TFramebufferID:
+        case ParamType::TMemoryObjectID:
+        case ParamType::TProgramPipelineID:
+        case ParamType::TQueryID:
+        case ParamType::TRenderbufferID:
+        case ParamType::TSamplerID:
+        case ParamType::TSemaphoreID:
+        case ParamType::TShaderProgramID:
+        case ParamType::TTextureID:
+        case ParamType::TTransformFeedbackID:
+        case ParamType::TVertexArrayID:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Returns the value of a scalar param as it is passed to the GL entry point.
+uint64_t GetBinaryParamValue(const ParamCapture &param)
+{
+    switch (param.type)
+    {
+        case ParamType::TAlphaTestFunc:
+            return gl::ToGLenum(param.value.AlphaTestFuncVal);
+        case ParamType::TBufferBinding:
+            return gl::ToGLenum(param.value.BufferBindingVal);
+        case ParamType::TBufferUsage:
+            return gl::ToGLenum(param.value.BufferUsageVal);
+        case ParamType::TClientVertexArrayType:
+            return gl::ToGLenum(param.value.ClientVertexArrayTypeVal);
+        case ParamType::TCullFaceMode:
+            return gl::ToGLenum(param.value.CullFaceModeVal);
+        case ParamType::TDrawElementsType:
+            return gl::ToGLenum(param.value.DrawElementsTypeVal);
+        case ParamType::TGraphicsResetStatus:
+            return gl::ToGLenum(param.value.GraphicsResetStatusVal);
+        case ParamType::THandleType:
+            return gl::ToGLenum(param.value.HandleTypeVal);
+        case ParamType::TLightParameter:
+            return gl::ToGLenum(param.value.LightParameterVal);
+        case ParamType::TLogicalOperation:
+            return gl::ToGLenum(param.value.LogicalOperationVal);
+        case ParamType::TMaterialParameter:
+            return gl::ToGLenum(param.value.MaterialParameterVal);
+        case ParamType::TMatrixType:
+            return gl::ToGLenum(param.value.MatrixTypeVal);
+        case ParamType::TPointParameter:
+            return gl::ToGLenum(param.value.PointParameterVal);
+        case ParamType::TPrimitiveMode:
+            return gl::ToGLenum(param.value.PrimitiveModeVal);
+        case ParamType::TProvokingVertexConvention:
+            return gl::ToGLenum(param.value.ProvokingVertexConventionVal);
+        case ParamType::TQueryType:
+            return gl::ToGLenum(param.value.QueryTypeVal);
+        case ParamType::TShaderType:
+            return gl::ToGLenum(param.value.ShaderTypeVal);
+        case ParamType::TShadingModel:
+            return gl::ToGLenum(param.value.ShadingModelVal);
+        case ParamType::TTextureEnvParameter:
+            return gl::ToGLenum(param.value.TextureEnvParameterVal);
+        case ParamType::TTextureEnvTarget:
+            return gl::ToGLenum(param.value.TextureEnvTargetVal);
+        case ParamType::TTextureTarget:
+            return gl::ToGLenum(param.value.TextureTargetVal);
+        case ParamType::TTextureType:
+            return gl::ToGLenum(param.value.TextureTypeVal);
+        case ParamType::TVertexAttribType:
+            return gl::ToGLenum(param.value.VertexAttribTypeVal);
+        case ParamType::TGLDEBUGPROC:
+        case ParamType::TGLDEBUGPROCKHR:
+            // Debug callbacks can't be replayed.
+            return 0;
+        default:
+        {
+            static_assert(sizeof(ParamValue) <= sizeof(uint64_t), "ParamValue doesn't fit a slot");
+            uint64_t value = 0;
+            memcpy(&value, &param.value, sizeof(ParamValue));
+            return value;
+        }
+    }
+}
+
+// Translates captured calls into the binary call stream described in
+// common/frame_capture_binary_format.h.
+class BinaryTraceWriter final : angle::NonCopyable
+{
+  public:
+    void writeSection(BinaryTraceSection section, const std::vector<CallCapture> &calls)
+    {
+        beginSection(section);
+        for (const CallCapture &call : calls)
+        {
+            writeCall(call);
+        }
+        endSection(section);
+    }
+
+    void beginSection(BinaryTraceSection section) { mStream.beginSection(section); }
+    void endSection(BinaryTraceSection section) { mStream.endSection(section); }
+
+    void writeCall(const CallCapture &call);
+    void serialize(uint32_t frameIndex, std::vector<uint8_t> *streamOut) const
+    {
+        mStream.serialize(frameIndex, streamOut);
+    }
+
+  private:
+    void writeParam(const CallCapture &call, const ParamCapture &param);
+
+    BinaryTraceStreamWriter mStream;
+};
+
+void BinaryTraceWriter::writeCall(const CallCapture &call)
+{
+    static_assert(static_cast<uint32_t>(ResourceIDType::EnumCount) <= kBinaryTraceMaxResourceTypes,
+                  "Too many resource ID types for the binary trace format");
+
+    std::string functionName = call.name();
+    if (call.entryPoint == EntryPoint::GLInvalid)
+    {
+        // The Update<Resource>ID helpers are folded into a single helper keyed by resource type.
+        for (ResourceIDType resourceIDType : AllEnums<ResourceIDType>())
+        {
+            std::string updateFuncName =
+                std::string("Update") + GetResourceIDTypeName(resourceIDType) + "ID";
+            if (call.customFunctionName == updateFuncName)
+            {
+                mStream.addParam(BinaryTraceParamKind::Value, 0, 0,
+                                 static_cast<uint64_t>(resourceIDType));
+                functionName = kBinaryTraceUpdateResourceID;
+                break;
+            }
+        }
+    }
+
+    BinaryTraceResultKind resultKind = BinaryTraceResultKind::Unused;
+    uint8_t resultType               = 0;
+    uint64_t resultKey               = 0;
+    if (call.entryPoint == EntryPoint::GLCreateShader ||
+        call.entryPoint == EntryPoint::GLCreateProgram)
+    {
+        resultKind = BinaryTraceResultKind::ResourceID;
+        resultType = static_cast<uint8_t>(ResourceIDType::ShaderProgram);
+        resultKey  = call.params.getReturnValue().value.GLuintVal;
+    }
+    else if (call.entryPoint == EntryPoint::GLFenceSync)
+    {
+        resultKind = BinaryTraceResultKind::Sync;
+        resultKey  = SyncIndexValue(call.params.getReturnValue().value.GLsyncVal);
+    }
+    else if (ShouldTrackMappedBufferPointer(call))
+    {
+        resultKind = BinaryTraceResultKind::MappedBuffer;
+        resultKey  = call.params.getMappedBufferID().value;
+    }
+
+    for (const ParamCapture &param : call.params.getParamCaptures())
+    {
+        writeParam(call, param);
+    }
+
+    mStream.addCall(functionName, resultKind, resultType, resultKey);
+}
+
+void BinaryTraceWriter::writeParam(const CallCapture &call, const ParamCapture &param)
+{
+    if (param.arrayClientPointerIndex != -1 && param.value.voidConstPointerVal != nullptr)
+    {
+        mStream.addParam(BinaryTraceParamKind::ClientArray, 0,
+                         static_cast<uint32_t>(param.arrayClientPointerIndex), 0);
+        return;
+    }
+
+    if (param.readBufferSizeBytes > 0)
+    {
+        mStream.addParam(BinaryTraceParamKind::ReadBuffer, 0,
+                         static_cast<uint32_t>(param.readBufferSizeBytes), 0);
+        return;
+    }
+
+    if (param.data.empty())
+    {
+        if (param.type == ParamType::TGLsync)
+        {
+            mStream.addParam(BinaryTraceParamKind::Sync, 0, 0,
+                             SyncIndexValue(param.value.GLsyncVal));
+        }
+        else if (param.type == ParamType::TUniformLocation &&
+                 param.value.UniformLocationVal.value != -1)
+        {
+            // A program ID of 0 selects the current program at replay time.
+            gl::ShaderProgramID programID = {0};
+            FindShaderProgramIDInCall(call, &programID);
+            mStream.addParam(BinaryTraceParamKind::UniformLocation,
+                             static_cast<uint8_t>(ResourceIDType::ShaderProgram), programID.value,
+                             GetBinaryParamValue(param));
+        }
+        else if (IsResourceIDValueParamType(param.type))
+        {
+            ResourceIDType resourceIDType = GetResourceIDTypeFromParamType(param.type);
+            mStream.addParam(BinaryTraceParamKind::ResourceID,
+                             static_cast<uint8_t>(resourceIDType), 0, GetBinaryParamValue(param));
+        }
+        else
+        {
+            mStream.addParam(BinaryTraceParamKind::Value, 0, 0, GetBinaryParamValue(param));
+        }
+        return;
+    }
+
+    if (param.type == ParamType::TGLcharConstPointerPointer)
+    {
+        std::vector<uint64_t> stringOffsets;
+        for (const std::vector<uint8_t> &data : param.data)
+        {
+            // null terminate C style string
+            ASSERT(data.size() > 0 && data.back() == '\0');
+            stringOffsets.push_back(mStream.appendData(data.data(), data.size()));
+        }
+        uint64_t offset =
+            mStream.appendData(stringOffsets.data(), stringOffsets.size() * sizeof(uint64_t));
+        mStream.addParam(BinaryTraceParamKind::StringArray, 0,
+                         static_cast<uint32_t>(stringOffsets.size()), offset);
+        return;
+    }
+
+    ASSERT(param.data.size() == 1);
+    const std::vector<uint8_t> &data = param.data[0];
+    uint64_t offset                  = mStream.appendData(data.data(), data.size());
+
+    ResourceIDType resourceIDType = GetResourceIDTypeFromParamType(param.type);
+    if (resourceIDType != ResourceIDType::InvalidEnum)
+    {
+        mStream.addParam(BinaryTraceParamKind::ResourceIDArray,
+                         static_cast<uint8_t>(resourceIDType),
+                         static_cast<uint32_t>(data.size() / sizeof(GLuint)), offset);
+    }
+    else
+    {
+        mStream.addParam(BinaryTraceParamKind::Data, 0, 0, offset);
+    }
+}
+
+// Mirrors the buffer handling of MaybeResetResources.
+void WriteBinaryResetCalls(ResourceTracker *resourceTracker, BinaryTraceWriter *writer)
+{
+    BufferSet &newBuffers           = resourceTracker->getNewBuffers();
+    BufferCalls &bufferRegenCalls   = resourceTracker->getBufferRegenCalls();
+    BufferCalls &bufferRestoreCalls = resourceTracker->getBufferRestoreCalls();
+    BufferCalls &bufferMapCalls     = resourceTracker->getBufferMapCalls();
+    BufferCalls &bufferUnmapCalls   = resourceTracker->getBufferUnmapCalls();
+
+    // If we have any new buffers generated and not deleted during the run, delete them now
+    if (!newBuffers.empty())
+    {
+        std::vector<gl::BufferID> deleteBuffers(newBuffers.begin(), newBuffers.end());
+
+        ParamBuffer params;
+        params.addValueParam("n", ParamType::TGLsizei, static_cast<GLsizei>(deleteBuffers.size()));
+        ParamCapture buffersParam("buffersPacked", ParamType::TBufferIDConstPointer);
+        CaptureMemory(deleteBuffers.data(), deleteBuffers.size() * sizeof(gl::BufferID),
+                      &buffersParam);
+        params.addParam(std::move(buffersParam));
+
+        writer->writeCall(CallCapture(EntryPoint::GLDeleteBuffers, std::move(params)));
+    }
+
+    // If any of our starting buffers were deleted during the run, recreate them
+    for (const gl::BufferID id : resourceTracker->getBuffersToRegen())
+    {
+        for (CallCapture &call : bufferRegenCalls[id])
+        {
+            writer->writeCall(call);
+        }
+    }
+
+    // If any of our starting buffers were modified during the run, restore their contents
+    for (const gl::BufferID id : resourceTracker->getBuffersToRestore())
+    {
+        if (resourceTracker->getStartingBuffersMappedCurrent(id))
+        {
+            for (CallCapture &call : bufferUnmapCalls[id])
+            {
+                writer->writeCall(call);
+            }
+        }
+
+        for (CallCapture &call : bufferRestoreCalls[id])
+        {
+            writer->writeCall(call);
+            resourceTracker->setBufferUnmapped(id);
+        }
+    }
+
+    // Update the map/unmap of buffers to match the starting state
+    for (const gl::BufferID id : resourceTracker->getStartingBuffers())
+    {
+        bool mappedInitial = resourceTracker->getStartingBuffersMappedInitial(id);
+        bool mappedCurrent = resourceTracker->getStartingBuffersMappedCurrent(id);
+
+        if (mappedInitial && !mappedCurrent)
+        {
+            for (CallCapture &call : bufferMapCalls[id])
+            {
+                writer->writeCall(call);
+            }
+        }
+        if (!mappedInitial && mappedCurrent)
+        {
+            for (CallCapture &call : bufferUnmapCalls[id])
+            {
+                writer->writeCall(call);
+            }
+        }
+    }
+
+    // Restore buffer bindings as seen during MEC
+    for (CallCapture &call : resourceTracker->getBufferBindingCalls())
+    {
+        writer->writeCall(call);
+    }
+}
+
+std::string GetBinaryStreamSuffix(bool compression)
+{
+    std::string suffix = kBinaryTraceStreamExtension;
+    if (compression)
+    {
+        suffix += ".gz";
+    }
+    return suffix;
+}
+
+// Like WriteCppReplay, this can run on the capture worker.
+void WriteBinaryReplay(bool compression,
+                       const std::string &outDir,
+                       gl::ContextID contextId,
+                       const std::string &captureLabel,
+                       uint32_t frameIndex,
+                       uint32_t frameCount,
+                       const std::vector<CallCapture> &frameCalls,
+                       const std::vector<CallCapture> &setupCalls,
+                       ResourceTracker *resourceTracker)
+{
+    BinaryTraceWriter writer;
+
+    if (frameIndex == 1)
+    {
+        writer.writeSection(BinaryTraceSection::Setup, setupCalls);
+    }
+
+    writer.writeSection(BinaryTraceSection::Frame, frameCalls);
+
+    if (frameIndex == frameCount)
+    {
+        ASSERT(resourceTracker);
+        writer.beginSection(BinaryTraceSection::Reset);
+        WriteBinaryResetCalls(resourceTracker, &writer);
+        writer.endSection(BinaryTraceSection::Reset);
+    }
+
+    std::vector<uint8_t> stream;
+    writer.serialize(frameIndex, &stream);
+
+    std::string streamFilePath = GetCaptureFilePath(outDir, contextId, captureLabel, frameIndex,
+                                                    GetBinaryStreamSuffix(compression).c_str());
+    SaveDataToFile(compression, streamFilePath, stream);
+}
+
+void WriteBinaryReplayIndexFile(bool compression,
+                                const std::string &outDir,
+                                gl::ContextID contextId,
+                                const std::string &captureLabel,
+                                uint32_t frameCount,
+                                const SurfaceDimensions &drawSurfaceDimensions)
+{
+    BinaryTraceIndex index  = {};
+    index.magic             = kBinaryTraceIndexMagic;
+    index.version           = kBinaryTraceVersion;
+    index.frameStart        = 1;
+    index.frameEnd          = frameCount;
+    index.drawSurfaceWidth  = static_cast<uint32_t>(drawSurfaceDimensions.at(contextId).width);
+    index.drawSurfaceHeight = static_cast<uint32_t>(drawSurfaceDimensions.at(contextId).height);
+    index.compressed        = compression ? 1 : 0;
+
+    std::stringstream indexPathStream;
+    indexPathStream << outDir << FmtCapturePrefix(contextId, captureLabel)
+                    << kBinaryTraceIndexExtension;
+
+    SaveFileHelper saveIndex(indexPathStream.str());
+    saveIndex.write(reinterpret_cast<const uint8_t *>(&index), sizeof(index));
+}
 }  // namespace
 
 ParamCapture::ParamCapture() : type(ParamType::TGLenum), enumGroup(gl::GLenumGroup::DefaultGroup) {}
@@ -3549,10 +3968,85 @@ ReplayContext::ReplayContext(size_t readBufferSizebytes,
 }
 ReplayContext::~ReplayContext() {}
 
+FrameCaptureWorker::FrameCaptureWorker(size_t maxPendingTasks)
+    : mTasks(maxPendingTasks), mHead(0), mTail(0), mStopping(false)
+{
+    ASSERT(maxPendingTasks > 0);
+    mThread = std::thread(&FrameCaptureWorker::threadMain, this);
+}
+
+FrameCaptureWorker::~FrameCaptureWorker()
+{
+    finish();
+    mStopping = true;
+    wake();
+    mThread.join();
+}
+
+void FrameCaptureWorker::post(Task &&task)
+{
+    size_t tail = mTail.load(std::memory_order_relaxed);
+    if (tail - mHead.load(std::memory_order_acquire) == mTasks.size())
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [this, tail]() {
+            return tail - mHead.load(std::memory_order_acquire) < mTasks.size();
+        });
+    }
+
+    mTasks[tail % mTasks.size()] = std::move(task);
+    mTail.store(tail + 1, std::memory_order_release);
+    wake();
+}
+
+void FrameCaptureWorker::finish()
+{
+    size_t tail = mTail.load(std::memory_order_relaxed);
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCondition.wait(lock,
+                    [this, tail]() { return mHead.load(std::memory_order_acquire) == tail; });
+}
+
+void FrameCaptureWorker::threadMain()
+{
+    while (true)
+    {
+        size_t head = mHead.load(std::memory_order_relaxed);
+        if (head == mTail.load(std::memory_order_acquire))
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this, head]() {
+                return mStopping || head != mTail.load(std::memory_order_acquire);
+            });
+            if (head == mTail.load(std::memory_order_acquire))
+            {
+                return;
+            }
+        }
+
+        Task &task = mTasks[head % mTasks.size()];
+        task();
+        // Release the frame's memory before making the slot available.
+        task = nullptr;
+
+        mHead.store(head + 1, std::memory_order_release);
+        wake();
+    }
+}
+
+void FrameCaptureWorker::wake()
+{
+    // Taking the lock orders the index update before a waiting thread's predicate check, so the
+    // notification can't be missed.
+    std::lock_guard<std::mutex> lock(mMutex);
+    mCondition.notify_all();
+}
+
 FrameCapture::FrameCapture()
     : mEnabled(true),
       mSerializeStateEnabled(false),
       mCompression(true),
+      mBinaryFormat(false),
       mClientVertexArrayMap{},
       mFrameIndex(1),
       mCaptureStartFrame(1),
@@ -3628,6 +4122,12 @@ FrameCapture::FrameCapture()
     {
         mCompression = false;
     }
+    std::string formatFromEnv =
+        GetEnvironmentVarOrUnCachedAndroidProperty(kFormatVarName, kAndroidFormat);
+    if (formatFromEnv == "binary")
+    {
+        mBinaryFormat = true;
+    }
     std::string serializeStateEnabledFromEnv =
         angle::GetEnvironmentVar(kSerializeStateEnabledVarName);
     if (serializeStateEnabledFromEnv == "1")
@@ -4323,39 +4823,78 @@ void FrameCapture::checkForCaptureTrigger()
     }
 }
 
-void FrameCapture::onEndFrame(const gl::Context *context)
+void FrameCapture::writeFrame(const gl::Context *context)
 {
-    // On Android, we can trigger a capture during the run
-    checkForCaptureTrigger();
+    uint32_t frameIndex = getReplayFrameIndex();
+    uint32_t frameCount = getFrameCount();
 
-    // Note that we currently capture before the start frame to collect shader and program sources.
-    if (!mFrameCalls.empty() && mFrameIndex >= mCaptureStartFrame)
+    // Serialized state must be read from the context before it moves on.
+    auto serializedContextState = std::make_shared<std::vector<uint8_t>>();
+    if (mSerializeStateEnabled && !mBinaryFormat)
     {
-        if (mIsFirstFrame)
+        SerializeContextState(context, serializedContextState.get());
+    }
+
+    if (!mWorker)
+    {
+        mWorker.reset(new FrameCaptureWorker(kMaxPendingCaptureFrames));
+    }
+
+    // Writing the reset calls reads the resource tracker, and the index files written after the
+    // last frame need the complete binary data. Write the last frame inline once the worker is
+    // idle.
+    if (frameIndex == frameCount)
+    {
+        mWorker->finish();
+        if (mBinaryFormat)
         {
-            mCaptureStartFrame = mFrameIndex;
-            mIsFirstFrame      = false;
+            WriteBinaryReplay(mCompression, mOutDirectory, context->id(), mCaptureLabel,
+                              frameIndex, frameCount, mFrameCalls, mSetupCalls,
+                              &mResourceTracker);
         }
-        WriteCppReplay(mCompression, mOutDirectory, context, mCaptureLabel, getReplayFrameIndex(),
-                       getFrameCount(), mFrameCalls, mSetupCalls, &mResourceTracker, &mBinaryData,
-                       mSerializeStateEnabled);
-        if (mFrameIndex == mCaptureEndFrame)
+        else
         {
-            // Save the index files after the last frame.
-            WriteCppReplayIndexFiles(mCompression, mOutDirectory, context->id(), mCaptureLabel,
-                                     getFrameCount(), mDrawSurfaceDimensions, mReadBufferSize,
-                                     mClientArraySizes, mHasResourceType, mSerializeStateEnabled,
-                                     false, context->getConfig(), mBinaryData);
-            if (!mBinaryData.empty())
-            {
-                SaveBinaryData(mCompression, mOutDirectory, context->id(), mCaptureLabel,
-                               mBinaryData);
-                mBinaryData.clear();
-            }
-            mWroteIndexFile = true;
+            WriteCppReplay(mCompression, mOutDirectory, context->id(), mCaptureLabel, frameIndex,
+                           frameCount, mFrameCalls, mSetupCalls, &mResourceTracker, &mBinaryData,
+                           *serializedContextState);
         }
+        return;
     }
 
+    // mFrameCalls and mSetupCalls are cleared at the end of every frame, so hand them over.
+    auto frameCalls = std::make_shared<std::vector<CallCapture>>(std::move(mFrameCalls));
+    auto setupCalls = std::make_shared<std::vector<CallCapture>>(std::move(mSetupCalls));
+    mFrameCalls.clear();
+    mSetupCalls.clear();
+
+    bool compression         = mCompression;
+    bool binaryFormat        = mBinaryFormat;
+    std::string outDirectory = mOutDirectory;
+    std::string captureLabel = mCaptureLabel;
+    gl::ContextID contextId  = context->id();
+    // Only the worker touches the binary data until the last frame.
+    BinaryDataStore *binaryData = &mBinaryData;
+
+    mWorker->post([=]() {
+        if (binaryFormat)
+        {
+            WriteBinaryReplay(compression, outDirectory, contextId, captureLabel, frameIndex,
+                              frameCount, *frameCalls, *setupCalls, nullptr);
+        }
+        else
+        {
+            WriteCppReplay(compression, outDirectory, contextId, captureLabel, frameIndex,
+                           frameCount, *frameCalls, *setupCalls, nullptr, binaryData,
+                           *serializedContextState);
+        }
+    });
+}
+
+void FrameCapture::onEndFrame(const gl::Context *context)
+{
+    // On Android, we can trigger a capture during the run
+    checkForCaptureTrigger();
+
     // Count resource IDs. This is also done on every frame. It could probably be done by checking
     // the GL state instead of the calls.
     for (const CallCapture &call : mFrameCalls)
@@ -4370,6 +4909,41 @@ void FrameCapture::onEndFrame(const gl::Context *context)
         }
     }
 
+    // Note that we currently capture before the start frame to collect shader and program sources.
+    if (!mFrameCalls.empty() && mFrameIndex >= mCaptureStartFrame)
+    {
+        if (mIsFirstFrame)
+        {
+            mCaptureStartFrame = mFrameIndex;
+            mIsFirstFrame      = false;
+        }
+        writeFrame(context);
+
+        if (mFrameIndex == mCaptureEndFrame)
+        {
+            // Save the index files after the last frame.
+            if (mBinaryFormat)
+            {
+                WriteBinaryReplayIndexFile(mCompression, mOutDirectory, context->id(),
+                                           mCaptureLabel, getFrameCount(), mDrawSurfaceDimensions);
+            }
+            else
+            {
+                WriteCppReplayIndexFiles(mCompression, mOutDirectory, context->id(), mCaptureLabel,
+                                         getFrameCount(), mDrawSurfaceDimensions, mReadBufferSize,
+                                         mClientArraySizes, mHasResourceType,
+                                         mSerializeStateEnabled, false, context->getConfig());
+                if (!mBinaryData.empty())
+                {
+                    SaveBinaryData(mCompression, mOutDirectory, context->id(), mCaptureLabel,
+                                   mBinaryData);
+                    mBinaryData.clear();
+                }
+            }
+            mWroteIndexFile = true;
+        }
+    }
+
     reset();
     mFrameIndex++;
 
@@ -4386,6 +4960,12 @@ void FrameCapture::onDestroyContext(const gl::Context *context)
     {
         return;
     }
+
+    // Make sure all captured frames are on disk before writing the index.
+    if (mWorker)
+    {
+        mWorker->finish();
+    }
     if (!mWroteIndexFile && mFrameIndex > mCaptureStartFrame)
     {
         // If context is destroyed before end frame is reached and at least
@@ -4393,10 +4973,17 @@ void FrameCapture::onDestroyContext(const gl::Context *context)
         // It doesnt make sense to write the index files when no frame has been recorded
         mFrameIndex -= 1;
         mCaptureEndFrame = mFrameIndex;
+        if (mBinaryFormat)
+        {
+            WriteBinaryReplayIndexFile(mCompression, mOutDirectory, context->id(), mCaptureLabel,
+                                       getFrameCount(), mDrawSurfaceDimensions);
+            mWroteIndexFile = true;
+            return;
+        }
         WriteCppReplayIndexFiles(mCompression, mOutDirectory, context->id(), mCaptureLabel,
                                  getFrameCount(), mDrawSurfaceDimensions, mReadBufferSize,
                                  mClientArraySizes, mHasResourceType, mSerializeStateEnabled, true,
-                                 context->getConfig(), mBinaryData);
+                                 context->getConfig());
         if (!mBinaryData.empty())
         {
             SaveBinaryData(mCompression, mOutDirectory, context->id(), mCaptureLabel, mBinaryData);
@@ -10,7 +10,14 @@
 #ifndef LIBANGLE_FRAME_CAPTURE_H_
 #define LIBANGLE_FRAME_CAPTURE_H_
 
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
 #include "common/PackedEnums.h"
+#include "common/frame_capture_binary_writer.h"
 #include "libANGLE/Context.h"
 #include "libANGLE/angletypes.h"
 #include "libANGLE/entry_points_utils.h"
@@ -309,6 +316,41 @@ using TextureLevelDataMap = std::map<gl::TextureID, TextureLevels>;
 // Map from ContextID to surface dimensions
 using SurfaceDimensions = std::map<gl::ContextID, gl::Extents>;
 
+// Runs frame serialization, compression and file output on a background thread so the capturing
+// thread only pays for copying call parameters. Tasks are handed over through a fixed-size
+// single-producer single-consumer ring with lock-free push and pop; the mutex is only used to park
+// a thread while the ring is empty or full. Blocking the producer on a full ring bounds the number
+// of captured frames held in memory.
+class FrameCaptureWorker final : angle::NonCopyable
+{
+  public:
+    using Task = std::function<void()>;
+
+    explicit FrameCaptureWorker(size_t maxPendingTasks);
+    ~FrameCaptureWorker();
+
+    // Queues |task|. Waits for the oldest pending task to complete if the ring is full.
+    void post(Task &&task);
+
+    // Waits for all posted tasks to complete.
+    void finish();
+
+  private:
+    void threadMain();
+    void wake();
+
+    std::vector<Task> mTasks;
+    // Index of the next task to run. Only written by the worker thread.
+    std::atomic<size_t> mHead;
+    // Index of the next free slot. Only written by the posting thread.
+    std::atomic<size_t> mTail;
+    std::atomic<bool> mStopping;
+
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::thread mThread;
+};
+
 class FrameCapture final : angle::NonCopyable
 {
   public:
@@ -345,6 +387,7 @@ class FrameCapture final : angle::NonCopyable
 
     void captureCompressedTextureData(const gl::Context *context, const CallCapture &call);
 
+    void writeFrame(const gl::Context *context);
     void reset();
     void maybeOverrideEntryPoint(const gl::Context *context, CallCapture &call);
     void maybeCapturePreCallUpdates(const gl::Context *context, CallCapture &call);
@@ -359,13 +402,14 @@ class FrameCapture final : angle::NonCopyable
 
     // We save one large buffer of binary data for the whole CPP replay.
     // This simplifies a lot of file management.
-    std::vector<uint8_t> mBinaryData;
+    BinaryDataStore mBinaryData;
 
     bool mEnabled = false;
     bool mSerializeStateEnabled;
     std::string mOutDirectory;
     std::string mCaptureLabel;
     bool mCompression;
+    bool mBinaryFormat;
     gl::AttribArray<int> mClientVertexArrayMap;
     uint32_t mFrameIndex;
     uint32_t mCaptureStartFrame;
@@ -380,6 +424,9 @@ class FrameCapture final : angle::NonCopyable
 
     ResourceTracker mResourceTracker;
 
+    // Writes out captured frames in the background. Created when the first frame is written.
+    std::unique_ptr<FrameCaptureWorker> mWorker;
+
     // If you don't know which frame you want to start capturing at, use the capture trigger.
     // Initialize it to the number of frames you want to capture, and then clear the value to 0 when
     // you reach the content you want to capture. Currently only available on Android.
@@ -24,12 +24,59 @@
 namespace
 {
 #include "libANGLE/GLES1Shaders.inc"
+
+// Records |value| as uploaded and returns true if it differs from the value last uploaded.
+template <typename T>
+bool UpdateUploadedValue(T *uploaded, const T &value)
+{
+    if (memcmp(uploaded, &value, sizeof(T)) == 0)
+    {
+        return false;
+    }
+    memcpy(uploaded, &value, sizeof(T));
+    return true;
+}
+
+template <size_t N>
+void AddShaderStateConstant(std::stringstream &out,
+                            const char *type,
+                            const char *name,
+                            const std::array<uint32_t, N> &values)
+{
+    out << "const " << type << " " << name << "[" << N << "] = " << type << "[" << N << "](";
+    for (size_t i = 0; i < N; i++)
+    {
+        out << (i > 0 ? ", " : "");
+        if (strcmp(type, "bool") == 0)
+        {
+            out << (values[i] ? "true" : "false");
+        }
+        else
+        {
+            out << values[i];
+        }
+    }
+    out << ");\n";
+}
 }  // anonymous namespace
 
 namespace gl
 {
 
-GLES1Renderer::GLES1Renderer() : mRendererProgramInitialized(false) {}
+GLES1ShaderState::GLES1ShaderState()
+{
+    // Zero the whole struct, including any padding, as it is hashed and compared as raw memory.
+    memset(this, 0, sizeof(*this));
+}
+
+bool GLES1ShaderState::operator==(const GLES1ShaderState &other) const
+{
+    return memcmp(this, &other, sizeof(GLES1ShaderState)) == 0;
+}
+
+GLES1Renderer::GLES1Renderer()
+    : mRendererProgramInitialized(false), mShaderPrograms(nullptr), mCurrentProgramState(nullptr)
+{}
 
 void GLES1Renderer::onDestroy(Context *context, State *state)
 {
@@ -37,7 +84,13 @@ void GLES1Renderer::onDestroy(Context *context, State *state)
     {
         (void)state->setProgram(context, 0);
 
-        mShaderPrograms->deleteProgram(context, {mProgramState.program});
+        for (const auto &programState : mProgramStates)
+        {
+            mShaderPrograms->deleteProgram(context, {programState.second->program});
+        }
+        mProgramStates.clear();
+        mCurrentProgramState = nullptr;
+
         mShaderPrograms->release(context);
         mShaderPrograms             = nullptr;
         mRendererProgramInitialized = false;
@@ -52,71 +105,48 @@ angle::Result GLES1Renderer::prepareForDraw(PrimitiveMode mode, Context *context
 
     GLES1State &gles1State = glState->gles1();
 
-    Program *programObject = getProgram(mProgramState.program);
+    GLES1ProgramState &programState  = *mCurrentProgramState;
+    GLES1UntrackedUniforms &uploaded = programState.uploadedUniforms;
+    Program *programObject           = getProgram(programState.program);
 
     GLES1UniformBuffers &uniformBuffers = mUniformBuffers;
 
-    // If anything is dirty in gles1 or the common parts of gles1/2, just redo these parts
-    // completely for now.
+    // Texturing, lighting, fog, alpha test and clip plane enables, as well as the texture
+    // environment modes, are constants of the program variant selected above.  The uniforms below
+    // are only uploaded when their value changes, either through GLES1State's dirty bits or by
+    // comparison with the value last uploaded to this program.
 
     // Feature enables
     {
-        setUniform1i(context, programObject, mProgramState.enableAlphaTestLoc,
-                     glState->getEnableFeature(GL_ALPHA_TEST));
-        setUniform1i(context, programObject, mProgramState.enableLightingLoc,
-                     glState->getEnableFeature(GL_LIGHTING));
-        setUniform1i(context, programObject, mProgramState.enableRescaleNormalLoc,
-                     glState->getEnableFeature(GL_RESCALE_NORMAL));
-        setUniform1i(context, programObject, mProgramState.enableNormalizeLoc,
-                     glState->getEnableFeature(GL_NORMALIZE));
-        setUniform1i(context, programObject, mProgramState.enableColorMaterialLoc,
-                     glState->getEnableFeature(GL_COLOR_MATERIAL));
-        setUniform1i(context, programObject, mProgramState.fogEnableLoc,
-                     glState->getEnableFeature(GL_FOG));
-
-        bool enableClipPlanes = false;
-        for (int i = 0; i < kClipPlaneCount; i++)
+        GLint enableRescaleNormal = glState->getEnableFeature(GL_RESCALE_NORMAL);
+        if (UpdateUploadedValue(&uploaded.enableRescaleNormal, enableRescaleNormal))
         {
-            uniformBuffers.clipPlaneEnables[i] = glState->getEnableFeature(GL_CLIP_PLANE0 + i);
-            enableClipPlanes = enableClipPlanes || uniformBuffers.clipPlaneEnables[i];
+            setUniform1i(context, programObject, programState.enableRescaleNormalLoc,
+                         enableRescaleNormal);
         }
 
-        setUniform1i(context, programObject, mProgramState.enableClipPlanesLoc, enableClipPlanes);
+        GLint enableNormalize = glState->getEnableFeature(GL_NORMALIZE);
+        if (UpdateUploadedValue(&uploaded.enableNormalize, enableNormalize))
+        {
+            setUniform1i(context, programObject, programState.enableNormalizeLoc, enableNormalize);
+        }
+
+        GLint enableColorMaterial = glState->getEnableFeature(GL_COLOR_MATERIAL);
+        if (UpdateUploadedValue(&uploaded.enableColorMaterial, enableColorMaterial))
+        {
+            setUniform1i(context, programObject, programState.enableColorMaterialLoc,
+                         enableColorMaterial);
+        }
     }
 
-    // Texture unit enables and format info
+    // Texture format info
     {
-        std::array<GLint, kTexUnitCount> &tex2DEnables   = uniformBuffers.tex2DEnables;
-        std::array<GLint, kTexUnitCount> &texCubeEnables = uniformBuffers.texCubeEnables;
-
-        std::vector<int> tex2DFormats = {GL_RGBA, GL_RGBA, GL_RGBA, GL_RGBA};
+        std::array<GLint, kTexUnitCount> tex2DFormats = {GL_RGBA, GL_RGBA, GL_RGBA, GL_RGBA};
 
         Vec4Uniform *cropRectBuffer = uniformBuffers.texCropRects.data();
 
         for (int i = 0; i < kTexUnitCount; i++)
         {
-            // GL_OES_cube_map allows only one of TEXTURE_2D / TEXTURE_CUBE_MAP
-            // to be enabled per unit, thankfully. From the extension text:
-            //
-            //  --  Section 3.8.10 "Texture Application"
-            //
-            //      Replace the beginning sentences of the first paragraph (page 138)
-            //      with:
-            //
-            //      "Texturing is enabled or disabled using the generic Enable
-            //      and Disable commands, respectively, with the symbolic constants
-            //      TEXTURE_2D or TEXTURE_CUBE_MAP_OES to enable the two-dimensional or cube
-            //      map texturing respectively.  If the cube map texture and the two-
-            //      dimensional texture are enabled, then cube map texturing is used.  If
-            //      texturing is disabled, a rasterized fragment is passed on unaltered to the
-            //      next stage of the GL (although its texture coordinates may be discarded).
-            //      Otherwise, a texture value is found according to the parameter values of
-            //      the currently bound texture image of the appropriate dimensionality.
-
-            texCubeEnables[i] = gles1State.isTextureTargetEnabled(i, TextureType::CubeMap);
-            tex2DEnables[i] =
-                !texCubeEnables[i] && (gles1State.isTextureTargetEnabled(i, TextureType::_2D));
-
             Texture *curr2DTexture = glState->getSamplerTexture(i, TextureType::_2D);
             if (curr2DTexture)
             {
@@ -140,16 +170,17 @@ angle::Result GLES1Renderer::prepareForDraw(PrimitiveMode mode, Context *context
             }
         }
 
-        setUniform1iv(context, programObject, mProgramState.enableTexture2DLoc, kTexUnitCount,
-                      tex2DEnables.data());
-        setUniform1iv(context, programObject, mProgramState.enableTextureCubeMapLoc, kTexUnitCount,
-                      texCubeEnables.data());
-
-        setUniform1iv(context, programObject, mProgramState.textureFormatLoc, kTexUnitCount,
-                      tex2DFormats.data());
+        if (UpdateUploadedValue(&uploaded.textureFormats, tex2DFormats))
+        {
+            setUniform1iv(context, programObject, programState.textureFormatLoc, kTexUnitCount,
+                          tex2DFormats.data());
+        }
 
-        setUniform4fv(programObject, mProgramState.drawTextureNormalizedCropRectLoc, kTexUnitCount,
-                      reinterpret_cast<GLfloat *>(cropRectBuffer));
+        if (UpdateUploadedValue(&uploaded.textureCropRects, uniformBuffers.texCropRects))
+        {
+            setUniform4fv(programObject, programState.drawTextureNormalizedCropRectLoc,
+                          kTexUnitCount, reinterpret_cast<GLfloat *>(cropRectBuffer));
+        }
     }
 
     // Client state / current vector enables
@@ -190,14 +221,14 @@ angle::Result GLES1Renderer::prepareForDraw(PrimitiveMode mode, Context *context
     if (gles1State.isDirty(GLES1State::DIRTY_GLES1_MATRICES))
     {
         angle::Mat4 proj = gles1State.mProjectionMatrices.back();
-        setUniformMatrix4fv(programObject, mProgramState.projMatrixLoc, 1, GL_FALSE, proj.data());
+        setUniformMatrix4fv(programObject, programState.projMatrixLoc, 1, GL_FALSE, proj.data());
 
         angle::Mat4 modelview = gles1State.mModelviewMatrices.back();
-        setUniformMatrix4fv(programObject, mProgramState.modelviewMatrixLoc, 1, GL_FALSE,
+        setUniformMatrix4fv(programObject, programState.modelviewMatrixLoc, 1, GL_FALSE,
                             modelview.data());
 
         angle::Mat4 modelviewInvTr = modelview.transpose().inverse();
-        setUniformMatrix4fv(programObject, mProgramState.modelviewInvTrLoc, 1, GL_FALSE,
+        setUniformMatrix4fv(programObject, programState.modelviewInvTrLoc, 1, GL_FALSE,
                             modelviewInvTr.data());
 
         Mat4Uniform *textureMatrixBuffer = uniformBuffers.textureMatrices.data();
@@ -208,7 +239,7 @@ angle::Result GLES1Renderer::prepareForDraw(PrimitiveMode mode, Context *context
             memcpy(textureMatrixBuffer + i, textureMatrix.data(), sizeof(Mat4Uniform));
         }
 
-        setUniformMatrix4fv(programObject, mProgramState.textureMatrixLoc, kTexUnitCount, GL_FALSE,
+        setUniformMatrix4fv(programObject, programState.textureMatrixLoc, kTexUnitCount, GL_FALSE,
                             reinterpret_cast<float *>(uniformBuffers.textureMatrices.data()));
     }
 
@@ -218,10 +249,6 @@ angle::Result GLES1Renderer::prepareForDraw(PrimitiveMode mode, Context *context
         {
             const auto &env = gles1State.textureEnvironment(i);
 
-            uniformBuffers.texEnvModes[i]      = ToGLenum(env.mode);
-            uniformBuffers.texCombineRgbs[i]   = ToGLenum(env.combineRgb);
-            uniformBuffers.texCombineAlphas[i] = ToGLenum(env.combineAlpha);
-
             uniformBuffers.texCombineSrc0Rgbs[i]   = ToGLenum(env.src0Rgb);
             uniformBuffers.texCombineSrc0Alphas[i] = ToGLenum(env.src0Alpha);
             uniformBuffers.texCombineSrc1Rgbs[i]   = ToGLenum(env.src1Rgb);
@@ -247,62 +274,55 @@ angle::Result GLES1Renderer::prepareForDraw(PrimitiveMode mode, Context *context
             uniformBuffers.pointSpriteCoordReplaces[i] = env.pointSpriteCoordReplace;
         }
 
-        setUniform1iv(context, programObject, mProgramState.textureEnvModeLoc, kTexUnitCount,
-                      uniformBuffers.texEnvModes.data());
-        setUniform1iv(context, programObject, mProgramState.combineRgbLoc, kTexUnitCount,
-                      uniformBuffers.texCombineRgbs.data());
-        setUniform1iv(context, programObject, mProgramState.combineAlphaLoc, kTexUnitCount,
-                      uniformBuffers.texCombineAlphas.data());
-
-        setUniform1iv(context, programObject, mProgramState.src0rgbLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState.src0rgbLoc, kTexUnitCount,
                       uniformBuffers.texCombineSrc0Rgbs.data());
-        setUniform1iv(context, programObject, mProgramState.src0alphaLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState.src0alphaLoc, kTexUnitCount,
                       uniformBuffers.texCombineSrc0Alphas.data());
-        setUniform1iv(context, programObject, mProgramState.src1rgbLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState.src1rgbLoc, kTexUnitCount,
                       uniformBuffers.texCombineSrc1Rgbs.data());
-        setUniform1iv(context, programObject, mProgramState.src1alphaLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState.src1alphaLoc, kTexUnitCount,
                       uniformBuffers.texCombineSrc1Alphas.data());
-        setUniform1iv(context, programObject, mProgramState.src2rgbLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState.src2rgbLoc, kTexUnitCount,
                       uniformBuffers.texCombineSrc2Rgbs.data());
-        setUniform1iv(context, programObject, mProgramState.src2alphaLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState.src2alphaLoc, kTexUnitCount,
                       uniformBuffers.texCombineSrc2Alphas.data());
 
-        setUniform1iv(context, programObject, mProgramState.op0rgbLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState.op0rgbLoc, kTexUnitCount,
                       uniformBuffers.texCombineOp0Rgbs.data());
-        setUniform1iv(context, programObject, mProgramState.op0alphaLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState.op0alphaLoc, kTexUnitCount,
                       uniformBuffers.texCombineOp0Alphas.data());
-        setUniform1iv(context, programObject, mProgramState.op1rgbLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState.op1rgbLoc, kTexUnitCount,
                       uniformBuffers.texCombineOp1Rgbs.data());
-        setUniform1iv(context, programObject, mProgramState.op1alphaLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState.op1alphaLoc, kTexUnitCount,
                       uniformBuffers.texCombineOp1Alphas.data());
-        setUniform1iv(context, programObject, mProgramState.op2rgbLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState.op2rgbLoc, kTexUnitCount,
                       uniformBuffers.texCombineOp2Rgbs.data());
-        setUniform1iv(context, programObject, mProgramState.op2alphaLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState.op2alphaLoc, kTexUnitCount,
                       uniformBuffers.texCombineOp2Alphas.data());
 
-        setUniform4fv(programObject, mProgramState.textureEnvColorLoc, kTexUnitCount,
+        setUniform4fv(programObject, programState.textureEnvColorLoc, kTexUnitCount,
                       reinterpret_cast<float *>(uniformBuffers.texEnvColors.data()));
-        setUniform1fv(programObject, mProgramState.rgbScaleLoc, kTexUnitCount,
+        setUniform1fv(programObject, programState.rgbScaleLoc, kTexUnitCount,
                       uniformBuffers.texEnvRgbScales.data());
-        setUniform1fv(programObject, mProgramState.alphaScaleLoc, kTexUnitCount,
+        setUniform1fv(programObject, programState.alphaScaleLoc, kTexUnitCount,
                       uniformBuffers.texEnvAlphaScales.data());
 
-        setUniform1iv(context, programObject, mProgramState.pointSpriteCoordReplaceLoc,
+        setUniform1iv(context, programObject, programState.pointSpriteCoordReplaceLoc,
                       kTexUnitCount, uniformBuffers.pointSpriteCoordReplaces.data());
     }
 
     // Alpha test
     if (gles1State.isDirty(GLES1State::DIRTY_GLES1_ALPHA_TEST))
     {
-        setUniform1i(context, programObject, mProgramState.alphaFuncLoc,
+        setUniform1i(context, programObject, programState.alphaFuncLoc,
                      ToGLenum(gles1State.mAlphaTestFunc));
-        setUniform1f(programObject, mProgramState.alphaTestRefLoc, gles1State.mAlphaTestRef);
+        setUniform1f(programObject, programState.alphaTestRefLoc, gles1State.mAlphaTestRef);
     }
 
     // Shading, materials, and lighting
     if (gles1State.isDirty(GLES1State::DIRTY_GLES1_SHADE_MODEL))
     {
-        setUniform1i(context, programObject, mProgramState.shadeModelFlatLoc,
+        setUniform1i(context, programObject, programState.shadeModelFlatLoc,
                      gles1State.mShadeModel == ShadingModel::Flat);
     }
 
@@ -310,13 +330,13 @@ angle::Result GLES1Renderer::prepareForDraw(PrimitiveMode mode, Context *context
     {
         const auto &material = gles1State.mMaterial;
 
-        setUniform4fv(programObject, mProgramState.materialAmbientLoc, 1, material.ambient.data());
-        setUniform4fv(programObject, mProgramState.materialDiffuseLoc, 1, material.diffuse.data());
-        setUniform4fv(programObject, mProgramState.materialSpecularLoc, 1,
+        setUniform4fv(programObject, programState.materialAmbientLoc, 1, material.ambient.data());
+        setUniform4fv(programObject, programState.materialDiffuseLoc, 1, material.diffuse.data());
+        setUniform4fv(programObject, programState.materialSpecularLoc, 1,
                       material.specular.data());
-        setUniform4fv(programObject, mProgramState.materialEmissiveLoc, 1,
+        setUniform4fv(programObject, programState.materialEmissiveLoc, 1,
                       material.emissive.data());
-        setUniform1f(programObject, mProgramState.materialSpecularExponentLoc,
+        setUniform1f(programObject, programState.materialSpecularExponentLoc,
                      material.specularExponent);
     }
 
@@ -324,11 +344,11 @@ angle::Result GLES1Renderer::prepareForDraw(PrimitiveMode mode, Context *context
     {
         const auto &lightModel = gles1State.mLightModel;
 
-        setUniform4fv(programObject, mProgramState.lightModelSceneAmbientLoc, 1,
+        setUniform4fv(programObject, programState.lightModelSceneAmbientLoc, 1,
                       lightModel.color.data());
 
         // TODO (lfy@google.com): Implement two-sided lighting model
-        // gl->uniform1i(mProgramState.lightModelTwoSidedLoc, lightModel.twoSided);
+        // gl->uniform1i(programState.lightModelTwoSidedLoc, lightModel.twoSided);
 
         for (int i = 0; i < kLightCount; i++)
         {
@@ -351,79 +371,101 @@ angle::Result GLES1Renderer::prepareForDraw(PrimitiveMode mode, Context *context
             uniformBuffers.attenuationQuadratics[i] = light.attenuationQuadratic;
         }
 
-        setUniform1iv(context, programObject, mProgramState.lightEnablesLoc, kLightCount,
+        setUniform1iv(context, programObject, programState.lightEnablesLoc, kLightCount,
                       uniformBuffers.lightEnables.data());
-        setUniform4fv(programObject, mProgramState.lightAmbientsLoc, kLightCount,
+        setUniform4fv(programObject, programState.lightAmbientsLoc, kLightCount,
                       reinterpret_cast<float *>(uniformBuffers.lightAmbients.data()));
-        setUniform4fv(programObject, mProgramState.lightDiffusesLoc, kLightCount,
+        setUniform4fv(programObject, programState.lightDiffusesLoc, kLightCount,
                       reinterpret_cast<float *>(uniformBuffers.lightDiffuses.data()));
-        setUniform4fv(programObject, mProgramState.lightSpecularsLoc, kLightCount,
+        setUniform4fv(programObject, programState.lightSpecularsLoc, kLightCount,
                       reinterpret_cast<float *>(uniformBuffers.lightSpeculars.data()));
-        setUniform4fv(programObject, mProgramState.lightPositionsLoc, kLightCount,
+        setUniform4fv(programObject, programState.lightPositionsLoc, kLightCount,
                       reinterpret_cast<float *>(uniformBuffers.lightPositions.data()));
-        setUniform3fv(programObject, mProgramState.lightDirectionsLoc, kLightCount,
+        setUniform3fv(programObject, programState.lightDirectionsLoc, kLightCount,
                       reinterpret_cast<float *>(uniformBuffers.lightDirections.data()));
-        setUniform1fv(programObject, mProgramState.lightSpotlightExponentsLoc, kLightCount,
+        setUniform1fv(programObject, programState.lightSpotlightExponentsLoc, kLightCount,
                       reinterpret_cast<float *>(uniformBuffers.spotlightExponents.data()));
-        setUniform1fv(programObject, mProgramState.lightSpotlightCutoffAnglesLoc, kLightCount,
+        setUniform1fv(programObject, programState.lightSpotlightCutoffAnglesLoc, kLightCount,
                       reinterpret_cast<float *>(uniformBuffers.spotlightCutoffAngles.data()));
-        setUniform1fv(programObject, mProgramState.lightAttenuationConstsLoc, kLightCount,
+        setUniform1fv(programObject, programState.lightAttenuationConstsLoc, kLightCount,
                       reinterpret_cast<float *>(uniformBuffers.attenuationConsts.data()));
-        setUniform1fv(programObject, mProgramState.lightAttenuationLinearsLoc, kLightCount,
+        setUniform1fv(programObject, programState.lightAttenuationLinearsLoc, kLightCount,
                       reinterpret_cast<float *>(uniformBuffers.attenuationLinears.data()));
-        setUniform1fv(programObject, mProgramState.lightAttenuationQuadraticsLoc, kLightCount,
+        setUniform1fv(programObject, programState.lightAttenuationQuadraticsLoc, kLightCount,
                       reinterpret_cast<float *>(uniformBuffers.attenuationQuadratics.data()));
     }
 
     if (gles1State.isDirty(GLES1State::DIRTY_GLES1_FOG))
     {
         const FogParameters &fog = gles1State.fogParameters();
-        setUniform1i(context, programObject, mProgramState.fogModeLoc, ToGLenum(fog.mode));
-        setUniform1f(programObject, mProgramState.fogDensityLoc, fog.density);
-        setUniform1f(programObject, mProgramState.fogStartLoc, fog.start);
-        setUniform1f(programObject, mProgramState.fogEndLoc, fog.end);
-        setUniform4fv(programObject, mProgramState.fogColorLoc, 1, fog.color.data());
+        setUniform1i(context, programObject, programState.fogModeLoc, ToGLenum(fog.mode));
+        setUniform1f(programObject, programState.fogDensityLoc, fog.density);
+        setUniform1f(programObject, programState.fogStartLoc, fog.start);
+        setUniform1f(programObject, programState.fogEndLoc, fog.end);
+        setUniform4fv(programObject, programState.fogColorLoc, 1, fog.color.data());
     }
 
     // Clip planes
     if (gles1State.isDirty(GLES1State::DIRTY_GLES1_CLIP_PLANES))
     {
-        bool enableClipPlanes = false;
         for (int i = 0; i < kClipPlaneCount; i++)
         {
-            uniformBuffers.clipPlaneEnables[i] = glState->getEnableFeature(GL_CLIP_PLANE0 + i);
-            enableClipPlanes = enableClipPlanes || uniformBuffers.clipPlaneEnables[i];
             gles1State.getClipPlane(
                 i, reinterpret_cast<float *>(uniformBuffers.clipPlanes.data() + i));
         }
 
-        setUniform1i(context, programObject, mProgramState.enableClipPlanesLoc, enableClipPlanes);
-        setUniform1iv(context, programObject, mProgramState.clipPlaneEnablesLoc, kClipPlaneCount,
-                      uniformBuffers.clipPlaneEnables.data());
-        setUniform4fv(programObject, mProgramState.clipPlanesLoc, kClipPlaneCount,
+        setUniform4fv(programObject, programState.clipPlanesLoc, kClipPlaneCount,
                       reinterpret_cast<float *>(uniformBuffers.clipPlanes.data()));
     }
 
     // Point rasterization
+    {
+        GLint pointRasterization = mode == PrimitiveMode::Points;
+        if (UpdateUploadedValue(&uploaded.pointRasterization, pointRasterization))
+        {
+            setUniform1i(context, programObject, programState.pointRasterizationLoc,
+                         pointRasterization);
+        }
+
+        GLint pointSpriteEnabled = glState->getEnableFeature(GL_POINT_SPRITE_OES);
+        if (UpdateUploadedValue(&uploaded.pointSpriteEnabled, pointSpriteEnabled))
+        {
+            setUniform1i(context, programObject, programState.pointSpriteEnabledLoc,
+                         pointSpriteEnabled);
+        }
+    }
+
+    if (gles1State.isDirty(GLES1State::DIRTY_GLES1_POINT_PARAMETERS))
     {
         const PointParameters &pointParams = gles1State.mPointParameters;
 
-        setUniform1i(context, programObject, mProgramState.pointRasterizationLoc,
-                     mode == PrimitiveMode::Points);
-        setUniform1i(context, programObject, mProgramState.pointSpriteEnabledLoc,
-                     glState->getEnableFeature(GL_POINT_SPRITE_OES));
-        setUniform1f(programObject, mProgramState.pointSizeMinLoc, pointParams.pointSizeMin);
-        setUniform1f(programObject, mProgramState.pointSizeMaxLoc, pointParams.pointSizeMax);
-        setUniform3fv(programObject, mProgramState.pointDistanceAttenuationLoc, 1,
+        setUniform1f(programObject, programState.pointSizeMinLoc, pointParams.pointSizeMin);
+        setUniform1f(programObject, programState.pointSizeMaxLoc, pointParams.pointSizeMax);
+        setUniform3fv(programObject, programState.pointDistanceAttenuationLoc, 1,
                       pointParams.pointDistanceAttenuation.data());
     }
 
     // Draw texture
     {
-        setUniform1i(context, programObject, mProgramState.enableDrawTextureLoc,
-                     mDrawTextureEnabled ? 1 : 0);
-        setUniform4fv(programObject, mProgramState.drawTextureCoordsLoc, 1, mDrawTextureCoords);
-        setUniform2fv(programObject, mProgramState.drawTextureDimsLoc, 1, mDrawTextureDims);
+        GLint enableDrawTexture = mDrawTextureEnabled ? 1 : 0;
+        if (UpdateUploadedValue(&uploaded.enableDrawTexture, enableDrawTexture))
+        {
+            setUniform1i(context, programObject, programState.enableDrawTextureLoc,
+                         enableDrawTexture);
+        }
+
+        if (mDrawTextureEnabled)
+        {
+            if (UpdateUploadedValue(&uploaded.drawTextureCoords, mDrawTextureCoords))
+            {
+                setUniform4fv(programObject, programState.drawTextureCoordsLoc, 1,
+                              mDrawTextureCoords);
+            }
+            if (UpdateUploadedValue(&uploaded.drawTextureDims, mDrawTextureDims))
+            {
+                setUniform2fv(programObject, programState.drawTextureDimsLoc, 1, mDrawTextureDims);
+            }
+        }
     }
 
     gles1State.clearDirty();
@@ -593,20 +635,141 @@ angle::Result GLES1Renderer::linkProgram(Context *context,
 
 angle::Result GLES1Renderer::initializeRendererProgram(Context *context, State *glState)
 {
-    if (mRendererProgramInitialized)
+    if (!mRendererProgramInitialized)
+    {
+        mShaderPrograms             = new ShaderProgramManager();
+        mRendererProgramInitialized = true;
+    }
+
+    GLES1ShaderState shaderState = computeShaderState(*glState);
+    if (mCurrentProgramState && shaderState == mCurrentShaderState)
     {
         return angle::Result::Continue;
     }
 
-    mShaderPrograms = new ShaderProgramManager();
+    GLES1ProgramState *programState = nullptr;
+
+    auto iter = mProgramStates.find(shaderState);
+    if (iter != mProgramStates.end())
+    {
+        programState = iter->second.get();
+    }
+    else
+    {
+        std::unique_ptr<GLES1ProgramState> newProgramState(new GLES1ProgramState());
+        ANGLE_TRY(createProgramVariant(context, glState, shaderState, newProgramState.get()));
+        programState                = newProgramState.get();
+        mProgramStates[shaderState] = std::move(newProgramState);
+    }
+
+    ANGLE_TRY(glState->setProgram(context, getProgram(programState->program)));
+    glState->setObjectDirty(GL_PROGRAM);
+
+    // The uniforms tracked by GLES1State's dirty bits may hold stale values in this variant.
+    glState->gles1().setAllDirty();
+
+    mCurrentShaderState  = shaderState;
+    mCurrentProgramState = programState;
+    return angle::Result::Continue;
+}
+
+GLES1ShaderState GLES1Renderer::computeShaderState(const State &glState) const
+{
+    const GLES1State &gles1State = glState.gles1();
+
+    GLES1ShaderState shaderState;
 
+    for (int i = 0; i < kTexUnitCount; i++)
+    {
+        // GL_OES_cube_map allows only one of TEXTURE_2D / TEXTURE_CUBE_MAP
+        // to be enabled per unit, thankfully. From the extension text:
+        //
+        //  --  Section 3.8.10 "Texture Application"
+        //
+        //      Replace the beginning sentences of the first paragraph (page 138)
+        //      with:
+        //
+        //      "Texturing is enabled or disabled using the generic Enable
+        //      and Disable commands, respectively, with the symbolic constants
+        //      TEXTURE_2D or TEXTURE_CUBE_MAP_OES to enable the two-dimensional or cube
+        //      map texturing respectively.  If the cube map texture and the two-
+        //      dimensional texture are enabled, then cube map texturing is used.  If
+        //      texturing is disabled, a rasterized fragment is passed on unaltered to the
+        //      next stage of the GL (although its texture coordinates may be discarded).
+        //      Otherwise, a texture value is found according to the parameter values of
+        //      the currently bound texture image of the appropriate dimensionality.
+
+        bool cubeEnabled = gles1State.isTextureTargetEnabled(i, TextureType::CubeMap);
+        bool tex2DEnabled =
+            !cubeEnabled && gles1State.isTextureTargetEnabled(i, TextureType::_2D);
+
+        shaderState.texCubeEnables[i] = cubeEnabled;
+        shaderState.tex2DEnables[i]   = tex2DEnabled;
+
+        // The texture environment of a disabled unit is never used, so it is left out of the
+        // state to avoid needless variants.
+        if (!cubeEnabled && !tex2DEnabled)
+        {
+            continue;
+        }
+
+        const TextureEnvironmentParameters &env = gles1State.textureEnvironment(i);
+
+        shaderState.texEnvModes[i] = ToGLenum(env.mode);
+        if (env.mode == TextureEnvMode::Combine)
+        {
+            shaderState.texCombineRgbs[i]   = ToGLenum(env.combineRgb);
+            shaderState.texCombineAlphas[i] = ToGLenum(env.combineAlpha);
+        }
+    }
+
+    for (int i = 0; i < kClipPlaneCount; i++)
+    {
+        shaderState.clipPlaneEnables[i] = glState.getEnableFeature(GL_CLIP_PLANE0 + i);
+    }
+
+    shaderState.lightingEnabled  = glState.getEnableFeature(GL_LIGHTING);
+    shaderState.fogEnabled       = glState.getEnableFeature(GL_FOG);
+    shaderState.alphaTestEnabled = glState.getEnableFeature(GL_ALPHA_TEST);
+
+    return shaderState;
+}
+
+angle::Result GLES1Renderer::createProgramVariant(Context *context,
+                                                  State *glState,
+                                                  const GLES1ShaderState &shaderState,
+                                                  GLES1ProgramState *programState)
+{
     ShaderProgramID vertexShader;
     ShaderProgramID fragmentShader;
 
     ANGLE_TRY(compileShader(context, ShaderType::Vertex, kGLES1DrawVShader, &vertexShader));
 
+    bool enableClipPlanes = false;
+    for (uint32_t clipPlaneEnable : shaderState.clipPlaneEnables)
+    {
+        enableClipPlanes = enableClipPlanes || clipPlaneEnable;
+    }
+
     std::stringstream fragmentStream;
     fragmentStream << kGLES1DrawFShaderHeader;
+    fragmentStream << "\n\n// Specialization constants\n";
+    AddShaderStateConstant(fragmentStream, "bool", "enable_texture_2d", shaderState.tex2DEnables);
+    AddShaderStateConstant(fragmentStream, "bool", "enable_texture_cube_map",
+                           shaderState.texCubeEnables);
+    AddShaderStateConstant(fragmentStream, "int", "texture_env_mode", shaderState.texEnvModes);
+    AddShaderStateConstant(fragmentStream, "int", "combine_rgb", shaderState.texCombineRgbs);
+    AddShaderStateConstant(fragmentStream, "int", "combine_alpha", shaderState.texCombineAlphas);
+    AddShaderStateConstant(fragmentStream, "bool", "clip_plane_enables",
+                           shaderState.clipPlaneEnables);
+    fragmentStream << "const bool enable_clip_planes = " << (enableClipPlanes ? "true" : "false")
+                   << ";\n";
+    fragmentStream << "const bool enable_lighting = "
+                   << (shaderState.lightingEnabled ? "true" : "false") << ";\n";
+    fragmentStream << "const bool enable_fog = " << (shaderState.fogEnabled ? "true" : "false")
+                   << ";\n";
+    fragmentStream << "const bool enable_alpha_test = "
+                   << (shaderState.alphaTestEnabled ? "true" : "false") << ";\n";
     fragmentStream << kGLES1DrawFShaderUniformDefs;
     fragmentStream << kGLES1DrawFShaderFunctions;
     fragmentStream << kGLES1DrawFShaderMultitexturing;
@@ -630,17 +793,17 @@ angle::Result GLES1Renderer::initializeRendererProgram(Context *context, State *
     }
 
     ANGLE_TRY(linkProgram(context, glState, vertexShader, fragmentShader, attribLocs,
-                          &mProgramState.program));
+                          &programState->program));
 
     mShaderPrograms->deleteShader(context, vertexShader);
     mShaderPrograms->deleteShader(context, fragmentShader);
 
-    Program *programObject = getProgram(mProgramState.program);
+    Program *programObject = getProgram(programState->program);
 
-    mProgramState.projMatrixLoc      = programObject->getUniformLocation("projection");
-    mProgramState.modelviewMatrixLoc = programObject->getUniformLocation("modelview");
-    mProgramState.textureMatrixLoc   = programObject->getUniformLocation("texture_matrix");
-    mProgramState.modelviewInvTrLoc  = programObject->getUniformLocation("modelview_invtr");
+    programState->projMatrixLoc      = programObject->getUniformLocation("projection");
+    programState->modelviewMatrixLoc = programObject->getUniformLocation("modelview");
+    programState->textureMatrixLoc   = programObject->getUniformLocation("texture_matrix");
+    programState->modelviewInvTrLoc  = programObject->getUniformLocation("modelview_invtr");
 
     for (int i = 0; i < kTexUnitCount; i++)
     {
@@ -650,114 +813,99 @@ angle::Result GLES1Renderer::initializeRendererProgram(Context *context, State *
         ss2d << "tex_sampler" << i;
         sscube << "tex_cube_sampler" << i;
 
-        mProgramState.tex2DSamplerLocs[i] = programObject->getUniformLocation(ss2d.str().c_str());
-        mProgramState.texCubeSamplerLocs[i] =
+        programState->tex2DSamplerLocs[i] = programObject->getUniformLocation(ss2d.str().c_str());
+        programState->texCubeSamplerLocs[i] =
             programObject->getUniformLocation(sscube.str().c_str());
     }
 
-    mProgramState.enableTexture2DLoc = programObject->getUniformLocation("enable_texture_2d");
-    mProgramState.enableTextureCubeMapLoc =
-        programObject->getUniformLocation("enable_texture_cube_map");
-
-    mProgramState.textureFormatLoc   = programObject->getUniformLocation("texture_format");
-    mProgramState.textureEnvModeLoc  = programObject->getUniformLocation("texture_env_mode");
-    mProgramState.combineRgbLoc      = programObject->getUniformLocation("combine_rgb");
-    mProgramState.combineAlphaLoc    = programObject->getUniformLocation("combine_alpha");
-    mProgramState.src0rgbLoc         = programObject->getUniformLocation("src0_rgb");
-    mProgramState.src0alphaLoc       = programObject->getUniformLocation("src0_alpha");
-    mProgramState.src1rgbLoc         = programObject->getUniformLocation("src1_rgb");
-    mProgramState.src1alphaLoc       = programObject->getUniformLocation("src1_alpha");
-    mProgramState.src2rgbLoc         = programObject->getUniformLocation("src2_rgb");
-    mProgramState.src2alphaLoc       = programObject->getUniformLocation("src2_alpha");
-    mProgramState.op0rgbLoc          = programObject->getUniformLocation("op0_rgb");
-    mProgramState.op0alphaLoc        = programObject->getUniformLocation("op0_alpha");
-    mProgramState.op1rgbLoc          = programObject->getUniformLocation("op1_rgb");
-    mProgramState.op1alphaLoc        = programObject->getUniformLocation("op1_alpha");
-    mProgramState.op2rgbLoc          = programObject->getUniformLocation("op2_rgb");
-    mProgramState.op2alphaLoc        = programObject->getUniformLocation("op2_alpha");
-    mProgramState.textureEnvColorLoc = programObject->getUniformLocation("texture_env_color");
-    mProgramState.rgbScaleLoc        = programObject->getUniformLocation("texture_env_rgb_scale");
-    mProgramState.alphaScaleLoc      = programObject->getUniformLocation("texture_env_alpha_scale");
-    mProgramState.pointSpriteCoordReplaceLoc =
+    programState->textureFormatLoc   = programObject->getUniformLocation("texture_format");
+    programState->src0rgbLoc         = programObject->getUniformLocation("src0_rgb");
+    programState->src0alphaLoc       = programObject->getUniformLocation("src0_alpha");
+    programState->src1rgbLoc         = programObject->getUniformLocation("src1_rgb");
+    programState->src1alphaLoc       = programObject->getUniformLocation("src1_alpha");
+    programState->src2rgbLoc         = programObject->getUniformLocation("src2_rgb");
+    programState->src2alphaLoc       = programObject->getUniformLocation("src2_alpha");
+    programState->op0rgbLoc          = programObject->getUniformLocation("op0_rgb");
+    programState->op0alphaLoc        = programObject->getUniformLocation("op0_alpha");
+    programState->op1rgbLoc          = programObject->getUniformLocation("op1_rgb");
+    programState->op1alphaLoc        = programObject->getUniformLocation("op1_alpha");
+    programState->op2rgbLoc          = programObject->getUniformLocation("op2_rgb");
+    programState->op2alphaLoc        = programObject->getUniformLocation("op2_alpha");
+    programState->textureEnvColorLoc = programObject->getUniformLocation("texture_env_color");
+    programState->rgbScaleLoc        = programObject->getUniformLocation("texture_env_rgb_scale");
+    programState->alphaScaleLoc      = programObject->getUniformLocation("texture_env_alpha_scale");
+    programState->pointSpriteCoordReplaceLoc =
         programObject->getUniformLocation("point_sprite_coord_replace");
 
-    mProgramState.enableAlphaTestLoc = programObject->getUniformLocation("enable_alpha_test");
-    mProgramState.alphaFuncLoc       = programObject->getUniformLocation("alpha_func");
-    mProgramState.alphaTestRefLoc    = programObject->getUniformLocation("alpha_test_ref");
+    programState->alphaFuncLoc    = programObject->getUniformLocation("alpha_func");
+    programState->alphaTestRefLoc = programObject->getUniformLocation("alpha_test_ref");
 
-    mProgramState.shadeModelFlatLoc = programObject->getUniformLocation("shade_model_flat");
-    mProgramState.enableLightingLoc = programObject->getUniformLocation("enable_lighting");
-    mProgramState.enableRescaleNormalLoc =
+    programState->shadeModelFlatLoc = programObject->getUniformLocation("shade_model_flat");
+    programState->enableRescaleNormalLoc =
         programObject->getUniformLocation("enable_rescale_normal");
-    mProgramState.enableNormalizeLoc = programObject->getUniformLocation("enable_normalize");
-    mProgramState.enableColorMaterialLoc =
+    programState->enableNormalizeLoc = programObject->getUniformLocation("enable_normalize");
+    programState->enableColorMaterialLoc =
         programObject->getUniformLocation("enable_color_material");
 
-    mProgramState.materialAmbientLoc  = programObject->getUniformLocation("material_ambient");
-    mProgramState.materialDiffuseLoc  = programObject->getUniformLocation("material_diffuse");
-    mProgramState.materialSpecularLoc = programObject->getUniformLocation("material_specular");
-    mProgramState.materialEmissiveLoc = programObject->getUniformLocation("material_emissive");
-    mProgramState.materialSpecularExponentLoc =
+    programState->materialAmbientLoc  = programObject->getUniformLocation("material_ambient");
+    programState->materialDiffuseLoc  = programObject->getUniformLocation("material_diffuse");
+    programState->materialSpecularLoc = programObject->getUniformLocation("material_specular");
+    programState->materialEmissiveLoc = programObject->getUniformLocation("material_emissive");
+    programState->materialSpecularExponentLoc =
         programObject->getUniformLocation("material_specular_exponent");
 
-    mProgramState.lightModelSceneAmbientLoc =
+    programState->lightModelSceneAmbientLoc =
         programObject->getUniformLocation("light_model_scene_ambient");
-    mProgramState.lightModelTwoSidedLoc =
+    programState->lightModelTwoSidedLoc =
         programObject->getUniformLocation("light_model_two_sided");
 
-    mProgramState.lightEnablesLoc    = programObject->getUniformLocation("light_enables");
-    mProgramState.lightAmbientsLoc   = programObject->getUniformLocation("light_ambients");
-    mProgramState.lightDiffusesLoc   = programObject->getUniformLocation("light_diffuses");
-    mProgramState.lightSpecularsLoc  = programObject->getUniformLocation("light_speculars");
-    mProgramState.lightPositionsLoc  = programObject->getUniformLocation("light_positions");
-    mProgramState.lightDirectionsLoc = programObject->getUniformLocation("light_directions");
-    mProgramState.lightSpotlightExponentsLoc =
+    programState->lightEnablesLoc    = programObject->getUniformLocation("light_enables");
+    programState->lightAmbientsLoc   = programObject->getUniformLocation("light_ambients");
+    programState->lightDiffusesLoc   = programObject->getUniformLocation("light_diffuses");
+    programState->lightSpecularsLoc  = programObject->getUniformLocation("light_speculars");
+    programState->lightPositionsLoc  = programObject->getUniformLocation("light_positions");
+    programState->lightDirectionsLoc = programObject->getUniformLocation("light_directions");
+    programState->lightSpotlightExponentsLoc =
         programObject->getUniformLocation("light_spotlight_exponents");
-    mProgramState.lightSpotlightCutoffAnglesLoc =
+    programState->lightSpotlightCutoffAnglesLoc =
         programObject->getUniformLocation("light_spotlight_cutoff_angles");
-    mProgramState.lightAttenuationConstsLoc =
+    programState->lightAttenuationConstsLoc =
         programObject->getUniformLocation("light_attenuation_consts");
-    mProgramState.lightAttenuationLinearsLoc =
+    programState->lightAttenuationLinearsLoc =
         programObject->getUniformLocation("light_attenuation_linears");
-    mProgramState.lightAttenuationQuadraticsLoc =
+    programState->lightAttenuationQuadraticsLoc =
         programObject->getUniformLocation("light_attenuation_quadratics");
 
-    mProgramState.fogEnableLoc  = programObject->getUniformLocation("enable_fog");
-    mProgramState.fogModeLoc    = programObject->getUniformLocation("fog_mode");
-    mProgramState.fogDensityLoc = programObject->getUniformLocation("fog_density");
-    mProgramState.fogStartLoc   = programObject->getUniformLocation("fog_start");
-    mProgramState.fogEndLoc     = programObject->getUniformLocation("fog_end");
-    mProgramState.fogColorLoc   = programObject->getUniformLocation("fog_color");
-
-    mProgramState.enableClipPlanesLoc = programObject->getUniformLocation("enable_clip_planes");
-    mProgramState.clipPlaneEnablesLoc = programObject->getUniformLocation("clip_plane_enables");
-    mProgramState.clipPlanesLoc       = programObject->getUniformLocation("clip_planes");
-
-    mProgramState.pointRasterizationLoc = programObject->getUniformLocation("point_rasterization");
-    mProgramState.pointSizeMinLoc       = programObject->getUniformLocation("point_size_min");
-    mProgramState.pointSizeMaxLoc       = programObject->getUniformLocation("point_size_max");
-    mProgramState.pointDistanceAttenuationLoc =
+    programState->fogModeLoc    = programObject->getUniformLocation("fog_mode");
+    programState->fogDensityLoc = programObject->getUniformLocation("fog_density");
+    programState->fogStartLoc   = programObject->getUniformLocation("fog_start");
+    programState->fogEndLoc     = programObject->getUniformLocation("fog_end");
+    programState->fogColorLoc   = programObject->getUniformLocation("fog_color");
+
+    programState->clipPlanesLoc = programObject->getUniformLocation("clip_planes");
+
+    programState->pointRasterizationLoc = programObject->getUniformLocation("point_rasterization");
+    programState->pointSizeMinLoc       = programObject->getUniformLocation("point_size_min");
+    programState->pointSizeMaxLoc       = programObject->getUniformLocation("point_size_max");
+    programState->pointDistanceAttenuationLoc =
         programObject->getUniformLocation("point_distance_attenuation");
-    mProgramState.pointSpriteEnabledLoc = programObject->getUniformLocation("point_sprite_enabled");
+    programState->pointSpriteEnabledLoc = programObject->getUniformLocation("point_sprite_enabled");
 
-    mProgramState.enableDrawTextureLoc = programObject->getUniformLocation("enable_draw_texture");
-    mProgramState.drawTextureCoordsLoc = programObject->getUniformLocation("draw_texture_coords");
-    mProgramState.drawTextureDimsLoc   = programObject->getUniformLocation("draw_texture_dims");
-    mProgramState.drawTextureNormalizedCropRectLoc =
+    programState->enableDrawTextureLoc = programObject->getUniformLocation("enable_draw_texture");
+    programState->drawTextureCoordsLoc = programObject->getUniformLocation("draw_texture_coords");
+    programState->drawTextureDimsLoc   = programObject->getUniformLocation("draw_texture_dims");
+    programState->drawTextureNormalizedCropRectLoc =
         programObject->getUniformLocation("draw_texture_normalized_crop_rect");
 
     ANGLE_TRY(glState->setProgram(context, programObject));
 
     for (int i = 0; i < kTexUnitCount; i++)
     {
-        setUniform1i(context, programObject, mProgramState.tex2DSamplerLocs[i], i);
-        setUniform1i(context, programObject, mProgramState.texCubeSamplerLocs[i],
+        setUniform1i(context, programObject, programState->tex2DSamplerLocs[i], i);
+        setUniform1i(context, programObject, programState->texCubeSamplerLocs[i],
                      i + kTexUnitCount);
     }
 
-    glState->setObjectDirty(GL_PROGRAM);
-
-    mRendererProgramInitialized = true;
     return angle::Result::Continue;
 }
 
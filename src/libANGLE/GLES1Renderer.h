@@ -12,6 +12,7 @@
 
 #include "angle_gl.h"
 #include "common/angleutils.h"
+#include "common/hash_utils.h"
 #include "libANGLE/angletypes.h"
 
 #include <memory>
@@ -27,6 +28,46 @@ class State;
 class Shader;
 class ShaderProgramManager;
 
+// The subset of GLES1 state that the emulation shaders are specialized on.  Each unique state
+// gets its own program, in which these values are compile-time constants instead of uniforms
+// that the shaders branch on.  Every member is 32-bit so the struct can be hashed as raw memory.
+struct GLES1ShaderState
+{
+    static constexpr int kTexUnitCount   = 4;
+    static constexpr int kClipPlaneCount = 6;
+
+    GLES1ShaderState();
+
+    bool operator==(const GLES1ShaderState &other) const;
+    bool operator!=(const GLES1ShaderState &other) const { return !(*this == other); }
+
+    size_t hash() const { return angle::ComputeGenericHash(*this); }
+
+    std::array<uint32_t, kTexUnitCount> tex2DEnables;
+    std::array<uint32_t, kTexUnitCount> texCubeEnables;
+    std::array<uint32_t, kTexUnitCount> texEnvModes;
+    std::array<uint32_t, kTexUnitCount> texCombineRgbs;
+    std::array<uint32_t, kTexUnitCount> texCombineAlphas;
+    std::array<uint32_t, kClipPlaneCount> clipPlaneEnables;
+    uint32_t lightingEnabled;
+    uint32_t fogEnabled;
+    uint32_t alphaTestEnabled;
+};
+
+}  // namespace gl
+
+namespace std
+{
+template <>
+struct hash<gl::GLES1ShaderState>
+{
+    size_t operator()(const gl::GLES1ShaderState &key) const { return key.hash(); }
+};
+}  // namespace std
+
+namespace gl
+{
+
 class GLES1Renderer final : angle::NonCopyable
 {
   public:
@@ -48,7 +89,7 @@ class GLES1Renderer final : angle::NonCopyable
                      float width,
                      float height);
 
-    static constexpr int kTexUnitCount = 4;
+    static constexpr int kTexUnitCount = GLES1ShaderState::kTexUnitCount;
 
   private:
     using Mat4Uniform = float[16];
@@ -70,6 +111,13 @@ class GLES1Renderer final : angle::NonCopyable
                               ShaderProgramID *programOut);
     angle::Result initializeRendererProgram(Context *context, State *glState);
 
+    struct GLES1ProgramState;
+    GLES1ShaderState computeShaderState(const State &glState) const;
+    angle::Result createProgramVariant(Context *context,
+                                       State *glState,
+                                       const GLES1ShaderState &shaderState,
+                                       GLES1ProgramState *programState);
+
     void setUniform1i(Context *context,
                       Program *programObject,
                       UniformLocation location,
@@ -105,7 +153,7 @@ class GLES1Renderer final : angle::NonCopyable
     void setAttributesEnabled(Context *context, State *glState, AttributesMask mask);
 
     static constexpr int kLightCount     = 8;
-    static constexpr int kClipPlaneCount = 6;
+    static constexpr int kClipPlaneCount = GLES1ShaderState::kClipPlaneCount;
 
     static constexpr int kVertexAttribIndex           = 0;
     static constexpr int kNormalAttribIndex           = 1;
@@ -116,26 +164,41 @@ class GLES1Renderer final : angle::NonCopyable
     bool mRendererProgramInitialized;
     ShaderProgramManager *mShaderPrograms;
 
+    // Last values uploaded to a program for uniforms that GLES1State has no dirty bits for.  They
+    // are compared against on every draw so that unchanged values are not re-uploaded.
+    struct GLES1UntrackedUniforms
+    {
+        GLint enableRescaleNormal = 0;
+        GLint enableNormalize     = 0;
+        GLint enableColorMaterial = 0;
+        GLint pointRasterization  = 0;
+        GLint pointSpriteEnabled  = 0;
+        GLint enableDrawTexture   = 0;
+
+        std::array<GLint, kTexUnitCount> textureFormats         = {};
+        std::array<Vec4Uniform, kTexUnitCount> textureCropRects = {};
+        Vec4Uniform drawTextureCoords                           = {};
+        GLfloat drawTextureDims[2]                              = {};
+    };
+
     struct GLES1ProgramState
     {
         ShaderProgramID program;
 
+        // Starts out matching the program's zero-initialized default uniforms.
+        GLES1UntrackedUniforms uploadedUniforms;
+
         UniformLocation projMatrixLoc;
         UniformLocation modelviewMatrixLoc;
         UniformLocation textureMatrixLoc;
         UniformLocation modelviewInvTrLoc;
 
         // Texturing
-        UniformLocation enableTexture2DLoc;
-        UniformLocation enableTextureCubeMapLoc;
         std::array<UniformLocation, kTexUnitCount> tex2DSamplerLocs;
         std::array<UniformLocation, kTexUnitCount> texCubeSamplerLocs;
 
         UniformLocation textureFormatLoc;
 
-        UniformLocation textureEnvModeLoc;
-        UniformLocation combineRgbLoc;
-        UniformLocation combineAlphaLoc;
         UniformLocation src0rgbLoc;
         UniformLocation src0alphaLoc;
         UniformLocation src1rgbLoc;
@@ -154,13 +217,11 @@ class GLES1Renderer final : angle::NonCopyable
         UniformLocation pointSpriteCoordReplaceLoc;
 
         // Alpha test
-        UniformLocation enableAlphaTestLoc;
         UniformLocation alphaFuncLoc;
         UniformLocation alphaTestRefLoc;
 
         // Shading, materials, and lighting
         UniformLocation shadeModelFlatLoc;
-        UniformLocation enableLightingLoc;
         UniformLocation enableRescaleNormalLoc;
         UniformLocation enableNormalizeLoc;
         UniformLocation enableColorMaterialLoc;
@@ -187,7 +248,6 @@ class GLES1Renderer final : angle::NonCopyable
         UniformLocation lightAttenuationQuadraticsLoc;
 
         // Fog
-        UniformLocation fogEnableLoc;
         UniformLocation fogModeLoc;
         UniformLocation fogDensityLoc;
         UniformLocation fogStartLoc;
@@ -195,8 +255,6 @@ class GLES1Renderer final : angle::NonCopyable
         UniformLocation fogColorLoc;
 
         // Clip planes
-        UniformLocation enableClipPlanesLoc;
-        UniformLocation clipPlaneEnablesLoc;
         UniformLocation clipPlanesLoc;
 
         // Point rasterization
@@ -216,12 +274,6 @@ class GLES1Renderer final : angle::NonCopyable
     struct GLES1UniformBuffers
     {
         std::array<Mat4Uniform, kTexUnitCount> textureMatrices;
-        std::array<GLint, kTexUnitCount> tex2DEnables;
-        std::array<GLint, kTexUnitCount> texCubeEnables;
-
-        std::array<GLint, kTexUnitCount> texEnvModes;
-        std::array<GLint, kTexUnitCount> texCombineRgbs;
-        std::array<GLint, kTexUnitCount> texCombineAlphas;
 
         std::array<GLint, kTexUnitCount> texCombineSrc0Rgbs;
         std::array<GLint, kTexUnitCount> texCombineSrc0Alphas;
@@ -254,7 +306,6 @@ class GLES1Renderer final : angle::NonCopyable
         std::array<GLfloat, kLightCount> attenuationQuadratics;
 
         // Clip planes
-        std::array<GLint, kClipPlaneCount> clipPlaneEnables;
         std::array<Vec4Uniform, kClipPlaneCount> clipPlanes;
 
         // Texture crop rectangles
@@ -262,7 +313,11 @@ class GLES1Renderer final : angle::NonCopyable
     };
 
     GLES1UniformBuffers mUniformBuffers;
-    GLES1ProgramState mProgramState;
+
+    // Program variants, compiled lazily the first time their state is drawn with.
+    angle::HashMap<GLES1ShaderState, std::unique_ptr<GLES1ProgramState>> mProgramStates;
+    GLES1ShaderState mCurrentShaderState;
+    GLES1ProgramState *mCurrentProgramState;
 
     bool mDrawTextureEnabled      = false;
     GLfloat mDrawTextureCoords[4] = {0.0f, 0.0f, 0.0f, 0.0f};
@@ -13,22 +13,32 @@
 #include <functional>
 
 #include "common/debug.h"
+#include "common/mathutil.h"
 
 namespace gl
 {
+namespace
+{
+constexpr size_t kBitsPerWord = 64;
+
+// Released handles from this value up go in the heap instead of the bitmap, which keeps the bitmap
+// under 130KB.
+constexpr GLuint kMaxBitmapHandle = 1 << 20;
+}  // anonymous namespace
 
 struct HandleAllocator::HandleRangeComparator
 {
     bool operator()(const HandleRange &range, GLuint handle) const { return (range.end < handle); }
 };
 
-HandleAllocator::HandleAllocator() : mBaseValue(1), mNextValue(1), mLoggingEnabled(false)
+HandleAllocator::HandleAllocator()
+    : mBaseValue(1), mNextValue(1), mReleasedSummaryBegin(0), mLoggingEnabled(false)
 {
     mUnallocatedList.push_back(HandleRange(1, std::numeric_limits<GLuint>::max()));
 }
 
 HandleAllocator::HandleAllocator(GLuint maximumHandleValue)
-    : mBaseValue(1), mNextValue(1), mLoggingEnabled(false)
+    : mBaseValue(1), mNextValue(1), mReleasedSummaryBegin(0), mLoggingEnabled(false)
 {
     mUnallocatedList.push_back(HandleRange(1, maximumHandleValue));
 }
@@ -42,30 +52,172 @@ void HandleAllocator::setBaseHandle(GLuint value)
     mNextValue = value;
 }
 
-GLuint HandleAllocator::allocate()
+ANGLE_INLINE bool HandleAllocator::hasReleasedHandles() const
 {
-    ASSERT(!mUnallocatedList.empty() || !mReleasedList.empty());
+    return mReleasedSummaryBegin < mReleasedSummary.size() || !mReleasedList.empty();
+}
 
-    // Allocate from released list, logarithmic time for pop_heap.
-    if (!mReleasedList.empty())
+ANGLE_INLINE size_t HandleAllocator::allocateReleasedHandles(size_t count, GLuint *handlesOut)
+{
+    size_t allocated = 0;
+    while (allocated < count && mReleasedSummaryBegin < mReleasedSummary.size())
+    {
+        uint64_t &summary = mReleasedSummary[mReleasedSummaryBegin];
+        if (summary == 0)
+        {
+            ++mReleasedSummaryBegin;
+            continue;
+        }
+
+        size_t wordIndex = mReleasedSummaryBegin * kBitsPerWord + gl::ScanForward(summary);
+        uint64_t &word   = mReleasedBits[wordIndex];
+        ASSERT(word != 0);
+
+        // Take as many handles as needed from this word.
+        while (allocated < count && word != 0)
+        {
+            size_t bit              = gl::ScanForward(word);
+            handlesOut[allocated++] = static_cast<GLuint>(wordIndex * kBitsPerWord + bit);
+            word &= word - 1;
+        }
+
+        if (word == 0)
+        {
+            summary &= ~(uint64_t(1) << (wordIndex % kBitsPerWord));
+        }
+    }
+
+    // All the handles in the bitmap are smaller than the ones in the heap, so the heap is only used
+    // once the bitmap is empty.  Logarithmic time for pop_heap.
+    for (; allocated < count && !mReleasedList.empty(); ++allocated)
     {
         std::pop_heap(mReleasedList.begin(), mReleasedList.end(), std::greater<GLuint>());
-        GLuint reusedHandle = mReleasedList.back();
+        handlesOut[allocated] = mReleasedList.back();
         mReleasedList.pop_back();
+    }
+
+    return allocated;
+}
+
+ANGLE_INLINE void HandleAllocator::addReleasedHandle(GLuint handle)
+{
+    size_t wordIndex = handle / kBitsPerWord;
+    if (ANGLE_UNLIKELY(wordIndex >= mReleasedBits.size()) && !growReleasedBits(handle))
+    {
+        // Add to the heap, logarithmic time for push_heap.
+        mReleasedList.push_back(handle);
+        std::push_heap(mReleasedList.begin(), mReleasedList.end(), std::greater<GLuint>());
+        return;
+    }
+
+    // Add to the bitmap, constant time.
+    size_t summaryIndex = wordIndex / kBitsPerWord;
+    ASSERT((mReleasedBits[wordIndex] & (uint64_t(1) << (handle % kBitsPerWord))) == 0);
+    mReleasedBits[wordIndex] |= uint64_t(1) << (handle % kBitsPerWord);
+    mReleasedSummary[summaryIndex] |= uint64_t(1) << (wordIndex % kBitsPerWord);
+    mReleasedSummaryBegin = std::min(mReleasedSummaryBegin, summaryIndex);
+}
+
+bool HandleAllocator::growReleasedBits(GLuint handle)
+{
+    if (handle >= kMaxBitmapHandle)
+    {
+        return false;
+    }
+
+    // The bitmap grows a whole summary word at a time.
+    size_t summaryIndex = handle / kBitsPerWord / kBitsPerWord;
+    mReleasedSummary.resize(summaryIndex + 1, 0);
+    mReleasedBits.resize(mReleasedSummary.size() * kBitsPerWord, 0);
+    return true;
+}
+
+bool HandleAllocator::removeReleasedHandle(GLuint handle)
+{
+    size_t wordIndex = handle / kBitsPerWord;
+    if (wordIndex >= mReleasedBits.size())
+    {
+        if (handle < kMaxBitmapHandle)
+        {
+            return false;
+        }
+
+        // Might be a slow operation, but this only happens with huge handles.
+        auto releasedIt = std::find(mReleasedList.begin(), mReleasedList.end(), handle);
+        if (releasedIt == mReleasedList.end())
+        {
+            return false;
+        }
+        mReleasedList.erase(releasedIt);
+        std::make_heap(mReleasedList.begin(), mReleasedList.end(), std::greater<GLuint>());
+        return true;
+    }
+
+    uint64_t bit = uint64_t(1) << (handle % kBitsPerWord);
+    if ((mReleasedBits[wordIndex] & bit) == 0)
+    {
+        return false;
+    }
 
+    mReleasedBits[wordIndex] &= ~bit;
+    if (mReleasedBits[wordIndex] == 0)
+    {
+        mReleasedSummary[wordIndex / kBitsPerWord] &= ~(uint64_t(1) << (wordIndex % kBitsPerWord));
+    }
+    return true;
+}
+
+size_t HandleAllocator::allocateUnallocatedHandles(size_t count, GLuint *handlesOut)
+{
+    size_t allocated = 0;
+    while (allocated < count)
+    {
+        ASSERT(!mUnallocatedList.empty());
+
+        // Allocate from the front of the first range, constant time unless the range runs out.
+        HandleRange &range = mUnallocatedList.front();
+        ASSERT(range.begin > 0);
+
+        size_t rangeCount = static_cast<size_t>(range.end - range.begin) + 1;
+        size_t takeCount  = std::min(count - allocated, rangeCount);
+        for (size_t index = 0; index < takeCount; ++index)
+        {
+            handlesOut[allocated++] = range.begin + static_cast<GLuint>(index);
+        }
+
+        if (takeCount == rangeCount)
+        {
+            mUnallocatedList.erase(mUnallocatedList.begin());
+        }
+        else
+        {
+            range.begin += static_cast<GLuint>(takeCount);
+        }
+    }
+    return allocated;
+}
+
+GLuint HandleAllocator::allocate()
+{
+    ASSERT(!mUnallocatedList.empty() || hasReleasedHandles());
+
+    // Allocate from the released handles, smallest first.
+    GLuint handle = 0;
+    if (hasReleasedHandles() && allocateReleasedHandles(1, &handle) == 1)
+    {
         if (mLoggingEnabled)
         {
-            WARN() << "HandleAllocator::allocate reusing " << reusedHandle << std::endl;
+            WARN() << "HandleAllocator::allocate reusing " << handle << std::endl;
         }
 
-        return reusedHandle;
+        return handle;
     }
 
     // Allocate from unallocated list, constant time.
     auto listIt = mUnallocatedList.begin();
 
-    GLuint freeListHandle = listIt->begin;
-    ASSERT(freeListHandle > 0);
+    handle = listIt->begin;
+    ASSERT(handle > 0);
 
     if (listIt->begin == listIt->end)
     {
@@ -78,10 +230,25 @@ GLuint HandleAllocator::allocate()
 
     if (mLoggingEnabled)
     {
-        WARN() << "HandleAllocator::allocate allocating " << freeListHandle << std::endl;
+        WARN() << "HandleAllocator::allocate allocating " << handle << std::endl;
     }
 
-    return freeListHandle;
+    return handle;
+}
+
+void HandleAllocator::allocate(size_t count, GLuint *handlesOut)
+{
+    size_t reusedCount = allocateReleasedHandles(count, handlesOut);
+    allocateUnallocatedHandles(count - reusedCount, handlesOut + reusedCount);
+
+    if (mLoggingEnabled)
+    {
+        for (size_t index = 0; index < count; ++index)
+        {
+            const char *action = index < reusedCount ? "reusing " : "allocating ";
+            WARN() << "HandleAllocator::allocate " << action << handlesOut[index] << std::endl;
+        }
+    }
 }
 
 void HandleAllocator::release(GLuint handle)
@@ -91,9 +258,20 @@ void HandleAllocator::release(GLuint handle)
         WARN() << "HandleAllocator::release releasing " << handle << std::endl;
     }
 
-    // Add to released list, logarithmic time for push_heap.
-    mReleasedList.push_back(handle);
-    std::push_heap(mReleasedList.begin(), mReleasedList.end(), std::greater<GLuint>());
+    addReleasedHandle(handle);
+}
+
+void HandleAllocator::release(size_t count, const GLuint *handles)
+{
+    for (size_t index = 0; index < count; ++index)
+    {
+        if (mLoggingEnabled)
+        {
+            WARN() << "HandleAllocator::release releasing " << handles[index] << std::endl;
+        }
+
+        addReleasedHandle(handles[index]);
+    }
 }
 
 void HandleAllocator::reserve(GLuint handle)
@@ -103,16 +281,10 @@ void HandleAllocator::reserve(GLuint handle)
         WARN() << "HandleAllocator::reserve reserving " << handle << std::endl;
     }
 
-    // Clear from released list -- might be a slow operation.
-    if (!mReleasedList.empty())
+    // Clear from released list.
+    if (removeReleasedHandle(handle))
     {
-        auto releasedIt = std::find(mReleasedList.begin(), mReleasedList.end(), handle);
-        if (releasedIt != mReleasedList.end())
-        {
-            mReleasedList.erase(releasedIt);
-            std::make_heap(mReleasedList.begin(), mReleasedList.end(), std::greater<GLuint>());
-            return;
-        }
+        return;
     }
 
     // Not in released list, reserve in the unallocated list.
@@ -154,6 +326,9 @@ void HandleAllocator::reset()
 {
     mUnallocatedList.clear();
     mUnallocatedList.push_back(HandleRange(1, std::numeric_limits<GLuint>::max()));
+    mReleasedBits.clear();
+    mReleasedSummary.clear();
+    mReleasedSummaryBegin = 0;
     mReleasedList.clear();
     mBaseValue = 1;
     mNextValue = 1;
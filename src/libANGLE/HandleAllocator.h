@@ -31,6 +31,12 @@ class HandleAllocator final : angle::NonCopyable
 
     GLuint allocate();
     void release(GLuint handle);
+
+    // Bulk versions of allocate() and release(), for glGen* and glDelete*.  The handles are
+    // allocated in the same order as |count| calls to allocate() would.
+    void allocate(size_t count, GLuint *handlesOut);
+    void release(size_t count, const GLuint *handles);
+
     void reserve(GLuint handle);
     void reset();
 
@@ -53,10 +59,28 @@ class HandleAllocator final : angle::NonCopyable
 
     struct HandleRangeComparator;
 
+    bool hasReleasedHandles() const;
+    size_t allocateReleasedHandles(size_t count, GLuint *handlesOut);
+    void addReleasedHandle(GLuint handle);
+    bool growReleasedBits(GLuint handle);
+    bool removeReleasedHandle(GLuint handle);
+    size_t allocateUnallocatedHandles(size_t count, GLuint *handlesOut);
+
     // The freelist consists of never-allocated handles, stored
     // as ranges, and handles that were previously allocated and
-    // released, stored in a heap.
+    // released.
     std::vector<HandleRange> mUnallocatedList;
+
+    // Released handles are kept in a two-level bitmap: one bit per handle, and one summary bit per
+    // word of the first level telling whether that word has any bit set.  The summary words below
+    // mReleasedSummaryBegin are known to be zero, so finding the smallest released handle is
+    // amortized constant time.
+    std::vector<uint64_t> mReleasedBits;
+    std::vector<uint64_t> mReleasedSummary;
+    size_t mReleasedSummaryBegin;
+
+    // Released handles too large for the bitmap, stored in a heap.  These only happen when the
+    // application reserves huge handles, so they don't need to be fast.
     std::vector<GLuint> mReleasedList;
 
     bool mLoggingEnabled;
@@ -193,4 +193,69 @@ TEST(HandleAllocatorTest, ReserveAfterReleaseBug)
     allocator.allocate();
 }
 
+// Tests that bulk allocation and release hand out the same handles as one at a time.
+TEST(HandleAllocatorTest, BulkAllocateAndRelease)
+{
+    gl::HandleAllocator bulkAllocator;
+    gl::HandleAllocator allocator;
+
+    bulkAllocator.reserve(10);
+    allocator.reserve(10);
+
+    std::vector<GLuint> handles(200);
+    bulkAllocator.allocate(handles.size(), handles.data());
+    for (GLuint handle : handles)
+    {
+        EXPECT_EQ(allocator.allocate(), handle);
+    }
+
+    // Release every third handle, out of order.
+    std::vector<GLuint> released;
+    for (size_t index = 0; index < handles.size(); index += 3)
+    {
+        released.push_back(handles[index]);
+    }
+    std::reverse(released.begin(), released.end());
+    bulkAllocator.release(released.size(), released.data());
+    for (GLuint handle : released)
+    {
+        allocator.release(handle);
+    }
+
+    // The released handles are reused smallest first, then new ones are allocated.
+    std::vector<GLuint> reused(released.size() + 10);
+    bulkAllocator.allocate(reused.size(), reused.data());
+    for (GLuint handle : reused)
+    {
+        EXPECT_EQ(allocator.allocate(), handle);
+    }
+    EXPECT_TRUE(std::is_sorted(reused.begin(), reused.end()));
+}
+
+// Tests that released handles are reused smallest first, small or huge.
+TEST(HandleAllocatorTest, ReuseSmallestReleasedHandle)
+{
+    gl::HandleAllocator allocator;
+
+    const GLuint kHandles[] = {std::numeric_limits<GLuint>::max() - 1, 5000000, 70000, 4096, 2};
+    for (GLuint handle : kHandles)
+    {
+        allocator.reserve(handle);
+    }
+    for (GLuint handle : kHandles)
+    {
+        allocator.release(handle);
+    }
+
+    // Reserving a released handle takes it out of the released handles.
+    allocator.reserve(70000);
+
+    EXPECT_EQ(2u, allocator.allocate());
+    EXPECT_EQ(4096u, allocator.allocate());
+    EXPECT_EQ(5000000u, allocator.allocate());
+    EXPECT_EQ(std::numeric_limits<GLuint>::max() - 1, allocator.allocate());
+    EXPECT_EQ(1u, allocator.allocate());
+    EXPECT_EQ(3u, allocator.allocate());
+}
+
 }  // anonymous namespace
@@ -9,6 +9,7 @@
 
 #include "libANGLE/ResourceManager.h"
 
+#include "common/FastVector.h"
 #include "libANGLE/Buffer.h"
 #include "libANGLE/Context.h"
 #include "libANGLE/Fence.h"
@@ -38,6 +39,19 @@ IDType AllocateEmptyObject(HandleAllocator *handleAllocator,
     return handle;
 }
 
+template <typename ResourceType, typename IDType>
+void AllocateEmptyObjects(HandleAllocator *handleAllocator,
+                          ResourceMap<ResourceType, IDType> *objectMap,
+                          GLsizei count,
+                          IDType *handlesOut)
+{
+    handleAllocator->allocate(static_cast<size_t>(count), PackParam<GLuint *>(handlesOut));
+    for (GLsizei index = 0; index < count; ++index)
+    {
+        objectMap->assign(handlesOut[index], nullptr);
+    }
+}
+
 }  // anonymous namespace
 
 ResourceManagerBase::ResourceManagerBase() : mRefCount(1) {}
@@ -97,6 +111,32 @@ void TypedResourceManager<ResourceType, ImplT, IDType>::deleteObject(const Conte
     }
 }
 
+template <typename ResourceType, typename ImplT, typename IDType>
+void TypedResourceManager<ResourceType, ImplT, IDType>::deleteObjects(const Context *context,
+                                                                      GLsizei count,
+                                                                      const IDType *handles)
+{
+    angle::FastVector<GLuint, 64> releasedHandles;
+    for (GLsizei index = 0; index < count; ++index)
+    {
+        ResourceType *resource = nullptr;
+        if (!mObjectMap.erase(handles[index], &resource))
+        {
+            continue;
+        }
+
+        releasedHandles.push_back(GetIDValue(handles[index]));
+
+        if (resource)
+        {
+            ImplT::DeleteObject(context, resource);
+        }
+    }
+
+    // Requires an explicit this-> because of C++ template rules.
+    this->mHandleAllocator.release(releasedHandles.size(), releasedHandles.data());
+}
+
 // Unclear why Clang warns about weak vtables in this case.
 ANGLE_DISABLE_WEAK_TEMPLATE_VTABLES_WARNING
 template class TypedResourceManager<Buffer, BufferManager, BufferID>;
@@ -130,6 +170,11 @@ BufferID BufferManager::createBuffer()
     return AllocateEmptyObject(&mHandleAllocator, &mObjectMap);
 }
 
+void BufferManager::createBuffers(GLsizei count, BufferID *buffersOut)
+{
+    AllocateEmptyObjects(&mHandleAllocator, &mObjectMap, count, buffersOut);
+}
+
 Buffer *BufferManager::getBuffer(BufferID handle) const
 {
     return mObjectMap.query(handle);
@@ -239,6 +284,11 @@ TextureID TextureManager::createTexture()
     return AllocateEmptyObject(&mHandleAllocator, &mObjectMap);
 }
 
+void TextureManager::createTextures(GLsizei count, TextureID *texturesOut)
+{
+    AllocateEmptyObjects(&mHandleAllocator, &mObjectMap, count, texturesOut);
+}
+
 void TextureManager::signalAllTexturesDirty() const
 {
     for (const auto &texture : mObjectMap)
@@ -281,6 +331,11 @@ RenderbufferID RenderbufferManager::createRenderbuffer()
     return {AllocateEmptyObject(&mHandleAllocator, &mObjectMap)};
 }
 
+void RenderbufferManager::createRenderbuffers(GLsizei count, RenderbufferID *renderbuffersOut)
+{
+    AllocateEmptyObjects(&mHandleAllocator, &mObjectMap, count, renderbuffersOut);
+}
+
 Renderbuffer *RenderbufferManager::getRenderbuffer(RenderbufferID handle) const
 {
     return mObjectMap.query(handle);
@@ -309,6 +364,11 @@ SamplerID SamplerManager::createSampler()
     return AllocateEmptyObject(&mHandleAllocator, &mObjectMap);
 }
 
+void SamplerManager::createSamplers(GLsizei count, SamplerID *samplersOut)
+{
+    AllocateEmptyObjects(&mHandleAllocator, &mObjectMap, count, samplersOut);
+}
+
 Sampler *SamplerManager::getSampler(SamplerID handle) const
 {
     return mObjectMap.query(handle);
@@ -370,6 +430,11 @@ FramebufferID FramebufferManager::createFramebuffer()
     return AllocateEmptyObject(&mHandleAllocator, &mObjectMap);
 }
 
+void FramebufferManager::createFramebuffers(GLsizei count, FramebufferID *framebuffersOut)
+{
+    AllocateEmptyObjects(&mHandleAllocator, &mObjectMap, count, framebuffersOut);
+}
+
 Framebuffer *FramebufferManager::getFramebuffer(FramebufferID handle) const
 {
     return mObjectMap.query(handle);
@@ -69,6 +69,9 @@ class TypedResourceManager : public ResourceManagerBase
     TypedResourceManager() {}
 
     void deleteObject(const Context *context, IDType handle);
+    // Same as calling deleteObject() on each handle, but releases the handles in bulk.
+    void deleteObjects(const Context *context, GLsizei count, const IDType *handles);
+
     ANGLE_INLINE bool isHandleGenerated(IDType handle) const
     {
         // Zero is always assumed to have been generated implicitly.
@@ -130,6 +133,7 @@ class BufferManager : public TypedResourceManager<Buffer, BufferManager, BufferI
 {
   public:
     BufferID createBuffer();
+    void createBuffers(GLsizei count, BufferID *buffersOut);
     Buffer *getBuffer(BufferID handle) const;
 
     ANGLE_INLINE Buffer *checkBufferAllocation(rx::GLImplFactory *factory, BufferID handle)
@@ -190,6 +194,7 @@ class TextureManager : public TypedResourceManager<Texture, TextureManager, Text
 {
   public:
     TextureID createTexture();
+    void createTextures(GLsizei count, TextureID *texturesOut);
     ANGLE_INLINE Texture *getTexture(TextureID handle) const
     {
         ASSERT(mObjectMap.query({0}) == nullptr);
@@ -221,6 +226,7 @@ class RenderbufferManager
 {
   public:
     RenderbufferID createRenderbuffer();
+    void createRenderbuffers(GLsizei count, RenderbufferID *renderbuffersOut);
     Renderbuffer *getRenderbuffer(RenderbufferID handle) const;
 
     Renderbuffer *checkRenderbufferAllocation(rx::GLImplFactory *factory, RenderbufferID handle)
@@ -239,6 +245,7 @@ class SamplerManager : public TypedResourceManager<Sampler, SamplerManager, Samp
 {
   public:
     SamplerID createSampler();
+    void createSamplers(GLsizei count, SamplerID *samplersOut);
     Sampler *getSampler(SamplerID handle) const;
     bool isSampler(SamplerID sampler) const;
 
@@ -271,6 +278,7 @@ class FramebufferManager
 {
   public:
     FramebufferID createFramebuffer();
+    void createFramebuffers(GLsizei count, FramebufferID *framebuffersOut);
     Framebuffer *getFramebuffer(FramebufferID handle) const;
     void setDefaultFramebuffer(Framebuffer *framebuffer);
 
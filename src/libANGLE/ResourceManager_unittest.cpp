@@ -70,4 +70,29 @@ TEST_F(ResourceManagerTest, ReallocateBoundRenderbuffer)
     EXPECT_NE(1u, newRenderbuffer.value);
 }
 
+// Tests that bulk deletion ignores unknown and repeated handles, and that the handles it releases
+// are reused by bulk creation.
+TEST_F(ResourceManagerTest, CreateAndDeleteBuffers)
+{
+    BufferID buffers[4];
+    mBufferManager->createBuffers(4, buffers);
+    for (GLuint index = 0; index < 4; ++index)
+    {
+        EXPECT_EQ(index + 1, buffers[index].value);
+        EXPECT_TRUE(mBufferManager->isHandleGenerated(buffers[index]));
+    }
+
+    const BufferID deletedBuffers[] = {buffers[2], {100}, buffers[0], buffers[2]};
+    mBufferManager->deleteObjects(nullptr, 4, deletedBuffers);
+    EXPECT_FALSE(mBufferManager->isHandleGenerated(buffers[0]));
+    EXPECT_TRUE(mBufferManager->isHandleGenerated(buffers[1]));
+    EXPECT_FALSE(mBufferManager->isHandleGenerated(buffers[2]));
+
+    BufferID newBuffers[3];
+    mBufferManager->createBuffers(3, newBuffers);
+    EXPECT_EQ(1u, newBuffers[0].value);
+    EXPECT_EQ(3u, newBuffers[1].value);
+    EXPECT_EQ(5u, newBuffers[2].value);
+}
+
 }  // anonymous namespace
@@ -4,8 +4,11 @@
 // found in the LICENSE file.
 //
 // ResourceMap:
-//   An optimized resource map which packs the first set of allocated objects into a
-//   flat array, and then falls back to an unordered map for the higher handle values.
+//   An optimized resource map which stores objects in a two-level page table indexed by handle,
+//   and falls back to an unordered map for sparse and very high handle values.  A page is only
+//   allocated for handles that follow a mostly full page, which is how handles from the handle
+//   allocator grow, or once enough sparse handles fall in it.  Pages are freed when they become
+//   empty.
 //
 
 #ifndef LIBANGLE_RESOURCE_MAP_H_
@@ -25,10 +28,11 @@ class ResourceMap final : angle::NonCopyable
 
     ANGLE_INLINE ResourceType *query(IDType id) const
     {
-        GLuint handle = GetIDValue(id);
-        if (handle < mFlatResourcesSize)
+        GLuint handle    = GetIDValue(id);
+        size_t pageIndex = handle >> kPageBits;
+        if (pageIndex < mPageCount && mPages[pageIndex] != nullptr)
         {
-            ResourceType *value = mFlatResources[handle];
+            ResourceType *value = mPages[pageIndex]->resources[handle & kPageMask];
             return (value == InvalidPointer() ? nullptr : value);
         }
         auto it = mHashedResources.find(handle);
@@ -61,13 +65,14 @@ class ResourceMap final : angle::NonCopyable
       private:
         friend class ResourceMap;
         Iterator(const ResourceMap &origin,
-                 GLuint flatIndex,
+                 GLuint pagedIndex,
                  typename HashMap::const_iterator hashIndex,
                  bool skipNulls);
+        void skipHashedNulls();
         void updateValue();
 
         const ResourceMap &mOrigin;
-        GLuint mFlatIndex;
+        GLuint mPagedIndex;
         typename HashMap::const_iterator mHashIndex;
         IndexAndResource mValue;
         bool mSkipNulls;
@@ -76,7 +81,7 @@ class ResourceMap final : angle::NonCopyable
     // null values represent reserved handles.
     Iterator begin() const;
     Iterator end() const;
-    Iterator find(IDType handle) const;
+    Iterator find(IDType id) const;
 
     Iterator beginWithNull() const;
     Iterator endWithNull() const;
@@ -84,53 +89,83 @@ class ResourceMap final : angle::NonCopyable
     // Not a constant-time operation, should only be used for verification.
     bool empty() const;
 
+    size_t getAllocatedPageCountForTesting() const;
+
   private:
     friend class Iterator;
 
-    GLuint nextResource(size_t flatIndex, bool skipNulls) const;
+    // One page of the table.  |count| is the number of assigned handles in the page, which lets
+    // iteration skip empty pages.
+    struct Page;
+
+    GLuint nextResource(size_t pagedIndex, bool skipNulls) const;
+    GLuint pagedResourcesEnd() const;
+    Page *getPage(GLuint handle) const;
+    bool followsDensePage(size_t pageIndex) const;
+    Page *allocatePage(size_t pageIndex);
+    void freePage(size_t pageIndex);
+    void deletePages();
 
     // constexpr methods cannot contain reinterpret_cast, so we need a static method.
     static ResourceType *InvalidPointer();
     static constexpr intptr_t kInvalidPointer = static_cast<intptr_t>(-1);
 
-    // Start with 32 maximum elements in the map, which can grow.
-    static constexpr size_t kInitialFlatResourcesSize = 0x20;
+    // 256 handles per page, so a page is 2KB on 64-bit.
+    static constexpr size_t kPageBits = 8;
+    static constexpr size_t kPageSize = static_cast<size_t>(1) << kPageBits;
+    static constexpr size_t kPageMask = kPageSize - 1;
+
+    // Start with a page table for 4k handles, which can grow.
+    static constexpr size_t kInitialPageCount = 16;
+
+    // Handles from 16M up are always hashed, which bounds the page table to 512KB.
+    static constexpr size_t kPagedResourcesLimit = 0x1000000;
+    static constexpr size_t kMaxPageCount        = kPagedResourcesLimit >> kPageBits;
 
-    // Experimental testing suggests that 16k is a reasonable upper limit.
-    static constexpr size_t kFlatResourcesLimit = 0x4000;
+    // Below that, sparse handles are hashed until this many fall in the same page.
+    static constexpr size_t kSparsePageThreshold = 16;
 
     // Size of one map element.
     static constexpr size_t kElementSize = sizeof(ResourceType *);
 
-    size_t mFlatResourcesSize;
-    ResourceType **mFlatResources;
+    size_t mPageCount;
+    Page **mPages;
 
     // A map of GL objects indexed by object ID.
     HashMap mHashedResources;
+
+    // The number of hashed handles in each page that isn't allocated.
+    angle::HashMap<size_t, size_t> mSparsePageCounts;
 };
 
 template <typename ResourceType, typename IDType>
-ResourceMap<ResourceType, IDType>::ResourceMap()
-    : mFlatResourcesSize(kInitialFlatResourcesSize),
-      mFlatResources(new ResourceType *[kInitialFlatResourcesSize])
+struct ResourceMap<ResourceType, IDType>::Page
 {
-    memset(mFlatResources, kInvalidPointer, mFlatResourcesSize * kElementSize);
-}
+    ResourceType *resources[kPageSize];
+    size_t count;
+};
+
+template <typename ResourceType, typename IDType>
+ResourceMap<ResourceType, IDType>::ResourceMap()
+    : mPageCount(kInitialPageCount), mPages(new Page *[kInitialPageCount]())
+{}
 
 template <typename ResourceType, typename IDType>
 ResourceMap<ResourceType, IDType>::~ResourceMap()
 {
     ASSERT(empty());
-    delete[] mFlatResources;
+    deletePages();
+    delete[] mPages;
 }
 
 template <typename ResourceType, typename IDType>
 ANGLE_INLINE bool ResourceMap<ResourceType, IDType>::contains(IDType id) const
 {
-    GLuint handle = GetIDValue(id);
-    if (handle < mFlatResourcesSize)
+    GLuint handle    = GetIDValue(id);
+    const Page *page = getPage(handle);
+    if (page != nullptr)
     {
-        return (mFlatResources[handle] != InvalidPointer());
+        return (page->resources[handle & kPageMask] != InvalidPointer());
     }
     return (mHashedResources.find(handle) != mHashedResources.end());
 }
@@ -139,25 +174,44 @@ template <typename ResourceType, typename IDType>
 bool ResourceMap<ResourceType, IDType>::erase(IDType id, ResourceType **resourceOut)
 {
     GLuint handle = GetIDValue(id);
-    if (handle < mFlatResourcesSize)
+    Page *page    = getPage(handle);
+    if (page != nullptr)
     {
-        auto &value = mFlatResources[handle];
+        auto &value = page->resources[handle & kPageMask];
         if (value == InvalidPointer())
         {
             return false;
         }
         *resourceOut = value;
         value        = InvalidPointer();
+        ASSERT(page->count > 0);
+        page->count--;
+
+        // The first page is used by almost every map, so it's kept.
+        size_t pageIndex = handle >> kPageBits;
+        if (page->count == 0 && pageIndex != 0)
+        {
+            freePage(pageIndex);
+        }
+        return true;
     }
-    else
+
+    auto it = mHashedResources.find(handle);
+    if (it == mHashedResources.end())
     {
-        auto it = mHashedResources.find(handle);
-        if (it == mHashedResources.end())
+        return false;
+    }
+    *resourceOut = it->second;
+    mHashedResources.erase(it);
+
+    if (handle < kPagedResourcesLimit)
+    {
+        auto countIt = mSparsePageCounts.find(handle >> kPageBits);
+        ASSERT(countIt != mSparsePageCounts.end() && countIt->second > 0);
+        if (--countIt->second == 0)
         {
-            return false;
+            mSparsePageCounts.erase(countIt);
         }
-        *resourceOut = it->second;
-        mHashedResources.erase(it);
     }
     return true;
 }
@@ -165,47 +219,145 @@ bool ResourceMap<ResourceType, IDType>::erase(IDType id, ResourceType **resource
 template <typename ResourceType, typename IDType>
 void ResourceMap<ResourceType, IDType>::assign(IDType id, ResourceType *resource)
 {
-    GLuint handle = GetIDValue(id);
-    if (handle < kFlatResourcesLimit)
+    GLuint handle    = GetIDValue(id);
+    size_t pageIndex = handle >> kPageBits;
+    Page *page       = getPage(handle);
+    if (page == nullptr && handle < kPagedResourcesLimit && followsDensePage(pageIndex))
     {
-        if (handle >= mFlatResourcesSize)
+        page = allocatePage(pageIndex);
+    }
+
+    if (page != nullptr)
+    {
+        auto &value = page->resources[handle & kPageMask];
+        if (value == InvalidPointer())
         {
-            // Use power-of-two.
-            size_t newSize = mFlatResourcesSize;
-            while (newSize <= handle)
-            {
-                newSize *= 2;
-            }
+            page->count++;
+        }
+        value = resource;
+        return;
+    }
+
+    auto it = mHashedResources.find(handle);
+    if (it != mHashedResources.end())
+    {
+        it->second = resource;
+        return;
+    }
+    mHashedResources.emplace(handle, resource);
+
+    // Move the handles to a page once it's cheaper than hashing them.
+    if (handle < kPagedResourcesLimit && ++mSparsePageCounts[pageIndex] >= kSparsePageThreshold)
+    {
+        allocatePage(pageIndex);
+    }
+}
+
+template <typename ResourceType, typename IDType>
+ANGLE_INLINE typename ResourceMap<ResourceType, IDType>::Page *
+ResourceMap<ResourceType, IDType>::getPage(GLuint handle) const
+{
+    size_t pageIndex = handle >> kPageBits;
+    return (pageIndex < mPageCount ? mPages[pageIndex] : nullptr);
+}
+
+template <typename ResourceType, typename IDType>
+bool ResourceMap<ResourceType, IDType>::followsDensePage(size_t pageIndex) const
+{
+    if (pageIndex == 0)
+    {
+        return true;
+    }
+    const Page *previousPage = (pageIndex - 1 < mPageCount ? mPages[pageIndex - 1] : nullptr);
+    return (previousPage != nullptr && previousPage->count >= kPageSize / 2);
+}
+
+template <typename ResourceType, typename IDType>
+typename ResourceMap<ResourceType, IDType>::Page *ResourceMap<ResourceType, IDType>::allocatePage(
+    size_t pageIndex)
+{
+    ASSERT(pageIndex < kMaxPageCount);
+    if (pageIndex >= mPageCount)
+    {
+        // Use power-of-two.
+        size_t newCount = mPageCount;
+        while (newCount <= pageIndex)
+        {
+            newCount *= 2;
+        }
+
+        Page **oldPages = mPages;
 
-            ResourceType **oldResources = mFlatResources;
+        mPages = new Page *[newCount]();
+        memcpy(mPages, oldPages, mPageCount * sizeof(Page *));
+        mPageCount = newCount;
+        delete[] oldPages;
+    }
 
-            mFlatResources = new ResourceType *[newSize];
-            memset(&mFlatResources[mFlatResourcesSize], kInvalidPointer,
-                   (newSize - mFlatResourcesSize) * kElementSize);
-            memcpy(mFlatResources, oldResources, mFlatResourcesSize * kElementSize);
-            mFlatResourcesSize = newSize;
-            delete[] oldResources;
+    Page *page = new Page;
+    memset(page->resources, kInvalidPointer, kPageSize * kElementSize);
+    page->count       = 0;
+    mPages[pageIndex] = page;
+
+    // Move the sparse handles of this page out of the hash map.
+    auto countIt = mSparsePageCounts.find(pageIndex);
+    if (countIt != mSparsePageCounts.end())
+    {
+        GLuint firstHandle = static_cast<GLuint>(pageIndex << kPageBits);
+        for (GLuint handle = firstHandle; handle < firstHandle + kPageSize; ++handle)
+        {
+            auto it = mHashedResources.find(handle);
+            if (it != mHashedResources.end())
+            {
+                page->resources[handle & kPageMask] = it->second;
+                page->count++;
+                mHashedResources.erase(it);
+            }
         }
-        ASSERT(mFlatResourcesSize > handle);
-        mFlatResources[handle] = resource;
+        ASSERT(page->count == countIt->second);
+        mSparsePageCounts.erase(countIt);
     }
-    else
+
+    return page;
+}
+
+template <typename ResourceType, typename IDType>
+void ResourceMap<ResourceType, IDType>::freePage(size_t pageIndex)
+{
+    ASSERT(mPages[pageIndex] != nullptr && mPages[pageIndex]->count == 0);
+    delete mPages[pageIndex];
+    mPages[pageIndex] = nullptr;
+}
+
+template <typename ResourceType, typename IDType>
+void ResourceMap<ResourceType, IDType>::deletePages()
+{
+    for (size_t pageIndex = 0; pageIndex < mPageCount; ++pageIndex)
     {
-        mHashedResources[handle] = resource;
+        delete mPages[pageIndex];
     }
 }
 
+template <typename ResourceType, typename IDType>
+ANGLE_INLINE GLuint ResourceMap<ResourceType, IDType>::pagedResourcesEnd() const
+{
+    return static_cast<GLuint>(mPageCount << kPageBits);
+}
+
 template <typename ResourceType, typename IDType>
 typename ResourceMap<ResourceType, IDType>::Iterator ResourceMap<ResourceType, IDType>::begin()
     const
 {
-    return Iterator(*this, nextResource(0, true), mHashedResources.begin(), true);
+    Iterator iter(*this, nextResource(0, true), mHashedResources.begin(), true);
+    iter.skipHashedNulls();
+    iter.updateValue();
+    return iter;
 }
 
 template <typename ResourceType, typename IDType>
 typename ResourceMap<ResourceType, IDType>::Iterator ResourceMap<ResourceType, IDType>::end() const
 {
-    return Iterator(*this, static_cast<GLuint>(mFlatResourcesSize), mHashedResources.end(), true);
+    return Iterator(*this, pagedResourcesEnd(), mHashedResources.end(), true);
 }
 
 template <typename ResourceType, typename IDType>
@@ -219,23 +371,24 @@ template <typename ResourceType, typename IDType>
 typename ResourceMap<ResourceType, IDType>::Iterator
 ResourceMap<ResourceType, IDType>::endWithNull() const
 {
-    return Iterator(*this, static_cast<GLuint>(mFlatResourcesSize), mHashedResources.end(), false);
+    return Iterator(*this, pagedResourcesEnd(), mHashedResources.end(), false);
 }
 
 template <typename ResourceType, typename IDType>
 typename ResourceMap<ResourceType, IDType>::Iterator ResourceMap<ResourceType, IDType>::find(
-    IDType handle) const
+    IDType id) const
 {
-    if (handle < mFlatResourcesSize)
+    if (!contains(id))
     {
-        return (mFlatResources[handle] != InvalidPointer()
-                    ? Iterator(handle, mHashedResources.begin())
-                    : end());
+        return end();
     }
-    else
+
+    GLuint handle = GetIDValue(id);
+    if (getPage(handle) != nullptr)
     {
-        return mHashedResources.find(handle);
+        return Iterator(*this, handle, mHashedResources.begin(), true);
     }
+    return Iterator(*this, pagedResourcesEnd(), mHashedResources.find(handle), true);
 }
 
 template <typename ResourceType, typename IDType>
@@ -244,26 +397,54 @@ bool ResourceMap<ResourceType, IDType>::empty() const
     return (begin() == end());
 }
 
+template <typename ResourceType, typename IDType>
+size_t ResourceMap<ResourceType, IDType>::getAllocatedPageCountForTesting() const
+{
+    size_t allocatedPageCount = 0;
+    for (size_t pageIndex = 0; pageIndex < mPageCount; ++pageIndex)
+    {
+        allocatedPageCount += (mPages[pageIndex] != nullptr ? 1 : 0);
+    }
+    return allocatedPageCount;
+}
+
 template <typename ResourceType, typename IDType>
 void ResourceMap<ResourceType, IDType>::clear()
 {
-    memset(mFlatResources, kInvalidPointer, kInitialFlatResourcesSize * kElementSize);
-    mFlatResourcesSize = kInitialFlatResourcesSize;
+    deletePages();
+    if (mPageCount != kInitialPageCount)
+    {
+        delete[] mPages;
+        mPages     = new Page *[kInitialPageCount];
+        mPageCount = kInitialPageCount;
+    }
+    memset(mPages, 0, mPageCount * sizeof(Page *));
     mHashedResources.clear();
+    mSparsePageCounts.clear();
 }
 
 template <typename ResourceType, typename IDType>
-GLuint ResourceMap<ResourceType, IDType>::nextResource(size_t flatIndex, bool skipNulls) const
+GLuint ResourceMap<ResourceType, IDType>::nextResource(size_t pagedIndex, bool skipNulls) const
 {
-    for (size_t index = flatIndex; index < mFlatResourcesSize; index++)
+    size_t index = pagedIndex;
+    while (index < (mPageCount << kPageBits))
     {
-        if ((mFlatResources[index] != nullptr || !skipNulls) &&
-            mFlatResources[index] != InvalidPointer())
+        const Page *page = mPages[index >> kPageBits];
+        if (page == nullptr || page->count == 0)
+        {
+            // Skip to the next page.
+            index = (index | kPageMask) + 1;
+            continue;
+        }
+
+        ResourceType *value = page->resources[index & kPageMask];
+        if ((value != nullptr || !skipNulls) && value != InvalidPointer())
         {
             return static_cast<GLuint>(index);
         }
+        index++;
     }
-    return static_cast<GLuint>(mFlatResourcesSize);
+    return pagedResourcesEnd();
 }
 
 template <typename ResourceType, typename IDType>
@@ -276,10 +457,10 @@ ResourceType *ResourceMap<ResourceType, IDType>::InvalidPointer()
 template <typename ResourceType, typename IDType>
 ResourceMap<ResourceType, IDType>::Iterator::Iterator(
     const ResourceMap &origin,
-    GLuint flatIndex,
+    GLuint pagedIndex,
     typename ResourceMap<ResourceType, IDType>::HashMap::const_iterator hashIndex,
     bool skipNulls)
-    : mOrigin(origin), mFlatIndex(flatIndex), mHashIndex(hashIndex), mSkipNulls(skipNulls)
+    : mOrigin(origin), mPagedIndex(pagedIndex), mHashIndex(hashIndex), mSkipNulls(skipNulls)
 {
     updateValue();
 }
@@ -287,7 +468,7 @@ ResourceMap<ResourceType, IDType>::Iterator::Iterator(
 template <typename ResourceType, typename IDType>
 bool ResourceMap<ResourceType, IDType>::Iterator::operator==(const Iterator &other) const
 {
-    return (mFlatIndex == other.mFlatIndex && mHashIndex == other.mHashIndex);
+    return (mPagedIndex == other.mPagedIndex && mHashIndex == other.mHashIndex);
 }
 
 template <typename ResourceType, typename IDType>
@@ -300,18 +481,33 @@ template <typename ResourceType, typename IDType>
 typename ResourceMap<ResourceType, IDType>::Iterator &
 ResourceMap<ResourceType, IDType>::Iterator::operator++()
 {
-    if (mFlatIndex < static_cast<GLuint>(mOrigin.mFlatResourcesSize))
+    if (mPagedIndex < mOrigin.pagedResourcesEnd())
     {
-        mFlatIndex = mOrigin.nextResource(mFlatIndex + 1, mSkipNulls);
+        mPagedIndex = mOrigin.nextResource(mPagedIndex + 1, mSkipNulls);
     }
     else
     {
         mHashIndex++;
     }
+    skipHashedNulls();
     updateValue();
     return *this;
 }
 
+template <typename ResourceType, typename IDType>
+void ResourceMap<ResourceType, IDType>::Iterator::skipHashedNulls()
+{
+    // Reserved sparse handles are hashed too.
+    if (!mSkipNulls || mPagedIndex < mOrigin.pagedResourcesEnd())
+    {
+        return;
+    }
+    while (mHashIndex != mOrigin.mHashedResources.end() && mHashIndex->second == nullptr)
+    {
+        mHashIndex++;
+    }
+}
+
 template <typename ResourceType, typename IDType>
 const typename ResourceMap<ResourceType, IDType>::IndexAndResource *
 ResourceMap<ResourceType, IDType>::Iterator::operator->() const
@@ -329,10 +525,11 @@ ResourceMap<ResourceType, IDType>::Iterator::operator*() const
 template <typename ResourceType, typename IDType>
 void ResourceMap<ResourceType, IDType>::Iterator::updateValue()
 {
-    if (mFlatIndex < static_cast<GLuint>(mOrigin.mFlatResourcesSize))
+    if (mPagedIndex < mOrigin.pagedResourcesEnd())
     {
-        mValue.first  = mFlatIndex;
-        mValue.second = mOrigin.mFlatResources[mFlatIndex];
+        const Page *page = mOrigin.mPages[mPagedIndex >> kPageBits];
+        mValue.first     = mPagedIndex;
+        mValue.second    = page->resources[mPagedIndex & kPageMask];
     }
     else if (mHashIndex != mOrigin.mHashedResources.end())
     {
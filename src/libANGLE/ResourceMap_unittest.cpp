@@ -9,6 +9,8 @@
 
 #include <gtest/gtest.h>
 
+#include <map>
+
 #include "libANGLE/ResourceMap.h"
 
 using namespace gl;
@@ -133,4 +135,144 @@ TEST(ResourceMapTest, QueryUnassigned)
     ASSERT_FALSE(resourceMap.contains(100));
     ASSERT_EQ(nullptr, resourceMap.query(100));
 }
+
+// Tests handles past the first page table size, sparse handles and handles that are hashed.
+TEST(ResourceMapTest, LargeAndSparseHandles)
+{
+    const GLuint kHandles[] = {1, 0x4000, 0x4002, 0x12345, 0xFFFFFE, 0x1000000, 0xFFFFFFFE};
+
+    ResourceMap<size_t, GLuint> resourceMap;
+    std::vector<size_t> objects(ArraySize(kHandles));
+
+    for (size_t index = 0; index < ArraySize(kHandles); ++index)
+    {
+        resourceMap.assign(kHandles[index], &objects[index]);
+    }
+
+    for (size_t index = 0; index < ArraySize(kHandles); ++index)
+    {
+        ASSERT_TRUE(resourceMap.contains(kHandles[index]));
+        ASSERT_EQ(&objects[index], resourceMap.query(kHandles[index]));
+        ASSERT_FALSE(resourceMap.contains(kHandles[index] + 1));
+        ASSERT_EQ(nullptr, resourceMap.query(kHandles[index] + 1));
+    }
+
+    // Handles in pages that were never allocated.
+    ASSERT_FALSE(resourceMap.contains(0x100000));
+    ASSERT_EQ(nullptr, resourceMap.query(0x100000));
+
+    for (size_t index = 0; index < ArraySize(kHandles); ++index)
+    {
+        size_t *found = nullptr;
+        ASSERT_TRUE(resourceMap.erase(kHandles[index], &found));
+        ASSERT_EQ(&objects[index], found);
+        ASSERT_FALSE(resourceMap.erase(kHandles[index], &found));
+    }
+
+    ASSERT_TRUE(resourceMap.empty());
+}
+
+// Tests that sparse handles don't allocate pages until enough of them share a page, that handles
+// growing from the first page are paged, and that pages are freed when they become empty.
+TEST(ResourceMapTest, SparseHandlePages)
+{
+    constexpr GLuint kPageSize = 256;
+    constexpr GLuint kCount    = 16;
+
+    ResourceMap<size_t, GLuint> resourceMap;
+    std::vector<size_t> objects(kPageSize * 2);
+
+    // Sparse handles are hashed.
+    for (GLuint index = 0; index < kCount - 1; ++index)
+    {
+        resourceMap.assign(0x10000 + index * kPageSize, &objects[index]);
+    }
+    resourceMap.assign(0x20000, &objects[kCount]);
+    resourceMap.assign(0xFFFFFE, &objects[kCount + 1]);
+    EXPECT_EQ(0u, resourceMap.getAllocatedPageCountForTesting());
+
+    // Handles in the same page are moved to a page once there are enough of them.
+    for (GLuint index = 1; index < kCount; ++index)
+    {
+        resourceMap.assign(0x20000 + index, &objects[kCount + 1 + index]);
+    }
+    EXPECT_EQ(1u, resourceMap.getAllocatedPageCountForTesting());
+    for (GLuint index = 1; index < kCount; ++index)
+    {
+        EXPECT_EQ(&objects[kCount + 1 + index], resourceMap.query(0x20000 + index));
+    }
+    EXPECT_EQ(&objects[kCount], resourceMap.query(0x20000));
+    EXPECT_EQ(&objects[0], resourceMap.query(0x10000));
+    EXPECT_EQ(&objects[kCount + 1], resourceMap.query(0xFFFFFE));
+
+    // Handles from the allocator grow into the next page directly.
+    for (GLuint handle = 1; handle < kPageSize + 1; ++handle)
+    {
+        resourceMap.assign(handle, nullptr);
+    }
+    EXPECT_EQ(3u, resourceMap.getAllocatedPageCountForTesting());
+
+    // Emptying a page frees it.
+    size_t *found = nullptr;
+    for (GLuint index = 0; index < kCount; ++index)
+    {
+        ASSERT_TRUE(resourceMap.erase(0x20000 + index, &found));
+    }
+    ASSERT_TRUE(resourceMap.erase(kPageSize, &found));
+    EXPECT_EQ(1u, resourceMap.getAllocatedPageCountForTesting());
+    EXPECT_FALSE(resourceMap.contains(0x20000));
+
+    for (GLuint handle = 1; handle < kPageSize; ++handle)
+    {
+        ASSERT_TRUE(resourceMap.erase(handle, &found));
+    }
+    for (GLuint index = 0; index < kCount - 1; ++index)
+    {
+        ASSERT_TRUE(resourceMap.erase(0x10000 + index * kPageSize, &found));
+        EXPECT_EQ(&objects[index], found);
+    }
+    ASSERT_TRUE(resourceMap.erase(0xFFFFFE, &found));
+    ASSERT_TRUE(resourceMap.empty());
+}
+
+// Tests that iteration visits every assigned handle once, with or without the reserved ones.
+TEST(ResourceMapTest, Iteration)
+{
+    ResourceMap<size_t, GLuint> resourceMap;
+    std::vector<size_t> objects(4);
+
+    std::map<GLuint, size_t *> expected = {
+        {3, &objects[0]}, {700, &objects[1]}, {0x30000, &objects[2]}, {0x80000000, &objects[3]}};
+    for (const auto &handleAndObject : expected)
+    {
+        resourceMap.assign(handleAndObject.first, handleAndObject.second);
+    }
+
+    // Reserved handles, and a page that becomes empty.
+    resourceMap.assign(5, nullptr);
+    resourceMap.assign(0x50000, nullptr);
+    resourceMap.assign(0x20000, &objects[0]);
+    size_t *found = nullptr;
+    ASSERT_TRUE(resourceMap.erase(0x20000, &found));
+
+    std::map<GLuint, size_t *> visited;
+    for (const auto &handleAndObject : resourceMap)
+    {
+        EXPECT_TRUE(visited.emplace(handleAndObject.first, handleAndObject.second).second);
+    }
+    EXPECT_EQ(expected, visited);
+
+    std::map<GLuint, size_t *> visitedWithNull;
+    for (auto iter = resourceMap.beginWithNull(); iter != resourceMap.endWithNull(); ++iter)
+    {
+        EXPECT_TRUE(visitedWithNull.emplace(iter->first, iter->second).second);
+    }
+    expected[5]       = nullptr;
+    expected[0x50000] = nullptr;
+    EXPECT_EQ(expected, visitedWithNull);
+
+    resourceMap.clear();
+    ASSERT_TRUE(resourceMap.empty());
+    ASSERT_EQ(nullptr, resourceMap.query(3));
+}
 }  // anonymous namespace
@@ -9,6 +9,236 @@
 namespace rx
 {
 
+#if defined(ANGLE_USE_SSE)
+namespace priv
+{
+
+// Loads the components of a vertex in the low lanes of a vector, widened to 32 bits.  The other
+// lanes are zero.
+template <typename T, size_t componentCount>
+inline __m128i LoadVertexComponentsSSE2(const uint8_t *input)
+{
+    static_assert(sizeof(T) <= 2, "Only 8 and 16-bit components are supported.");
+
+    uint64_t data = 0;
+    memcpy(&data, input, sizeof(T) * componentCount);
+    __m128i components = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(&data));
+
+    if (sizeof(T) == 1)
+    {
+        components = std::numeric_limits<T>::is_signed
+                         ? _mm_srai_epi16(_mm_unpacklo_epi8(components, components), 8)
+                         : _mm_unpacklo_epi8(components, _mm_setzero_si128());
+    }
+
+    return std::numeric_limits<T>::is_signed
+               ? _mm_srai_epi32(_mm_unpacklo_epi16(components, components), 16)
+               : _mm_unpacklo_epi16(components, _mm_setzero_si128());
+}
+
+// Stores the low |componentCount| lanes of a vector.
+template <size_t componentCount>
+inline void StoreVertexComponentsSSE2(__m128 components, float *output)
+{
+    switch (componentCount)
+    {
+        case 1:
+            _mm_store_ss(output, components);
+            break;
+        case 2:
+            _mm_storel_pi(reinterpret_cast<__m64 *>(output), components);
+            break;
+        case 3:
+            _mm_storel_pi(reinterpret_cast<__m64 *>(output), components);
+            _mm_store_ss(output + 2, _mm_movehl_ps(components, components));
+            break;
+        default:
+            _mm_storeu_ps(output, components);
+            break;
+    }
+}
+
+// Converts widened components to floats the way CopyTo32FVertexData does.
+template <typename T, bool normalized>
+inline __m128 ConvertVertexComponentsSSE2(__m128i components)
+{
+    typedef std::numeric_limits<T> NL;
+
+    __m128 values = _mm_cvtepi32_ps(components);
+    if (normalized)
+    {
+        values = _mm_div_ps(values, _mm_set1_ps(static_cast<float>(NL::max())));
+        if (NL::is_signed)
+        {
+            values = _mm_max_ps(values, _mm_set1_ps(-1.0f));
+        }
+    }
+    return values;
+}
+
+// Converts 8 and 16-bit components to floats one vertex at a time, with the same operations as
+// CopyTo32FVertexData so that the results are identical.  Returns false if the conversion is left
+// to the caller, as for 32-bit components which have no unsigned conversion in SSE2.
+template <typename T, size_t inputComponentCount, size_t outputComponentCount, bool normalized>
+inline typename std::enable_if<(sizeof(T) <= 2), bool>::type
+CopyTo32FVertexDataSSE2(const uint8_t *input, size_t stride, size_t count, uint8_t *output)
+{
+    if (!gl::supportsSSE2())
+    {
+        return false;
+    }
+
+    size_t i = 0;
+
+    // Four components can be loaded and stored at once for all vertices but the last, as long as
+    // the extra ones read are within the next vertex and the extra ones written are overwritten
+    // when the next vertex is converted.
+    if (outputComponentCount >= 2 && stride >= (4 - inputComponentCount) * sizeof(T))
+    {
+        const __m128i inputComponentMask =
+            _mm_set_epi32(inputComponentCount > 3 ? -1 : 0, inputComponentCount > 2 ? -1 : 0,
+                          inputComponentCount > 1 ? -1 : 0, -1);
+
+        for (; i + 1 < count; i++)
+        {
+            float *offsetOutput = reinterpret_cast<float *>(output) + i * outputComponentCount;
+
+            __m128i components = LoadVertexComponentsSSE2<T, 4>(input + (stride * i));
+            if (inputComponentCount < outputComponentCount)
+            {
+                // The other output components are set to 0.
+                components = _mm_and_si128(components, inputComponentMask);
+            }
+
+            _mm_storeu_ps(offsetOutput, ConvertVertexComponentsSSE2<T, normalized>(components));
+        }
+    }
+
+    for (; i < count; i++)
+    {
+        float *offsetOutput = reinterpret_cast<float *>(output) + i * outputComponentCount;
+
+        // The lanes past the input components are zero, which is what the other output components
+        // are set to.
+        __m128i components = LoadVertexComponentsSSE2<T, inputComponentCount>(input + (stride * i));
+        StoreVertexComponentsSSE2<outputComponentCount>(
+            ConvertVertexComponentsSSE2<T, normalized>(components), offsetOutput);
+    }
+
+    return true;
+}
+
+template <typename T, size_t inputComponentCount, size_t outputComponentCount, bool normalized>
+inline typename std::enable_if<(sizeof(T) > 2), bool>::type
+CopyTo32FVertexDataSSE2(const uint8_t *input, size_t stride, size_t count, uint8_t *output)
+{
+    return false;
+}
+
+// Loads a packed 32-bit value in the first lane of a vector.
+inline __m128i LoadPackedSSE2(const uint8_t *input)
+{
+    int32_t packedValue;
+    memcpy(&packedValue, input, sizeof(packedValue));
+    return _mm_cvtsi32_si128(packedValue);
+}
+
+// Converts a 10-bit component of four packed values the way CopyPackedRGB does.
+template <bool isSigned, bool normalized, size_t shift>
+inline __m128 UnpackRGB10SSE2(__m128i packed)
+{
+    __m128i component =
+        isSigned ? _mm_srai_epi32(_mm_slli_epi32(packed, 22 - shift), 22)
+                 : _mm_and_si128(_mm_srli_epi32(packed, shift), _mm_set1_epi32(0x3FF));
+    __m128 value = _mm_cvtepi32_ps(component);
+
+    if (normalized && isSigned)
+    {
+        // Same operations as CopyPackedRGB, so the results are identical.
+        const __m128 minValue  = _mm_set1_ps(-511.0f);
+        const __m128 halfRange = _mm_set1_ps(511.0f);
+        value                  = _mm_max_ps(value, minValue);
+        value = _mm_sub_ps(_mm_div_ps(_mm_sub_ps(value, minValue), halfRange), _mm_set1_ps(1.0f));
+    }
+    else if (normalized)
+    {
+        value = _mm_div_ps(value, _mm_set1_ps(1023.0f));
+    }
+
+    return value;
+}
+
+// Converts the 2-bit component of four packed values the way CopyPackedAlpha does.
+template <bool isSigned, bool normalized, size_t shift>
+inline __m128 UnpackA2SSE2(__m128i packed)
+{
+    __m128i component =
+        isSigned ? _mm_srai_epi32(_mm_slli_epi32(packed, 30 - shift), 30)
+                 : _mm_and_si128(_mm_srli_epi32(packed, shift), _mm_set1_epi32(0x3));
+    __m128 value = _mm_cvtepi32_ps(component);
+
+    if (normalized && isSigned)
+    {
+        value = _mm_max_ps(value, _mm_set1_ps(-1.0f));
+    }
+    else if (normalized)
+    {
+        value = _mm_div_ps(value, _mm_set1_ps(3.0f));
+    }
+
+    return value;
+}
+
+// Converts packed 10_10_10_2 values to four floats, four vertices at a time.  Returns the number of
+// vertices converted, which leaves fewer than four for the caller to convert.
+template <bool isSigned,
+          bool normalized,
+          size_t redShift,
+          size_t greenShift,
+          size_t blueShift,
+          bool hasAlpha,
+          size_t alphaShift>
+inline size_t CopyPackedToXYZW32FSSE2(const uint8_t *input,
+                                      size_t stride,
+                                      size_t count,
+                                      uint8_t *output)
+{
+    if (!gl::supportsSSE2())
+    {
+        return 0;
+    }
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // Gather the values in registers; going through memory would stall on store forwarding.
+        const uint8_t *offsetInput = input + (i * stride);
+        __m128i packed             = _mm_unpacklo_epi64(
+            _mm_unpacklo_epi32(LoadPackedSSE2(offsetInput), LoadPackedSSE2(offsetInput + stride)),
+            _mm_unpacklo_epi32(LoadPackedSSE2(offsetInput + 2 * stride),
+                               LoadPackedSSE2(offsetInput + 3 * stride)));
+
+        __m128 red   = UnpackRGB10SSE2<isSigned, normalized, redShift>(packed);
+        __m128 green = UnpackRGB10SSE2<isSigned, normalized, greenShift>(packed);
+        __m128 blue  = UnpackRGB10SSE2<isSigned, normalized, blueShift>(packed);
+        // The alpha of formats without one is 1 whatever the signedness and normalization.
+        __m128 alpha = hasAlpha ? UnpackA2SSE2<isSigned, normalized, alphaShift>(packed)
+                                : _mm_set1_ps(1.0f);
+        _MM_TRANSPOSE4_PS(red, green, blue, alpha);
+
+        float *offsetOutput = reinterpret_cast<float *>(output) + i * 4;
+        _mm_storeu_ps(offsetOutput + 0, red);
+        _mm_storeu_ps(offsetOutput + 4, green);
+        _mm_storeu_ps(offsetOutput + 8, blue);
+        _mm_storeu_ps(offsetOutput + 12, alpha);
+    }
+
+    return i;
+}
+
+}  // namespace priv
+#endif  // defined(ANGLE_USE_SSE)
+
 template <typename T,
           size_t inputComponentCount,
           size_t outputComponentCount,
@@ -182,6 +412,14 @@ inline void CopyTo32FVertexData(const uint8_t *input, size_t stride, size_t coun
 {
     typedef std::numeric_limits<T> NL;
 
+#if defined(ANGLE_USE_SSE)
+    if (priv::CopyTo32FVertexDataSSE2<T, inputComponentCount, outputComponentCount, normalized>(
+            input, stride, count, output))
+    {
+        return;
+    }
+#endif  // defined(ANGLE_USE_SSE)
+
     for (size_t i = 0; i < count; i++)
     {
         const T *offsetInput = reinterpret_cast<const T *>(input + (stride * i));
@@ -511,7 +749,17 @@ inline void CopyXYZ10W2ToXYZW32FVertexData(const uint8_t *input,
     const uint32_t alphaMask = 0x3;  // 1 set in bits 0 and 1
     const size_t alphaShift  = 30;   // Alpha is the 30 and 31 bits
 
-    for (size_t i = 0; i < count; i++)
+    size_t i = 0;
+
+#if defined(ANGLE_USE_SSE)
+    if (toFloat)
+    {
+        i = priv::CopyPackedToXYZW32FSSE2<isSigned, normalized, redShift, greenShift, blueShift,
+                                          true, alphaShift>(input, stride, count, output);
+    }
+#endif  // defined(ANGLE_USE_SSE)
+
+    for (; i < count; i++)
     {
         GLuint packedValue    = *reinterpret_cast<const GLuint *>(input + (i * stride));
         uint8_t *offsetOutput = output + (i * outputComponentSize * componentCount);
@@ -543,7 +791,14 @@ inline void CopyXYZ10ToXYZW32FVertexData(const uint8_t *input,
 
     const uint32_t alphaDefaultValueBits = normalized ? (isSigned ? 0x1 : 0x3) : 0x1;
 
-    for (size_t i = 0; i < count; i++)
+    size_t i = 0;
+
+#if defined(ANGLE_USE_SSE)
+    i = priv::CopyPackedToXYZW32FSSE2<isSigned, normalized, redShift, greenShift, blueShift, false,
+                                      0>(input, stride, count, output);
+#endif  // defined(ANGLE_USE_SSE)
+
+    for (; i < count; i++)
     {
         GLuint packedValue    = *reinterpret_cast<const GLuint *>(input + (i * stride));
         uint8_t *offsetOutput = output + (i * outputComponentSize * componentCount);
@@ -576,7 +831,14 @@ inline void CopyW2XYZ10ToXYZW32FVertexData(const uint8_t *input,
     const uint32_t alphaMask = 0x3;  // 1 set in bits 0 and 1
     const size_t alphaShift  = 0;    // Alpha is the 30 and 31 bits
 
-    for (size_t i = 0; i < count; i++)
+    size_t i = 0;
+
+#if defined(ANGLE_USE_SSE)
+    i = priv::CopyPackedToXYZW32FSSE2<isSigned, normalized, redShift, greenShift, blueShift, true,
+                                      alphaShift>(input, stride, count, output);
+#endif  // defined(ANGLE_USE_SSE)
+
+    for (; i < count; i++)
     {
         GLuint packedValue    = *reinterpret_cast<const GLuint *>(input + (i * stride));
         uint8_t *offsetOutput = output + (i * outputComponentSize * componentCount);
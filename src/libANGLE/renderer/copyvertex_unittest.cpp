@@ -0,0 +1,241 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// copyvertex_unittest:
+//   Unit tests for the vertex conversion functions.  The conversions may be vectorized, and must
+//   give the same results as the scalar conversion, bit for bit.
+//
+
+#include <gtest/gtest.h>
+
+#include "angle_gl.h"
+#include "libANGLE/renderer/copyvertex.h"
+
+namespace rx
+{
+namespace
+{
+// Builds |count| vertices of |componentCount| components, |stride| bytes apart and unaligned.  The
+// components take consecutive values, so they cover all the values of 8 and 16-bit components,
+// while 32-bit components are spread over their whole range.  The buffer ends exactly at the end
+// of the last vertex, so that reads past it are caught by AddressSanitizer.
+std::vector<uint8_t> MakeVertices(size_t count,
+                                  size_t componentSize,
+                                  size_t componentCount,
+                                  size_t stride)
+{
+    std::vector<uint8_t> vertices(1 + (count - 1) * stride + componentCount * componentSize, 0xCD);
+    for (size_t i = 0; i < count; i++)
+    {
+        for (size_t j = 0; j < componentCount; j++)
+        {
+            uint32_t value = static_cast<uint32_t>(i + j * 1000);
+            if (componentSize == 4)
+            {
+                value *= 0x9E3779B1u;
+            }
+            memcpy(&vertices[1 + i * stride + j * componentSize], &value, componentSize);
+        }
+    }
+    return vertices;
+}
+
+template <typename T, size_t inputComponentCount, size_t outputComponentCount, bool normalized>
+void CheckCopyTo32F(size_t count, size_t stride)
+{
+    typedef std::numeric_limits<T> NL;
+
+    const std::vector<uint8_t> vertices =
+        MakeVertices(count, sizeof(T), inputComponentCount, stride);
+
+    std::vector<float> output(count * outputComponentCount + 1, -2.0f);
+    CopyTo32FVertexData<T, inputComponentCount, outputComponentCount, normalized>(
+        vertices.data() + 1, stride, count, reinterpret_cast<uint8_t *>(output.data()));
+
+    for (size_t i = 0; i < count; i++)
+    {
+        for (size_t j = 0; j < outputComponentCount; j++)
+        {
+            float expected = 0.0f;
+            if (j < inputComponentCount)
+            {
+                T value;
+                memcpy(&value, &vertices[1 + i * stride + j * sizeof(T)], sizeof(T));
+                expected = static_cast<float>(value);
+                if (normalized)
+                {
+                    expected = std::max(expected / NL::max(), -1.0f);
+                }
+            }
+
+            const float actual = output[i * outputComponentCount + j];
+            ASSERT_EQ(gl::bitCast<uint32_t>(expected), gl::bitCast<uint32_t>(actual))
+                << "vertex " << i << " component " << j;
+        }
+    }
+
+    // Nothing is written past the output.
+    EXPECT_EQ(-2.0f, output.back());
+}
+
+template <typename T, size_t inputComponentCount, size_t outputComponentCount, bool normalized>
+void CheckCopyTo32FAllStrides()
+{
+    // Enough vertices for each 16-bit component to take all values, with tight and loose strides,
+    // and a few counts that don't fill the vectors.
+    const size_t attribSize = sizeof(T) * inputComponentCount;
+    for (size_t stride : {attribSize, attribSize + 1, attribSize * 2, size_t(16)})
+    {
+        for (size_t count : {1, 2, 3, 5, 65537})
+        {
+            CheckCopyTo32F<T, inputComponentCount, outputComponentCount, normalized>(count,
+                                                                                      stride);
+        }
+    }
+}
+
+// Returns the float a 10-bit component of a packed 10_10_10_2 value converts to.
+float UnpackRGB10(uint32_t packed, size_t shift, bool isSigned, bool normalized)
+{
+    if (isSigned)
+    {
+        float value = static_cast<float>(static_cast<int32_t>(packed << (22 - shift)) >> 22);
+        return normalized ? (std::max(value, -511.0f) + 511.0f) / 511.0f - 1.0f : value;
+    }
+
+    float value = static_cast<float>((packed >> shift) & 0x3FF);
+    return normalized ? value / 1023.0f : value;
+}
+
+// Returns the float the 2-bit component of a packed 10_10_10_2 value converts to.
+float UnpackA2(uint32_t packed, size_t shift, bool isSigned, bool normalized)
+{
+    if (isSigned)
+    {
+        float value = static_cast<float>(static_cast<int32_t>(packed << (30 - shift)) >> 30);
+        return normalized ? std::max(value, -1.0f) : value;
+    }
+
+    float value = static_cast<float>((packed >> shift) & 0x3);
+    return normalized ? value / 3.0f : value;
+}
+
+// Checks a conversion of packed 10_10_10_2 values to four floats.  |alphaShift| is negative for
+// formats without alpha.
+void CheckCopyPackedTo32F(VertexCopyFunction copyFunction,
+                          bool isSigned,
+                          bool normalized,
+                          size_t redShift,
+                          size_t greenShift,
+                          size_t blueShift,
+                          int alphaShift)
+{
+    for (size_t stride : {size_t(4), size_t(5), size_t(12)})
+    {
+        for (size_t count : {1, 3, 4, 7, 4099})
+        {
+            const std::vector<uint8_t> vertices = MakeVertices(count, 4, 1, stride);
+
+            std::vector<float> output(count * 4 + 1, -2.0f);
+            copyFunction(vertices.data() + 1, stride, count,
+                         reinterpret_cast<uint8_t *>(output.data()));
+
+            for (size_t i = 0; i < count; i++)
+            {
+                uint32_t packed;
+                memcpy(&packed, &vertices[1 + i * stride], sizeof(packed));
+
+                const float expected[4] = {
+                    UnpackRGB10(packed, redShift, isSigned, normalized),
+                    UnpackRGB10(packed, greenShift, isSigned, normalized),
+                    UnpackRGB10(packed, blueShift, isSigned, normalized),
+                    alphaShift < 0 ? 1.0f : UnpackA2(packed, alphaShift, isSigned, normalized)};
+
+                for (size_t j = 0; j < 4; j++)
+                {
+                    ASSERT_EQ(gl::bitCast<uint32_t>(expected[j]),
+                              gl::bitCast<uint32_t>(output[i * 4 + j]))
+                        << "vertex " << i << " component " << j;
+                }
+            }
+
+            EXPECT_EQ(-2.0f, output.back());
+        }
+    }
+}
+
+// Tests converting 8-bit components to floats.
+TEST(CopyVertexTest, Copy8BitTo32F)
+{
+    CheckCopyTo32FAllStrides<GLbyte, 1, 1, true>();
+    CheckCopyTo32FAllStrides<GLbyte, 2, 2, true>();
+    CheckCopyTo32FAllStrides<GLbyte, 3, 3, true>();
+    CheckCopyTo32FAllStrides<GLbyte, 4, 4, true>();
+    CheckCopyTo32FAllStrides<GLbyte, 3, 3, false>();
+    CheckCopyTo32FAllStrides<GLubyte, 1, 1, true>();
+    CheckCopyTo32FAllStrides<GLubyte, 2, 2, false>();
+    CheckCopyTo32FAllStrides<GLubyte, 3, 3, true>();
+    CheckCopyTo32FAllStrides<GLubyte, 3, 3, false>();
+    CheckCopyTo32FAllStrides<GLubyte, 4, 4, true>();
+}
+
+// Tests converting 16-bit components to floats.
+TEST(CopyVertexTest, Copy16BitTo32F)
+{
+    CheckCopyTo32FAllStrides<GLshort, 1, 1, false>();
+    CheckCopyTo32FAllStrides<GLshort, 2, 2, true>();
+    CheckCopyTo32FAllStrides<GLshort, 3, 3, true>();
+    CheckCopyTo32FAllStrides<GLshort, 3, 3, false>();
+    CheckCopyTo32FAllStrides<GLshort, 4, 4, true>();
+    CheckCopyTo32FAllStrides<GLushort, 1, 1, true>();
+    CheckCopyTo32FAllStrides<GLushort, 2, 2, false>();
+    CheckCopyTo32FAllStrides<GLushort, 3, 3, true>();
+    CheckCopyTo32FAllStrides<GLushort, 4, 4, false>();
+
+    // Single components are widened to two on D3D11.
+    CheckCopyTo32FAllStrides<GLushort, 1, 2, true>();
+    CheckCopyTo32FAllStrides<GLushort, 1, 2, false>();
+    CheckCopyTo32FAllStrides<GLshort, 1, 2, true>();
+}
+
+// Tests converting 32-bit components to floats, which are not vectorized.
+TEST(CopyVertexTest, Copy32BitTo32F)
+{
+    CheckCopyTo32F<GLint, 3, 3, true>(1000, 12);
+    CheckCopyTo32F<GLuint, 2, 2, true>(1000, 9);
+}
+
+// Tests converting packed 10_10_10_2 values to floats.
+TEST(CopyVertexTest, CopyXYZ10W2To32F)
+{
+    CheckCopyPackedTo32F(CopyXYZ10W2ToXYZW32FVertexData<true, true, true>, true, true, 0, 10, 20,
+                         30);
+    CheckCopyPackedTo32F(CopyXYZ10W2ToXYZW32FVertexData<true, false, true>, true, false, 0, 10, 20,
+                         30);
+    CheckCopyPackedTo32F(CopyXYZ10W2ToXYZW32FVertexData<false, true, true>, false, true, 0, 10, 20,
+                         30);
+    CheckCopyPackedTo32F(CopyXYZ10W2ToXYZW32FVertexData<false, false, true>, false, false, 0, 10,
+                         20, 30);
+}
+
+// Tests converting packed 10_10_10_2 values stored the other way around to floats.
+TEST(CopyVertexTest, CopyW2XYZ10To32F)
+{
+    CheckCopyPackedTo32F(CopyW2XYZ10ToXYZW32FVertexData<true, true>, true, true, 22, 12, 2, 0);
+    CheckCopyPackedTo32F(CopyW2XYZ10ToXYZW32FVertexData<true, false>, true, false, 22, 12, 2, 0);
+    CheckCopyPackedTo32F(CopyW2XYZ10ToXYZW32FVertexData<false, true>, false, true, 22, 12, 2, 0);
+    CheckCopyPackedTo32F(CopyW2XYZ10ToXYZW32FVertexData<false, false>, false, false, 22, 12, 2, 0);
+}
+
+// Tests converting packed 10_10_10 values without alpha to floats.
+TEST(CopyVertexTest, CopyXYZ10To32F)
+{
+    CheckCopyPackedTo32F(CopyXYZ10ToXYZW32FVertexData<true, true>, true, true, 22, 12, 2, -1);
+    CheckCopyPackedTo32F(CopyXYZ10ToXYZW32FVertexData<true, false>, true, false, 22, 12, 2, -1);
+    CheckCopyPackedTo32F(CopyXYZ10ToXYZW32FVertexData<false, true>, false, true, 22, 12, 2, -1);
+    CheckCopyPackedTo32F(CopyXYZ10ToXYZW32FVertexData<false, false>, false, false, 22, 12, 2, -1);
+}
+}  // anonymous namespace
+}  // namespace rx
@@ -1457,10 +1457,16 @@ class SpirvTransformer final : public SpirvTransformerBase
     // duplicated with a similar instruction but which defines a type with the Private storage
     // class.  If inactive varyings are encountered, its type is changed to the Private one.  The
     // following vector maps the Output type id to the corresponding Private one.
+    //
+    // Similarly, if the default uniform block is delivered through push constants, each
+    // OpTypePointer instruction with the Uniform storage class is duplicated with the PushConstant
+    // storage class, and the default uniform block variable and the access chains into it are
+    // changed to use that.
     struct TransformedIDs
     {
         uint32_t privateID;
         uint32_t typeID;
+        uint32_t pushConstantID;
     };
     std::vector<TransformedIDs> mTypePointerTransformedId;
     std::vector<uint32_t> mFixedVaryingId;
@@ -1477,6 +1483,12 @@ class SpirvTransformer final : public SpirvTransformerBase
     };
     PerVertexData mOutputPerVertex;
     PerVertexData mInputPerVertex;
+
+    // The struct type of the default uniform block if it's delivered through push constants, and
+    // the offset of this stage's block in the push constant range.  The std140 member offsets of
+    // the block are shifted by this amount.
+    uint32_t mPushConstantBlockTypeId = 0;
+    uint32_t mPushConstantOffset      = 0;
 };
 
 bool SpirvTransformer::transform()
@@ -1516,7 +1528,7 @@ void SpirvTransformer::resolveVariableIds()
     // Allocate storage for Output type pointer map.  At index i, this vector holds the identical
     // type as %i except for its storage class turned to Private.
     // Also store a FunctionID and TypeID for when we need to fix a precision mismatch
-    mTypePointerTransformedId.resize(indexBound, {0, 0});
+    mTypePointerTransformedId.resize(indexBound, {0, 0, 0});
     mFixedVaryingId.resize(indexBound, {0});
     mFixedVaryingTypeId.resize(indexBound, {0});
 
@@ -1864,9 +1876,14 @@ void SpirvTransformer::visitTypePointer(const uint32_t *instruction)
 
     visitTypeHelper(instruction, kIdIndex, kTypeIdIndex);
 
+    const uint32_t id           = instruction[kIdIndex];
     const uint32_t typeId       = instruction[kTypeIdIndex];
     const uint32_t storageClass = instruction[kStorageClassIndex];
 
+    // Remember the pointee type, used to find the struct type of the default uniform block.
+    ASSERT(id < mTypePointerTransformedId.size());
+    mTypePointerTransformedId[id].typeID = typeId;
+
     // Verify that the ids associated with input and output gl_PerVertex are correct.
     if (typeId == mOutputPerVertex.typeId || typeId == mInputPerVertex.typeId)
     {
@@ -1943,6 +1960,17 @@ void SpirvTransformer::visitVariable(const uint32_t *instruction)
     // Associate the id of this name with its info.
     mVariableInfoById[id] = info;
 
+    // If this is the default uniform block and it's delivered through push constants, remember its
+    // type so its member offsets can be adjusted.
+    if (storageClass == spv::StorageClassUniform &&
+        info->pushConstantOffset != ShaderInterfaceVariableInfo::kInvalid)
+    {
+        ASSERT(mPushConstantBlockTypeId == 0);
+        mPushConstantBlockTypeId = mTypePointerTransformedId[typeId].typeID;
+        mPushConstantOffset      = info->pushConstantOffset;
+        ASSERT(mPushConstantBlockTypeId != 0);
+    }
+
     if (info && info->useRelaxedPrecision && info->activeStages[mShaderType] &&
         mFixedVaryingId[id] == 0)
     {
@@ -1985,6 +2013,13 @@ bool SpirvTransformer::transformDecorate(const uint32_t *instruction, size_t wor
         return true;
     }
 
+    // Push constant blocks don't take a descriptor set or binding.
+    if (info->pushConstantOffset != ShaderInterfaceVariableInfo::kInvalid &&
+        (decoration == spv::DecorationDescriptorSet || decoration == spv::DecorationBinding))
+    {
+        return true;
+    }
+
     uint32_t newDecorationValue = ShaderInterfaceVariableInfo::kInvalid;
 
     switch (decoration)
@@ -2096,14 +2131,24 @@ bool SpirvTransformer::transformDecorate(const uint32_t *instruction, size_t wor
 bool SpirvTransformer::transformMemberDecorate(const uint32_t *instruction, size_t wordCount)
 {
     // SPIR-V 1.0 Section 3.32 Instructions, OpMemberDecorate
-    constexpr size_t kTypeIdIndex     = 1;
-    constexpr size_t kMemberIndex     = 2;
-    constexpr size_t kDecorationIndex = 3;
+    constexpr size_t kTypeIdIndex          = 1;
+    constexpr size_t kMemberIndex          = 2;
+    constexpr size_t kDecorationIndex      = 3;
+    constexpr size_t kDecorationValueIndex = 4;
 
     uint32_t typeId     = instruction[kTypeIdIndex];
     uint32_t member     = instruction[kMemberIndex];
     uint32_t decoration = instruction[kDecorationIndex];
 
+    // Move the default uniform block to this stage's part of the push constant range.
+    if (typeId == mPushConstantBlockTypeId && decoration == spv::DecorationOffset &&
+        mPushConstantOffset != 0)
+    {
+        const size_t instructionOffset = copyInstruction(instruction, wordCount);
+        (*mSpirvBlobOut)[instructionOffset + kDecorationValueIndex] += mPushConstantOffset;
+        return true;
+    }
+
     // Transform only OpMemberDecorate %gl_PerVertex N BuiltIn B
     if ((typeId != mOutputPerVertex.typeId && typeId != mInputPerVertex.typeId) ||
         decoration != spv::DecorationBuiltIn)
@@ -2302,6 +2347,22 @@ bool SpirvTransformer::transformTypePointer(const uint32_t *instruction, size_t
     // Precision fixup needs this typeID
     mTypePointerTransformedId[id].typeID = typeId;
 
+    // If the default uniform block is delivered through push constants, duplicate every Uniform
+    // pointer type with the PushConstant storage class for the block variable and the access
+    // chains into it.
+    if (storageClass == spv::StorageClassUniform && mPushConstantBlockTypeId != 0)
+    {
+        copyInstruction(instruction, wordCount);
+
+        const uint32_t pushConstantTypeId = getNewId();
+        writeTypePointer(pushConstantTypeId, spv::StorageClassPushConstant, typeId);
+
+        ASSERT(id < mTypePointerTransformedId.size());
+        mTypePointerTransformedId[id].pushConstantID = pushConstantTypeId;
+
+        return true;
+    }
+
     if (storageClass != spv::StorageClassOutput && storageClass != spv::StorageClassInput)
     {
         return false;
@@ -2391,6 +2452,17 @@ bool SpirvTransformer::transformVariable(const uint32_t *instruction, size_t wor
         return false;
     }
 
+    // If this is the default uniform block delivered through push constants, change its storage
+    // class.
+    if (storageClass == spv::StorageClassUniform &&
+        info->pushConstantOffset != ShaderInterfaceVariableInfo::kInvalid)
+    {
+        ASSERT(mTypePointerTransformedId[typeId].pushConstantID != 0);
+        writeVariable(id, mTypePointerTransformedId[typeId].pushConstantID,
+                      spv::StorageClassPushConstant);
+        return true;
+    }
+
     // Furthermore, if it's not an inactive varying output, there's nothing to do.  Note that
     // inactive varying inputs are already pruned by the translator.
     // However, input or output storage class for interface block will not be pruned when a shader
@@ -2450,6 +2522,21 @@ bool SpirvTransformer::transformAccessChain(const uint32_t *instruction, size_t
         return false;
     }
 
+    // Access chains into a default uniform block delivered through push constants produce
+    // PushConstant pointers.
+    if (info->pushConstantOffset != ShaderInterfaceVariableInfo::kInvalid)
+    {
+        const size_t instructionOffset = copyInstruction(instruction, wordCount);
+
+        ASSERT(typeId < mTypePointerTransformedId.size());
+        ASSERT(mTypePointerTransformedId[typeId].pushConstantID != 0);
+
+        (*mSpirvBlobOut)[instructionOffset + kTypeIdIndex] =
+            mTypePointerTransformedId[typeId].pushConstantID;
+
+        return true;
+    }
+
     if (info->activeStages[mShaderType] && !info->useRelaxedPrecision)
     {
         return false;
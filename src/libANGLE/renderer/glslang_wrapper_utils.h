@@ -94,6 +94,9 @@ struct ShaderInterfaceVariableInfo
     // vertex attribute aliasing transformation only.
     uint8_t attributeComponentCount = 0;
     uint8_t attributeLocationCount  = 0;
+    // For default uniform blocks that are delivered through push constants instead of a uniform
+    // buffer, the offset of this stage's block in the push constant range.
+    uint32_t pushConstantOffset = kInvalid;
 };
 
 // TODO: http://anglebug.com/4524: Need a different hash key than a string, since
@@ -11,6 +11,7 @@
 
 #include "common/FixedVector.h"
 #include "common/debug.h"
+#include "common/hash_utils.h"
 #include "common/mathutil.h"
 #include "common/utilities.h"
 #include "libANGLE/Context.h"
@@ -33,6 +34,12 @@ static_assert(gl::isPow2(kBufferSizeGranularity), "use as alignment, must be pow
 // Start with a fairly small buffer size. We can increase this dynamically as we convert more data.
 constexpr size_t kConvertedArrayBufferInitialSize = 1024 * 8;
 
+// Conversions are only discarded when the buffer's data changes, so draws of ever-changing ranges
+// of a static buffer would accumulate them in the cache.  They are discarded once their total size
+// exceeds this multiple of the buffer's size, or the minimum below.
+constexpr size_t kIndexConversionsSizeLimitFactor = 4;
+constexpr size_t kIndexConversionsMinSizeLimit    = 1024 * 1024;
+
 // Buffers that have a static usage pattern will be allocated in
 // device local memory to speed up access to and from the GPU.
 // Dynamic usage patterns or that are frequently mapped
@@ -139,8 +146,34 @@ BufferVk::VertexConversionBuffer::VertexConversionBuffer(VertexConversionBuffer
 
 BufferVk::VertexConversionBuffer::~VertexConversionBuffer() = default;
 
+// IndexConversionDesc implementation.
+IndexConversionDesc::IndexConversionDesc(gl::DrawElementsType indexTypeIn,
+                                         size_t offsetIn,
+                                         size_t indexCountIn,
+                                         bool primitiveRestartIn,
+                                         bool lineLoopIn)
+    : offset(offsetIn),
+      indexCount(static_cast<uint32_t>(indexCountIn)),
+      indexType(static_cast<uint8_t>(indexTypeIn)),
+      primitiveRestart(primitiveRestartIn),
+      lineLoop(lineLoopIn),
+      padding(0)
+{}
+
+size_t IndexConversionDesc::hash() const
+{
+    return angle::ComputeGenericHash(*this);
+}
+
+bool IndexConversionDesc::operator==(const IndexConversionDesc &other) const
+{
+    return memcmp(this, &other, sizeof(IndexConversionDesc)) == 0;
+}
+
 // BufferVk implementation.
-BufferVk::BufferVk(const gl::BufferState &state) : BufferImpl(state), mBuffer(nullptr) {}
+BufferVk::BufferVk(const gl::BufferState &state)
+    : BufferImpl(state), mBuffer(nullptr), mIndexConversionsSize(0)
+{}
 
 BufferVk::~BufferVk() {}
 
@@ -168,6 +201,9 @@ void BufferVk::release(ContextVk *contextVk)
     {
         buffer.data.release(renderer);
     }
+
+    mIndexConversions.clear();
+    mIndexConversionsSize = 0;
 }
 
 angle::Result BufferVk::initializeShadowBuffer(ContextVk *contextVk,
@@ -461,6 +497,9 @@ angle::Result BufferVk::mapRangeImpl(ContextVk *contextVk,
         {
             ANGLE_TRY(mBuffer->waitForIdle(contextVk,
                                            "GPU stall due to mapping buffer in use by the GPU"));
+
+            // The GPU may have written to the buffer (e.g. glReadPixels into a pack buffer).
+            ANGLE_TRY(mBuffer->invalidate(contextVk->getRenderer(), offset, length));
         }
 
         ANGLE_TRY(mBuffer->mapWithOffset(contextVk, reinterpret_cast<uint8_t **>(mapPtr),
@@ -495,11 +534,7 @@ angle::Result BufferVk::unmapImpl(ContextVk *contextVk)
 {
     ASSERT(mBuffer && mBuffer->valid());
 
-    if (!mShadowBuffer.valid())
-    {
-        mBuffer->unmap(contextVk->getRenderer());
-    }
-    else
+    if (mShadowBuffer.valid())
     {
         bool writeOperation = ((mState.getAccessFlags() & GL_MAP_WRITE_BIT) != 0);
         size_t offset       = static_cast<size_t>(mState.getMapOffset());
@@ -513,15 +548,31 @@ angle::Result BufferVk::unmapImpl(ContextVk *contextVk)
             const uint8_t *data = getShadowBuffer(offset);
             ANGLE_TRY(stagedUpdate(contextVk, data, size, offset));
         }
-
-        mShadowBuffer.unmap();
     }
 
+    ANGLE_TRY(unmapReadOnlyImpl(contextVk));
+
     markConversionBuffersDirty();
 
     return angle::Result::Continue;
 }
 
+angle::Result BufferVk::unmapReadOnlyImpl(ContextVk *contextVk)
+{
+    ASSERT(mBuffer && mBuffer->valid());
+
+    if (!mShadowBuffer.valid())
+    {
+        mBuffer->unmap(contextVk->getRenderer());
+    }
+    else
+    {
+        mShadowBuffer.unmap();
+    }
+
+    return angle::Result::Continue;
+}
+
 angle::Result BufferVk::getSubData(const gl::Context *context,
                                    GLintptr offset,
                                    GLsizeiptr size,
@@ -755,12 +806,71 @@ ConversionBuffer *BufferVk::getVertexConversionBuffer(RendererVk *renderer,
     return &mVertexConversionBuffers.back();
 }
 
+bool BufferVk::getIndexConversion(ContextVk *contextVk,
+                                  const IndexConversionDesc &desc,
+                                  IndexConversion *conversionOut) const
+{
+    if (isPersistentlyMapped())
+    {
+        return false;
+    }
+
+    auto iter = mIndexConversions.find(desc);
+    if (iter == mIndexConversions.end() ||
+        iter->second.serial != contextVk->getIndexConversionSerial())
+    {
+        return false;
+    }
+
+    *conversionOut = iter->second;
+    return true;
+}
+
+angle::Result BufferVk::allocateIndexConversion(ContextVk *contextVk,
+                                                const IndexConversionDesc &desc,
+                                                size_t sizeInBytes,
+                                                uint32_t indexCount,
+                                                uint8_t **ptrOut,
+                                                IndexConversion *conversionOut)
+{
+    IndexConversion conversion = {};
+    ANGLE_TRY(contextVk->allocateIndexConversion(sizeInBytes, ptrOut, &conversion));
+    conversion.indexCount = indexCount;
+    *conversionOut        = conversion;
+
+    if (isPersistentlyMapped())
+    {
+        return angle::Result::Continue;
+    }
+
+    const size_t sizeLimit =
+        std::max(static_cast<size_t>(getSize()) * kIndexConversionsSizeLimitFactor,
+                 kIndexConversionsMinSizeLimit);
+    if (mIndexConversionsSize + sizeInBytes > sizeLimit)
+    {
+        discardIndexConversions();
+    }
+
+    // Replaces the conversion of another context, or one whose data was recycled.
+    mIndexConversions[desc] = conversion;
+    mIndexConversionsSize += sizeInBytes;
+    return angle::Result::Continue;
+}
+
 void BufferVk::markConversionBuffersDirty()
 {
     for (VertexConversionBuffer &buffer : mVertexConversionBuffers)
     {
         buffer.dirty = true;
     }
+
+    discardIndexConversions();
+}
+
+void BufferVk::discardIndexConversions()
+{
+    mIndexConversions.clear();
+    mIndexConversionsSize = 0;
 }
 
 void BufferVk::onDataChanged()
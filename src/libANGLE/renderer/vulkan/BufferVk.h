@@ -41,6 +41,51 @@ struct ConversionBuffer
     vk::DynamicBuffer data;
 };
 
+// Identifies a conversion of the indices of a draw call that are in a buffer: either the
+// translation of a line loop to a line strip, or the expansion of uint8 indices to uint16 when
+// VK_EXT_index_type_uint8 is not supported.
+struct IndexConversionDesc
+{
+    IndexConversionDesc(gl::DrawElementsType indexTypeIn,
+                        size_t offsetIn,
+                        size_t indexCountIn,
+                        bool primitiveRestartIn,
+                        bool lineLoopIn);
+
+    size_t hash() const;
+    bool operator==(const IndexConversionDesc &other) const;
+
+    uint64_t offset;
+    uint32_t indexCount;
+    uint8_t indexType;
+    uint8_t primitiveRestart;
+    uint8_t lineLoop;
+    uint8_t padding;
+};
+
+// Where the converted indices are.  They are sub-allocated from the index conversion buffer of
+// the context that converted them, and remain valid as long as that buffer's serial is |serial|.
+struct IndexConversion
+{
+    vk::BufferHelper *buffer;
+    VkDeviceSize offset;
+    uint32_t indexCount;
+    Serial serial;
+};
+}  // namespace rx
+
+namespace std
+{
+template <>
+struct hash<rx::IndexConversionDesc>
+{
+    size_t operator()(const rx::IndexConversionDesc &key) const { return key.hash(); }
+};
+}  // namespace std
+
+namespace rx
+{
+
 class BufferVk : public BufferImpl
 {
   public:
@@ -111,6 +156,7 @@ class BufferVk : public BufferImpl
     }
 
     bool isBufferValid() const { return mBuffer && mBuffer->valid(); }
+    bool isShadowBuffered() const { return mShadowBuffer.valid(); }
 
     angle::Result mapImpl(ContextVk *contextVk, void **mapPtr);
     angle::Result mapRangeImpl(ContextVk *contextVk,
@@ -119,6 +165,9 @@ class BufferVk : public BufferImpl
                                GLbitfield access,
                                void **mapPtr);
     angle::Result unmapImpl(ContextVk *contextVk);
+    // Unmaps a mapping that the data was only read through, which keeps the data converted from
+    // the buffer.
+    angle::Result unmapReadOnlyImpl(ContextVk *contextVk);
 
     // Calls copyBuffer internally.
     angle::Result copyToBufferImpl(ContextVk *contextVk,
@@ -132,6 +181,23 @@ class BufferVk : public BufferImpl
                                                 size_t offset,
                                                 bool hostVisible);
 
+    // Returns false if the indices described by |desc| have not been converted by |contextVk| since
+    // the buffer's data last changed.  Conversions are never cached while the buffer is
+    // persistently mapped, as the application can write the data at any time.
+    bool getIndexConversion(ContextVk *contextVk,
+                            const IndexConversionDesc &desc,
+                            IndexConversion *conversionOut) const;
+
+    // Allocates |sizeInBytes| for the conversion described by |desc|, to be filled with
+    // |indexCount| indices either on the GPU or through |ptrOut|, after which the CPU writes must
+    // be flushed with ContextVk::flushIndexConversions().
+    angle::Result allocateIndexConversion(ContextVk *contextVk,
+                                          const IndexConversionDesc &desc,
+                                          size_t sizeInBytes,
+                                          uint32_t indexCount,
+                                          uint8_t **ptrOut,
+                                          IndexConversion *conversionOut);
+
   private:
     angle::Result initializeShadowBuffer(ContextVk *contextVk,
                                          gl::BufferBinding target,
@@ -172,6 +238,11 @@ class BufferVk : public BufferImpl
                               size_t offset);
     void release(ContextVk *context);
     void markConversionBuffersDirty();
+    void discardIndexConversions();
+    bool isPersistentlyMapped() const
+    {
+        return mState.isMapped() && (mState.getAccessFlags() & GL_MAP_PERSISTENT_BIT_EXT) != 0;
+    }
 
     angle::Result acquireBufferHelper(ContextVk *contextVk,
                                       size_t sizeInBytes,
@@ -208,6 +279,11 @@ class BufferVk : public BufferImpl
 
     // A cache of converted vertex data.
     std::vector<VertexConversionBuffer> mVertexConversionBuffers;
+
+    // A cache of converted index data.  The data itself is in the contexts' index conversion
+    // buffers.
+    angle::HashMap<IndexConversionDesc, IndexConversion> mIndexConversions;
+    size_t mIndexConversionsSize;
 };
 
 }  // namespace rx
@@ -99,7 +99,6 @@ void FenceRecycler::destroy(vk::Context *context)
 void CommandProcessorTask::initTask()
 {
     mTask                        = CustomTask::Invalid;
-    mRenderPass                  = nullptr;
     mCommandBuffer               = nullptr;
     mSemaphore                   = nullptr;
     mOneOffFence                 = nullptr;
@@ -110,6 +109,7 @@ void CommandProcessorTask::initTask()
     mPresentInfo.pNext           = nullptr;
     mPresentInfo.pWaitSemaphores = nullptr;
     mOneOffCommandBufferVk       = VK_NULL_HANDLE;
+    mRenderPass.setHandle(VK_NULL_HANDLE);
 }
 
 void CommandProcessorTask::initProcessCommands(CommandBufferHelper *commandBuffer,
@@ -117,7 +117,7 @@ void CommandProcessorTask::initProcessCommands(CommandBufferHelper *commandBuffe
 {
     mTask          = CustomTask::ProcessCommands;
     mCommandBuffer = commandBuffer;
-    mRenderPass    = renderPass;
+    mRenderPass.setHandle(renderPass ? renderPass->getHandle() : VK_NULL_HANDLE);
 }
 
 void CommandProcessorTask::copyPresentInfo(const VkPresentInfoKHR &other)
@@ -236,7 +236,9 @@ CommandProcessorTask &CommandProcessorTask::operator=(CommandProcessorTask &&rhs
         return *this;
     }
 
-    std::swap(mRenderPass, rhs.mRenderPass);
+    VkRenderPass renderPass = mRenderPass.getHandle();
+    mRenderPass.setHandle(rhs.mRenderPass.getHandle());
+    rhs.mRenderPass.setHandle(renderPass);
     std::swap(mCommandBuffer, rhs.mCommandBuffer);
     std::swap(mTask, rhs.mTask);
     std::swap(mWaitSemaphores, rhs.mWaitSemaphores);
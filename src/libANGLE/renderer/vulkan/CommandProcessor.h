@@ -72,6 +72,7 @@ class CommandProcessorTask
 {
   public:
     CommandProcessorTask() { initTask(); }
+    ~CommandProcessorTask() { mRenderPass.setHandle(VK_NULL_HANDLE); }
 
     void initTask();
 
@@ -116,7 +117,10 @@ class CommandProcessorTask
     VkCommandBuffer getOneOffCommandBufferVk() const { return mOneOffCommandBufferVk; }
     const Fence *getOneOffFence() { return mOneOffFence; }
     const VkPresentInfoKHR &getPresentInfo() const { return mPresentInfo; }
-    const RenderPass *getRenderPass() const { return mRenderPass; }
+    const RenderPass *getRenderPass() const
+    {
+        return mRenderPass.valid() ? &mRenderPass : nullptr;
+    }
     CommandBufferHelper *getCommandBuffer() const { return mCommandBuffer; }
 
   private:
@@ -124,8 +128,10 @@ class CommandProcessorTask
 
     CustomTask mTask;
 
-    // ProcessCommands
-    const RenderPass *mRenderPass;
+    // ProcessCommands.  The render pass handle is copied rather than referenced, as the render
+    // pass cache may trim its entry before the worker thread processes the task.  The handle
+    // itself is released as garbage, so stays valid until the commands complete.
+    RenderPass mRenderPass;
     CommandBufferHelper *mCommandBuffer;
 
     // Flush data
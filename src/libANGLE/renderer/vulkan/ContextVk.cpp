@@ -13,6 +13,7 @@
 #include "common/debug.h"
 #include "common/utilities.h"
 #include "libANGLE/Context.h"
+#include "libANGLE/Context.inl.h"
 #include "libANGLE/Display.h"
 #include "libANGLE/Program.h"
 #include "libANGLE/Semaphore.h"
@@ -299,6 +300,26 @@ egl::ContextPriority GetContextPriority(const gl::State &state)
 {
     return egl::FromEGLenum<egl::ContextPriority>(state.getContextPriority());
 }
+
+// With VK_EXT_extended_dynamic_state, the primitive topology is set at draw time and the pipeline
+// only needs a topology of the same class.  Strip topologies are used for the lines and triangles
+// classes, as list topologies are not allowed with primitive restart.
+gl::PrimitiveMode GetDynamicTopologyClass(gl::PrimitiveMode mode)
+{
+    switch (mode)
+    {
+        case gl::PrimitiveMode::Lines:
+        case gl::PrimitiveMode::LineLoop:
+        case gl::PrimitiveMode::LineStrip:
+            return gl::PrimitiveMode::LineStrip;
+        case gl::PrimitiveMode::Triangles:
+        case gl::PrimitiveMode::TriangleStrip:
+        case gl::PrimitiveMode::TriangleFan:
+            return gl::PrimitiveMode::TriangleStrip;
+        default:
+            return mode;
+    }
+}
 }  // anonymous namespace
 
 ANGLE_INLINE void ContextVk::flushDescriptorSetUpdates()
@@ -407,6 +428,10 @@ ContextVk::ContextVk(const gl::State &state, gl::ErrorSet *errorSet, RendererVk
     mNewGraphicsCommandBufferDirtyBits.set(DIRTY_BIT_SHADER_RESOURCES);
     mNewGraphicsCommandBufferDirtyBits.set(DIRTY_BIT_DESCRIPTOR_SETS);
     mNewGraphicsCommandBufferDirtyBits.set(DIRTY_BIT_DRIVER_UNIFORMS_BINDING);
+    if (getFeatures().supportsExtendedDynamicState.enabled)
+    {
+        mNewGraphicsCommandBufferDirtyBits.set(DIRTY_BIT_DYNAMIC_STATE);
+    }
 
     mNewComputeCommandBufferDirtyBits.set(DIRTY_BIT_PIPELINE);
     mNewComputeCommandBufferDirtyBits.set(DIRTY_BIT_TEXTURES);
@@ -418,6 +443,8 @@ ContextVk::ContextVk(const gl::State &state, gl::ErrorSet *errorSet, RendererVk
     mGraphicsDirtyBitHandlers[DIRTY_BIT_DEFAULT_ATTRIBS] =
         &ContextVk::handleDirtyGraphicsDefaultAttribs;
     mGraphicsDirtyBitHandlers[DIRTY_BIT_PIPELINE] = &ContextVk::handleDirtyGraphicsPipeline;
+    mGraphicsDirtyBitHandlers[DIRTY_BIT_DYNAMIC_STATE] =
+        &ContextVk::handleDirtyGraphicsDynamicState;
     mGraphicsDirtyBitHandlers[DIRTY_BIT_TEXTURES] = &ContextVk::handleDirtyGraphicsTextures;
     mGraphicsDirtyBitHandlers[DIRTY_BIT_VERTEX_BUFFERS] =
         &ContextVk::handleDirtyGraphicsVertexBuffers;
@@ -465,6 +492,20 @@ ContextVk::ContextVk(const gl::State &state, gl::ErrorSet *errorSet, RendererVk
     mPipelineDirtyBitsMask.set();
     mPipelineDirtyBitsMask.reset(gl::State::DIRTY_BIT_TEXTURE_BINDINGS);
 
+    // State that is set dynamically doesn't require the pipeline to be rebound.
+    if (getFeatures().supportsExtendedDynamicState.enabled)
+    {
+        mPipelineDirtyBitsMask.reset(gl::State::DIRTY_BIT_CULL_FACE_ENABLED);
+        mPipelineDirtyBitsMask.reset(gl::State::DIRTY_BIT_CULL_FACE);
+        mPipelineDirtyBitsMask.reset(gl::State::DIRTY_BIT_FRONT_FACE);
+        mPipelineDirtyBitsMask.reset(gl::State::DIRTY_BIT_DEPTH_TEST_ENABLED);
+        mPipelineDirtyBitsMask.reset(gl::State::DIRTY_BIT_DEPTH_FUNC);
+        mPipelineDirtyBitsMask.reset(gl::State::DIRTY_BIT_DEPTH_MASK);
+        mPipelineDirtyBitsMask.reset(gl::State::DIRTY_BIT_STENCIL_TEST_ENABLED);
+        mPipelineDirtyBitsMask.reset(gl::State::DIRTY_BIT_STENCIL_OPS_FRONT);
+        mPipelineDirtyBitsMask.reset(gl::State::DIRTY_BIT_STENCIL_OPS_BACK);
+    }
+
     // Reserve reasonable amount of spaces so that for majority of apps we don't need to grow at all
     mDescriptorBufferInfos.reserve(kDescriptorBufferInfosInitialSize);
     mDescriptorImageInfos.reserve(kDescriptorImageInfosInitialSize);
@@ -503,6 +544,9 @@ void ContextVk::onDestroy(const gl::Context *context)
     mDefaultUniformStorage.release(mRenderer);
     mEmptyBuffer.release(mRenderer);
     mStagingBuffer.release(mRenderer);
+    mMultiDrawIndirectBuffer.release(mRenderer);
+    mIndexConversionBuffer.release(mRenderer);
+    mTranscodeBuffer.release(mRenderer);
 
     for (vk::DynamicBuffer &defaultBuffer : mDefaultAttribBuffers)
     {
@@ -511,7 +555,7 @@ void ContextVk::onDestroy(const gl::Context *context)
 
     for (vk::DynamicQueryPool &queryPool : mQueryPools)
     {
-        queryPool.destroy(device);
+        queryPool.destroy(mRenderer);
     }
 
     // Recycle current commands buffers.
@@ -526,9 +570,12 @@ void ContextVk::onDestroy(const gl::Context *context)
 
     mUtils.destroy(mRenderer);
 
+    waitForPipelineTasks();
+    mPipelineWorkerPool.reset();
+
     mRenderPassCache.destroy(device);
     mShaderLibrary.destroy(device);
-    mGpuEventQueryPool.destroy(device);
+    mGpuEventQueryPool.destroy(mRenderer);
     mCommandPool.destroy(device);
 }
 
@@ -629,6 +676,18 @@ angle::Result ContextVk::initialize()
 
     mUseOldRewriteStructSamplers = shouldUseOldRewriteStructSamplers();
 
+    if (getFeatures().asyncGraphicsPipelineOptimization.enabled ||
+        getFeatures().prespecializeGraphicsPipelines.enabled)
+    {
+        // If the pool can't run tasks in the background, creating pipelines through it would only
+        // add to their cost.
+        mPipelineWorkerPool = angle::WorkerThreadPool::Create(true);
+        if (!mPipelineWorkerPool->isAsync())
+        {
+            mPipelineWorkerPool.reset();
+        }
+    }
+
     // Assign initial command buffers from queue
     mOutsideRenderPassCommands = mRenderer->getCommandBufferHelper(false);
     mRenderPassCommands        = mRenderer->getCommandBufferHelper(true);
@@ -678,6 +737,30 @@ angle::Result ContextVk::initialize()
     mStagingBuffer.init(mRenderer, kStagingBufferUsageFlags, stagingBufferAlignment,
                         kStagingBufferSize, true);
 
+    // Indirect command offsets must be 4-byte aligned.
+    constexpr size_t kMultiDrawIndirectBufferSize = 64u * 1024u;
+    mMultiDrawIndirectBuffer.init(mRenderer, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, 4,
+                                  kMultiDrawIndirectBufferSize, true);
+
+    // Converted indices are written by the GPU with either a copy or a compute shader, or by the
+    // CPU.  We use an alignment of four so compute shaders can read the indices from "uint"
+    // aligned addresses, which also fits uint32 indices.
+    constexpr VkBufferUsageFlags kIndexConversionBufferUsageFlags =
+        vk::kIndexBufferUsageFlags | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    constexpr size_t kIndexConversionBufferSize = 256u * 1024u;
+    mIndexConversionBuffer.init(mRenderer, kIndexConversionBufferUsageFlags,
+                                vk::kIndexBufferAlignment, kIndexConversionBufferSize, true);
+
+    // Compressed texture uploads that are decoded in compute are written here, then copied to the
+    // image.  The decode is split so that each part fits in the initial size.
+    constexpr VkBufferUsageFlags kTranscodeBufferUsageFlags =
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    size_t transcodeBufferAlignment = std::max<size_t>(
+        4, static_cast<size_t>(
+               mRenderer->getPhysicalDeviceProperties().limits.minStorageBufferOffsetAlignment));
+    mTranscodeBuffer.init(mRenderer, kTranscodeBufferUsageFlags, transcodeBufferAlignment,
+                          vk::kTranscodeBufferSize, false);
+
     // Add context into the share group
     mShareGroupVk->getShareContextSet()->insert(this);
 
@@ -718,9 +801,23 @@ angle::Result ContextVk::setupDraw(const gl::Context *context,
     // Set any dirty bits that depend on draw call parameters or other objects.
     if (mode != mCurrentDrawMode)
     {
-        invalidateCurrentGraphicsPipeline();
+        if (getFeatures().supportsExtendedDynamicState.enabled)
+        {
+            // The pipeline only needs to change if the topology class changes.
+            invalidateGraphicsDynamicState();
+            if (GetDynamicTopologyClass(mode) != GetDynamicTopologyClass(mCurrentDrawMode))
+            {
+                invalidateCurrentGraphicsPipeline();
+                mGraphicsPipelineDesc->updateTopology(&mGraphicsPipelineTransition,
+                                                      GetDynamicTopologyClass(mode));
+            }
+        }
+        else
+        {
+            invalidateCurrentGraphicsPipeline();
+            mGraphicsPipelineDesc->updateTopology(&mGraphicsPipelineTransition, mode);
+        }
         mCurrentDrawMode = mode;
-        mGraphicsPipelineDesc->updateTopology(&mGraphicsPipelineTransition, mCurrentDrawMode);
     }
 
     // Must be called before the command buffer is started. Can call finish.
@@ -757,8 +854,12 @@ angle::Result ContextVk::setupDraw(const gl::Context *context,
 
     if (mProgram && mProgram->dirtyUniforms())
     {
-        ANGLE_TRY(mProgram->updateUniforms(this));
-        mGraphicsDirtyBits.set(DIRTY_BIT_DESCRIPTOR_SETS);
+        bool descriptorSetsDirty = false;
+        ANGLE_TRY(mProgram->updateUniforms(this, *commandBufferOut, &descriptorSetsDirty));
+        if (descriptorSetsDirty)
+        {
+            mGraphicsDirtyBits.set(DIRTY_BIT_DESCRIPTOR_SETS);
+        }
     }
     else if (mProgramPipeline && mProgramPipeline->dirtyUniforms(getState()))
     {
@@ -830,24 +931,8 @@ angle::Result ContextVk::setupIndexedDraw(const gl::Context *context,
                                "Potential inefficiency emulating uint8 vertex attributes due to "
                                "lack of hardware support");
 
-            BufferVk *bufferVk             = vk::GetImpl(elementArrayBuffer);
-            vk::BufferHelper &bufferHelper = bufferVk->getBuffer();
-
-            if (bufferHelper.isHostVisible() &&
-                !bufferHelper.isCurrentlyInUse(getLastCompletedQueueSerial()))
-            {
-                uint8_t *src = nullptr;
-                ANGLE_TRY(bufferVk->mapImpl(this, reinterpret_cast<void **>(&src)));
-                src += reinterpret_cast<uintptr_t>(indices);
-                const size_t byteCount = static_cast<size_t>(elementArrayBuffer->getSize()) -
-                                         reinterpret_cast<uintptr_t>(indices);
-                ANGLE_TRY(mVertexArray->convertIndexBufferCPU(this, indexType, byteCount, src));
-                ANGLE_TRY(bufferVk->unmapImpl(this));
-            }
-            else
-            {
-                ANGLE_TRY(mVertexArray->convertIndexBufferGPU(this, bufferVk, indices));
-            }
+            BufferVk *bufferVk = vk::GetImpl(elementArrayBuffer);
+            ANGLE_TRY(mVertexArray->convertIndexBufferUint8(this, bufferVk, indices));
         }
     }
 
@@ -994,8 +1079,12 @@ angle::Result ContextVk::setupDispatch(const gl::Context *context,
 
     if (mProgram && mProgram->dirtyUniforms())
     {
-        ANGLE_TRY(mProgram->updateUniforms(this));
-        mComputeDirtyBits.set(DIRTY_BIT_DESCRIPTOR_SETS);
+        bool descriptorSetsDirty = false;
+        ANGLE_TRY(mProgram->updateUniforms(this, *commandBufferOut, &descriptorSetsDirty));
+        if (descriptorSetsDirty)
+        {
+            mComputeDirtyBits.set(DIRTY_BIT_DESCRIPTOR_SETS);
+        }
     }
     else if (mProgramPipeline && mProgramPipeline->dirtyUniforms(getState()))
     {
@@ -1125,6 +1214,7 @@ angle::Result ContextVk::handleDirtyGraphicsPipeline(const gl::Context *context,
 
     pauseTransformFeedbackIfStarted({});
 
+    mCurrentGraphicsPipeline->updatePendingPipeline(this);
     commandBuffer->bindGraphicsPipeline(mCurrentGraphicsPipeline->getPipeline());
     // Update the queue serial for the pipeline object.
     ASSERT(mCurrentGraphicsPipeline && mCurrentGraphicsPipeline->valid());
@@ -1134,6 +1224,44 @@ angle::Result ContextVk::handleDirtyGraphicsPipeline(const gl::Context *context,
     return angle::Result::Continue;
 }
 
+angle::Result ContextVk::handleDirtyGraphicsDynamicState(const gl::Context *context,
+                                                         vk::CommandBuffer *commandBuffer)
+{
+    ASSERT(getFeatures().supportsExtendedDynamicState.enabled);
+
+    const gl::State &glState                       = context->getState();
+    const gl::RasterizerState &rasterState         = glState.getRasterizerState();
+    const gl::DepthStencilState &depthStencilState = glState.getDepthStencilState();
+    const gl::Framebuffer *drawFramebuffer         = glState.getDrawFramebuffer();
+
+    commandBuffer->setCullMode(gl_vk::GetCullMode(rasterState));
+    commandBuffer->setFrontFace(
+        gl_vk::GetFrontFace(rasterState.frontFace, isViewportFlipEnabledForDrawFBO()));
+    commandBuffer->setPrimitiveTopology(gl_vk::GetPrimitiveTopology(mCurrentDrawMode));
+
+    // Only enable the depth and stencil tests if the draw framebuffer has the corresponding
+    // aspect.  It's possible that we're emulating a depth-only or stencil-only buffer with a
+    // depth-stencil buffer.  Similarly, don't write to depth buffers that should not exist.
+    const bool hasDepth   = drawFramebuffer->hasDepth();
+    const bool hasStencil = drawFramebuffer->hasStencil();
+    commandBuffer->setDepthTestEnable(depthStencilState.depthTest && hasDepth);
+    commandBuffer->setDepthWriteEnable(depthStencilState.depthMask && hasDepth);
+    commandBuffer->setDepthCompareOp(gl_vk::GetCompareOp(depthStencilState.depthFunc));
+    commandBuffer->setStencilTestEnable(depthStencilState.stencilTest && hasStencil);
+    commandBuffer->setStencilOp(VK_STENCIL_FACE_FRONT_BIT,
+                                gl_vk::GetStencilOp(depthStencilState.stencilFail),
+                                gl_vk::GetStencilOp(depthStencilState.stencilPassDepthPass),
+                                gl_vk::GetStencilOp(depthStencilState.stencilPassDepthFail),
+                                gl_vk::GetCompareOp(depthStencilState.stencilFunc));
+    commandBuffer->setStencilOp(VK_STENCIL_FACE_BACK_BIT,
+                                gl_vk::GetStencilOp(depthStencilState.stencilBackFail),
+                                gl_vk::GetStencilOp(depthStencilState.stencilBackPassDepthPass),
+                                gl_vk::GetStencilOp(depthStencilState.stencilBackPassDepthFail),
+                                gl_vk::GetCompareOp(depthStencilState.stencilBackFunc));
+
+    return angle::Result::Continue;
+}
+
 angle::Result ContextVk::handleDirtyComputePipeline(const gl::Context *context,
                                                     vk::CommandBuffer *commandBuffer)
 {
@@ -2266,6 +2394,11 @@ angle::Result ContextVk::multiDrawArrays(const gl::Context *context,
                                          const GLsizei *counts,
                                          GLsizei drawcount)
 {
+    if (canMultiDrawIndirect(context, mode, drawcount, false))
+    {
+        return multiDrawArraysIndirect(context, mode, firsts, counts, nullptr, nullptr, drawcount);
+    }
+
     return rx::MultiDrawArraysGeneral(this, context, mode, firsts, counts, drawcount);
 }
 
@@ -2276,6 +2409,12 @@ angle::Result ContextVk::multiDrawArraysInstanced(const gl::Context *context,
                                                   const GLsizei *instanceCounts,
                                                   GLsizei drawcount)
 {
+    if (canMultiDrawIndirect(context, mode, drawcount, false))
+    {
+        return multiDrawArraysIndirect(context, mode, firsts, counts, instanceCounts, nullptr,
+                                       drawcount);
+    }
+
     return rx::MultiDrawArraysInstancedGeneral(this, context, mode, firsts, counts, instanceCounts,
                                                drawcount);
 }
@@ -2287,6 +2426,12 @@ angle::Result ContextVk::multiDrawElements(const gl::Context *context,
                                            const GLvoid *const *indices,
                                            GLsizei drawcount)
 {
+    if (canMultiDrawElementsIndirect(context, mode, type, indices, drawcount, false))
+    {
+        return multiDrawElementsIndirect(context, mode, counts, type, indices, nullptr, nullptr,
+                                         nullptr, drawcount);
+    }
+
     return rx::MultiDrawElementsGeneral(this, context, mode, counts, type, indices, drawcount);
 }
 
@@ -2298,6 +2443,12 @@ angle::Result ContextVk::multiDrawElementsInstanced(const gl::Context *context,
                                                     const GLsizei *instanceCounts,
                                                     GLsizei drawcount)
 {
+    if (canMultiDrawElementsIndirect(context, mode, type, indices, drawcount, false))
+    {
+        return multiDrawElementsIndirect(context, mode, counts, type, indices, instanceCounts,
+                                         nullptr, nullptr, drawcount);
+    }
+
     return rx::MultiDrawElementsInstancedGeneral(this, context, mode, counts, type, indices,
                                                  instanceCounts, drawcount);
 }
@@ -2310,6 +2461,12 @@ angle::Result ContextVk::multiDrawArraysInstancedBaseInstance(const gl::Context
                                                               const GLuint *baseInstances,
                                                               GLsizei drawcount)
 {
+    if (canMultiDrawIndirect(context, mode, drawcount, true))
+    {
+        return multiDrawArraysIndirect(context, mode, firsts, counts, instanceCounts,
+                                       baseInstances, drawcount);
+    }
+
     return rx::MultiDrawArraysInstancedBaseInstanceGeneral(
         this, context, mode, firsts, counts, instanceCounts, baseInstances, drawcount);
 }
@@ -2325,11 +2482,191 @@ angle::Result ContextVk::multiDrawElementsInstancedBaseVertexBaseInstance(
     const GLuint *baseInstances,
     GLsizei drawcount)
 {
+    if (canMultiDrawElementsIndirect(context, mode, type, indices, drawcount, true))
+    {
+        return multiDrawElementsIndirect(context, mode, counts, type, indices, instanceCounts,
+                                         baseVertices, baseInstances, drawcount);
+    }
+
     return rx::MultiDrawElementsInstancedBaseVertexBaseInstanceGeneral(
         this, context, mode, counts, type, indices, instanceCounts, baseVertices, baseInstances,
         drawcount);
 }
 
+bool ContextVk::canMultiDrawIndirect(const gl::Context *context,
+                                     gl::PrimitiveMode mode,
+                                     GLsizei drawcount,
+                                     bool hasBaseInstance) const
+{
+    // A single draw gains nothing from going through a buffer.
+    if (!getFeatures().supportsMultiDrawIndirect.enabled || drawcount <= 1 ||
+        static_cast<uint32_t>(drawcount) >
+            mRenderer->getPhysicalDeviceProperties().limits.maxDrawIndirectCount)
+    {
+        return false;
+    }
+
+    if (hasBaseInstance && !mRenderer->getPhysicalDeviceFeatures().drawIndirectFirstInstance)
+    {
+        return false;
+    }
+
+    // Line loops are converted per draw, streamed attributes need each draw's vertex range, and
+    // emulated transform feedback needs each draw's first vertex.
+    if (mode == gl::PrimitiveMode::LineLoop ||
+        mVertexArray->getStreamingVertexAttribsMask().any() ||
+        mState.isTransformFeedbackActiveUnpaused())
+    {
+        return false;
+    }
+
+    // gl_DrawID, gl_BaseVertex and gl_BaseInstance are emulated with uniforms that are set
+    // between draws.  gl_DrawID also adds the index of the draw in the indirect command when the
+    // shaders can read it, see SH_ADD_DRAW_INDEX_TO_DRAW_ID.
+    const gl::Program *program = mState.getLinkedProgram(context);
+    if (program == nullptr)
+    {
+        return true;
+    }
+    if (program->hasDrawIDUniform() && !getFeatures().supportsShaderDrawParameters.enabled)
+    {
+        return false;
+    }
+    return !program->hasBaseVertexUniform() && !program->hasBaseInstanceUniform();
+}
+
+void ContextVk::resetDrawIDUniform(const gl::Context *context)
+{
+    // Draws in the indirect command read their index from DrawIndex, which is added to the
+    // uniform.  It's left at the last draw's index by multi-draws issued as separate draws.
+    gl::Program *program = mState.getLinkedProgram(context);
+    if (program != nullptr && program->hasDrawIDUniform())
+    {
+        program->setDrawIDUniform(0);
+    }
+}
+
+bool ContextVk::canMultiDrawElementsIndirect(const gl::Context *context,
+                                             gl::PrimitiveMode mode,
+                                             gl::DrawElementsType type,
+                                             const GLvoid *const *indices,
+                                             GLsizei drawcount,
+                                             bool hasBaseInstance) const
+{
+    if (!canMultiDrawIndirect(context, mode, drawcount, hasBaseInstance))
+    {
+        return false;
+    }
+
+    // Every draw must index the bound element array buffer directly, at an offset the indirect
+    // command can express as a first index.
+    if (!mVertexArray->getState().getElementArrayBuffer() || shouldConvertUint8VkIndexType(type))
+    {
+        return false;
+    }
+
+    const GLuint typeSize = gl::GetDrawElementsTypeSize(type);
+    for (GLsizei drawID = 0; drawID < drawcount; ++drawID)
+    {
+        if (reinterpret_cast<uintptr_t>(indices[drawID]) % typeSize != 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+angle::Result ContextVk::multiDrawArraysIndirect(const gl::Context *context,
+                                                 gl::PrimitiveMode mode,
+                                                 const GLint *firsts,
+                                                 const GLsizei *counts,
+                                                 const GLsizei *instanceCounts,
+                                                 const GLuint *baseInstances,
+                                                 GLsizei drawcount)
+{
+    uint8_t *commandData      = nullptr;
+    VkDeviceSize bufferOffset = 0;
+    ANGLE_TRY(mMultiDrawIndirectBuffer.allocate(this, sizeof(VkDrawIndirectCommand) * drawcount,
+                                                &commandData, nullptr, &bufferOffset, nullptr));
+
+    VkDrawIndirectCommand *commands = reinterpret_cast<VkDrawIndirectCommand *>(commandData);
+    for (GLsizei drawID = 0; drawID < drawcount; ++drawID)
+    {
+        VkDrawIndirectCommand &command = commands[drawID];
+        command.vertexCount            = gl::GetClampedVertexCount<uint32_t>(counts[drawID]);
+        command.instanceCount          = instanceCounts ? instanceCounts[drawID] : 1;
+        command.firstVertex            = firsts[drawID];
+        command.firstInstance          = baseInstances ? baseInstances[drawID] : 0;
+    }
+    ANGLE_TRY(mMultiDrawIndirectBuffer.flush(this));
+    resetDrawIDUniform(context);
+
+    vk::BufferHelper *indirectBuffer = mMultiDrawIndirectBuffer.getCurrentBuffer();
+    vk::CommandBuffer *commandBuffer = nullptr;
+    ANGLE_TRY(setupIndirectDraw(context, mode, mNonIndexedDirtyBitsMask, indirectBuffer,
+                                bufferOffset, &commandBuffer));
+
+    commandBuffer->drawIndirect(indirectBuffer->getBuffer(), bufferOffset, drawcount,
+                                sizeof(VkDrawIndirectCommand));
+    mPerfCounters.indirectMultiDraws++;
+    gl::MarkShaderStorageUsage(context);
+    return angle::Result::Continue;
+}
+
+angle::Result ContextVk::multiDrawElementsIndirect(const gl::Context *context,
+                                                   gl::PrimitiveMode mode,
+                                                   const GLsizei *counts,
+                                                   gl::DrawElementsType type,
+                                                   const GLvoid *const *indices,
+                                                   const GLsizei *instanceCounts,
+                                                   const GLint *baseVertices,
+                                                   const GLuint *baseInstances,
+                                                   GLsizei drawcount)
+{
+    const GLuint typeSize = gl::GetDrawElementsTypeSize(type);
+
+    uint8_t *commandData      = nullptr;
+    VkDeviceSize bufferOffset = 0;
+    ANGLE_TRY(mMultiDrawIndirectBuffer.allocate(this,
+                                                sizeof(VkDrawIndexedIndirectCommand) * drawcount,
+                                                &commandData, nullptr, &bufferOffset, nullptr));
+
+    VkDrawIndexedIndirectCommand *commands =
+        reinterpret_cast<VkDrawIndexedIndirectCommand *>(commandData);
+    for (GLsizei drawID = 0; drawID < drawcount; ++drawID)
+    {
+        const uintptr_t indexOffset           = reinterpret_cast<uintptr_t>(indices[drawID]);
+        VkDrawIndexedIndirectCommand &command = commands[drawID];
+        command.indexCount                    = counts[drawID];
+        command.instanceCount                 = instanceCounts ? instanceCounts[drawID] : 1;
+        command.firstIndex                    = static_cast<uint32_t>(indexOffset / typeSize);
+        command.vertexOffset                  = baseVertices ? baseVertices[drawID] : 0;
+        command.firstInstance                 = baseInstances ? baseInstances[drawID] : 0;
+    }
+    ANGLE_TRY(mMultiDrawIndirectBuffer.flush(this));
+    resetDrawIDUniform(context);
+
+    // The first index of each draw is relative to the start of the element array buffer.
+    if (mLastIndexBufferOffset != nullptr)
+    {
+        mGraphicsDirtyBits.set(DIRTY_BIT_INDEX_BUFFER);
+        mLastIndexBufferOffset = nullptr;
+        mVertexArray->updateCurrentElementArrayBufferOffset(mLastIndexBufferOffset);
+    }
+
+    vk::BufferHelper *indirectBuffer = mMultiDrawIndirectBuffer.getCurrentBuffer();
+    vk::CommandBuffer *commandBuffer = nullptr;
+    ANGLE_TRY(setupIndexedIndirectDraw(context, mode, type, indirectBuffer, bufferOffset,
+                                       &commandBuffer));
+
+    commandBuffer->drawIndexedIndirect(indirectBuffer->getBuffer(), bufferOffset, drawcount,
+                                       sizeof(VkDrawIndexedIndirectCommand));
+    mPerfCounters.indirectMultiDraws++;
+    gl::MarkShaderStorageUsage(context);
+    return angle::Result::Continue;
+}
+
 void ContextVk::optimizeRenderPassForPresent(VkFramebuffer framebufferHandle)
 {
     if (!mRenderPassCommands->started())
@@ -2719,6 +3056,9 @@ angle::Result ContextVk::syncState(const gl::Context *context,
     const gl::State &glState                       = context->getState();
     const gl::ProgramExecutable *programExecutable = glState.getProgramExecutable();
 
+    // With VK_EXT_extended_dynamic_state, some of the state below is set in the command buffer.
+    const bool useDynamicState = getFeatures().supportsExtendedDynamicState.enabled;
+
     if ((dirtyBits & mPipelineDirtyBitsMask).any() &&
         (programExecutable == nullptr || !programExecutable->isCompute()))
     {
@@ -2786,49 +3126,111 @@ angle::Result ContextVk::syncState(const gl::Context *context,
                 break;
             case gl::State::DIRTY_BIT_DEPTH_TEST_ENABLED:
             {
-                mGraphicsPipelineDesc->updateDepthTestEnabled(&mGraphicsPipelineTransition,
-                                                              glState.getDepthStencilState(),
-                                                              glState.getDrawFramebuffer());
+                if (useDynamicState)
+                {
+                    invalidateGraphicsDynamicState();
+                }
+                else
+                {
+                    mGraphicsPipelineDesc->updateDepthTestEnabled(&mGraphicsPipelineTransition,
+                                                                  glState.getDepthStencilState(),
+                                                                  glState.getDrawFramebuffer());
+                }
                 ANGLE_TRY(updateRenderPassDepthStencilAccess());
                 break;
             }
             case gl::State::DIRTY_BIT_DEPTH_FUNC:
-                mGraphicsPipelineDesc->updateDepthFunc(&mGraphicsPipelineTransition,
-                                                       glState.getDepthStencilState());
+                if (useDynamicState)
+                {
+                    invalidateGraphicsDynamicState();
+                }
+                else
+                {
+                    mGraphicsPipelineDesc->updateDepthFunc(&mGraphicsPipelineTransition,
+                                                           glState.getDepthStencilState());
+                }
                 break;
             case gl::State::DIRTY_BIT_DEPTH_MASK:
             {
-                mGraphicsPipelineDesc->updateDepthWriteEnabled(&mGraphicsPipelineTransition,
-                                                               glState.getDepthStencilState(),
-                                                               glState.getDrawFramebuffer());
+                if (useDynamicState)
+                {
+                    invalidateGraphicsDynamicState();
+                }
+                else
+                {
+                    mGraphicsPipelineDesc->updateDepthWriteEnabled(&mGraphicsPipelineTransition,
+                                                                   glState.getDepthStencilState(),
+                                                                   glState.getDrawFramebuffer());
+                }
                 ANGLE_TRY(updateRenderPassDepthStencilAccess());
                 break;
             }
             case gl::State::DIRTY_BIT_STENCIL_TEST_ENABLED:
             {
-                mGraphicsPipelineDesc->updateStencilTestEnabled(&mGraphicsPipelineTransition,
-                                                                glState.getDepthStencilState(),
-                                                                glState.getDrawFramebuffer());
+                if (useDynamicState)
+                {
+                    invalidateGraphicsDynamicState();
+                }
+                else
+                {
+                    mGraphicsPipelineDesc->updateStencilTestEnabled(
+                        &mGraphicsPipelineTransition, glState.getDepthStencilState(),
+                        glState.getDrawFramebuffer());
+                }
                 ANGLE_TRY(updateRenderPassDepthStencilAccess());
                 break;
             }
             case gl::State::DIRTY_BIT_STENCIL_FUNCS_FRONT:
-                mGraphicsPipelineDesc->updateStencilFrontFuncs(&mGraphicsPipelineTransition,
-                                                               glState.getStencilRef(),
-                                                               glState.getDepthStencilState());
+                if (useDynamicState)
+                {
+                    mGraphicsPipelineDesc->updateStencilFrontReferenceAndMask(
+                        &mGraphicsPipelineTransition, glState.getStencilRef(),
+                        glState.getDepthStencilState());
+                    invalidateGraphicsDynamicState();
+                }
+                else
+                {
+                    mGraphicsPipelineDesc->updateStencilFrontFuncs(&mGraphicsPipelineTransition,
+                                                                   glState.getStencilRef(),
+                                                                   glState.getDepthStencilState());
+                }
                 break;
             case gl::State::DIRTY_BIT_STENCIL_FUNCS_BACK:
-                mGraphicsPipelineDesc->updateStencilBackFuncs(&mGraphicsPipelineTransition,
-                                                              glState.getStencilBackRef(),
-                                                              glState.getDepthStencilState());
+                if (useDynamicState)
+                {
+                    mGraphicsPipelineDesc->updateStencilBackReferenceAndMask(
+                        &mGraphicsPipelineTransition, glState.getStencilBackRef(),
+                        glState.getDepthStencilState());
+                    invalidateGraphicsDynamicState();
+                }
+                else
+                {
+                    mGraphicsPipelineDesc->updateStencilBackFuncs(&mGraphicsPipelineTransition,
+                                                                  glState.getStencilBackRef(),
+                                                                  glState.getDepthStencilState());
+                }
                 break;
             case gl::State::DIRTY_BIT_STENCIL_OPS_FRONT:
-                mGraphicsPipelineDesc->updateStencilFrontOps(&mGraphicsPipelineTransition,
-                                                             glState.getDepthStencilState());
+                if (useDynamicState)
+                {
+                    invalidateGraphicsDynamicState();
+                }
+                else
+                {
+                    mGraphicsPipelineDesc->updateStencilFrontOps(&mGraphicsPipelineTransition,
+                                                                 glState.getDepthStencilState());
+                }
                 break;
             case gl::State::DIRTY_BIT_STENCIL_OPS_BACK:
-                mGraphicsPipelineDesc->updateStencilBackOps(&mGraphicsPipelineTransition,
-                                                            glState.getDepthStencilState());
+                if (useDynamicState)
+                {
+                    invalidateGraphicsDynamicState();
+                }
+                else
+                {
+                    mGraphicsPipelineDesc->updateStencilBackOps(&mGraphicsPipelineTransition,
+                                                                glState.getDepthStencilState());
+                }
                 break;
             case gl::State::DIRTY_BIT_STENCIL_WRITEMASK_FRONT:
                 mGraphicsPipelineDesc->updateStencilFrontWriteMask(&mGraphicsPipelineTransition,
@@ -2842,13 +3244,27 @@ angle::Result ContextVk::syncState(const gl::Context *context,
                 break;
             case gl::State::DIRTY_BIT_CULL_FACE_ENABLED:
             case gl::State::DIRTY_BIT_CULL_FACE:
-                mGraphicsPipelineDesc->updateCullMode(&mGraphicsPipelineTransition,
-                                                      glState.getRasterizerState());
+                if (useDynamicState)
+                {
+                    invalidateGraphicsDynamicState();
+                }
+                else
+                {
+                    mGraphicsPipelineDesc->updateCullMode(&mGraphicsPipelineTransition,
+                                                          glState.getRasterizerState());
+                }
                 break;
             case gl::State::DIRTY_BIT_FRONT_FACE:
-                mGraphicsPipelineDesc->updateFrontFace(&mGraphicsPipelineTransition,
-                                                       glState.getRasterizerState(),
-                                                       isViewportFlipEnabledForDrawFBO());
+                if (useDynamicState)
+                {
+                    invalidateGraphicsDynamicState();
+                }
+                else
+                {
+                    mGraphicsPipelineDesc->updateFrontFace(&mGraphicsPipelineTransition,
+                                                           glState.getRasterizerState(),
+                                                           isViewportFlipEnabledForDrawFBO());
+                }
                 break;
             case gl::State::DIRTY_BIT_POLYGON_OFFSET_FILL_ENABLED:
                 mGraphicsPipelineDesc->updatePolygonOffsetFillEnabled(
@@ -2922,17 +3338,24 @@ angle::Result ContextVk::syncState(const gl::Context *context,
                                glState.getFarPlane(), isViewportFlipEnabledForDrawFBO());
                 updateColorMasks(glState.getBlendStateExt());
                 updateRasterizationSamples(mDrawFramebuffer->getSamples());
-                mGraphicsPipelineDesc->updateFrontFace(&mGraphicsPipelineTransition,
-                                                       glState.getRasterizerState(),
-                                                       isViewportFlipEnabledForDrawFBO());
                 updateScissor(glState);
                 const gl::DepthStencilState depthStencilState = glState.getDepthStencilState();
-                mGraphicsPipelineDesc->updateDepthTestEnabled(&mGraphicsPipelineTransition,
-                                                              depthStencilState, drawFramebuffer);
-                mGraphicsPipelineDesc->updateDepthWriteEnabled(&mGraphicsPipelineTransition,
-                                                               depthStencilState, drawFramebuffer);
-                mGraphicsPipelineDesc->updateStencilTestEnabled(&mGraphicsPipelineTransition,
-                                                                depthStencilState, drawFramebuffer);
+                if (useDynamicState)
+                {
+                    invalidateGraphicsDynamicState();
+                }
+                else
+                {
+                    mGraphicsPipelineDesc->updateFrontFace(&mGraphicsPipelineTransition,
+                                                           glState.getRasterizerState(),
+                                                           isViewportFlipEnabledForDrawFBO());
+                    mGraphicsPipelineDesc->updateDepthTestEnabled(
+                        &mGraphicsPipelineTransition, depthStencilState, drawFramebuffer);
+                    mGraphicsPipelineDesc->updateDepthWriteEnabled(
+                        &mGraphicsPipelineTransition, depthStencilState, drawFramebuffer);
+                    mGraphicsPipelineDesc->updateStencilTestEnabled(
+                        &mGraphicsPipelineTransition, depthStencilState, drawFramebuffer);
+                }
                 mGraphicsPipelineDesc->updateStencilFrontWriteMask(
                     &mGraphicsPipelineTransition, depthStencilState, drawFramebuffer);
                 mGraphicsPipelineDesc->updateStencilBackWriteMask(
@@ -3509,6 +3932,16 @@ void ContextVk::invalidateComputeDescriptorSet(DescriptorSetIndex usedDescriptor
     }
 }
 
+void ContextVk::invalidateDefaultUniformPushConstants()
+{
+    // Binding the descriptor sets pushes the whole default uniform blocks again.
+    if (mExecutable && mExecutable->getDefaultUniformPushConstantStages().any())
+    {
+        mGraphicsDirtyBits.set(DIRTY_BIT_DESCRIPTOR_SETS);
+        mComputeDirtyBits.set(DIRTY_BIT_DESCRIPTOR_SETS);
+    }
+}
+
 angle::Result ContextVk::dispatchCompute(const gl::Context *context,
                                          GLuint numGroupsX,
                                          GLuint numGroupsY,
@@ -3593,6 +4026,18 @@ angle::Result ContextVk::memoryBarrierImpl(GLbitfield barriers, VkPipelineStageF
     return angle::Result::Continue;
 }
 
+void ContextVk::removeQueryResultCopies(const vk::QueryResultCopy &copy)
+{
+    mQueryResultCopies.erase(
+        std::remove_if(mQueryResultCopies.begin(), mQueryResultCopies.end(),
+                       [&copy](const vk::QueryResultCopy &pending) {
+                           return pending.dynamicQueryPool == copy.dynamicQueryPool &&
+                                  pending.queryPoolIndex == copy.queryPoolIndex &&
+                                  pending.query == copy.query;
+                       }),
+        mQueryResultCopies.end());
+}
+
 vk::DynamicQueryPool *ContextVk::getQueryPool(gl::QueryType queryType)
 {
     ASSERT(queryType == gl::QueryType::AnySamples ||
@@ -4187,6 +4632,19 @@ angle::Result ContextVk::flushImpl(const vk::Semaphore *signalSemaphore)
 
     ANGLE_TRY(flushCommandsAndEndRenderPass());
 
+    if (!mQueryResultCopies.empty())
+    {
+        // Now that all the queries have ended, copy their results to where getResult can read
+        // them without a round trip through the driver.
+        uint32_t copyCount = vk::DynamicQueryPool::CopyResults(
+            &mOutsideRenderPassCommands->getCommandBuffer(), &mQueryResultCopies);
+        mQueryResultCopies.clear();
+        if (copyCount > 0)
+        {
+            mIsAnyHostVisibleBufferWritten = true;
+        }
+    }
+
     if (mIsAnyHostVisibleBufferWritten)
     {
         // Make sure all writes to host-visible buffers are flushed.  We have no way of knowing
@@ -4220,6 +4678,9 @@ angle::Result ContextVk::flushImpl(const vk::Semaphore *signalSemaphore)
     }
     mDefaultUniformStorage.releaseInFlightBuffersToResourceUseList(this);
     mStagingBuffer.releaseInFlightBuffersToResourceUseList(this);
+    mMultiDrawIndirectBuffer.releaseInFlightBuffersToResourceUseList(this);
+    mIndexConversionBuffer.releaseInFlightBuffersToResourceUseList(this);
+    mTranscodeBuffer.releaseInFlightBuffersToResourceUseList(this);
 
     ANGLE_TRY(submitFrame(signalSemaphore));
 
@@ -4484,6 +4945,7 @@ angle::Result ContextVk::onImageReleaseToExternal(const vk::ImageHelper &image)
 
 angle::Result ContextVk::beginNewRenderPass(
     const vk::Framebuffer &framebuffer,
+    const vk::FramebufferAttachmentsVector<VkImageView> &imagelessAttachmentViews,
     const gl::Rectangle &renderArea,
     const vk::RenderPassDesc &renderPassDesc,
     const vk::AttachmentOpsArray &renderPassAttachmentOps,
@@ -4494,9 +4956,10 @@ angle::Result ContextVk::beginNewRenderPass(
     // Next end any currently outstanding renderPass
     ANGLE_TRY(flushCommandsAndEndRenderPass());
 
-    mRenderPassCommands->beginRenderPass(framebuffer, renderArea, renderPassDesc,
-                                         renderPassAttachmentOps, depthStencilAttachmentIndex,
-                                         clearValues, commandBufferOut);
+    mRenderPassCommands->beginRenderPass(framebuffer, imagelessAttachmentViews, renderArea,
+                                         renderPassDesc, renderPassAttachmentOps,
+                                         depthStencilAttachmentIndex, clearValues,
+                                         commandBufferOut);
     // Restart at subpass 0.
     mGraphicsPipelineDesc->resetSubpass(&mGraphicsPipelineTransition);
 
@@ -4866,12 +5329,62 @@ void ContextVk::setDefaultUniformBlocksMinSizeForTesting(size_t minSize)
     mDefaultUniformStorage.setMinimumSizeForTesting(minSize);
 }
 
+angle::Result ContextVk::allocateIndexConversion(size_t sizeInBytes,
+                                                 uint8_t **ptrOut,
+                                                 IndexConversion *conversionOut)
+{
+    bool newBufferAllocated = false;
+    ANGLE_TRY(mIndexConversionBuffer.allocate(this, sizeInBytes, ptrOut, nullptr,
+                                              &conversionOut->offset, &newBufferAllocated));
+    if (newBufferAllocated)
+    {
+        // The previous buffer is recycled once the GPU is done with it, so the conversions it holds
+        // can no longer be used.
+        mIndexConversionSerial = mRenderer->issueIndexConversionSerial();
+    }
+
+    conversionOut->buffer = mIndexConversionBuffer.getCurrentBuffer();
+    conversionOut->serial = mIndexConversionSerial;
+    return angle::Result::Continue;
+}
+
 void ContextVk::invalidateGraphicsPipelineAndDescriptorSets()
 {
     mGraphicsDirtyBits.set(DIRTY_BIT_PIPELINE);
     mGraphicsDirtyBits.set(DIRTY_BIT_DESCRIPTOR_SETS);
 }
 
+std::shared_ptr<angle::WaitableEvent> ContextVk::postPipelineTask(
+    std::shared_ptr<angle::Closure> task)
+{
+    ASSERT(hasPipelineWorkerPool());
+
+    // Stop tracking the tasks that have already finished.
+    mPendingPipelineTasks.erase(
+        std::remove_if(mPendingPipelineTasks.begin(), mPendingPipelineTasks.end(),
+                       [](const std::shared_ptr<angle::WaitableEvent> &waitableEvent) {
+                           return waitableEvent->isReady();
+                       }),
+        mPendingPipelineTasks.end());
+
+    std::shared_ptr<angle::WaitableEvent> waitableEvent =
+        angle::WorkerThreadPool::PostWorkerTask(mPipelineWorkerPool, task);
+    if (waitableEvent)
+    {
+        mPendingPipelineTasks.push_back(waitableEvent);
+    }
+    return waitableEvent;
+}
+
+void ContextVk::waitForPipelineTasks()
+{
+    for (std::shared_ptr<angle::WaitableEvent> &waitableEvent : mPendingPipelineTasks)
+    {
+        waitableEvent->wait();
+    }
+    mPendingPipelineTasks.clear();
+}
+
 angle::Result ContextVk::initializeMultisampleTextureToBlack(const gl::Context *context,
                                                              gl::Texture *glTexture)
 {
@@ -5065,5 +5578,7 @@ void ContextVk::outputCumulativePerfCounters()
             }
         }
     }
+
+    INFO() << "Context Graphics Pipeline Creations: " << mPerfCounters.graphicsPipelineCreations;
 }
 }  // namespace rx
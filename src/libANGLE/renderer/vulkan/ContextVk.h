@@ -31,6 +31,7 @@ namespace rx
 {
 class ProgramExecutableVk;
 class RendererVk;
+struct IndexConversion;
 class WindowSurfaceVk;
 class ShareGroupVk;
 
@@ -327,10 +328,21 @@ class ContextVk : public ContextImpl, public vk::Context, public MultisampleText
     // for the next application draw/dispatch call.
     void invalidateGraphicsDescriptorSet(DescriptorSetIndex usedDescriptorSet);
     void invalidateComputeDescriptorSet(DescriptorSetIndex usedDescriptorSet);
+    // Likewise for the push constants UtilsVk records, which overwrite the current program's
+    // default uniforms if they are delivered as push constants too.
+    void invalidateDefaultUniformPushConstants();
 
     void optimizeRenderPassForPresent(VkFramebuffer framebufferHandle);
 
     vk::DynamicQueryPool *getQueryPool(gl::QueryType queryType);
+    // Queries whose results are copied to their pool's results buffer before the next submission.
+    void addQueryResultCopy(const vk::QueryResultCopy &copy)
+    {
+        mQueryResultCopies.push_back(copy);
+    }
+    // Drops the pending copies of a query that is freed before the commands are flushed.  Its slot
+    // may be reset and reused, and the copy waits for the query to become available.
+    void removeQueryResultCopies(const vk::QueryResultCopy &copy);
 
     const VkClearValue &getClearColorValue() const;
     const VkClearValue &getClearDepthStencilValue() const;
@@ -476,13 +488,15 @@ class ContextVk : public ContextImpl, public vk::Context, public MultisampleText
         return angle::Result::Continue;
     }
 
-    angle::Result beginNewRenderPass(const vk::Framebuffer &framebuffer,
-                                     const gl::Rectangle &renderArea,
-                                     const vk::RenderPassDesc &renderPassDesc,
-                                     const vk::AttachmentOpsArray &renderPassAttachmentOps,
-                                     const vk::PackedAttachmentIndex depthStencilAttachmentIndex,
-                                     const vk::PackedClearValuesArray &clearValues,
-                                     vk::CommandBuffer **commandBufferOut);
+    angle::Result beginNewRenderPass(
+        const vk::Framebuffer &framebuffer,
+        const vk::FramebufferAttachmentsVector<VkImageView> &imagelessAttachmentViews,
+        const gl::Rectangle &renderArea,
+        const vk::RenderPassDesc &renderPassDesc,
+        const vk::AttachmentOpsArray &renderPassAttachmentOps,
+        const vk::PackedAttachmentIndex depthStencilAttachmentIndex,
+        const vk::PackedClearValuesArray &clearValues,
+        vk::CommandBuffer **commandBufferOut);
 
     // Only returns true if we have a started RP and we've run setupDraw.
     bool hasStartedRenderPass() const
@@ -497,6 +511,14 @@ class ContextVk : public ContextImpl, public vk::Context, public MultisampleText
                mRenderPassCommands->getFramebufferHandle() == framebuffer->getHandle();
     }
 
+    // Like hasStartedRenderPassWithFramebuffer(), but also true if the render pass was finished
+    // and could be restored with restoreFinishedRenderPass().
+    bool isRenderPassStartedWithFramebuffer(VkFramebuffer framebufferHandle) const
+    {
+        return mRenderPassCommands->started() &&
+               mRenderPassCommands->getFramebufferHandle() == framebufferHandle;
+    }
+
     bool hasStartedRenderPassWithCommands() const
     {
         return hasStartedRenderPass() && !mRenderPassCommands->getCommandBuffer().empty();
@@ -562,6 +584,19 @@ class ContextVk : public ContextImpl, public vk::Context, public MultisampleText
     vk::BufferHelper &getEmptyBuffer() { return mEmptyBuffer; }
     vk::DynamicBuffer *getStagingBuffer() { return &mStagingBuffer; }
 
+    // Allocates converted indices that element array buffers cache.  When the conversion buffer
+    // moves on to a new buffer, the serial changes, which invalidates all the cached conversions
+    // so the previous buffers can be recycled.
+    angle::Result allocateIndexConversion(size_t sizeInBytes,
+                                          uint8_t **ptrOut,
+                                          IndexConversion *conversionOut);
+    angle::Result flushIndexConversions() { return mIndexConversionBuffer.flush(this); }
+    Serial getIndexConversionSerial() const { return mIndexConversionSerial; }
+
+    // Holds the output of compressed texture uploads decoded in compute, until it's copied to the
+    // images.
+    vk::DynamicBuffer *getTranscodeBuffer() { return &mTranscodeBuffer; }
+
     const vk::PerfCounters &getPerfCounters() const { return mPerfCounters; }
     vk::PerfCounters &getPerfCounters() { return mPerfCounters; }
 
@@ -571,6 +606,16 @@ class ContextVk : public ContextImpl, public vk::Context, public MultisampleText
     // descriptor sets it binds need to be undone.
     void invalidateGraphicsPipelineAndDescriptorSets();
 
+    // With VK_EXT_extended_dynamic_state, part of the pipeline state is recorded in the command
+    // buffer.  UtilsVk overrides it when drawing on the currently running render pass.
+    void invalidateGraphicsDynamicState() { mGraphicsDirtyBits.set(DIRTY_BIT_DYNAMIC_STATE); }
+
+    // Graphics pipelines are created on a worker thread when they are optimized in the background
+    // (asyncGraphicsPipelineOptimization) or prespecialized (prespecializeGraphicsPipelines).
+    bool hasPipelineWorkerPool() const { return mPipelineWorkerPool != nullptr; }
+    std::shared_ptr<angle::WaitableEvent> postPipelineTask(std::shared_ptr<angle::Closure> task);
+    void waitForPipelineTasks();
+
     // Implementation of MultisampleTextureInitializer
     angle::Result initializeMultisampleTextureToBlack(const gl::Context *context,
                                                       gl::Texture *glTexture) override;
@@ -582,6 +627,7 @@ class ContextVk : public ContextImpl, public vk::Context, public MultisampleText
         DIRTY_BIT_EVENT_LOG,
         DIRTY_BIT_DEFAULT_ATTRIBS,
         DIRTY_BIT_PIPELINE,
+        DIRTY_BIT_DYNAMIC_STATE,
         DIRTY_BIT_TEXTURES,
         DIRTY_BIT_VERTEX_BUFFERS,
         DIRTY_BIT_INDEX_BUFFER,
@@ -724,6 +770,36 @@ class ContextVk : public ContextImpl, public vk::Context, public MultisampleText
                                     uint32_t *numIndicesOut);
     angle::Result setupDispatch(const gl::Context *context, vk::CommandBuffer **commandBufferOut);
 
+    // ANGLE_multi_draw calls are turned into a single indirect draw when the draws don't need
+    // anything that changes between them (gl_BaseVertex and friends, streamed attributes, etc).
+    bool canMultiDrawIndirect(const gl::Context *context,
+                              gl::PrimitiveMode mode,
+                              GLsizei drawcount,
+                              bool hasBaseInstance) const;
+    bool canMultiDrawElementsIndirect(const gl::Context *context,
+                                      gl::PrimitiveMode mode,
+                                      gl::DrawElementsType type,
+                                      const GLvoid *const *indices,
+                                      GLsizei drawcount,
+                                      bool hasBaseInstance) const;
+    angle::Result multiDrawArraysIndirect(const gl::Context *context,
+                                          gl::PrimitiveMode mode,
+                                          const GLint *firsts,
+                                          const GLsizei *counts,
+                                          const GLsizei *instanceCounts,
+                                          const GLuint *baseInstances,
+                                          GLsizei drawcount);
+    angle::Result multiDrawElementsIndirect(const gl::Context *context,
+                                            gl::PrimitiveMode mode,
+                                            const GLsizei *counts,
+                                            gl::DrawElementsType type,
+                                            const GLvoid *const *indices,
+                                            const GLsizei *instanceCounts,
+                                            const GLint *baseVertices,
+                                            const GLuint *baseInstances,
+                                            GLsizei drawcount);
+    void resetDrawIDUniform(const gl::Context *context);
+
     gl::Rectangle getCorrectedViewport(const gl::Rectangle &viewport) const;
     void updateViewport(FramebufferVk *framebufferVk,
                         const gl::Rectangle &viewport,
@@ -765,6 +841,8 @@ class ContextVk : public ContextImpl, public vk::Context, public MultisampleText
                                                     vk::CommandBuffer *commandBuffer);
     angle::Result handleDirtyGraphicsPipeline(const gl::Context *context,
                                               vk::CommandBuffer *commandBuffer);
+    angle::Result handleDirtyGraphicsDynamicState(const gl::Context *context,
+                                                  vk::CommandBuffer *commandBuffer);
     angle::Result handleDirtyGraphicsTextures(const gl::Context *context,
                                               vk::CommandBuffer *commandBuffer);
     angle::Result handleDirtyGraphicsVertexBuffers(const gl::Context *context,
@@ -947,6 +1025,10 @@ class ContextVk : public ContextImpl, public vk::Context, public MultisampleText
     // at the end of the command buffer to make that write available to the host.
     bool mIsAnyHostVisibleBufferWritten;
 
+    // Query results that are yet to be copied to the results buffers of the query pools.  The
+    // copies are recorded together after the render pass is flushed, right before submission.
+    std::vector<vk::QueryResultCopy> mQueryResultCopies;
+
     // Whether this context should do seamful cube map sampling emulation.
     bool mEmulateSeamfulCubeMapSampling;
 
@@ -974,6 +1056,11 @@ class ContextVk : public ContextImpl, public vk::Context, public MultisampleText
 
     RenderPassCache mRenderPassCache;
 
+    // The tasks posted to the pool reference render passes from mRenderPassCache, so they are
+    // tracked until they finish.
+    std::shared_ptr<angle::WorkerThreadPool> mPipelineWorkerPool;
+    std::vector<std::shared_ptr<angle::WaitableEvent>> mPendingPipelineTasks;
+
     vk::CommandBufferHelper *mOutsideRenderPassCommands;
     vk::CommandBufferHelper *mRenderPassCommands;
 
@@ -1043,6 +1130,15 @@ class ContextVk : public ContextImpl, public vk::Context, public MultisampleText
     // All staging buffer support is provided by a DynamicBuffer.
     vk::DynamicBuffer mStagingBuffer;
 
+    // Indirect draw commands generated for ANGLE_multi_draw calls.
+    vk::DynamicBuffer mMultiDrawIndirectBuffer;
+
+    // Line loop and uint8 index conversions, shared by all the element array buffers.
+    vk::DynamicBuffer mIndexConversionBuffer;
+    Serial mIndexConversionSerial;
+
+    vk::DynamicBuffer mTranscodeBuffer;
+
     std::vector<std::string> mCommandBufferDiagnostics;
 
     // Record GL API calls for debuggers
@@ -9,6 +9,7 @@
 
 #include "libANGLE/renderer/vulkan/FramebufferVk.h"
 
+#include <algorithm>
 #include <array>
 
 #include "common/debug.h"
@@ -47,6 +48,11 @@ constexpr VkClearValue kUninitializedClearValue = {{{0.95, 0.05, 0.95, 0.95}}};
 // automatically convert to the actual data type.
 constexpr unsigned int kEmulatedAlphaValue = 1;
 
+// The maximum number of VkFramebuffers cached per framebuffer object.  Framebuffers that keep
+// changing attachments (such as when rendering into many textures or array layers) otherwise
+// accumulate a VkFramebuffer per combination, most of which are never used again.
+constexpr size_t kMaxFramebufferCacheSize = 32;
+
 bool HasSrcBlitFeature(RendererVk *renderer, RenderTargetVk *srcRenderTarget)
 {
     const VkFormat srcFormat = srcRenderTarget->getImageFormat().vkImageFormat;
@@ -292,6 +298,48 @@ vk::FramebufferNonResolveAttachmentMask MakeUnresolveAttachmentMask(const vk::Re
     }
     return unresolveMask;
 }
+
+// Releases the least recently used framebuffers in a framebuffer cache, down to three quarters of
+// its limit so a workload that cycles through slightly more framebuffers than the limit doesn't
+// trim on every miss.
+template <typename CacheT>
+void TrimFramebufferCache(ContextVk *contextVk, CacheT *cache)
+{
+    ASSERT(cache->size() > kMaxFramebufferCacheSize * 3 / 4);
+    const size_t trimCount = cache->size() - kMaxFramebufferCacheSize * 3 / 4;
+
+    std::vector<uint64_t> lastUses;
+    lastUses.reserve(cache->size());
+    for (const auto &entry : *cache)
+    {
+        lastUses.push_back(entry.second.getLastUse());
+    }
+
+    // Find the most recent use that is old enough to be released.  Every use gets its own count,
+    // so exactly trimCount framebuffers are released.  The released framebuffers are kept alive
+    // until the GPU is done with them, so it's fine if some were used in the commands being
+    // recorded.
+    auto oldestEnd = lastUses.begin() + (trimCount - 1);
+    std::nth_element(lastUses.begin(), oldestEnd, lastUses.end());
+    const uint64_t trimLastUse = *oldestEnd;
+
+    uint32_t evictionCount = 0;
+    for (auto iter = cache->begin(); iter != cache->end();)
+    {
+        if (iter->second.getLastUse() <= trimLastUse)
+        {
+            iter->second.release(contextVk);
+            cache->erase(iter++);
+            ++evictionCount;
+        }
+        else
+        {
+            ++iter;
+        }
+    }
+
+    contextVk->getPerfCounters().framebufferCacheEvictions += evictionCount;
+}
 }  // anonymous namespace
 
 // static
@@ -315,6 +363,7 @@ FramebufferVk::FramebufferVk(RendererVk *renderer,
       mBackbuffer(backbuffer),
       mFramebuffer(nullptr),
       mActiveColorComponentMasksForClear(0),
+      mFramebufferUseCount(0),
       mReadOnlyDepthFeedbackLoopMode(false)
 {
     mReadPixelBuffer.init(renderer, VK_BUFFER_USAGE_TRANSFER_DST_BIT, kReadPixelsBufferAlignment,
@@ -331,6 +380,12 @@ void FramebufferVk::clearCache(ContextVk *contextVk)
         tmpFB.release(contextVk);
     }
     mFramebufferCache.clear();
+
+    for (auto &entry : mImagelessFramebufferCache)
+    {
+        entry.second.release(contextVk);
+    }
+    mImagelessFramebufferCache.clear();
 }
 
 void FramebufferVk::destroy(const gl::Context *context)
@@ -1323,14 +1378,13 @@ angle::Result FramebufferVk::resolveColorWithSubpass(ContextVk *contextVk,
     //   - The draw framebuffer's ImageView will be used as the resolve attachment, so pass it along
     //   in case vkCreateFramebuffer() needs to be called to create a new vkFramebuffer with the new
     //   resolve attachment.
-    RenderTargetVk *drawRenderTarget      = mRenderTargetCache.getColors()[drawColorIndexGL];
-    const vk::ImageView *resolveImageView = nullptr;
-    ANGLE_TRY(drawRenderTarget->getImageView(contextVk, &resolveImageView));
+    RenderTargetVk *drawRenderTarget   = mRenderTargetCache.getColors()[drawColorIndexGL];
     vk::Framebuffer *newSrcFramebuffer = nullptr;
-    ANGLE_TRY(srcFramebufferVk->getFramebuffer(contextVk, &newSrcFramebuffer, resolveImageView));
+    ANGLE_TRY(srcFramebufferVk->getFramebuffer(contextVk, &newSrcFramebuffer, drawRenderTarget));
     // 2. Update the CommandBufferHelper with the new framebuffer and render pass
     vk::CommandBufferHelper &commandBufferHelper = contextVk->getStartedRenderPassCommands();
     commandBufferHelper.updateRenderPassForResolve(newSrcFramebuffer,
+                                                   srcFramebufferVk->getImagelessAttachmentViews(),
                                                    srcFramebufferVk->getRenderPassDesc());
 
     // End the render pass now since we don't (yet) support subpass dependencies.
@@ -1754,7 +1808,7 @@ angle::Result FramebufferVk::syncState(const gl::Context *context,
         return angle::Result::Continue;
     }
 
-    if (command != gl::Command::Blit)
+    if (command != gl::Command::Blit || isRenderPassUsingImagelessFramebuffer(contextVk))
     {
         // Don't end the render pass when handling a blit to resolve, since we may be able to
         // optimize that path which requires modifying the current render pass.
@@ -1829,11 +1883,12 @@ void FramebufferVk::updateRenderPassDesc()
 
 angle::Result FramebufferVk::getFramebuffer(ContextVk *contextVk,
                                             vk::Framebuffer **framebufferOut,
-                                            const vk::ImageView *resolveImageViewIn)
+                                            const RenderTargetVk *resolveRenderTargetIn)
 {
     // First return a presently valid Framebuffer
     if (mFramebuffer != nullptr)
     {
+        mFramebuffer->setLastUse(++mFramebufferUseCount);
         *framebufferOut = &mFramebuffer->getFramebuffer();
         return angle::Result::Continue;
     }
@@ -1843,7 +1898,10 @@ angle::Result FramebufferVk::getFramebuffer(ContextVk *contextVk,
     {
         if (contextVk->getRenderer()->getFeatures().enableFramebufferVkCache.enabled)
         {
-            *framebufferOut = &iter->second.getFramebuffer();
+            mFramebuffer = &iter->second;
+            mFramebuffer->setLastUse(++mFramebufferUseCount);
+            mImagelessAttachmentViews.clear();
+            *framebufferOut = &mFramebuffer->getFramebuffer();
             return angle::Result::Continue;
         }
         else
@@ -1859,11 +1917,15 @@ angle::Result FramebufferVk::getFramebuffer(ContextVk *contextVk,
     // If we've a Framebuffer provided by a Surface (default FBO/backbuffer), query it.
     if (mBackbuffer)
     {
+        mImagelessAttachmentViews.clear();
         return mBackbuffer->getCurrentFramebuffer(contextVk, *compatibleRenderPass, framebufferOut);
     }
 
-    // Gather VkImageViews over all FBO attachments, also size of attached region.
-    std::vector<VkImageView> attachments;
+    // Gather VkImageViews over all FBO attachments, also size of attached region.  The images and
+    // sizes of the attachments are gathered as well in case an imageless framebuffer is used.
+    vk::FramebufferAttachmentsVector<VkImageView> attachments;
+    vk::FramebufferAttachmentsVector<const vk::ImageHelper *> attachmentImages;
+    vk::FramebufferAttachmentsVector<gl::Extents> attachmentSizes;
     gl::Extents attachmentsSize;
 
     // Color attachments.
@@ -1877,6 +1939,8 @@ angle::Result FramebufferVk::getFramebuffer(ContextVk *contextVk,
         ANGLE_TRY(colorRenderTarget->getImageView(contextVk, &imageView));
 
         attachments.push_back(imageView->getHandle());
+        attachmentImages.push_back(&colorRenderTarget->getImageForRenderPass());
+        attachmentSizes.push_back(colorRenderTarget->getExtents());
 
         ASSERT(attachmentsSize.empty() || attachmentsSize == colorRenderTarget->getExtents());
         attachmentsSize = colorRenderTarget->getExtents();
@@ -1890,6 +1954,8 @@ angle::Result FramebufferVk::getFramebuffer(ContextVk *contextVk,
         ANGLE_TRY(depthStencilRenderTarget->getImageView(contextVk, &imageView));
 
         attachments.push_back(imageView->getHandle());
+        attachmentImages.push_back(&depthStencilRenderTarget->getImageForRenderPass());
+        attachmentSizes.push_back(depthStencilRenderTarget->getExtents());
 
         ASSERT(attachmentsSize.empty() ||
                attachmentsSize == depthStencilRenderTarget->getExtents());
@@ -1897,13 +1963,18 @@ angle::Result FramebufferVk::getFramebuffer(ContextVk *contextVk,
     }
 
     // Color resolve attachments.
-    if (resolveImageViewIn)
+    if (resolveRenderTargetIn)
     {
         ASSERT(!HasResolveAttachment(colorRenderTargets, mState.getEnabledDrawBuffers()));
 
-        // Need to use the passed in ImageView for the resolve attachment, since it came from
-        // another Framebuffer.
-        attachments.push_back(resolveImageViewIn->getHandle());
+        // Need to use the passed in render target's ImageView for the resolve attachment, since it
+        // came from another Framebuffer.
+        const vk::ImageView *resolveImageView = nullptr;
+        ANGLE_TRY(resolveRenderTargetIn->getImageView(contextVk, &resolveImageView));
+
+        attachments.push_back(resolveImageView->getHandle());
+        attachmentImages.push_back(&resolveRenderTargetIn->getImageForRenderPass());
+        attachmentSizes.push_back(resolveRenderTargetIn->getExtents());
     }
     else
     {
@@ -1919,6 +1990,8 @@ angle::Result FramebufferVk::getFramebuffer(ContextVk *contextVk,
                 ANGLE_TRY(colorRenderTarget->getResolveImageView(contextVk, &resolveImageView));
 
                 attachments.push_back(resolveImageView->getHandle());
+                attachmentImages.push_back(&colorRenderTarget->getResolveImageForRenderPass());
+                attachmentSizes.push_back(colorRenderTarget->getExtents());
 
                 ASSERT(!attachmentsSize.empty());
             }
@@ -1932,6 +2005,8 @@ angle::Result FramebufferVk::getFramebuffer(ContextVk *contextVk,
         ANGLE_TRY(depthStencilRenderTarget->getResolveImageView(contextVk, &imageView));
 
         attachments.push_back(imageView->getHandle());
+        attachmentImages.push_back(&depthStencilRenderTarget->getResolveImageForRenderPass());
+        attachmentSizes.push_back(depthStencilRenderTarget->getExtents());
 
         ASSERT(!attachmentsSize.empty());
     }
@@ -1943,6 +2018,27 @@ angle::Result FramebufferVk::getFramebuffer(ContextVk *contextVk,
         attachmentsSize.width  = mState.getDefaultWidth();
         attachmentsSize.depth  = 0;
     }
+
+    // Check that our description matches our attachments. Can catch implementation bugs.
+    ASSERT(static_cast<uint32_t>(attachments.size()) == mCurrentFramebufferDesc.attachmentCount());
+
+    // Imageless framebuffers can only be used if the creation parameters of all attachments are
+    // known.
+    bool useImagelessFramebuffer =
+        contextVk->getRenderer()->getFeatures().supportsImagelessFramebuffer.enabled;
+    for (const vk::ImageHelper *image : attachmentImages)
+    {
+        useImagelessFramebuffer = useImagelessFramebuffer && image->hasKnownCreateInfo();
+    }
+
+    if (useImagelessFramebuffer)
+    {
+        ANGLE_TRY(getImagelessFramebuffer(contextVk, *compatibleRenderPass, attachmentsSize,
+                                          attachmentImages, attachmentSizes, framebufferOut));
+        mImagelessAttachmentViews = attachments;
+        return angle::Result::Continue;
+    }
+
     VkFramebufferCreateInfo framebufferInfo = {};
 
     framebufferInfo.sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
@@ -1957,12 +2053,107 @@ angle::Result FramebufferVk::getFramebuffer(ContextVk *contextVk,
     vk::FramebufferHelper newFramebuffer;
     ANGLE_TRY(newFramebuffer.init(contextVk, framebufferInfo));
 
-    // Check that our description matches our attachments. Can catch implementation bugs.
-    ASSERT(static_cast<uint32_t>(attachments.size()) == mCurrentFramebufferDesc.attachmentCount());
+    // Make room before inserting so the new framebuffer is never a candidate for release.
+    if (mFramebufferCache.size() >= kMaxFramebufferCacheSize)
+    {
+        TrimFramebufferCache(contextVk, &mFramebufferCache);
+    }
 
+    newFramebuffer.setLastUse(++mFramebufferUseCount);
     mFramebufferCache[mCurrentFramebufferDesc] = std::move(newFramebuffer);
     mFramebuffer                               = &mFramebufferCache[mCurrentFramebufferDesc];
     *framebufferOut                            = &mFramebuffer->getFramebuffer();
+    mImagelessAttachmentViews.clear();
+    return angle::Result::Continue;
+}
+
+bool FramebufferVk::isRenderPassUsingImagelessFramebuffer(ContextVk *contextVk) const
+{
+    // Imageless framebuffers are reused when the attachments change, so a render pass that was
+    // started with the previous attachments could otherwise be mistaken for one that uses the new
+    // ones.
+    for (const auto &entry : mImagelessFramebufferCache)
+    {
+        VkFramebuffer framebufferHandle = entry.second.getFramebuffer().getHandle();
+        if (contextVk->isRenderPassStartedWithFramebuffer(framebufferHandle))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+angle::Result FramebufferVk::getImagelessFramebuffer(
+    ContextVk *contextVk,
+    const vk::RenderPass &compatibleRenderPass,
+    const gl::Extents &framebufferSize,
+    const vk::FramebufferAttachmentsVector<const vk::ImageHelper *> &attachmentImages,
+    const vk::FramebufferAttachmentsVector<gl::Extents> &attachmentSizes,
+    vk::Framebuffer **framebufferOut)
+{
+    ASSERT(attachmentImages.size() == attachmentSizes.size());
+
+    // Describe the attachments without referencing their image views.
+    vk::ImagelessFramebufferDesc desc;
+    desc.reset(mRenderPassDesc, static_cast<uint32_t>(framebufferSize.width),
+               static_cast<uint32_t>(framebufferSize.height));
+
+    vk::FramebufferAttachmentsVector<VkFramebufferAttachmentImageInfoKHR> attachmentInfos;
+    for (size_t attachmentIndex = 0; attachmentIndex < attachmentImages.size(); ++attachmentIndex)
+    {
+        const vk::ImageHelper *image        = attachmentImages[attachmentIndex];
+        const gl::Extents &attachmentSize   = attachmentSizes[attachmentIndex];
+        const vk::ImageViewFormats &formats = image->getViewFormats();
+
+        VkFramebufferAttachmentImageInfoKHR attachmentInfo = {};
+        attachmentInfo.sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_ATTACHMENT_IMAGE_INFO_KHR;
+        attachmentInfo.flags           = image->getCreateFlags();
+        attachmentInfo.usage           = image->getUsage();
+        attachmentInfo.width           = static_cast<uint32_t>(attachmentSize.width);
+        attachmentInfo.height          = static_cast<uint32_t>(attachmentSize.height);
+        attachmentInfo.layerCount      = 1;
+        attachmentInfo.viewFormatCount = static_cast<uint32_t>(formats.size());
+        attachmentInfo.pViewFormats    = formats.data();
+
+        desc.addAttachment(attachmentInfo);
+        attachmentInfos.push_back(attachmentInfo);
+    }
+
+    auto iter = mImagelessFramebufferCache.find(desc);
+    if (iter == mImagelessFramebufferCache.end())
+    {
+        VkFramebufferAttachmentsCreateInfoKHR attachmentsCreateInfo = {};
+        attachmentsCreateInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_ATTACHMENTS_CREATE_INFO_KHR;
+        attachmentsCreateInfo.attachmentImageInfoCount =
+            static_cast<uint32_t>(attachmentInfos.size());
+        attachmentsCreateInfo.pAttachmentImageInfos = attachmentInfos.data();
+
+        VkFramebufferCreateInfo framebufferInfo = {};
+        framebufferInfo.sType                   = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferInfo.pNext                   = &attachmentsCreateInfo;
+        framebufferInfo.flags                   = VK_FRAMEBUFFER_CREATE_IMAGELESS_BIT_KHR;
+        framebufferInfo.renderPass              = compatibleRenderPass.getHandle();
+        framebufferInfo.attachmentCount         = static_cast<uint32_t>(attachmentInfos.size());
+        framebufferInfo.pAttachments            = nullptr;
+        framebufferInfo.width                   = static_cast<uint32_t>(framebufferSize.width);
+        framebufferInfo.height                  = static_cast<uint32_t>(framebufferSize.height);
+        framebufferInfo.layers                  = 1;
+
+        vk::FramebufferHelper newFramebuffer;
+        ANGLE_TRY(newFramebuffer.init(contextVk, framebufferInfo));
+
+        // Make room before inserting so the new framebuffer is never a candidate for release.
+        if (mImagelessFramebufferCache.size() >= kMaxFramebufferCacheSize)
+        {
+            TrimFramebufferCache(contextVk, &mImagelessFramebufferCache);
+        }
+
+        iter = mImagelessFramebufferCache.emplace(desc, std::move(newFramebuffer)).first;
+    }
+
+    mFramebuffer = &iter->second;
+    mFramebuffer->setLastUse(++mFramebufferUseCount);
+    *framebufferOut = &mFramebuffer->getFramebuffer();
     return angle::Result::Continue;
 }
 
@@ -2452,9 +2643,10 @@ angle::Result FramebufferVk::startNewRenderPass(ContextVk *contextVk,
         renderArea = getRotatedCompleteRenderArea(contextVk);
     }
 
-    ANGLE_TRY(contextVk->beginNewRenderPass(*framebuffer, renderArea, mRenderPassDesc,
-                                            renderPassAttachmentOps, depthStencilAttachmentIndex,
-                                            packedClearValues, commandBufferOut));
+    ANGLE_TRY(contextVk->beginNewRenderPass(*framebuffer, mImagelessAttachmentViews, renderArea,
+                                            mRenderPassDesc, renderPassAttachmentOps,
+                                            depthStencilAttachmentIndex, packedClearValues,
+                                            commandBufferOut));
 
     // Transition the images to the correct layout (through onColorDraw).
     for (size_t colorIndexGL : mState.getColorAttachmentsMask())
@@ -126,7 +126,13 @@ class FramebufferVk : public FramebufferImpl
 
     angle::Result getFramebuffer(ContextVk *contextVk,
                                  vk::Framebuffer **framebufferOut,
-                                 const vk::ImageView *resolveImageViewIn);
+                                 const RenderTargetVk *resolveRenderTargetIn);
+    // If the framebuffer returned by getFramebuffer() is imageless, these are its attachments.
+    // Otherwise, this is empty.
+    const vk::FramebufferAttachmentsVector<VkImageView> &getImagelessAttachmentViews() const
+    {
+        return mImagelessAttachmentViews;
+    }
 
     bool hasDeferredClears() const { return !mDeferredClears.empty(); }
     angle::Result flushDeferredClears(ContextVk *contextVk);
@@ -202,6 +208,14 @@ class FramebufferVk : public FramebufferImpl
                                  const gl::Rectangle &invalidateArea);
     // Release all FramebufferVk objects in the cache and clear cache
     void clearCache(ContextVk *contextVk);
+    bool isRenderPassUsingImagelessFramebuffer(ContextVk *contextVk) const;
+    angle::Result getImagelessFramebuffer(
+        ContextVk *contextVk,
+        const vk::RenderPass &compatibleRenderPass,
+        const gl::Extents &framebufferSize,
+        const vk::FramebufferAttachmentsVector<const vk::ImageHelper *> &attachmentImages,
+        const vk::FramebufferAttachmentsVector<gl::Extents> &attachmentSizes,
+        vk::Framebuffer **framebufferOut);
     angle::Result updateDepthStencilAttachment(const gl::Context *context, bool deferClears);
     void updateDepthStencilAttachmentSerial(ContextVk *contextVk);
 
@@ -235,6 +249,12 @@ class FramebufferVk : public FramebufferImpl
 
     vk::FramebufferDesc mCurrentFramebufferDesc;
     angle::HashMap<vk::FramebufferDesc, vk::FramebufferHelper> mFramebufferCache;
+    // When VK_KHR_imageless_framebuffer is supported, framebuffers are instead cached by the
+    // attachments' properties, and the image views are provided when the render pass begins.
+    angle::HashMap<vk::ImagelessFramebufferDesc, vk::FramebufferHelper> mImagelessFramebufferCache;
+    vk::FramebufferAttachmentsVector<VkImageView> mImagelessAttachmentViews;
+    // Incremented every time a cached framebuffer is used, to order them for eviction.
+    uint64_t mFramebufferUseCount;
 
     vk::ClearValuesArray mDeferredClears;
 
@@ -8,8 +8,11 @@
 
 #include "libANGLE/renderer/vulkan/GlslangWrapperVk.h"
 
+#include <spirv-tools/optimizer.hpp>
+
 #include "libANGLE/renderer/vulkan/ContextVk.h"
 #include "libANGLE/renderer/vulkan/vk_cache_utils.h"
+#include "libANGLE/trace.h"
 
 namespace rx
 {
@@ -98,6 +101,55 @@ angle::Result GlslangWrapperVk::TransformSpirV(
         shaderCodeOut);
 }
 
+// static
+bool GlslangWrapperVk::OptimizeSpirv(const SpirvBlob &spirvBlob, SpirvBlob *spirvBlobOut)
+{
+    ANGLE_TRACE_EVENT0("gpu.angle", "GlslangWrapperVk::OptimizeSpirv");
+
+    spvtools::Optimizer optimizer(SPV_ENV_VULKAN_1_1);
+
+    // Inline everything first so the remaining passes see whole shaders.  OpKill can't be inlined
+    // into a continue construct, so it's wrapped in a function of its own first.
+    optimizer.RegisterPass(spvtools::CreateWrapOpKillPass())
+        .RegisterPass(spvtools::CreateMergeReturnPass())
+        .RegisterPass(spvtools::CreateInlineExhaustivePass())
+        .RegisterPass(spvtools::CreateEliminateDeadFunctionsPass())
+        // Promote function-local variables to SSA values.
+        .RegisterPass(spvtools::CreatePrivateToLocalPass())
+        .RegisterPass(spvtools::CreateLocalSingleBlockLoadStoreElimPass())
+        .RegisterPass(spvtools::CreateLocalSingleStoreElimPass())
+        .RegisterPass(spvtools::CreateScalarReplacementPass())
+        .RegisterPass(spvtools::CreateLocalMultiStoreElimPass())
+        // Fold constants and remove the code that becomes dead as a result.
+        .RegisterPass(spvtools::CreateCCPPass())
+        .RegisterPass(spvtools::CreateFoldSpecConstantOpAndCompositePass())
+        .RegisterPass(spvtools::CreateDeadBranchElimPass())
+        .RegisterPass(spvtools::CreateAggressiveDCEPass())
+        .RegisterPass(spvtools::CreateBlockMergePass())
+        .RegisterPass(spvtools::CreateRedundancyEliminationPass())
+        .RegisterPass(spvtools::CreateCFGCleanupPass())
+        // Drop global variables, such as unused inputs and outputs, that no longer have any users.
+        .RegisterPass(spvtools::CreateDeadVariableEliminationPass())
+        .RegisterPass(spvtools::CreateAggressiveDCEPass());
+
+    // The descriptor set layouts and the transformation done per program permutation rely on
+    // every resource keeping its binding and on specialization constants staying in the module.
+    // The shader was validated after compilation already, so don't pay for it a second time.
+    spvtools::OptimizerOptions options;
+    options.set_run_validator(false);
+    options.set_preserve_bindings(true);
+    options.set_preserve_spec_constants(true);
+
+    SpirvBlob optimized;
+    if (!optimizer.Run(spirvBlob.data(), spirvBlob.size(), &optimized, options))
+    {
+        return false;
+    }
+
+    *spirvBlobOut = std::move(optimized);
+    return true;
+}
+
 // static
 angle::Result GlslangWrapperVk::CompileShaderOneOff(vk::Context *context,
                                                     gl::ShaderType shaderType,
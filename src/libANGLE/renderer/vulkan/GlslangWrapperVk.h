@@ -50,6 +50,12 @@ class GlslangWrapperVk
                                         const SpirvBlob &initialSpirvBlob,
                                         SpirvBlob *shaderCodeOut);
 
+    // Runs a curated list of spirv-opt passes over the SPIR-V of a linked shader stage.  Bindings
+    // and specialization constants are preserved, so the result can go through TransformSpirV just
+    // like the original.  Doesn't touch any context state, so it may be called from a worker
+    // thread.  Returns false if the optimizer failed, leaving |spirvBlobOut| untouched.
+    static bool OptimizeSpirv(const SpirvBlob &spirvBlob, SpirvBlob *spirvBlobOut);
+
     static angle::Result CompileShaderOneOff(vk::Context *context,
                                              gl::ShaderType shaderType,
                                              const std::string &shaderSource,
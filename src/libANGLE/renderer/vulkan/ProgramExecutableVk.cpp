@@ -18,6 +18,7 @@
 #include "libANGLE/renderer/vulkan/TransformFeedbackVk.h"
 #include "libANGLE/renderer/vulkan/vk_helpers.h"
 #include "libANGLE/renderer/vulkan/vk_utils.h"
+#include "libANGLE/trace.h"
 
 namespace rx
 {
@@ -43,7 +44,10 @@ bool ValidateTransformedSpirV(ContextVk *contextVk,
 }
 }  // namespace
 
-DefaultUniformBlock::DefaultUniformBlock() = default;
+DefaultUniformBlock::DefaultUniformBlock()
+{
+    dirtyRange.invalidate();
+}
 
 DefaultUniformBlock::~DefaultUniformBlock() = default;
 
@@ -169,6 +173,14 @@ ProgramExecutableVk::~ProgramExecutableVk()
 
 void ProgramExecutableVk::reset(ContextVk *contextVk)
 {
+    // Release the pipelines first.  This waits for the pipelines still being created on worker
+    // threads, which use the pipeline layout.
+    for (ProgramInfo &programInfo : mGraphicsProgramInfos)
+    {
+        programInfo.release(contextVk);
+    }
+    mComputeProgramInfo.release(contextVk);
+
     for (auto &descriptorSetLayout : mDescriptorSetLayouts)
     {
         descriptorSetLayout.reset();
@@ -179,6 +191,8 @@ void ProgramExecutableVk::reset(ContextVk *contextVk)
     mEmptyDescriptorSets.fill(VK_NULL_HANDLE);
     mNumDefaultUniformDescriptors = 0;
     mTransformOptions             = {};
+    mUsedGraphicsProgramInfos.reset();
+    mDefaultUniformPushConstantStages.reset();
 
     for (vk::RefCountedDescriptorPoolBinding &binding : mDescriptorPoolBindings)
     {
@@ -196,12 +210,6 @@ void ProgramExecutableVk::reset(ContextVk *contextVk)
     // Initialize with a unique BufferSerial
     vk::ResourceSerialFactory &factory = contextVk->getRenderer()->getResourceSerialFactory();
     mCurrentDefaultUniformBufferSerial = factory.generateBufferSerial();
-
-    for (ProgramInfo &programInfo : mGraphicsProgramInfos)
-    {
-        programInfo.release(contextVk);
-    }
-    mComputeProgramInfo.release(contextVk);
 }
 
 std::unique_ptr<rx::LinkEvent> ProgramExecutableVk::load(gl::BinaryInputStream *stream)
@@ -231,6 +239,7 @@ std::unique_ptr<rx::LinkEvent> ProgramExecutableVk::load(gl::BinaryInputStream *
             info->varyingIsOutput         = stream->readBool();
             info->attributeComponentCount = stream->readInt<uint8_t>();
             info->attributeLocationCount  = stream->readInt<uint8_t>();
+            info->pushConstantOffset      = stream->readInt<uint32_t>();
         }
     }
 
@@ -259,6 +268,7 @@ void ProgramExecutableVk::save(gl::BinaryOutputStream *stream)
             stream->writeBool(it.second.varyingIsOutput);
             stream->writeInt(it.second.attributeComponentCount);
             stream->writeInt(it.second.attributeLocationCount);
+            stream->writeInt(it.second.pushConstantOffset);
         }
     }
 }
@@ -682,12 +692,91 @@ angle::Result ProgramExecutableVk::getGraphicsPipeline(
     vk::ShaderProgramHelper *shaderProgram = programInfo.getShaderProgram();
     ASSERT(shaderProgram);
     ANGLE_TRY(renderer->getPipelineCache(&pipelineCache));
+
+    // Prespecialize before looking up the pipeline of this draw, so that if it is one of the
+    // prespecialized ones it's created on a worker along with the others and the draw only waits
+    // for it.
+    const uint8_t programInfoIndex =
+        gl::bitCast<uint8_t, ProgramTransformOptions>(mTransformOptions);
+    if (!mUsedGraphicsProgramInfos.test(programInfoIndex))
+    {
+        mUsedGraphicsProgramInfos.set(programInfoIndex);
+
+        if (contextVk->getFeatures().prespecializeGraphicsPipelines.enabled &&
+            contextVk->hasPipelineWorkerPool())
+        {
+            ANGLE_TRY(prespecializeGraphicsPipelines(contextVk, *pipelineCache, desc,
+                                                     activeAttribLocations));
+        }
+    }
+
     return shaderProgram->getGraphicsPipeline(
         contextVk, &contextVk->getRenderPassCache(), *pipelineCache, getPipelineLayout(), desc,
         activeAttribLocations, glState.getProgramExecutable()->getAttributesTypeMask(), descPtrOut,
         pipelineOut);
 }
 
+angle::Result ProgramExecutableVk::prespecializeGraphicsPipelines(
+    ContextVk *contextVk,
+    const vk::PipelineCache &pipelineCache,
+    const vk::GraphicsPipelineDesc &currentDesc,
+    const gl::AttributesMask &activeAttribLocations)
+{
+    // Of the permutations that only differ from the current one by their surface rotation, take
+    // the one that has been drawn with the most pipelines.
+    std::vector<vk::GraphicsPipelineDesc> descs;
+    for (uint8_t rotation = 0; rotation < ToUnderlying(SurfaceRotation::EnumCount); ++rotation)
+    {
+        ProgramTransformOptions sourceOptions = mTransformOptions;
+        sourceOptions.surfaceRotation         = rotation;
+
+        const uint8_t sourceIndex = gl::bitCast<uint8_t, ProgramTransformOptions>(sourceOptions);
+        if (rotation == mTransformOptions.surfaceRotation ||
+            !mUsedGraphicsProgramInfos.test(sourceIndex))
+        {
+            continue;
+        }
+
+        std::vector<vk::GraphicsPipelineDesc> sourceDescs;
+        mGraphicsProgramInfos[sourceIndex]
+            .getShaderProgram()
+            ->getGraphicsPipelineCache()
+            .getUsedPipelineDescs(&sourceDescs);
+        if (sourceDescs.size() > descs.size())
+        {
+            descs = std::move(sourceDescs);
+        }
+    }
+
+    if (descs.empty())
+    {
+        return angle::Result::Continue;
+    }
+
+    ANGLE_TRACE_EVENT0("gpu.angle", "ProgramExecutableVk::prespecializeGraphicsPipelines");
+
+    const gl::ComponentTypeMask &programAttribsTypeMask =
+        contextVk->getState().getProgramExecutable()->getAttributesTypeMask();
+    vk::ShaderProgramHelper *shaderProgram =
+        getGraphicsProgramInfo(mTransformOptions).getShaderProgram();
+
+    for (vk::GraphicsPipelineDesc &desc : descs)
+    {
+        // The viewport is rotated along with the surface, so it's taken from the current draw as
+        // well. Descs that only differed by their viewport become identical, which the cache
+        // handles.
+        vk::GraphicsPipelineTransitionBits transition;
+        desc.updateSurfaceRotation(&transition, currentDesc.getSurfaceRotation());
+        desc.updateViewport(&transition, currentDesc.getViewport());
+
+        ANGLE_TRY(shaderProgram->prespecializeGraphicsPipeline(
+            contextVk, &contextVk->getRenderPassCache(), pipelineCache, getPipelineLayout(), desc,
+            activeAttribLocations, programAttribsTypeMask));
+    }
+
+    return angle::Result::Continue;
+}
+
 angle::Result ProgramExecutableVk::getComputePipeline(ContextVk *contextVk,
                                                       vk::PipelineAndSerial **pipelineOut)
 {
@@ -770,6 +859,7 @@ angle::Result ProgramExecutableVk::createPipelineLayout(
     // don't already exist in the cache.
 
     // Default uniforms and transform feedback:
+    vk::PipelineLayoutDesc pipelineLayoutDesc;
     vk::DescriptorSetLayoutDesc uniformsAndXfbSetDesc;
     mNumDefaultUniformDescriptors = 0;
     for (const gl::ShaderType shaderType : linkedShaderStages)
@@ -781,6 +871,20 @@ angle::Result ProgramExecutableVk::createPipelineLayout(
             continue;
         }
 
+        // Only ProgramVk assigns push constants to default uniforms.  Program pipelines always use
+        // the default uniform buffer.
+        if (info.pushConstantOffset != ShaderInterfaceVariableInfo::kInvalid)
+        {
+            ASSERT(mProgram);
+            const DefaultUniformBlock &block = mProgram->getDefaultUniformBlocks()[shaderType];
+            pipelineLayoutDesc.updatePushConstantRange(
+                shaderType, info.pushConstantOffset,
+                static_cast<uint32_t>(block.uniformData.size()));
+            mDefaultUniformPushConstantStages.set(shaderType);
+            mDefaultUniformPushConstantOffsets[shaderType] = info.pushConstantOffset;
+            continue;
+        }
+
         uniformsAndXfbSetDesc.update(info.binding, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1,
                                      gl_vk::kShaderStageMap[shaderType], nullptr);
         mNumDefaultUniformDescriptors++;
@@ -857,7 +961,6 @@ angle::Result ProgramExecutableVk::createPipelineLayout(
         &mDescriptorSetLayouts[ToUnderlying(DescriptorSetIndex::DriverUniforms)]));
 
     // Create pipeline layout with these 4 descriptor sets.
-    vk::PipelineLayoutDesc pipelineLayoutDesc;
     pipelineLayoutDesc.updateDescriptorSetLayout(DescriptorSetIndex::UniformsAndXfb,
                                                  uniformsAndXfbSetDesc);
     pipelineLayoutDesc.updateDescriptorSetLayout(DescriptorSetIndex::ShaderResource,
@@ -930,7 +1033,7 @@ void ProgramExecutableVk::updateDefaultUniformsDescriptorSet(
 {
     const std::string uniformBlockName = kDefaultUniformNames[shaderType];
     ShaderInterfaceVariableInfo &info  = mVariableInfoMap[shaderType][uniformBlockName];
-    if (!info.activeStages[shaderType])
+    if (!info.activeStages[shaderType] || mDefaultUniformPushConstantStages[shaderType])
     {
         return;
     }
@@ -1641,9 +1744,53 @@ angle::Result ProgramExecutableVk::updateDescriptorSets(ContextVk *contextVk,
                                           mDynamicBufferOffsets.data());
     }
 
+    // Push constants don't survive a command buffer change either, so they are recorded every time
+    // the descriptor sets are bound.
+    pushDefaultUniformConstants(commandBuffer);
+
     return angle::Result::Continue;
 }
 
+void ProgramExecutableVk::pushDefaultUniformConstants(vk::CommandBuffer *commandBuffer)
+{
+    if (mDefaultUniformPushConstantStages.none())
+    {
+        return;
+    }
+
+    ASSERT(mProgram);
+    const gl::ShaderMap<DefaultUniformBlock> &defaultUniformBlocks =
+        mProgram->getDefaultUniformBlocks();
+
+    for (const gl::ShaderType shaderType : mDefaultUniformPushConstantStages)
+    {
+        const angle::MemoryBuffer &uniformData = defaultUniformBlocks[shaderType].uniformData;
+        commandBuffer->pushConstants(getPipelineLayout(), gl_vk::kShaderStageMap[shaderType],
+                                     mDefaultUniformPushConstantOffsets[shaderType],
+                                     static_cast<uint32_t>(uniformData.size()), uniformData.data());
+    }
+}
+
+void ProgramExecutableVk::pushDefaultUniformConstantsRange(
+    vk::CommandBuffer *commandBuffer,
+    gl::ShaderType shaderType,
+    const DefaultUniformBlock &defaultUniformBlock)
+{
+    ASSERT(mDefaultUniformPushConstantStages[shaderType]);
+
+    // Only the bytes that changed since the block was last pushed are recorded.  The rest of the
+    // push constant range keeps its previous contents.
+    const gl::RangeUI &dirtyRange = defaultUniformBlock.dirtyRange;
+    ASSERT(!dirtyRange.empty());
+    ASSERT(dirtyRange.high() <= defaultUniformBlock.uniformData.size());
+    ASSERT(dirtyRange.low() % 4 == 0 && dirtyRange.length() % 4 == 0);
+
+    commandBuffer->pushConstants(getPipelineLayout(), gl_vk::kShaderStageMap[shaderType],
+                                 mDefaultUniformPushConstantOffsets[shaderType] + dirtyRange.low(),
+                                 dirtyRange.length(),
+                                 defaultUniformBlock.uniformData.data() + dirtyRange.low());
+}
+
 // Requires that trace is enabled to see the output, which is supported with is_debug=true
 void ProgramExecutableVk::outputCumulativePerfCounters()
 {
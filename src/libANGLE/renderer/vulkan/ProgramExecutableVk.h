@@ -38,6 +38,7 @@ class ShaderInfo final : angle::NonCopyable
     ANGLE_INLINE bool valid() const { return mIsInitialized; }
 
     const gl::ShaderMap<SpirvBlob> &getSpirvBlobs() const { return mSpirvBlobs; }
+    gl::ShaderMap<SpirvBlob> &getSpirvBlobs() { return mSpirvBlobs; }
 
     // Save and load implementation for GLES Program Binary support.
     void load(gl::BinaryInputStream *stream);
@@ -96,6 +97,10 @@ struct DefaultUniformBlock final : private angle::NonCopyable
     // Since the default blocks are laid out in std140, this tells us where to write on a call
     // to a setUniform method. They are arranged in uniform location order.
     std::vector<sh::BlockMemberInfo> uniformLayout;
+
+    // The bytes of uniformData that changed since the block was last uploaded.  Calls that write
+    // the values already in the shadow copy leave it untouched.
+    gl::RangeUI dirtyRange;
 };
 
 class ProgramExecutableVk
@@ -132,6 +137,12 @@ class ProgramExecutableVk
     {
         return mCurrentDefaultUniformBufferSerial;
     }
+    // Stages whose default uniform block is delivered through push constants rather than the
+    // default uniform buffer.
+    gl::ShaderBitSet getDefaultUniformPushConstantStages() const
+    {
+        return mDefaultUniformPushConstantStages;
+    }
 
     angle::Result getGraphicsPipeline(ContextVk *contextVk,
                                       gl::PrimitiveMode mode,
@@ -215,6 +226,10 @@ class ProgramExecutableVk
                                             const DefaultUniformBlock &defaultUniformBlock,
                                             vk::BufferHelper *defaultUniformBuffer,
                                             ContextVk *contextVk);
+    void pushDefaultUniformConstants(vk::CommandBuffer *commandBuffer);
+    void pushDefaultUniformConstantsRange(vk::CommandBuffer *commandBuffer,
+                                          gl::ShaderType shaderType,
+                                          const DefaultUniformBlock &defaultUniformBlock);
     void updateTransformFeedbackDescriptorSetImpl(const gl::ProgramState &programState,
                                                   ContextVk *contextVk);
     angle::Result updateBuffersDescriptorSet(ContextVk *contextVk,
@@ -237,6 +252,11 @@ class ProgramExecutableVk
                                              DescriptorSetIndex descriptorSetIndex,
                                              VkDescriptorSetLayout descriptorSetLayout);
 
+    angle::Result prespecializeGraphicsPipelines(ContextVk *contextVk,
+                                                 const vk::PipelineCache &pipelineCache,
+                                                 const vk::GraphicsPipelineDesc &currentDesc,
+                                                 const gl::AttributesMask &activeAttribLocations);
+
     void outputCumulativePerfCounters();
 
     // Descriptor sets for uniform blocks and textures for this program.
@@ -245,6 +265,11 @@ class ProgramExecutableVk
     size_t mNumDefaultUniformDescriptors;
     vk::BufferSerial mCurrentDefaultUniformBufferSerial;
 
+    // Default uniform blocks small enough to be pushed as constants, and where each stage's block
+    // is placed in the push constant range.
+    gl::ShaderBitSet mDefaultUniformPushConstantStages;
+    gl::ShaderMap<uint32_t> mDefaultUniformPushConstantOffsets;
+
     angle::HashMap<vk::UniformsAndXfbDesc, VkDescriptorSet> mUniformsAndXfbDescriptorSetCache;
     angle::HashMap<vk::TextureDescriptorDesc, VkDescriptorSet> mTextureDescriptorsCache;
 
@@ -275,6 +300,11 @@ class ProgramExecutableVk
 
     ProgramTransformOptions mTransformOptions;
 
+    // The permutations of mGraphicsProgramInfos that have been drawn with.  A program that is
+    // drawn with a new surface rotation is likely to be drawn with the same pipeline states as
+    // before the rotation, so those are prespecialized for the new rotation.
+    angle::BitSet32<ProgramTransformOptions::kPermutationCount> mUsedGraphicsProgramInfos;
+
     ProgramVk *mProgram;
     ProgramPipelineVk *mProgramPipeline;
 
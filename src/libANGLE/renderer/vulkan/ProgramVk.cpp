@@ -9,6 +9,7 @@
 
 #include "libANGLE/renderer/vulkan/ProgramVk.h"
 
+#include "common/FixedVector.h"
 #include "common/debug.h"
 #include "common/utilities.h"
 #include "libANGLE/Context.h"
@@ -18,12 +19,17 @@
 #include "libANGLE/renderer/vulkan/BufferVk.h"
 #include "libANGLE/renderer/vulkan/GlslangWrapperVk.h"
 #include "libANGLE/renderer/vulkan/TextureVk.h"
+#include "libANGLE/trace.h"
 
 namespace rx
 {
 
 namespace
 {
+// Dirty blocks with at least this many unchanged bytes copy them from their previous upload on the
+// GPU instead of writing the whole block from the CPU.
+constexpr size_t kMinDefaultUniformBytesToCopyOnGPU = 1024;
+
 // Identical to Std140 encoder in all aspects, except it ignores opaque uniform types.
 class VulkanDefaultBlockEncoder : public sh::Std140BlockEncoder
 {
@@ -44,6 +50,83 @@ class VulkanDefaultBlockEncoder : public sh::Std140BlockEncoder
     }
 };
 
+// Runs spirv-opt over copies of the SPIR-V of a freshly linked program.
+class OptimizeSpirvTask final : public angle::Closure
+{
+  public:
+    OptimizeSpirvTask(const gl::ShaderBitSet &linkedShaderStages,
+                      const gl::ShaderMap<SpirvBlob> &spirvBlobs)
+        : mLinkedShaderStages(linkedShaderStages), mSpirvBlobs(spirvBlobs)
+    {}
+
+    void operator()() override
+    {
+        ANGLE_TRACE_EVENT0("gpu.angle", "OptimizeSpirvTask::run");
+
+        for (const gl::ShaderType shaderType : mLinkedShaderStages)
+        {
+            if (GlslangWrapperVk::OptimizeSpirv(mSpirvBlobs[shaderType],
+                                                &mSpirvBlobs[shaderType]))
+            {
+                mOptimizedShaderStages.set(shaderType);
+            }
+        }
+    }
+
+    const gl::ShaderBitSet &getOptimizedShaderStages() const { return mOptimizedShaderStages; }
+    gl::ShaderMap<SpirvBlob> &getSpirvBlobs() { return mSpirvBlobs; }
+
+  private:
+    gl::ShaderBitSet mLinkedShaderStages;
+    gl::ShaderBitSet mOptimizedShaderStages;
+    gl::ShaderMap<SpirvBlob> mSpirvBlobs;
+};
+
+// Finishes linking once the SPIR-V optimization is done by replacing the program's SPIR-V with the
+// optimized one.  This happens before the program is used or saved to the program cache, so the
+// optimized SPIR-V is what gets cached.  Stages that failed to optimize keep their SPIR-V as is.
+class LinkEventVk final : public LinkEvent
+{
+  public:
+    LinkEventVk(std::shared_ptr<angle::WorkerThreadPool> workerPool,
+                std::shared_ptr<OptimizeSpirvTask> optimizeTask,
+                ShaderInfo *shaderInfo)
+        : mOptimizeTask(optimizeTask),
+          mWaitableEvent(angle::WorkerThreadPool::PostWorkerTask(workerPool, mOptimizeTask)),
+          mShaderInfo(shaderInfo)
+    {}
+
+    angle::Result wait(const gl::Context *context) override
+    {
+        ANGLE_TRACE_EVENT0("gpu.angle", "LinkEventVk::wait");
+
+        if (mWaitableEvent)
+        {
+            mWaitableEvent->wait();
+        }
+        else
+        {
+            // The task couldn't be posted; do the work here instead.
+            (*mOptimizeTask)();
+        }
+
+        gl::ShaderMap<SpirvBlob> &optimizedSpirvBlobs = mOptimizeTask->getSpirvBlobs();
+        for (const gl::ShaderType shaderType : mOptimizeTask->getOptimizedShaderStages())
+        {
+            mShaderInfo->getSpirvBlobs()[shaderType] = std::move(optimizedSpirvBlobs[shaderType]);
+        }
+
+        return angle::Result::Continue;
+    }
+
+    bool isLinking() override { return mWaitableEvent && !mWaitableEvent->isReady(); }
+
+  private:
+    std::shared_ptr<OptimizeSpirvTask> mOptimizeTask;
+    std::shared_ptr<angle::WaitableEvent> mWaitableEvent;
+    ShaderInfo *mShaderInfo;
+};
+
 void InitDefaultUniformBlock(const std::vector<sh::ShaderVariable> &uniforms,
                              sh::BlockLayoutMap *blockLayoutMapOut,
                              size_t *blockSizeOut)
@@ -70,38 +153,64 @@ void InitDefaultUniformBlock(const std::vector<sh::ShaderVariable> &uniforms,
     return;
 }
 
+// Marks |size| bytes at |offset| of the block's shadow copy as needing an upload.
+void ExtendDirtyRange(DefaultUniformBlock *uniformBlock, size_t offset, size_t size)
+{
+    const gl::RangeUI &dirtyRange = uniformBlock->dirtyRange;
+    uniformBlock->dirtyRange =
+        gl::RangeUI(std::min(dirtyRange.low(), static_cast<uint32_t>(offset)),
+                    std::max(dirtyRange.high(), static_cast<uint32_t>(offset + size)));
+}
+
+// Copies |size| bytes into the shadow copy at |offset| unless they are already there.  Returns
+// whether anything changed.
+bool UpdateDefaultUniformBytes(DefaultUniformBlock *uniformBlock,
+                               size_t offset,
+                               const void *data,
+                               size_t size)
+{
+    uint8_t *writePtr = uniformBlock->uniformData.data() + offset;
+    ASSERT(offset + size <= uniformBlock->uniformData.size());
+
+    if (memcmp(writePtr, data, size) == 0)
+    {
+        return false;
+    }
+
+    memcpy(writePtr, data, size);
+    ExtendDirtyRange(uniformBlock, offset, size);
+    return true;
+}
+
 template <typename T>
-void UpdateDefaultUniformBlock(GLsizei count,
+bool UpdateDefaultUniformBlock(GLsizei count,
                                uint32_t arrayIndex,
                                int componentCount,
                                const T *v,
                                const sh::BlockMemberInfo &layoutInfo,
-                               angle::MemoryBuffer *uniformData)
+                               DefaultUniformBlock *uniformBlock)
 {
     const int elementSize = sizeof(T) * componentCount;
 
-    uint8_t *dst = uniformData->data() + layoutInfo.offset;
     if (layoutInfo.arrayStride == 0 || layoutInfo.arrayStride == elementSize)
     {
         uint32_t arrayOffset = arrayIndex * layoutInfo.arrayStride;
-        uint8_t *writePtr    = dst + arrayOffset;
-        ASSERT(writePtr + (elementSize * count) <= uniformData->data() + uniformData->size());
-        memcpy(writePtr, v, elementSize * count);
+        return UpdateDefaultUniformBytes(uniformBlock, layoutInfo.offset + arrayOffset, v,
+                                         elementSize * count);
     }
-    else
+
+    // Have to respect the arrayStride between each element of the array.
+    bool changed = false;
+    int maxIndex = arrayIndex + count;
+    for (int writeIndex = arrayIndex, readIndex = 0; writeIndex < maxIndex;
+         writeIndex++, readIndex++)
     {
-        // Have to respect the arrayStride between each element of the array.
-        int maxIndex = arrayIndex + count;
-        for (int writeIndex = arrayIndex, readIndex = 0; writeIndex < maxIndex;
-             writeIndex++, readIndex++)
-        {
-            const int arrayOffset = writeIndex * layoutInfo.arrayStride;
-            uint8_t *writePtr     = dst + arrayOffset;
-            const T *readPtr      = v + (readIndex * componentCount);
-            ASSERT(writePtr + elementSize <= uniformData->data() + uniformData->size());
-            memcpy(writePtr, readPtr, elementSize);
-        }
+        const int arrayOffset = writeIndex * layoutInfo.arrayStride;
+        const T *readPtr      = v + (readIndex * componentCount);
+        changed |= UpdateDefaultUniformBytes(uniformBlock, layoutInfo.offset + arrayOffset,
+                                             readPtr, elementSize);
     }
+    return changed;
 }
 
 template <typename T>
@@ -171,6 +280,15 @@ std::unique_ptr<rx::LinkEvent> ProgramVk::load(const gl::Context *context,
 
     reset(contextVk);
 
+    // SPIR-V optimized or not by a context with the other setting is still valid, but it would
+    // not be what this context would have produced.  Have the program relinked instead.
+    const bool spirvOptimized = stream->readBool();
+    if (spirvOptimized != contextVk->getFeatures().optimizeSpirv.enabled)
+    {
+        infoLog << "Mismatched SPIR-V optimization setting.";
+        return nullptr;
+    }
+
     mOriginalShaderInfo.load(stream);
     mExecutable.load(stream);
 
@@ -205,6 +323,9 @@ std::unique_ptr<rx::LinkEvent> ProgramVk::load(const gl::Context *context,
 
 void ProgramVk::save(const gl::Context *context, gl::BinaryOutputStream *stream)
 {
+    ContextVk *contextVk = vk::GetImpl(context);
+    stream->writeBool(contextVk->getFeatures().optimizeSpirv.enabled);
+
     mOriginalShaderInfo.save(stream);
     mExecutable.save(stream);
 
@@ -287,6 +408,8 @@ std::unique_ptr<LinkEvent> ProgramVk::link(const gl::Context *context,
         return std::make_unique<LinkEventDone>(status);
     }
 
+    initDefaultUniformPushConstants(contextVk);
+
     if (contextVk->getFeatures().enablePrecisionQualifiers.enabled)
     {
         mExecutable.resolvePrecisionMismatch(mergedVaryings);
@@ -295,7 +418,17 @@ std::unique_ptr<LinkEvent> ProgramVk::link(const gl::Context *context,
     // TODO(jie.a.chen@intel.com): Parallelize linking.
     // http://crbug.com/849576
     status = mExecutable.createPipelineLayout(context, nullptr);
-    return std::make_unique<LinkEventDone>(status);
+    if (status != angle::Result::Continue || !contextVk->getFeatures().optimizeSpirv.enabled)
+    {
+        return std::make_unique<LinkEventDone>(status);
+    }
+
+    // Optimize the SPIR-V in the background.  Nothing else is left to do, so the link completes as
+    // soon as the optimizer does.
+    auto optimizeTask = std::make_shared<OptimizeSpirvTask>(
+        mState.getExecutable().getLinkedShaderStages(), mOriginalShaderInfo.getSpirvBlobs());
+    return std::make_unique<LinkEventVk>(context->getWorkerThreadPool(), optimizeTask,
+                                         &mOriginalShaderInfo);
 }
 
 void ProgramVk::linkResources(const gl::ProgramLinkedResources &resources)
@@ -403,13 +536,55 @@ angle::Result ProgramVk::resizeUniformBlockMemory(ContextVk *contextVk,
 
             // Initialize uniform buffer memory to zero by default.
             mDefaultUniformBlocks[shaderType].uniformData.fill(0);
-            mDefaultUniformBlocksDirty.set(shaderType);
+            setShaderUniformDirtyBit(shaderType);
         }
     }
 
     return angle::Result::Continue;
 }
 
+void ProgramVk::initDefaultUniformPushConstants(ContextVk *contextVk)
+{
+    if (!contextVk->getFeatures().useDefaultUniformPushConstants.enabled)
+    {
+        return;
+    }
+
+    // Lay the blocks of all stages out one after the other.  Push constants are only used if they
+    // all fit, as there's no way to mix the two for a single stage.
+    const gl::ProgramExecutable &glExecutable = mState.getExecutable();
+    gl::ShaderMap<uint32_t> offsets;
+    uint32_t totalSize = 0;
+
+    for (const gl::ShaderType shaderType : glExecutable.getLinkedShaderStages())
+    {
+        const size_t blockSize = mDefaultUniformBlocks[shaderType].uniformData.size();
+        offsets[shaderType]    = totalSize;
+        // Keep every block at a 16-byte boundary so the std140 member offsets remain valid.
+        totalSize += static_cast<uint32_t>(roundUp<size_t>(blockSize, 16));
+    }
+
+    const uint32_t maxPushConstantsSize =
+        contextVk->getRenderer()->getPhysicalDeviceProperties().limits.maxPushConstantsSize;
+    if (totalSize == 0 || totalSize > maxPushConstantsSize)
+    {
+        return;
+    }
+
+    for (const gl::ShaderType shaderType : glExecutable.getLinkedShaderStages())
+    {
+        if (mDefaultUniformBlocks[shaderType].uniformData.empty())
+        {
+            continue;
+        }
+
+        ShaderInterfaceVariableInfo &info =
+            mExecutable.mVariableInfoMap[shaderType][kDefaultUniformNames[shaderType]];
+        ASSERT(info.activeStages[shaderType]);
+        info.pushConstantOffset = offsets[shaderType];
+    }
+}
+
 GLboolean ProgramVk::validate(const gl::Caps &caps, gl::InfoLog *infoLog)
 {
     // No-op. The spec is very vague about the behavior of validation.
@@ -439,9 +614,11 @@ void ProgramVk::setUniformImpl(GLint location, GLsizei count, const T *v, GLenum
             }
 
             const GLint componentCount = linkedUniform.typeInfo->componentCount;
-            UpdateDefaultUniformBlock(count, locationInfo.arrayIndex, componentCount, v, layoutInfo,
-                                      &uniformBlock.uniformData);
-            mDefaultUniformBlocksDirty.set(shaderType);
+            if (UpdateDefaultUniformBlock(count, locationInfo.arrayIndex, componentCount, v,
+                                          layoutInfo, &uniformBlock))
+            {
+                mDefaultUniformBlocksDirty.set(shaderType);
+            }
         }
     }
     else
@@ -463,20 +640,26 @@ void ProgramVk::setUniformImpl(GLint location, GLsizei count, const T *v, GLenum
 
             GLint initialArrayOffset =
                 locationInfo.arrayIndex * layoutInfo.arrayStride + layoutInfo.offset;
+            bool changed = false;
             for (GLint i = 0; i < count; i++)
             {
                 GLint elementOffset = i * layoutInfo.arrayStride + initialArrayOffset;
-                GLint *dest =
-                    reinterpret_cast<GLint *>(uniformBlock.uniformData.data() + elementOffset);
-                const T *source = v + i * componentCount;
+                const T *source     = v + i * componentCount;
 
+                std::array<GLint, 4> element;
                 for (int c = 0; c < componentCount; c++)
                 {
-                    dest[c] = (source[c] == static_cast<T>(0)) ? GL_FALSE : GL_TRUE;
+                    element[c] = (source[c] == static_cast<T>(0)) ? GL_FALSE : GL_TRUE;
                 }
+
+                changed |= UpdateDefaultUniformBytes(&uniformBlock, elementOffset, element.data(),
+                                                     sizeof(GLint) * componentCount);
             }
 
-            mDefaultUniformBlocksDirty.set(shaderType);
+            if (changed)
+            {
+                mDefaultUniformBlocksDirty.set(shaderType);
+            }
         }
     }
 }
@@ -601,10 +784,30 @@ void ProgramVk::setUniformMatrixfv(GLint location,
             continue;
         }
 
+        // GLSL matrices are stored as columns padded to 4 components.
+        constexpr size_t kMatrixSize = sizeof(GLfloat) * cols * 4;
+        const unsigned int arraySize = linkedUniform.getArraySizeProduct();
+        const size_t matrixCount     = std::min<size_t>(count, arraySize - locationInfo.arrayIndex);
+        const size_t updateOffset    = layoutInfo.offset + locationInfo.arrayIndex * kMatrixSize;
+
+        if (matrixCount == 1)
+        {
+            // Convert the common single matrix update on the side, so setting a matrix to its
+            // current value doesn't dirty the block.  The padding stays zero in both copies.
+            std::array<uint8_t, kMatrixSize> matrix = {};
+            SetFloatUniformMatrixGLSL<cols, rows>::Run(0, 1, 1, transpose, value, matrix.data());
+            if (UpdateDefaultUniformBytes(&uniformBlock, updateOffset, matrix.data(), kMatrixSize))
+            {
+                mDefaultUniformBlocksDirty.set(shaderType);
+            }
+            continue;
+        }
+
         SetFloatUniformMatrixGLSL<cols, rows>::Run(
-            locationInfo.arrayIndex, linkedUniform.getArraySizeProduct(), count, transpose, value,
+            locationInfo.arrayIndex, arraySize, count, transpose, value,
             uniformBlock.uniformData.data() + layoutInfo.offset);
 
+        ExtendDirtyRange(&uniformBlock, updateOffset, matrixCount * kMatrixSize);
         mDefaultUniformBlocksDirty.set(shaderType);
     }
 }
@@ -712,9 +915,28 @@ size_t ProgramVk::calcUniformUpdateRequiredSpace(ContextVk *contextVk,
     return requiredSpace;
 }
 
-angle::Result ProgramVk::updateUniforms(ContextVk *contextVk)
+angle::Result ProgramVk::updateUniforms(ContextVk *contextVk,
+                                        vk::CommandBuffer *commandBuffer,
+                                        bool *descriptorSetsDirtyOut)
 {
     ASSERT(dirtyUniforms());
+    *descriptorSetsDirtyOut = false;
+
+    // Stages whose uniforms are pushed as constants need no buffer space.  Only the bytes that
+    // changed are recorded here; the whole block is pushed again whenever the descriptor sets are
+    // bound, which covers new command buffers and program changes.
+    const gl::ShaderBitSet pushConstantStages = mExecutable.getDefaultUniformPushConstantStages();
+    for (const gl::ShaderType shaderType : mDefaultUniformBlocksDirty & pushConstantStages)
+    {
+        mExecutable.pushDefaultUniformConstantsRange(commandBuffer, shaderType,
+                                                     mDefaultUniformBlocks[shaderType]);
+        clearShaderUniformDirtyBit(shaderType);
+    }
+    if (!dirtyUniforms())
+    {
+        return angle::Result::Continue;
+    }
+    *descriptorSetsDirtyOut = true;
 
     bool anyNewBufferAllocated                = false;
     uint8_t *bufferData                       = nullptr;
@@ -739,9 +961,9 @@ angle::Result ProgramVk::updateUniforms(ContextVk *contextVk)
     {
         for (const gl::ShaderType shaderType : glExecutable.getLinkedShaderStages())
         {
-            if (!mDefaultUniformBlocks[shaderType].uniformData.empty())
+            if (!pushConstantStages[shaderType])
             {
-                mDefaultUniformBlocksDirty.set(shaderType);
+                setShaderUniformDirtyBit(shaderType);
             }
         }
 
@@ -750,22 +972,85 @@ angle::Result ProgramVk::updateUniforms(ContextVk *contextVk)
                                                   &bufferOffset, &anyNewBufferAllocated));
     }
 
+    vk::BufferHelper *defaultUniformBuffer = defaultUniformStorage->getCurrentBuffer();
+
+    // The previous upload of every stage lives in the current buffer unless the buffer switched,
+    // in which case all blocks were marked fully dirty above.  Graphics draws then only write the
+    // dirty bytes from the CPU, and copy the rest of a large block from its previous upload on the
+    // GPU, outside the render pass.  Dispatches are recorded in the outside render pass command
+    // buffer themselves, which recording the copy may flush, so they always write whole blocks.
+    const bool canCopyUnchangedBytes = !glExecutable.isCompute() &&
+                                       mExecutable.getCurrentDefaultUniformBufferSerial() ==
+                                           defaultUniformBuffer->getBufferSerial();
+    angle::FixedVector<VkBufferCopy, 2 * gl::kGraphicsShaderCount> unchangedBytesCopies;
+
     // Update buffer memory by immediate mapping. This immediate update only works once.
     for (const gl::ShaderType shaderType : glExecutable.getLinkedShaderStages())
     {
+        // Push constant stages have no binding, and so no dynamic offset either.
+        if (pushConstantStages[shaderType])
+        {
+            continue;
+        }
+
         if (mDefaultUniformBlocksDirty[shaderType])
         {
-            const angle::MemoryBuffer &uniformData = mDefaultUniformBlocks[shaderType].uniformData;
-            memcpy(&bufferData[offsets[shaderType]], uniformData.data(), uniformData.size());
-            mExecutable.mDynamicBufferOffsets[offsetIndex] =
-                static_cast<uint32_t>(bufferOffset + offsets[shaderType]);
-            mDefaultUniformBlocksDirty.reset(shaderType);
+            const DefaultUniformBlock &uniformBlock = mDefaultUniformBlocks[shaderType];
+            const angle::MemoryBuffer &uniformData  = uniformBlock.uniformData;
+            const gl::RangeUI &dirtyRange           = uniformBlock.dirtyRange;
+
+            const VkDeviceSize previousOffset = mExecutable.mDynamicBufferOffsets[offsetIndex];
+            const VkDeviceSize newOffset      = bufferOffset + offsets[shaderType];
+
+            if (canCopyUnchangedBytes && !dirtyRange.empty() &&
+                uniformData.size() - dirtyRange.length() >= kMinDefaultUniformBytesToCopyOnGPU)
+            {
+                memcpy(&bufferData[offsets[shaderType] + dirtyRange.low()],
+                       uniformData.data() + dirtyRange.low(), dirtyRange.length());
+                if (dirtyRange.low() > 0)
+                {
+                    unchangedBytesCopies.push_back({previousOffset, newOffset, dirtyRange.low()});
+                }
+                if (dirtyRange.high() < uniformData.size())
+                {
+                    unchangedBytesCopies.push_back({previousOffset + dirtyRange.high(),
+                                                    newOffset + dirtyRange.high(),
+                                                    uniformData.size() - dirtyRange.high()});
+                }
+            }
+            else
+            {
+                memcpy(&bufferData[offsets[shaderType]], uniformData.data(), uniformData.size());
+            }
+            mExecutable.mDynamicBufferOffsets[offsetIndex] = static_cast<uint32_t>(newOffset);
+            clearShaderUniformDirtyBit(shaderType);
         }
         ++offsetIndex;
     }
     ANGLE_TRY(defaultUniformStorage->flush(contextVk));
 
-    vk::BufferHelper *defaultUniformBuffer = defaultUniformStorage->getCurrentBuffer();
+    if (!unchangedBytesCopies.empty())
+    {
+        vk::CommandBufferAccess access;
+        access.onBufferSelfCopy(defaultUniformBuffer);
+
+        vk::CommandBuffer *copyCommandBuffer;
+        ANGLE_TRY(contextVk->getOutsideRenderPassCommandBuffer(access, &copyCommandBuffer));
+
+        copyCommandBuffer->copyBuffer(defaultUniformBuffer->getBuffer(),
+                                      defaultUniformBuffer->getBuffer(),
+                                      static_cast<uint32_t>(unchangedBytesCopies.size()),
+                                      unchangedBytesCopies.data());
+
+        // Uniform reads are not tracked by the buffer, so make the copies visible to the draws.
+        VkMemoryBarrier memoryBarrier = {};
+        memoryBarrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        memoryBarrier.srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+        memoryBarrier.dstAccessMask   = VK_ACCESS_UNIFORM_READ_BIT;
+        copyCommandBuffer->memoryBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                         VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT, &memoryBarrier);
+    }
+
     if (mExecutable.getCurrentDefaultUniformBufferSerial() !=
         defaultUniformBuffer->getBufferSerial())
     {
@@ -103,7 +103,13 @@ class ProgramVk : public ProgramImpl
     void getUniformiv(const gl::Context *context, GLint location, GLint *params) const override;
     void getUniformuiv(const gl::Context *context, GLint location, GLuint *params) const override;
 
-    angle::Result updateUniforms(ContextVk *contextVk);
+    // Uploads the dirty default uniform blocks.  Blocks delivered as push constants have only their
+    // changed bytes recorded into |commandBuffer|.  |descriptorSetsDirtyOut| is set if the other
+    // blocks moved to new offsets in the default uniform buffer, so the descriptor sets must be
+    // rebound.
+    angle::Result updateUniforms(ContextVk *contextVk,
+                                 vk::CommandBuffer *commandBuffer,
+                                 bool *descriptorSetsDirtyOut);
 
     bool dirtyUniforms() const { return mDefaultUniformBlocksDirty.any(); }
     bool isShaderUniformDirty(gl::ShaderType shaderType) const
@@ -112,13 +118,17 @@ class ProgramVk : public ProgramImpl
     }
     void setShaderUniformDirtyBit(gl::ShaderType shaderType)
     {
-        if (!mDefaultUniformBlocks[shaderType].uniformData.empty())
+        DefaultUniformBlock &uniformBlock = mDefaultUniformBlocks[shaderType];
+        if (!uniformBlock.uniformData.empty())
         {
+            uniformBlock.dirtyRange =
+                gl::RangeUI(0, static_cast<uint32_t>(uniformBlock.uniformData.size()));
             mDefaultUniformBlocksDirty.set(shaderType);
         }
     }
     void clearShaderUniformDirtyBit(gl::ShaderType shaderType)
     {
+        mDefaultUniformBlocks[shaderType].dirtyRange.invalidate();
         mDefaultUniformBlocksDirty.reset(shaderType);
     }
     void onProgramBind();
@@ -182,6 +192,7 @@ class ProgramVk : public ProgramImpl
     void initDefaultUniformLayoutMapping(gl::ShaderMap<sh::BlockLayoutMap> &layoutMap);
     angle::Result resizeUniformBlockMemory(ContextVk *contextVk,
                                            gl::ShaderMap<size_t> &requiredBufferSize);
+    void initDefaultUniformPushConstants(ContextVk *contextVk);
 
     template <class T>
     void getUniformImpl(GLint location, T *v, GLenum entryPointType) const;
@@ -46,7 +46,8 @@ QueryVk::QueryVk(gl::QueryType type)
     : QueryImpl(type),
       mTransformFeedbackPrimitivesDrawn(0),
       mCachedResult(0),
-      mCachedResultValid(false)
+      mCachedResultValid(false),
+      mPolledBeforeFlush(false)
 {}
 
 QueryVk::~QueryVk() = default;
@@ -76,7 +77,7 @@ angle::Result QueryVk::accumulateStashedQueryResult(ContextVk *contextVk, vk::Qu
     for (vk::QueryHelper &query : mStashedQueryHelpers)
     {
         vk::QueryResult v(getQueryResultCount());
-        ANGLE_TRY(query.getUint64Result(contextVk, &v));
+        ANGLE_TRY(query.getCopiedResult(contextVk, &v));
         *result += v;
     }
     mStashedQueryHelpers.clear();
@@ -88,6 +89,7 @@ angle::Result QueryVk::begin(const gl::Context *context)
     ContextVk *contextVk = vk::GetImpl(context);
 
     mCachedResultValid = false;
+    mPolledBeforeFlush = false;
 
     // Transform feedback query is a handled by a CPU-calculated value when emulated.
     if (IsEmulatedTransformFeedbackQuery(contextVk, mType))
@@ -193,6 +195,7 @@ angle::Result QueryVk::queryCounter(const gl::Context *context)
     ContextVk *contextVk = vk::GetImpl(context);
 
     mCachedResultValid = false;
+    mPolledBeforeFlush = false;
 
     if (!mQueryHelper.valid())
     {
@@ -272,12 +275,20 @@ angle::Result QueryVk::getResult(const gl::Context *context, bool wait)
     RendererVk *renderer = contextVk->getRenderer();
 
     // glGetQueryObject* requires an implicit flush of the command buffers to guarantee execution in
-    // finite time.
+    // finite time.  Polling for availability doesn't flush the first time around though; the
+    // query is likely to be submitted with the rest of the frame before it's polled again, and
+    // flushing early would split the frame's submission in two.
     // Note regarding time-elapsed: end should have been called after begin, so flushing when end
     // has pending work should flush begin too.
 
     if (isUsedInRecordedCommands())
     {
+        if (!wait && !mPolledBeforeFlush)
+        {
+            mPolledBeforeFlush = true;
+            return angle::Result::Continue;
+        }
+
         ANGLE_TRY(contextVk->flushImpl(nullptr));
 
         ASSERT(!mQueryHelperTimeElapsedBegin.usedInRecordedCommands());
@@ -286,10 +297,9 @@ angle::Result QueryVk::getResult(const gl::Context *context, bool wait)
 
     ANGLE_TRY(contextVk->checkCompletedCommands());
 
-    // If the command buffer this query is being written to is still in flight, its reset
-    // command may not have been performed by the GPU yet.  To avoid a race condition in this
-    // case, wait for the batch to finish first before querying (or return not-ready if not
-    // waiting).
+    // The results are copied to the results buffer of the query pool at the end of the command
+    // buffer the query is in.  If that command buffer is still in flight, wait for it to finish
+    // (or return not-ready if not waiting).
     if (isCurrentlyInUse(contextVk->getLastCompletedQueueSerial()))
     {
         if (!wait)
@@ -305,23 +315,8 @@ angle::Result QueryVk::getResult(const gl::Context *context, bool wait)
     }
 
     vk::QueryResult result(getQueryResultCount());
-
-    if (wait)
-    {
-        ANGLE_TRY(mQueryHelper.getUint64Result(contextVk, &result));
-        ANGLE_TRY(accumulateStashedQueryResult(contextVk, &result));
-    }
-    else
-    {
-        bool available = false;
-        ANGLE_TRY(mQueryHelper.getUint64ResultNonBlocking(contextVk, &result, &available));
-        if (!available)
-        {
-            // If the results are not ready, do nothing.  mCachedResultValid remains false.
-            return angle::Result::Continue;
-        }
-        ANGLE_TRY(accumulateStashedQueryResult(contextVk, &result));
-    }
+    ANGLE_TRY(mQueryHelper.getCopiedResult(contextVk, &result));
+    ANGLE_TRY(accumulateStashedQueryResult(contextVk, &result));
 
     double timestampPeriod = renderer->getPhysicalDeviceProperties().limits.timestampPeriod;
 
@@ -342,7 +337,7 @@ angle::Result QueryVk::getResult(const gl::Context *context, bool wait)
 
             // Since the result of the end query of time-elapsed is already available, the
             // result of begin query must be available too.
-            ANGLE_TRY(mQueryHelperTimeElapsedBegin.getUint64Result(contextVk, &timeElapsedBegin));
+            ANGLE_TRY(mQueryHelperTimeElapsedBegin.getCopiedResult(contextVk, &timeElapsedBegin));
 
             uint64_t delta = result.getResult() - timeElapsedBegin.getResult();
             mCachedResult  = static_cast<uint64_t>(delta * timestampPeriod);
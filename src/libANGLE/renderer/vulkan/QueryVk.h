@@ -59,6 +59,9 @@ class QueryVk : public QueryImpl
 
     uint64_t mCachedResult;
     bool mCachedResultValid;
+    // Whether availability was polled while the query was still in unflushed commands.  The
+    // commands are flushed on the next poll, so the result eventually becomes available.
+    bool mPolledBeforeFlush;
 };
 
 }  // namespace rx
@@ -987,6 +987,14 @@ void RendererVk::queryDeviceExtensionFeatures(const vk::ExtensionNameList &devic
     mSamplerYcbcrConversionFeatures.sType =
         VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SAMPLER_YCBCR_CONVERSION_FEATURES;
 
+    mImagelessFramebufferFeatures = {};
+    mImagelessFramebufferFeatures.sType =
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGELESS_FRAMEBUFFER_FEATURES_KHR;
+
+    mExtendedDynamicStateFeatures = {};
+    mExtendedDynamicStateFeatures.sType =
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+
     if (!vkGetPhysicalDeviceProperties2KHR || !vkGetPhysicalDeviceFeatures2KHR)
     {
         return;
@@ -1048,6 +1056,18 @@ void RendererVk::queryDeviceExtensionFeatures(const vk::ExtensionNameList &devic
         vk::AddToPNextChain(&deviceFeatures, &mSamplerYcbcrConversionFeatures);
     }
 
+    // Query imageless framebuffer features
+    if (ExtensionFound(VK_KHR_IMAGELESS_FRAMEBUFFER_EXTENSION_NAME, deviceExtensionNames))
+    {
+        vk::AddToPNextChain(&deviceFeatures, &mImagelessFramebufferFeatures);
+    }
+
+    // Query extended dynamic state features
+    if (ExtensionFound(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME, deviceExtensionNames))
+    {
+        vk::AddToPNextChain(&deviceFeatures, &mExtendedDynamicStateFeatures);
+    }
+
     // Query float16/int8 features
     if (ExtensionFound(VK_KHR_SHADER_FLOAT16_INT8_EXTENSION_NAME, deviceExtensionNames))
     {
@@ -1101,6 +1121,8 @@ void RendererVk::queryDeviceExtensionFeatures(const vk::ExtensionNameList &devic
     mShaderFloat16Int8Features.pNext        = nullptr;
     mDepthStencilResolveProperties.pNext    = nullptr;
     mSamplerYcbcrConversionFeatures.pNext   = nullptr;
+    mImagelessFramebufferFeatures.pNext     = nullptr;
+    mExtendedDynamicStateFeatures.pNext     = nullptr;
 }
 
 angle::Result RendererVk::initializeDevice(DisplayVk *displayVk, uint32_t queueFamilyIndex)
@@ -1340,7 +1362,10 @@ angle::Result RendererVk::initializeDevice(DisplayVk *displayVk, uint32_t queueF
         enabledDeviceExtensions.push_back(VK_QCOM_render_pass_store_ops_EXTENSION_NAME);
     }
 
-    if (getFeatures().supportsImageFormatList.enabled)
+    // VK_KHR_imageless_framebuffer depends on VK_KHR_image_format_list, even if images are not
+    // created with a format list.
+    if (getFeatures().supportsImageFormatList.enabled ||
+        getFeatures().supportsImagelessFramebuffer.enabled)
     {
         enabledDeviceExtensions.push_back(VK_KHR_IMAGE_FORMAT_LIST_EXTENSION_NAME);
     }
@@ -1387,6 +1412,10 @@ angle::Result RendererVk::initializeDevice(DisplayVk *displayVk, uint32_t queueF
     enabledFeatures.features.sampleRateShading = mPhysicalDeviceFeatures.sampleRateShading;
     // Used to support depth clears through draw calls.
     enabledFeatures.features.depthClamp = mPhysicalDeviceFeatures.depthClamp;
+    // Used to implement ANGLE_multi_draw with indirect draws:
+    enabledFeatures.features.multiDrawIndirect = getFeatures().supportsMultiDrawIndirect.enabled;
+    enabledFeatures.features.drawIndirectFirstInstance =
+        mPhysicalDeviceFeatures.drawIndirectFirstInstance;
 
     if (!vk::CommandBuffer::ExecutesInline())
     {
@@ -1437,11 +1466,28 @@ angle::Result RendererVk::initializeDevice(DisplayVk *displayVk, uint32_t queueF
         vk::AddToPNextChain(&createInfo, &mIndexTypeUint8Features);
     }
 
+    if (getFeatures().supportsImagelessFramebuffer.enabled)
+    {
+        enabledDeviceExtensions.push_back(VK_KHR_IMAGELESS_FRAMEBUFFER_EXTENSION_NAME);
+        vk::AddToPNextChain(&createInfo, &mImagelessFramebufferFeatures);
+    }
+
+    if (getFeatures().supportsExtendedDynamicState.enabled)
+    {
+        enabledDeviceExtensions.push_back(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME);
+        vk::AddToPNextChain(&createInfo, &mExtendedDynamicStateFeatures);
+    }
+
     if (getFeatures().supportsDepthStencilResolve.enabled)
     {
         enabledDeviceExtensions.push_back(VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME);
     }
 
+    if (getFeatures().supportsShaderDrawParameters.enabled)
+    {
+        enabledDeviceExtensions.push_back(VK_KHR_SHADER_DRAW_PARAMETERS_EXTENSION_NAME);
+    }
+
     if (mMemoryReportFeatures.deviceMemoryReport &&
         (getFeatures().logMemoryReportCallbacks.enabled ||
          getFeatures().logMemoryReportStats.enabled))
@@ -1547,6 +1593,10 @@ angle::Result RendererVk::initializeDevice(DisplayVk *displayVk, uint32_t queueF
     {
         InitRenderPass2KHRFunctions(mDevice);
     }
+    if (getFeatures().supportsExtendedDynamicState.enabled)
+    {
+        InitExtendedDynamicStateEXTFunctions(mDevice);
+    }
 #endif  // !defined(ANGLE_SHARED_LIBVULKAN)
 
     if (getFeatures().forceMaxUniformBufferSize16KB.enabled)
@@ -1811,6 +1861,7 @@ void RendererVk::initFeatures(DisplayVk *displayVk,
 
     // http://anglebug.com/3055
     ANGLE_FEATURE_CONDITION(&mFeatures, forceCPUPathForCubeMapCopy, IsWindows() && isIntel);
+    ANGLE_FEATURE_CONDITION(&mFeatures, forceCPUPathForGenerateMipmap, false);
 
     // Work around incorrect NVIDIA point size range clamping.
     // http://anglebug.com/2970#c10
@@ -1930,6 +1981,24 @@ void RendererVk::initFeatures(DisplayVk *displayVk,
     ANGLE_FEATURE_CONDITION(&mFeatures, supportsIndexTypeUint8,
                             mIndexTypeUint8Features.indexTypeUint8 == VK_TRUE);
 
+    ANGLE_FEATURE_CONDITION(
+        &mFeatures, supportsImagelessFramebuffer,
+        mImagelessFramebufferFeatures.imagelessFramebuffer == VK_TRUE &&
+            ExtensionFound(VK_KHR_IMAGE_FORMAT_LIST_EXTENSION_NAME, deviceExtensionNames));
+
+    ANGLE_FEATURE_CONDITION(&mFeatures, supportsExtendedDynamicState,
+                            mExtendedDynamicStateFeatures.extendedDynamicState == VK_TRUE);
+
+    // How much VK_PIPELINE_CREATE_DISABLE_OPTIMIZATION_BIT saves varies a lot between drivers, so
+    // this is opt-in for now.
+    ANGLE_FEATURE_CONDITION(&mFeatures, asyncGraphicsPipelineOptimization, false);
+
+    // Programs only switch between surface rotation specializations when surfaces are pre-rotated.
+    ANGLE_FEATURE_CONDITION(&mFeatures, prespecializeGraphicsPipelines, false);
+
+    // Optimizing the SPIR-V only pays off with drivers that don't optimize much themselves.
+    ANGLE_FEATURE_CONDITION(&mFeatures, optimizeSpirv, false);
+
     ANGLE_FEATURE_CONDITION(&mFeatures, supportsDepthStencilResolve,
                             mFeatures.supportsRenderpass2.enabled &&
                                 mDepthStencilResolveProperties.independentResolveNone == VK_TRUE);
@@ -2045,6 +2114,17 @@ void RendererVk::initFeatures(DisplayVk *displayVk,
         &mFeatures, supportsImageCubeArray,
         mPhysicalDeviceFeatures.imageCubeArray == VK_TRUE && !isSwiftShader && !isQualcomm);
 
+    ANGLE_FEATURE_CONDITION(&mFeatures, supportsMultiDrawIndirect,
+                            mPhysicalDeviceFeatures.multiDrawIndirect == VK_TRUE);
+
+    ANGLE_FEATURE_CONDITION(
+        &mFeatures, supportsShaderDrawParameters,
+        ExtensionFound(VK_KHR_SHADER_DRAW_PARAMETERS_EXTENSION_NAME, deviceExtensionNames));
+
+    ANGLE_FEATURE_CONDITION(&mFeatures, useDefaultUniformPushConstants, false);
+
+    ANGLE_FEATURE_CONDITION(&mFeatures, transcodeEtcWithCompute, true);
+
     ANGLE_FEATURE_CONDITION(&mFeatures, preferredLargeHeapBlockSize4MB, !isQualcomm);
 
     // Defer glFLush call causes manhattan 3.0 perf regression. Let Qualcomm driver opt out from
@@ -2244,6 +2324,11 @@ Serial RendererVk::issueShaderSerial()
     return mShaderSerialFactory.generate();
 }
 
+Serial RendererVk::issueIndexConversionSerial()
+{
+    return mIndexConversionSerialFactory.generate();
+}
+
 // These functions look at the mandatory format for support, and fallback to querying the device (if
 // necessary) to test the availability of the bits.
 bool RendererVk::hasLinearImageFormatFeatureBits(VkFormat format,
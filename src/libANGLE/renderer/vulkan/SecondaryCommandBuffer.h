@@ -51,6 +51,7 @@ enum class CommandID : uint16_t
     CopyBufferToImage,
     CopyImage,
     CopyImageToBuffer,
+    CopyQueryPoolResults,
     Dispatch,
     DispatchIndirect,
     Draw,
@@ -77,8 +78,16 @@ enum class CommandID : uint16_t
     ResetEvent,
     ResetQueryPool,
     ResolveImage,
+    SetCullMode,
+    SetDepthCompareOp,
+    SetDepthTestEnable,
+    SetDepthWriteEnable,
     SetEvent,
+    SetFrontFace,
+    SetPrimitiveTopology,
     SetScissor,
+    SetStencilOp,
+    SetStencilTestEnable,
     WaitEvents,
     WriteTimestamp,
 };
@@ -215,6 +224,18 @@ struct CopyImageToBufferParams
 };
 VERIFY_4_BYTE_ALIGNMENT(CopyImageToBufferParams)
 
+struct CopyQueryPoolResultsParams
+{
+    VkQueryPool queryPool;
+    VkBuffer dstBuffer;
+    VkDeviceSize dstOffset;
+    VkDeviceSize stride;
+    uint32_t firstQuery;
+    uint32_t queryCount;
+    VkQueryResultFlags flags;
+};
+VERIFY_4_BYTE_ALIGNMENT(CopyQueryPoolResultsParams)
+
 // This is a common struct used by both begin & insert DebugUtilsLabelEXT() functions
 struct DebugUtilsLabelParams
 {
@@ -261,6 +282,8 @@ struct DrawIndexedIndirectParams
 {
     VkBuffer buffer;
     VkDeviceSize offset;
+    uint32_t drawCount;
+    uint32_t stride;
 };
 VERIFY_4_BYTE_ALIGNMENT(DrawIndexedIndirectParams)
 
@@ -293,6 +316,8 @@ struct DrawIndirectParams
 {
     VkBuffer buffer;
     VkDeviceSize offset;
+    uint32_t drawCount;
+    uint32_t stride;
 };
 VERIFY_4_BYTE_ALIGNMENT(DrawIndirectParams)
 
@@ -410,6 +435,30 @@ struct ResolveImageParams
 };
 VERIFY_4_BYTE_ALIGNMENT(ResolveImageParams)
 
+struct SetCullModeParams
+{
+    VkCullModeFlags cullMode;
+};
+VERIFY_4_BYTE_ALIGNMENT(SetCullModeParams)
+
+struct SetDepthCompareOpParams
+{
+    VkCompareOp depthCompareOp;
+};
+VERIFY_4_BYTE_ALIGNMENT(SetDepthCompareOpParams)
+
+struct SetDepthTestEnableParams
+{
+    VkBool32 depthTestEnable;
+};
+VERIFY_4_BYTE_ALIGNMENT(SetDepthTestEnableParams)
+
+struct SetDepthWriteEnableParams
+{
+    VkBool32 depthWriteEnable;
+};
+VERIFY_4_BYTE_ALIGNMENT(SetDepthWriteEnableParams)
+
 struct SetEventParams
 {
     VkEvent event;
@@ -417,12 +466,40 @@ struct SetEventParams
 };
 VERIFY_4_BYTE_ALIGNMENT(SetEventParams)
 
+struct SetFrontFaceParams
+{
+    VkFrontFace frontFace;
+};
+VERIFY_4_BYTE_ALIGNMENT(SetFrontFaceParams)
+
+struct SetPrimitiveTopologyParams
+{
+    VkPrimitiveTopology primitiveTopology;
+};
+VERIFY_4_BYTE_ALIGNMENT(SetPrimitiveTopologyParams)
+
 struct SetScissorParams
 {
     VkRect2D scissor;
 };
 VERIFY_4_BYTE_ALIGNMENT(SetScissorParams)
 
+struct SetStencilOpParams
+{
+    VkStencilFaceFlags faceMask;
+    VkStencilOp failOp;
+    VkStencilOp passOp;
+    VkStencilOp depthFailOp;
+    VkCompareOp compareOp;
+};
+VERIFY_4_BYTE_ALIGNMENT(SetStencilOpParams)
+
+struct SetStencilTestEnableParams
+{
+    VkBool32 stencilTestEnable;
+};
+VERIFY_4_BYTE_ALIGNMENT(SetStencilTestEnableParams)
+
 struct WaitEventsParams
 {
     uint32_t eventCount;
@@ -558,6 +635,14 @@ class SecondaryCommandBuffer final : angle::NonCopyable
                            uint32_t regionCount,
                            const VkBufferImageCopy *regions);
 
+    void copyQueryPoolResults(VkQueryPool queryPool,
+                              uint32_t firstQuery,
+                              uint32_t queryCount,
+                              const Buffer &dstBuffer,
+                              VkDeviceSize dstOffset,
+                              VkDeviceSize stride,
+                              VkQueryResultFlags flags);
+
     void dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ);
 
     void dispatchIndirect(const Buffer &buffer, VkDeviceSize offset);
@@ -646,10 +731,26 @@ class SecondaryCommandBuffer final : angle::NonCopyable
                       uint32_t regionCount,
                       const VkImageResolve *regions);
 
+    // VK_EXT_extended_dynamic_state
+    void setCullMode(VkCullModeFlags cullMode);
+    void setDepthCompareOp(VkCompareOp depthCompareOp);
+    void setDepthTestEnable(VkBool32 depthTestEnable);
+    void setDepthWriteEnable(VkBool32 depthWriteEnable);
+
     void setEvent(VkEvent event, VkPipelineStageFlags stageMask);
 
+    void setFrontFace(VkFrontFace frontFace);
+    void setPrimitiveTopology(VkPrimitiveTopology primitiveTopology);
+
     void setScissor(uint32_t firstScissor, uint32_t scissorCount, const VkRect2D *scissors);
 
+    void setStencilOp(VkStencilFaceFlags faceMask,
+                      VkStencilOp failOp,
+                      VkStencilOp passOp,
+                      VkStencilOp depthFailOp,
+                      VkCompareOp compareOp);
+    void setStencilTestEnable(VkBool32 stencilTestEnable);
+
     void waitEvents(uint32_t eventCount,
                     const VkEvent *events,
                     VkPipelineStageFlags srcStageMask,
@@ -1092,6 +1193,25 @@ ANGLE_INLINE void SecondaryCommandBuffer::copyImageToBuffer(const Image &srcImag
     paramStruct->region         = regions[0];
 }
 
+ANGLE_INLINE void SecondaryCommandBuffer::copyQueryPoolResults(VkQueryPool queryPool,
+                                                               uint32_t firstQuery,
+                                                               uint32_t queryCount,
+                                                               const Buffer &dstBuffer,
+                                                               VkDeviceSize dstOffset,
+                                                               VkDeviceSize stride,
+                                                               VkQueryResultFlags flags)
+{
+    CopyQueryPoolResultsParams *paramStruct =
+        initCommand<CopyQueryPoolResultsParams>(CommandID::CopyQueryPoolResults);
+    paramStruct->queryPool  = queryPool;
+    paramStruct->dstBuffer  = dstBuffer.getHandle();
+    paramStruct->dstOffset  = dstOffset;
+    paramStruct->stride     = stride;
+    paramStruct->firstQuery = firstQuery;
+    paramStruct->queryCount = queryCount;
+    paramStruct->flags      = flags;
+}
+
 ANGLE_INLINE void SecondaryCommandBuffer::dispatch(uint32_t groupCountX,
                                                    uint32_t groupCountY,
                                                    uint32_t groupCountZ)
@@ -1140,9 +1260,10 @@ ANGLE_INLINE void SecondaryCommandBuffer::drawIndexedIndirect(const Buffer &buff
 {
     DrawIndexedIndirectParams *paramStruct =
         initCommand<DrawIndexedIndirectParams>(CommandID::DrawIndexedIndirect);
-    paramStruct->buffer = buffer.getHandle();
-    paramStruct->offset = offset;
-    ASSERT(drawCount == 1);
+    paramStruct->buffer    = buffer.getHandle();
+    paramStruct->offset    = offset;
+    paramStruct->drawCount = drawCount;
+    paramStruct->stride    = stride;
 }
 
 ANGLE_INLINE void SecondaryCommandBuffer::drawIndexedInstanced(uint32_t indexCount,
@@ -1191,10 +1312,8 @@ ANGLE_INLINE void SecondaryCommandBuffer::drawIndirect(const Buffer &buffer,
     DrawIndirectParams *paramStruct = initCommand<DrawIndirectParams>(CommandID::DrawIndirect);
     paramStruct->buffer             = buffer.getHandle();
     paramStruct->offset             = offset;
-
-    // OpenGL ES doesn't have a way to specify a drawCount or stride, throw assert if something
-    // changes.
-    ASSERT(drawCount == 1);
+    paramStruct->drawCount          = drawCount;
+    paramStruct->stride             = stride;
 }
 
 ANGLE_INLINE void SecondaryCommandBuffer::drawInstanced(uint32_t vertexCount,
@@ -1378,6 +1497,33 @@ ANGLE_INLINE void SecondaryCommandBuffer::resolveImage(const Image &srcImage,
     paramStruct->region             = regions[0];
 }
 
+ANGLE_INLINE void SecondaryCommandBuffer::setCullMode(VkCullModeFlags cullMode)
+{
+    SetCullModeParams *paramStruct = initCommand<SetCullModeParams>(CommandID::SetCullMode);
+    paramStruct->cullMode          = cullMode;
+}
+
+ANGLE_INLINE void SecondaryCommandBuffer::setDepthCompareOp(VkCompareOp depthCompareOp)
+{
+    SetDepthCompareOpParams *paramStruct =
+        initCommand<SetDepthCompareOpParams>(CommandID::SetDepthCompareOp);
+    paramStruct->depthCompareOp = depthCompareOp;
+}
+
+ANGLE_INLINE void SecondaryCommandBuffer::setDepthTestEnable(VkBool32 depthTestEnable)
+{
+    SetDepthTestEnableParams *paramStruct =
+        initCommand<SetDepthTestEnableParams>(CommandID::SetDepthTestEnable);
+    paramStruct->depthTestEnable = depthTestEnable;
+}
+
+ANGLE_INLINE void SecondaryCommandBuffer::setDepthWriteEnable(VkBool32 depthWriteEnable)
+{
+    SetDepthWriteEnableParams *paramStruct =
+        initCommand<SetDepthWriteEnableParams>(CommandID::SetDepthWriteEnable);
+    paramStruct->depthWriteEnable = depthWriteEnable;
+}
+
 ANGLE_INLINE void SecondaryCommandBuffer::setEvent(VkEvent event, VkPipelineStageFlags stageMask)
 {
     SetEventParams *paramStruct = initCommand<SetEventParams>(CommandID::SetEvent);
@@ -1385,6 +1531,20 @@ ANGLE_INLINE void SecondaryCommandBuffer::setEvent(VkEvent event, VkPipelineStag
     paramStruct->stageMask      = stageMask;
 }
 
+ANGLE_INLINE void SecondaryCommandBuffer::setFrontFace(VkFrontFace frontFace)
+{
+    SetFrontFaceParams *paramStruct = initCommand<SetFrontFaceParams>(CommandID::SetFrontFace);
+    paramStruct->frontFace          = frontFace;
+}
+
+ANGLE_INLINE void SecondaryCommandBuffer::setPrimitiveTopology(
+    VkPrimitiveTopology primitiveTopology)
+{
+    SetPrimitiveTopologyParams *paramStruct =
+        initCommand<SetPrimitiveTopologyParams>(CommandID::SetPrimitiveTopology);
+    paramStruct->primitiveTopology = primitiveTopology;
+}
+
 ANGLE_INLINE void SecondaryCommandBuffer::setScissor(uint32_t firstScissor,
                                                      uint32_t scissorCount,
                                                      const VkRect2D *scissors)
@@ -1396,6 +1556,27 @@ ANGLE_INLINE void SecondaryCommandBuffer::setScissor(uint32_t firstScissor,
     paramStruct->scissor          = scissors[0];
 }
 
+ANGLE_INLINE void SecondaryCommandBuffer::setStencilOp(VkStencilFaceFlags faceMask,
+                                                       VkStencilOp failOp,
+                                                       VkStencilOp passOp,
+                                                       VkStencilOp depthFailOp,
+                                                       VkCompareOp compareOp)
+{
+    SetStencilOpParams *paramStruct = initCommand<SetStencilOpParams>(CommandID::SetStencilOp);
+    paramStruct->faceMask           = faceMask;
+    paramStruct->failOp             = failOp;
+    paramStruct->passOp             = passOp;
+    paramStruct->depthFailOp        = depthFailOp;
+    paramStruct->compareOp          = compareOp;
+}
+
+ANGLE_INLINE void SecondaryCommandBuffer::setStencilTestEnable(VkBool32 stencilTestEnable)
+{
+    SetStencilTestEnableParams *paramStruct =
+        initCommand<SetStencilTestEnableParams>(CommandID::SetStencilTestEnable);
+    paramStruct->stencilTestEnable = stencilTestEnable;
+}
+
 ANGLE_INLINE void SecondaryCommandBuffer::waitEvents(
     uint32_t eventCount,
     const VkEvent *events,
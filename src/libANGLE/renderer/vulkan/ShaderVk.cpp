@@ -78,6 +78,13 @@ std::shared_ptr<WaitableCompileEvent> ShaderVk::compile(const gl::Context *conte
         compileOptions |= SH_USE_ROTATION_SPECIALIZATION_CONSTANT;
     }
 
+    // Let multi-draws that use gl_DrawID be issued as a single indirect draw.
+    if (contextVk->getFeatures().supportsMultiDrawIndirect.enabled &&
+        contextVk->getFeatures().supportsShaderDrawParameters.enabled)
+    {
+        compileOptions |= SH_ADD_DRAW_INDEX_TO_DRAW_ID;
+    }
+
     if (contextVk->getFeatures().enablePreRotateSurfaces.enabled ||
         contextVk->getFeatures().emulatedPrerotation90.enabled ||
         contextVk->getFeatures().emulatedPrerotation180.enabled ||
@@ -46,6 +46,9 @@ constexpr VkImageAspectFlags kDepthStencilAspects =
 
 constexpr angle::SubjectIndex kTextureImageSubjectIndex = 0;
 
+// The minimum amount of data a worker generates at once when generating mipmaps on the CPU.
+constexpr size_t kMinMipmapBandSize = 64 * 1024;
+
 // Test whether a texture level is within the range of levels for which the current image is
 // allocated.  This is used to ensure out-of-range updates are staged in the image, and not
 // attempted to be directly applied.
@@ -164,6 +167,52 @@ bool ForceCPUPathForCopy(RendererVk *renderer, const vk::ImageHelper &image)
     return image.getLayerCount() > 1 && renderer->getFeatures().forceCPUPathForCubeMapCopy.enabled;
 }
 
+// Generates a band of rows (or slices of a 3D image) of a mip level from the previous level.
+class GenerateMipmapBandTask final : public angle::Closure
+{
+  public:
+    GenerateMipmapBandTask(rx::MipGenerationFunction mipGenerationFunction,
+                           size_t sourceWidth,
+                           size_t sourceHeight,
+                           size_t sourceDepth,
+                           const uint8_t *sourceData,
+                           size_t sourceRowPitch,
+                           size_t sourceDepthPitch,
+                           uint8_t *destData,
+                           size_t destRowPitch,
+                           size_t destDepthPitch)
+        : mMipGenerationFunction(mipGenerationFunction),
+          mSourceWidth(sourceWidth),
+          mSourceHeight(sourceHeight),
+          mSourceDepth(sourceDepth),
+          mSourceData(sourceData),
+          mSourceRowPitch(sourceRowPitch),
+          mSourceDepthPitch(sourceDepthPitch),
+          mDestData(destData),
+          mDestRowPitch(destRowPitch),
+          mDestDepthPitch(destDepthPitch)
+    {}
+
+    void operator()() override
+    {
+        mMipGenerationFunction(mSourceWidth, mSourceHeight, mSourceDepth, mSourceData,
+                               mSourceRowPitch, mSourceDepthPitch, mDestData, mDestRowPitch,
+                               mDestDepthPitch);
+    }
+
+  private:
+    rx::MipGenerationFunction mMipGenerationFunction;
+    size_t mSourceWidth;
+    size_t mSourceHeight;
+    size_t mSourceDepth;
+    const uint8_t *mSourceData;
+    size_t mSourceRowPitch;
+    size_t mSourceDepthPitch;
+    uint8_t *mDestData;
+    size_t mDestRowPitch;
+    size_t mDestDepthPitch;
+};
+
 bool CanGenerateMipmapWithCompute(RendererVk *renderer,
                                   VkImageType imageType,
                                   const vk::Format &format,
@@ -1803,18 +1852,12 @@ angle::Result TextureVk::generateMipmapsWithCPU(const gl::Context *context)
     size_t baseLevelAllocationSize   = sourceDepthPitch * baseLevelExtents.depth;
 
     // We now have the base level available to be manipulated in the imageData pointer. Generate all
-    // the missing mipmaps with the slow path. For each layer, use the copied data to generate all
-    // the mips.
-    for (GLuint layer = 0; layer < imageLayerCount; layer++)
-    {
-        size_t bufferOffset = layer * baseLevelAllocationSize;
-
-        ANGLE_TRY(generateMipmapLevelsWithCPU(
-            contextVk, angleFormat, layer, gl::LevelIndex(mState.getEffectiveBaseLevel() + 1),
-            gl::LevelIndex(mState.getMipmapMaxLevel()), baseLevelExtents.width,
-            baseLevelExtents.height, baseLevelExtents.depth, sourceRowPitch, sourceDepthPitch,
-            imageData + bufferOffset));
-    }
+    // the missing mipmaps with the slow path, one level at a time for all layers.
+    ANGLE_TRY(generateMipmapLevelsWithCPU(
+        context, angleFormat, imageLayerCount, gl::LevelIndex(mState.getEffectiveBaseLevel() + 1),
+        gl::LevelIndex(mState.getMipmapMaxLevel()), baseLevelExtents.width,
+        baseLevelExtents.height, baseLevelExtents.depth, sourceRowPitch, sourceDepthPitch,
+        baseLevelAllocationSize, imageData));
 
     ASSERT(!mRedefinedLevels.any());
     return flushImageStagedUpdates(contextVk);
@@ -1837,6 +1880,11 @@ angle::Result TextureVk::generateMipmap(const gl::Context *context)
     vk::LevelIndex maxLevel(mState.getMipmapMaxLevel() - mState.getEffectiveBaseLevel());
     ASSERT(maxLevel != vk::LevelIndex(0));
 
+    if (renderer->getFeatures().forceCPUPathForGenerateMipmap.enabled)
+    {
+        return generateMipmapsWithCPU(context);
+    }
+
     // If it's possible to generate mipmap in compute, that would give the best possible
     // performance on some hardware.
     if (CanGenerateMipmapWithCompute(renderer, mImage->getType(), mImage->getFormat(),
@@ -2762,9 +2810,9 @@ uint32_t TextureVk::getMaxLevelCount() const
     return mState.getMipmapMaxLevel() + 1;
 }
 
-angle::Result TextureVk::generateMipmapLevelsWithCPU(ContextVk *contextVk,
+angle::Result TextureVk::generateMipmapLevelsWithCPU(const gl::Context *context,
                                                      const angle::Format &sourceFormat,
-                                                     GLuint layer,
+                                                     uint32_t layerCount,
                                                      gl::LevelIndex firstMipLevel,
                                                      gl::LevelIndex maxMipLevel,
                                                      const size_t sourceWidth,
@@ -2772,15 +2820,27 @@ angle::Result TextureVk::generateMipmapLevelsWithCPU(ContextVk *contextVk,
                                                      const size_t sourceDepth,
                                                      const size_t sourceRowPitch,
                                                      const size_t sourceDepthPitch,
+                                                     const size_t sourceLayerPitch,
                                                      uint8_t *sourceData)
 {
+    ContextVk *contextVk                                      = vk::GetImpl(context);
+    std::shared_ptr<angle::WorkerThreadPool> workerThreadPool = context->getWorkerThreadPool();
+
     size_t previousLevelWidth      = sourceWidth;
     size_t previousLevelHeight     = sourceHeight;
     size_t previousLevelDepth      = sourceDepth;
-    uint8_t *previousLevelData     = sourceData;
     size_t previousLevelRowPitch   = sourceRowPitch;
     size_t previousLevelDepthPitch = sourceDepthPitch;
 
+    std::vector<uint8_t *> previousLevelData(layerCount);
+    for (uint32_t layer = 0; layer < layerCount; ++layer)
+    {
+        previousLevelData[layer] = sourceData + layer * sourceLayerPitch;
+    }
+
+    std::vector<uint8_t *> destData(layerCount, nullptr);
+    std::vector<std::shared_ptr<angle::WaitableEvent>> waitableEvents;
+
     for (gl::LevelIndex currentMipLevel = firstMipLevel; currentMipLevel <= maxMipLevel;
          ++currentMipLevel)
     {
@@ -2789,8 +2849,6 @@ angle::Result TextureVk::generateMipmapLevelsWithCPU(ContextVk *contextVk,
         size_t mipHeight = std::max<size_t>(1, previousLevelHeight >> 1);
         size_t mipDepth  = std::max<size_t>(1, previousLevelDepth >> 1);
 
-        // With the width and height of the next mip, we can allocate the next buffer we need.
-        uint8_t *destData     = nullptr;
         size_t destRowPitch   = mipWidth * sourceFormat.pixelBytes;
         size_t destDepthPitch = destRowPitch * mipHeight;
 
@@ -2798,23 +2856,78 @@ angle::Result TextureVk::generateMipmapLevelsWithCPU(ContextVk *contextVk,
         gl::Extents mipLevelExtents(static_cast<int>(mipWidth), static_cast<int>(mipHeight),
                                     static_cast<int>(mipDepth));
 
-        ANGLE_TRY(mImage->stageSubresourceUpdateAndGetData(
-            contextVk, mipAllocationSize,
-            gl::ImageIndex::MakeFromType(mState.getType(), currentMipLevel.get(), layer),
-            mipLevelExtents, gl::Offset(), &destData, contextVk->getStagingBuffer()));
+        // With the width and height of the next mip, we can allocate the next buffers we need.
+        // The staging buffer is only ever touched on this thread; the workers just fill in the
+        // allocations.
+        for (uint32_t layer = 0; layer < layerCount; ++layer)
+        {
+            ANGLE_TRY(mImage->stageSubresourceUpdateAndGetData(
+                contextVk, mipAllocationSize,
+                gl::ImageIndex::MakeFromType(mState.getType(), currentMipLevel.get(), layer),
+                mipLevelExtents, gl::Offset(), &destData[layer], contextVk->getStagingBuffer()));
+        }
 
-        // Generate the mipmap into that new buffer
-        sourceFormat.mipGenerationFunction(
-            previousLevelWidth, previousLevelHeight, previousLevelDepth, previousLevelData,
-            previousLevelRowPitch, previousLevelDepthPitch, destData, destRowPitch, destDepthPitch);
+        // Split the level in bands of destination rows, or slices for 3D images, that are
+        // generated in parallel.  Each destination row or slice is filtered from two rows or
+        // slices of the previous level, so the bands are independent.
+        const bool splitSlices    = previousLevelDepth > 1;
+        const size_t destUnits    = splitSlices ? mipDepth : mipHeight;
+        const size_t sourceUnits  = splitSlices ? previousLevelDepth : previousLevelHeight;
+        const size_t sourcePitch  = splitSlices ? previousLevelDepthPitch : previousLevelRowPitch;
+        const size_t destPitch    = splitSlices ? destDepthPitch : destRowPitch;
+        const size_t unitsPerBand = std::max<size_t>(1, kMinMipmapBandSize / destPitch);
+
+        // Small levels are not worth handing to another thread.
+        if (layerCount == 1 && unitsPerBand >= destUnits)
+        {
+            sourceFormat.mipGenerationFunction(previousLevelWidth, previousLevelHeight,
+                                               previousLevelDepth, previousLevelData[0],
+                                               previousLevelRowPitch, previousLevelDepthPitch,
+                                               destData[0], destRowPitch, destDepthPitch);
+        }
+        else
+        {
+            for (uint32_t layer = 0; layer < layerCount; ++layer)
+            {
+                for (size_t firstUnit = 0; firstUnit < destUnits; firstUnit += unitsPerBand)
+                {
+                    // The last band takes whatever is left of the previous level.  For an
+                    // odd-sized level, that includes the trailing row or slice, which the filters
+                    // skip since the destination size rounds down.  A level that is a single row
+                    // or slice has no second one to filter with, so it can't use twice the
+                    // destination size either.
+                    const size_t endUnit         = std::min(firstUnit + unitsPerBand, destUnits);
+                    const size_t bandSourceUnits = endUnit == destUnits
+                                                       ? sourceUnits - 2 * firstUnit
+                                                       : 2 * (endUnit - firstUnit);
+
+                    auto task = std::make_shared<GenerateMipmapBandTask>(
+                        sourceFormat.mipGenerationFunction, previousLevelWidth,
+                        splitSlices ? previousLevelHeight : bandSourceUnits,
+                        splitSlices ? bandSourceUnits : previousLevelDepth,
+                        previousLevelData[layer] + 2 * firstUnit * sourcePitch,
+                        previousLevelRowPitch, previousLevelDepthPitch,
+                        destData[layer] + firstUnit * destPitch, destRowPitch, destDepthPitch);
+                    waitableEvents.push_back(
+                        angle::WorkerThreadPool::PostWorkerTask(workerThreadPool, task));
+                }
+            }
+
+            // The next level is generated from this one, so wait for all the bands to finish.
+            for (std::shared_ptr<angle::WaitableEvent> &waitableEvent : waitableEvents)
+            {
+                waitableEvent->wait();
+            }
+            waitableEvents.clear();
+        }
 
         // Swap for the next iteration
         previousLevelWidth      = mipWidth;
         previousLevelHeight     = mipHeight;
         previousLevelDepth      = mipDepth;
-        previousLevelData       = destData;
         previousLevelRowPitch   = destRowPitch;
         previousLevelDepthPitch = destDepthPitch;
+        std::swap(previousLevelData, destData);
     }
 
     return angle::Result::Continue;
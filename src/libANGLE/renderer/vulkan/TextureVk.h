@@ -353,9 +353,11 @@ class TextureVk : public TextureImpl, public angle::ObserverInterface
 
     angle::Result generateMipmapsWithCPU(const gl::Context *context);
 
-    angle::Result generateMipmapLevelsWithCPU(ContextVk *contextVk,
+    // Generates the levels of all layers from the level above.  Each level is split into bands
+    // that are filtered in parallel on the context's worker thread pool.
+    angle::Result generateMipmapLevelsWithCPU(const gl::Context *context,
                                               const angle::Format &sourceFormat,
-                                              GLuint layer,
+                                              uint32_t layerCount,
                                               gl::LevelIndex firstMipLevel,
                                               gl::LevelIndex maxMipLevel,
                                               const size_t sourceWidth,
@@ -363,6 +365,7 @@ class TextureVk : public TextureImpl, public angle::ObserverInterface
                                               const size_t sourceDepth,
                                               const size_t sourceRowPitch,
                                               const size_t sourceDepthPitch,
+                                              const size_t sourceLayerPitch,
                                               uint8_t *sourceData);
 
     angle::Result copySubImageImpl(const gl::Context *context,
@@ -59,6 +59,9 @@ constexpr uint32_t kOverlayDrawFontBinding          = 4;
 constexpr uint32_t kGenerateMipmapDestinationBinding = 0;
 constexpr uint32_t kGenerateMipmapSourceBinding      = 1;
 
+constexpr uint32_t kTranscodeEtcDestinationBinding = 0;
+constexpr uint32_t kTranscodeEtcSourceBinding      = 1;
+
 constexpr uint32_t kFloatOneAsUint = 0x3F80'0000u;
 
 bool ValidateFloatOneAsUint()
@@ -525,6 +528,15 @@ angle::Result GetUnresolveFrag(
     return vk::InitShaderAndSerial(context, &shader->get(), shaderCode.data(),
                                    shaderCode.size() * 4);
 }
+
+// Transcode modes of EtcToRgba.comp, selected by the push constants.
+constexpr uint32_t kTranscodeEtcModeRgb8       = 0;
+constexpr uint32_t kTranscodeEtcModeRgb8A1     = 1;
+constexpr uint32_t kTranscodeEtcModeRgba8      = 2;
+constexpr uint32_t kTranscodeEtcModeR11        = 3;
+constexpr uint32_t kTranscodeEtcModeR11Signed  = 4;
+constexpr uint32_t kTranscodeEtcModeRg11       = 5;
+constexpr uint32_t kTranscodeEtcModeRg11Signed = 6;
 }  // namespace
 
 const uint32_t UtilsVk::kGenerateMipmapMaxLevels;
@@ -616,6 +628,7 @@ void UtilsVk::destroy(RendererVk *renderer)
     {
         program.destroy(device);
     }
+    mTranscodeEtcProgram.destroy(device);
 
     for (auto &programIter : mUnresolvePrograms)
     {
@@ -903,6 +916,22 @@ angle::Result UtilsVk::ensureGenerateMipmapResourcesInitialized(ContextVk *conte
                                       ArraySize(setSizes), sizeof(GenerateMipmapShaderParams));
 }
 
+angle::Result UtilsVk::ensureTranscodeEtcResourcesInitialized(ContextVk *contextVk)
+{
+    if (mPipelineLayouts[Function::TranscodeEtc].valid())
+    {
+        return angle::Result::Continue;
+    }
+
+    VkDescriptorPoolSize setSizes[2] = {
+        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1},  // decoded texels
+        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1},  // compressed blocks
+    };
+
+    return ensureResourcesInitialized(contextVk, Function::TranscodeEtc, setSizes,
+                                      ArraySize(setSizes), sizeof(TranscodeEtcShaderParams));
+}
+
 angle::Result UtilsVk::ensureUnresolveResourcesInitialized(ContextVk *contextVk,
                                                            Function function,
                                                            uint32_t attachmentCount)
@@ -1013,7 +1042,15 @@ angle::Result UtilsVk::setupProgram(ContextVk *contextVk,
             contextVk, &contextVk->getRenderPassCache(), *pipelineCache, pipelineLayout.get(),
             *pipelineDesc, gl::AttributesMask(), gl::ComponentTypeMask(), &descPtr, &helper));
         helper->updateSerial(serial);
+        helper->updatePendingPipeline(contextVk);
         commandBuffer->bindGraphicsPipeline(helper->getPipeline());
+
+        // The context's dynamic state is overwritten here, so have it reapplied on its next draw.
+        if (contextVk->getFeatures().supportsExtendedDynamicState.enabled)
+        {
+            pipelineDesc->setExtendedDynamicState(commandBuffer);
+            contextVk->invalidateGraphicsDynamicState();
+        }
     }
 
     if (descriptorSet != VK_NULL_HANDLE)
@@ -1035,6 +1072,7 @@ angle::Result UtilsVk::setupProgram(ContextVk *contextVk,
     {
         commandBuffer->pushConstants(pipelineLayout.get(), pushConstantsShaderStage, 0,
                                      static_cast<uint32_t>(pushConstantsSize), pushConstants);
+        contextVk->invalidateDefaultUniformPushConstants();
     }
 
     return angle::Result::Continue;
@@ -1461,7 +1499,7 @@ angle::Result UtilsVk::startRenderPass(ContextVk *contextVk,
                                               vk::ImageLayout::ColorAttachment,
                                               vk::ImageLayout::ColorAttachment);
 
-    ANGLE_TRY(contextVk->beginNewRenderPass(framebuffer, renderArea, renderPassDesc,
+    ANGLE_TRY(contextVk->beginNewRenderPass(framebuffer, {}, renderArea, renderPassDesc,
                                             renderPassAttachmentOps, vk::kAttachmentIndexInvalid,
                                             clearValues, commandBufferOut));
 
@@ -2762,6 +2800,193 @@ angle::Result UtilsVk::unresolve(ContextVk *contextVk,
     return angle::Result::Continue;
 }
 
+angle::Result UtilsVk::transcodeEtc(ContextVk *contextVk,
+                                    vk::ImageHelper *dest,
+                                    vk::BufferHelper *src,
+                                    angle::FormatID compressedFormatID,
+                                    const VkBufferImageCopy &copyRegion)
+{
+    ANGLE_TRY(ensureTranscodeEtcResourcesInitialized(contextVk));
+
+    // ETC2 RGBA8 and EAC RG11 have two blocks one after the other.  EAC is decoded to 16-bit
+    // channels.
+    TranscodeEtcShaderParams shaderParams;
+    uint32_t srcBytesPerBlock  = 8;
+    uint32_t destBytesPerTexel = 4;
+    switch (compressedFormatID)
+    {
+        case angle::FormatID::ETC1_R8G8B8_UNORM_BLOCK:
+        case angle::FormatID::ETC2_R8G8B8_UNORM_BLOCK:
+        case angle::FormatID::ETC2_R8G8B8_SRGB_BLOCK:
+            shaderParams.mode = kTranscodeEtcModeRgb8;
+            break;
+        case angle::FormatID::ETC2_R8G8B8A1_UNORM_BLOCK:
+        case angle::FormatID::ETC2_R8G8B8A1_SRGB_BLOCK:
+            shaderParams.mode = kTranscodeEtcModeRgb8A1;
+            break;
+        case angle::FormatID::ETC2_R8G8B8A8_UNORM_BLOCK:
+        case angle::FormatID::ETC2_R8G8B8A8_SRGB_BLOCK:
+            shaderParams.mode = kTranscodeEtcModeRgba8;
+            srcBytesPerBlock  = 16;
+            break;
+        case angle::FormatID::EAC_R11_UNORM_BLOCK:
+            shaderParams.mode = kTranscodeEtcModeR11;
+            destBytesPerTexel = 2;
+            break;
+        case angle::FormatID::EAC_R11_SNORM_BLOCK:
+            shaderParams.mode = kTranscodeEtcModeR11Signed;
+            destBytesPerTexel = 2;
+            break;
+        case angle::FormatID::EAC_R11G11_UNORM_BLOCK:
+            shaderParams.mode = kTranscodeEtcModeRg11;
+            srcBytesPerBlock  = 16;
+            break;
+        case angle::FormatID::EAC_R11G11_SNORM_BLOCK:
+            shaderParams.mode = kTranscodeEtcModeRg11Signed;
+            srcBytesPerBlock  = 16;
+            break;
+        default:
+            UNREACHABLE();
+            return angle::Result::Stop;
+    }
+
+    // The blocks of each layer or slice follow each other.
+    constexpr uint32_t kBlockSize      = 4;
+    constexpr uint32_t kTexelsPerBlock = kBlockSize * kBlockSize;
+    ASSERT(copyRegion.bufferRowLength % kBlockSize == 0 &&
+           copyRegion.bufferImageHeight % kBlockSize == 0);
+    ASSERT(copyRegion.bufferOffset % sizeof(uint32_t) == 0);
+    ASSERT(copyRegion.imageExtent.depth == 1 || copyRegion.imageSubresource.layerCount == 1);
+
+    const uint32_t blockCountX = copyRegion.bufferRowLength / kBlockSize;
+    const uint32_t blockCountY = copyRegion.bufferImageHeight / kBlockSize;
+    const uint32_t sliceCount =
+        std::max(copyRegion.imageExtent.depth, copyRegion.imageSubresource.layerCount);
+    const uint32_t rowCount = blockCountY * sliceCount;
+
+    const VkDeviceSize srcRowSize  = blockCountX * srcBytesPerBlock;
+    const VkDeviceSize destRowSize = blockCountX * kTexelsPerBlock * destBytesPerTexel;
+    ASSERT(src->getSize() >= copyRegion.bufferOffset + rowCount * srcRowSize);
+
+    // Rows of blocks are decoded in parts that fit in the context's transcode buffer and in a
+    // storage buffer binding.  ShouldTranscodeWithCompute() made sure a single row fits.
+    const VkPhysicalDeviceLimits &limits =
+        contextVk->getRenderer()->getPhysicalDeviceProperties().limits;
+    const VkDeviceSize maxPartSize =
+        std::min<VkDeviceSize>(vk::kTranscodeBufferSize, limits.maxStorageBufferRange / 2);
+    ASSERT(destRowSize <= limits.maxStorageBufferRange / 2);
+    const uint32_t rowsPerPart =
+        static_cast<uint32_t>(std::max<VkDeviceSize>(1, maxPartSize / destRowSize));
+
+    vk::DynamicBuffer *transcodeBuffer = contextVk->getTranscodeBuffer();
+
+    for (uint32_t rowStart = 0; rowStart < rowCount; rowStart += rowsPerPart)
+    {
+        const uint32_t partRowCount = std::min(rowsPerPart, rowCount - rowStart);
+        const uint32_t rowEnd       = rowStart + partRowCount;
+        const VkDeviceSize destSize = partRowCount * destRowSize;
+
+        VkDeviceSize destOffset = 0;
+        ANGLE_TRY(transcodeBuffer->allocate(contextVk, static_cast<size_t>(destSize), nullptr,
+                                            nullptr, &destOffset, nullptr));
+        vk::BufferHelper *decodedBuffer = transcodeBuffer->getCurrentBuffer();
+
+        // The source is bound from an offset with the required alignment, and the shader skips to
+        // the first block.
+        const VkDeviceSize srcOffset = copyRegion.bufferOffset + rowStart * srcRowSize;
+        const VkDeviceSize srcBindingOffset =
+            srcOffset - srcOffset % limits.minStorageBufferOffsetAlignment;
+        shaderParams.srcOffsetDiv4 =
+            static_cast<uint32_t>((srcOffset - srcBindingOffset) / sizeof(uint32_t));
+        shaderParams.blockCountX = blockCountX;
+        shaderParams.blockCount  = partRowCount * blockCountX;
+
+        // Note: the image is expected to be transitioned to TransferDst by the caller, which also
+        // takes care of the barriers between its updates.
+        vk::CommandBufferAccess access;
+        access.onBufferComputeShaderRead(src);
+        access.onBufferComputeShaderWrite(decodedBuffer);
+
+        vk::CommandBuffer *commandBuffer;
+        ANGLE_TRY(contextVk->getOutsideRenderPassCommandBuffer(access, &commandBuffer));
+
+        VkDescriptorSet descriptorSet;
+        vk::RefCountedDescriptorPoolBinding descriptorPoolBinding;
+        ANGLE_TRY(allocateDescriptorSet(contextVk, Function::TranscodeEtc, &descriptorPoolBinding,
+                                        &descriptorSet));
+
+        VkDescriptorBufferInfo buffers[2] = {
+            {decodedBuffer->getBuffer().getHandle(), destOffset, destSize},
+            {src->getBuffer().getHandle(), srcBindingOffset,
+             srcOffset - srcBindingOffset + partRowCount * srcRowSize},
+        };
+        static_assert(kTranscodeEtcDestinationBinding + 1 == kTranscodeEtcSourceBinding,
+                      "Update write info");
+
+        VkWriteDescriptorSet writeInfo = {};
+        writeInfo.sType                = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writeInfo.dstSet               = descriptorSet;
+        writeInfo.dstBinding           = kTranscodeEtcDestinationBinding;
+        writeInfo.descriptorCount      = 2;
+        writeInfo.descriptorType       = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writeInfo.pBufferInfo          = buffers;
+
+        vkUpdateDescriptorSets(contextVk->getDevice(), 1, &writeInfo, 0, nullptr);
+
+        vk::RefCounted<vk::ShaderAndSerial> *shader = nullptr;
+        ANGLE_TRY(contextVk->getShaderLibrary().getEtcToRgba_comp(contextVk, 0, &shader));
+
+        ANGLE_TRY(setupProgram(contextVk, Function::TranscodeEtc, shader, nullptr,
+                               &mTranscodeEtcProgram, nullptr, descriptorSet, &shaderParams,
+                               sizeof(shaderParams), commandBuffer));
+
+        // Each invocation outputs one word.
+        constexpr uint32_t kInvocationsPerGroup = 64;
+        const uint32_t wordCount                = static_cast<uint32_t>(destSize / 4);
+        commandBuffer->dispatch(UnsignedCeilDivide(wordCount, kInvocationsPerGroup), 1, 1);
+        descriptorPoolBinding.reset();
+
+        // Copy the decoded texels to dest, one region per layer or slice in this part.  They have
+        // the same row length as the blocks they were decoded from.
+        vk::CommandBufferAccess copyAccess;
+        copyAccess.onBufferTransferRead(decodedBuffer);
+        ANGLE_TRY(contextVk->getOutsideRenderPassCommandBuffer(copyAccess, &commandBuffer));
+
+        std::vector<VkBufferImageCopy> regions;
+        for (uint32_t slice = rowStart / blockCountY; slice * blockCountY < rowEnd; ++slice)
+        {
+            const uint32_t sliceRowStart = std::max(rowStart, slice * blockCountY);
+            const uint32_t sliceRowEnd   = std::min(rowEnd, (slice + 1) * blockCountY);
+            const uint32_t firstTexelRow = (sliceRowStart - slice * blockCountY) * kBlockSize;
+
+            VkBufferImageCopy region  = copyRegion;
+            region.bufferOffset       = destOffset + (sliceRowStart - rowStart) * destRowSize;
+            region.bufferImageHeight  = 0;
+            region.imageOffset.y      = copyRegion.imageOffset.y + firstTexelRow;
+            region.imageExtent.height = std::min(copyRegion.imageExtent.height - firstTexelRow,
+                                                 (sliceRowEnd - sliceRowStart) * kBlockSize);
+            if (copyRegion.imageExtent.depth > 1)
+            {
+                region.imageOffset.z     = copyRegion.imageOffset.z + slice;
+                region.imageExtent.depth = 1;
+            }
+            else
+            {
+                region.imageSubresource.baseArrayLayer =
+                    copyRegion.imageSubresource.baseArrayLayer + slice;
+                region.imageSubresource.layerCount = 1;
+            }
+            regions.push_back(region);
+        }
+
+        commandBuffer->copyBufferToImage(decodedBuffer->getBuffer().getHandle(), dest->getImage(),
+                                         dest->getCurrentLayout(),
+                                         static_cast<uint32_t>(regions.size()), regions.data());
+    }
+
+    return angle::Result::Continue;
+}
+
 angle::Result UtilsVk::cullOverlayWidgets(ContextVk *contextVk,
                                           vk::BufferHelper *enabledWidgetsBuffer,
                                           vk::ImageHelper *dest,
@@ -8,7 +8,8 @@
 //    buffer clear and copy, image clear and copy, texture mip map generation, etc.
 //
 //    - Convert index buffer:
-//      * Used by VertexArrayVk::convertIndexBufferGPU() to convert a ubyte element array to ushort
+//      * Used by VertexArrayVk::convertIndexBufferUint8() to convert a ubyte element array to
+//        ushort
 //    - Convert vertex buffer:
 //      * Used by VertexArrayVk::convertVertexBufferGPU() to convert vertex attributes from
 //        unsupported formats to their fallbacks.
@@ -23,6 +24,8 @@
 //    - Generate mipmap: Used by TextureVk::generateMipmapsWithCompute().
 //    - Overlay Cull/Draw: Used by OverlayVk to efficiently draw a UI for debugging.
 //    - Mipmap generation: Used by TextureVk to generate mipmaps more efficiently in compute.
+//    - Transcode ETC: Used by ImageHelper::flushStagedUpdates() to decode ETC1, ETC2 and EAC
+//      uploads in compute when these formats are emulated with uncompressed formats.
 //
 
 #ifndef LIBANGLE_RENDERER_VULKAN_UTILSVK_H_
@@ -266,6 +269,17 @@ class UtilsVk : angle::NonCopyable
                             const FramebufferVk *framebuffer,
                             const UnresolveParameters &params);
 
+    // Decodes the |compressedFormatID| blocks staged in |src| at |copyRegion.bufferOffset| and
+    // copies the result to |copyRegion| of |dest|, which is expected to be in the TransferDst
+    // layout.  The region's row length and image height are those of the blocks, i.e. rounded up
+    // to the block size.  ETC2 and EAC formats are decoded to RGBA8, R16 or RG16.  Large uploads
+    // are decoded in parts that fit in the context's transcode buffer.
+    angle::Result transcodeEtc(ContextVk *contextVk,
+                               vk::ImageHelper *dest,
+                               vk::BufferHelper *src,
+                               angle::FormatID compressedFormatID,
+                               const VkBufferImageCopy &copyRegion);
+
     // Overlay utilities.
     angle::Result cullOverlayWidgets(ContextVk *contextVk,
                                      vk::BufferHelper *enabledWidgetsBuffer,
@@ -420,6 +434,15 @@ class UtilsVk : angle::NonCopyable
         uint32_t levelCount   = 0;
     };
 
+    struct TranscodeEtcShaderParams
+    {
+        // Structure matching PushConstants in EtcToRgba.comp
+        uint32_t srcOffsetDiv4 = 0;
+        uint32_t blockCountX   = 0;
+        uint32_t blockCount    = 0;
+        uint32_t mode          = 0;
+    };
+
     ANGLE_DISABLE_STRUCT_PADDING_WARNINGS
 
     // Functions implemented by the class:
@@ -453,9 +476,10 @@ class UtilsVk : angle::NonCopyable
         ConvertIndexIndirectLineLoopBuffer = 19,
         ConvertIndirectLineLoopBuffer      = 20,
         GenerateMipmap                     = 21,
+        TranscodeEtc                       = 22,
 
-        InvalidEnum = 22,
-        EnumCount   = 22,
+        InvalidEnum = 23,
+        EnumCount   = 23,
     };
 
     // Common function that creates the pipeline for the specified function, binds it and prepares
@@ -499,6 +523,7 @@ class UtilsVk : angle::NonCopyable
     angle::Result ensureOverlayCullResourcesInitialized(ContextVk *contextVk);
     angle::Result ensureOverlayDrawResourcesInitialized(ContextVk *contextVk);
     angle::Result ensureGenerateMipmapResourcesInitialized(ContextVk *contextVk);
+    angle::Result ensureTranscodeEtcResourcesInitialized(ContextVk *contextVk);
     angle::Result ensureUnresolveResourcesInitialized(ContextVk *contextVk,
                                                       Function function,
                                                       uint32_t attachmentIndex);
@@ -558,6 +583,7 @@ class UtilsVk : angle::NonCopyable
     vk::ShaderProgramHelper mOverlayDrawPrograms[vk::InternalShader::OverlayDraw_comp::kArrayLen];
     vk::ShaderProgramHelper
         mGenerateMipmapPrograms[vk::InternalShader::GenerateMipmap_comp::kArrayLen];
+    vk::ShaderProgramHelper mTranscodeEtcProgram;
 
     // Unresolve shaders are special as they are generated on the fly due to the large number of
     // combinations.
@@ -49,6 +49,55 @@ ANGLE_INLINE bool BindingIsAligned(const gl::VertexBinding &binding,
     }
 }
 
+// Copies |indexCount| indices to |dst|, expanding uint8 indices to uint16 if Vulkan can't consume
+// them.
+void CopyIndexData(ContextVk *contextVk,
+                   gl::DrawElementsType indexType,
+                   size_t indexCount,
+                   const void *sourcePointer,
+                   uint8_t *dst)
+{
+    if (contextVk->shouldConvertUint8VkIndexType(indexType))
+    {
+        // Unsigned bytes don't have direct support in Vulkan so we have to expand the
+        // memory to a GLushort.
+        const GLubyte *in     = static_cast<const GLubyte *>(sourcePointer);
+        GLushort *expandedDst = reinterpret_cast<GLushort *>(dst);
+        bool primitiveRestart = contextVk->getState().isPrimitiveRestartEnabled();
+
+        constexpr GLubyte kUnsignedByteRestartValue   = 0xFF;
+        constexpr GLushort kUnsignedShortRestartValue = 0xFFFF;
+
+        if (primitiveRestart)
+        {
+            for (size_t index = 0; index < indexCount; index++)
+            {
+                GLushort value = static_cast<GLushort>(in[index]);
+                if (in[index] == kUnsignedByteRestartValue)
+                {
+                    // Convert from 8-bit restart value to 16-bit restart value
+                    value = kUnsignedShortRestartValue;
+                }
+                expandedDst[index] = value;
+            }
+        }
+        else
+        {
+            // Fast path for common case.
+            for (size_t index = 0; index < indexCount; index++)
+            {
+                expandedDst[index] = static_cast<GLushort>(in[index]);
+            }
+        }
+    }
+    else
+    {
+        // The primitive restart value is the same for OpenGL and Vulkan,
+        // so there's no need to perform any conversion.
+        memcpy(dst, sourcePointer, contextVk->getVkIndexTypeSize(indexType) * indexCount);
+    }
+}
+
 angle::Result StreamVertexData(ContextVk *contextVk,
                                vk::DynamicBuffer *dynamicBuffer,
                                const uint8_t *sourceData,
@@ -118,8 +167,7 @@ VertexArrayVk::VertexArrayVk(ContextVk *contextVk, const gl::VertexArrayState &s
       mCurrentArrayBuffers{},
       mCurrentElementArrayBufferOffset(0),
       mCurrentElementArrayBuffer(nullptr),
-      mLineLoopHelper(contextVk->getRenderer()),
-      mDirtyLineLoopTranslation(true)
+      mLineLoopHelper(contextVk->getRenderer())
 {
     RendererVk *renderer          = contextVk->getRenderer();
     vk::BufferHelper &emptyBuffer = contextVk->getEmptyBuffer();
@@ -157,31 +205,61 @@ void VertexArrayVk::destroy(const gl::Context *context)
     mLineLoopHelper.release(contextVk);
 }
 
-angle::Result VertexArrayVk::convertIndexBufferGPU(ContextVk *contextVk,
-                                                   BufferVk *bufferVk,
-                                                   const void *indices)
+angle::Result VertexArrayVk::convertIndexBufferUint8(ContextVk *contextVk,
+                                                     BufferVk *bufferVk,
+                                                     const void *indices)
 {
-    intptr_t offsetIntoSrcData = reinterpret_cast<intptr_t>(indices);
-    size_t srcDataSize         = static_cast<size_t>(bufferVk->getSize()) - offsetIntoSrcData;
-
-    mTranslatedByteIndexData.releaseInFlightBuffers(contextVk);
+    // The indices are converted up to the end of the buffer, so draws starting at the same offset
+    // share the conversion whatever their index count.
+    size_t offsetIntoSrcData = reinterpret_cast<uintptr_t>(indices);
+    size_t srcDataSize       = static_cast<size_t>(bufferVk->getSize()) - offsetIntoSrcData;
+    const IndexConversionDesc desc(gl::DrawElementsType::UnsignedByte, offsetIntoSrcData,
+                                   srcDataSize, contextVk->getState().isPrimitiveRestartEnabled(),
+                                   false);
+
+    IndexConversion conversion;
+    if (!bufferVk->getIndexConversion(contextVk, desc, &conversion))
+    {
+        vk::BufferHelper &bufferHelper = bufferVk->getBuffer();
+        const size_t allocateBytes     = sizeof(GLushort) * srcDataSize;
+        const uint32_t indexCount      = static_cast<uint32_t>(srcDataSize);
 
-    ANGLE_TRY(mTranslatedByteIndexData.allocate(contextVk, sizeof(GLushort) * srcDataSize, nullptr,
-                                                nullptr, &mCurrentElementArrayBufferOffset,
-                                                nullptr));
-    mCurrentElementArrayBuffer = mTranslatedByteIndexData.getCurrentBuffer();
+        if (bufferHelper.isHostVisible() &&
+            !bufferHelper.isCurrentlyInUse(contextVk->getLastCompletedQueueSerial()))
+        {
+            uint8_t *src = nullptr;
+            ANGLE_TRY(bufferVk->mapImpl(contextVk, reinterpret_cast<void **>(&src)));
 
-    vk::BufferHelper *dest = mTranslatedByteIndexData.getCurrentBuffer();
-    vk::BufferHelper *src  = &bufferVk->getBuffer();
+            uint8_t *dst = nullptr;
+            ANGLE_TRY(bufferVk->allocateIndexConversion(contextVk, desc, allocateBytes, indexCount,
+                                                        &dst, &conversion));
+            CopyIndexData(contextVk, gl::DrawElementsType::UnsignedByte, srcDataSize,
+                          src + offsetIntoSrcData, dst);
 
-    // Copy relevant section of the source into destination at allocated offset.  Note that the
-    // offset returned by allocate() above is in bytes. As is the indices offset pointer.
-    UtilsVk::ConvertIndexParameters params = {};
-    params.srcOffset                       = static_cast<uint32_t>(offsetIntoSrcData);
-    params.dstOffset = static_cast<uint32_t>(mCurrentElementArrayBufferOffset);
-    params.maxIndex  = static_cast<uint32_t>(bufferVk->getSize());
+            ANGLE_TRY(bufferVk->unmapReadOnlyImpl(contextVk));
+            ANGLE_TRY(contextVk->flushIndexConversions());
+        }
+        else
+        {
+            ANGLE_TRY(bufferVk->allocateIndexConversion(contextVk, desc, allocateBytes, indexCount,
+                                                        nullptr, &conversion));
+
+            // Copy relevant section of the source into destination at allocated offset.  Note that
+            // the offset returned by allocate() above is in bytes. As is the indices offset
+            // pointer.
+            UtilsVk::ConvertIndexParameters params = {};
+            params.srcOffset                       = static_cast<uint32_t>(offsetIntoSrcData);
+            params.dstOffset                       = static_cast<uint32_t>(conversion.offset);
+            params.maxIndex                        = static_cast<uint32_t>(bufferVk->getSize());
+
+            ANGLE_TRY(contextVk->getUtils().convertIndexBuffer(contextVk, conversion.buffer,
+                                                               &bufferHelper, params));
+        }
+    }
 
-    return contextVk->getUtils().convertIndexBuffer(contextVk, dest, src, params);
+    mCurrentElementArrayBuffer       = conversion.buffer;
+    mCurrentElementArrayBufferOffset = conversion.offset;
+    return angle::Result::Continue;
 }
 
 angle::Result VertexArrayVk::convertIndexBufferIndirectGPU(ContextVk *contextVk,
@@ -285,7 +363,7 @@ angle::Result VertexArrayVk::convertIndexBufferCPU(ContextVk *contextVk,
                                                    size_t indexCount,
                                                    const void *sourcePointer)
 {
-    ASSERT(!mState.getElementArrayBuffer() || indexType == gl::DrawElementsType::UnsignedByte);
+    ASSERT(!mState.getElementArrayBuffer());
 
     mDynamicIndexData.releaseInFlightBuffers(contextVk);
 
@@ -296,45 +374,7 @@ angle::Result VertexArrayVk::convertIndexBufferCPU(ContextVk *contextVk,
     ANGLE_TRY(mDynamicIndexData.allocate(contextVk, amount, &dst, nullptr,
                                          &mCurrentElementArrayBufferOffset, nullptr));
     mCurrentElementArrayBuffer = mDynamicIndexData.getCurrentBuffer();
-    if (contextVk->shouldConvertUint8VkIndexType(indexType))
-    {
-        // Unsigned bytes don't have direct support in Vulkan so we have to expand the
-        // memory to a GLushort.
-        const GLubyte *in     = static_cast<const GLubyte *>(sourcePointer);
-        GLushort *expandedDst = reinterpret_cast<GLushort *>(dst);
-        bool primitiveRestart = contextVk->getState().isPrimitiveRestartEnabled();
-
-        constexpr GLubyte kUnsignedByteRestartValue   = 0xFF;
-        constexpr GLushort kUnsignedShortRestartValue = 0xFFFF;
-
-        if (primitiveRestart)
-        {
-            for (size_t index = 0; index < indexCount; index++)
-            {
-                GLushort value = static_cast<GLushort>(in[index]);
-                if (in[index] == kUnsignedByteRestartValue)
-                {
-                    // Convert from 8-bit restart value to 16-bit restart value
-                    value = kUnsignedShortRestartValue;
-                }
-                expandedDst[index] = value;
-            }
-        }
-        else
-        {
-            // Fast path for common case.
-            for (size_t index = 0; index < indexCount; index++)
-            {
-                expandedDst[index] = static_cast<GLushort>(in[index]);
-            }
-        }
-    }
-    else
-    {
-        // The primitive restart value is the same for OpenGL and Vulkan,
-        // so there's no need to perform any conversion.
-        memcpy(dst, sourcePointer, amount);
-    }
+    CopyIndexData(contextVk, indexType, indexCount, sourcePointer, dst);
     return mDynamicIndexData.flush(contextVk);
 }
 
@@ -460,7 +500,6 @@ angle::Result VertexArrayVk::syncState(const gl::Context *context,
                 mLineLoopBufferFirstIndex.reset();
                 mLineLoopBufferLastIndex.reset();
                 ANGLE_TRY(contextVk->onIndexBufferChange(mCurrentElementArrayBuffer));
-                mDirtyLineLoopTranslation = true;
                 break;
             }
 
@@ -468,7 +507,6 @@ angle::Result VertexArrayVk::syncState(const gl::Context *context,
                 mLineLoopBufferFirstIndex.reset();
                 mLineLoopBufferLastIndex.reset();
                 ANGLE_TRY(contextVk->onIndexBufferChange(mCurrentElementArrayBuffer));
-                mDirtyLineLoopTranslation = true;
                 break;
 
 #define ANGLE_VERTEX_DIRTY_ATTRIB_FUNC(INDEX)                                                 \
@@ -812,26 +850,24 @@ angle::Result VertexArrayVk::handleLineLoop(ContextVk *contextVk,
     if (indexTypeOrInvalid != gl::DrawElementsType::InvalidEnum)
     {
         // Handle GL_LINE_LOOP drawElements.
-        if (mDirtyLineLoopTranslation)
-        {
-            gl::Buffer *elementArrayBuffer = mState.getElementArrayBuffer();
+        gl::Buffer *elementArrayBuffer = mState.getElementArrayBuffer();
 
-            if (!elementArrayBuffer)
-            {
-                ANGLE_TRY(mLineLoopHelper.streamIndices(
-                    contextVk, indexTypeOrInvalid, vertexOrIndexCount,
-                    reinterpret_cast<const uint8_t *>(indices), &mCurrentElementArrayBuffer,
-                    &mCurrentElementArrayBufferOffset, indexCountOut));
-            }
-            else
-            {
-                // When using an element array buffer, 'indices' is an offset to the first element.
-                intptr_t offset                = reinterpret_cast<intptr_t>(indices);
-                BufferVk *elementArrayBufferVk = vk::GetImpl(elementArrayBuffer);
-                ANGLE_TRY(mLineLoopHelper.getIndexBufferForElementArrayBuffer(
-                    contextVk, elementArrayBufferVk, indexTypeOrInvalid, vertexOrIndexCount, offset,
-                    &mCurrentElementArrayBuffer, &mCurrentElementArrayBufferOffset, indexCountOut));
-            }
+        if (!elementArrayBuffer)
+        {
+            ANGLE_TRY(mLineLoopHelper.streamIndices(
+                contextVk, indexTypeOrInvalid, vertexOrIndexCount,
+                reinterpret_cast<const uint8_t *>(indices), &mCurrentElementArrayBuffer,
+                &mCurrentElementArrayBufferOffset, indexCountOut));
+        }
+        else
+        {
+            // When using an element array buffer, 'indices' is an offset to the first element.
+            // The translation is cached by the buffer.
+            intptr_t offset                = reinterpret_cast<intptr_t>(indices);
+            BufferVk *elementArrayBufferVk = vk::GetImpl(elementArrayBuffer);
+            ANGLE_TRY(mLineLoopHelper.getIndexBufferForElementArrayBuffer(
+                contextVk, elementArrayBufferVk, indexTypeOrInvalid, vertexOrIndexCount, offset,
+                &mCurrentElementArrayBuffer, &mCurrentElementArrayBufferOffset, indexCountOut));
         }
 
         // If we've had a drawArrays call with a line loop before, we want to make sure this is
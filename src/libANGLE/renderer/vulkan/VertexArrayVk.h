@@ -94,9 +94,12 @@ class VertexArrayVk : public VertexArrayImpl
 
     vk::BufferHelper *getCurrentElementArrayBuffer() const { return mCurrentElementArrayBuffer; }
 
-    angle::Result convertIndexBufferGPU(ContextVk *contextVk,
-                                        BufferVk *bufferVk,
-                                        const void *indices);
+    // Converts the uint8 indices of |bufferVk|, from |indices| on, to uint16 for Vulkan
+    // implementations that don't support VK_EXT_index_type_uint8.  The conversion is cached by the
+    // buffer until its data changes.
+    angle::Result convertIndexBufferUint8(ContextVk *contextVk,
+                                          BufferVk *bufferVk,
+                                          const void *indices);
 
     angle::Result convertIndexBufferIndirectGPU(ContextVk *contextVk,
                                                 vk::BufferHelper *srcIndirectBuf,
@@ -159,7 +162,6 @@ class VertexArrayVk : public VertexArrayImpl
     vk::LineLoopHelper mLineLoopHelper;
     Optional<GLint> mLineLoopBufferFirstIndex;
     Optional<size_t> mLineLoopBufferLastIndex;
-    bool mDirtyLineLoopTranslation;
 
     // Track client and/or emulated attribs that we have to stream their buffer contents
     gl::AttributesMask mStreamingVertexAttribsMask;
@@ -21,7 +21,9 @@
 #include "libANGLE/renderer/vulkan/VertexArrayVk.h"
 #include "libANGLE/renderer/vulkan/vk_format_utils.h"
 #include "libANGLE/renderer/vulkan/vk_helpers.h"
+#include "libANGLE/trace.h"
 
+#include <algorithm>
 #include <type_traits>
 
 namespace rx
@@ -1153,33 +1155,6 @@ angle::Result InitializeRenderPassFromDesc(ContextVk *contextVk,
     return angle::Result::Continue;
 }
 
-void GetRenderPassAndUpdateCounters(ContextVk *contextVk,
-                                    bool updatePerfCounters,
-                                    RenderPassHelper *renderPassHelper,
-                                    RenderPass **renderPassOut)
-{
-    *renderPassOut = &renderPassHelper->getRenderPass();
-    if (updatePerfCounters)
-    {
-        PerfCounters &counters                   = contextVk->getPerfCounters();
-        const RenderPassPerfCounters &rpCounters = renderPassHelper->getPerfCounters();
-
-        counters.depthClears += rpCounters.depthClears;
-        counters.depthLoads += rpCounters.depthLoads;
-        counters.depthStores += rpCounters.depthStores;
-        counters.stencilClears += rpCounters.stencilClears;
-        counters.stencilLoads += rpCounters.stencilLoads;
-        counters.stencilStores += rpCounters.stencilStores;
-        counters.colorAttachmentUnresolves += rpCounters.colorAttachmentUnresolves;
-        counters.colorAttachmentResolves += rpCounters.colorAttachmentResolves;
-        counters.depthAttachmentUnresolves += rpCounters.depthAttachmentUnresolves;
-        counters.depthAttachmentResolves += rpCounters.depthAttachmentResolves;
-        counters.stencilAttachmentUnresolves += rpCounters.stencilAttachmentUnresolves;
-        counters.stencilAttachmentResolves += rpCounters.stencilAttachmentResolves;
-        counters.readOnlyDepthStencilRenderPasses += rpCounters.readOnlyDepthStencil;
-    }
-}
-
 void InitializeSpecializationInfo(
     const SpecializationConstants &specConsts,
     SpecializationConstantMap<VkSpecializationMapEntry> *specializationEntriesOut,
@@ -1276,6 +1251,34 @@ constexpr angle::PackedEnumMap<gl::ComponentType, VkFormat> kMismatchedComponent
 }};
 }  // anonymous namespace
 
+void GetRenderPassAndUpdateCounters(ContextVk *contextVk,
+                                    bool updatePerfCounters,
+                                    RenderPassHelper *renderPassHelper,
+                                    RenderPass **renderPassOut)
+{
+    *renderPassOut = &renderPassHelper->getRenderPass();
+    renderPassHelper->updateSerial(contextVk->getCurrentQueueSerial());
+    if (updatePerfCounters)
+    {
+        PerfCounters &counters                   = contextVk->getPerfCounters();
+        const RenderPassPerfCounters &rpCounters = renderPassHelper->getPerfCounters();
+
+        counters.depthClears += rpCounters.depthClears;
+        counters.depthLoads += rpCounters.depthLoads;
+        counters.depthStores += rpCounters.depthStores;
+        counters.stencilClears += rpCounters.stencilClears;
+        counters.stencilLoads += rpCounters.stencilLoads;
+        counters.stencilStores += rpCounters.stencilStores;
+        counters.colorAttachmentUnresolves += rpCounters.colorAttachmentUnresolves;
+        counters.colorAttachmentResolves += rpCounters.colorAttachmentResolves;
+        counters.depthAttachmentUnresolves += rpCounters.depthAttachmentUnresolves;
+        counters.depthAttachmentResolves += rpCounters.depthAttachmentResolves;
+        counters.stencilAttachmentUnresolves += rpCounters.stencilAttachmentUnresolves;
+        counters.stencilAttachmentResolves += rpCounters.stencilAttachmentResolves;
+        counters.readOnlyDepthStencilRenderPasses += rpCounters.readOnlyDepthStencil;
+    }
+}
+
 // RenderPassDesc implementation.
 RenderPassDesc::RenderPassDesc()
 {
@@ -1602,6 +1605,7 @@ void GraphicsPipelineDesc::initDefaults(const ContextVk *contextVk)
 
 angle::Result GraphicsPipelineDesc::initializePipeline(
     ContextVk *contextVk,
+    VkPipelineCreateFlags flags,
     const PipelineCache &pipelineCacheVk,
     const RenderPass &compatibleRenderPass,
     const PipelineLayout &pipelineLayout,
@@ -1612,6 +1616,28 @@ angle::Result GraphicsPipelineDesc::initializePipeline(
     const ShaderModule *geometryModule,
     const SpecializationConstants specConsts,
     Pipeline *pipelineOut) const
+{
+    ANGLE_VK_TRY(contextVk, createPipeline(contextVk->getRenderer(), flags, pipelineCacheVk,
+                                           compatibleRenderPass.getHandle(),
+                                           pipelineLayout.getHandle(), activeAttribLocationsMask,
+                                           programAttribsTypeMask, vertexModule, fragmentModule,
+                                           geometryModule, specConsts, pipelineOut));
+    contextVk->getPerfCounters().graphicsPipelineCreations++;
+    return angle::Result::Continue;
+}
+
+VkResult GraphicsPipelineDesc::createPipeline(RendererVk *renderer,
+                                              VkPipelineCreateFlags flags,
+                                              const PipelineCache &pipelineCacheVk,
+                                              VkRenderPass compatibleRenderPass,
+                                              VkPipelineLayout pipelineLayout,
+                                              const gl::AttributesMask &activeAttribLocationsMask,
+                                              const gl::ComponentTypeMask &programAttribsTypeMask,
+                                              const ShaderModule *vertexModule,
+                                              const ShaderModule *fragmentModule,
+                                              const ShaderModule *geometryModule,
+                                              const SpecializationConstants &specConsts,
+                                              Pipeline *pipelineOut) const
 {
     angle::FixedVector<VkPipelineShaderStageCreateInfo, 3> shaderStages;
     VkPipelineVertexInputStateCreateInfo vertexInputState     = {};
@@ -1697,7 +1723,7 @@ angle::Result GraphicsPipelineDesc::initializePipeline(
 
         // Get the corresponding VkFormat for the attrib's format.
         angle::FormatID formatID         = static_cast<angle::FormatID>(packedAttrib.format);
-        const Format &format             = contextVk->getRenderer()->getFormat(formatID);
+        const Format &format             = renderer->getFormat(formatID);
         const angle::Format &angleFormat = format.intendedFormat();
         VkFormat vkFormat =
             packedAttrib.compressed ? format.vkCompressedBufferFormat : format.vkBufferFormat;
@@ -1808,7 +1834,7 @@ angle::Result GraphicsPipelineDesc::initializePipeline(
     rasterLineState.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_LINE_STATE_CREATE_INFO_EXT;
     // Enable Bresenham line rasterization if available and not multisampling.
     if (rasterAndMS.bits.rasterizationSamples <= 1 &&
-        contextVk->getFeatures().bresenhamLineRasterization.enabled)
+        renderer->getFeatures().bresenhamLineRasterization.enabled)
     {
         rasterLineState.lineRasterizationMode = VK_LINE_RASTERIZATION_MODE_BRESENHAM_EXT;
         *pNextPtr                             = &rasterLineState;
@@ -1819,7 +1845,7 @@ angle::Result GraphicsPipelineDesc::initializePipeline(
     provokingVertexState.sType =
         VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_PROVOKING_VERTEX_STATE_CREATE_INFO_EXT;
     // Always set provoking vertex mode to last if available.
-    if (contextVk->getFeatures().provokingVertex.enabled)
+    if (renderer->getFeatures().provokingVertex.enabled)
     {
         provokingVertexState.provokingVertexMode = VK_PROVOKING_VERTEX_MODE_LAST_VERTEX_EXT;
         *pNextPtr                                = &provokingVertexState;
@@ -1833,7 +1859,7 @@ angle::Result GraphicsPipelineDesc::initializePipeline(
     VkPipelineRasterizationDepthClipStateCreateInfoEXT depthClipState = {};
     depthClipState.sType =
         VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_DEPTH_CLIP_STATE_CREATE_INFO_EXT;
-    if (contextVk->getFeatures().depthClamping.enabled)
+    if (renderer->getFeatures().depthClamping.enabled)
     {
         depthClipState.depthClipEnable = VK_TRUE;
         *pNextPtr                      = &depthClipState;
@@ -1842,7 +1868,7 @@ angle::Result GraphicsPipelineDesc::initializePipeline(
 
     VkPipelineRasterizationStateStreamCreateInfoEXT rasterStreamState = {};
     rasterStreamState.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_STREAM_CREATE_INFO_EXT;
-    if (contextVk->getFeatures().supportsTransformFeedbackExtension.enabled)
+    if (renderer->getFeatures().supportsTransformFeedbackExtension.enabled)
     {
         rasterStreamState.rasterizationStream = 0;
         rasterState.pNext                     = &rasterLineState;
@@ -1922,8 +1948,7 @@ angle::Result GraphicsPipelineDesc::initializePipeline(
             // From OpenGL ES clients, this means disabling blending for integer formats.
             if (!angle::Format::Get(mRenderPassDesc[colorIndexGL]).isInt())
             {
-                ASSERT(!contextVk->getRenderer()
-                            ->getFormat(mRenderPassDesc[colorIndexGL])
+                ASSERT(!renderer->getFormat(mRenderPassDesc[colorIndexGL])
                             .actualImageFormat()
                             .isInt());
                 state.blendEnable = VK_TRUE;
@@ -1935,11 +1960,22 @@ angle::Result GraphicsPipelineDesc::initializePipeline(
     }
 
     // Dynamic state
-    angle::FixedVector<VkDynamicState, 1> dynamicStateList;
+    angle::FixedVector<VkDynamicState, 9> dynamicStateList;
     if (IsScissorStateDynamic(mScissor))
     {
         dynamicStateList.push_back(VK_DYNAMIC_STATE_SCISSOR);
     }
+    if (renderer->getFeatures().supportsExtendedDynamicState.enabled)
+    {
+        dynamicStateList.push_back(VK_DYNAMIC_STATE_CULL_MODE_EXT);
+        dynamicStateList.push_back(VK_DYNAMIC_STATE_FRONT_FACE_EXT);
+        dynamicStateList.push_back(VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY_EXT);
+        dynamicStateList.push_back(VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE_EXT);
+        dynamicStateList.push_back(VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE_EXT);
+        dynamicStateList.push_back(VK_DYNAMIC_STATE_DEPTH_COMPARE_OP_EXT);
+        dynamicStateList.push_back(VK_DYNAMIC_STATE_STENCIL_TEST_ENABLE_EXT);
+        dynamicStateList.push_back(VK_DYNAMIC_STATE_STENCIL_OP_EXT);
+    }
 
     VkPipelineDynamicStateCreateInfo dynamicState = {};
     dynamicState.sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
@@ -1947,7 +1983,7 @@ angle::Result GraphicsPipelineDesc::initializePipeline(
     dynamicState.pDynamicStates    = dynamicStateList.data();
 
     createInfo.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-    createInfo.flags               = 0;
+    createInfo.flags               = flags;
     createInfo.stageCount          = static_cast<uint32_t>(shaderStages.size());
     createInfo.pStages             = shaderStages.data();
     createInfo.pVertexInputState   = &vertexInputState;
@@ -1959,15 +1995,39 @@ angle::Result GraphicsPipelineDesc::initializePipeline(
     createInfo.pDepthStencilState  = &depthStencilState;
     createInfo.pColorBlendState    = &blendState;
     createInfo.pDynamicState       = dynamicStateList.empty() ? nullptr : &dynamicState;
-    createInfo.layout              = pipelineLayout.getHandle();
-    createInfo.renderPass          = compatibleRenderPass.getHandle();
+    createInfo.layout              = pipelineLayout;
+    createInfo.renderPass          = compatibleRenderPass;
     createInfo.subpass             = mRasterizationAndMultisampleStateInfo.bits.subpass;
     createInfo.basePipelineHandle  = VK_NULL_HANDLE;
     createInfo.basePipelineIndex   = 0;
 
-    ANGLE_VK_TRY(contextVk,
-                 pipelineOut->initGraphics(contextVk->getDevice(), createInfo, pipelineCacheVk));
-    return angle::Result::Continue;
+    return pipelineOut->initGraphics(renderer->getDevice(), createInfo, pipelineCacheVk);
+}
+
+void GraphicsPipelineDesc::setExtendedDynamicState(CommandBuffer *commandBuffer) const
+{
+    const RasterizationStateBits &rasterBits = mRasterizationAndMultisampleStateInfo.bits;
+    commandBuffer->setCullMode(static_cast<VkCullModeFlags>(rasterBits.cullMode));
+    commandBuffer->setFrontFace(static_cast<VkFrontFace>(rasterBits.frontFace));
+    commandBuffer->setPrimitiveTopology(static_cast<VkPrimitiveTopology>(
+        mInputAssemblyAndColorBlendStateInfo.primitive.topology));
+
+    commandBuffer->setDepthTestEnable(mDepthStencilStateInfo.enable.depthTest);
+    commandBuffer->setDepthWriteEnable(mDepthStencilStateInfo.enable.depthWrite);
+    commandBuffer->setDepthCompareOp(static_cast<VkCompareOp>(
+        mDepthStencilStateInfo.depthCompareOpAndSurfaceRotation.depthCompareOp));
+    commandBuffer->setStencilTestEnable(mDepthStencilStateInfo.enable.stencilTest);
+
+    const StencilOps &front = mDepthStencilStateInfo.front.ops;
+    const StencilOps &back  = mDepthStencilStateInfo.back.ops;
+    commandBuffer->setStencilOp(VK_STENCIL_FACE_FRONT_BIT, static_cast<VkStencilOp>(front.fail),
+                                static_cast<VkStencilOp>(front.pass),
+                                static_cast<VkStencilOp>(front.depthFail),
+                                static_cast<VkCompareOp>(front.compare));
+    commandBuffer->setStencilOp(VK_STENCIL_FACE_BACK_BIT, static_cast<VkStencilOp>(back.fail),
+                                static_cast<VkStencilOp>(back.pass),
+                                static_cast<VkStencilOp>(back.depthFail),
+                                static_cast<VkCompareOp>(back.compare));
 }
 
 void GraphicsPipelineDesc::updateVertexInput(GraphicsPipelineTransitionBits *transition,
@@ -2362,6 +2422,32 @@ void GraphicsPipelineDesc::updateStencilBackFuncs(GraphicsPipelineTransitionBits
     transition->set(ANGLE_GET_TRANSITION_BIT(mDepthStencilStateInfo, backStencilReference));
 }
 
+void GraphicsPipelineDesc::updateStencilFrontReferenceAndMask(
+    GraphicsPipelineTransitionBits *transition,
+    GLint ref,
+    const gl::DepthStencilState &depthStencilState)
+{
+    const uint8_t compareMask = static_cast<uint8_t>(depthStencilState.stencilMask);
+
+    mDepthStencilStateInfo.frontStencilReference = static_cast<uint8_t>(ref);
+    mDepthStencilStateInfo.front.compareMask     = compareMask;
+    transition->set(ANGLE_GET_TRANSITION_BIT(mDepthStencilStateInfo, front));
+    transition->set(ANGLE_GET_TRANSITION_BIT(mDepthStencilStateInfo, frontStencilReference));
+}
+
+void GraphicsPipelineDesc::updateStencilBackReferenceAndMask(
+    GraphicsPipelineTransitionBits *transition,
+    GLint ref,
+    const gl::DepthStencilState &depthStencilState)
+{
+    const uint8_t compareMask = static_cast<uint8_t>(depthStencilState.stencilBackMask);
+
+    mDepthStencilStateInfo.backStencilReference = static_cast<uint8_t>(ref);
+    mDepthStencilStateInfo.back.compareMask     = compareMask;
+    transition->set(ANGLE_GET_TRANSITION_BIT(mDepthStencilStateInfo, back));
+    transition->set(ANGLE_GET_TRANSITION_BIT(mDepthStencilStateInfo, backStencilReference));
+}
+
 void GraphicsPipelineDesc::updateStencilFrontOps(GraphicsPipelineTransitionBits *transition,
                                                  const gl::DepthStencilState &depthStencilState)
 {
@@ -2752,6 +2838,70 @@ const PushConstantRangeArray<PackedPushConstantRange> &PipelineLayoutDesc::getPu
     return mPushConstantRanges;
 }
 
+// GraphicsPipelineCreateTask implementation.
+// Creates a fully optimized graphics pipeline on a worker thread.  The render pass and pipeline
+// layout are copied by handle: their wrappers live in hash maps that may be rehashed while the task
+// runs.  The objects themselves must outlive the task.  The program waits for the task before
+// releasing the shader modules and its pipeline layout (see PipelineHelper::release and
+// ProgramExecutableVk::reset), and the context waits for all its tasks before releasing render
+// passes.  The pipeline cache is owned by the renderer.
+class GraphicsPipelineCreateTask final : public angle::Closure
+{
+  public:
+    GraphicsPipelineCreateTask(RendererVk *renderer,
+                               const PipelineCache &pipelineCacheVk,
+                               const RenderPass &compatibleRenderPass,
+                               const PipelineLayout &pipelineLayout,
+                               const gl::AttributesMask &activeAttribLocationsMask,
+                               const gl::ComponentTypeMask &programAttribsTypeMask,
+                               const ShaderModule *vertexModule,
+                               const ShaderModule *fragmentModule,
+                               const ShaderModule *geometryModule,
+                               const SpecializationConstants &specConsts,
+                               const GraphicsPipelineDesc &desc)
+        : mRenderer(renderer),
+          mPipelineCache(pipelineCacheVk),
+          mCompatibleRenderPass(compatibleRenderPass.getHandle()),
+          mPipelineLayout(pipelineLayout.getHandle()),
+          mActiveAttribLocationsMask(activeAttribLocationsMask),
+          mProgramAttribsTypeMask(programAttribsTypeMask),
+          mVertexModule(vertexModule),
+          mFragmentModule(fragmentModule),
+          mGeometryModule(geometryModule),
+          mSpecConsts(specConsts),
+          mDesc(desc),
+          mResult(VK_NOT_READY)
+    {}
+
+    void operator()() override
+    {
+        ANGLE_TRACE_EVENT0("gpu.angle", "GraphicsPipelineCreateTask");
+        mResult = mDesc.createPipeline(mRenderer, 0, mPipelineCache, mCompatibleRenderPass,
+                                       mPipelineLayout, mActiveAttribLocationsMask,
+                                       mProgramAttribsTypeMask, mVertexModule, mFragmentModule,
+                                       mGeometryModule, mSpecConsts, &mPipeline);
+    }
+
+    VkResult getResult() const { return mResult; }
+    Pipeline &getPipeline() { return mPipeline; }
+
+  private:
+    RendererVk *mRenderer;
+    const PipelineCache &mPipelineCache;
+    const VkRenderPass mCompatibleRenderPass;
+    const VkPipelineLayout mPipelineLayout;
+    const gl::AttributesMask mActiveAttribLocationsMask;
+    const gl::ComponentTypeMask mProgramAttribsTypeMask;
+    const ShaderModule *mVertexModule;
+    const ShaderModule *mFragmentModule;
+    const ShaderModule *mGeometryModule;
+    const SpecializationConstants mSpecConsts;
+    const GraphicsPipelineDesc mDesc;
+
+    VkResult mResult;
+    Pipeline mPipeline;
+};
+
 // PipelineHelper implementation.
 PipelineHelper::PipelineHelper() = default;
 
@@ -2759,9 +2909,64 @@ PipelineHelper::~PipelineHelper() = default;
 
 void PipelineHelper::destroy(VkDevice device)
 {
+    discardPendingPipeline(device);
     mPipeline.destroy(device);
 }
 
+void PipelineHelper::release(ContextVk *contextVk)
+{
+    discardPendingPipeline(contextVk->getDevice());
+    contextVk->addGarbage(&mPipeline);
+}
+
+void PipelineHelper::setPendingPipeline(std::shared_ptr<GraphicsPipelineCreateTask> task,
+                                            std::shared_ptr<angle::WaitableEvent> waitableEvent)
+{
+    ASSERT(!mPendingTask);
+    mPendingTask          = std::move(task);
+    mPendingWaitableEvent = std::move(waitableEvent);
+}
+
+void PipelineHelper::waitForPendingPipeline(ContextVk *contextVk)
+{
+    ASSERT(mPendingTask);
+    mPendingWaitableEvent->wait();
+    onPendingPipelineDone(contextVk);
+}
+
+void PipelineHelper::onPendingPipelineDone(ContextVk *contextVk)
+{
+    ASSERT(mPendingWaitableEvent->isReady());
+
+    // If the pending pipeline failed to compile, keep using the current one.  If there is no
+    // current pipeline, GraphicsPipelineCache creates it on the spot.
+    if (mPendingTask->getResult() == VK_SUCCESS)
+    {
+        // The unoptimized pipeline may still be in use by recorded commands.
+        if (mPipeline.valid())
+        {
+            contextVk->addGarbage(&mPipeline);
+        }
+        mPipeline = std::move(mPendingTask->getPipeline());
+    }
+
+    mPendingTask.reset();
+    mPendingWaitableEvent.reset();
+}
+
+void PipelineHelper::discardPendingPipeline(VkDevice device)
+{
+    if (!mPendingTask)
+    {
+        return;
+    }
+
+    mPendingWaitableEvent->wait();
+    mPendingTask->getPipeline().destroy(device);
+    mPendingTask.reset();
+    mPendingWaitableEvent.reset();
+}
+
 void PipelineHelper::addTransition(GraphicsPipelineTransitionBits bits,
                                    const GraphicsPipelineDesc *desc,
                                    PipelineHelper *pipeline)
@@ -2935,6 +3140,75 @@ FramebufferNonResolveAttachmentMask FramebufferDesc::getUnresolveAttachmentMask(
     return mUnresolveAttachmentMask;
 }
 
+// ImagelessFramebufferDesc implementation.
+ImagelessFramebufferDesc::ImagelessFramebufferDesc()
+{
+    memset(this, 0, sizeof(ImagelessFramebufferDesc));
+}
+
+ImagelessFramebufferDesc::~ImagelessFramebufferDesc() = default;
+
+ImagelessFramebufferDesc::ImagelessFramebufferDesc(const ImagelessFramebufferDesc &other)
+{
+    memcpy(this, &other, sizeof(ImagelessFramebufferDesc));
+}
+
+ImagelessFramebufferDesc &ImagelessFramebufferDesc::operator=(
+    const ImagelessFramebufferDesc &other)
+{
+    memcpy(this, &other, sizeof(ImagelessFramebufferDesc));
+    return *this;
+}
+
+void ImagelessFramebufferDesc::reset(const RenderPassDesc &renderPassDesc,
+                                     uint32_t width,
+                                     uint32_t height)
+{
+    memset(this, 0, sizeof(ImagelessFramebufferDesc));
+    mRenderPassDesc = renderPassDesc;
+    mWidth          = width;
+    mHeight         = height;
+}
+
+void ImagelessFramebufferDesc::addAttachment(
+    const VkFramebufferAttachmentImageInfoKHR &attachmentInfo)
+{
+    ASSERT(mAttachmentCount < kMaxFramebufferAttachments);
+    ASSERT(attachmentInfo.viewFormatCount <= ArraySize(mAttachments[0].viewFormats));
+
+    AttachmentInfo &info = mAttachments[mAttachmentCount++];
+    info.flags           = attachmentInfo.flags;
+    info.usage           = attachmentInfo.usage;
+    info.width           = attachmentInfo.width;
+    info.height          = attachmentInfo.height;
+    info.layerCount      = attachmentInfo.layerCount;
+    info.viewFormatCount = attachmentInfo.viewFormatCount;
+    for (uint32_t formatIndex = 0; formatIndex < attachmentInfo.viewFormatCount; ++formatIndex)
+    {
+        info.viewFormats[formatIndex] = attachmentInfo.pViewFormats[formatIndex];
+    }
+}
+
+size_t ImagelessFramebufferDesc::hash() const
+{
+    // The unused attachments are zero, so only hash the used ones.
+    const size_t validSize = offsetof(ImagelessFramebufferDesc, mAttachments) +
+                             sizeof(mAttachments[0]) * mAttachmentCount;
+    return angle::ComputeGenericHash(this, validSize);
+}
+
+bool ImagelessFramebufferDesc::operator==(const ImagelessFramebufferDesc &other) const
+{
+    if (mAttachmentCount != other.mAttachmentCount)
+    {
+        return false;
+    }
+
+    const size_t validSize = offsetof(ImagelessFramebufferDesc, mAttachments) +
+                             sizeof(mAttachments[0]) * mAttachmentCount;
+    return memcmp(this, &other, validSize) == 0;
+}
+
 // SamplerDesc implementation.
 SamplerDesc::SamplerDesc()
 {
@@ -3132,6 +3406,7 @@ RenderPassHelper &RenderPassHelper::operator=(RenderPassHelper &&other)
 {
     mRenderPass   = std::move(other.mRenderPass);
     mPerfCounters = std::move(other.mPerfCounters);
+    mSerial       = other.mSerial;
     return *this;
 }
 
@@ -3140,6 +3415,11 @@ void RenderPassHelper::destroy(VkDevice device)
     mRenderPass.destroy(device);
 }
 
+void RenderPassHelper::release(ContextVk *contextVk)
+{
+    contextVk->addGarbage(&mRenderPass);
+}
+
 const RenderPass &RenderPassHelper::getRenderPass() const
 {
     return mRenderPass;
@@ -3179,6 +3459,7 @@ void RenderPassCache::destroy(VkDevice device)
         }
     }
     mPayload.clear();
+    mSize = 0;
 }
 
 angle::Result RenderPassCache::addRenderPass(ContextVk *contextVk,
@@ -3242,7 +3523,6 @@ angle::Result RenderPassCache::getRenderPassWithOpsImpl(ContextVk *contextVk,
         auto innerIt = innerCache.find(attachmentOps);
         if (innerIt != innerCache.end())
         {
-            // TODO(jmadill): Could possibly use an MRU cache here.
             vk::GetRenderPassAndUpdateCounters(contextVk, updatePerfCounters, &innerIt->second,
                                                renderPassOut);
             return angle::Result::Continue;
@@ -3261,11 +3541,85 @@ angle::Result RenderPassCache::getRenderPassWithOpsImpl(ContextVk *contextVk,
     auto insertPos         = innerCache.emplace(attachmentOps, std::move(newRenderPass));
     vk::GetRenderPassAndUpdateCounters(contextVk, updatePerfCounters, &insertPos.first->second,
                                        renderPassOut);
+    ++mSize;
 
-    // TODO(jmadill): Trim cache, and pre-populate with the most common RPs on startup.
+    // The new render pass is stamped with the current serial, so trimming can't release it and
+    // erasing other entries doesn't move it.
+    if (mSize > kMaxSize)
+    {
+        trim(contextVk);
+    }
+
+    // TODO(jmadill): Pre-populate with the most common RPs on startup.
     return angle::Result::Continue;
 }
 
+void RenderPassCache::trim(ContextVk *contextVk)
+{
+    // Render passes used since the last submission may be needed by the commands being recorded
+    // (for example to begin the current render pass), so they are never released.
+    const Serial currentSerial = contextVk->getCurrentQueueSerial();
+
+    std::vector<Serial> evictableSerials;
+    for (const auto &outerIt : mPayload)
+    {
+        for (const auto &innerIt : outerIt.second)
+        {
+            if (innerIt.second.getSerial() < currentSerial)
+            {
+                evictableSerials.push_back(innerIt.second.getSerial());
+            }
+        }
+    }
+
+    // Release down to three quarters of the limit so a workload that cycles through slightly more
+    // render passes than the limit doesn't trim on every miss.
+    const size_t trimCount = std::min(mSize - kMaxSize * 3 / 4, evictableSerials.size());
+    if (trimCount == 0)
+    {
+        return;
+    }
+
+    // Pipelines being created on worker threads may reference these render passes.
+    contextVk->waitForPipelineTasks();
+
+    // Find the newest serial that is old enough to be released.
+    auto oldestEnd = evictableSerials.begin() + (trimCount - 1);
+    std::nth_element(evictableSerials.begin(), oldestEnd, evictableSerials.end());
+    const Serial trimSerial = *oldestEnd;
+
+    uint32_t evictionCount = 0;
+    for (auto outerIt = mPayload.begin(); outerIt != mPayload.end();)
+    {
+        InnerCache &innerCache = outerIt->second;
+        for (auto innerIt = innerCache.begin(); innerIt != innerCache.end();)
+        {
+            if (innerIt->second.getSerial() <= trimSerial)
+            {
+                innerIt->second.release(contextVk);
+                innerCache.erase(innerIt++);
+                ++evictionCount;
+            }
+            else
+            {
+                ++innerIt;
+            }
+        }
+
+        if (innerCache.empty())
+        {
+            mPayload.erase(outerIt++);
+        }
+        else
+        {
+            ++outerIt;
+        }
+    }
+
+    mSize -= evictionCount;
+    contextVk->getPerfCounters().renderPassCacheEvictions += evictionCount;
+}
+
 // GraphicsPipelineCache implementation.
 GraphicsPipelineCache::GraphicsPipelineCache() = default;
 
@@ -3290,7 +3644,7 @@ void GraphicsPipelineCache::release(ContextVk *context)
     for (auto &item : mPayload)
     {
         vk::PipelineHelper &pipeline = item.second;
-        context->addGarbage(&pipeline.getPipeline());
+        pipeline.release(context);
     }
 
     mPayload.clear();
@@ -3313,11 +3667,20 @@ angle::Result GraphicsPipelineCache::insertPipeline(
 {
     vk::Pipeline newPipeline;
 
+    // When a worker thread is available to optimize the pipeline, create a cheap unoptimized
+    // pipeline to draw with in the meantime.
+    const bool optimizeAsync =
+        contextVk != nullptr &&
+        contextVk->getFeatures().asyncGraphicsPipelineOptimization.enabled &&
+        contextVk->hasPipelineWorkerPool();
+    const VkPipelineCreateFlags flags =
+        optimizeAsync ? VK_PIPELINE_CREATE_DISABLE_OPTIMIZATION_BIT : 0;
+
     // This "if" is left here for the benefit of VulkanPipelineCachePerfTest.
     if (contextVk != nullptr)
     {
         contextVk->getRenderer()->onNewGraphicsPipeline();
-        ANGLE_TRY(desc.initializePipeline(contextVk, pipelineCacheVk, compatibleRenderPass,
+        ANGLE_TRY(desc.initializePipeline(contextVk, flags, pipelineCacheVk, compatibleRenderPass,
                                           pipelineLayout, activeAttribLocationsMask,
                                           programAttribsTypeMask, vertexModule, fragmentModule,
                                           geometryModule, specConsts, &newPipeline));
@@ -3328,9 +3691,102 @@ angle::Result GraphicsPipelineCache::insertPipeline(
     *descPtrOut       = &insertedItem.first->first;
     *pipelineOut      = &insertedItem.first->second;
 
+    if (optimizeAsync)
+    {
+        auto task = std::make_shared<vk::GraphicsPipelineCreateTask>(
+            contextVk->getRenderer(), pipelineCacheVk, compatibleRenderPass, pipelineLayout,
+            activeAttribLocationsMask, programAttribsTypeMask, vertexModule, fragmentModule,
+            geometryModule, specConsts, desc);
+        std::shared_ptr<angle::WaitableEvent> waitableEvent = contextVk->postPipelineTask(task);
+        if (waitableEvent)
+        {
+            (*pipelineOut)->setPendingPipeline(std::move(task), std::move(waitableEvent));
+        }
+    }
+
     return angle::Result::Continue;
 }
 
+angle::Result GraphicsPipelineCache::finishPendingPipeline(
+    ContextVk *contextVk,
+    const vk::PipelineCache &pipelineCacheVk,
+    const vk::RenderPass &compatibleRenderPass,
+    const vk::PipelineLayout &pipelineLayout,
+    const gl::AttributesMask &activeAttribLocationsMask,
+    const gl::ComponentTypeMask &programAttribsTypeMask,
+    const vk::ShaderModule *vertexModule,
+    const vk::ShaderModule *fragmentModule,
+    const vk::ShaderModule *geometryModule,
+    const vk::SpecializationConstants specConsts,
+    const vk::GraphicsPipelineDesc &desc,
+    vk::PipelineHelper *pipeline)
+{
+    ANGLE_TRACE_EVENT0("gpu.angle", "GraphicsPipelineCache::finishPendingPipeline");
+
+    // The pipeline was requested ahead of time, but its creation hasn't finished yet.
+    pipeline->waitForPendingPipeline(contextVk);
+    if (pipeline->valid())
+    {
+        return angle::Result::Continue;
+    }
+
+    // The worker thread failed to create the pipeline.  Try again so the error is reported.
+    return desc.initializePipeline(contextVk, 0, pipelineCacheVk, compatibleRenderPass,
+                                   pipelineLayout, activeAttribLocationsMask,
+                                   programAttribsTypeMask, vertexModule, fragmentModule,
+                                   geometryModule, specConsts, &pipeline->getPipeline());
+}
+
+void GraphicsPipelineCache::prespecializePipeline(
+    ContextVk *contextVk,
+    const vk::PipelineCache &pipelineCacheVk,
+    const vk::RenderPass &compatibleRenderPass,
+    const vk::PipelineLayout &pipelineLayout,
+    const gl::AttributesMask &activeAttribLocationsMask,
+    const gl::ComponentTypeMask &programAttribsTypeMask,
+    const vk::ShaderModule *vertexModule,
+    const vk::ShaderModule *fragmentModule,
+    const vk::ShaderModule *geometryModule,
+    const vk::SpecializationConstants specConsts,
+    const vk::GraphicsPipelineDesc &desc)
+{
+    ASSERT(contextVk->hasPipelineWorkerPool());
+
+    if (mPayload.find(desc) != mPayload.end())
+    {
+        return;
+    }
+
+    auto task = std::make_shared<vk::GraphicsPipelineCreateTask>(
+        contextVk->getRenderer(), pipelineCacheVk, compatibleRenderPass, pipelineLayout,
+        activeAttribLocationsMask, programAttribsTypeMask, vertexModule, fragmentModule,
+        geometryModule, specConsts, desc);
+    std::shared_ptr<angle::WaitableEvent> waitableEvent = contextVk->postPipelineTask(task);
+    if (!waitableEvent)
+    {
+        return;
+    }
+
+    contextVk->getRenderer()->onNewGraphicsPipeline();
+
+    // The entry has no pipeline until the task finishes.  See getPipeline().
+    auto insertedItem = mPayload.emplace(desc, vk::Pipeline());
+    insertedItem.first->second.setPendingPipeline(std::move(task), std::move(waitableEvent));
+}
+
+void GraphicsPipelineCache::getUsedPipelineDescs(
+    std::vector<vk::GraphicsPipelineDesc> *descsOut) const
+{
+    for (const auto &item : mPayload)
+    {
+        // Pipelines that have never been bound have an invalid serial.
+        if (item.second.getSerial().valid())
+        {
+            descsOut->push_back(item.first);
+        }
+    }
+}
+
 void GraphicsPipelineCache::populate(const vk::GraphicsPipelineDesc &desc, vk::Pipeline &&pipeline)
 {
     auto item = mPayload.find(desc);
@@ -13,6 +13,7 @@
 
 #include "common/Color.h"
 #include "common/FixedVector.h"
+#include "libANGLE/WorkerThread.h"
 #include "libANGLE/renderer/vulkan/vk_utils.h"
 
 namespace rx
@@ -584,6 +585,7 @@ class GraphicsPipelineDesc final
     }
 
     angle::Result initializePipeline(ContextVk *contextVk,
+                                     VkPipelineCreateFlags flags,
                                      const PipelineCache &pipelineCacheVk,
                                      const RenderPass &compatibleRenderPass,
                                      const PipelineLayout &pipelineLayout,
@@ -595,6 +597,28 @@ class GraphicsPipelineDesc final
                                      const SpecializationConstants specConsts,
                                      Pipeline *pipelineOut) const;
 
+    // Same as initializePipeline, but doesn't need a context so it can be called from a worker
+    // thread.  The render pass and pipeline layout are taken by handle, since the objects that
+    // wrap them may move while the worker thread runs.
+    VkResult createPipeline(RendererVk *renderer,
+                            VkPipelineCreateFlags flags,
+                            const PipelineCache &pipelineCacheVk,
+                            VkRenderPass compatibleRenderPass,
+                            VkPipelineLayout pipelineLayout,
+                            const gl::AttributesMask &activeAttribLocationsMask,
+                            const gl::ComponentTypeMask &programAttribsTypeMask,
+                            const ShaderModule *vertexModule,
+                            const ShaderModule *fragmentModule,
+                            const ShaderModule *geometryModule,
+                            const SpecializationConstants &specConsts,
+                            Pipeline *pipelineOut) const;
+
+    // Pipelines created with VK_EXT_extended_dynamic_state ignore the cull mode, front face,
+    // primitive topology (within its class) and depth/stencil test state baked into the
+    // description.  Internal pipelines that set that state directly in the description use this to
+    // record it in the command buffer after binding the pipeline.
+    void setExtendedDynamicState(CommandBuffer *commandBuffer) const;
+
     // Vertex input state. For ES 3.1 this should be separated into binding and attribute.
     void updateVertexInput(GraphicsPipelineTransitionBits *transition,
                            uint32_t attribIndex,
@@ -686,6 +710,14 @@ class GraphicsPipelineDesc final
     void updateStencilBackFuncs(GraphicsPipelineTransitionBits *transition,
                                 GLint ref,
                                 const gl::DepthStencilState &depthStencilState);
+    // With VK_EXT_extended_dynamic_state, the compare op is set along with the stencil ops, so only
+    // the reference and compare mask are part of the pipeline.
+    void updateStencilFrontReferenceAndMask(GraphicsPipelineTransitionBits *transition,
+                                            GLint ref,
+                                            const gl::DepthStencilState &depthStencilState);
+    void updateStencilBackReferenceAndMask(GraphicsPipelineTransitionBits *transition,
+                                           GLint ref,
+                                           const gl::DepthStencilState &depthStencilState);
     void updateStencilFrontOps(GraphicsPipelineTransitionBits *transition,
                                const gl::DepthStencilState &depthStencilState);
     void updateStencilBackOps(GraphicsPipelineTransitionBits *transition,
@@ -725,6 +757,7 @@ class GraphicsPipelineDesc final
         return static_cast<SurfaceRotation>(
             mDepthStencilStateInfo.depthCompareOpAndSurfaceRotation.surfaceRotation);
     }
+    const VkViewport &getViewport() const { return mViewport; }
 
   private:
     void updateSubpass(GraphicsPipelineTransitionBits *transition, uint32_t subpass);
@@ -920,6 +953,7 @@ static_assert(sizeof(SamplerDesc) == 32, "Unexpected SamplerDesc size");
 ANGLE_DISABLE_STRUCT_PADDING_WARNINGS
 
 class PipelineHelper;
+class GraphicsPipelineCreateTask;
 
 struct GraphicsPipelineTransition
 {
@@ -982,6 +1016,7 @@ class PipelineHelper final : angle::NonCopyable
     inline explicit PipelineHelper(Pipeline &&pipeline);
 
     void destroy(VkDevice device);
+    void release(ContextVk *contextVk);
 
     void updateSerial(Serial serial) { mSerial = serial; }
     bool valid() const { return mPipeline.valid(); }
@@ -1009,10 +1044,31 @@ class PipelineHelper final : angle::NonCopyable
                        const GraphicsPipelineDesc *desc,
                        PipelineHelper *pipeline);
 
+    // A pipeline can be created on a worker thread, either to replace one created with
+    // VK_PIPELINE_CREATE_DISABLE_OPTIMIZATION_BIT, or ahead of its first use in which case the
+    // helper has no pipeline until the task finishes.  The pending pipeline is taken the next time
+    // the helper is bound after the task finishes.
+    void setPendingPipeline(std::shared_ptr<GraphicsPipelineCreateTask> task,
+                            std::shared_ptr<angle::WaitableEvent> waitableEvent);
+    bool hasPendingPipeline() const { return mPendingTask != nullptr; }
+    ANGLE_INLINE void updatePendingPipeline(ContextVk *contextVk)
+    {
+        if (mPendingTask && mPendingWaitableEvent->isReady())
+        {
+            onPendingPipelineDone(contextVk);
+        }
+    }
+    void waitForPendingPipeline(ContextVk *contextVk);
+
   private:
+    void onPendingPipelineDone(ContextVk *contextVk);
+    void discardPendingPipeline(VkDevice device);
+
     std::vector<GraphicsPipelineTransition> mTransitions;
     Serial mSerial;
     Pipeline mPipeline;
+    std::shared_ptr<GraphicsPipelineCreateTask> mPendingTask;
+    std::shared_ptr<angle::WaitableEvent> mPendingWaitableEvent;
 };
 
 ANGLE_INLINE PipelineHelper::PipelineHelper(Pipeline &&pipeline) : mPipeline(std::move(pipeline)) {}
@@ -1171,6 +1227,47 @@ class FramebufferDesc
     FramebufferAttachmentArray<ImageOrBufferViewSubresourceSerial> mSerials;
 };
 
+// Describes a framebuffer created with VK_KHR_imageless_framebuffer.  Unlike FramebufferDesc, it
+// doesn't identify the attachments' image views, which are only provided when the render pass
+// begins.  Framebuffers whose attachments have the same formats, sizes and usage can thus use the
+// same VkFramebuffer.
+class ImagelessFramebufferDesc
+{
+  public:
+    ImagelessFramebufferDesc();
+    ~ImagelessFramebufferDesc();
+
+    ImagelessFramebufferDesc(const ImagelessFramebufferDesc &other);
+    ImagelessFramebufferDesc &operator=(const ImagelessFramebufferDesc &other);
+
+    void reset(const RenderPassDesc &renderPassDesc, uint32_t width, uint32_t height);
+    void addAttachment(const VkFramebufferAttachmentImageInfoKHR &attachmentInfo);
+    size_t hash() const;
+
+    bool operator==(const ImagelessFramebufferDesc &other) const;
+
+    uint32_t attachmentCount() const { return mAttachmentCount; }
+
+  private:
+    struct AttachmentInfo
+    {
+        VkImageCreateFlags flags;
+        VkImageUsageFlags usage;
+        uint32_t width;
+        uint32_t height;
+        uint32_t layerCount;
+        uint32_t viewFormatCount;
+        VkFormat viewFormats[2];
+    };
+
+    // The framebuffer is created for a render pass compatible with this one.
+    RenderPassDesc mRenderPassDesc;
+    uint32_t mWidth;
+    uint32_t mHeight;
+    uint32_t mAttachmentCount;
+    FramebufferAttachmentArray<AttachmentInfo> mAttachments;
+};
+
 // Disable warnings about struct padding.
 ANGLE_DISABLE_STRUCT_PADDING_WARNINGS
 
@@ -1208,6 +1305,7 @@ class RenderPassHelper final : angle::NonCopyable
     RenderPassHelper &operator=(RenderPassHelper &&other);
 
     void destroy(VkDevice device);
+    void release(ContextVk *contextVk);
 
     const RenderPass &getRenderPass() const;
     RenderPass &getRenderPass();
@@ -1215,10 +1313,22 @@ class RenderPassHelper final : angle::NonCopyable
     const RenderPassPerfCounters &getPerfCounters() const;
     RenderPassPerfCounters &getPerfCounters();
 
+    void updateSerial(Serial serial) { mSerial = serial; }
+    Serial getSerial() const { return mSerial; }
+
   private:
     RenderPass mRenderPass;
     RenderPassPerfCounters mPerfCounters;
+    // Serial of the last submission that used this render pass, for cache eviction.
+    Serial mSerial;
 };
+
+// Returns the render pass and marks it as used by the current submission.  If requested, the render
+// pass's load/store counters are also accumulated in the context's perf counters.
+void GetRenderPassAndUpdateCounters(ContextVk *contextVk,
+                                    bool updatePerfCounters,
+                                    RenderPassHelper *renderPassHelper,
+                                    RenderPass **renderPassOut);
 }  // namespace vk
 }  // namespace rx
 
@@ -1273,6 +1383,12 @@ struct hash<rx::vk::FramebufferDesc>
     size_t operator()(const rx::vk::FramebufferDesc &key) const { return key.hash(); }
 };
 
+template <>
+struct hash<rx::vk::ImagelessFramebufferDesc>
+{
+    size_t operator()(const rx::vk::ImagelessFramebufferDesc &key) const { return key.hash(); }
+};
+
 template <>
 struct hash<rx::vk::SamplerDesc>
 {
@@ -1293,7 +1409,8 @@ ANGLE_VK_SERIAL_OP(ANGLE_HASH_VK_SERIAL)
 
 namespace rx
 {
-// TODO(jmadill): Add cache trimming/eviction.
+// The cache is bounded.  Once it grows past kMaxSize render passes, the least recently used ones
+// that are not referenced by the commands currently being recorded are released.
 class RenderPassCache final : angle::NonCopyable
 {
   public:
@@ -1313,7 +1430,8 @@ class RenderPassCache final : angle::NonCopyable
             ASSERT(!innerCache.empty());
 
             // Find the first element and return it.
-            *renderPassOut = &innerCache.begin()->second.getRenderPass();
+            vk::GetRenderPassAndUpdateCounters(contextVk, false, &innerCache.begin()->second,
+                                               renderPassOut);
             return angle::Result::Continue;
         }
 
@@ -1325,7 +1443,11 @@ class RenderPassCache final : angle::NonCopyable
                                        const vk::AttachmentOpsArray &attachmentOps,
                                        vk::RenderPass **renderPassOut);
 
+    size_t getSize() const { return mSize; }
+
   private:
+    static constexpr size_t kMaxSize = 128;
+
     angle::Result getRenderPassWithOpsImpl(ContextVk *contextVk,
                                            const vk::RenderPassDesc &desc,
                                            const vk::AttachmentOpsArray &attachmentOps,
@@ -1336,12 +1458,16 @@ class RenderPassCache final : angle::NonCopyable
                                 const vk::RenderPassDesc &desc,
                                 vk::RenderPass **renderPassOut);
 
+    // Releases the least recently used render passes until the cache is back under kMaxSize.
+    void trim(ContextVk *contextVk);
+
     // Use a two-layer caching scheme. The top level matches the "compatible" RenderPass elements.
     // The second layer caches the attachment load/store ops and initial/final layout.
     using InnerCache = angle::HashMap<vk::AttachmentOpsArray, vk::RenderPassHelper>;
     using OuterCache = angle::HashMap<vk::RenderPassDesc, InnerCache>;
 
     OuterCache mPayload;
+    size_t mSize = 0;
 };
 
 // TODO(jmadill): Add cache trimming/eviction.
@@ -1375,6 +1501,15 @@ class GraphicsPipelineCache final : angle::NonCopyable
         {
             *descPtrOut  = &item->first;
             *pipelineOut = &item->second;
+
+            // Prespecialized pipelines may still be being created.
+            if (!item->second.valid() && item->second.hasPendingPipeline())
+            {
+                return finishPendingPipeline(contextVk, pipelineCacheVk, compatibleRenderPass,
+                                             pipelineLayout, activeAttribLocationsMask,
+                                             programAttribsTypeMask, vertexModule, fragmentModule,
+                                             geometryModule, specConsts, desc, &item->second);
+            }
             return angle::Result::Continue;
         }
 
@@ -1384,7 +1519,35 @@ class GraphicsPipelineCache final : angle::NonCopyable
                               pipelineOut);
     }
 
+    // Starts creating the pipeline for |desc| on a worker thread, in anticipation of its use.
+    void prespecializePipeline(ContextVk *contextVk,
+                               const vk::PipelineCache &pipelineCacheVk,
+                               const vk::RenderPass &compatibleRenderPass,
+                               const vk::PipelineLayout &pipelineLayout,
+                               const gl::AttributesMask &activeAttribLocationsMask,
+                               const gl::ComponentTypeMask &programAttribsTypeMask,
+                               const vk::ShaderModule *vertexModule,
+                               const vk::ShaderModule *fragmentModule,
+                               const vk::ShaderModule *geometryModule,
+                               const vk::SpecializationConstants specConsts,
+                               const vk::GraphicsPipelineDesc &desc);
+
+    // Returns the descriptions of the pipelines that have been bound at least once.
+    void getUsedPipelineDescs(std::vector<vk::GraphicsPipelineDesc> *descsOut) const;
+
   private:
+    angle::Result finishPendingPipeline(ContextVk *contextVk,
+                                        const vk::PipelineCache &pipelineCacheVk,
+                                        const vk::RenderPass &compatibleRenderPass,
+                                        const vk::PipelineLayout &pipelineLayout,
+                                        const gl::AttributesMask &activeAttribLocationsMask,
+                                        const gl::ComponentTypeMask &programAttribsTypeMask,
+                                        const vk::ShaderModule *vertexModule,
+                                        const vk::ShaderModule *fragmentModule,
+                                        const vk::ShaderModule *geometryModule,
+                                        const vk::SpecializationConstants specConsts,
+                                        const vk::GraphicsPipelineDesc &desc,
+                                        vk::PipelineHelper *pipeline);
     angle::Result insertPipeline(ContextVk *contextVk,
                                  const vk::PipelineCache &pipelineCacheVk,
                                  const vk::RenderPass &compatibleRenderPass,
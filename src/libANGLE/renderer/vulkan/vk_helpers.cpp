@@ -483,6 +483,53 @@ void HandlePrimitiveRestart(ContextVk *contextVk,
     }
 }
 
+uint32_t GetLineLoopIndexCount(ContextVk *contextVk,
+                               gl::DrawElementsType glIndexType,
+                               GLsizei indexCount,
+                               const uint8_t *srcPtr)
+{
+    if (contextVk->getState().isPrimitiveRestartEnabled())
+    {
+        return GetLineLoopWithRestartIndexCount(glIndexType, indexCount, srcPtr);
+    }
+    return indexCount + 1;
+}
+
+// Writes the indices of the line strip that a line loop is drawn with.
+void WriteLineLoopIndices(ContextVk *contextVk,
+                          gl::DrawElementsType glIndexType,
+                          GLsizei indexCount,
+                          const uint8_t *srcPtr,
+                          uint8_t *indices)
+{
+    if (contextVk->getState().isPrimitiveRestartEnabled())
+    {
+        HandlePrimitiveRestart(contextVk, glIndexType, indexCount, srcPtr, indices);
+    }
+    else
+    {
+        if (contextVk->shouldConvertUint8VkIndexType(glIndexType))
+        {
+            // If vulkan doesn't support uint8 index types, we need to emulate it.
+            VkIndexType indexType = contextVk->getVkIndexType(glIndexType);
+            ASSERT(indexType == VK_INDEX_TYPE_UINT16);
+            uint16_t *indicesDst = reinterpret_cast<uint16_t *>(indices);
+            for (int i = 0; i < indexCount; i++)
+            {
+                indicesDst[i] = srcPtr[i];
+            }
+
+            indicesDst[indexCount] = srcPtr[0];
+        }
+        else
+        {
+            size_t unitSize = contextVk->getVkIndexTypeSize(glIndexType);
+            memcpy(indices, srcPtr, unitSize * indexCount);
+            memcpy(indices + unitSize * indexCount, srcPtr, unitSize);
+        }
+    }
+}
+
 bool HasBothDepthAndStencilAspects(VkImageAspectFlags aspectFlags)
 {
     return IsMaskFlagSet(aspectFlags, kDepthStencilAspects);
@@ -653,6 +700,32 @@ bool CanCopyWithTransferForCopyImage(RendererVk *renderer,
            CanCopyWithTransfer(renderer, srcFormat, srcTilingMode, destFormat, destTilingMode);
 }
 
+// Whether a read of |readFormat| into a pack buffer of |destFormat| can be done by drawing into an
+// image of |destFormat| and copying that to the buffer.  Only channel reordering (such as reading
+// a BGRA window surface as RGBA) is done this way, as that matches PackPixels bit for bit.
+bool CanConvertReadPixelsWithDraw(RendererVk *renderer,
+                                  const angle::Format &readFormat,
+                                  const angle::Format &destFormat)
+{
+    if (!readFormat.isUnorm() || !destFormat.isUnorm() || readFormat.isSRGB ||
+        destFormat.isSRGB || readFormat.isLUMA() || destFormat.isLUMA())
+    {
+        return false;
+    }
+
+    if (readFormat.redBits != destFormat.redBits || readFormat.greenBits != destFormat.greenBits ||
+        readFormat.blueBits != destFormat.blueBits ||
+        (readFormat.alphaBits != 0 && readFormat.alphaBits != destFormat.alphaBits))
+    {
+        return false;
+    }
+
+    const Format &destVkFormat = renderer->getFormat(destFormat.id);
+    return destVkFormat.actualImageFormatID == destFormat.id &&
+           renderer->hasImageFormatFeatureBits(destVkFormat.vkImageFormat,
+                                               VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT);
+}
+
 void ReleaseBufferListToRenderer(RendererVk *renderer, BufferHelperPointerVector *buffers)
 {
     for (std::unique_ptr<BufferHelper> &toFree : *buffers)
@@ -670,6 +743,92 @@ void DestroyBufferList(RendererVk *renderer, BufferHelperPointerVector *buffers)
     }
     buffers->clear();
 }
+
+// Records the formats of the VkImageFormatListCreateInfo in an image create info's pNext chain, if
+// any.  Returns false if there are more formats than can be recorded.
+bool GetImageViewFormats(const void *imageCreateInfoNext, ImageViewFormats *viewFormatsOut)
+{
+    viewFormatsOut->clear();
+
+    for (const VkBaseInStructure *info = reinterpret_cast<const VkBaseInStructure *>(
+             imageCreateInfoNext);
+         info != nullptr; info = info->pNext)
+    {
+        if (info->sType != VK_STRUCTURE_TYPE_IMAGE_FORMAT_LIST_CREATE_INFO_KHR)
+        {
+            continue;
+        }
+
+        const VkImageFormatListCreateInfoKHR *formatList =
+            reinterpret_cast<const VkImageFormatListCreateInfoKHR *>(info);
+        if (formatList->viewFormatCount > ImageViewFormats::max_size())
+        {
+            return false;
+        }
+        for (uint32_t formatIndex = 0; formatIndex < formatList->viewFormatCount; ++formatIndex)
+        {
+            viewFormatsOut->push_back(formatList->pViewFormats[formatIndex]);
+        }
+    }
+
+    return true;
+}
+
+// ETC1, ETC2 and EAC are emulated with RGBA8, R16 and RG16 formats when they are not natively
+// supported.  In that case, the blocks can be staged as is and decoded in compute instead of on the
+// CPU.  The R16_FLOAT and RG16_FLOAT fallbacks of EAC are still decoded on the CPU.
+bool ShouldTranscodeWithCompute(ContextVk *contextVk,
+                                const Format &format,
+                                const gl::Extents &glExtents)
+{
+    if (!contextVk->getFeatures().transcodeEtcWithCompute.enabled)
+    {
+        return false;
+    }
+
+    angle::FormatID expectedImageFormatID;
+    switch (format.intendedFormatID)
+    {
+        case angle::FormatID::ETC1_R8G8B8_UNORM_BLOCK:
+        case angle::FormatID::ETC2_R8G8B8_UNORM_BLOCK:
+        case angle::FormatID::ETC2_R8G8B8A1_UNORM_BLOCK:
+        case angle::FormatID::ETC2_R8G8B8A8_UNORM_BLOCK:
+            expectedImageFormatID = angle::FormatID::R8G8B8A8_UNORM;
+            break;
+        case angle::FormatID::ETC2_R8G8B8_SRGB_BLOCK:
+        case angle::FormatID::ETC2_R8G8B8A1_SRGB_BLOCK:
+        case angle::FormatID::ETC2_R8G8B8A8_SRGB_BLOCK:
+            expectedImageFormatID = angle::FormatID::R8G8B8A8_UNORM_SRGB;
+            break;
+        case angle::FormatID::EAC_R11_UNORM_BLOCK:
+            expectedImageFormatID = angle::FormatID::R16_UNORM;
+            break;
+        case angle::FormatID::EAC_R11_SNORM_BLOCK:
+            expectedImageFormatID = angle::FormatID::R16_SNORM;
+            break;
+        case angle::FormatID::EAC_R11G11_UNORM_BLOCK:
+            expectedImageFormatID = angle::FormatID::R16G16_UNORM;
+            break;
+        case angle::FormatID::EAC_R11G11_SNORM_BLOCK:
+            expectedImageFormatID = angle::FormatID::R16G16_SNORM;
+            break;
+        default:
+            return false;
+    }
+
+    if (format.actualImageFormatID != expectedImageFormatID)
+    {
+        return false;
+    }
+
+    // The decode is split in parts of whole rows of blocks, each of which is bound as a storage
+    // buffer.  If a single row doesn't fit in a storage buffer binding, decode on the CPU.
+    const VkDeviceSize maxStorageBufferRange =
+        contextVk->getRenderer()->getPhysicalDeviceProperties().limits.maxStorageBufferRange;
+    const VkDeviceSize decodedBlockRowSize = static_cast<VkDeviceSize>(
+        roundUpPow2(glExtents.width, 4) * 4 * format.actualImageFormat().pixelBytes);
+    return decodedBlockRowSize <= maxStorageBufferRange / 2;
+}
 }  // anonymous namespace
 
 // This is an arbitrary max. We can change this later if necessary.
@@ -1172,13 +1331,15 @@ void CommandBufferHelper::onImageHelperRelease(const ImageHelper *image)
     }
 }
 
-void CommandBufferHelper::beginRenderPass(const Framebuffer &framebuffer,
-                                          const gl::Rectangle &renderArea,
-                                          const RenderPassDesc &renderPassDesc,
-                                          const AttachmentOpsArray &renderPassAttachmentOps,
-                                          const PackedAttachmentIndex depthStencilAttachmentIndex,
-                                          const PackedClearValuesArray &clearValues,
-                                          CommandBuffer **commandBufferOut)
+void CommandBufferHelper::beginRenderPass(
+    const Framebuffer &framebuffer,
+    const FramebufferAttachmentsVector<VkImageView> &imagelessAttachmentViews,
+    const gl::Rectangle &renderArea,
+    const RenderPassDesc &renderPassDesc,
+    const AttachmentOpsArray &renderPassAttachmentOps,
+    const PackedAttachmentIndex depthStencilAttachmentIndex,
+    const PackedClearValuesArray &clearValues,
+    CommandBuffer **commandBufferOut)
 {
     ASSERT(mIsRenderPassCommandBuffer);
     ASSERT(empty());
@@ -1187,9 +1348,10 @@ void CommandBufferHelper::beginRenderPass(const Framebuffer &framebuffer,
     mAttachmentOps               = renderPassAttachmentOps;
     mDepthStencilAttachmentIndex = depthStencilAttachmentIndex;
     mFramebuffer.setHandle(framebuffer.getHandle());
-    mRenderArea       = renderArea;
-    mClearValues      = clearValues;
-    *commandBufferOut = &mCommandBuffer;
+    mImagelessAttachmentViews = imagelessAttachmentViews;
+    mRenderArea               = renderArea;
+    mClearValues              = clearValues;
+    *commandBufferOut         = &mCommandBuffer;
 
     mRenderPassStarted = true;
     mCounter++;
@@ -1366,6 +1528,17 @@ angle::Result CommandBufferHelper::flushToPrimary(const angle::FeaturesVk &featu
         beginInfo.clearValueCount = static_cast<uint32_t>(mRenderPassDesc.attachmentCount());
         beginInfo.pClearValues    = mClearValues.data();
 
+        // Imageless framebuffers take their attachments when the render pass begins.
+        VkRenderPassAttachmentBeginInfoKHR attachmentBeginInfo = {};
+        if (!mImagelessAttachmentViews.empty())
+        {
+            attachmentBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_ATTACHMENT_BEGIN_INFO_KHR;
+            attachmentBeginInfo.attachmentCount =
+                static_cast<uint32_t>(mImagelessAttachmentViews.size());
+            attachmentBeginInfo.pAttachments = mImagelessAttachmentViews.data();
+            beginInfo.pNext                  = &attachmentBeginInfo;
+        }
+
         // Run commands inside the RenderPass.
         primary->beginRenderPass(beginInfo, VK_SUBPASS_CONTENTS_INLINE);
         mCommandBuffer.executeCommands(primary->getHandle());
@@ -1402,12 +1575,15 @@ angle::Result CommandBufferHelper::flushToPrimary(const angle::FeaturesVk &featu
     return angle::Result::Continue;
 }
 
-void CommandBufferHelper::updateRenderPassForResolve(Framebuffer *newFramebuffer,
-                                                     const RenderPassDesc &renderPassDesc)
+void CommandBufferHelper::updateRenderPassForResolve(
+    Framebuffer *newFramebuffer,
+    const FramebufferAttachmentsVector<VkImageView> &imagelessAttachmentViews,
+    const RenderPassDesc &renderPassDesc)
 {
     ASSERT(newFramebuffer);
     mFramebuffer.setHandle(newFramebuffer->getHandle());
-    mRenderPassDesc = renderPassDesc;
+    mImagelessAttachmentViews = imagelessAttachmentViews;
+    mRenderPassDesc           = renderPassDesc;
 }
 
 // Helper functions used below
@@ -1522,6 +1698,7 @@ void CommandBufferHelper::reset()
         mDepthInvalidateArea               = gl::Rectangle();
         mStencilInvalidateArea             = gl::Rectangle();
         mRenderPassUsedImages.clear();
+        mImagelessAttachmentViews.clear();
         mDepthStencilImage        = nullptr;
         mDepthStencilResolveImage = nullptr;
         mReadOnlyDepthStencilMode = false;
@@ -2325,18 +2502,25 @@ angle::Result DynamicQueryPool::init(ContextVk *contextVk, VkQueryType type, uin
 {
     ANGLE_TRY(initEntryPool(contextVk, poolSize));
 
-    mQueryType = type;
+    mQueryType   = type;
+    mResultCount = type == VK_QUERY_TYPE_TRANSFORM_FEEDBACK_STREAM_EXT ? 2 : 1;
     ANGLE_TRY(allocateNewPool(contextVk));
 
     return angle::Result::Continue;
 }
 
-void DynamicQueryPool::destroy(VkDevice device)
+void DynamicQueryPool::destroy(RendererVk *renderer)
 {
     for (QueryPool &queryPool : mPools)
     {
-        queryPool.destroy(device);
+        queryPool.destroy(renderer->getDevice());
+    }
+
+    for (std::unique_ptr<BufferHelper> &resultBuffer : mResultBuffers)
+    {
+        resultBuffer->destroy(renderer);
     }
+    mResultBuffers.clear();
 
     destroyEntryPool();
 }
@@ -2365,6 +2549,7 @@ void DynamicQueryPool::freeQuery(ContextVk *contextVk, QueryHelper *query)
         ASSERT(getQueryPool(poolIndex).valid());
 
         onEntryFreed(contextVk, poolIndex);
+        contextVk->removeQueryResultCopies({this, poolIndex, query->mQuery});
 
         query->deinit();
     }
@@ -2388,9 +2573,105 @@ angle::Result DynamicQueryPool::allocateNewPool(ContextVk *contextVk)
 
     ANGLE_VK_TRY(contextVk, queryPool.init(contextVk->getDevice(), queryPoolInfo));
 
+    VkBufferCreateInfo bufferInfo    = {};
+    bufferInfo.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.flags                 = 0;
+    bufferInfo.size                  = mPoolSize * getResultStride();
+    bufferInfo.usage                 = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    bufferInfo.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+    bufferInfo.queueFamilyIndexCount = 0;
+    bufferInfo.pQueueFamilyIndices   = nullptr;
+
+    std::unique_ptr<BufferHelper> resultBuffer = std::make_unique<BufferHelper>();
+    ANGLE_TRY(resultBuffer->init(contextVk, bufferInfo,
+                                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                     VK_MEMORY_PROPERTY_HOST_CACHED_BIT));
+
+    uint8_t *mappedMemory;
+    ANGLE_TRY(resultBuffer->map(contextVk, &mappedMemory));
+
+    mResultBuffers.push_back(std::move(resultBuffer));
+
     return allocateNewEntryPool(contextVk, std::move(queryPool));
 }
 
+// static
+uint32_t DynamicQueryPool::CopyResults(CommandBuffer *commandBuffer,
+                                       std::vector<QueryResultCopy> *copies)
+{
+    std::sort(copies->begin(), copies->end(),
+              [](const QueryResultCopy &lhs, const QueryResultCopy &rhs) {
+                  if (lhs.dynamicQueryPool != rhs.dynamicQueryPool)
+                  {
+                      return std::less<const DynamicQueryPool *>()(lhs.dynamicQueryPool,
+                                                                   rhs.dynamicQueryPool);
+                  }
+                  if (lhs.queryPoolIndex != rhs.queryPoolIndex)
+                  {
+                      return lhs.queryPoolIndex < rhs.queryPoolIndex;
+                  }
+                  return lhs.query < rhs.query;
+              });
+
+    // The results are copied with the wait bit, so the copy is ordered after the queries become
+    // available.  The host visibility of the results is guaranteed by the barrier flushImpl
+    // records for host-visible buffer writes.
+    constexpr VkQueryResultFlags kFlags = VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT;
+
+    uint32_t copyCount = 0;
+    size_t rangeStart  = 0;
+    while (rangeStart < copies->size())
+    {
+        const QueryResultCopy &first = (*copies)[rangeStart];
+
+        // Extend the range over the following queries of the same pool.  The same query may be
+        // listed more than once if it was reused before the copies were recorded.
+        size_t rangeEnd    = rangeStart + 1;
+        uint32_t lastQuery = first.query;
+        while (rangeEnd < copies->size())
+        {
+            const QueryResultCopy &next = (*copies)[rangeEnd];
+            if (next.dynamicQueryPool != first.dynamicQueryPool ||
+                next.queryPoolIndex != first.queryPoolIndex || next.query > lastQuery + 1)
+            {
+                break;
+            }
+            lastQuery = next.query;
+            ++rangeEnd;
+        }
+
+        const DynamicQueryPool *dynamicQueryPool = first.dynamicQueryPool;
+        const VkDeviceSize stride                = dynamicQueryPool->getResultStride();
+        commandBuffer->copyQueryPoolResults(
+            dynamicQueryPool->getQueryPool(first.queryPoolIndex).getHandle(), first.query,
+            lastQuery - first.query + 1,
+            dynamicQueryPool->mResultBuffers[first.queryPoolIndex]->getBuffer(),
+            first.query * stride, stride, kFlags);
+        ++copyCount;
+
+        rangeStart = rangeEnd;
+    }
+
+    return copyCount;
+}
+
+angle::Result DynamicQueryPool::getCopiedResult(ContextVk *contextVk,
+                                                size_t queryPoolIndex,
+                                                uint32_t query,
+                                                QueryResult *resultOut) const
+{
+    const VkDeviceSize stride = getResultStride();
+    ASSERT(resultOut->getDataSize() <= stride);
+
+    BufferHelper *resultBuffer = mResultBuffers[queryPoolIndex].get();
+    ANGLE_TRY(resultBuffer->invalidate(contextVk->getRenderer(), query * stride, stride));
+
+    memcpy(resultOut->getPointerToResults(), resultBuffer->getMappedMemory() + query * stride,
+           resultOut->getDataSize());
+
+    return angle::Result::Continue;
+}
+
 // QueryHelper implementation
 QueryHelper::QueryHelper() : mDynamicQueryPool(nullptr), mQueryPoolIndex(0), mQuery(0) {}
 
@@ -2450,6 +2731,15 @@ void QueryHelper::endQueryImpl(ContextVk *contextVk, CommandBuffer *commandBuffe
     // Query results are available after endQuery, retain this query so that we get its serial
     // updated which is used to indicate that query results are (or will be) available.
     retain(&contextVk->getResourceUseList());
+
+    onQueryEnded(contextVk);
+}
+
+void QueryHelper::onQueryEnded(ContextVk *contextVk)
+{
+    // The copy can't be recorded in the render pass, so it's deferred until the commands are
+    // flushed, where it's batched with the copies of the other queries.
+    contextVk->addQueryResultCopy({mDynamicQueryPool, mQueryPoolIndex, mQuery});
 }
 
 angle::Result QueryHelper::beginQuery(ContextVk *contextVk)
@@ -2510,6 +2800,7 @@ angle::Result QueryHelper::flushAndWriteTimestamp(ContextVk *contextVk)
     CommandBuffer *commandBuffer;
     ANGLE_TRY(contextVk->getOutsideRenderPassCommandBuffer({}, &commandBuffer));
     writeTimestamp(contextVk, commandBuffer);
+    onQueryEnded(contextVk);
     return angle::Result::Continue;
 }
 
@@ -2587,6 +2878,21 @@ angle::Result QueryHelper::getUint64Result(ContextVk *contextVk, QueryResult *re
     return angle::Result::Continue;
 }
 
+angle::Result QueryHelper::getCopiedResult(ContextVk *contextVk, QueryResult *resultOut)
+{
+    ASSERT(valid());
+    ASSERT(!isCurrentlyInUse(contextVk->getLastCompletedQueueSerial()));
+
+    // A query that was never written to the command buffer has nothing to read back.
+    if (!mUse.getSerial().valid())
+    {
+        *resultOut = 0;
+        return angle::Result::Continue;
+    }
+
+    return mDynamicQueryPool->getCopiedResult(contextVk, mQueryPoolIndex, mQuery, resultOut);
+}
+
 // DynamicSemaphorePool implementation
 DynamicSemaphorePool::DynamicSemaphorePool() = default;
 
@@ -2749,44 +3055,61 @@ angle::Result LineLoopHelper::getIndexBufferForElementArrayBuffer(ContextVk *con
                                                                   VkDeviceSize *bufferOffsetOut,
                                                                   uint32_t *indexCountOut)
 {
-    if (glIndexType == gl::DrawElementsType::UnsignedByte ||
-        contextVk->getState().isPrimitiveRestartEnabled())
+    // The translated indices are cached by the element array buffer until its data changes, so
+    // drawing the same line loops again doesn't translate them again.
+    const bool primitiveRestart = contextVk->getState().isPrimitiveRestartEnabled();
+    const IndexConversionDesc desc(glIndexType, elementArrayOffset, indexCount, primitiveRestart,
+                                   true);
+
+    IndexConversion conversion;
+    if (!elementArrayBufferVk->getIndexConversion(contextVk, desc, &conversion))
     {
-        ANGLE_TRACE_EVENT0("gpu.angle", "LineLoopHelper::getIndexBufferForElementArrayBuffer");
+        size_t unitSize = contextVk->getVkIndexTypeSize(glIndexType);
 
-        void *srcDataMapping = nullptr;
-        ANGLE_TRY(elementArrayBufferVk->mapImpl(contextVk, &srcDataMapping));
-        ANGLE_TRY(streamIndices(contextVk, glIndexType, indexCount,
-                                static_cast<const uint8_t *>(srcDataMapping) + elementArrayOffset,
-                                bufferOut, bufferOffsetOut, indexCountOut));
-        ANGLE_TRY(elementArrayBufferVk->unmapImpl(contextVk));
-        return angle::Result::Continue;
+        if (contextVk->shouldConvertUint8VkIndexType(glIndexType) || primitiveRestart)
+        {
+            ANGLE_TRACE_EVENT0("gpu.angle", "LineLoopHelper::getIndexBufferForElementArrayBuffer");
+
+            void *srcDataMapping = nullptr;
+            ANGLE_TRY(elementArrayBufferVk->mapImpl(contextVk, &srcDataMapping));
+            const uint8_t *srcPtr =
+                static_cast<const uint8_t *>(srcDataMapping) + elementArrayOffset;
+
+            uint32_t numOutIndices =
+                GetLineLoopIndexCount(contextVk, glIndexType, indexCount, srcPtr);
+            uint8_t *indices = nullptr;
+            ANGLE_TRY(elementArrayBufferVk->allocateIndexConversion(
+                contextVk, desc, unitSize * numOutIndices, numOutIndices, &indices, &conversion));
+            WriteLineLoopIndices(contextVk, glIndexType, indexCount, srcPtr, indices);
+
+            ANGLE_TRY(elementArrayBufferVk->unmapReadOnlyImpl(contextVk));
+            ANGLE_TRY(contextVk->flushIndexConversions());
+        }
+        else
+        {
+            size_t allocateBytes = unitSize * (indexCount + 1) + 1;
+            ANGLE_TRY(elementArrayBufferVk->allocateIndexConversion(
+                contextVk, desc, allocateBytes, indexCount + 1, nullptr, &conversion));
+
+            VkDeviceSize sourceOffset = static_cast<VkDeviceSize>(elementArrayOffset);
+            uint64_t unitCount        = static_cast<VkDeviceSize>(indexCount);
+
+            angle::FixedVector<VkBufferCopy, 3> copies = {
+                {sourceOffset, conversion.offset, unitCount * unitSize},
+                {sourceOffset, conversion.offset + unitCount * unitSize, unitSize},
+            };
+            if (contextVk->getRenderer()->getFeatures().extraCopyBufferRegion.enabled)
+                copies.push_back({sourceOffset, conversion.offset + (unitCount + 1) * unitSize, 1});
+
+            ANGLE_TRY(elementArrayBufferVk->copyToBufferImpl(
+                contextVk, conversion.buffer, static_cast<uint32_t>(copies.size()),
+                copies.data()));
+        }
     }
 
-    *indexCountOut = indexCount + 1;
-
-    uint32_t *indices    = nullptr;
-    size_t unitSize      = contextVk->getVkIndexTypeSize(glIndexType);
-    size_t allocateBytes = unitSize * (indexCount + 1) + 1;
-
-    mDynamicIndexBuffer.releaseInFlightBuffers(contextVk);
-    ANGLE_TRY(mDynamicIndexBuffer.allocate(contextVk, allocateBytes,
-                                           reinterpret_cast<uint8_t **>(&indices), nullptr,
-                                           bufferOffsetOut, nullptr));
-    *bufferOut = mDynamicIndexBuffer.getCurrentBuffer();
-
-    VkDeviceSize sourceOffset                  = static_cast<VkDeviceSize>(elementArrayOffset);
-    uint64_t unitCount                         = static_cast<VkDeviceSize>(indexCount);
-    angle::FixedVector<VkBufferCopy, 3> copies = {
-        {sourceOffset, *bufferOffsetOut, unitCount * unitSize},
-        {sourceOffset, *bufferOffsetOut + unitCount * unitSize, unitSize},
-    };
-    if (contextVk->getRenderer()->getFeatures().extraCopyBufferRegion.enabled)
-        copies.push_back({sourceOffset, *bufferOffsetOut + (unitCount + 1) * unitSize, 1});
-
-    ANGLE_TRY(elementArrayBufferVk->copyToBufferImpl(
-        contextVk, *bufferOut, static_cast<uint32_t>(copies.size()), copies.data()));
-    ANGLE_TRY(mDynamicIndexBuffer.flush(contextVk));
+    *bufferOut       = conversion.buffer;
+    *bufferOffsetOut = conversion.offset;
+    *indexCountOut   = conversion.indexCount;
     return angle::Result::Continue;
 }
 
@@ -2802,43 +3125,15 @@ angle::Result LineLoopHelper::streamIndices(ContextVk *contextVk,
 
     uint8_t *indices = nullptr;
 
-    uint32_t numOutIndices = indexCount + 1;
-    if (contextVk->getState().isPrimitiveRestartEnabled())
-    {
-        numOutIndices = GetLineLoopWithRestartIndexCount(glIndexType, indexCount, srcPtr);
-    }
-    *indexCountOut       = numOutIndices;
-    size_t allocateBytes = unitSize * numOutIndices;
+    uint32_t numOutIndices = GetLineLoopIndexCount(contextVk, glIndexType, indexCount, srcPtr);
+    *indexCountOut         = numOutIndices;
+    size_t allocateBytes   = unitSize * numOutIndices;
     ANGLE_TRY(mDynamicIndexBuffer.allocate(contextVk, allocateBytes,
                                            reinterpret_cast<uint8_t **>(&indices), nullptr,
                                            bufferOffsetOut, nullptr));
     *bufferOut = mDynamicIndexBuffer.getCurrentBuffer();
 
-    if (contextVk->getState().isPrimitiveRestartEnabled())
-    {
-        HandlePrimitiveRestart(contextVk, glIndexType, indexCount, srcPtr, indices);
-    }
-    else
-    {
-        if (contextVk->shouldConvertUint8VkIndexType(glIndexType))
-        {
-            // If vulkan doesn't support uint8 index types, we need to emulate it.
-            VkIndexType indexType = contextVk->getVkIndexType(glIndexType);
-            ASSERT(indexType == VK_INDEX_TYPE_UINT16);
-            uint16_t *indicesDst = reinterpret_cast<uint16_t *>(indices);
-            for (int i = 0; i < indexCount; i++)
-            {
-                indicesDst[i] = srcPtr[i];
-            }
-
-            indicesDst[indexCount] = srcPtr[0];
-        }
-        else
-        {
-            memcpy(indices, srcPtr, unitSize * indexCount);
-            memcpy(indices + unitSize * indexCount, srcPtr, unitSize);
-        }
-    }
+    WriteLineLoopIndices(contextVk, glIndexType, indexCount, srcPtr, indices);
 
     ANGLE_TRY(mDynamicIndexBuffer.flush(contextVk));
     return angle::Result::Continue;
@@ -3403,6 +3698,9 @@ ImageHelper::ImageHelper(ImageHelper &&other)
       mImageType(other.mImageType),
       mTilingMode(other.mTilingMode),
       mUsage(other.mUsage),
+      mCreateFlags(other.mCreateFlags),
+      mViewFormats(other.mViewFormats),
+      mHasKnownCreateInfo(other.mHasKnownCreateInfo),
       mExtents(other.mExtents),
       mFormat(other.mFormat),
       mSamples(other.mSamples),
@@ -3418,6 +3716,7 @@ ImageHelper::ImageHelper(ImageHelper &&other)
       mLayerCount(other.mLayerCount),
       mLevelCount(other.mLevelCount),
       mStagingBuffer(std::move(other.mStagingBuffer)),
+      mTranscodeStagingBuffer(std::move(other.mTranscodeStagingBuffer)),
       mSubresourceUpdates(std::move(other.mSubresourceUpdates)),
       mCurrentSingleClearValue(std::move(other.mCurrentSingleClearValue)),
       mContentDefined(std::move(other.mContentDefined)),
@@ -3437,6 +3736,8 @@ void ImageHelper::resetCachedProperties()
     mImageType                   = VK_IMAGE_TYPE_2D;
     mTilingMode                  = VK_IMAGE_TILING_OPTIMAL;
     mUsage                       = 0;
+    mCreateFlags                 = 0;
+    mHasKnownCreateInfo          = false;
     mExtents                     = {};
     mFormat                      = nullptr;
     mSamples                     = 1;
@@ -3451,6 +3752,7 @@ void ImageHelper::resetCachedProperties()
     mLevelCount                  = 0;
     mExternalFormat              = 0;
     mCurrentSingleClearValue.reset();
+    mViewFormats.clear();
 
     setEntireContentUndefined();
 }
@@ -3613,7 +3915,9 @@ angle::Result ImageHelper::initExternal(Context *context,
     imageInfo.pQueueFamilyIndices   = nullptr;
     imageInfo.initialLayout         = ConvertImageLayoutToVkImageLayout(initialLayout);
 
-    mCurrentLayout = initialLayout;
+    mCurrentLayout      = initialLayout;
+    mCreateFlags        = imageInfo.flags;
+    mHasKnownCreateInfo = GetImageViewFormats(externalImageCreateInfo, &mViewFormats);
 
     mYuvConversionSampler.reset();
     mExternalFormat = 0;
@@ -3663,6 +3967,7 @@ void ImageHelper::releaseStagingBuffer(RendererVk *renderer)
         }
     }
     mStagingBuffer.release(renderer);
+    mTranscodeStagingBuffer.release(renderer);
     mSubresourceUpdates.clear();
     mCurrentSingleClearValue.reset();
 }
@@ -3955,6 +4260,7 @@ void ImageHelper::destroy(RendererVk *renderer)
     mImage.destroy(device);
     mDeviceMemory.destroy(device);
     mStagingBuffer.destroy(renderer);
+    mTranscodeStagingBuffer.destroy(renderer);
     mCurrentLayout = ImageLayout::Undefined;
     mImageType     = VK_IMAGE_TYPE_2D;
     mLayerCount    = 0;
@@ -3982,6 +4288,9 @@ void ImageHelper::init2DWeakReference(Context *context,
     mLayerCount    = 1;
     mLevelCount    = 1;
 
+    // The swapchain's create info is not tracked by the image.
+    mHasKnownCreateInfo = false;
+
     mImage.setHandle(handle);
 
     stageClearIfEmulatedFormat(isRobustResourceInitEnabled);
@@ -4716,10 +5025,18 @@ angle::Result ImageHelper::stageSubresourceUpdateImpl(ContextVk *contextVk,
 
     LoadImageFunctionInfo loadFunctionInfo = vkFormat.textureLoadFunctions(type);
     LoadImageFunction stencilLoadFunction  = nullptr;
+    angle::FormatID compressedFormatID     = angle::FormatID::NONE;
 
-    if (storageFormat.isBlock)
+    // If the compressed data is to be decoded in compute, it's staged unmodified and laid out like
+    // a native block format would be.
+    const bool transcodeWithCompute = ShouldTranscodeWithCompute(contextVk, vkFormat, glExtents);
+
+    if (storageFormat.isBlock || transcodeWithCompute)
     {
-        const gl::InternalFormat &storageFormatInfo = vkFormat.getInternalFormatInfo(type);
+        const gl::InternalFormat &storageFormatInfo =
+            transcodeWithCompute
+                ? gl::GetSizedInternalFormatInfo(vkFormat.intendedFormat().glInternalFormat)
+                : vkFormat.getInternalFormatInfo(type);
         GLuint rowPitch;
         GLuint depthPitch;
         GLuint totalSize;
@@ -4741,6 +5058,20 @@ angle::Result ImageHelper::stageSubresourceUpdateImpl(ContextVk *contextVk,
             contextVk, storageFormatInfo.computeBufferRowLength(glExtents.width, &bufferRowLength));
         ANGLE_VK_CHECK_MATH(contextVk, storageFormatInfo.computeBufferImageHeight(
                                            glExtents.height, &bufferImageHeight));
+
+        if (transcodeWithCompute)
+        {
+            // ETC and EAC blocks are 4x4 texels in 8 bytes, or 16 bytes for ETC2 RGBA8 and EAC
+            // RG11, which have two blocks one after the other.
+            ASSERT(storageFormatInfo.compressedBlockWidth == 4 &&
+                   storageFormatInfo.compressedBlockHeight == 4);
+            ASSERT(storageFormatInfo.pixelBytes == 8 || storageFormatInfo.pixelBytes == 16);
+            loadFunctionInfo.loadFunction = storageFormatInfo.pixelBytes == 16
+                                                ? angle::LoadCompressedToNative<4, 4, 1, 16>
+                                                : angle::LoadCompressedToNative<4, 4, 1, 8>;
+
+            compressedFormatID = vkFormat.intendedFormatID;
+        }
     }
     else
     {
@@ -4803,9 +5134,18 @@ angle::Result ImageHelper::stageSubresourceUpdateImpl(ContextVk *contextVk,
 
     uint8_t *stagingPointer    = nullptr;
     VkDeviceSize stagingOffset = 0;
-    // If caller has provided a staging buffer, use it.
+    // If caller has provided a staging buffer, use it.  Blocks that are decoded in compute are
+    // staged in a buffer the compute shader can read.
     DynamicBuffer *stagingBuffer = stagingBufferOverride ? stagingBufferOverride : &mStagingBuffer;
     size_t alignment             = mStagingBuffer.getAlignment();
+    if (transcodeWithCompute)
+    {
+        // The compute shader reads the blocks as uints.
+        mTranscodeStagingBuffer.init(contextVk->getRenderer(), kTranscodeStagingBufferFlags, 4,
+                                     kStagingBufferSize, true);
+        stagingBuffer = &mTranscodeStagingBuffer;
+        alignment     = mTranscodeStagingBuffer.getAlignment();
+    }
     ANGLE_TRY(stagingBuffer->allocateWithAlignment(contextVk, allocationSize, alignment,
                                                    &stagingPointer, &bufferHandle, &stagingOffset,
                                                    nullptr));
@@ -4894,7 +5234,8 @@ angle::Result ImageHelper::stageSubresourceUpdateImpl(ContextVk *contextVk,
     if (aspectFlags)
     {
         copy.imageSubresource.aspectMask = aspectFlags;
-        appendSubresourceUpdate(updateLevelGL, SubresourceUpdate(currentBuffer, copy));
+        appendSubresourceUpdate(updateLevelGL,
+                                SubresourceUpdate(currentBuffer, copy, compressedFormatID));
     }
 
     return angle::Result::Continue;
@@ -5494,6 +5835,7 @@ angle::Result ImageHelper::flushStagedUpdates(ContextVk *contextVk,
     }
 
     ANGLE_TRY(mStagingBuffer.flush(contextVk));
+    ANGLE_TRY(mTranscodeStagingBuffer.flush(contextVk));
 
     const VkImageAspectFlags aspectFlags = GetFormatAspectFlags(mFormat->actualImageFormat());
 
@@ -5620,13 +5962,24 @@ angle::Result ImageHelper::flushStagedUpdates(ContextVk *contextVk,
                 BufferHelper *currentBuffer = bufferUpdate.bufferHelper;
                 ASSERT(currentBuffer && currentBuffer->valid());
 
-                CommandBufferAccess bufferAccess;
-                bufferAccess.onBufferTransferRead(currentBuffer);
-                ANGLE_TRY(
-                    contextVk->getOutsideRenderPassCommandBuffer(bufferAccess, &commandBuffer));
-
-                commandBuffer->copyBufferToImage(currentBuffer->getBuffer().getHandle(), mImage,
-                                                 getCurrentLayout(), 1, &update.buffer.copyRegion);
+                if (bufferUpdate.compressedFormatID != angle::FormatID::NONE)
+                {
+                    // The staged blocks are decoded and copied to the image in one go.
+                    ANGLE_TRY(contextVk->getUtils().transcodeEtc(
+                        contextVk, this, currentBuffer, bufferUpdate.compressedFormatID,
+                        bufferUpdate.copyRegion));
+                }
+                else
+                {
+                    CommandBufferAccess bufferAccess;
+                    bufferAccess.onBufferTransferRead(currentBuffer);
+                    ANGLE_TRY(
+                        contextVk->getOutsideRenderPassCommandBuffer(bufferAccess, &commandBuffer));
+
+                    commandBuffer->copyBufferToImage(currentBuffer->getBuffer().getHandle(),
+                                                     mImage, getCurrentLayout(), 1,
+                                                     &update.buffer.copyRegion);
+                }
                 onWrite(updateMipLevelGL, 1, updateBaseLayer, updateLayerCount,
                         update.buffer.copyRegion.imageSubresource.aspectMask);
             }
@@ -5667,6 +6020,8 @@ angle::Result ImageHelper::flushStagedUpdates(ContextVk *contextVk,
     {
         mStagingBuffer.releaseInFlightBuffers(contextVk);
         mStagingBuffer.release(contextVk->getRenderer());
+        mTranscodeStagingBuffer.releaseInFlightBuffers(contextVk);
+        mTranscodeStagingBuffer.release(contextVk->getRenderer());
     }
 
     return angle::Result::Continue;
@@ -6055,6 +6410,17 @@ angle::Result ImageHelper::readPixels(ContextVk *contextVk,
 
     ASSERT(!hasStagedUpdatesForSubresource(levelGL, layer));
 
+    if (packPixelsParams.packBuffer && copyAspectFlags == VK_IMAGE_ASPECT_COLOR_BIT)
+    {
+        bool handled = false;
+        ANGLE_TRY(readPixelsToPackBuffer(contextVk, area, packPixelsParams, levelGL, layer,
+                                         reinterpret_cast<ptrdiff_t>(pixels), &handled));
+        if (handled)
+        {
+            return angle::Result::Continue;
+        }
+    }
+
     if (isMultisampled)
     {
         ANGLE_TRY(resolvedImage.get().init2DStaging(
@@ -6181,13 +6547,168 @@ angle::Result ImageHelper::readPixels(ContextVk *contextVk,
     return angle::Result::Continue;
 }
 
+angle::Result ImageHelper::readPixelsToPackBuffer(ContextVk *contextVk,
+                                                  const gl::Rectangle &area,
+                                                  const PackPixelsParams &packPixelsParams,
+                                                  gl::LevelIndex levelGL,
+                                                  uint32_t layer,
+                                                  ptrdiff_t bufferOffset,
+                                                  bool *handledOut)
+{
+    *handledOut = false;
+
+    RendererVk *renderer            = contextVk->getRenderer();
+    BufferVk *packBufferVk          = GetImpl(packPixelsParams.packBuffer);
+    const angle::Format &readFormat = mFormat->actualImageFormat();
+    const angle::Format &destFormat = *packPixelsParams.destFormat;
+    const size_t destOffset         = static_cast<size_t>(bufferOffset + packPixelsParams.offset);
+
+    // Multisampled and pre-rotated reads go through the CPU.  So do buffers with a shadow copy, as
+    // mapping those returns the shadow copy and would not see the GPU's writes.
+    if (mSamples > 1 || packPixelsParams.rotation != SurfaceRotation::Identity ||
+        packBufferVk->isShadowBuffered())
+    {
+        return angle::Result::Continue;
+    }
+
+    // The copy addresses the buffer in whole texels.
+    const uint32_t texelSize = destFormat.pixelBytes;
+    if (texelSize == 0 || packPixelsParams.outputPitch % texelSize != 0 ||
+        destOffset % texelSize != 0)
+    {
+        return angle::Result::Continue;
+    }
+
+    const bool needsConversion = destFormat.id != readFormat.id;
+    if (needsConversion &&
+        (mExtents.depth > 1 || mLayerCount > 1 || (mUsage & VK_IMAGE_USAGE_SAMPLED_BIT) == 0 ||
+         !CanConvertReadPixelsWithDraw(renderer, readFormat, destFormat)))
+    {
+        return angle::Result::Continue;
+    }
+
+    ImageHelper *src = this;
+    RendererScoped<ImageHelper> convertedImage(renderer);
+
+    VkOffset3D srcOffset = {area.x, area.y, 0};
+
+    VkImageSubresourceLayers srcSubresource = {};
+    srcSubresource.aspectMask               = VK_IMAGE_ASPECT_COLOR_BIT;
+    srcSubresource.mipLevel                 = toVkLevel(levelGL).get();
+    srcSubresource.baseArrayLayer           = layer;
+    srcSubresource.layerCount               = 1;
+
+    if (mExtents.depth > 1)
+    {
+        // Depth > 1 means this is a 3D texture and we need special handling
+        srcOffset.z                   = layer;
+        srcSubresource.baseArrayLayer = 0;
+    }
+
+    bool reverseRowOrder = packPixelsParams.reverseRowOrder;
+
+    if (needsConversion)
+    {
+        // Draw the area into an image of the pack format, flipping it on the way if needed, so
+        // that it can be copied to the buffer as is.
+        ANGLE_TRY(convertedImage.get().init2DStaging(
+            contextVk, renderer->getMemoryProperties(), gl::Extents(area.width, area.height, 1),
+            renderer->getFormat(destFormat.id),
+            VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, 1));
+        convertedImage.get().retain(&contextVk->getResourceUseList());
+
+        ImageView srcView;
+        ANGLE_TRY(initLayerImageView(contextVk, gl::TextureType::_2D, VK_IMAGE_ASPECT_COLOR_BIT,
+                                     gl::SwizzleState(), &srcView, toVkLevel(levelGL), 1, 0, 1));
+        ImageView destView;
+        ANGLE_TRY(convertedImage.get().initLayerImageView(
+            contextVk, gl::TextureType::_2D, VK_IMAGE_ASPECT_COLOR_BIT, gl::SwizzleState(),
+            &destView, LevelIndex(0), 1, 0, 1));
+
+        UtilsVk::CopyImageParameters params = {};
+        params.srcOffset[0]                 = area.x;
+        params.srcOffset[1]                 = area.y;
+        params.srcExtents[0]                = area.width;
+        params.srcExtents[1]                = area.height;
+        params.srcHeight                    = getLevelExtents2D(toVkLevel(levelGL)).height;
+        params.dstMip                       = gl::LevelIndex(0);
+        params.destFlipY                    = reverseRowOrder;
+        params.srcRotation                  = SurfaceRotation::Identity;
+
+        ANGLE_TRY(contextVk->getUtils().copyImage(contextVk, &convertedImage.get(), &destView,
+                                                  this, &srcView, params));
+
+        contextVk->addGarbage(&srcView);
+        contextVk->addGarbage(&destView);
+
+        src                           = &convertedImage.get();
+        srcOffset                     = {0, 0, 0};
+        srcSubresource.mipLevel       = 0;
+        srcSubresource.baseArrayLayer = 0;
+        reverseRowOrder               = false;
+    }
+
+    BufferHelper &packBuffer = packBufferVk->getBuffer();
+
+    CommandBufferAccess access;
+    access.onImageTransferRead(src->getAspectFlags(), src);
+    access.onBufferTransferWrite(&packBuffer);
+
+    CommandBuffer *commandBuffer;
+    ANGLE_TRY(contextVk->getOutsideRenderPassCommandBuffer(access, &commandBuffer));
+
+    VkBufferImageCopy region = {};
+    region.bufferOffset      = destOffset;
+    region.bufferRowLength   = packPixelsParams.outputPitch / texelSize;
+    region.bufferImageHeight = area.height;
+    region.imageSubresource  = srcSubresource;
+    region.imageOffset       = srcOffset;
+    region.imageExtent = {static_cast<uint32_t>(area.width), static_cast<uint32_t>(area.height), 1};
+
+    if (!reverseRowOrder)
+    {
+        commandBuffer->copyImageToBuffer(src->getImage(), src->getCurrentLayout(),
+                                         packBuffer.getBuffer().getHandle(), 1, &region);
+    }
+    else
+    {
+        // Flip the image by copying every row to its mirrored position in the buffer.
+        std::vector<VkBufferImageCopy> rowRegions(area.height, region);
+        for (int row = 0; row < area.height; ++row)
+        {
+            const size_t destRow         = static_cast<size_t>(area.height - 1 - row);
+            VkBufferImageCopy &rowRegion = rowRegions[row];
+            rowRegion.bufferOffset       = destOffset + destRow * packPixelsParams.outputPitch;
+            rowRegion.bufferImageHeight  = 1;
+            rowRegion.imageOffset.y      = srcOffset.y + row;
+            rowRegion.imageExtent.height = 1;
+        }
+        commandBuffer->copyImageToBuffer(src->getImage(), src->getCurrentLayout(),
+                                         packBuffer.getBuffer().getHandle(),
+                                         static_cast<uint32_t>(rowRegions.size()),
+                                         rowRegions.data());
+    }
+
+    // Make the results visible to the host once the commands are flushed.
+    contextVk->onHostVisibleBufferWrite();
+
+    *handledOut = true;
+    return angle::Result::Continue;
+}
+
 // ImageHelper::SubresourceUpdate implementation
 ImageHelper::SubresourceUpdate::SubresourceUpdate() : updateSource(UpdateSource::Buffer), buffer{}
 {}
 
 ImageHelper::SubresourceUpdate::SubresourceUpdate(BufferHelper *bufferHelperIn,
                                                   const VkBufferImageCopy &copyRegionIn)
-    : updateSource(UpdateSource::Buffer), buffer{bufferHelperIn, copyRegionIn}
+    : SubresourceUpdate(bufferHelperIn, copyRegionIn, angle::FormatID::NONE)
+{}
+
+ImageHelper::SubresourceUpdate::SubresourceUpdate(BufferHelper *bufferHelperIn,
+                                                  const VkBufferImageCopy &copyRegionIn,
+                                                  angle::FormatID compressedFormatIDIn)
+    : updateSource(UpdateSource::Buffer), buffer{bufferHelperIn, copyRegionIn, compressedFormatIDIn}
 {}
 
 ImageHelper::SubresourceUpdate::SubresourceUpdate(ImageHelper *imageIn,
@@ -6352,12 +6873,14 @@ FramebufferHelper::~FramebufferHelper() = default;
 FramebufferHelper::FramebufferHelper(FramebufferHelper &&other) : Resource(std::move(other))
 {
     mFramebuffer = std::move(other.mFramebuffer);
+    mLastUse     = other.mLastUse;
 }
 
 FramebufferHelper &FramebufferHelper::operator=(FramebufferHelper &&other)
 {
     std::swap(mUse, other.mUse);
     std::swap(mFramebuffer, other.mFramebuffer);
+    std::swap(mLastUse, other.mLastUse);
     return *this;
 }
 
@@ -6365,6 +6888,7 @@ angle::Result FramebufferHelper::init(ContextVk *contextVk,
                                       const VkFramebufferCreateInfo &createInfo)
 {
     ANGLE_VK_TRY(contextVk, mFramebuffer.init(contextVk->getDevice(), createInfo));
+    contextVk->getPerfCounters().framebufferCreations++;
     return angle::Result::Continue;
 }
 
@@ -6944,6 +7468,34 @@ void ShaderProgramHelper::release(ContextVk *contextVk)
     }
 }
 
+angle::Result ShaderProgramHelper::prespecializeGraphicsPipeline(
+    ContextVk *contextVk,
+    RenderPassCache *renderPassCache,
+    const PipelineCache &pipelineCache,
+    const PipelineLayout &pipelineLayout,
+    const GraphicsPipelineDesc &pipelineDesc,
+    const gl::AttributesMask &activeAttribLocationsMask,
+    const gl::ComponentTypeMask &programAttribsTypeMask)
+{
+    RenderPass *compatibleRenderPass = nullptr;
+    ANGLE_TRY(renderPassCache->getCompatibleRenderPass(contextVk, pipelineDesc.getRenderPassDesc(),
+                                                       &compatibleRenderPass));
+
+    ShaderModule *vertexShader   = &mShaders[gl::ShaderType::Vertex].get().get();
+    ShaderModule *fragmentShader = mShaders[gl::ShaderType::Fragment].valid()
+                                       ? &mShaders[gl::ShaderType::Fragment].get().get()
+                                       : nullptr;
+    ShaderModule *geometryShader = mShaders[gl::ShaderType::Geometry].valid()
+                                       ? &mShaders[gl::ShaderType::Geometry].get().get()
+                                       : nullptr;
+
+    mGraphicsPipelines.prespecializePipeline(
+        contextVk, pipelineCache, *compatibleRenderPass, pipelineLayout, activeAttribLocationsMask,
+        programAttribsTypeMask, vertexShader, fragmentShader, geometryShader,
+        mSpecializationConstants, pipelineDesc);
+    return angle::Result::Continue;
+}
+
 void ShaderProgramHelper::setShader(gl::ShaderType shaderType, RefCounted<ShaderAndSerial> *shader)
 {
     mShaders[shaderType].set(shader);
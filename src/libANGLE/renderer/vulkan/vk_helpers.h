@@ -36,6 +36,12 @@ constexpr VkBufferUsageFlags kStagingBufferFlags =
     VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
 constexpr size_t kStagingBufferSize = 1024 * 16;
 
+// Compressed uploads that are decoded in compute are staged in buffers that the compute shader can
+// read, and decoded in parts of at most kTranscodeBufferSize bytes.
+constexpr VkBufferUsageFlags kTranscodeStagingBufferFlags =
+    kStagingBufferFlags | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+constexpr size_t kTranscodeBufferSize = 1024 * 1024;
+
 constexpr VkImageCreateFlags kVkImageCreateFlagsNone = 0;
 
 using StagingBufferOffsetArray = std::array<VkDeviceSize, 2>;
@@ -378,6 +384,10 @@ class DynamicallyGrowingPool : angle::NonCopyable
 
 // DynamicQueryPool allocates indices out of QueryPool as needed.  Once a QueryPool is exhausted,
 // another is created.  The query pools live permanently, but are recycled as indices get freed.
+//
+// Every query pool is paired with a host-visible buffer that the results of its queries are copied
+// to with vkCmdCopyQueryPoolResults.  Once the commands that ended a query have completed, its
+// result can be read from that buffer without calling into the driver.
 
 // These are arbitrary default sizes for query pools.
 constexpr uint32_t kDefaultOcclusionQueryPoolSize         = 64;
@@ -385,6 +395,15 @@ constexpr uint32_t kDefaultTimestampQueryPoolSize         = 64;
 constexpr uint32_t kDefaultTransformFeedbackQueryPoolSize = 128;
 
 class QueryHelper;
+class QueryResult;
+
+// A query whose result is yet to be copied to the results buffer of its pool.
+struct QueryResultCopy
+{
+    const DynamicQueryPool *dynamicQueryPool;
+    size_t queryPoolIndex;
+    uint32_t query;
+};
 
 class DynamicQueryPool final : public DynamicallyGrowingPool<QueryPool>
 {
@@ -393,18 +412,36 @@ class DynamicQueryPool final : public DynamicallyGrowingPool<QueryPool>
     ~DynamicQueryPool() override;
 
     angle::Result init(ContextVk *contextVk, VkQueryType type, uint32_t poolSize);
-    void destroy(VkDevice device);
+    void destroy(RendererVk *renderer);
 
     angle::Result allocateQuery(ContextVk *contextVk, QueryHelper *queryOut);
     void freeQuery(ContextVk *contextVk, QueryHelper *query);
 
     const QueryPool &getQueryPool(size_t index) const { return mPools[index]; }
 
+    // Records the copies of the given query results to the results buffers.  Queries that are
+    // adjacent in the same query pool are copied together.  The list is sorted in the process.
+    // Returns the number of copy commands recorded.
+    static uint32_t CopyResults(CommandBuffer *commandBuffer,
+                                std::vector<QueryResultCopy> *copies);
+
+    angle::Result getCopiedResult(ContextVk *contextVk,
+                                  size_t queryPoolIndex,
+                                  uint32_t query,
+                                  QueryResult *resultOut) const;
+
   private:
     angle::Result allocateNewPool(ContextVk *contextVk);
 
+    VkDeviceSize getResultStride() const { return mResultCount * sizeof(uint64_t); }
+
     // Information required to create new query pools
     VkQueryType mQueryType;
+    // The number of values in a query result; transform feedback queries have two.
+    uint32_t mResultCount;
+
+    // One results buffer per query pool, persistently mapped.
+    BufferHelperPointerVector mResultBuffers;
 };
 
 // Stores the result of a Vulkan query call. XFB queries in particular store two result values.
@@ -469,6 +506,10 @@ class QueryHelper final : public Resource
                                              bool *availableOut);
     angle::Result getUint64Result(ContextVk *contextVk, QueryResult *resultOut);
 
+    // Reads the result that was copied to the results buffer of the pool when the query ended.
+    // The commands that ended the query must have completed.
+    angle::Result getCopiedResult(ContextVk *contextVk, QueryResult *resultOut);
+
   private:
     friend class DynamicQueryPool;
     const QueryPool &getQueryPool() const
@@ -483,6 +524,8 @@ class QueryHelper final : public Resource
                         CommandBuffer *resetCommandBuffer,
                         CommandBuffer *commandBuffer);
     void endQueryImpl(ContextVk *contextVk, CommandBuffer *commandBuffer);
+    // Schedules the copy of the result to the results buffer once the query has ended.
+    void onQueryEnded(ContextVk *contextVk);
 
     const DynamicQueryPool *mDynamicQueryPool;
     size_t mQueryPoolIndex;
@@ -1043,7 +1086,10 @@ class CommandBufferHelper : angle::NonCopyable
 
     void onImageHelperRelease(const ImageHelper *image);
 
+    // |imagelessAttachmentViews| are the attachments of |framebuffer| if it was created with
+    // VK_KHR_imageless_framebuffer, and are otherwise empty.
     void beginRenderPass(const Framebuffer &framebuffer,
+                         const FramebufferAttachmentsVector<VkImageView> &imagelessAttachmentViews,
                          const gl::Rectangle &renderArea,
                          const RenderPassDesc &renderPassDesc,
                          const AttachmentOpsArray &renderPassAttachmentOps,
@@ -1137,8 +1183,10 @@ class CommandBufferHelper : angle::NonCopyable
     void onDepthAccess(ResourceAccess access);
     void onStencilAccess(ResourceAccess access);
 
-    void updateRenderPassForResolve(Framebuffer *newFramebuffer,
-                                    const RenderPassDesc &renderPassDesc);
+    void updateRenderPassForResolve(
+        Framebuffer *newFramebuffer,
+        const FramebufferAttachmentsVector<VkImageView> &imagelessAttachmentViews,
+        const RenderPassDesc &renderPassDesc);
 
     bool hasDepthStencilWriteOrClear() const
     {
@@ -1181,6 +1229,7 @@ class CommandBufferHelper : angle::NonCopyable
     RenderPassDesc mRenderPassDesc;
     AttachmentOpsArray mAttachmentOps;
     Framebuffer mFramebuffer;
+    FramebufferAttachmentsVector<VkImageView> mImagelessAttachmentViews;
     gl::Rectangle mRenderArea;
     PackedClearValuesArray mClearValues;
     bool mRenderPassStarted;
@@ -1299,6 +1348,9 @@ bool CanCopyWithTransfer(RendererVk *renderer,
                          const Format &destFormat,
                          VkImageTiling destTilingMode);
 
+// The formats listed in an image's VkImageFormatListCreateInfo.  ANGLE never lists more than two.
+using ImageViewFormats = angle::FixedVector<VkFormat, 2>;
+
 class ImageHelper final : public Resource, public angle::Subject
 {
   public:
@@ -1432,6 +1484,11 @@ class ImageHelper final : public Resource, public angle::Subject
     void setTilingMode(VkImageTiling tilingMode) { mTilingMode = tilingMode; }
     VkImageTiling getTilingMode() const { return mTilingMode; }
     VkImageUsageFlags getUsage() const { return mUsage; }
+    VkImageCreateFlags getCreateFlags() const { return mCreateFlags; }
+    const ImageViewFormats &getViewFormats() const { return mViewFormats; }
+    // Whether the image's create flags and view formats are known, which is not the case for images
+    // ANGLE did not create, such as swapchain images.
+    bool hasKnownCreateInfo() const { return mHasKnownCreateInfo; }
     VkImageType getType() const { return mImageType; }
     const VkExtent3D &getExtents() const { return mExtents; }
     uint32_t getLayerCount() const { return mLayerCount; }
@@ -1760,6 +1817,9 @@ class ImageHelper final : public Resource, public angle::Subject
     {
         BufferHelper *bufferHelper;
         VkBufferImageCopy copyRegion;
+        // If not NONE, the buffer holds blocks of this compressed format, which are decoded in
+        // compute before being copied to the image.
+        angle::FormatID compressedFormatID;
     };
     struct ImageUpdate
     {
@@ -1771,6 +1831,9 @@ class ImageHelper final : public Resource, public angle::Subject
     {
         SubresourceUpdate();
         SubresourceUpdate(BufferHelper *bufferHelperIn, const VkBufferImageCopy &copyRegion);
+        SubresourceUpdate(BufferHelper *bufferHelperIn,
+                          const VkBufferImageCopy &copyRegion,
+                          angle::FormatID compressedFormatID);
         SubresourceUpdate(ImageHelper *image, const VkImageCopy &copyRegion);
         SubresourceUpdate(VkImageAspectFlags aspectFlags,
                           const VkClearValue &clearValue,
@@ -1834,6 +1897,17 @@ class ImageHelper final : public Resource, public angle::Subject
 
     angle::Result initializeNonZeroMemory(Context *context, VkDeviceSize size);
 
+    // Records a copy of |area| directly into the pixel pack buffer at |bufferOffset|, reordering
+    // channels on the GPU if necessary.  No wait is performed; the buffer is synchronized when
+    // mapped.  |*handledOut| is set to false (and nothing is recorded) if the read needs the CPU.
+    angle::Result readPixelsToPackBuffer(ContextVk *contextVk,
+                                         const gl::Rectangle &area,
+                                         const PackPixelsParams &packPixelsParams,
+                                         gl::LevelIndex levelGL,
+                                         uint32_t layer,
+                                         ptrdiff_t bufferOffset,
+                                         bool *handledOut);
+
     std::vector<SubresourceUpdate> *getLevelUpdates(gl::LevelIndex level);
     const std::vector<SubresourceUpdate> *getLevelUpdates(gl::LevelIndex level) const;
 
@@ -1891,6 +1965,9 @@ class ImageHelper final : public Resource, public angle::Subject
     VkImageType mImageType;
     VkImageTiling mTilingMode;
     VkImageUsageFlags mUsage;
+    VkImageCreateFlags mCreateFlags;
+    ImageViewFormats mViewFormats;
+    bool mHasKnownCreateInfo;
     VkExtent3D mExtents;
     const Format *mFormat;
     GLint mSamples;
@@ -1915,6 +1992,8 @@ class ImageHelper final : public Resource, public angle::Subject
 
     // Staging buffer
     DynamicBuffer mStagingBuffer;
+    // Staging buffer for compressed data that's decoded in compute, which needs storage usage.
+    DynamicBuffer mTranscodeStagingBuffer;
     std::vector<std::vector<SubresourceUpdate>> mSubresourceUpdates;
 
     // Optimization for repeated clear with the same value. If this pointer is not null, the entire
@@ -2244,9 +2323,14 @@ class FramebufferHelper : public Resource
         return mFramebuffer;
     }
 
+    // Used by FramebufferVk to find the least recently used framebuffers in its cache.
+    void setLastUse(uint64_t useCount) { mLastUse = useCount; }
+    uint64_t getLastUse() const { return mLastUse; }
+
   private:
     // Vulkan object.
     Framebuffer mFramebuffer;
+    uint64_t mLastUse = 0;
 };
 
 class ShaderProgramHelper : angle::NonCopyable
@@ -2295,6 +2379,18 @@ class ShaderProgramHelper : angle::NonCopyable
             geometryShader, mSpecializationConstants, pipelineDesc, descPtrOut, pipelineOut);
     }
 
+    // Starts creating the pipeline for |pipelineDesc| on a worker thread ahead of its first use.
+    angle::Result prespecializeGraphicsPipeline(
+        ContextVk *contextVk,
+        RenderPassCache *renderPassCache,
+        const PipelineCache &pipelineCache,
+        const PipelineLayout &pipelineLayout,
+        const GraphicsPipelineDesc &pipelineDesc,
+        const gl::AttributesMask &activeAttribLocationsMask,
+        const gl::ComponentTypeMask &programAttribsTypeMask);
+
+    const GraphicsPipelineCache &getGraphicsPipelineCache() const { return mGraphicsPipelines; }
+
     angle::Result getComputePipeline(Context *context,
                                      const PipelineLayout &pipelineLayout,
                                      PipelineAndSerial **pipelineOut);
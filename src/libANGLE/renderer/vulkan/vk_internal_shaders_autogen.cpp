@@ -64,6 +64,7 @@ namespace
 #include "libANGLE/renderer/vulkan/shaders/gen/ConvertVertex.comp.00000006.inc"
 #include "libANGLE/renderer/vulkan/shaders/gen/ConvertVertex.comp.00000007.inc"
 #include "libANGLE/renderer/vulkan/shaders/gen/ConvertVertex.comp.00000008.inc"
+#include "libANGLE/renderer/vulkan/shaders/gen/EtcToRgba.comp.00000000.inc"
 #include "libANGLE/renderer/vulkan/shaders/gen/FullScreenQuad.vert.00000000.inc"
 #include "libANGLE/renderer/vulkan/shaders/gen/GenerateMipmap.comp.00000000.inc"
 #include "libANGLE/renderer/vulkan/shaders/gen/GenerateMipmap.comp.00000001.inc"
@@ -226,6 +227,9 @@ constexpr CompressedShaderBlob kConvertVertex_comp_shaders[] = {
     {kConvertVertex_comp_00000007, sizeof(kConvertVertex_comp_00000007)},
     {kConvertVertex_comp_00000008, sizeof(kConvertVertex_comp_00000008)},
 };
+constexpr CompressedShaderBlob kEtcToRgba_comp_shaders[] = {
+    {kEtcToRgba_comp_00000000, sizeof(kEtcToRgba_comp_00000000)},
+};
 constexpr CompressedShaderBlob kFullScreenQuad_vert_shaders[] = {
     {kFullScreenQuad_vert_00000000, sizeof(kFullScreenQuad_vert_00000000)},
 };
@@ -418,6 +422,10 @@ void ShaderLibrary::destroy(VkDevice device)
     {
         shader.get().destroy(device);
     }
+    for (RefCounted<ShaderAndSerial> &shader : mEtcToRgba_comp_shaders)
+    {
+        shader.get().destroy(device);
+    }
     for (RefCounted<ShaderAndSerial> &shader : mFullScreenQuad_vert_shaders)
     {
         shader.get().destroy(device);
@@ -498,6 +506,14 @@ angle::Result ShaderLibrary::getConvertVertex_comp(Context *context,
                      ArraySize(kConvertVertex_comp_shaders), shaderFlags, shaderOut);
 }
 
+angle::Result ShaderLibrary::getEtcToRgba_comp(Context *context,
+                                               uint32_t shaderFlags,
+                                               RefCounted<ShaderAndSerial> **shaderOut)
+{
+    return GetShader(context, mEtcToRgba_comp_shaders, kEtcToRgba_comp_shaders,
+                     ArraySize(kEtcToRgba_comp_shaders), shaderFlags, shaderOut);
+}
+
 angle::Result ShaderLibrary::getFullScreenQuad_vert(Context *context,
                                                     uint32_t shaderFlags,
                                                     RefCounted<ShaderAndSerial> **shaderOut)
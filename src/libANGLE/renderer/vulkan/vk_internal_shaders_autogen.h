@@ -91,6 +91,11 @@ enum Conversion
 constexpr size_t kArrayLen = 0x00000009;
 }  // namespace ConvertVertex_comp
 
+namespace EtcToRgba_comp
+{
+constexpr size_t kArrayLen = 0x00000001;
+}  // namespace EtcToRgba_comp
+
 namespace FullScreenQuad_vert
 {
 constexpr size_t kArrayLen = 0x00000001;
@@ -217,6 +222,9 @@ class ShaderLibrary final : angle::NonCopyable
     angle::Result getConvertVertex_comp(Context *context,
                                         uint32_t shaderFlags,
                                         RefCounted<ShaderAndSerial> **shaderOut);
+    angle::Result getEtcToRgba_comp(Context *context,
+                                    uint32_t shaderFlags,
+                                    RefCounted<ShaderAndSerial> **shaderOut);
     angle::Result getFullScreenQuad_vert(Context *context,
                                          uint32_t shaderFlags,
                                          RefCounted<ShaderAndSerial> **shaderOut);
@@ -249,6 +257,7 @@ class ShaderLibrary final : angle::NonCopyable
         [InternalShader::ConvertIndirectLineLoop_comp::kArrayLen];
     RefCounted<ShaderAndSerial>
         mConvertVertex_comp_shaders[InternalShader::ConvertVertex_comp::kArrayLen];
+    RefCounted<ShaderAndSerial> mEtcToRgba_comp_shaders[InternalShader::EtcToRgba_comp::kArrayLen];
     RefCounted<ShaderAndSerial>
         mFullScreenQuad_vert_shaders[InternalShader::FullScreenQuad_vert::kArrayLen];
     RefCounted<ShaderAndSerial>
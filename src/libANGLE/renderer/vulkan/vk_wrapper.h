@@ -259,6 +259,13 @@ class CommandBuffer : public WrappedObject<CommandBuffer, VkCommandBuffer>
                    VkImageLayout dstImageLayout,
                    uint32_t regionCount,
                    const VkImageCopy *regions);
+    void copyQueryPoolResults(const QueryPool &queryPool,
+                              uint32_t firstQuery,
+                              uint32_t queryCount,
+                              const Buffer &dstBuffer,
+                              VkDeviceSize dstOffset,
+                              VkDeviceSize stride,
+                              VkQueryResultFlags flags);
 
     void dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ);
     void dispatchIndirect(const Buffer &buffer, VkDeviceSize offset);
@@ -342,8 +349,21 @@ class CommandBuffer : public WrappedObject<CommandBuffer, VkCommandBuffer>
                        uint32_t size,
                        const void *data);
 
+    // VK_EXT_extended_dynamic_state
+    void setCullMode(VkCullModeFlags cullMode);
+    void setDepthCompareOp(VkCompareOp depthCompareOp);
+    void setDepthTestEnable(VkBool32 depthTestEnable);
+    void setDepthWriteEnable(VkBool32 depthWriteEnable);
     void setEvent(VkEvent event, VkPipelineStageFlags stageMask);
+    void setFrontFace(VkFrontFace frontFace);
+    void setPrimitiveTopology(VkPrimitiveTopology primitiveTopology);
     void setScissor(uint32_t firstScissor, uint32_t scissorCount, const VkRect2D *scissors);
+    void setStencilOp(VkStencilFaceFlags faceMask,
+                      VkStencilOp failOp,
+                      VkStencilOp passOp,
+                      VkStencilOp depthFailOp,
+                      VkCompareOp compareOp);
+    void setStencilTestEnable(VkBool32 stencilTestEnable);
     VkResult reset();
     void resetEvent(VkEvent event, VkPipelineStageFlags stageMask);
     void resetQueryPool(const QueryPool &queryPool, uint32_t firstQuery, uint32_t queryCount);
@@ -854,6 +874,19 @@ ANGLE_INLINE void CommandBuffer::copyImageToBuffer(const Image &srcImage,
     vkCmdCopyImageToBuffer(mHandle, srcImage.getHandle(), srcImageLayout, dstBuffer, 1, regions);
 }
 
+ANGLE_INLINE void CommandBuffer::copyQueryPoolResults(const QueryPool &queryPool,
+                                                      uint32_t firstQuery,
+                                                      uint32_t queryCount,
+                                                      const Buffer &dstBuffer,
+                                                      VkDeviceSize dstOffset,
+                                                      VkDeviceSize stride,
+                                                      VkQueryResultFlags flags)
+{
+    ASSERT(valid() && queryPool.valid() && dstBuffer.valid());
+    vkCmdCopyQueryPoolResults(mHandle, queryPool.getHandle(), firstQuery, queryCount,
+                              dstBuffer.getHandle(), dstOffset, stride, flags);
+}
+
 ANGLE_INLINE void CommandBuffer::clearColorImage(const Image &image,
                                                  VkImageLayout imageLayout,
                                                  const VkClearColorValue &color,
@@ -964,8 +997,31 @@ ANGLE_INLINE void CommandBuffer::pushConstants(const PipelineLayout &layout,
                                                const void *data)
 {
     ASSERT(valid() && layout.valid());
-    ASSERT(offset == 0);
-    vkCmdPushConstants(mHandle, layout.getHandle(), flag, 0, size, data);
+    vkCmdPushConstants(mHandle, layout.getHandle(), flag, offset, size, data);
+}
+
+ANGLE_INLINE void CommandBuffer::setCullMode(VkCullModeFlags cullMode)
+{
+    ASSERT(valid());
+    vkCmdSetCullModeEXT(mHandle, cullMode);
+}
+
+ANGLE_INLINE void CommandBuffer::setDepthCompareOp(VkCompareOp depthCompareOp)
+{
+    ASSERT(valid());
+    vkCmdSetDepthCompareOpEXT(mHandle, depthCompareOp);
+}
+
+ANGLE_INLINE void CommandBuffer::setDepthTestEnable(VkBool32 depthTestEnable)
+{
+    ASSERT(valid());
+    vkCmdSetDepthTestEnableEXT(mHandle, depthTestEnable);
+}
+
+ANGLE_INLINE void CommandBuffer::setDepthWriteEnable(VkBool32 depthWriteEnable)
+{
+    ASSERT(valid());
+    vkCmdSetDepthWriteEnableEXT(mHandle, depthWriteEnable);
 }
 
 ANGLE_INLINE void CommandBuffer::setEvent(VkEvent event, VkPipelineStageFlags stageMask)
@@ -974,6 +1030,18 @@ ANGLE_INLINE void CommandBuffer::setEvent(VkEvent event, VkPipelineStageFlags st
     vkCmdSetEvent(mHandle, event, stageMask);
 }
 
+ANGLE_INLINE void CommandBuffer::setFrontFace(VkFrontFace frontFace)
+{
+    ASSERT(valid());
+    vkCmdSetFrontFaceEXT(mHandle, frontFace);
+}
+
+ANGLE_INLINE void CommandBuffer::setPrimitiveTopology(VkPrimitiveTopology primitiveTopology)
+{
+    ASSERT(valid());
+    vkCmdSetPrimitiveTopologyEXT(mHandle, primitiveTopology);
+}
+
 ANGLE_INLINE void CommandBuffer::setScissor(uint32_t firstScissor,
                                             uint32_t scissorCount,
                                             const VkRect2D *scissors)
@@ -982,6 +1050,22 @@ ANGLE_INLINE void CommandBuffer::setScissor(uint32_t firstScissor,
     vkCmdSetScissor(mHandle, firstScissor, scissorCount, scissors);
 }
 
+ANGLE_INLINE void CommandBuffer::setStencilOp(VkStencilFaceFlags faceMask,
+                                              VkStencilOp failOp,
+                                              VkStencilOp passOp,
+                                              VkStencilOp depthFailOp,
+                                              VkCompareOp compareOp)
+{
+    ASSERT(valid());
+    vkCmdSetStencilOpEXT(mHandle, faceMask, failOp, passOp, depthFailOp, compareOp);
+}
+
+ANGLE_INLINE void CommandBuffer::setStencilTestEnable(VkBool32 stencilTestEnable)
+{
+    ASSERT(valid());
+    vkCmdSetStencilTestEnableEXT(mHandle, stencilTestEnable);
+}
+
 ANGLE_INLINE void CommandBuffer::resetEvent(VkEvent event, VkPipelineStageFlags stageMask)
 {
     ASSERT(valid() && event != VK_NULL_HANDLE);
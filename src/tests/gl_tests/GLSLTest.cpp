@@ -8628,6 +8628,59 @@ void main() { precise = a_position.x; gl_Position = a_position; })";
     EXPECT_NE(0u, program);
 }
 
+// Test a shader with a function call, a discard in a loop, a constant condition and an unused
+// varying.  With SPIR-V optimization on Vulkan, these are inlined, wrapped, folded and removed.
+TEST_P(GLSLTest_ES3, DiscardInLoopWithConstantCondition)
+{
+    constexpr char kVS[] = R"(#version 300 es
+in vec4 a_position;
+out vec2 v_position;
+out float v_unused;
+void main()
+{
+    v_position  = a_position.xy;
+    v_unused    = a_position.z;
+    gl_Position = a_position;
+})";
+
+    constexpr char kFS[] = R"(#version 300 es
+precision highp float;
+in vec2 v_position;
+in float v_unused;
+uniform int u_iterations;
+out vec4 my_FragColor;
+float twice(float x) { return x * 2.0; }
+void main()
+{
+    const bool kAlwaysTrue = true;
+    float sum = 0.0;
+    for (int i = 0; i < u_iterations; ++i)
+    {
+        if (v_position.x < 0.0 && i == 1)
+        {
+            discard;
+        }
+        sum += twice(0.125);
+    }
+    my_FragColor = kAlwaysTrue ? vec4(0, sum, 0, 1) : vec4(1, 0, 0, 1);
+})";
+
+    ANGLE_GL_PROGRAM(program, kVS, kFS);
+    glUseProgram(program);
+    GLint iterationsLocation = glGetUniformLocation(program, "u_iterations");
+    ASSERT_NE(-1, iterationsLocation);
+    glUniform1i(iterationsLocation, 4);
+
+    glClearColor(1.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    drawQuad(program, "a_position", 0.5f);
+    ASSERT_GL_NO_ERROR();
+
+    // The left half is discarded, the right half sums up to green.
+    EXPECT_PIXEL_COLOR_EQ(0, getWindowHeight() / 2, GLColor::red);
+    EXPECT_PIXEL_COLOR_EQ(getWindowWidth() - 1, getWindowHeight() / 2, GLColor::green);
+}
+
 // Test that the precise keyword is reserved on ES3.0 without GL_EXT_gpu_shader5.
 TEST_P(GLSLTest_ES31, PreciseReservedWithoutExtension)
 {
@@ -8790,6 +8843,15 @@ ANGLE_INSTANTIATE_TEST_ES2_AND_ES3(GLSLTestNoValidation);
 // tests should be run against.
 ANGLE_INSTANTIATE_TEST_ES3(GLSLTest_ES3);
 
+namespace optimizeSpirv
+{
+// Runs the shaders through spirv-opt after linking on Vulkan.
+ANGLE_INSTANTIATE_TEST(GLSLTest,
+                       WithOptimizeSpirvFeatureVulkan(ES2_VULKAN()),
+                       WithOptimizeSpirvFeatureVulkan(ES3_VULKAN()));
+ANGLE_INSTANTIATE_TEST(GLSLTest_ES3, WithOptimizeSpirvFeatureVulkan(ES3_VULKAN()));
+}  // namespace optimizeSpirv
+
 ANGLE_INSTANTIATE_TEST_ES2(WebGLGLSLTest);
 
 ANGLE_INSTANTIATE_TEST_ES3(WebGL2GLSLTest);
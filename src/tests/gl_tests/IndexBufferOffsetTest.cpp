@@ -7,6 +7,7 @@
 // IndexBufferOffsetTest.cpp: Test glDrawElements with an offset and an index buffer
 
 #include "test_utils/ANGLETest.h"
+#include "test_utils/gl_raii.h"
 #include "util/test_utils.h"
 
 using namespace angle;
@@ -105,6 +106,20 @@ class IndexBufferOffsetTest : public ANGLETest
         swapBuffers();
     }
 
+    // Draws the two triangles of the uint8 indices at the start of the index buffer.
+    void drawUInt8Triangles(const GLColor &color)
+    {
+        glUseProgram(mProgram);
+
+        glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+        glVertexAttribPointer(mPositionAttributeLocation, 2, GL_FLOAT, GL_FALSE, 0, 0);
+        glEnableVertexAttribArray(mPositionAttributeLocation);
+
+        glUniform4fv(mColorUniformLocation, 1, color.toNormalizedVector().data());
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_BYTE, nullptr);
+    }
+
     GLuint mProgram;
     GLint mColorUniformLocation;
     GLint mPositionAttributeLocation;
@@ -248,6 +263,99 @@ TEST_P(IndexBufferOffsetTest, DrawWithDifferentCountsSameOffset)
     EXPECT_GL_NO_ERROR();
 }
 
+// Tests that uint8 triangles drawn again from the same offset of an index buffer whose data
+// changed use the new indices.
+TEST_P(IndexBufferOffsetTest, UInt8IndexDataChangeSameOffset)
+{
+    const GLubyte zeroIndexData[8] = {};
+    const GLubyte indexData[8]     = {0, 1, 2, 1, 2, 3};
+
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(zeroIndexData), zeroIndexData, GL_DYNAMIC_DRAW);
+    drawUInt8Triangles(GLColor::red);
+    EXPECT_PIXEL_COLOR_EQ(64, 64, GLColor::black);
+
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, sizeof(indexData), indexData);
+    drawUInt8Triangles(GLColor::green);
+    EXPECT_PIXEL_COLOR_EQ(64, 64, GLColor::green);
+    EXPECT_GL_NO_ERROR();
+}
+
+class IndexBufferOffsetTestES31 : public IndexBufferOffsetTest
+{};
+
+// Tests that uint8 triangles drawn again from an index buffer that a compute shader wrote use the
+// new indices.
+TEST_P(IndexBufferOffsetTestES31, UInt8IndexWrittenByCompute)
+{
+    constexpr char kCS[] = R"(#version 310 es
+layout(local_size_x = 2) in;
+layout(std430, binding = 0) buffer Indices
+{
+    uint words[];
+};
+uniform uint values[2];
+void main()
+{
+    words[gl_LocalInvocationIndex] = values[gl_LocalInvocationIndex];
+})";
+
+    const GLubyte zeroIndexData[8] = {};
+    const GLubyte indexData[8]     = {0, 1, 2, 1, 2, 3};
+    GLuint words[2]                = {};
+    memcpy(words, indexData, sizeof(indexData));
+
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(zeroIndexData), zeroIndexData, GL_DYNAMIC_DRAW);
+    drawUInt8Triangles(GLColor::red);
+
+    ANGLE_GL_COMPUTE_PROGRAM(program, kCS);
+    glUseProgram(program);
+    glUniform1uiv(glGetUniformLocation(program, "values"), 2, words);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, mIndexBuffer);
+    glDispatchCompute(1, 1, 1);
+    glMemoryBarrier(GL_ELEMENT_ARRAY_BARRIER_BIT);
+
+    drawUInt8Triangles(GLColor::green);
+    EXPECT_PIXEL_COLOR_EQ(64, 64, GLColor::green);
+    EXPECT_GL_NO_ERROR();
+}
+
+// Tests that uint8 triangles drawn again from a persistently mapped index buffer use the indices
+// written through the mapping.
+TEST_P(IndexBufferOffsetTestES31, UInt8IndexPersistentlyMapped)
+{
+    ANGLE_SKIP_TEST_IF(!IsGLExtensionEnabled("GL_EXT_buffer_storage"));
+
+    constexpr GLbitfield kMapFlags =
+        GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT_EXT | GL_MAP_COHERENT_BIT_EXT;
+    const GLubyte zeroIndexData[8] = {};
+    const GLubyte indexData[8]     = {0, 1, 2, 1, 2, 3};
+
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+    glBufferStorageEXT(GL_ELEMENT_ARRAY_BUFFER, sizeof(zeroIndexData), zeroIndexData, kMapFlags);
+    void *mapPtr = glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, sizeof(zeroIndexData), kMapFlags);
+    ASSERT_NE(nullptr, mapPtr);
+
+    // Make sure the indices are converted before they are written.
+    drawUInt8Triangles(GLColor::red);
+    glFinish();
+
+    memcpy(mapPtr, indexData, sizeof(indexData));
+    drawUInt8Triangles(GLColor::green);
+    EXPECT_PIXEL_COLOR_EQ(64, 64, GLColor::green);
+
+    glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+    EXPECT_GL_NO_ERROR();
+}
+
 ANGLE_INSTANTIATE_TEST(IndexBufferOffsetTest,
                        ES2_D3D9(),
                        ES2_D3D11(),
@@ -258,3 +366,5 @@ ANGLE_INSTANTIATE_TEST(IndexBufferOffsetTest,
                        ES2_OPENGLES(),
                        ES3_OPENGLES(),
                        ES2_VULKAN());
+
+ANGLE_INSTANTIATE_TEST_ES31(IndexBufferOffsetTestES31);
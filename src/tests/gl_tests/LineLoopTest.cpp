@@ -91,6 +91,18 @@ class LineLoopTest : public ANGLETest
         checkPixels();
     }
 
+    // Draws a degenerate line loop from the bound index buffer, so its indices are translated
+    // before they are changed.
+    void drawDegenerateLineLoop(GLenum indexType, const void *indexPtr)
+    {
+        static const GLfloat positions[2] = {};
+
+        glUseProgram(mProgram);
+        glEnableVertexAttribArray(mPositionLocation);
+        glVertexAttribPointer(mPositionLocation, 2, GL_FLOAT, GL_FALSE, 0, positions);
+        glDrawElements(GL_LINE_LOOP, 4, indexType, indexPtr);
+    }
+
     GLuint mProgram;
     GLint mPositionLocation;
     GLint mColorLocation;
@@ -186,6 +198,36 @@ TEST_P(LineLoopTest, LineLoopUIntIndexBuffer)
     glDeleteBuffers(1, &buf);
 }
 
+// Tests that a line loop drawn again from an index buffer whose data changed uses the new indices.
+TEST_P(LineLoopTest, LineLoopIndexBufferDataChange)
+{
+    // Disable D3D11 SDK Layers warnings checks, see ANGLE issue 667 for details
+    ignoreD3D11SDKLayersWarnings();
+
+    static const GLubyte ubyteIndices[]   = {0, 7, 6, 9, 8, 0};
+    static const GLushort ushortIndices[] = {0, 7, 6, 9, 8, 0};
+
+    for (GLenum indexType : {GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT})
+    {
+        const bool isUByte     = indexType == GL_UNSIGNED_BYTE;
+        const size_t indexSize = isUByte ? sizeof(GLubyte) : sizeof(GLushort);
+        const void *indices    = isUByte ? static_cast<const void *>(ubyteIndices)
+                                         : static_cast<const void *>(ushortIndices);
+        const size_t bufferSize = 6 * indexSize;
+
+        // Draw a degenerate line loop from the same offset first.
+        std::vector<GLubyte> zeroIndices(bufferSize, 0);
+
+        GLBuffer buf;
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buf);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, bufferSize, zeroIndices.data(), GL_DYNAMIC_DRAW);
+        drawDegenerateLineLoop(indexType, reinterpret_cast<const void *>(indexSize));
+
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, bufferSize, indices);
+        runTest(indexType, buf, reinterpret_cast<const void *>(indexSize));
+    }
+}
+
 // Tests an edge case with a very large line loop element count.
 // Disabled because it is slow and triggers an internal error.
 TEST_P(LineLoopTest, DISABLED_DrawArraysWithLargeCount)
@@ -474,6 +516,104 @@ TEST_P(LineLoopIndirectTest, UShortIndexIndirectBuffer)
     runTest(GL_UNSIGNED_SHORT, reinterpret_cast<const void *>(indices), sizeof(indices), 1);
 }
 
+class LineLoopTestES31 : public LineLoopTest
+{
+  protected:
+    // Writes |words| to |buffer| with a compute shader.
+    void writeIndicesWithCompute(GLuint buffer, const std::array<GLuint, 8> &words)
+    {
+        constexpr char kCS[] = R"(#version 310 es
+layout(local_size_x = 8) in;
+layout(std430, binding = 0) buffer Indices
+{
+    uint words[];
+};
+uniform uint values[8];
+void main()
+{
+    words[gl_LocalInvocationIndex] = values[gl_LocalInvocationIndex];
+})";
+
+        ANGLE_GL_COMPUTE_PROGRAM(program, kCS);
+        glUseProgram(program);
+        glUniform1uiv(glGetUniformLocation(program, "values"), 8, words.data());
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, buffer);
+        glDispatchCompute(1, 1, 1);
+        glMemoryBarrier(GL_ELEMENT_ARRAY_BARRIER_BIT);
+        ASSERT_GL_NO_ERROR();
+    }
+};
+
+// Tests that a line loop drawn again from an index buffer that a compute shader wrote uses the new
+// indices.
+TEST_P(LineLoopTestES31, IndexBufferWrittenByCompute)
+{
+    static const GLubyte ubyteIndices[] = {0, 7, 6, 9, 8, 0};
+    static const GLuint uintIndices[]   = {0, 7, 6, 9, 8, 0};
+
+    for (GLenum indexType : {GL_UNSIGNED_BYTE, GL_UNSIGNED_INT})
+    {
+        const bool isUByte     = indexType == GL_UNSIGNED_BYTE;
+        const size_t indexSize = isUByte ? sizeof(GLubyte) : sizeof(GLuint);
+        const void *indices    = isUByte ? static_cast<const void *>(ubyteIndices)
+                                         : static_cast<const void *>(uintIndices);
+
+        std::array<GLuint, 8> words = {};
+        memcpy(words.data(), indices, 6 * indexSize);
+        const std::array<GLuint, 8> zeroWords = {};
+
+        GLBuffer buf;
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buf);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(zeroWords), zeroWords.data(),
+                     GL_DYNAMIC_DRAW);
+        drawDegenerateLineLoop(indexType, reinterpret_cast<const void *>(indexSize));
+
+        writeIndicesWithCompute(buf, words);
+        runTest(indexType, buf, reinterpret_cast<const void *>(indexSize));
+    }
+}
+
+// Tests that a line loop drawn again from a persistently mapped index buffer uses the indices
+// written through the mapping.
+TEST_P(LineLoopTestES31, PersistentlyMappedIndexBuffer)
+{
+    ANGLE_SKIP_TEST_IF(!IsGLExtensionEnabled("GL_EXT_buffer_storage"));
+
+    static const GLubyte ubyteIndices[]   = {0, 7, 6, 9, 8, 0};
+    static const GLushort ushortIndices[] = {0, 7, 6, 9, 8, 0};
+
+    constexpr GLbitfield kMapFlags =
+        GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT_EXT | GL_MAP_COHERENT_BIT_EXT;
+
+    for (GLenum indexType : {GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT})
+    {
+        const bool isUByte     = indexType == GL_UNSIGNED_BYTE;
+        const size_t indexSize = isUByte ? sizeof(GLubyte) : sizeof(GLushort);
+        const void *indices    = isUByte ? static_cast<const void *>(ubyteIndices)
+                                         : static_cast<const void *>(ushortIndices);
+        const size_t bufferSize = 6 * indexSize;
+
+        std::vector<GLubyte> zeroIndices(bufferSize, 0);
+
+        GLBuffer buf;
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buf);
+        glBufferStorageEXT(GL_ELEMENT_ARRAY_BUFFER, bufferSize, zeroIndices.data(), kMapFlags);
+        void *mapPtr = glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, bufferSize, kMapFlags);
+        ASSERT_NE(nullptr, mapPtr);
+
+        // Make sure the indices are translated before they are written.
+        drawDegenerateLineLoop(indexType, reinterpret_cast<const void *>(indexSize));
+        glFinish();
+
+        memcpy(mapPtr, indices, bufferSize);
+        runTest(indexType, buf, reinterpret_cast<const void *>(indexSize));
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buf);
+        glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+        ASSERT_GL_NO_ERROR();
+    }
+}
+
 // Use this to select which configurations (e.g. which renderer, which GLES major version) these
 // tests should be run against.
 ANGLE_INSTANTIATE_TEST_ES2(LineLoopTest);
@@ -486,3 +626,5 @@ ANGLE_INSTANTIATE_TEST_ES3_AND(
                                              /* cheapRenderPass */ false));
 
 ANGLE_INSTANTIATE_TEST_ES31(LineLoopIndirectTest);
+
+ANGLE_INSTANTIATE_TEST_ES31(LineLoopTestES31);
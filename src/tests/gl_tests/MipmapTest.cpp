@@ -34,6 +34,80 @@ void TexImageCubeMapFaces(GLint level,
                  type, pixels);
 }
 
+// Makes level 0 data whose 2x2 (or 2x2x2 for 3D) blocks are uniform, so every texel of level 1 is
+// the average of identical texels and holds its own coordinates.  2D array layers keep their index
+// in blue.
+std::vector<GLColor> MakeBlockPattern(GLsizei width, GLsizei height, GLsizei depth, bool is3D)
+{
+    std::vector<GLColor> data;
+    data.reserve(width * height * depth);
+    for (GLsizei z = 0; z < depth; ++z)
+    {
+        for (GLsizei y = 0; y < height; ++y)
+        {
+            for (GLsizei x = 0; x < width; ++x)
+            {
+                data.emplace_back(static_cast<GLubyte>(x >> 1), static_cast<GLubyte>(y >> 1),
+                                  static_cast<GLubyte>(is3D ? z >> 1 : z * 40), 255);
+            }
+        }
+    }
+    return data;
+}
+
+// Verifies level 1 of a texture filled with MakeBlockPattern.  The trailing row, column or slice
+// of an odd-sized level 0 is dropped by a box filter, but other paths may blend it in, so allow
+// off-by-one values.
+void VerifyBlockPatternLevelOne(GLenum target,
+                                GLuint texture,
+                                GLsizei width,
+                                GLsizei height,
+                                GLsizei depth)
+{
+    const bool is3D          = target == GL_TEXTURE_3D;
+    const GLsizei mipWidth   = std::max(1, width >> 1);
+    const GLsizei mipHeight  = std::max(1, height >> 1);
+    const GLsizei mipDepth   = is3D ? std::max(1, depth >> 1) : depth;
+    constexpr int kTolerance = 1;
+
+    GLFramebuffer framebuffer;
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+    std::vector<GLColor> pixels(mipWidth * mipHeight);
+    for (GLsizei z = 0; z < mipDepth; ++z)
+    {
+        if (target == GL_TEXTURE_2D)
+        {
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 1);
+        }
+        else
+        {
+            glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, texture, 1, z);
+        }
+        ASSERT_GLENUM_EQ(GL_FRAMEBUFFER_COMPLETE, glCheckFramebufferStatus(GL_FRAMEBUFFER));
+
+        glReadPixels(0, 0, mipWidth, mipHeight, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        ASSERT_GL_NO_ERROR();
+
+        const int expectedBlue = is3D ? z : z * 40;
+        for (GLsizei y = 0; y < mipHeight; ++y)
+        {
+            for (GLsizei x = 0; x < mipWidth; ++x)
+            {
+                const GLColor &actual = pixels[y * mipWidth + x];
+                if (std::abs(actual.R - x) > kTolerance || std::abs(actual.G - y) > kTolerance ||
+                    std::abs(actual.B - expectedBlue) > kTolerance || actual.A != 255)
+                {
+                    FAIL() << "Unexpected color " << actual << " at (" << x << ", " << y << ", "
+                           << z << ") of level 1";
+                }
+            }
+        }
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
 class BaseMipmapTest : public ANGLETest
 {
   protected:
@@ -742,6 +816,66 @@ TEST_P(MipmapTestES3, GenerateMipmapLongNPOTTexture)
     verifyAllMips(kTextureWidth, kTextureHeight, kInitialColor[0]);
 }
 
+// Generates mipmaps for an odd-sized 2D texture large enough for the CPU path to split level 1 in
+// several bands of rows, and verifies every texel.
+TEST_P(MipmapTestES3, GenerateMipmapOddNPOTTexture)
+{
+    constexpr GLsizei kTextureWidth  = 509;
+    constexpr GLsizei kTextureHeight = 307;
+
+    const std::vector<GLColor> data = MakeBlockPattern(kTextureWidth, kTextureHeight, 1, false);
+
+    glBindTexture(GL_TEXTURE_2D, mTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, kTextureWidth, kTextureHeight, 0, GL_RGBA,
+                 GL_UNSIGNED_BYTE, data.data());
+    glGenerateMipmap(GL_TEXTURE_2D);
+    ASSERT_GL_NO_ERROR();
+
+    VerifyBlockPatternLevelOne(GL_TEXTURE_2D, mTexture, kTextureWidth, kTextureHeight, 1);
+}
+
+// Generates mipmaps for an odd-sized 2D array texture, whose layers the CPU path filters in
+// parallel, and verifies every texel of every layer.
+TEST_P(MipmapTestES3, GenerateMipmapOddNPOTTextureArray)
+{
+    constexpr GLsizei kTextureWidth  = 131;
+    constexpr GLsizei kTextureHeight = 77;
+    constexpr GLsizei kLayers        = 3;
+
+    const std::vector<GLColor> data =
+        MakeBlockPattern(kTextureWidth, kTextureHeight, kLayers, false);
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, mTexture);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, kTextureWidth, kTextureHeight, kLayers, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+    glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+    ASSERT_GL_NO_ERROR();
+
+    VerifyBlockPatternLevelOne(GL_TEXTURE_2D_ARRAY, mTexture, kTextureWidth, kTextureHeight,
+                               kLayers);
+}
+
+// Generates mipmaps for an odd-sized 3D texture large enough for the CPU path to split level 1 in
+// several bands of slices, and verifies every texel.
+TEST_P(MipmapTestES3, GenerateMipmapOddNPOTTexture3D)
+{
+    constexpr GLsizei kTextureWidth  = 131;
+    constexpr GLsizei kTextureHeight = 67;
+    constexpr GLsizei kTextureDepth  = 37;
+
+    const std::vector<GLColor> data =
+        MakeBlockPattern(kTextureWidth, kTextureHeight, kTextureDepth, true);
+
+    glBindTexture(GL_TEXTURE_3D, mTexture);
+    glTexImage3D(GL_TEXTURE_3D, 0, GL_RGBA8, kTextureWidth, kTextureHeight, kTextureDepth, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+    glGenerateMipmap(GL_TEXTURE_3D);
+    ASSERT_GL_NO_ERROR();
+
+    VerifyBlockPatternLevelOne(GL_TEXTURE_3D, mTexture, kTextureWidth, kTextureHeight,
+                               kTextureDepth);
+}
+
 // This test generates (and uses) mipmaps on a texture using init data. D3D11 will use a
 // non-renderable TextureStorage for this. The test then disables mips, renders to level zero of the
 // texture, and reenables mips before using the texture again. To do this, D3D11 has to convert the
@@ -2053,5 +2187,14 @@ ANGLE_INSTANTIATE_TEST(Mipmap3DBoxFilterTest,
                        WithNoGenMultipleMipsPerPass(ES2_METAL()));
 }  // namespace extraPlatforms
 
+namespace cpuGenerateMipmap
+{
+// Vulkan generates mipmaps on the CPU when the image can't be used for blits or compute.  Force
+// that path on to cover odd sizes, 2D arrays and 3D textures.
+ANGLE_INSTANTIATE_TEST(MipmapTest, WithCPUGenerateMipmapFeatureVulkan(ES2_VULKAN()));
+ANGLE_INSTANTIATE_TEST(Mipmap3DBoxFilterTest, WithCPUGenerateMipmapFeatureVulkan(ES2_VULKAN()));
+ANGLE_INSTANTIATE_TEST(MipmapTestES3, WithCPUGenerateMipmapFeatureVulkan(ES3_VULKAN()));
+}  // namespace cpuGenerateMipmap
+
 ANGLE_INSTANTIATE_TEST_ES3(MipmapTestES3);
 ANGLE_INSTANTIATE_TEST_ES31(MipmapTestES31);
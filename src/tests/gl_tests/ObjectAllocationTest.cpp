@@ -49,6 +49,41 @@ TEST_P(ObjectAllocationTest, BindFramebufferAfterGen)
     EXPECT_GL_NO_ERROR();
 }
 
+// Test that deleting several framebuffers at once, including zero, a bound framebuffer and one that
+// was never bound, unbinds the deleted framebuffer and keeps the default framebuffer.
+TEST_P(ObjectAllocationTest, DeleteFramebuffersWithZero)
+{
+    GLuint fbos[3] = {0};
+    glGenFramebuffers(3, fbos);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbos[1]);
+
+    GLuint deletedFBOs[4] = {fbos[0], 0, fbos[1], fbos[2]};
+    glDeleteFramebuffers(4, deletedFBOs);
+    EXPECT_GL_NO_ERROR();
+
+    GLint binding = -1;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &binding);
+    EXPECT_EQ(0, binding);
+    EXPECT_GL_FALSE(glIsFramebuffer(fbos[0]));
+    EXPECT_GL_FALSE(glIsFramebuffer(fbos[1]));
+    EXPECT_GL_FALSE(glIsFramebuffer(fbos[2]));
+
+    // The default framebuffer is still usable.
+    glClearColor(1.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::red);
+
+    // The deleted names are reused.
+    GLuint newFBOs[3] = {0};
+    glGenFramebuffers(3, newFBOs);
+    for (GLuint newFBO : newFBOs)
+    {
+        EXPECT_TRUE(newFBO == fbos[0] || newFBO == fbos[1] || newFBO == fbos[2]);
+    }
+    glDeleteFramebuffers(3, newFBOs);
+    EXPECT_GL_NO_ERROR();
+}
+
 }  // anonymous namespace
 
 ANGLE_INSTANTIATE_TEST_ES3(ObjectAllocationTest);
\ No newline at end of file
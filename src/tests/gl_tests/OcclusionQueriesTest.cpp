@@ -125,6 +125,58 @@ TEST_P(OcclusionQueriesTest, IsNotOccluded)
     EXPECT_GL_TRUE(result);
 }
 
+// Test that polling for the result availability without flushing eventually succeeds, and that
+// the result is correct.  VulkanPerformanceCounterTest verifies the first poll doesn't flush.
+TEST_P(OcclusionQueriesTest, PollAvailabilityWithoutFlush)
+{
+    ANGLE_SKIP_TEST_IF(getClientMajorVersion() < 3 &&
+                       !IsGLExtensionEnabled("GL_EXT_occlusion_query_boolean"));
+
+    // http://anglebug.com/5400
+    ANGLE_SKIP_TEST_IF(IsOSX() && IsMetal());
+
+    glDepthMask(GL_TRUE);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+    glEnable(GL_DEPTH_TEST);
+    drawQuad(mProgram, essl1_shaders::PositionAttrib(), 0.3f);
+
+    GLuint queries[2] = {};
+    glGenQueriesEXT(2, queries);
+
+    glBeginQueryEXT(GL_ANY_SAMPLES_PASSED_EXT, queries[0]);
+    drawQuad(mProgram, essl1_shaders::PositionAttrib(), 0.8f);  // this quad should be occluded
+    glEndQueryEXT(GL_ANY_SAMPLES_PASSED_EXT);
+
+    glBeginQueryEXT(GL_ANY_SAMPLES_PASSED_EXT, queries[1]);
+    drawQuad(mProgram, essl1_shaders::PositionAttrib(), 0.0f);  // this quad should not be occluded
+    glEndQueryEXT(GL_ANY_SAMPLES_PASSED_EXT);
+
+    EXPECT_GL_NO_ERROR();
+
+    for (GLuint query : queries)
+    {
+        GLuint ready = GL_FALSE;
+        while (ready == GL_FALSE)
+        {
+            angle::Sleep(0);
+            glGetQueryObjectuivEXT(query, GL_QUERY_RESULT_AVAILABLE_EXT, &ready);
+        }
+    }
+
+    GLuint result = GL_TRUE;
+    glGetQueryObjectuivEXT(queries[0], GL_QUERY_RESULT_EXT, &result);
+    EXPECT_GL_FALSE(result);
+
+    result = GL_FALSE;
+    glGetQueryObjectuivEXT(queries[1], GL_QUERY_RESULT_EXT, &result);
+    EXPECT_GL_TRUE(result);
+
+    EXPECT_GL_NO_ERROR();
+
+    glDeleteQueriesEXT(2, queries);
+}
+
 // Test that glClear should not be counted by occlusion query.
 TEST_P(OcclusionQueriesTest, ClearNotCounted)
 {
@@ -823,6 +823,12 @@ TEST_P(ProgramBinaryTest, SRGBDecodeWithSamplerAndTexelFetchTest)
 
 ANGLE_INSTANTIATE_TEST_ES3(ProgramBinaryES3Test);
 
+namespace optimizeSpirv
+{
+// Saves and loads programs whose SPIR-V was optimized on Vulkan.
+ANGLE_INSTANTIATE_TEST(ProgramBinaryES3Test, WithOptimizeSpirvFeatureVulkan(ES3_VULKAN()));
+}  // namespace optimizeSpirv
+
 class ProgramBinaryES31Test : public ANGLETest
 {
   protected:
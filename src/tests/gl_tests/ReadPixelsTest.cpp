@@ -253,6 +253,9 @@ TEST_P(ReadPixelsPBONVTest, ReadFromFBO)
     EXPECT_GL_NO_ERROR();
 }
 
+// The PBO contents before a read, to check what the read overwrote.
+constexpr GLubyte kPBOFill = 0xCD;
+
 class ReadPixelsPBOTest : public ReadPixelsPBONVTest
 {
   protected:
@@ -283,6 +286,73 @@ class ReadPixelsPBOTest : public ReadPixelsPBONVTest
 
         ASSERT_GL_NO_ERROR();
     }
+
+    void fillPBO(GLsizeiptr bufferSize)
+    {
+        std::vector<GLubyte> fill(bufferSize, kPBOFill);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, mPBO);
+        glBufferData(GL_PIXEL_PACK_BUFFER, bufferSize, fill.data(), GL_STATIC_DRAW);
+    }
+
+    // Fills the texture with distinct pixels and the PBO with kPBOFill, and returns the pixels.
+    std::vector<GLColor> fillTextureAndPBO(GLsizei width, GLsizei height, GLsizeiptr bufferSize)
+    {
+        std::vector<GLColor> pixels;
+        for (GLsizei y = 0; y < height; ++y)
+        {
+            for (GLsizei x = 0; x < width; ++x)
+            {
+                pixels.emplace_back(static_cast<GLubyte>(x * 30), static_cast<GLubyte>(y * 40),
+                                    static_cast<GLubyte>(x + y), static_cast<GLubyte>(255 - x));
+            }
+        }
+
+        glBindTexture(GL_TEXTURE_2D, mTexture);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE,
+                        pixels.data());
+        fillPBO(bufferSize);
+
+        return pixels;
+    }
+
+    // Checks |width|x|height| pixels were packed |rowPitch| bytes apart from |offset| in the PBO,
+    // and that the bytes around them were left alone.
+    void expectPackedPixels(const std::vector<GLColor> &expected,
+                            GLsizei width,
+                            GLsizei height,
+                            size_t offset,
+                            size_t rowPitch,
+                            size_t bufferSize)
+    {
+        const GLubyte *mapped = static_cast<const GLubyte *>(
+            glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bufferSize, GL_MAP_READ_BIT));
+        ASSERT_NE(nullptr, mapped);
+
+        std::vector<bool> written(bufferSize, false);
+        for (GLsizei y = 0; y < height; ++y)
+        {
+            for (GLsizei x = 0; x < width; ++x)
+            {
+                size_t pixelOffset = offset + y * rowPitch + x * sizeof(GLColor);
+                GLColor actual;
+                memcpy(&actual, mapped + pixelOffset, sizeof(GLColor));
+                EXPECT_EQ(expected[y * width + x], actual) << "at " << x << ", " << y;
+                std::fill(written.begin() + pixelOffset,
+                          written.begin() + pixelOffset + sizeof(GLColor), true);
+            }
+        }
+
+        for (size_t byte = 0; byte < bufferSize; ++byte)
+        {
+            if (!written[byte])
+            {
+                EXPECT_EQ(kPBOFill, mapped[byte]) << "at byte " << byte;
+            }
+        }
+
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        EXPECT_GL_NO_ERROR();
+    }
 };
 
 // Test basic usage of PBOs.
@@ -454,6 +524,176 @@ TEST_P(ReadPixelsPBOTest, SubDataOffsetPreservesContents)
     EXPECT_GL_NO_ERROR();
 }
 
+// Test reading into a PBO with a row length that's odd and longer than the read.
+TEST_P(ReadPixelsPBOTest, OddRowPitch)
+{
+    constexpr GLsizei kWidth     = 7;
+    constexpr GLsizei kHeight    = 5;
+    constexpr GLint kRowLength   = 9;
+    constexpr size_t kRowPitch   = kRowLength * sizeof(GLColor);
+    constexpr size_t kBufferSize = kRowPitch * kHeight;
+
+    Reset(kBufferSize, kWidth, kHeight);
+    std::vector<GLColor> pixels = fillTextureAndPBO(kWidth, kHeight, kBufferSize);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, mFBO);
+    glPixelStorei(GL_PACK_ROW_LENGTH, kRowLength);
+    glReadPixels(0, 0, kWidth, kHeight, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+    EXPECT_GL_NO_ERROR();
+
+    expectPackedPixels(pixels, kWidth, kHeight, 0, kRowPitch, kBufferSize);
+}
+
+// Test reading into a PBO with a pack alignment that pads the rows, and a sub-rectangle.
+TEST_P(ReadPixelsPBOTest, PackAlignment)
+{
+    constexpr GLsizei kTextureWidth  = 8;
+    constexpr GLsizei kTextureHeight = 6;
+    constexpr GLsizei kWidth         = 3;
+    constexpr GLsizei kHeight        = 4;
+    // 12 bytes per row, padded to 16.
+    constexpr size_t kRowPitch   = 16;
+    constexpr size_t kBufferSize = kRowPitch * kHeight;
+
+    Reset(kBufferSize, kTextureWidth, kTextureHeight);
+    std::vector<GLColor> pixels = fillTextureAndPBO(kTextureWidth, kTextureHeight, kBufferSize);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, mFBO);
+    glPixelStorei(GL_PACK_ALIGNMENT, 8);
+    glReadPixels(2, 1, kWidth, kHeight, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    EXPECT_GL_NO_ERROR();
+
+    std::vector<GLColor> expected;
+    for (GLsizei y = 1; y < 1 + kHeight; ++y)
+    {
+        for (GLsizei x = 2; x < 2 + kWidth; ++x)
+        {
+            expected.push_back(pixels[y * kTextureWidth + x]);
+        }
+    }
+    expectPackedPixels(expected, kWidth, kHeight, 0, kRowPitch, kBufferSize);
+}
+
+// Test reading into a PBO at an offset that isn't a multiple of the pixel size.
+TEST_P(ReadPixelsPBOTest, UnalignedOffset)
+{
+    constexpr GLsizei kWidth     = 4;
+    constexpr GLsizei kHeight    = 3;
+    constexpr size_t kOffset     = 6;
+    constexpr size_t kRowPitch   = kWidth * sizeof(GLColor);
+    constexpr size_t kBufferSize = kOffset + kRowPitch * kHeight + 2;
+
+    Reset(kBufferSize, kWidth, kHeight);
+    std::vector<GLColor> pixels = fillTextureAndPBO(kWidth, kHeight, kBufferSize);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, mFBO);
+    glReadPixels(0, 0, kWidth, kHeight, GL_RGBA, GL_UNSIGNED_BYTE,
+                 reinterpret_cast<void *>(kOffset));
+    EXPECT_GL_NO_ERROR();
+
+    expectPackedPixels(pixels, kWidth, kHeight, kOffset, kRowPitch, kBufferSize);
+}
+
+// Test reading a BGRA framebuffer as RGBA into a PBO, which converts the format.
+TEST_P(ReadPixelsPBOTest, BGRAToRGBA)
+{
+    ANGLE_SKIP_TEST_IF(!IsGLExtensionEnabled("GL_EXT_texture_format_BGRA8888"));
+
+    constexpr GLsizei kWidth     = 5;
+    constexpr GLsizei kHeight    = 3;
+    constexpr size_t kRowPitch   = kWidth * sizeof(GLColor);
+    constexpr size_t kBufferSize = kRowPitch * kHeight;
+
+    fillPBO(kBufferSize);
+
+    std::vector<GLColor> pixels;
+    std::vector<GLColor> bgraPixels;
+    for (GLsizei y = 0; y < kHeight; ++y)
+    {
+        for (GLsizei x = 0; x < kWidth; ++x)
+        {
+            GLColor color(static_cast<GLubyte>(x * 50), static_cast<GLubyte>(y * 60),
+                          static_cast<GLubyte>(x + y + 1), static_cast<GLubyte>(200 + x));
+            pixels.push_back(color);
+            bgraPixels.emplace_back(color.B, color.G, color.R, color.A);
+        }
+    }
+
+    GLTexture bgraTexture;
+    glBindTexture(GL_TEXTURE_2D, bgraTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_BGRA_EXT, kWidth, kHeight, 0, GL_BGRA_EXT, GL_UNSIGNED_BYTE,
+                 bgraPixels.data());
+
+    GLFramebuffer framebuffer;
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, bgraTexture, 0);
+    ASSERT_GLENUM_EQ(GL_FRAMEBUFFER_COMPLETE, glCheckFramebufferStatus(GL_FRAMEBUFFER));
+
+    glReadPixels(0, 0, kWidth, kHeight, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    EXPECT_GL_NO_ERROR();
+
+    expectPackedPixels(pixels, kWidth, kHeight, 0, kRowPitch, kBufferSize);
+}
+
+// Test reading an RGBA framebuffer as BGRA into a PBO.
+TEST_P(ReadPixelsPBOTest, RGBAToBGRA)
+{
+    ANGLE_SKIP_TEST_IF(!IsGLExtensionEnabled("GL_EXT_read_format_bgra"));
+
+    constexpr GLsizei kWidth     = 6;
+    constexpr GLsizei kHeight    = 2;
+    constexpr size_t kRowPitch   = kWidth * sizeof(GLColor);
+    constexpr size_t kBufferSize = kRowPitch * kHeight;
+
+    Reset(kBufferSize, kWidth, kHeight);
+    std::vector<GLColor> pixels = fillTextureAndPBO(kWidth, kHeight, kBufferSize);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, mFBO);
+    glReadPixels(0, 0, kWidth, kHeight, GL_BGRA_EXT, GL_UNSIGNED_BYTE, nullptr);
+    EXPECT_GL_NO_ERROR();
+
+    std::vector<GLColor> expected;
+    for (const GLColor &color : pixels)
+    {
+        expected.emplace_back(color.B, color.G, color.R, color.A);
+    }
+    expectPackedPixels(expected, kWidth, kHeight, 0, kRowPitch, kBufferSize);
+}
+
+// Test reading the window into a PBO keeps the bottom row first, for backends that store the
+// window flipped.
+TEST_P(ReadPixelsPBOTest, WindowRowOrder)
+{
+    const GLsizei width  = getWindowWidth();
+    const GLsizei height = getWindowHeight();
+
+    glClearColor(1.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(0, height / 2, width, height - height / 2);
+    glClearColor(0.0f, 1.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glDisable(GL_SCISSOR_TEST);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, mPBO);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    EXPECT_GL_NO_ERROR();
+
+    const GLColor *mapped = static_cast<const GLColor *>(glMapBufferRange(
+        GL_PIXEL_PACK_BUFFER, 0, width * height * sizeof(GLColor), GL_MAP_READ_BIT));
+    ASSERT_NE(nullptr, mapped);
+    for (GLsizei y = 0; y < height; ++y)
+    {
+        const GLColor &expected = y < height / 2 ? GLColor::red : GLColor::green;
+        EXPECT_EQ(expected, mapped[y * width]) << "row " << y;
+        EXPECT_EQ(expected, mapped[y * width + width - 1]) << "row " << y;
+    }
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    EXPECT_GL_NO_ERROR();
+}
+
 class ReadPixelsPBODrawTest : public ReadPixelsPBOTest
 {
   protected:
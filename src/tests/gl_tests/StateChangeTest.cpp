@@ -2748,6 +2748,100 @@ TEST_P(SimpleStateChangeTestES3, InvalidateThenSubUploadThenBlend)
     blendAndVerifyColor(GLColor32F(1.0f, 0.0f, 0.0f, 0.5f), GLColor(127, 127, 127, 191));
 }
 
+// Tests drawing with several pipelines into framebuffers of many formats.  The render pass cache
+// grows while pipelines created for earlier render passes may still be built on worker threads
+// (with the Vulkan asyncGraphicsPipelineOptimization feature).  The results are verified both
+// before and after the optimized pipelines replace the initial ones.
+TEST_P(SimpleStateChangeTestES3, ManyPipelinesAcrossRenderPasses)
+{
+    struct FormatAndColor
+    {
+        GLenum internalFormat;
+        GLColor expected;
+    };
+    constexpr size_t kFormatCount                           = 8;
+    const std::array<FormatAndColor, kFormatCount> kFormats = {{
+        {GL_RGBA8, GLColor::white},
+        {GL_RGB565, GLColor::white},
+        {GL_RGBA4, GLColor::white},
+        {GL_RGB5_A1, GLColor::white},
+        {GL_RGB10_A2, GLColor::white},
+        {GL_SRGB8_ALPHA8, GLColor::white},
+        {GL_R8, GLColor(255, 0, 0, 255)},
+        {GL_RG8, GLColor(255, 255, 0, 255)},
+    }};
+    constexpr GLsizei kSize = 4;
+
+    ANGLE_GL_PROGRAM(program, essl1_shaders::vs::Simple(), essl1_shaders::fs::UniformColor());
+    glUseProgram(program);
+    GLint colorUniformLocation =
+        glGetUniformLocation(program, angle::essl1_shaders::ColorUniform());
+    ASSERT_NE(colorUniformLocation, -1);
+    glUniform4fv(colorUniformLocation, 1, GLColor::white.toNormalizedVector().data());
+
+    // Each format is used with and without a depth attachment, for different render passes.
+    std::array<GLTexture, kFormatCount> textures;
+    std::array<GLRenderbuffer, kFormatCount> depthbuffers;
+    std::array<GLFramebuffer, kFormatCount * 2> framebuffers;
+    for (size_t formatIndex = 0; formatIndex < kFormatCount; ++formatIndex)
+    {
+        glBindTexture(GL_TEXTURE_2D, textures[formatIndex]);
+        glTexStorage2D(GL_TEXTURE_2D, 1, kFormats[formatIndex].internalFormat, kSize, kSize);
+        glBindRenderbuffer(GL_RENDERBUFFER, depthbuffers[formatIndex]);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, kSize, kSize);
+
+        for (size_t withDepth = 0; withDepth < 2; ++withDepth)
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, framebuffers[formatIndex * 2 + withDepth]);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                                   textures[formatIndex], 0);
+            if (withDepth)
+            {
+                glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER,
+                                          depthbuffers[formatIndex]);
+            }
+            ASSERT_GL_FRAMEBUFFER_COMPLETE(GL_FRAMEBUFFER);
+        }
+    }
+    ASSERT_GL_NO_ERROR();
+
+    glViewport(0, 0, kSize, kSize);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+
+    for (int round = 0; round < 2; ++round)
+    {
+        for (size_t framebufferIndex = 0; framebufferIndex < framebuffers.size();
+             ++framebufferIndex)
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, framebuffers[framebufferIndex]);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+            // Each of these draws white with a different pipeline.
+            drawQuad(program, essl1_shaders::PositionAttrib(), 0.5f);
+
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_ONE, GL_ZERO);
+            drawQuad(program, essl1_shaders::PositionAttrib(), 0.5f);
+
+            glBlendEquation(GL_MAX);
+            drawQuad(program, essl1_shaders::PositionAttrib(), 0.5f);
+            glBlendEquation(GL_FUNC_ADD);
+            glDisable(GL_BLEND);
+
+            glEnable(GL_POLYGON_OFFSET_FILL);
+            glPolygonOffset(1.0f, 1.0f);
+            drawQuad(program, essl1_shaders::PositionAttrib(), 0.5f);
+            glDisable(GL_POLYGON_OFFSET_FILL);
+
+            EXPECT_PIXEL_COLOR_NEAR(0, 0, kFormats[framebufferIndex / 2].expected, 1);
+        }
+        ASSERT_GL_NO_ERROR();
+
+        // Let the worker threads finish, so the second round uses the optimized pipelines.
+        glFinish();
+    }
+}
+
 // Tests that invalidate then compute write works
 TEST_P(SimpleStateChangeTestES31, InvalidateThenStorageWriteThenBlend)
 {
@@ -5838,6 +5932,15 @@ ANGLE_INSTANTIATE_TEST_ES3(StateChangeTestES3);
 ANGLE_INSTANTIATE_TEST_ES3(StateChangeRenderTestES3);
 ANGLE_INSTANTIATE_TEST_ES2(SimpleStateChangeTest);
 ANGLE_INSTANTIATE_TEST_ES3(SimpleStateChangeTestES3);
+
+namespace asyncPipelineOptimization
+{
+// Creates unoptimized pipelines on Vulkan and optimizes them on worker threads.
+ANGLE_INSTANTIATE_TEST(StateChangeRenderTestES3,
+                       WithAsyncPipelineOptimizationFeatureVulkan(ES3_VULKAN()));
+ANGLE_INSTANTIATE_TEST(SimpleStateChangeTestES3,
+                       WithAsyncPipelineOptimizationFeatureVulkan(ES3_VULKAN()));
+}  // namespace asyncPipelineOptimization
 ANGLE_INSTANTIATE_TEST_ES3(ImageRespecificationTest);
 ANGLE_INSTANTIATE_TEST_ES31(SimpleStateChangeTestES31);
 ANGLE_INSTANTIATE_TEST_ES31(SimpleStateChangeTestComputeES31);
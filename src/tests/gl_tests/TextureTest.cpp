@@ -5,6 +5,7 @@
 //
 
 #include "common/mathutil.h"
+#include "image_util/loadimage.h"
 #include "test_utils/ANGLETest.h"
 #include "test_utils/gl_raii.h"
 
@@ -8581,6 +8582,473 @@ TEST_P(ETC1CompressedTextureTest, ETC1ShrinkThenGrowMaxLevels)
     ASSERT_GL_NO_ERROR();
 }
 
+// Test that ETC1 textures decode to the same texels as ANGLE's CPU decoder does, with blocks in
+// each of the modes it decodes and a size that is not a multiple of the block size.  On Vulkan,
+// ETC1 may be decoded in a compute shader instead.
+TEST_P(ETC1CompressedTextureTest, ETC1DecodeMatchesCPUDecoder)
+{
+    ANGLE_SKIP_TEST_IF(getClientMajorVersion() < 3);
+    ANGLE_SKIP_TEST_IF(!IsGLExtensionEnabled("GL_OES_compressed_ETC1_RGB8_texture"));
+
+    // The T, H and planar modes of ETC2 are invalid in ETC1, so only ANGLE's own decoders are
+    // expected to agree on them.  The Vulkan backend decodes ETC1 itself when ETC2 is not natively
+    // supported, and uses the native decoder otherwise, which is a superset of ETC1.
+    ANGLE_SKIP_TEST_IF(!IsVulkan());
+
+    constexpr GLsizei kWidth       = 37;
+    constexpr GLsizei kHeight      = 22;
+    constexpr GLsizei kBlockCountX = (kWidth + 3) / 4;
+    constexpr GLsizei kBlockCountY = (kHeight + 3) / 4;
+    constexpr GLsizei kBlockSize   = 8;
+    constexpr GLsizei kImageSize   = kBlockCountX * kBlockCountY * kBlockSize;
+
+    enum BlockMode
+    {
+        kIndividual,
+        kDifferential,
+        kT,
+        kH,
+        kPlanar,
+        kBlockModeCount,
+    };
+
+    // The mode is selected by the differential bit, then by which of R, G and B overflows when
+    // its delta is applied.
+    auto getBlockMode = [](const uint8_t *block) {
+        if ((block[3] & 0x2) == 0)
+        {
+            return kIndividual;
+        }
+        auto overflows = [](uint8_t colorAndDelta) {
+            int delta = colorAndDelta & 0x7;
+            int color = (colorAndDelta >> 3) + (delta >= 4 ? delta - 8 : delta);
+            return color < 0 || color > 31;
+        };
+        return overflows(block[0]) ? kT
+               : overflows(block[1]) ? kH
+               : overflows(block[2]) ? kPlanar
+                                     : kDifferential;
+    };
+
+    // Make pseudo-random blocks, cycling through the modes.
+    std::vector<uint8_t> data(kImageSize);
+    uint32_t seed = 1;
+    for (GLsizei blockIndex = 0; blockIndex < kBlockCountX * kBlockCountY; ++blockIndex)
+    {
+        uint8_t *block = &data[blockIndex * kBlockSize];
+        do
+        {
+            for (GLsizei byteIndex = 0; byteIndex < kBlockSize; ++byteIndex)
+            {
+                seed             = seed * 1664525u + 1013904223u;
+                block[byteIndex] = static_cast<uint8_t>(seed >> 24);
+            }
+        } while (getBlockMode(block) != blockIndex % kBlockModeCount);
+    }
+
+    std::vector<GLColor> expected(kWidth * kHeight);
+    angle::LoadETC1RGB8ToRGBA8(kWidth, kHeight, 1, data.data(), kBlockCountX * kBlockSize,
+                               kImageSize, reinterpret_cast<uint8_t *>(expected.data()),
+                               kWidth * sizeof(GLColor), kWidth * kHeight * sizeof(GLColor));
+
+    glCompressedTexImage2D(GL_TEXTURE_2D, 0, GL_ETC1_RGB8_OES, kWidth, kHeight, 0, kImageSize,
+                           data.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    ASSERT_GL_NO_ERROR();
+
+    // Draw the texels one to one in a framebuffer of the same size.
+    constexpr char kFS[] = R"(#version 300 es
+precision highp float;
+uniform highp sampler2D tex;
+out vec4 color;
+void main()
+{
+    color = texelFetch(tex, ivec2(gl_FragCoord.xy), 0);
+})";
+    ANGLE_GL_PROGRAM(program, essl3_shaders::vs::Simple(), kFS);
+
+    GLRenderbuffer renderbuffer;
+    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, kWidth, kHeight);
+
+    GLFramebuffer framebuffer;
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, renderbuffer);
+    ASSERT_GL_FRAMEBUFFER_COMPLETE(GL_FRAMEBUFFER);
+
+    glViewport(0, 0, kWidth, kHeight);
+    drawQuad(program, essl3_shaders::PositionAttrib(), 0.5f);
+    ASSERT_GL_NO_ERROR();
+
+    std::vector<GLColor> actual(kWidth * kHeight);
+    glReadPixels(0, 0, kWidth, kHeight, GL_RGBA, GL_UNSIGNED_BYTE, actual.data());
+    ASSERT_GL_NO_ERROR();
+
+    for (GLsizei y = 0; y < kHeight; ++y)
+    {
+        for (GLsizei x = 0; x < kWidth; ++x)
+        {
+            EXPECT_EQ(expected[y * kWidth + x], actual[y * kWidth + x]) << x << ", " << y;
+        }
+    }
+}
+
+// Decodes ETC2 and EAC textures with ANGLE's CPU decoders, which the backends use to emulate them,
+// and compares them to what the texture returns.  Texels are read back exactly through an integer
+// framebuffer.
+class ETCDecodeTestES3 : public ANGLETest
+{
+  protected:
+    using LoadFunction = void (*)(size_t width,
+                                  size_t height,
+                                  size_t depth,
+                                  const uint8_t *input,
+                                  size_t inputRowPitch,
+                                  size_t inputDepthPitch,
+                                  uint8_t *output,
+                                  size_t outputRowPitch,
+                                  size_t outputDepthPitch);
+
+    struct Format
+    {
+        GLenum internalFormat;
+        LoadFunction loadFunction;
+        // Size of a 4x4 block.
+        GLsizei blockSize;
+        // The CPU decoders output RGBA8, or 16-bit normalized R or RG.
+        GLsizei componentCount;
+        GLsizei bytesPerComponent;
+        bool isSigned;
+    };
+
+    static const Format kFormats[7];
+
+    void testSetUp() override
+    {
+        constexpr char kFS2D[] = R"(#version 300 es
+precision highp float;
+uniform highp sampler2D tex;
+uniform int lod;
+uniform vec4 scale;
+out highp uvec4 color;
+void main()
+{
+    vec4 texel = texelFetch(tex, ivec2(gl_FragCoord.xy), lod);
+    color = uvec4(ivec4(round(texel * scale)) & 0xFFFF);
+})";
+        constexpr char kFS2DArray[] = R"(#version 300 es
+precision highp float;
+uniform highp sampler2DArray tex;
+uniform int lod;
+uniform int layer;
+uniform vec4 scale;
+out highp uvec4 color;
+void main()
+{
+    vec4 texel = texelFetch(tex, ivec3(gl_FragCoord.xy, layer), lod);
+    color = uvec4(ivec4(round(texel * scale)) & 0xFFFF);
+})";
+        mProgram2D      = CompileProgram(essl3_shaders::vs::Simple(), kFS2D);
+        mProgram2DArray = CompileProgram(essl3_shaders::vs::Simple(), kFS2DArray);
+        ASSERT_NE(0u, mProgram2D);
+        ASSERT_NE(0u, mProgram2DArray);
+    }
+
+    void testTearDown() override
+    {
+        glDeleteProgram(mProgram2D);
+        glDeleteProgram(mProgram2DArray);
+    }
+
+    static GLsizei GetImageSize(const Format &format, GLsizei width, GLsizei height)
+    {
+        return ((width + 3) / 4) * ((height + 3) / 4) * format.blockSize;
+    }
+
+    static std::vector<uint8_t> MakeBlocks(const Format &format,
+                                           GLsizei width,
+                                           GLsizei height,
+                                           GLsizei depth,
+                                           uint32_t seed)
+    {
+        std::vector<uint8_t> data(GetImageSize(format, width, height) * depth);
+        for (uint8_t &byte : data)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            byte = static_cast<uint8_t>(seed >> 24);
+        }
+        return data;
+    }
+
+    // Returns the components of each texel, as they are read back.
+    static std::vector<uint32_t> DecodeOnCPU(const Format &format,
+                                             GLsizei width,
+                                             GLsizei height,
+                                             GLsizei depth,
+                                             const uint8_t *data)
+    {
+        const GLsizei texelSize   = format.componentCount * format.bytesPerComponent;
+        const GLsizei blockCountX = (width + 3) / 4;
+        std::vector<uint8_t> decoded(width * height * depth * texelSize);
+        format.loadFunction(width, height, depth, data, blockCountX * format.blockSize,
+                            GetImageSize(format, width, height), decoded.data(), width * texelSize,
+                            width * height * texelSize);
+
+        std::vector<uint32_t> components(width * height * depth * 4, 0);
+        for (GLsizei texel = 0; texel < width * height * depth; ++texel)
+        {
+            for (GLsizei component = 0; component < format.componentCount; ++component)
+            {
+                const GLsizei offset =
+                    (texel * format.componentCount + component) * format.bytesPerComponent;
+                const uint8_t *value = &decoded[offset];
+                if (format.bytesPerComponent == 1)
+                {
+                    components[texel * 4 + component] = *value;
+                }
+                else
+                {
+                    uint16_t value16;
+                    memcpy(&value16, value, sizeof(value16));
+                    components[texel * 4 + component] = value16;
+                }
+            }
+        }
+        return components;
+    }
+
+    // Draws the texels of |level| or |layer| one to one and reads them back.
+    std::vector<uint32_t> readTexels(const Format &format,
+                                     GLenum target,
+                                     GLint level,
+                                     GLint layer,
+                                     GLsizei width,
+                                     GLsizei height)
+    {
+        GLuint program = target == GL_TEXTURE_2D_ARRAY ? mProgram2DArray : mProgram2D;
+        glUseProgram(program);
+        glUniform1i(glGetUniformLocation(program, "lod"), level);
+        if (target == GL_TEXTURE_2D_ARRAY)
+        {
+            glUniform1i(glGetUniformLocation(program, "layer"), layer);
+        }
+        const float scale = format.bytesPerComponent == 1 ? 255.0f
+                            : format.isSigned            ? 32767.0f
+                                                         : 65535.0f;
+        glUniform4f(glGetUniformLocation(program, "scale"), scale, scale, scale, scale);
+
+        GLRenderbuffer renderbuffer;
+        glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA32UI, width, height);
+
+        GLFramebuffer framebuffer;
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER,
+                                  renderbuffer);
+        EXPECT_GLENUM_EQ(GL_FRAMEBUFFER_COMPLETE, glCheckFramebufferStatus(GL_FRAMEBUFFER));
+
+        glViewport(0, 0, width, height);
+        drawQuad(program, essl3_shaders::PositionAttrib(), 0.5f);
+
+        std::vector<uint32_t> texels(width * height * 4);
+        glReadPixels(0, 0, width, height, GL_RGBA_INTEGER, GL_UNSIGNED_INT, texels.data());
+        EXPECT_GL_NO_ERROR();
+        return texels;
+    }
+
+    // ANGLE's decoders expand 11-bit EAC values to 16 bits by shifting them, while native decoders
+    // normalize them, which differs by less than an 11-bit step.
+    static void ExpectTexelsEqual(const Format &format,
+                                  const std::vector<uint32_t> &expected,
+                                  const std::vector<uint32_t> &actual,
+                                  GLsizei width,
+                                  GLsizei height,
+                                  const char *description)
+    {
+        const int tolerance = format.bytesPerComponent == 1 ? 0 : 31;
+        GLsizei mismatches  = 0;
+        for (GLsizei texel = 0; texel < width * height && mismatches < 16; ++texel)
+        {
+            for (GLsizei component = 0; component < format.componentCount; ++component)
+            {
+                int expectedValue = static_cast<int>(expected[texel * 4 + component]);
+                int actualValue   = static_cast<int>(actual[texel * 4 + component]);
+                if (format.isSigned)
+                {
+                    expectedValue = static_cast<int16_t>(expectedValue);
+                    actualValue   = static_cast<int16_t>(actualValue);
+                }
+                if (std::abs(expectedValue - actualValue) > tolerance)
+                {
+                    ADD_FAILURE() << description << ": format 0x" << std::hex
+                                  << format.internalFormat << std::dec << ", texel "
+                                  << texel % width << ", " << texel / width << ", component "
+                                  << component << ": expected " << expectedValue << ", actual "
+                                  << actualValue;
+                    ++mismatches;
+                }
+            }
+        }
+    }
+
+    GLuint mProgram2D      = 0;
+    GLuint mProgram2DArray = 0;
+};
+
+const ETCDecodeTestES3::Format ETCDecodeTestES3::kFormats[7] = {
+    {GL_COMPRESSED_RGB8_ETC2, angle::LoadETC2RGB8ToRGBA8, 8, 4, 1, false},
+    {GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2, angle::LoadETC2RGB8A1ToRGBA8, 8, 4, 1, false},
+    {GL_COMPRESSED_RGBA8_ETC2_EAC, angle::LoadETC2RGBA8ToRGBA8, 16, 4, 1, false},
+    {GL_COMPRESSED_R11_EAC, angle::LoadEACR11ToR16, 8, 1, 2, false},
+    {GL_COMPRESSED_SIGNED_R11_EAC, angle::LoadEACR11SToR16, 8, 1, 2, true},
+    {GL_COMPRESSED_RG11_EAC, angle::LoadEACRG11ToRG16, 16, 2, 2, false},
+    {GL_COMPRESSED_SIGNED_RG11_EAC, angle::LoadEACRG11SToRG16, 16, 2, 2, true},
+};
+
+// Test that ETC2 and EAC textures decode like ANGLE's CPU decoders with random blocks, which cover
+// all the modes, and a size that is not a multiple of the block size.  On Vulkan, they may be
+// decoded in a compute shader instead.
+TEST_P(ETCDecodeTestES3, DecodeMatchesCPUDecoder)
+{
+    constexpr GLsizei kWidth  = 37;
+    constexpr GLsizei kHeight = 22;
+
+    for (const Format &format : kFormats)
+    {
+        std::vector<uint8_t> data = MakeBlocks(format, kWidth, kHeight, 1, format.internalFormat);
+
+        GLTexture texture;
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glCompressedTexImage2D(GL_TEXTURE_2D, 0, format.internalFormat, kWidth, kHeight, 0,
+                               static_cast<GLsizei>(data.size()), data.data());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        ASSERT_GL_NO_ERROR();
+
+        ExpectTexelsEqual(format, DecodeOnCPU(format, kWidth, kHeight, 1, data.data()),
+                          readTexels(format, GL_TEXTURE_2D, 0, 0, kWidth, kHeight), kWidth,
+                          kHeight, "decode");
+    }
+}
+
+// Test that every level of a mip chain is decoded, including those smaller than a block.
+TEST_P(ETCDecodeTestES3, MipChain)
+{
+    constexpr GLsizei kWidth    = 37;
+    constexpr GLsizei kHeight   = 22;
+    constexpr GLint kLevelCount = 6;
+
+    for (const Format &format : kFormats)
+    {
+        GLTexture texture;
+        glBindTexture(GL_TEXTURE_2D, texture);
+
+        std::vector<std::vector<uint8_t>> levelData(kLevelCount);
+        for (GLint level = 0; level < kLevelCount; ++level)
+        {
+            GLsizei width    = std::max(kWidth >> level, 1);
+            GLsizei height   = std::max(kHeight >> level, 1);
+            levelData[level] = MakeBlocks(format, width, height, 1, format.internalFormat + level);
+            glCompressedTexImage2D(GL_TEXTURE_2D, level, format.internalFormat, width, height, 0,
+                                   static_cast<GLsizei>(levelData[level].size()),
+                                   levelData[level].data());
+        }
+        ASSERT_GL_NO_ERROR();
+
+        for (GLint level = 0; level < kLevelCount; ++level)
+        {
+            GLsizei width  = std::max(kWidth >> level, 1);
+            GLsizei height = std::max(kHeight >> level, 1);
+            ExpectTexelsEqual(format,
+                              DecodeOnCPU(format, width, height, 1, levelData[level].data()),
+                              readTexels(format, GL_TEXTURE_2D, level, 0, width, height), width,
+                              height, "mip chain");
+        }
+    }
+}
+
+// Test that block-aligned updates with glCompressedTexSubImage2D are decoded in place.
+TEST_P(ETCDecodeTestES3, CompressedTexSubImage)
+{
+    constexpr GLsizei kWidth     = 37;
+    constexpr GLsizei kHeight    = 22;
+    constexpr GLint kSubX        = 8;
+    constexpr GLint kSubY        = 4;
+    constexpr GLsizei kSubWidth  = 16;
+    constexpr GLsizei kSubHeight = 12;
+
+    for (const Format &format : kFormats)
+    {
+        std::vector<uint8_t> data = MakeBlocks(format, kWidth, kHeight, 1, format.internalFormat);
+        std::vector<uint8_t> subData =
+            MakeBlocks(format, kSubWidth, kSubHeight, 1, ~format.internalFormat);
+
+        GLTexture texture;
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glCompressedTexImage2D(GL_TEXTURE_2D, 0, format.internalFormat, kWidth, kHeight, 0,
+                               static_cast<GLsizei>(data.size()), data.data());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+
+        // Use the texture so the update isn't merged with the initial upload.
+        readTexels(format, GL_TEXTURE_2D, 0, 0, kWidth, kHeight);
+
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glCompressedTexSubImage2D(GL_TEXTURE_2D, 0, kSubX, kSubY, kSubWidth, kSubHeight,
+                                  format.internalFormat, static_cast<GLsizei>(subData.size()),
+                                  subData.data());
+        ASSERT_GL_NO_ERROR();
+
+        std::vector<uint32_t> expected = DecodeOnCPU(format, kWidth, kHeight, 1, data.data());
+        std::vector<uint32_t> expectedSub =
+            DecodeOnCPU(format, kSubWidth, kSubHeight, 1, subData.data());
+        for (GLsizei y = 0; y < kSubHeight; ++y)
+        {
+            std::copy(expectedSub.begin() + y * kSubWidth * 4,
+                      expectedSub.begin() + (y + 1) * kSubWidth * 4,
+                      expected.begin() + ((kSubY + y) * kWidth + kSubX) * 4);
+        }
+
+        ExpectTexelsEqual(format, expected,
+                          readTexels(format, GL_TEXTURE_2D, 0, 0, kWidth, kHeight), kWidth,
+                          kHeight, "sub image");
+    }
+}
+
+// Test that array textures are decoded correctly when the upload is too large to be decoded in one
+// go, and is split in the middle of a layer.
+TEST_P(ETCDecodeTestES3, LargeArray)
+{
+    constexpr GLsizei kWidth      = 256;
+    constexpr GLsizei kHeight     = 258;
+    constexpr GLsizei kLayerCount = 6;
+
+    // ETC2 RGBA8 and EAC RG11 have the largest blocks and decoded texels.
+    for (const Format &format : {kFormats[2], kFormats[5]})
+    {
+        std::vector<uint8_t> data =
+            MakeBlocks(format, kWidth, kHeight, kLayerCount, format.internalFormat);
+
+        GLTexture texture;
+        glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+        glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, 0, format.internalFormat, kWidth, kHeight,
+                               kLayerCount, 0, static_cast<GLsizei>(data.size()), data.data());
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        ASSERT_GL_NO_ERROR();
+
+        std::vector<uint32_t> expected =
+            DecodeOnCPU(format, kWidth, kHeight, kLayerCount, data.data());
+        for (GLint layer = 0; layer < kLayerCount; ++layer)
+        {
+            std::vector<uint32_t> expectedLayer(
+                expected.begin() + layer * kWidth * kHeight * 4,
+                expected.begin() + (layer + 1) * kWidth * kHeight * 4);
+            ExpectTexelsEqual(format, expectedLayer,
+                              readTexels(format, GL_TEXTURE_2D_ARRAY, 0, layer, kWidth, kHeight),
+                              kWidth, kHeight, "array");
+        }
+    }
+}
+
 class TextureBufferTestES31 : public ANGLETest
 {
   protected:
@@ -8745,6 +9213,7 @@ ANGLE_INSTANTIATE_TEST_ES3(Texture3DIntegerTestES3);
 ANGLE_INSTANTIATE_TEST_ES2_AND_ES3(Texture2DDepthTest);
 ANGLE_INSTANTIATE_TEST_ES2_AND_ES3(PBOCompressedTextureTest);
 ANGLE_INSTANTIATE_TEST_ES2_AND_ES3(ETC1CompressedTextureTest);
+ANGLE_INSTANTIATE_TEST_ES3(ETCDecodeTestES3);
 ANGLE_INSTANTIATE_TEST_ES31(TextureBufferTestES31);
 ANGLE_INSTANTIATE_TEST_ES31(CopyImageTestES31);
 
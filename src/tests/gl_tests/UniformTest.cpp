@@ -681,9 +681,97 @@ class UniformTestES3 : public ANGLETest
         }
     }
 
+    // Draws one row per step, each showing every element of a large uniform array after a few of
+    // them were updated.  The rows are either read back after each draw, or all at the end.
+    void drawAfterPartialArrayUpdates(bool readBackAfterEachDraw);
+
     GLuint mProgram;
 };
 
+void UniformTestES3::drawAfterPartialArrayUpdates(bool readBackAfterEachDraw)
+{
+    constexpr GLsizei kArraySize = 128;
+    constexpr GLsizei kStepCount = 16;
+
+    constexpr char kFS[] = R"(#version 300 es
+precision highp float;
+uniform vec4 data[128];
+out vec4 color;
+void main()
+{
+    color = data[int(gl_FragCoord.x)];
+})";
+
+    ANGLE_GL_PROGRAM(program, essl3_shaders::vs::Simple(), kFS);
+    glUseProgram(program);
+
+    GLTexture texture;
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, kArraySize, kStepCount);
+
+    GLFramebuffer framebuffer;
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    ASSERT_GL_FRAMEBUFFER_COMPLETE(GL_FRAMEBUFFER);
+    glViewport(0, 0, kArraySize, kStepCount);
+    glEnable(GL_SCISSOR_TEST);
+
+    auto makeColor = [](GLsizei index, GLsizei step) {
+        return GLColor(static_cast<GLubyte>(index), static_cast<GLubyte>(255 - index),
+                       static_cast<GLubyte>(step * 16), 255);
+    };
+    auto setElements = [&](GLsizei first, GLsizei count, GLsizei step,
+                           std::vector<GLColor> *elements) {
+        std::vector<Vector4> values;
+        for (GLsizei index = first; index < first + count; ++index)
+        {
+            (*elements)[index] = makeColor(index, step);
+            values.push_back((*elements)[index].toNormalizedVector());
+        }
+        std::string name = "data[" + std::to_string(first) + "]";
+        glUniform4fv(glGetUniformLocation(program, name.c_str()), count, values[0].data());
+    };
+    auto readBackRows = [&](GLsizei firstRow, GLsizei rowCount) {
+        std::vector<GLColor> rows(kArraySize * rowCount);
+        glReadPixels(0, firstRow, kArraySize, rowCount, GL_RGBA, GL_UNSIGNED_BYTE, rows.data());
+        return rows;
+    };
+
+    std::vector<GLColor> elements(kArraySize);
+    setElements(0, kArraySize, 0, &elements);
+
+    std::vector<GLColor> expectedRows;
+    for (GLsizei step = 0; step < kStepCount; ++step)
+    {
+        // Update single elements spread over the array, a short run of elements, or none.
+        if (step % 4 == 1)
+        {
+            setElements((step * 37) % kArraySize, 1, step, &elements);
+        }
+        else if (step % 4 == 2)
+        {
+            setElements(0, 1, step, &elements);
+            setElements(kArraySize - 1, 1, step, &elements);
+        }
+        else if (step % 4 == 3)
+        {
+            setElements((step * 11) % (kArraySize - 5), 5, step, &elements);
+        }
+
+        glScissor(0, step, kArraySize, 1);
+        drawQuad(program, essl3_shaders::PositionAttrib(), 0.5f);
+        ASSERT_GL_NO_ERROR();
+
+        expectedRows.insert(expectedRows.end(), elements.begin(), elements.end());
+        if (readBackAfterEachDraw)
+        {
+            EXPECT_EQ(elements, readBackRows(step, 1));
+        }
+    }
+
+    EXPECT_EQ(expectedRows, readBackRows(0, kStepCount));
+}
+
 // Test that we can get and set an array of matrices uniform.
 TEST_P(UniformTestES3, MatrixArrayUniformStateQuery)
 {
@@ -1383,6 +1471,18 @@ TEST_P(UniformTestES3, MatrixUniformUpload)
     }
 }
 
+// Test that draws in the same render pass see partial updates of a large uniform array.
+TEST_P(UniformTestES3, DrawsAfterPartialArrayUpdates)
+{
+    drawAfterPartialArrayUpdates(false);
+}
+
+// Test that draws see partial updates of a large uniform array when each draw is read back.
+TEST_P(UniformTestES3, DrawsAfterPartialArrayUpdatesWithReadBack)
+{
+    drawAfterPartialArrayUpdates(true);
+}
+
 // Test that uniforms with reserved OpenGL names that aren't reserved in GL ES 2 work correctly.
 TEST_P(UniformTest, UniformWithReservedOpenGLName)
 {
@@ -20,6 +20,7 @@
 #include "libANGLE/angletypes.h"
 #include "libANGLE/renderer/vulkan/ContextVk.h"
 #include "test_utils/gl_raii.h"
+#include "util/test_utils.h"
 
 using namespace angle;
 
@@ -46,6 +47,12 @@ class VulkanPerformanceCounterTest : public ANGLETest
         return rx::GetImplAs<const rx::ContextVk>(context)->getPerfCounters();
     }
 
+    const angle::FeaturesVk &hackANGLEFeatures() const
+    {
+        const gl::Context *context = static_cast<const gl::Context *>(getEGLWindow()->getContext());
+        return rx::GetImplAs<const rx::ContextVk>(context)->getFeatures();
+    }
+
     static constexpr GLsizei kInvalidateTestSize = 16;
 
     void setupClearAndDrawForInvalidateTest(GLProgram *program,
@@ -167,11 +174,177 @@ class VulkanPerformanceCounterTest : public ANGLETest
         EXPECT_EQ(expected.depthAttachmentResolves, counters.depthAttachmentResolves);
         EXPECT_EQ(expected.stencilAttachmentResolves, counters.stencilAttachmentResolves);
     }
+
+    // Polls the availability of |query| until its result is available.  The query is expected to
+    // be in commands that are not submitted yet, and the first poll is expected not to flush them.
+    void pollQueryAvailability(GLuint query)
+    {
+        const rx::vk::PerfCounters &counters = hackANGLE();
+        uint32_t expectedPrimaryBuffers      = counters.primaryBuffers;
+
+        GLuint available = GL_FALSE;
+        glGetQueryObjectuiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+        EXPECT_EQ(expectedPrimaryBuffers, counters.primaryBuffers);
+
+        while (available == GL_FALSE)
+        {
+            angle::Sleep(0);
+            glGetQueryObjectuiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+        }
+        ASSERT_GL_NO_ERROR();
+    }
+
+    static constexpr GLsizei kMultiDrawCount = 4;
+
+    // Creates a program that draws each of the quads in |verticesOut| with its own color: red,
+    // green, blue and yellow.  The colors come from gl_DrawID if |useDrawID|, otherwise from a
+    // vertex attribute.  Each quad covers a quadrant of the window, starting from the bottom left,
+    // and is 6 vertices of interleaved position and color.
+    void setupMultiDrawQuadrants(bool useDrawID,
+                                 GLProgram *programOut,
+                                 std::vector<GLfloat> *verticesOut)
+    {
+        constexpr char kVSWithDrawID[] = R"(#extension GL_ANGLE_multi_draw : require
+attribute vec2 position;
+varying vec4 color;
+void main()
+{
+    color = vec4(gl_DrawID == 0 || gl_DrawID == 3 ? 1.0 : 0.0,
+                 gl_DrawID == 1 || gl_DrawID == 3 ? 1.0 : 0.0,
+                 gl_DrawID == 2 ? 1.0 : 0.0, 1.0);
+    gl_Position = vec4(position, 0.0, 1.0);
+})";
+
+        constexpr char kVS[] = R"(attribute vec2 position;
+attribute vec4 vertexColor;
+varying vec4 color;
+void main()
+{
+    color = vertexColor;
+    gl_Position = vec4(position, 0.0, 1.0);
+})";
+
+        constexpr char kFS[] = R"(precision mediump float;
+varying vec4 color;
+void main()
+{
+    gl_FragColor = color;
+})";
+
+        programOut->makeRaster(useDrawID ? kVSWithDrawID : kVS, kFS);
+        ASSERT_TRUE(programOut->valid());
+
+        constexpr GLfloat kCorners[6][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 0}, {1, 1}, {0, 1}};
+
+        const GLColor kColors[kMultiDrawCount] = {GLColor::red, GLColor::green, GLColor::blue,
+                                                  GLColor::yellow};
+        for (GLsizei draw = 0; draw < kMultiDrawCount; ++draw)
+        {
+            const angle::Vector4 color = kColors[draw].toNormalizedVector();
+            for (const GLfloat *corner : kCorners)
+            {
+                verticesOut->push_back(corner[0] + static_cast<GLfloat>(draw % 2) - 1.0f);
+                verticesOut->push_back(corner[1] + static_cast<GLfloat>(draw / 2) - 1.0f);
+                verticesOut->insert(verticesOut->end(), color.data(), color.data() + 4);
+            }
+        }
+    }
+
+    // Points the attributes of |program| at |vertices|, either in the bound array buffer if null
+    // or in client memory.
+    void setupMultiDrawAttributes(GLuint program, const GLfloat *vertices)
+    {
+        constexpr GLsizei kStride = 6 * sizeof(GLfloat);
+
+        GLint positionLocation = glGetAttribLocation(program, "position");
+        ASSERT_NE(-1, positionLocation);
+        glVertexAttribPointer(positionLocation, 2, GL_FLOAT, GL_FALSE, kStride, vertices);
+        glEnableVertexAttribArray(positionLocation);
+
+        GLint colorLocation = glGetAttribLocation(program, "vertexColor");
+        if (colorLocation != -1)
+        {
+            glVertexAttribPointer(colorLocation, 4, GL_FLOAT, GL_FALSE, kStride,
+                                  vertices == nullptr ? reinterpret_cast<const void *>(8)
+                                                      : vertices + 2);
+            glEnableVertexAttribArray(colorLocation);
+        }
+    }
+
+    // Checks each draw of setupMultiDrawQuadrants() covers its quadrant.
+    void expectMultiDrawQuadrants()
+    {
+        const int w = getWindowWidth();
+        const int h = getWindowHeight();
+        EXPECT_PIXEL_COLOR_EQ(w / 4, h / 4, GLColor::red);
+        EXPECT_PIXEL_COLOR_EQ(3 * w / 4, h / 4, GLColor::green);
+        EXPECT_PIXEL_COLOR_EQ(w / 4, 3 * h / 4, GLColor::blue);
+        EXPECT_PIXEL_COLOR_EQ(3 * w / 4, 3 * h / 4, GLColor::yellow);
+    }
+
+    // Draws the quadrants with glMultiDrawArraysANGLE and glMultiDrawElementsANGLE from buffers
+    // and checks each is a single indirect draw.
+    void multiDrawQuadrantsIndirect(GLuint program, const std::vector<GLfloat> &vertices)
+    {
+        const rx::vk::PerfCounters &counters = hackANGLE();
+
+        GLBuffer vertexBuffer;
+        glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(vertices[0]), vertices.data(),
+                     GL_STATIC_DRAW);
+        setupMultiDrawAttributes(program, nullptr);
+
+        std::vector<GLushort> indices(kMultiDrawCount * 6);
+        for (size_t index = 0; index < indices.size(); ++index)
+        {
+            indices[index] = static_cast<GLushort>(index);
+        }
+        GLBuffer indexBuffer;
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(indices[0]), indices.data(),
+                     GL_STATIC_DRAW);
+
+        const GLint firsts[kMultiDrawCount]   = {0, 6, 12, 18};
+        const GLsizei counts[kMultiDrawCount] = {6, 6, 6, 6};
+        const GLvoid *offsets[kMultiDrawCount];
+        for (GLsizei draw = 0; draw < kMultiDrawCount; ++draw)
+        {
+            offsets[draw] = reinterpret_cast<const GLvoid *>(firsts[draw] * sizeof(GLushort));
+        }
+
+        uint32_t expectedIndirectMultiDraws = counters.indirectMultiDraws + 1;
+        glClear(GL_COLOR_BUFFER_BIT);
+        glMultiDrawArraysANGLE(GL_TRIANGLES, firsts, counts, kMultiDrawCount);
+        ASSERT_GL_NO_ERROR();
+        EXPECT_EQ(expectedIndirectMultiDraws, counters.indirectMultiDraws);
+        expectMultiDrawQuadrants();
+
+        expectedIndirectMultiDraws++;
+        glClear(GL_COLOR_BUFFER_BIT);
+        glMultiDrawElementsANGLE(GL_TRIANGLES, counts, GL_UNSIGNED_SHORT, offsets,
+                                 kMultiDrawCount);
+        ASSERT_GL_NO_ERROR();
+        EXPECT_EQ(expectedIndirectMultiDraws, counters.indirectMultiDraws);
+        expectMultiDrawQuadrants();
+    }
 };
 
 class VulkanPerformanceCounterTest_ES31 : public VulkanPerformanceCounterTest
 {};
 
+class VulkanPerformanceCounterTest_AsyncCommandQueue : public VulkanPerformanceCounterTest
+{};
+
+class VulkanPerformanceCounterTest_Prespecialize : public VulkanPerformanceCounterTest
+{
+  protected:
+    bool hasPipelineWorkerPool() const
+    {
+        const gl::Context *context = static_cast<const gl::Context *>(getEGLWindow()->getContext());
+        return rx::GetImplAs<const rx::ContextVk>(context)->hasPipelineWorkerPool();
+    }
+};
+
 // Tests that texture updates to unused textures don't break the RP.
 TEST_P(VulkanPerformanceCounterTest, NewTextureDoesNotBreakRenderPass)
 {
@@ -2919,7 +3092,563 @@ TEST_P(VulkanPerformanceCounterTest, ScissorDoesNotBreakRenderPass)
                          GLColor::transparentBlack);
 }
 
+// Ensures rendering into many textures through the same framebuffer object keeps the framebuffer
+// cache bounded, and that evicted framebuffers are correctly recreated.
+TEST_P(VulkanPerformanceCounterTest, ManyAttachmentsEvictFramebufferCache)
+{
+    // Imageless framebuffers are shared by all the textures.
+    ANGLE_SKIP_TEST_IF(hackANGLEFeatures().supportsImagelessFramebuffer.enabled);
+
+    const rx::vk::PerfCounters &counters = hackANGLE();
+
+    // More than the size of the per-framebuffer cache.
+    constexpr size_t kTextureCount = 48;
+    constexpr GLsizei kSize        = 4;
+
+    ANGLE_GL_PROGRAM(drawColor, essl1_shaders::vs::Simple(), essl1_shaders::fs::UniformColor());
+    glUseProgram(drawColor);
+    GLint colorUniformLocation =
+        glGetUniformLocation(drawColor, angle::essl1_shaders::ColorUniform());
+    ASSERT_NE(colorUniformLocation, -1);
+
+    std::array<GLTexture, kTextureCount> textures;
+    for (GLTexture &texture : textures)
+    {
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, kSize, kSize);
+    }
+
+    uint32_t expectedEvictions = counters.framebufferCacheEvictions;
+
+    GLFramebuffer framebuffer;
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, kSize, kSize);
+
+    auto colorForIndex = [](size_t index) {
+        return GLColor(static_cast<GLubyte>(index * 5), 255, static_cast<GLubyte>(255 - index),
+                       255);
+    };
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (size_t index = 0; index < kTextureCount; ++index)
+        {
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                                   textures[index], 0);
+            const GLColor color = colorForIndex(index);
+            glUniform4fv(colorUniformLocation, 1, color.toNormalizedVector().data());
+            drawQuad(drawColor, essl1_shaders::PositionAttrib(), 0.5f);
+        }
+    }
+    ASSERT_GL_NO_ERROR();
+
+    // The first textures' framebuffers must have been evicted to make room for the later ones.
+    EXPECT_GT(counters.framebufferCacheEvictions, expectedEvictions);
+
+    for (size_t index = 0; index < kTextureCount; ++index)
+    {
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                               textures[index], 0);
+        EXPECT_PIXEL_COLOR_NEAR(0, 0, colorForIndex(index), 1);
+    }
+}
+
+// Tests that when the framebuffer cache is full, only the least recently used framebuffers are
+// evicted, even if all of them were used in the same submission.
+TEST_P(VulkanPerformanceCounterTest, FramebufferCacheEvictsLeastRecentlyUsed)
+{
+    // Imageless framebuffers are shared by all the textures.
+    ANGLE_SKIP_TEST_IF(hackANGLEFeatures().supportsImagelessFramebuffer.enabled);
+
+    const rx::vk::PerfCounters &counters = hackANGLE();
+
+    // One more than the size of the per-framebuffer cache, which is trimmed to three quarters of
+    // its size when full.
+    constexpr size_t kCacheSize    = 32;
+    constexpr size_t kTrimCount    = kCacheSize - kCacheSize * 3 / 4;
+    constexpr size_t kTextureCount = kCacheSize + 1;
+    constexpr GLsizei kSize        = 4;
+
+    ANGLE_GL_PROGRAM(drawColor, essl1_shaders::vs::Simple(), essl1_shaders::fs::UniformColor());
+    glUseProgram(drawColor);
+    GLint colorUniformLocation =
+        glGetUniformLocation(drawColor, angle::essl1_shaders::ColorUniform());
+    ASSERT_NE(colorUniformLocation, -1);
+    glUniform4fv(colorUniformLocation, 1, GLColor::green.toNormalizedVector().data());
+
+    std::array<GLTexture, kTextureCount> textures;
+    for (GLTexture &texture : textures)
+    {
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, kSize, kSize);
+    }
+
+    GLFramebuffer framebuffer;
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, kSize, kSize);
+
+    auto drawInto = [&](size_t index) {
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                               textures[index], 0);
+        drawQuad(drawColor, essl1_shaders::PositionAttrib(), 0.5f);
+    };
+
+    // Fill the cache without submitting, then use the first framebuffer again.
+    for (size_t index = 0; index < kCacheSize; ++index)
+    {
+        drawInto(index);
+    }
+    drawInto(0);
+    ASSERT_GL_NO_ERROR();
+
+    uint32_t expectedEvictions =
+        counters.framebufferCacheEvictions + static_cast<uint32_t>(kTrimCount);
+
+    // The next framebuffer trims the cache, evicting the ones used longest ago, which are the ones
+    // after the first.
+    drawInto(kCacheSize);
+    ASSERT_GL_NO_ERROR();
+    EXPECT_EQ(expectedEvictions, counters.framebufferCacheEvictions);
+
+    uint32_t expectedFramebufferCreations = counters.framebufferCreations;
+    drawInto(0);
+    drawInto(kTrimCount + 1);
+    EXPECT_EQ(expectedFramebufferCreations, counters.framebufferCreations);
+
+    drawInto(1);
+    EXPECT_EQ(expectedFramebufferCreations + 1, counters.framebufferCreations);
+    ASSERT_GL_NO_ERROR();
+
+    for (size_t index = 0; index < kTextureCount; ++index)
+    {
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                               textures[index], 0);
+        EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::green);
+    }
+}
+
+// Tests that trimming the render pass cache while the command processor thread may still be
+// processing render passes that use the trimmed entries is safe, and that they are recreated.
+TEST_P(VulkanPerformanceCounterTest_AsyncCommandQueue, ManyRenderPassesTrimRenderPassCache)
+{
+    const rx::vk::PerfCounters &counters = hackANGLE();
+
+    // Every combination of formats for three of the attachments, each cleared in one pass and
+    // loaded in the next, makes more render passes than the cache holds.
+    constexpr std::array<GLenum, 5> kFormats = {GL_RGBA8, GL_RGB10_A2, GL_R8, GL_RG8,
+                                                GL_SRGB8_ALPHA8};
+
+    constexpr size_t kFormatCount           = kFormats.size();
+    constexpr size_t kVariedAttachmentCount = 3;
+    constexpr size_t kCombinationCount      = kFormatCount * kFormatCount * kFormatCount;
+    constexpr size_t kFlushInterval         = 8;
+    constexpr size_t kCheckInterval         = 16;
+    constexpr GLsizei kSize                 = 4;
+
+    constexpr char kFS[] = R"(#version 300 es
+precision highp float;
+uniform vec4 color;
+layout(location = 0) out vec4 color0;
+layout(location = 1) out vec4 color1;
+layout(location = 2) out vec4 color2;
+layout(location = 3) out vec4 color3;
+void main()
+{
+    color0 = color;
+    color1 = color;
+    color2 = color;
+    color3 = color;
+})";
+
+    ANGLE_GL_PROGRAM(program, essl3_shaders::vs::Simple(), kFS);
+    glUseProgram(program);
+    GLint colorUniformLocation = glGetUniformLocation(program, "color");
+    ASSERT_NE(colorUniformLocation, -1);
+
+    GLTexture readTexture;
+    glBindTexture(GL_TEXTURE_2D, readTexture);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, kSize, kSize);
+
+    std::array<std::array<GLTexture, kFormatCount>, kVariedAttachmentCount> textures;
+    for (std::array<GLTexture, kFormatCount> &attachmentTextures : textures)
+    {
+        for (size_t formatIndex = 0; formatIndex < kFormatCount; ++formatIndex)
+        {
+            glBindTexture(GL_TEXTURE_2D, attachmentTextures[formatIndex]);
+            glTexStorage2D(GL_TEXTURE_2D, 1, kFormats[formatIndex], kSize, kSize);
+        }
+    }
+
+    GLFramebuffer framebuffer;
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, readTexture, 0);
+    constexpr std::array<GLenum, 4> kDrawBuffers = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1,
+                                                    GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT3};
+    glDrawBuffers(static_cast<GLsizei>(kDrawBuffers.size()), kDrawBuffers.data());
+    glViewport(0, 0, kSize, kSize);
+    glClearColor(0, 0, 0, 0);
+
+    auto colorForIndex = [](size_t index) {
+        return GLColor(static_cast<GLubyte>(index), 255, static_cast<GLubyte>(255 - index), 255);
+    };
+
+    uint32_t expectedEvictions = counters.renderPassCacheEvictions;
+
+    for (int pass = 0; pass < 3; ++pass)
+    {
+        const bool clear = pass != 1;
+        for (size_t combination = 0; combination < kCombinationCount; ++combination)
+        {
+            size_t formatIndices = combination;
+            for (size_t attachment = 0; attachment < kVariedAttachmentCount; ++attachment)
+            {
+                const GLuint texture = textures[attachment][formatIndices % kFormatCount];
+                glFramebufferTexture2D(GL_FRAMEBUFFER,
+                                       static_cast<GLenum>(GL_COLOR_ATTACHMENT1 + attachment),
+                                       GL_TEXTURE_2D, texture, 0);
+                formatIndices /= kFormatCount;
+            }
+            ASSERT_GL_FRAMEBUFFER_COMPLETE(GL_FRAMEBUFFER);
+
+            if (clear)
+            {
+                glClear(GL_COLOR_BUFFER_BIT);
+            }
+            const GLColor color = colorForIndex(combination);
+            glUniform4fv(colorUniformLocation, 1, color.toNormalizedVector().data());
+            drawQuad(program, essl3_shaders::PositionAttrib(), 0.5f);
+
+            // Hand the render passes to the command processor thread while the cache keeps
+            // growing, so trimming happens with their tasks in flight.
+            if (combination % kFlushInterval == kFlushInterval - 1)
+            {
+                glFlush();
+            }
+            if (pass == 2 && combination % kCheckInterval == 0)
+            {
+                EXPECT_PIXEL_COLOR_EQ(0, 0, color);
+            }
+        }
+    }
+    ASSERT_GL_NO_ERROR();
+
+    // Render passes from the first pass must have been evicted to make room for the later ones.
+    EXPECT_GT(counters.renderPassCacheEvictions, expectedEvictions);
+}
+
+// Tests that with VK_KHR_imageless_framebuffer, switching the attachment of a framebuffer object
+// between textures of the same format and size doesn't create new framebuffers.
+TEST_P(VulkanPerformanceCounterTest, SwitchingAttachmentsReusesImagelessFramebuffer)
+{
+    ANGLE_SKIP_TEST_IF(!hackANGLEFeatures().supportsImagelessFramebuffer.enabled);
+
+    const rx::vk::PerfCounters &counters = hackANGLE();
+
+    constexpr GLsizei kSize = 16;
+
+    ANGLE_GL_PROGRAM(drawColor, essl1_shaders::vs::Simple(), essl1_shaders::fs::UniformColor());
+    glUseProgram(drawColor);
+    GLint colorUniformLocation =
+        glGetUniformLocation(drawColor, angle::essl1_shaders::ColorUniform());
+    ASSERT_NE(colorUniformLocation, -1);
+
+    const std::array<GLColor, 4> kColors = {GLColor::red, GLColor::green, GLColor::blue,
+                                            GLColor::yellow};
+    std::array<GLTexture, 4> textures;
+    for (GLTexture &texture : textures)
+    {
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, kSize, kSize);
+    }
+
+    GLFramebuffer framebuffer;
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, kSize, kSize);
+
+    // The first draw creates the framebuffer.
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textures[0], 0);
+    ASSERT_GL_FRAMEBUFFER_COMPLETE(GL_FRAMEBUFFER);
+    glUniform4fv(colorUniformLocation, 1, kColors[0].toNormalizedVector().data());
+    drawQuad(drawColor, essl1_shaders::PositionAttrib(), 0.5f);
+    EXPECT_PIXEL_COLOR_EQ(0, 0, kColors[0]);
+
+    uint32_t expectedFramebufferCreations = counters.framebufferCreations;
+
+    // The other textures have different image views, but the same format and size.
+    for (size_t index = 1; index < textures.size(); ++index)
+    {
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                               textures[index], 0);
+        glUniform4fv(colorUniformLocation, 1, kColors[index].toNormalizedVector().data());
+        drawQuad(drawColor, essl1_shaders::PositionAttrib(), 0.5f);
+        EXPECT_PIXEL_COLOR_EQ(0, 0, kColors[index]);
+    }
+    ASSERT_GL_NO_ERROR();
+
+    EXPECT_EQ(expectedFramebufferCreations, counters.framebufferCreations);
+}
+
+// Tests that with VK_EXT_extended_dynamic_state, changing the cull, front face and depth/stencil
+// test state doesn't create new pipelines.
+TEST_P(VulkanPerformanceCounterTest, DynamicStateChangesDontCreatePipelines)
+{
+    ANGLE_SKIP_TEST_IF(!hackANGLEFeatures().supportsExtendedDynamicState.enabled);
+
+    const rx::vk::PerfCounters &counters = hackANGLE();
+
+    ANGLE_GL_PROGRAM(drawRed, essl1_shaders::vs::Simple(), essl1_shaders::fs::Red());
+
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+    drawQuad(drawRed, essl1_shaders::PositionAttrib(), 0.5f);
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::red);
+
+    uint32_t expectedPipelineCreations = counters.graphicsPipelineCreations;
+
+    glEnable(GL_CULL_FACE);
+    glCullFace(GL_FRONT);
+    glFrontFace(GL_CW);
+    drawQuad(drawRed, essl1_shaders::PositionAttrib(), 0.5f);
+    glDisable(GL_CULL_FACE);
+
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LEQUAL);
+    glDepthMask(GL_FALSE);
+    drawQuad(drawRed, essl1_shaders::PositionAttrib(), 0.5f);
+
+    glEnable(GL_STENCIL_TEST);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_INCR);
+    drawQuad(drawRed, essl1_shaders::PositionAttrib(), 0.5f);
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::red);
+    ASSERT_GL_NO_ERROR();
+
+    // Only the compare op changes; the reference and compare mask stay the defaults.
+    glStencilFunc(GL_GEQUAL, 0, 0xFFFFFFFF);
+    drawQuad(drawRed, essl1_shaders::PositionAttrib(), 0.5f);
+    glStencilFuncSeparate(GL_BACK, GL_NOTEQUAL, 0, 0xFFFFFFFF);
+    drawQuad(drawRed, essl1_shaders::PositionAttrib(), 0.5f);
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::red);
+    ASSERT_GL_NO_ERROR();
+
+    EXPECT_EQ(expectedPipelineCreations, counters.graphicsPipelineCreations);
+}
+
+// Tests that polling for the availability of an occlusion query doesn't flush the commands the
+// first time, and that the result is correct.
+TEST_P(VulkanPerformanceCounterTest, PollingOcclusionQueryDoesNotFlush)
+{
+    ANGLE_GL_PROGRAM(drawRed, essl1_shaders::vs::Simple(), essl1_shaders::fs::Red());
+
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glEnable(GL_DEPTH_TEST);
+    glDepthMask(GL_TRUE);
+    drawQuad(drawRed, essl1_shaders::PositionAttrib(), 0.3f);
+
+    GLQuery occludedQuery;
+    glBeginQuery(GL_ANY_SAMPLES_PASSED, occludedQuery);
+    drawQuad(drawRed, essl1_shaders::PositionAttrib(), 0.8f);
+    glEndQuery(GL_ANY_SAMPLES_PASSED);
+
+    GLQuery visibleQuery;
+    glBeginQuery(GL_ANY_SAMPLES_PASSED, visibleQuery);
+    drawQuad(drawRed, essl1_shaders::PositionAttrib(), 0.0f);
+    glEndQuery(GL_ANY_SAMPLES_PASSED);
+    ASSERT_GL_NO_ERROR();
+
+    pollQueryAvailability(occludedQuery);
+
+    GLuint result = GL_TRUE;
+    glGetQueryObjectuiv(occludedQuery, GL_QUERY_RESULT, &result);
+    EXPECT_GL_FALSE(result);
+
+    glGetQueryObjectuiv(visibleQuery, GL_QUERY_RESULT, &result);
+    EXPECT_GL_TRUE(result);
+    ASSERT_GL_NO_ERROR();
+}
+
+// Tests that polling for the availability of timestamp and time-elapsed queries doesn't flush the
+// commands the first time, and that the results are consistent.
+TEST_P(VulkanPerformanceCounterTest, PollingTimerQueriesDoesNotFlush)
+{
+    ANGLE_SKIP_TEST_IF(!IsGLExtensionEnabled("GL_EXT_disjoint_timer_query"));
+
+    GLint timestampBits = 0;
+    glGetQueryivEXT(GL_TIMESTAMP_EXT, GL_QUERY_COUNTER_BITS_EXT, &timestampBits);
+    ANGLE_SKIP_TEST_IF(timestampBits == 0);
+
+    ANGLE_GL_PROGRAM(drawRed, essl1_shaders::vs::Simple(), essl1_shaders::fs::Red());
+
+    GLQuery timestampBegin;
+    GLQuery timestampEnd;
+    GLQuery timeElapsed;
+
+    glQueryCounterEXT(timestampBegin, GL_TIMESTAMP_EXT);
+    glBeginQueryEXT(GL_TIME_ELAPSED_EXT, timeElapsed);
+    drawQuad(drawRed, essl1_shaders::PositionAttrib(), 0.5f);
+    glEndQueryEXT(GL_TIME_ELAPSED_EXT);
+    glQueryCounterEXT(timestampEnd, GL_TIMESTAMP_EXT);
+    ASSERT_GL_NO_ERROR();
+
+    pollQueryAvailability(timeElapsed);
+
+    // The other queries were submitted along with the time-elapsed one.
+    GLuint available = GL_FALSE;
+    glGetQueryObjectuiv(timestampEnd, GL_QUERY_RESULT_AVAILABLE, &available);
+    EXPECT_GL_TRUE(available);
+
+    GLuint64 begin   = 0;
+    GLuint64 end     = 0;
+    GLuint64 elapsed = 0;
+    glGetQueryObjectui64vEXT(timestampBegin, GL_QUERY_RESULT_EXT, &begin);
+    glGetQueryObjectui64vEXT(timestampEnd, GL_QUERY_RESULT_EXT, &end);
+    glGetQueryObjectui64vEXT(timeElapsed, GL_QUERY_RESULT_EXT, &elapsed);
+    ASSERT_GL_NO_ERROR();
+
+    EXPECT_LE(begin, end);
+    EXPECT_LE(elapsed, end - begin);
+}
+
+// Tests that polling for the availability of a transform feedback primitives written query doesn't
+// flush the commands the first time, and that the result is correct.
+TEST_P(VulkanPerformanceCounterTest, PollingTransformFeedbackQueryDoesNotFlush)
+{
+    std::vector<std::string> tfVaryings = {"gl_Position"};
+    ANGLE_GL_PROGRAM_TRANSFORM_FEEDBACK(program, essl1_shaders::vs::Simple(),
+                                        essl1_shaders::fs::Red(), tfVaryings,
+                                        GL_INTERLEAVED_ATTRIBS);
+
+    GLBuffer xfbBuffer;
+    glBindBuffer(GL_TRANSFORM_FEEDBACK_BUFFER, xfbBuffer);
+    glBufferData(GL_TRANSFORM_FEEDBACK_BUFFER, 6 * 4 * sizeof(float), nullptr, GL_STATIC_DRAW);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, xfbBuffer);
+
+    GLQuery primitivesWritten;
+    glUseProgram(program);
+    glBeginQuery(GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN, primitivesWritten);
+    glBeginTransformFeedback(GL_TRIANGLES);
+    drawQuad(program, essl1_shaders::PositionAttrib(), 0.5f);
+    glEndTransformFeedback();
+    glEndQuery(GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN);
+    ASSERT_GL_NO_ERROR();
+
+    pollQueryAvailability(primitivesWritten);
+
+    GLuint result = 0;
+    glGetQueryObjectuiv(primitivesWritten, GL_QUERY_RESULT, &result);
+    ASSERT_GL_NO_ERROR();
+    EXPECT_EQ(2u, result);
+}
+
+// Tests that ANGLE_multi_draw calls are issued as a single indirect draw, and that each draw in it
+// uses its own vertices.
+TEST_P(VulkanPerformanceCounterTest, MultiDrawIsIndirect)
+{
+    ANGLE_SKIP_TEST_IF(!hackANGLEFeatures().supportsMultiDrawIndirect.enabled);
+    ANGLE_SKIP_TEST_IF(!EnsureGLExtensionEnabled("GL_ANGLE_multi_draw"));
+
+    GLProgram program;
+    std::vector<GLfloat> vertices;
+    setupMultiDrawQuadrants(false, &program, &vertices);
+    glUseProgram(program);
+
+    multiDrawQuadrantsIndirect(program, vertices);
+}
+
+// Tests that ANGLE_multi_draw calls with gl_DrawID are issued as a single indirect draw, and that
+// gl_DrawID is the index of each draw in it.  Also tests gl_DrawID when the same program is first
+// used with client-side vertices, whose draws are issued separately.
+TEST_P(VulkanPerformanceCounterTest, MultiDrawWithDrawIDIsIndirect)
+{
+    ANGLE_SKIP_TEST_IF(!hackANGLEFeatures().supportsMultiDrawIndirect.enabled ||
+                       !hackANGLEFeatures().supportsShaderDrawParameters.enabled);
+    ANGLE_SKIP_TEST_IF(!EnsureGLExtensionEnabled("GL_ANGLE_multi_draw"));
+
+    const rx::vk::PerfCounters &counters = hackANGLE();
+
+    GLProgram program;
+    std::vector<GLfloat> vertices;
+    setupMultiDrawQuadrants(true, &program, &vertices);
+    glUseProgram(program);
+
+    // Client-side vertices need each draw's vertex range, so the draws are separate and
+    // gl_DrawID comes from the uniform.
+    setupMultiDrawAttributes(program, vertices.data());
+    const GLint firsts[kMultiDrawCount]   = {0, 6, 12, 18};
+    const GLsizei counts[kMultiDrawCount] = {6, 6, 6, 6};
+    uint32_t expectedIndirectMultiDraws   = counters.indirectMultiDraws;
+    glClear(GL_COLOR_BUFFER_BIT);
+    glMultiDrawArraysANGLE(GL_TRIANGLES, firsts, counts, kMultiDrawCount);
+    ASSERT_GL_NO_ERROR();
+    EXPECT_EQ(expectedIndirectMultiDraws, counters.indirectMultiDraws);
+    expectMultiDrawQuadrants();
+
+    // The uniform was left at the last draw's index and must not offset the indirect draws.
+    multiDrawQuadrantsIndirect(program, vertices);
+}
+
+// Tests that when a program is first drawn with a new surface rotation, the pipelines it was drawn
+// with at the other rotation are created ahead of the draws that use them.  The pbuffer isn't
+// rotated and the window is, so switching between them changes the rotation.
+TEST_P(VulkanPerformanceCounterTest_Prespecialize, NewRotationDoesNotCreatePipelinesOnDraw)
+{
+    ANGLE_SKIP_TEST_IF(!hackANGLEFeatures().prespecializeGraphicsPipelines.enabled ||
+                       !hasPipelineWorkerPool());
+
+    EGLWindow *window  = getEGLWindow();
+    EGLDisplay display = window->getDisplay();
+    EGLint surfaceType = 0;
+    eglGetConfigAttrib(display, window->getConfig(), EGL_SURFACE_TYPE, &surfaceType);
+    ANGLE_SKIP_TEST_IF((surfaceType & EGL_PBUFFER_BIT) == 0);
+
+    const rx::vk::PerfCounters &counters = hackANGLE();
+
+    const EGLint pbufferAttribs[] = {EGL_WIDTH, getWindowWidth(), EGL_HEIGHT, getWindowHeight(),
+                                     EGL_NONE};
+    EGLSurface pbuffer = eglCreatePbufferSurface(display, window->getConfig(), pbufferAttribs);
+    ASSERT_NE(EGL_NO_SURFACE, pbuffer);
+
+    ANGLE_GL_PROGRAM(drawGreen, essl1_shaders::vs::Simple(), essl1_shaders::fs::Green());
+
+    // Draws with three different pipelines.
+    auto drawWithThreePipelines = [&]() {
+        glClear(GL_COLOR_BUFFER_BIT);
+        drawQuad(drawGreen, essl1_shaders::PositionAttrib(), 0.5f);
+
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_ONE, GL_ZERO);
+        drawQuad(drawGreen, essl1_shaders::PositionAttrib(), 0.5f);
+
+        glEnable(GL_POLYGON_OFFSET_FILL);
+        glPolygonOffset(1.0f, 1.0f);
+        drawQuad(drawGreen, essl1_shaders::PositionAttrib(), 0.5f);
+
+        glDisable(GL_POLYGON_OFFSET_FILL);
+        glDisable(GL_BLEND);
+    };
+
+    EXPECT_EGL_TRUE(eglMakeCurrent(display, pbuffer, pbuffer, window->getContext()));
+    drawWithThreePipelines();
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::green);
+    ASSERT_GL_NO_ERROR();
+
+    EXPECT_EGL_TRUE(
+        eglMakeCurrent(display, window->getSurface(), window->getSurface(), window->getContext()));
+    uint32_t expectedPipelineCreations = counters.graphicsPipelineCreations;
+    drawWithThreePipelines();
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::green);
+    ASSERT_GL_NO_ERROR();
+
+    EXPECT_EQ(expectedPipelineCreations, counters.graphicsPipelineCreations);
+
+    eglDestroySurface(display, pbuffer);
+}
+
 ANGLE_INSTANTIATE_TEST(VulkanPerformanceCounterTest, ES3_VULKAN());
 ANGLE_INSTANTIATE_TEST(VulkanPerformanceCounterTest_ES31, ES31_VULKAN());
+ANGLE_INSTANTIATE_TEST(VulkanPerformanceCounterTest_AsyncCommandQueue,
+                       WithAsyncCommandQueueFeatureVulkan(ES3_VULKAN()));
+ANGLE_INSTANTIATE_TEST(VulkanPerformanceCounterTest_Prespecialize,
+                       WithPrespecializeGraphicsPipelinesFeatureVulkan(
+                           WithEmulatedPrerotation(ES3_VULKAN(), 90)));
 
 }  // anonymous namespace
@@ -552,7 +552,10 @@ void main()
     }
 }
 
-ANGLE_INSTANTIATE_TEST(VulkanUniformUpdatesTest, ES2_VULKAN(), ES3_VULKAN());
+ANGLE_INSTANTIATE_TEST(VulkanUniformUpdatesTest,
+                       ES2_VULKAN(),
+                       ES3_VULKAN(),
+                       WithDefaultUniformPushConstantsFeatureVulkan(ES3_VULKAN()));
 
 // This test tries to test uniform data update while switching between PPO and monolithic program.
 // The uniform data update occurred on one should carry over to the other. Also buffers are hacked
@@ -690,6 +693,356 @@ void main()
     }
 }
 
-ANGLE_INSTANTIATE_TEST(PipelineProgramUniformUpdatesTest, ES31_VULKAN());
+ANGLE_INSTANTIATE_TEST(PipelineProgramUniformUpdatesTest,
+                       ES31_VULKAN(),
+                       WithDefaultUniformPushConstantsFeatureVulkan(ES31_VULKAN()));
+
+// Tests the default uniform blocks that are delivered as push constants, which is only enabled
+// with the useDefaultUniformPushConstants feature.
+class VulkanDefaultUniformPushConstantsTest : public ANGLETest
+{
+  protected:
+    const rx::ProgramVk *hackProgram(GLuint handle) const
+    {
+        // Hack the angle!
+        const gl::Context *context = static_cast<gl::Context *>(getEGLWindow()->getContext());
+        return rx::vk::GetImpl(context->getProgramResolveLink({handle}));
+    }
+
+    uint32_t getMaxPushConstantsSize() const
+    {
+        const gl::Context *context     = static_cast<gl::Context *>(getEGLWindow()->getContext());
+        const rx::ContextVk *contextVk = rx::GetImplAs<rx::ContextVk>(context);
+        return contextVk->getRenderer()->getPhysicalDeviceProperties().limits.maxPushConstantsSize;
+    }
+
+    gl::ShaderBitSet getPushConstantStages(GLuint program) const
+    {
+        return hackProgram(program)->getExecutable().getDefaultUniformPushConstantStages();
+    }
+
+    // Creates a program whose vertex and fragment shaders add up the elements of a vec4 uniform
+    // array each, so their default uniform blocks are |vsCount| and |fsCount| vec4s.
+    void makeSumProgram(size_t vsCount, size_t fsCount, GLProgram *programOut)
+    {
+        std::stringstream vs;
+        vs << R"(#version 300 es
+in vec4 position;
+uniform vec4 vsData[)"
+           << vsCount << R"(];
+out vec4 color;
+void main()
+{
+    color = vec4(0);
+    for (int i = 0; i < )"
+           << vsCount << R"(; ++i)
+    {
+        color += vsData[i];
+    }
+    gl_Position = position;
+})";
+
+        std::stringstream fs;
+        fs << R"(#version 300 es
+precision mediump float;
+uniform vec4 fsData[)"
+           << fsCount << R"(];
+in vec4 color;
+out vec4 fragColor;
+void main()
+{
+    fragColor = color;
+    for (int i = 0; i < )"
+           << fsCount << R"(; ++i)
+    {
+        fragColor += fsData[i];
+    }
+})";
+
+        programOut->makeRaster(vs.str().c_str(), fs.str().c_str());
+        ASSERT_TRUE(programOut->valid());
+    }
+
+    // Sets all the elements of the uniform array |name| to zero, except for the last one.
+    void setSumUniform(GLuint program, const char *name, size_t count, const GLColor &last)
+    {
+        std::vector<Vector4> data(count, Vector4(0.0f));
+        data.back() = last.toNormalizedVector();
+
+        GLint location = glGetUniformLocation(program, name);
+        ASSERT_NE(-1, location);
+        glUniform4fv(location, static_cast<GLsizei>(count), data[0].data());
+    }
+
+    // Whether a sum program whose blocks take |totalCount| vec4s can be linked.
+    bool canMakeSumProgram(size_t totalCount) const
+    {
+        GLint maxVertexUniformVectors   = 0;
+        GLint maxFragmentUniformVectors = 0;
+        glGetIntegerv(GL_MAX_VERTEX_UNIFORM_VECTORS, &maxVertexUniformVectors);
+        glGetIntegerv(GL_MAX_FRAGMENT_UNIFORM_VECTORS, &maxFragmentUniformVectors);
+        return totalCount / 2 <= static_cast<size_t>(maxVertexUniformVectors) &&
+               totalCount - totalCount / 2 <= static_cast<size_t>(maxFragmentUniformVectors);
+    }
+
+    // Draws a sum program whose blocks take |totalCount| vec4s, and checks its uniform updates are
+    // seen by the following draws.  Returns the stages whose blocks are push constants.
+    void drawSumProgram(size_t totalCount, gl::ShaderBitSet *pushConstantStagesOut)
+    {
+        const size_t vsCount = totalCount / 2;
+        const size_t fsCount = totalCount - vsCount;
+
+        GLProgram program;
+        makeSumProgram(vsCount, fsCount, &program);
+        glUseProgram(program);
+        *pushConstantStagesOut = getPushConstantStages(program);
+
+        setSumUniform(program, "vsData", vsCount, GLColor::red);
+        setSumUniform(program, "fsData", fsCount, GLColor::black);
+        drawQuad(program, "position", 0.5f);
+        EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::red);
+
+        // Only the last element of the vertex shader's block changes.
+        setSumUniform(program, "vsData", vsCount, GLColor::green);
+        drawQuad(program, "position", 0.5f);
+        EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::green);
+
+        // Only the first element of the fragment shader's block changes.
+        GLint location = glGetUniformLocation(program, "fsData[0]");
+        ASSERT_NE(-1, location);
+        glUniform4f(location, 0.0f, 0.0f, 1.0f, 0.0f);
+        drawQuad(program, "position", 0.5f);
+        EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::cyan);
+        ASSERT_GL_NO_ERROR();
+    }
+};
+
+class VulkanDefaultUniformPushConstantsTestES31 : public VulkanDefaultUniformPushConstantsTest
+{};
+
+// Tests that vertex and fragment shader uniforms updated between draws are read by each draw,
+// including after the command buffer and the program change.
+TEST_P(VulkanDefaultUniformPushConstantsTest, VertexAndFragmentUniforms)
+{
+    constexpr char kVS[] = R"(#version 300 es
+in vec4 position;
+uniform vec2 offset;
+uniform vec4 vsColor;
+out vec4 color;
+void main()
+{
+    color = vsColor;
+    gl_Position = vec4(position.xy * 0.5 + offset, 0, 1);
+})";
+
+    constexpr char kFS[] = R"(#version 300 es
+precision mediump float;
+uniform vec4 fsColor;
+in vec4 color;
+out vec4 fragColor;
+void main()
+{
+    fragColor = color + fsColor;
+})";
+
+    ANGLE_GL_PROGRAM(program, kVS, kFS);
+    glUseProgram(program);
+
+    const gl::ShaderBitSet pushConstantStages = getPushConstantStages(program);
+    EXPECT_TRUE(pushConstantStages[gl::ShaderType::Vertex]);
+    EXPECT_TRUE(pushConstantStages[gl::ShaderType::Fragment]);
+
+    GLint offsetLocation = glGetUniformLocation(program, "offset");
+    ASSERT_NE(-1, offsetLocation);
+    GLint vsColorLocation = glGetUniformLocation(program, "vsColor");
+    ASSERT_NE(-1, vsColorLocation);
+    GLint fsColorLocation = glGetUniformLocation(program, "fsColor");
+    ASSERT_NE(-1, fsColorLocation);
+
+    // Draw a quad in each quadrant, with the colors split between the two stages.
+    const GLColor kVSColors[4] = {GLColor::red, GLColor::black, GLColor::red, GLColor::green};
+    const GLColor kFSColors[4] = {GLColor::black, GLColor::green, GLColor::blue, GLColor::red};
+    const GLColor kExpected[4] = {GLColor::red, GLColor::green, GLColor::magenta, GLColor::yellow};
+
+    const int w = getWindowWidth();
+    const int h = getWindowHeight();
+
+    glClear(GL_COLOR_BUFFER_BIT);
+    for (int quad = 0; quad < 4; ++quad)
+    {
+        glUniform2f(offsetLocation, quad % 2 == 0 ? -0.5f : 0.5f, quad / 2 == 0 ? -0.5f : 0.5f);
+        glUniform4fv(vsColorLocation, 1, kVSColors[quad].toNormalizedVector().data());
+        glUniform4fv(fsColorLocation, 1, kFSColors[quad].toNormalizedVector().data());
+        drawQuad(program, "position", 0.5f);
+    }
+    ASSERT_GL_NO_ERROR();
+    for (int quad = 0; quad < 4; ++quad)
+    {
+        EXPECT_PIXEL_COLOR_EQ((quad % 2 * 2 + 1) * w / 4, (quad / 2 * 2 + 1) * h / 4,
+                              kExpected[quad]);
+    }
+
+    // Draw with another program, then redraw the last quad in a new command buffer without
+    // changing the uniforms.
+    ANGLE_GL_PROGRAM(otherProgram, essl3_shaders::vs::Simple(), essl3_shaders::fs::Red());
+    drawQuad(otherProgram, essl3_shaders::PositionAttrib(), 0.5f);
+    EXPECT_PIXEL_COLOR_EQ(w / 4, h / 4, GLColor::red);
+    EXPECT_PIXEL_COLOR_EQ(3 * w / 4, 3 * h / 4, GLColor::red);
+
+    glUseProgram(program);
+    drawQuad(program, "position", 0.5f);
+    ASSERT_GL_NO_ERROR();
+    EXPECT_PIXEL_COLOR_EQ(w / 4, h / 4, GLColor::red);
+    EXPECT_PIXEL_COLOR_EQ(3 * w / 4, 3 * h / 4, kExpected[3]);
+}
+
+// Tests blocks that take exactly maxPushConstantsSize, which are delivered as push constants.
+TEST_P(VulkanDefaultUniformPushConstantsTest, BlocksAtLimit)
+{
+    const size_t totalCount = getMaxPushConstantsSize() / 16;
+    ANGLE_SKIP_TEST_IF(!canMakeSumProgram(totalCount));
+
+    gl::ShaderBitSet pushConstantStages;
+    drawSumProgram(totalCount, &pushConstantStages);
+    EXPECT_TRUE(pushConstantStages[gl::ShaderType::Vertex]);
+    EXPECT_TRUE(pushConstantStages[gl::ShaderType::Fragment]);
+}
+
+// Tests blocks that take more than maxPushConstantsSize, which fall back to the default uniform
+// buffer.
+TEST_P(VulkanDefaultUniformPushConstantsTest, BlocksOverLimit)
+{
+    const size_t totalCount = getMaxPushConstantsSize() / 16 + 1;
+    ANGLE_SKIP_TEST_IF(!canMakeSumProgram(totalCount));
+
+    gl::ShaderBitSet pushConstantStages;
+    drawSumProgram(totalCount, &pushConstantStages);
+    EXPECT_TRUE(pushConstantStages.none());
+}
+
+// Tests that compute shader uniforms updated between dispatches are read by each dispatch.
+TEST_P(VulkanDefaultUniformPushConstantsTestES31, ComputeUniforms)
+{
+    constexpr char kCS[] = R"(#version 310 es
+layout(local_size_x = 1) in;
+uniform uint index;
+uniform uvec4 value;
+layout(std430, binding = 0) buffer Output
+{
+    uvec4 result[];
+};
+void main()
+{
+    result[index] = value;
+})";
+
+    ANGLE_GL_COMPUTE_PROGRAM(program, kCS);
+    glUseProgram(program);
+    EXPECT_TRUE(getPushConstantStages(program)[gl::ShaderType::Compute]);
+
+    GLint indexLocation = glGetUniformLocation(program, "index");
+    ASSERT_NE(-1, indexLocation);
+    GLint valueLocation = glGetUniformLocation(program, "value");
+    ASSERT_NE(-1, valueLocation);
+
+    constexpr GLuint kCount = 3;
+    const std::array<GLuint, kCount * 4> zeros{};
+    GLBuffer buffer;
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(zeros), zeros.data(), GL_STATIC_DRAW);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, buffer);
+
+    for (GLuint index = 0; index < kCount; ++index)
+    {
+        glUniform1ui(indexLocation, index);
+        glUniform4ui(valueLocation, index, index + 10, index + 20, index + 30);
+        glDispatchCompute(1, 1, 1);
+    }
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    ASSERT_GL_NO_ERROR();
+
+    const GLuint *result = static_cast<const GLuint *>(
+        glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, sizeof(zeros), GL_MAP_READ_BIT));
+    ASSERT_NE(nullptr, result);
+    for (GLuint index = 0; index < kCount; ++index)
+    {
+        for (GLuint component = 0; component < 4; ++component)
+        {
+            EXPECT_EQ(index + component * 10, result[index * 4 + component]);
+        }
+    }
+    glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
+}
+
+// Tests that geometry shader uniforms updated between draws are read by each draw.
+TEST_P(VulkanDefaultUniformPushConstantsTestES31, GeometryUniforms)
+{
+    ANGLE_SKIP_TEST_IF(!EnsureGLExtensionEnabled("GL_EXT_geometry_shader"));
+
+    constexpr char kVS[] = R"(#version 310 es
+in vec4 position;
+void main()
+{
+    gl_Position = position;
+})";
+
+    constexpr char kGS[] = R"(#version 310 es
+#extension GL_EXT_geometry_shader : require
+layout(triangles) in;
+layout(triangle_strip, max_vertices = 3) out;
+uniform vec4 gsColor;
+out vec4 color;
+void main()
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        color = gsColor;
+        gl_Position = gl_in[i].gl_Position;
+        EmitVertex();
+    }
+    EndPrimitive();
+})";
+
+    constexpr char kFS[] = R"(#version 310 es
+precision mediump float;
+uniform vec4 fsColor;
+in vec4 color;
+out vec4 fragColor;
+void main()
+{
+    fragColor = color + fsColor;
+})";
+
+    ANGLE_GL_PROGRAM_WITH_GS(program, kVS, kGS, kFS);
+    glUseProgram(program);
+
+    const gl::ShaderBitSet pushConstantStages = getPushConstantStages(program);
+    EXPECT_TRUE(pushConstantStages[gl::ShaderType::Geometry]);
+    EXPECT_TRUE(pushConstantStages[gl::ShaderType::Fragment]);
+
+    GLint gsColorLocation = glGetUniformLocation(program, "gsColor");
+    ASSERT_NE(-1, gsColorLocation);
+    GLint fsColorLocation = glGetUniformLocation(program, "fsColor");
+    ASSERT_NE(-1, fsColorLocation);
+
+    glUniform4f(gsColorLocation, 1.0f, 0.0f, 0.0f, 1.0f);
+    glUniform4f(fsColorLocation, 0.0f, 0.0f, 0.0f, 0.0f);
+    drawQuad(program, "position", 0.5f);
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::red);
+
+    glUniform4f(gsColorLocation, 0.0f, 1.0f, 0.0f, 1.0f);
+    drawQuad(program, "position", 0.5f);
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::green);
+
+    glUniform4f(fsColorLocation, 0.0f, 0.0f, 1.0f, 0.0f);
+    drawQuad(program, "position", 0.5f);
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::cyan);
+    ASSERT_GL_NO_ERROR();
+}
+
+ANGLE_INSTANTIATE_TEST(VulkanDefaultUniformPushConstantsTest,
+                       WithDefaultUniformPushConstantsFeatureVulkan(ES3_VULKAN()));
+ANGLE_INSTANTIATE_TEST(VulkanDefaultUniformPushConstantsTestES31,
+                       WithDefaultUniformPushConstantsFeatureVulkan(ES31_VULKAN()));
 
 }  // anonymous namespace
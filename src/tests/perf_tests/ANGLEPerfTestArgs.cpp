@@ -26,6 +26,8 @@ int gTestTrials                = 3;
 bool gNoFinish                 = false;
 bool gEnableAllTraceTests      = false;
 bool gStartTraceAfterSetup     = false;
+bool gUseBinaryTraces          = false;
+const char *gBinaryTracePath   = nullptr;
 
 // Default to three warmup loops. There's no science to this. More than two loops was experimentally
 // helpful on a Windows NVIDIA setup when testing with Vulkan and native trace tests.
@@ -46,6 +48,8 @@ int ReadIntArgument(const char *arg)
 
 // The same as --screenshot-dir, but used by Chrome tests.
 constexpr char kRenderTestDirArg[] = "--render-test-output-dir=";
+
+constexpr char kBinaryTraceArg[] = "--binary-trace=";
 }  // namespace
 
 using namespace angle;
@@ -144,6 +148,15 @@ void ANGLEProcessPerfTestArgs(int *argc, char **argv)
         {
             gStartTraceAfterSetup = true;
         }
+        else if (strcmp("--use-binary-traces", argv[argIndex]) == 0)
+        {
+            gUseBinaryTraces = true;
+        }
+        else if (strncmp(kBinaryTraceArg, argv[argIndex], strlen(kBinaryTraceArg)) == 0)
+        {
+            gBinaryTracePath = argv[argIndex] + strlen(kBinaryTraceArg);
+            gUseBinaryTraces = true;
+        }
         else
         {
             argv[argcOutCount++] = argv[argIndex];
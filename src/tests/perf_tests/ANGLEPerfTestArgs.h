@@ -28,6 +28,8 @@ extern int gTestTrials;
 extern bool gNoFinish;
 extern bool gEnableAllTraceTests;
 extern bool gStartTraceAfterSetup;
+extern bool gUseBinaryTraces;
+extern const char *gBinaryTracePath;
 
 inline bool OneFrame()
 {
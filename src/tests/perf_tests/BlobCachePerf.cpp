@@ -0,0 +1,131 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// BlobCachePerf:
+//   Performance test for looking up blobs in the BlobCache while other threads use it too, the way
+//   program and pipeline caches are hit by contexts on different threads.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <atomic>
+#include <sstream>
+#include <thread>
+
+#include "libANGLE/BlobCache.h"
+
+namespace
+{
+constexpr unsigned int kIterationsPerStep = 1000;
+constexpr size_t kCacheSize               = 64 * 1024 * 1024;
+constexpr size_t kBlobSize                = 16 * 1024;
+constexpr size_t kBlobCount               = 256;
+
+egl::BlobCache::Key MakeKey(size_t index)
+{
+    // Spread the keys the way SHA-1 hashes are spread.
+    egl::BlobCache::Key key;
+    for (size_t byte = 0; byte < key.size(); ++byte)
+    {
+        key[byte] = static_cast<uint8_t>(index * 37 + byte * 11);
+    }
+    key[0] = static_cast<uint8_t>(index);
+    return key;
+}
+
+std::string GetStory(size_t threadCount)
+{
+    std::stringstream storyStr;
+    storyStr << "_" << threadCount << "_other_threads";
+    return storyStr.str();
+}
+
+class BlobCachePerfTest : public ANGLEPerfTest, public ::testing::WithParamInterface<size_t>
+{
+  public:
+    BlobCachePerfTest();
+
+    void SetUp() override;
+    void TearDown() override;
+    void step() override;
+
+  private:
+    void lookUp(angle::ScratchBuffer *scratchBuffer, size_t index);
+
+    egl::BlobCache mBlobCache;
+    angle::ScratchBuffer mScratchBuffer;
+    size_t mNextIndex = 0;
+
+    // Threads that keep looking blobs up while the test runs.
+    std::vector<std::thread> mThreads;
+    std::atomic<bool> mStopThreads;
+};
+
+BlobCachePerfTest::BlobCachePerfTest()
+    : ANGLEPerfTest("BlobCachePerf", "", GetStory(GetParam()), kIterationsPerStep),
+      mBlobCache(kCacheSize),
+      mStopThreads(false)
+{}
+
+void BlobCachePerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    for (size_t index = 0; index < kBlobCount; ++index)
+    {
+        angle::MemoryBuffer blob;
+        ASSERT_TRUE(blob.resize(kBlobSize));
+        blob.fill(static_cast<uint8_t>(index));
+        mBlobCache.populate(MakeKey(index), std::move(blob));
+    }
+
+    for (size_t threadIndex = 0; threadIndex < GetParam(); ++threadIndex)
+    {
+        mThreads.emplace_back([this, threadIndex]() {
+            angle::ScratchBuffer scratchBuffer;
+            size_t index = threadIndex * 7;
+            while (!mStopThreads)
+            {
+                lookUp(&scratchBuffer, index++);
+            }
+        });
+    }
+}
+
+void BlobCachePerfTest::TearDown()
+{
+    mStopThreads = true;
+    for (std::thread &thread : mThreads)
+    {
+        thread.join();
+    }
+
+    ANGLEPerfTest::TearDown();
+}
+
+void BlobCachePerfTest::lookUp(angle::ScratchBuffer *scratchBuffer, size_t index)
+{
+    egl::BlobCache::Value blob;
+    size_t blobSize;
+    bool found = mBlobCache.get(scratchBuffer, MakeKey(index % kBlobCount), &blob, &blobSize);
+    EXPECT_TRUE(found);
+    EXPECT_EQ(kBlobSize, blobSize);
+}
+
+void BlobCachePerfTest::step()
+{
+    for (unsigned int iteration = 0; iteration < kIterationsPerStep; ++iteration)
+    {
+        lookUp(&mScratchBuffer, mNextIndex++);
+    }
+}
+
+TEST_P(BlobCachePerfTest, Run)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(, BlobCachePerfTest, ::testing::Values(0, 1, 3, 7));
+}  // anonymous namespace
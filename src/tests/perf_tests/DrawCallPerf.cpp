@@ -13,6 +13,8 @@
 #include "test_utils/draw_call_perf_utils.h"
 #include "util/shader_utils.h"
 
+#include <algorithm>
+
 namespace
 {
 enum class StateChange
@@ -25,11 +27,15 @@ enum class StateChange
     Program,
     VertexBufferCycle,
     Scissor,
+    MultiDraw,
     InvalidEnum,
 };
 
 constexpr size_t kCycleVBOPoolSize = 200;
 
+// Number of draws each glMultiDrawArraysANGLE call is split into.
+constexpr GLsizei kMultiDrawCount = 16;
+
 struct DrawArraysPerfParams : public DrawCallPerfParams
 {
     DrawArraysPerfParams() = default;
@@ -69,6 +75,9 @@ std::string DrawArraysPerfParams::story() const
         case StateChange::Scissor:
             strstr << "_scissor_change";
             break;
+        case StateChange::MultiDraw:
+            strstr << "_multi_draw";
+            break;
         default:
             break;
     }
@@ -134,9 +143,17 @@ class DrawCallPerfBenchmark : public ANGLERenderTest,
     int mNumTris       = GetParam().numTris;
     std::vector<GLuint> mVBOPool;
     size_t mCurrentVBO = 0;
+    std::vector<GLint> mMultiDrawFirsts;
+    std::vector<GLsizei> mMultiDrawCounts;
 };
 
-DrawCallPerfBenchmark::DrawCallPerfBenchmark() : ANGLERenderTest("DrawCallPerf", GetParam()) {}
+DrawCallPerfBenchmark::DrawCallPerfBenchmark() : ANGLERenderTest("DrawCallPerf", GetParam())
+{
+    if (GetParam().stateChange == StateChange::MultiDraw)
+    {
+        addExtensionPrerequisite("GL_ANGLE_multi_draw");
+    }
+}
 
 void DrawCallPerfBenchmark::initializeBenchmark()
 {
@@ -256,6 +273,19 @@ void main()
         glBindTexture(GL_TEXTURE_2D, mTexture2);
     }
 
+    if (params.stateChange == StateChange::MultiDraw)
+    {
+        // Split the triangles evenly between the draws, giving the remainder to the last one.
+        GLsizei trisPerDraw = std::max(mNumTris / kMultiDrawCount, 1);
+        for (GLsizei draw = 0; draw < kMultiDrawCount && draw * trisPerDraw < mNumTris; ++draw)
+        {
+            GLsizei firstTri = draw * trisPerDraw;
+            GLsizei drawTris = draw + 1 == kMultiDrawCount ? mNumTris - firstTri : trisPerDraw;
+            mMultiDrawFirsts.push_back(3 * firstTri);
+            mMultiDrawCounts.push_back(3 * drawTris);
+        }
+    }
+
     ASSERT_GL_NO_ERROR();
 }
 
@@ -294,6 +324,20 @@ void JustDraw(unsigned int iterations, GLsizei numElements)
     }
 }
 
+void MultiDrawArrays(unsigned int iterations,
+                     const std::vector<GLint> &firsts,
+                     const std::vector<GLsizei> &counts)
+{
+    GLsizei drawCount = static_cast<GLsizei>(firsts.size());
+
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    for (unsigned int it = 0; it < iterations; it++)
+    {
+        glMultiDrawArraysANGLE(GL_TRIANGLES, firsts.data(), counts.data(), drawCount);
+    }
+}
+
 template <int kArrayBufferCount>
 void ChangeVertexAttribThenDraw(unsigned int iterations, GLsizei numElements, GLuint buffer)
 {
@@ -514,6 +558,9 @@ void DrawCallPerfBenchmark::drawBenchmark()
             ChangeScissorThenDraw(params.iterationsPerStep, numElements, getWindow()->getWidth(),
                                   getWindow()->getHeight());
             break;
+        case StateChange::MultiDraw:
+            MultiDrawArrays(params.iterationsPerStep, mMultiDrawFirsts, mMultiDrawCounts);
+            break;
         case StateChange::InvalidEnum:
             FAIL() << "Invalid state change.";
             break;
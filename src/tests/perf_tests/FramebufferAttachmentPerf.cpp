@@ -0,0 +1,190 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// FramebufferAttachmentPerf:
+//   Performance test for rendering into a single framebuffer object whose color attachment is
+//   switched between a set of same-sized textures every draw, the way post-processing chains and
+//   texture atlases ping-pong between render targets.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <sstream>
+
+#include "util/shader_utils.h"
+
+using namespace angle;
+
+namespace
+{
+constexpr unsigned int kIterationsPerStep = 10;
+
+struct FramebufferAttachmentParams final : public RenderTestParams
+{
+    FramebufferAttachmentParams()
+    {
+        iterationsPerStep = kIterationsPerStep;
+        majorVersion      = 3;
+        minorVersion      = 0;
+        windowWidth       = 256;
+        windowHeight      = 256;
+    }
+
+    std::string story() const override
+    {
+        std::stringstream storyStr;
+        storyStr << RenderTestParams::story();
+        storyStr << "_" << textureCount << "_textures";
+        if (respecify)
+        {
+            storyStr << "_respecify";
+        }
+        return storyStr.str();
+    }
+
+    unsigned int textureCount = 8;
+    unsigned int textureSize  = 256;
+    // Redefine one texture's storage every frame, so new images keep showing up as attachments.
+    bool respecify = false;
+};
+
+std::ostream &operator<<(std::ostream &os, const FramebufferAttachmentParams &params)
+{
+    os << params.backendAndStory().substr(1);
+    return os;
+}
+
+class FramebufferAttachmentBenchmark
+    : public ANGLERenderTest,
+      public ::testing::WithParamInterface<FramebufferAttachmentParams>
+{
+  public:
+    FramebufferAttachmentBenchmark() : ANGLERenderTest("FramebufferAttachment", GetParam()) {}
+
+    void initializeBenchmark() override;
+    void destroyBenchmark() override;
+    void drawBenchmark() override;
+
+  private:
+    void specifyTexture(GLuint texture);
+
+    GLuint mProgram     = 0;
+    GLuint mFramebuffer = 0;
+    std::vector<GLuint> mTextures;
+    size_t mFrameIndex = 0;
+};
+
+void FramebufferAttachmentBenchmark::specifyTexture(GLuint texture)
+{
+    const FramebufferAttachmentParams &params = GetParam();
+
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, params.textureSize, params.textureSize, 0, GL_RGBA,
+                 GL_UNSIGNED_BYTE, nullptr);
+}
+
+void FramebufferAttachmentBenchmark::initializeBenchmark()
+{
+    const FramebufferAttachmentParams &params = GetParam();
+
+    constexpr char kVS[] = R"(void main()
+{
+    gl_Position = vec4(0, 0, 0, 1);
+})";
+
+    constexpr char kFS[] = R"(precision mediump float;
+void main()
+{
+    gl_FragColor = vec4(1);
+})";
+
+    mProgram = CompileProgram(kVS, kFS);
+    ASSERT_NE(0u, mProgram);
+    glUseProgram(mProgram);
+
+    mTextures.resize(params.textureCount);
+    glGenTextures(params.textureCount, mTextures.data());
+    for (GLuint texture : mTextures)
+    {
+        specifyTexture(texture);
+    }
+
+    glGenFramebuffers(1, &mFramebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffer);
+    glViewport(0, 0, params.textureSize, params.textureSize);
+
+    ASSERT_GL_NO_ERROR();
+}
+
+void FramebufferAttachmentBenchmark::destroyBenchmark()
+{
+    glDeleteFramebuffers(1, &mFramebuffer);
+    glDeleteTextures(static_cast<GLsizei>(mTextures.size()), mTextures.data());
+    glDeleteProgram(mProgram);
+}
+
+void FramebufferAttachmentBenchmark::drawBenchmark()
+{
+    const FramebufferAttachmentParams &params = GetParam();
+
+    if (params.respecify)
+    {
+        specifyTexture(mTextures[mFrameIndex % mTextures.size()]);
+    }
+
+    for (unsigned int iteration = 0; iteration < params.iterationsPerStep; ++iteration)
+    {
+        for (GLuint texture : mTextures)
+        {
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture,
+                                   0);
+
+            // A single cheap draw is enough to start a render pass with the new attachment.
+            glDrawArrays(GL_TRIANGLES, 0, 3);
+        }
+    }
+
+    ++mFrameIndex;
+
+    ASSERT_GL_NO_ERROR();
+}
+
+FramebufferAttachmentParams D3D11Params(bool respecify)
+{
+    FramebufferAttachmentParams params;
+    params.eglParameters = egl_platform::D3D11();
+    params.respecify     = respecify;
+    return params;
+}
+
+FramebufferAttachmentParams OpenGLOrGLESParams(bool respecify)
+{
+    FramebufferAttachmentParams params;
+    params.eglParameters = egl_platform::OPENGL_OR_GLES();
+    params.respecify     = respecify;
+    return params;
+}
+
+FramebufferAttachmentParams VulkanParams(bool respecify)
+{
+    FramebufferAttachmentParams params;
+    params.eglParameters = egl_platform::VULKAN();
+    params.respecify     = respecify;
+    return params;
+}
+}  // anonymous namespace
+
+TEST_P(FramebufferAttachmentBenchmark, Run)
+{
+    run();
+}
+
+ANGLE_INSTANTIATE_TEST(FramebufferAttachmentBenchmark,
+                       D3D11Params(false),
+                       D3D11Params(true),
+                       OpenGLOrGLESParams(false),
+                       OpenGLOrGLESParams(true),
+                       VulkanParams(false),
+                       VulkanParams(true));
@@ -33,6 +33,8 @@ struct GenerateMipmapParams final : public RenderTestParams
         textureHeight = 1080;
 
         internalFormat = GL_RGBA;
+        format         = GL_RGBA;
+        type           = GL_UNSIGNED_BYTE;
 
         webgl = false;
     }
@@ -43,6 +45,8 @@ struct GenerateMipmapParams final : public RenderTestParams
     GLsizei textureHeight;
 
     GLenum internalFormat;
+    GLenum format;
+    GLenum type;
 
     bool webgl;
 };
@@ -67,6 +71,19 @@ std::string GenerateMipmapParams::story() const
     {
         strstr << "_rgb";
     }
+    else if (internalFormat == GL_RGBA16F)
+    {
+        strstr << "_rgba16f";
+    }
+    else if (internalFormat == GL_RGBA32F)
+    {
+        strstr << "_rgba32f";
+    }
+
+    if (eglParameters.forceCPUGenerateMipmapFeatureVulkan == EGL_TRUE)
+    {
+        strstr << "_cpu";
+    }
 
     return strstr.str();
 }
@@ -80,6 +97,29 @@ void FillWithRandomData(T *storage)
     }
 }
 
+// Random bytes make for NaNs and denormals when uploaded as floats, so float data is filled with
+// values in [0, 1] instead.
+template <typename T>
+void FillWithRandomData(T *storage, GLenum type)
+{
+    if (type != GL_FLOAT)
+    {
+        FillWithRandomData(storage);
+        return;
+    }
+
+    for (size_t offset = 0; offset + sizeof(float) <= storage->size(); offset += sizeof(float))
+    {
+        float value = static_cast<float>(rand() & 0xFF) / 255.0f;
+        memcpy(storage->data() + offset, &value, sizeof(float));
+    }
+}
+
+size_t GetTexelSize(GLenum type)
+{
+    return (type == GL_FLOAT ? sizeof(float) : sizeof(uint8_t)) * 4;
+}
+
 class GenerateMipmapBenchmarkBase : public ANGLERenderTest,
                                     public ::testing::WithParamInterface<GenerateMipmapParams>
 {
@@ -159,11 +199,11 @@ void GenerateMipmapBenchmarkBase::initializeBenchmark()
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-    mTextureData.resize(params.textureWidth * params.textureHeight * 4);
-    FillWithRandomData(&mTextureData);
+    mTextureData.resize(params.textureWidth * params.textureHeight * GetTexelSize(params.type));
+    FillWithRandomData(&mTextureData, params.type);
 
     glTexImage2D(GL_TEXTURE_2D, 0, params.internalFormat, params.textureWidth, params.textureHeight,
-                 0, params.internalFormat, GL_UNSIGNED_BYTE, mTextureData.data());
+                 0, params.format, params.type, mTextureData.data());
 
     // Perform a draw so the image data is flushed.
     glDrawArrays(GL_TRIANGLES, 0, 3);
@@ -221,10 +261,10 @@ void GenerateMipmapBenchmark::drawBenchmark()
     for (unsigned int iteration = 0; iteration < params.iterationsPerStep; ++iteration)
     {
         // Slightly modify the base texture so the mipmap is definitely regenerated.
-        std::array<uint8_t, 4> randomData;
-        FillWithRandomData(&randomData);
+        std::array<uint8_t, 16> randomData;
+        FillWithRandomData(&randomData, params.type);
 
-        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 1, 1, params.internalFormat, GL_UNSIGNED_BYTE,
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 1, 1, params.format, params.type,
                         randomData.data());
 
         // Generate mipmaps
@@ -253,7 +293,7 @@ void GenerateMipmapWithRedefineBenchmark::drawBenchmark()
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
     glTexImage2D(GL_TEXTURE_2D, 0, params.internalFormat, params.textureWidth, params.textureHeight,
-                 0, params.internalFormat, GL_UNSIGNED_BYTE, mTextureData.data());
+                 0, params.format, params.type, mTextureData.data());
 
     // Perform a draw so the image data is flushed.
     glDrawArrays(GL_TRIANGLES, 0, 3);
@@ -315,6 +355,7 @@ GenerateMipmapParams VulkanParams(bool webglCompat, bool singleIteration, bool e
     if (emulatedFormat)
     {
         params.internalFormat = GL_RGB;
+        params.format         = GL_RGB;
     }
     if (singleIteration)
     {
@@ -323,6 +364,16 @@ GenerateMipmapParams VulkanParams(bool webglCompat, bool singleIteration, bool e
     return params;
 }
 
+// Forces the CPU fallback that is used when the format can't be blitted or written by compute.
+GenerateMipmapParams VulkanCPUParams(GLenum internalFormat, GLenum type, bool singleIteration)
+{
+    GenerateMipmapParams params = VulkanParams(false, singleIteration, false);
+    params.eglParameters.forceCPUGenerateMipmapFeatureVulkan = EGL_TRUE;
+    params.internalFormat                                    = internalFormat;
+    params.type                                              = type;
+    return params;
+}
+
 }  // anonymous namespace
 
 TEST_P(GenerateMipmapBenchmark, Run)
@@ -345,7 +396,10 @@ ANGLE_INSTANTIATE_TEST(GenerateMipmapBenchmark,
                        VulkanParams(false, false, false),
                        VulkanParams(true, false, false),
                        VulkanParams(false, false, true),
-                       VulkanParams(true, false, true));
+                       VulkanParams(true, false, true),
+                       VulkanCPUParams(GL_RGBA, GL_UNSIGNED_BYTE, false),
+                       VulkanCPUParams(GL_RGBA16F, GL_FLOAT, false),
+                       VulkanCPUParams(GL_RGBA32F, GL_FLOAT, false));
 
 ANGLE_INSTANTIATE_TEST(GenerateMipmapWithRedefineBenchmark,
                        D3D11Params(false, true),
@@ -355,4 +409,6 @@ ANGLE_INSTANTIATE_TEST(GenerateMipmapWithRedefineBenchmark,
                        VulkanParams(false, true, false),
                        VulkanParams(true, true, false),
                        VulkanParams(false, true, true),
-                       VulkanParams(true, true, true));
+                       VulkanParams(true, true, true),
+                       VulkanCPUParams(GL_RGBA, GL_UNSIGNED_BYTE, true),
+                       VulkanCPUParams(GL_RGBA32F, GL_FLOAT, true));
@@ -0,0 +1,125 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// HandleAllocatorPerf:
+//   Performance test for allocating and releasing GL handles, the way glGen* and glDelete* do for
+//   particle systems and streamed tiles that recreate many objects every frame.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <sstream>
+
+#include "libANGLE/HandleAllocator.h"
+
+namespace
+{
+constexpr unsigned int kIterationsPerStep = 10;
+constexpr size_t kLiveHandleCount         = 16384;
+
+struct HandleAllocatorParams
+{
+    // The number of handles generated and deleted by each call.
+    size_t batchSize;
+    // Whether the bulk allocate() and release() are used.
+    bool bulk;
+};
+
+std::ostream &operator<<(std::ostream &os, const HandleAllocatorParams &params)
+{
+    os << "_" << params.batchSize << (params.bulk ? "_bulk" : "_single");
+    return os;
+}
+
+std::string GetStory(const HandleAllocatorParams &params)
+{
+    std::stringstream storyStr;
+    storyStr << params;
+    return storyStr.str();
+}
+
+class HandleAllocatorPerfTest : public ANGLEPerfTest,
+                                public ::testing::WithParamInterface<HandleAllocatorParams>
+{
+  public:
+    HandleAllocatorPerfTest();
+
+    void SetUp() override;
+    void step() override;
+
+  private:
+    gl::HandleAllocator mHandleAllocator;
+    std::vector<GLuint> mHandles;
+    std::vector<GLuint> mBatch;
+    size_t mNextBatch = 0;
+};
+
+HandleAllocatorPerfTest::HandleAllocatorPerfTest()
+    : ANGLEPerfTest("HandleAllocatorPerf", "", GetStory(GetParam()), kIterationsPerStep)
+{}
+
+void HandleAllocatorPerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    mHandles.resize(kLiveHandleCount);
+    mHandleAllocator.allocate(mHandles.size(), mHandles.data());
+    mBatch.resize(GetParam().batchSize);
+}
+
+void HandleAllocatorPerfTest::step()
+{
+    const HandleAllocatorParams &params = GetParam();
+    const size_t batchCount             = kLiveHandleCount / params.batchSize;
+
+    for (unsigned int iteration = 0; iteration < kIterationsPerStep; ++iteration)
+    {
+        for (size_t batch = 0; batch < batchCount; ++batch)
+        {
+            // Delete handles spread over the whole range, then generate as many again.
+            size_t batchIndex = (mNextBatch++ * 7) % batchCount;
+            for (size_t index = 0; index < params.batchSize; ++index)
+            {
+                mBatch[index] = mHandles[index * batchCount + batchIndex];
+            }
+
+            if (params.bulk)
+            {
+                mHandleAllocator.release(mBatch.size(), mBatch.data());
+                mHandleAllocator.allocate(mBatch.size(), mBatch.data());
+            }
+            else
+            {
+                for (GLuint handle : mBatch)
+                {
+                    mHandleAllocator.release(handle);
+                }
+                for (GLuint &handle : mBatch)
+                {
+                    handle = mHandleAllocator.allocate();
+                }
+            }
+
+            for (size_t index = 0; index < params.batchSize; ++index)
+            {
+                mHandles[index * batchCount + batchIndex] = mBatch[index];
+            }
+        }
+    }
+}
+
+TEST_P(HandleAllocatorPerfTest, Run)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         HandleAllocatorPerfTest,
+                         ::testing::Values(HandleAllocatorParams{1, false},
+                                           HandleAllocatorParams{64, false},
+                                           HandleAllocatorParams{64, true},
+                                           HandleAllocatorParams{1024, false},
+                                           HandleAllocatorParams{1024, true}));
+}  // anonymous namespace
@@ -0,0 +1,230 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ReadPixelsPerf:
+//   Performance test for glReadPixels, either into client memory or into a ring of pixel pack
+//   buffers that are mapped a few frames later, the way screenshot and video capture work. Each
+//   step is one frame, so the ring advances through a swap between reads.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <array>
+#include <sstream>
+
+using namespace angle;
+
+namespace
+{
+// Number of pack buffers in flight.  The oldest one is mapped after each read.
+constexpr size_t kPackBufferCount = 3;
+
+// Generous enough to never expire unless the GPU hangs.
+constexpr GLuint64 kFenceTimeoutNs = 10'000'000'000;
+
+enum class ReadDestination
+{
+    ClientMemory,
+    PackBuffer,
+};
+
+struct ReadPixelsParams final : public RenderTestParams
+{
+    ReadPixelsParams()
+    {
+        iterationsPerStep = 1;
+        majorVersion      = 3;
+        minorVersion      = 0;
+        windowWidth       = 1920;
+        windowHeight      = 1080;
+    }
+
+    std::string story() const override
+    {
+        std::stringstream storyStr;
+        storyStr << RenderTestParams::story();
+        storyStr << (destination == ReadDestination::PackBuffer ? "_pbo" : "_client");
+        if (readFromWindow)
+        {
+            storyStr << "_window";
+        }
+        return storyStr.str();
+    }
+
+    ReadDestination destination = ReadDestination::ClientMemory;
+    bool readFromWindow         = false;
+};
+
+std::ostream &operator<<(std::ostream &os, const ReadPixelsParams &params)
+{
+    os << params.backendAndStory().substr(1);
+    return os;
+}
+
+class ReadPixelsBenchmark : public ANGLERenderTest,
+                            public ::testing::WithParamInterface<ReadPixelsParams>
+{
+  public:
+    ReadPixelsBenchmark() : ANGLERenderTest("ReadPixels", GetParam())
+    {
+        mPackBuffers.fill(0);
+        mPackFences.fill(nullptr);
+    }
+
+    void initializeBenchmark() override;
+    void destroyBenchmark() override;
+    void drawBenchmark() override;
+
+  private:
+    size_t getPixelsSize() const;
+
+    GLuint mFramebuffer  = 0;
+    GLuint mRenderbuffer = 0;
+    std::array<GLuint, kPackBufferCount> mPackBuffers;
+    std::array<GLsync, kPackBufferCount> mPackFences;
+    std::vector<uint8_t> mClientPixels;
+    size_t mFrameIndex = 0;
+};
+
+size_t ReadPixelsBenchmark::getPixelsSize() const
+{
+    const ReadPixelsParams &params = GetParam();
+    return static_cast<size_t>(params.windowWidth) * params.windowHeight * 4;
+}
+
+void ReadPixelsBenchmark::initializeBenchmark()
+{
+    const ReadPixelsParams &params = GetParam();
+
+    if (!params.readFromWindow)
+    {
+        glGenRenderbuffers(1, &mRenderbuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, mRenderbuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, params.windowWidth, params.windowHeight);
+
+        glGenFramebuffers(1, &mFramebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffer);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER,
+                                  mRenderbuffer);
+        ASSERT_GLENUM_EQ(GL_FRAMEBUFFER_COMPLETE, glCheckFramebufferStatus(GL_FRAMEBUFFER));
+    }
+
+    if (params.destination == ReadDestination::PackBuffer)
+    {
+        glGenBuffers(kPackBufferCount, mPackBuffers.data());
+        for (GLuint packBuffer : mPackBuffers)
+        {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, packBuffer);
+            glBufferData(GL_PIXEL_PACK_BUFFER, getPixelsSize(), nullptr, GL_STREAM_READ);
+        }
+    }
+    else
+    {
+        mClientPixels.resize(getPixelsSize());
+    }
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+    ASSERT_GL_NO_ERROR();
+}
+
+void ReadPixelsBenchmark::destroyBenchmark()
+{
+    for (GLsync fence : mPackFences)
+    {
+        glDeleteSync(fence);
+    }
+    glDeleteBuffers(kPackBufferCount, mPackBuffers.data());
+    glDeleteFramebuffers(1, &mFramebuffer);
+    glDeleteRenderbuffers(1, &mRenderbuffer);
+}
+
+void ReadPixelsBenchmark::drawBenchmark()
+{
+    const ReadPixelsParams &params = GetParam();
+
+    // Change the contents every frame so the read can't be skipped.
+    float shade = static_cast<float>(mFrameIndex % 256) / 255.0f;
+    glClearColor(shade, 1.0f - shade, 0.5f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    if (params.destination == ReadDestination::PackBuffer)
+    {
+        size_t readIndex = mFrameIndex % kPackBufferCount;
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, mPackBuffers[readIndex]);
+        glReadPixels(0, 0, params.windowWidth, params.windowHeight, GL_RGBA, GL_UNSIGNED_BYTE,
+                     nullptr);
+        ASSERT_EQ(nullptr, mPackFences[readIndex]);
+        mPackFences[readIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        // Consume the read made kPackBufferCount - 1 frames ago.  The swaps since then submitted
+        // it, so the fence has normally signaled and neither the wait nor the map stalls.
+        size_t mapIndex = (mFrameIndex + 1) % kPackBufferCount;
+        if (mPackFences[mapIndex])
+        {
+            glClientWaitSync(mPackFences[mapIndex], GL_SYNC_FLUSH_COMMANDS_BIT, kFenceTimeoutNs);
+            glDeleteSync(mPackFences[mapIndex]);
+            mPackFences[mapIndex] = nullptr;
+
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, mPackBuffers[mapIndex]);
+            void *mapped =
+                glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, getPixelsSize(), GL_MAP_READ_BIT);
+            ASSERT_NE(nullptr, mapped);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+    }
+    else
+    {
+        glReadPixels(0, 0, params.windowWidth, params.windowHeight, GL_RGBA, GL_UNSIGNED_BYTE,
+                     mClientPixels.data());
+    }
+
+    ++mFrameIndex;
+
+    ASSERT_GL_NO_ERROR();
+}
+
+ReadPixelsParams D3D11Params(ReadDestination destination, bool readFromWindow)
+{
+    ReadPixelsParams params;
+    params.eglParameters  = egl_platform::D3D11();
+    params.destination    = destination;
+    params.readFromWindow = readFromWindow;
+    return params;
+}
+
+ReadPixelsParams OpenGLOrGLESParams(ReadDestination destination, bool readFromWindow)
+{
+    ReadPixelsParams params;
+    params.eglParameters  = egl_platform::OPENGL_OR_GLES();
+    params.destination    = destination;
+    params.readFromWindow = readFromWindow;
+    return params;
+}
+
+ReadPixelsParams VulkanParams(ReadDestination destination, bool readFromWindow)
+{
+    ReadPixelsParams params;
+    params.eglParameters  = egl_platform::VULKAN();
+    params.destination    = destination;
+    params.readFromWindow = readFromWindow;
+    return params;
+}
+}  // anonymous namespace
+
+TEST_P(ReadPixelsBenchmark, Run)
+{
+    run();
+}
+
+ANGLE_INSTANTIATE_TEST(ReadPixelsBenchmark,
+                       D3D11Params(ReadDestination::ClientMemory, false),
+                       D3D11Params(ReadDestination::PackBuffer, false),
+                       OpenGLOrGLESParams(ReadDestination::ClientMemory, false),
+                       OpenGLOrGLESParams(ReadDestination::PackBuffer, false),
+                       VulkanParams(ReadDestination::ClientMemory, false),
+                       VulkanParams(ReadDestination::PackBuffer, false),
+                       VulkanParams(ReadDestination::ClientMemory, true),
+                       VulkanParams(ReadDestination::PackBuffer, true));
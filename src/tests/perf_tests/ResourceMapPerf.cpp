@@ -0,0 +1,150 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ResourceMapPerf:
+//   Performance test for looking objects up in ResourceMap, the way binding calls on the draw path
+//   do, for different numbers and layouts of handles.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <sstream>
+
+#include "libANGLE/ResourceMap.h"
+
+namespace
+{
+constexpr unsigned int kIterationsPerStep = 100;
+constexpr size_t kLookupCount             = 4096;
+
+enum class HandleLayout
+{
+    // Handles 1 to N, as HandleAllocator gives them out.
+    Dense,
+    // Handles spread over the first 16M values, as an external allocator could give them out.
+    Sparse,
+    // Handles above 2G.
+    Huge,
+};
+
+struct ResourceMapParams
+{
+    size_t handleCount;
+    HandleLayout layout;
+};
+
+std::ostream &operator<<(std::ostream &os, const ResourceMapParams &params)
+{
+    os << "_" << params.handleCount;
+    switch (params.layout)
+    {
+        case HandleLayout::Dense:
+            os << "_dense";
+            break;
+        case HandleLayout::Sparse:
+            os << "_sparse";
+            break;
+        case HandleLayout::Huge:
+            os << "_huge";
+            break;
+    }
+    return os;
+}
+
+std::string GetStory(const ResourceMapParams &params)
+{
+    std::stringstream storyStr;
+    storyStr << params;
+    return storyStr.str();
+}
+
+GLuint GetHandle(const ResourceMapParams &params, size_t index)
+{
+    switch (params.layout)
+    {
+        case HandleLayout::Dense:
+            return static_cast<GLuint>(index + 1);
+        case HandleLayout::Sparse:
+            return static_cast<GLuint>((index * 2654435761u) % 0x1000000 + 1);
+        case HandleLayout::Huge:
+            return static_cast<GLuint>(0x80000000u + index * 7);
+    }
+    return 0;
+}
+
+class ResourceMapPerfTest : public ANGLEPerfTest,
+                            public ::testing::WithParamInterface<ResourceMapParams>
+{
+  public:
+    ResourceMapPerfTest();
+
+    void SetUp() override;
+    void TearDown() override;
+    void step() override;
+
+  private:
+    gl::ResourceMap<size_t, GLuint> mResourceMap;
+    std::vector<size_t> mObjects;
+    std::vector<GLuint> mLookups;
+    size_t mFoundCount = 0;
+};
+
+ResourceMapPerfTest::ResourceMapPerfTest()
+    : ANGLEPerfTest("ResourceMapPerf", "", GetStory(GetParam()), kIterationsPerStep)
+{}
+
+void ResourceMapPerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    const ResourceMapParams &params = GetParam();
+
+    mObjects.resize(params.handleCount);
+    for (size_t index = 0; index < params.handleCount; ++index)
+    {
+        mResourceMap.assign(GetHandle(params, index), &mObjects[index]);
+    }
+
+    // Look the objects up in a scattered order, the way draw calls bind them.
+    for (size_t lookup = 0; lookup < kLookupCount; ++lookup)
+    {
+        mLookups.push_back(GetHandle(params, (lookup * 7919) % params.handleCount));
+    }
+}
+
+void ResourceMapPerfTest::TearDown()
+{
+    ASSERT(mFoundCount > 0);
+    mResourceMap.clear();
+
+    ANGLEPerfTest::TearDown();
+}
+
+void ResourceMapPerfTest::step()
+{
+    for (unsigned int iteration = 0; iteration < kIterationsPerStep; ++iteration)
+    {
+        for (GLuint handle : mLookups)
+        {
+            if (mResourceMap.query(handle) != nullptr)
+            {
+                mFoundCount++;
+            }
+        }
+    }
+}
+
+TEST_P(ResourceMapPerfTest, Run)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         ResourceMapPerfTest,
+                         ::testing::Values(ResourceMapParams{1024, HandleLayout::Dense},
+                                           ResourceMapParams{65536, HandleLayout::Dense},
+                                           ResourceMapParams{4096, HandleLayout::Sparse},
+                                           ResourceMapParams{4096, HandleLayout::Huge}));
+}  // anonymous namespace
@@ -16,6 +16,7 @@
 #include "util/egl_loader_autogen.h"
 #include "util/frame_capture_test_utils.h"
 #include "util/png_utils.h"
+#include "util/trace_interpreter.h"
 
 #include "restricted_traces/restricted_traces_autogen.h"
 
@@ -114,6 +115,10 @@ class TracePerfTest : public ANGLERenderTest, public ::testing::WithParamInterfa
     void saveScreenshot(const std::string &screenshotName) override;
     void swap();
 
+    void setupReplay();
+    void replayFrame(uint32_t frameIndex);
+    void resetReplay();
+
     // For tracking RenderPass/FBO change timing.
     QueryInfo mCurrentQuery = {};
     std::vector<QueryInfo> mRunningQueries;
@@ -131,6 +136,10 @@ class TracePerfTest : public ANGLERenderTest, public ::testing::WithParamInterfa
     uint32_t mCurrentFrame         = 0;
     uint32_t mOffscreenFrameCount  = 0;
     bool mScreenshotSaved          = false;
+
+    // Set when replaying binary call streams with --use-binary-traces.
+    std::string mBinaryTraceIndexPath;
+    std::unique_ptr<TraceInterpreter> mInterpreter;
 };
 
 class TracePerfTest;
@@ -207,6 +216,57 @@ angle::GenericProc KHRONOS_APIENTRY TraceLoadProc(const char *procName)
     return gCurrentTracePerfTest->getGLWindow()->getProcAddress(procName);
 }
 
+// Returns the path of the binary trace index, or an empty string if the trace wasn't captured with
+// ANGLE_CAPTURE_FORMAT=binary.
+std::string FindBinaryTraceIndex(const TraceInfo &traceInfo)
+{
+    std::stringstream testDataDirStr;
+    if (!IsAndroid())
+    {
+        // The working directory is only moved to the executable directory at initialization.
+        testDataDirStr << angle::GetExecutableDirectory() << GetPathSeparator();
+    }
+    testDataDirStr << ANGLE_TRACE_DATA_DIR << GetPathSeparator() << traceInfo.name;
+
+    // The restricted trace list doesn't record which context was captured, so probe for it.
+    constexpr uint32_t kMaxCaptureContext = 8;
+    for (uint32_t contextID = 1; contextID <= kMaxCaptureContext; ++contextID)
+    {
+        std::stringstream indexPathStr;
+        indexPathStr << testDataDirStr.str() << GetPathSeparator() << traceInfo.name
+                     << "_capture_context" << contextID << kBinaryTraceIndexExtension;
+
+        FILE *fp = fopen(indexPathStr.str().c_str(), "rb");
+        if (fp)
+        {
+            fclose(fp);
+            return indexPathStr.str();
+        }
+    }
+
+    return "";
+}
+
+// Returns the binary trace index given with --binary-trace, or the one captured for the trace.
+std::string GetBinaryTraceIndex(const TraceInfo &traceInfo)
+{
+    if (!gBinaryTracePath)
+    {
+        return FindBinaryTraceIndex(traceInfo);
+    }
+
+    // Relative paths are resolved against the launch directory, as the working directory is moved
+    // at initialization.
+    std::string indexPath = gBinaryTracePath;
+    bool isAbsolute       = !indexPath.empty() && (indexPath[0] == '/' || indexPath[0] == '\\' ||
+                                             (indexPath.size() > 1 && indexPath[1] == ':'));
+    if (!isAbsolute)
+    {
+        indexPath = angle::GetCWD().value() + GetPathSeparator() + indexPath;
+    }
+    return indexPath;
+}
+
 TracePerfTest::TracePerfTest()
     : ANGLERenderTest("TracePerf", GetParam(), "ms"), mStartFrame(0), mEndFrame(0)
 {
@@ -283,6 +343,16 @@ TracePerfTest::TracePerfTest()
         addExtensionPrerequisite("GL_EXT_shadow_samplers");
     }
 
+    if (gUseBinaryTraces)
+    {
+        mBinaryTraceIndexPath = GetBinaryTraceIndex(GetTraceInfo(param.testID));
+        if (mBinaryTraceIndexPath.empty())
+        {
+            printf("Test skipped. No binary capture found for this trace.\n");
+            mSkipTest = true;
+        }
+    }
+
     // We already swap in TracePerfTest::drawBenchmark, no need to swap again in the harness.
     disableTestHarnessSwap();
 
@@ -314,6 +384,16 @@ void TracePerfTest::initializeBenchmark()
     std::string testDataDir = testDataDirStr.str();
     SetBinaryDataDir(params.testID, testDataDir.c_str());
 
+    if (gUseBinaryTraces)
+    {
+        // Potentially slow. Decodes every frame up front.
+        mInterpreter.reset(new TraceInterpreter());
+        ASSERT_TRUE(
+            mInterpreter->load(mBinaryTraceIndexPath, TraceLoadProc, DecompressBinaryData));
+        mStartFrame = mInterpreter->getFrameStart();
+        mEndFrame   = mInterpreter->getFrameEnd();
+    }
+
     mWindowWidth  = mTestParams.windowWidth;
     mWindowHeight = mTestParams.windowHeight;
     mCurrentFrame = mStartFrame;
@@ -357,7 +437,7 @@ void TracePerfTest::initializeBenchmark()
     }
 
     // Potentially slow. Can load a lot of resources.
-    SetupReplay(params.testID);
+    setupReplay();
 
     glFinish();
 
@@ -401,6 +481,42 @@ void TracePerfTest::destroyBenchmark()
     angle::SetCWD(mStartingDirectory.c_str());
 }
 
+void TracePerfTest::setupReplay()
+{
+    if (mInterpreter)
+    {
+        mInterpreter->setupReplay();
+    }
+    else
+    {
+        SetupReplay(GetParam().testID);
+    }
+}
+
+void TracePerfTest::replayFrame(uint32_t frameIndex)
+{
+    if (mInterpreter)
+    {
+        mInterpreter->replayFrame(frameIndex);
+    }
+    else
+    {
+        ReplayFrame(GetParam().testID, frameIndex);
+    }
+}
+
+void TracePerfTest::resetReplay()
+{
+    if (mInterpreter)
+    {
+        mInterpreter->resetReplay();
+    }
+    else
+    {
+        ResetReplay(GetParam().testID);
+    }
+}
+
 void TracePerfTest::sampleTime()
 {
     if (mUseTimestampQueries)
@@ -451,7 +567,7 @@ void TracePerfTest::drawBenchmark()
     beginInternalTraceEvent(frameName);
 
     startGpuTimer();
-    ReplayFrame(params.testID, mCurrentFrame);
+    replayFrame(mCurrentFrame);
     stopGpuTimer();
 
     if (params.surfaceType == SurfaceType::Offscreen)
@@ -514,7 +630,7 @@ void TracePerfTest::drawBenchmark()
 
     if (mCurrentFrame == mEndFrame)
     {
-        ResetReplay(params.testID);
+        resetReplay();
         mCurrentFrame = mStartFrame;
     }
     else
@@ -29,6 +29,8 @@ enum DataMode
 {
     UPDATE,
     REPEAT,
+    // Only one of the uniforms changes each frame.
+    UPDATE_ONE,
 };
 
 // TODO(jmadill): Use an ANGLE enum for this?
@@ -120,6 +122,15 @@ std::string UniformsParams::story() const
     {
         strstr << "_repeating";
     }
+    else if (dataMode == DataMode::UPDATE_ONE)
+    {
+        strstr << "_update_one";
+    }
+
+    if (eglParameters.defaultUniformPushConstantsFeatureVulkan == EGL_TRUE)
+    {
+        strstr << "_push_constants";
+    }
 
     return strstr.str();
 }
@@ -398,6 +409,12 @@ void UniformsBenchmark::drawLoop(const SetUniformFunc &setUniformsFunc)
                 setUniformsFunc(mUniformLocations, mMatrixData, uniform, frameIndex);
             }
         }
+        else if (params.dataMode == DataMode::UPDATE_ONE)
+        {
+            // Each uniform is set for two consecutive frames, flipping between the two data sets.
+            size_t uniform = (it / 2) % mUniformLocations.size();
+            setUniformsFunc(mUniformLocations, mMatrixData, uniform, frameIndex);
+        }
         glDrawArrays(GL_TRIANGLES, 0, 3);
     }
 }
@@ -447,7 +464,8 @@ void UniformsBenchmark::drawBenchmark()
         {
             auto setFunc = [](const std::vector<GLuint> &locations, const MatrixData &matrixData,
                               size_t uniform, size_t frameIndex) {
-                float value = static_cast<float>(uniform);
+                // Vary the value with the frame, so each call actually changes the uniform.
+                float value = static_cast<float>(uniform + frameIndex);
                 glUniform4f(locations[uniform], value, value, value, value);
             };
 
@@ -481,6 +499,28 @@ UniformsParams VectorUniforms(const EGLPlatformParameters &egl,
     return params;
 }
 
+// Few enough uniforms for the Vulkan back-end to deliver them as push constants, which is the
+// common case for simple programs.
+UniformsParams SmallVectorUniforms(const EGLPlatformParameters &egl,
+                                   DataMode dataMode,
+                                   ProgramMode programMode = ProgramMode::SINGLE)
+{
+    UniformsParams params      = VectorUniforms(egl, dataMode, programMode);
+    params.numVertexUniforms   = 4;
+    params.numFragmentUniforms = 4;
+    return params;
+}
+
+// Same as SmallVectorUniforms, with the Vulkan back-end delivering them as push constants.
+UniformsParams PushConstantVectorUniforms(const EGLPlatformParameters &egl,
+                                          DataMode dataMode,
+                                          ProgramMode programMode = ProgramMode::SINGLE)
+{
+    UniformsParams params = SmallVectorUniforms(egl, dataMode, programMode);
+    params.eglParameters.defaultUniformPushConstantsFeatureVulkan = EGL_TRUE;
+    return params;
+}
+
 UniformsParams MatrixUniforms(const EGLPlatformParameters &egl,
                               DataMode dataMode,
                               DataType dataType,
@@ -529,4 +569,17 @@ ANGLE_INSTANTIATE_TEST(
     MatrixUniforms(VULKAN(), DataMode::REPEAT, DataType::MAT4x4, MatrixLayout::NO_TRANSPOSE),
     MatrixUniforms(VULKAN(), DataMode::UPDATE, DataType::MAT3x3, MatrixLayout::NO_TRANSPOSE),
     MatrixUniforms(VULKAN(), DataMode::REPEAT, DataType::MAT3x3, MatrixLayout::NO_TRANSPOSE),
-    VectorUniforms(D3D11_NULL(), DataMode::REPEAT, ProgramMode::MULTIPLE));
+    VectorUniforms(D3D11_NULL(), DataMode::REPEAT, ProgramMode::MULTIPLE),
+    SmallVectorUniforms(VULKAN(), DataMode::UPDATE),
+    SmallVectorUniforms(VULKAN(), DataMode::UPDATE, ProgramMode::MULTIPLE),
+    SmallVectorUniforms(VULKAN_NULL(), DataMode::UPDATE),
+    SmallVectorUniforms(VULKAN_NULL(), DataMode::UPDATE, ProgramMode::MULTIPLE),
+    VectorUniforms(VULKAN(), DataMode::UPDATE_ONE),
+    VectorUniforms(VULKAN_NULL(), DataMode::UPDATE_ONE),
+    SmallVectorUniforms(VULKAN(), DataMode::UPDATE_ONE),
+    PushConstantVectorUniforms(VULKAN(), DataMode::UPDATE),
+    PushConstantVectorUniforms(VULKAN(), DataMode::UPDATE, ProgramMode::MULTIPLE),
+    PushConstantVectorUniforms(VULKAN_NULL(), DataMode::UPDATE),
+    PushConstantVectorUniforms(VULKAN_NULL(), DataMode::UPDATE, ProgramMode::MULTIPLE),
+    PushConstantVectorUniforms(VULKAN(), DataMode::UPDATE_ONE),
+    MatrixUniforms(VULKAN(), DataMode::UPDATE_ONE, DataType::MAT4x4, MatrixLayout::NO_TRANSPOSE));
@@ -0,0 +1,109 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// VertexConversionPerf:
+//   Performance test for the CPU conversion of vertex formats that are emulated, the way the
+//   backends convert the vertex buffers of large meshes.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include "angle_gl.h"
+#include "libANGLE/renderer/copyvertex.h"
+
+namespace
+{
+constexpr unsigned int kIterationsPerStep = 10;
+constexpr size_t kVertexCount             = 256 * 1024;
+
+struct VertexConversionParams
+{
+    const char *name;
+    rx::VertexCopyFunction copyFunction;
+    size_t inputStride;
+    size_t outputSize;
+};
+
+std::ostream &operator<<(std::ostream &os, const VertexConversionParams &params)
+{
+    os << "_" << params.name;
+    return os;
+}
+
+class VertexConversionPerfTest : public ANGLEPerfTest,
+                                 public ::testing::WithParamInterface<VertexConversionParams>
+{
+  public:
+    VertexConversionPerfTest();
+
+    void SetUp() override;
+    void step() override;
+
+  private:
+    std::vector<uint8_t> mInput;
+    std::vector<uint8_t> mOutput;
+};
+
+VertexConversionPerfTest::VertexConversionPerfTest()
+    : ANGLEPerfTest("VertexConversionPerf",
+                    "",
+                    std::string("_") + GetParam().name,
+                    kIterationsPerStep)
+{}
+
+void VertexConversionPerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    const VertexConversionParams &params = GetParam();
+
+    mInput.resize(kVertexCount * params.inputStride);
+    for (size_t index = 0; index < mInput.size(); ++index)
+    {
+        mInput[index] = static_cast<uint8_t>(index * 37);
+    }
+    mOutput.resize(kVertexCount * params.outputSize);
+}
+
+void VertexConversionPerfTest::step()
+{
+    const VertexConversionParams &params = GetParam();
+
+    for (unsigned int iteration = 0; iteration < kIterationsPerStep; ++iteration)
+    {
+        params.copyFunction(mInput.data(), params.inputStride, kVertexCount, mOutput.data());
+    }
+}
+
+TEST_P(VertexConversionPerfTest, Run)
+{
+    run();
+}
+
+// Formats that are converted when they are not supported natively, and the interleaved buffers
+// they are often found in.
+INSTANTIATE_TEST_SUITE_P(
+    ,
+    VertexConversionPerfTest,
+    ::testing::Values(
+        VertexConversionParams{"byte3_norm", rx::CopyTo32FVertexData<GLbyte, 3, 3, true>, 3, 12},
+        VertexConversionParams{"ubyte3_norm", rx::CopyTo32FVertexData<GLubyte, 3, 3, true>, 3,
+                               12},
+        VertexConversionParams{"ubyte4", rx::CopyTo32FVertexData<GLubyte, 4, 4, false>, 4, 16},
+        VertexConversionParams{"short3_norm", rx::CopyTo32FVertexData<GLshort, 3, 3, true>, 6,
+                               12},
+        VertexConversionParams{"ushort2", rx::CopyTo32FVertexData<GLushort, 2, 2, false>, 4, 8},
+        VertexConversionParams{"ushort4_norm_interleaved",
+                               rx::CopyTo32FVertexData<GLushort, 4, 4, true>, 32, 16},
+        VertexConversionParams{"int3_norm", rx::CopyTo32FVertexData<GLint, 3, 3, true>, 12, 12},
+        VertexConversionParams{"rgb10a2_snorm",
+                               rx::CopyXYZ10W2ToXYZW32FVertexData<true, true, true>, 4, 16},
+        VertexConversionParams{"rgb10a2_uint",
+                               rx::CopyXYZ10W2ToXYZW32FVertexData<false, false, true>, 4, 16},
+        VertexConversionParams{"rgb10_snorm", rx::CopyXYZ10ToXYZW32FVertexData<true, true>, 4,
+                               16},
+        VertexConversionParams{"a2bgr10_unorm_interleaved",
+                               rx::CopyW2XYZ10ToXYZW32FVertexData<false, true>, 24, 16}));
+}  // anonymous namespace
@@ -239,6 +239,31 @@ std::ostream &operator<<(std::ostream &stream, const PlatformParameters &pp)
         stream << "_AsyncQueue";
     }
 
+    if (pp.eglParameters.forceCPUGenerateMipmapFeatureVulkan == EGL_TRUE)
+    {
+        stream << "_CPUGenerateMipmap";
+    }
+
+    if (pp.eglParameters.asyncPipelineOptimizationFeatureVulkan == EGL_TRUE)
+    {
+        stream << "_AsyncPipelineOptimization";
+    }
+
+    if (pp.eglParameters.prespecializePipelinesFeatureVulkan == EGL_TRUE)
+    {
+        stream << "_PrespecializeGraphicsPipelines";
+    }
+
+    if (pp.eglParameters.optimizeSpirvFeatureVulkan == EGL_TRUE)
+    {
+        stream << "_OptimizeSpirv";
+    }
+
+    if (pp.eglParameters.defaultUniformPushConstantsFeatureVulkan == EGL_TRUE)
+    {
+        stream << "_DefaultUniformPushConstants";
+    }
+
     if (pp.eglParameters.hasExplicitMemBarrierFeatureMtl == EGL_FALSE)
     {
         stream << "_NoMetalExplicitMemoryBarrier";
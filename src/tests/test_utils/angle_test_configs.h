@@ -281,6 +281,44 @@ inline PlatformParameters WithAsyncCommandQueueFeatureVulkan(const PlatformParam
     withAsyncCommandQueue.eglParameters.asyncCommandQueueFeatureVulkan = EGL_TRUE;
     return withAsyncCommandQueue;
 }
+
+inline PlatformParameters WithCPUGenerateMipmapFeatureVulkan(const PlatformParameters &params)
+{
+    PlatformParameters withCPUGenerateMipmap                                = params;
+    withCPUGenerateMipmap.eglParameters.forceCPUGenerateMipmapFeatureVulkan = EGL_TRUE;
+    return withCPUGenerateMipmap;
+}
+
+inline PlatformParameters WithAsyncPipelineOptimizationFeatureVulkan(
+    const PlatformParameters &params)
+{
+    PlatformParameters withAsyncPipelineOptimization                                   = params;
+    withAsyncPipelineOptimization.eglParameters.asyncPipelineOptimizationFeatureVulkan = EGL_TRUE;
+    return withAsyncPipelineOptimization;
+}
+
+inline PlatformParameters WithPrespecializeGraphicsPipelinesFeatureVulkan(
+    const PlatformParameters &params)
+{
+    PlatformParameters withPrespecialize                                = params;
+    withPrespecialize.eglParameters.prespecializePipelinesFeatureVulkan = EGL_TRUE;
+    return withPrespecialize;
+}
+
+inline PlatformParameters WithOptimizeSpirvFeatureVulkan(const PlatformParameters &params)
+{
+    PlatformParameters withOptimizeSpirv                       = params;
+    withOptimizeSpirv.eglParameters.optimizeSpirvFeatureVulkan = EGL_TRUE;
+    return withOptimizeSpirv;
+}
+
+inline PlatformParameters WithDefaultUniformPushConstantsFeatureVulkan(
+    const PlatformParameters &params)
+{
+    PlatformParameters withPushConstants                                     = params;
+    withPushConstants.eglParameters.defaultUniformPushConstantsFeatureVulkan = EGL_TRUE;
+    return withPushConstants;
+}
 }  // namespace angle
 
 #endif  // ANGLE_TEST_CONFIGS_H_
@@ -63,29 +63,37 @@ struct EGLPlatformParameters
                         allocateNonZeroMemoryFeature, emulateCopyTexImage2DFromRenderbuffers,
                         shaderStencilOutputFeature, genMultipleMipsPerPassFeature, platformMethods,
                         robustness, emulatedPrerotation, asyncCommandQueueFeatureVulkan,
-                        hasExplicitMemBarrierFeatureMtl, hasCheapRenderPassFeatureMtl,
-                        forceBufferGPUStorageFeatureMtl);
+                        forceCPUGenerateMipmapFeatureVulkan,
+                        asyncPipelineOptimizationFeatureVulkan,
+                        prespecializePipelinesFeatureVulkan, optimizeSpirvFeatureVulkan,
+                        defaultUniformPushConstantsFeatureVulkan, hasExplicitMemBarrierFeatureMtl,
+                        hasCheapRenderPassFeatureMtl, forceBufferGPUStorageFeatureMtl);
     }
 
-    EGLint renderer                               = EGL_PLATFORM_ANGLE_TYPE_DEFAULT_ANGLE;
-    EGLint majorVersion                           = EGL_DONT_CARE;
-    EGLint minorVersion                           = EGL_DONT_CARE;
-    EGLint deviceType                             = EGL_PLATFORM_ANGLE_DEVICE_TYPE_HARDWARE_ANGLE;
-    EGLint presentPath                            = EGL_DONT_CARE;
-    EGLint debugLayersEnabled                     = EGL_DONT_CARE;
-    EGLint contextVirtualization                  = EGL_DONT_CARE;
-    EGLint robustness                             = EGL_DONT_CARE;
-    EGLint transformFeedbackFeature               = EGL_DONT_CARE;
-    EGLint allocateNonZeroMemoryFeature           = EGL_DONT_CARE;
-    EGLint emulateCopyTexImage2DFromRenderbuffers = EGL_DONT_CARE;
-    EGLint shaderStencilOutputFeature             = EGL_DONT_CARE;
-    EGLint genMultipleMipsPerPassFeature          = EGL_DONT_CARE;
-    uint32_t emulatedPrerotation                  = 0;  // Can be 0, 90, 180 or 270
-    EGLint asyncCommandQueueFeatureVulkan         = EGL_DONT_CARE;
-    EGLint hasExplicitMemBarrierFeatureMtl        = EGL_DONT_CARE;
-    EGLint hasCheapRenderPassFeatureMtl           = EGL_DONT_CARE;
-    EGLint forceBufferGPUStorageFeatureMtl        = EGL_DONT_CARE;
-    angle::PlatformMethods *platformMethods       = nullptr;
+    EGLint renderer                                 = EGL_PLATFORM_ANGLE_TYPE_DEFAULT_ANGLE;
+    EGLint majorVersion                             = EGL_DONT_CARE;
+    EGLint minorVersion                             = EGL_DONT_CARE;
+    EGLint deviceType                               = EGL_PLATFORM_ANGLE_DEVICE_TYPE_HARDWARE_ANGLE;
+    EGLint presentPath                              = EGL_DONT_CARE;
+    EGLint debugLayersEnabled                       = EGL_DONT_CARE;
+    EGLint contextVirtualization                    = EGL_DONT_CARE;
+    EGLint robustness                               = EGL_DONT_CARE;
+    EGLint transformFeedbackFeature                 = EGL_DONT_CARE;
+    EGLint allocateNonZeroMemoryFeature             = EGL_DONT_CARE;
+    EGLint emulateCopyTexImage2DFromRenderbuffers   = EGL_DONT_CARE;
+    EGLint shaderStencilOutputFeature               = EGL_DONT_CARE;
+    EGLint genMultipleMipsPerPassFeature            = EGL_DONT_CARE;
+    uint32_t emulatedPrerotation                    = 0;  // Can be 0, 90, 180 or 270
+    EGLint asyncCommandQueueFeatureVulkan           = EGL_DONT_CARE;
+    EGLint forceCPUGenerateMipmapFeatureVulkan      = EGL_DONT_CARE;
+    EGLint asyncPipelineOptimizationFeatureVulkan   = EGL_DONT_CARE;
+    EGLint prespecializePipelinesFeatureVulkan      = EGL_DONT_CARE;
+    EGLint optimizeSpirvFeatureVulkan               = EGL_DONT_CARE;
+    EGLint defaultUniformPushConstantsFeatureVulkan = EGL_DONT_CARE;
+    EGLint hasExplicitMemBarrierFeatureMtl          = EGL_DONT_CARE;
+    EGLint hasCheapRenderPassFeatureMtl             = EGL_DONT_CARE;
+    EGLint forceBufferGPUStorageFeatureMtl          = EGL_DONT_CARE;
+    angle::PlatformMethods *platformMethods         = nullptr;
 };
 
 inline bool operator<(const EGLPlatformParameters &a, const EGLPlatformParameters &b)
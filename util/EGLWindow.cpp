@@ -228,6 +228,31 @@ bool EGLWindow::initializeDisplay(OSWindow *osWindow,
         enabledFeatureOverrides.push_back("asynchronousCommandProcessing");
     }
 
+    if (params.forceCPUGenerateMipmapFeatureVulkan == EGL_TRUE)
+    {
+        enabledFeatureOverrides.push_back("forceCPUPathForGenerateMipmap");
+    }
+
+    if (params.asyncPipelineOptimizationFeatureVulkan == EGL_TRUE)
+    {
+        enabledFeatureOverrides.push_back("asyncGraphicsPipelineOptimization");
+    }
+
+    if (params.prespecializePipelinesFeatureVulkan == EGL_TRUE)
+    {
+        enabledFeatureOverrides.push_back("prespecializeGraphicsPipelines");
+    }
+
+    if (params.optimizeSpirvFeatureVulkan == EGL_TRUE)
+    {
+        enabledFeatureOverrides.push_back("optimizeSpirv");
+    }
+
+    if (params.defaultUniformPushConstantsFeatureVulkan == EGL_TRUE)
+    {
+        enabledFeatureOverrides.push_back("useDefaultUniformPushConstants");
+    }
+
     if (params.hasExplicitMemBarrierFeatureMtl == EGL_FALSE)
     {
         disabledFeatureOverrides.push_back("has_explicit_mem_barrier_mtl");
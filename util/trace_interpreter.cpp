@@ -0,0 +1,525 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// trace_interpreter.cpp:
+//   Implements the binary call stream interpreter.
+//
+
+#include "util/trace_interpreter.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+
+namespace angle
+{
+namespace
+{
+bool ReadWholeFile(const std::string &path, std::vector<uint8_t> *contentsOut)
+{
+    FILE *fp = fopen(path.c_str(), "rb");
+    if (!fp)
+    {
+        return false;
+    }
+
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    bool success = size >= 0;
+    if (success)
+    {
+        contentsOut->resize(static_cast<size_t>(size));
+        success = fread(contentsOut->data(), 1, contentsOut->size(), fp) == contentsOut->size();
+    }
+
+    fclose(fp);
+    return success;
+}
+
+std::string GetStreamPath(const std::string &prefix, uint32_t frameIndex, bool compressed)
+{
+    std::stringstream pathStream;
+    pathStream << prefix << "_frame" << std::setfill('0') << std::setw(3) << frameIndex
+               << kBinaryTraceStreamExtension;
+    if (compressed)
+    {
+        pathStream << ".gz";
+    }
+    return pathStream.str();
+}
+}  // anonymous namespace
+
+TraceInterpreter::Stream::Stream() : params(nullptr), sections{} {}
+
+TraceInterpreter::Stream::~Stream() = default;
+
+TraceInterpreter::Stream::Stream(Stream &&other) = default;
+
+TraceInterpreter::TraceInterpreter()
+    : mIndex{}, mGetUniformLocation(nullptr), mCurrentProgram(0)
+{}
+
+TraceInterpreter::~TraceInterpreter() = default;
+
+bool TraceInterpreter::load(const std::string &indexPath,
+                            LoadProc loadProc,
+                            DecompressCallback decompress)
+{
+    std::vector<uint8_t> indexData;
+    if (!ReadWholeFile(indexPath, &indexData) || indexData.size() != sizeof(BinaryTraceIndex))
+    {
+        fprintf(stderr, "Could not read trace index: %s\n", indexPath.c_str());
+        return false;
+    }
+
+    memcpy(&mIndex, indexData.data(), sizeof(BinaryTraceIndex));
+    if (mIndex.magic != kBinaryTraceIndexMagic || mIndex.version != kBinaryTraceVersion ||
+        mIndex.frameStart == 0 || mIndex.frameEnd < mIndex.frameStart)
+    {
+        fprintf(stderr, "Invalid trace index: %s\n", indexPath.c_str());
+        return false;
+    }
+
+    if (mIndex.compressed && !decompress)
+    {
+        fprintf(stderr, "Trace is compressed but no decompress callback was given.\n");
+        return false;
+    }
+
+    mGetUniformLocation =
+        reinterpret_cast<PFNGLGETUNIFORMLOCATIONPROC>(loadProc("glGetUniformLocation"));
+    if (!mGetUniformLocation)
+    {
+        fprintf(stderr, "Could not load glGetUniformLocation.\n");
+        return false;
+    }
+
+    std::string prefix = indexPath.substr(0, indexPath.rfind(kBinaryTraceIndexExtension));
+    for (uint32_t frameIndex = mIndex.frameStart; frameIndex <= mIndex.frameEnd; ++frameIndex)
+    {
+        std::string streamPath = GetStreamPath(prefix, frameIndex, mIndex.compressed != 0);
+        if (!loadStream(streamPath, loadProc, decompress))
+        {
+            mStreams.clear();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool TraceInterpreter::loadStream(const std::string &streamPath,
+                                  LoadProc loadProc,
+                                  DecompressCallback decompress)
+{
+    std::vector<uint8_t> fileData;
+    if (!ReadWholeFile(streamPath, &fileData))
+    {
+        fprintf(stderr, "Could not read call stream: %s\n", streamPath.c_str());
+        return false;
+    }
+
+    Stream stream;
+    size_t streamSize = fileData.size();
+    if (mIndex.compressed)
+    {
+        stream.storage.reset(decompress(fileData));
+        if (!stream.storage)
+        {
+            fprintf(stderr, "Could not decompress call stream: %s\n", streamPath.c_str());
+            return false;
+        }
+        // The header records the size of the uncompressed stream.
+        streamSize = static_cast<size_t>(
+            reinterpret_cast<const BinaryTraceHeader *>(stream.storage.get())->totalSize);
+    }
+    else
+    {
+        stream.storage.reset(new uint8_t[streamSize]);
+        memcpy(stream.storage.get(), fileData.data(), streamSize);
+    }
+
+    uint8_t *base = stream.storage.get();
+    BinaryTraceHeader header;
+    if (streamSize < sizeof(header))
+    {
+        fprintf(stderr, "Truncated call stream: %s\n", streamPath.c_str());
+        return false;
+    }
+    memcpy(&header, base, sizeof(header));
+
+    size_t namesOffset  = sizeof(BinaryTraceHeader);
+    size_t callsOffset  = namesOffset + header.functionCount * sizeof(uint64_t);
+    size_t paramsOffset = callsOffset + header.callCount * sizeof(BinaryTraceCall);
+    size_t dataOffset   = paramsOffset + header.paramCount * sizeof(BinaryTraceParam);
+    dataOffset = (dataOffset + kBinaryTraceDataAlignment - 1) & ~(kBinaryTraceDataAlignment - 1);
+
+    if (header.magic != kBinaryTraceStreamMagic || header.version != kBinaryTraceVersion ||
+        header.totalSize != streamSize || dataOffset + header.dataSize != streamSize)
+    {
+        fprintf(stderr, "Invalid call stream: %s\n", streamPath.c_str());
+        return false;
+    }
+
+    const uint64_t *nameOffsets  = reinterpret_cast<const uint64_t *>(base + namesOffset);
+    const BinaryTraceCall *calls = reinterpret_cast<const BinaryTraceCall *>(base + callsOffset);
+    uint8_t *data                = base + dataOffset;
+    stream.params                = reinterpret_cast<BinaryTraceParam *>(base + paramsOffset);
+    memcpy(stream.sections, header.sections, sizeof(stream.sections));
+
+    // Map the stream-local function table onto the interpreter's.
+    std::vector<uint32_t> functions(header.functionCount);
+    for (uint32_t functionIndex = 0; functionIndex < header.functionCount; ++functionIndex)
+    {
+        if (nameOffsets[functionIndex] >= header.dataSize)
+        {
+            fprintf(stderr, "Invalid function name in call stream: %s\n", streamPath.c_str());
+            return false;
+        }
+
+        const char *name = reinterpret_cast<const char *>(data + nameOffsets[functionIndex]);
+        if (!getFunction(name, loadProc, &functions[functionIndex]))
+        {
+            return false;
+        }
+    }
+
+    // Decode the calls and patch data offsets into pointers so replay doesn't have to.
+    stream.calls.resize(header.callCount);
+    uint32_t paramIndex = 0;
+    for (uint32_t callIndex = 0; callIndex < header.callCount; ++callIndex)
+    {
+        const BinaryTraceCall &binaryCall = calls[callIndex];
+        if (binaryCall.functionIndex >= header.functionCount ||
+            binaryCall.paramCount > kBinaryTraceMaxParams ||
+            binaryCall.resultType >= kBinaryTraceMaxResourceTypes ||
+            paramIndex + binaryCall.paramCount > header.paramCount)
+        {
+            fprintf(stderr, "Invalid call %u in call stream: %s\n", callIndex, streamPath.c_str());
+            return false;
+        }
+
+        Call &call      = stream.calls[callIndex];
+        call.function   = functions[binaryCall.functionIndex];
+        call.firstParam = paramIndex;
+        call.paramCount = binaryCall.paramCount;
+        call.resultKind = binaryCall.resultKind;
+        call.resultType = binaryCall.resultType;
+        call.resultKey  = binaryCall.resultKey;
+        Builtin builtin = mFunctions[call.function].builtin;
+
+        for (uint32_t callParam = 0; callParam < binaryCall.paramCount; ++callParam, ++paramIndex)
+        {
+            BinaryTraceParam &param = stream.params[paramIndex];
+            switch (param.kind)
+            {
+                case BinaryTraceParamKind::Data:
+                case BinaryTraceParamKind::ResourceIDArray:
+                    param.value = reinterpret_cast<uintptr_t>(data + param.value);
+                    break;
+                case BinaryTraceParamKind::StringArray:
+                {
+                    const uint64_t *stringOffsets =
+                        reinterpret_cast<const uint64_t *>(data + param.value);
+                    std::vector<const char *> strings(param.count);
+                    for (uint32_t stringIndex = 0; stringIndex < param.count; ++stringIndex)
+                    {
+                        strings[stringIndex] =
+                            reinterpret_cast<const char *>(data + stringOffsets[stringIndex]);
+                    }
+                    stream.stringArrays.push_back(std::move(strings));
+                    param.value = reinterpret_cast<uintptr_t>(stream.stringArrays.back().data());
+                    break;
+                }
+                case BinaryTraceParamKind::ResourceID:
+                case BinaryTraceParamKind::UniformLocation:
+                    if (param.resourceType >= kBinaryTraceMaxResourceTypes)
+                    {
+                        fprintf(stderr, "Invalid resource type in call stream: %s\n",
+                                streamPath.c_str());
+                        return false;
+                    }
+                    break;
+                case BinaryTraceParamKind::ReadBuffer:
+                    if (mReadBuffer.size() < param.count)
+                    {
+                        mReadBuffer.resize(param.count);
+                    }
+                    break;
+                case BinaryTraceParamKind::ClientArray:
+                    if (param.count >= kMaxClientArrays)
+                    {
+                        fprintf(stderr, "Invalid client array in call stream: %s\n",
+                                streamPath.c_str());
+                        return false;
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        // Client arrays are allocated up front so the pointers handed to GL stay valid.
+        if (builtin == Builtin::UpdateClientArray && call.paramCount == 3)
+        {
+            const BinaryTraceParam *params = &stream.params[call.firstParam];
+            uint64_t arrayIndex            = params[0].value;
+            uint64_t size                  = params[2].value;
+            if (arrayIndex >= kMaxClientArrays)
+            {
+                fprintf(stderr, "Invalid client array in call stream: %s\n", streamPath.c_str());
+                return false;
+            }
+            if (mClientArrays[arrayIndex].size() < size)
+            {
+                mClientArrays[arrayIndex].resize(static_cast<size_t>(size));
+            }
+        }
+    }
+
+    for (const BinaryTraceRange &range : stream.sections)
+    {
+        if (static_cast<uint64_t>(range.firstCall) + range.callCount > header.callCount)
+        {
+            fprintf(stderr, "Invalid section in call stream: %s\n", streamPath.c_str());
+            return false;
+        }
+    }
+
+    mStreams.push_back(std::move(stream));
+    return true;
+}
+
+bool TraceInterpreter::getFunction(const char *name, LoadProc loadProc, uint32_t *functionOut)
+{
+    auto iter = mFunctionIndices.find(name);
+    if (iter != mFunctionIndices.end())
+    {
+        *functionOut = iter->second;
+        return true;
+    }
+
+    static constexpr std::pair<const char *, Builtin> kBuiltins[] = {
+        {kBinaryTraceUpdateResourceID, Builtin::UpdateResourceID},
+        {kBinaryTraceUpdateUniformLocation, Builtin::UpdateUniformLocation},
+        {kBinaryTraceDeleteUniformLocations, Builtin::DeleteUniformLocations},
+        {kBinaryTraceUpdateCurrentProgram, Builtin::UpdateCurrentProgram},
+        {kBinaryTraceUpdateClientArray, Builtin::UpdateClientArray},
+        {kBinaryTraceUpdateClientBuffer, Builtin::UpdateClientBuffer},
+    };
+
+    Function function = {Builtin::GLCall, nullptr, nullptr};
+    for (const auto &builtin : kBuiltins)
+    {
+        if (strcmp(name, builtin.first) == 0)
+        {
+            function.builtin = builtin.second;
+            break;
+        }
+    }
+
+    if (function.builtin == Builtin::GLCall)
+    {
+        function.invoke = GetTraceInvokeFunc(name);
+        function.proc   = function.invoke ? loadProc(name) : nullptr;
+        if (!function.proc)
+        {
+            fprintf(stderr, "Unsupported function in call stream: %s\n", name);
+            return false;
+        }
+    }
+
+    *functionOut = static_cast<uint32_t>(mFunctions.size());
+    mFunctions.push_back(function);
+    mFunctionIndices[name] = *functionOut;
+    return true;
+}
+
+void TraceInterpreter::setupReplay()
+{
+    if (!mStreams.empty())
+    {
+        runSection(mStreams.front(), BinaryTraceSection::Setup);
+    }
+}
+
+void TraceInterpreter::replayFrame(uint32_t frameIndex)
+{
+    if (frameIndex >= mIndex.frameStart && frameIndex - mIndex.frameStart < mStreams.size())
+    {
+        runSection(mStreams[frameIndex - mIndex.frameStart], BinaryTraceSection::Frame);
+    }
+}
+
+void TraceInterpreter::resetReplay()
+{
+    if (!mStreams.empty())
+    {
+        runSection(mStreams.back(), BinaryTraceSection::Reset);
+    }
+}
+
+void TraceInterpreter::runSection(const Stream &stream, BinaryTraceSection section)
+{
+    const BinaryTraceRange &range = stream.sections[static_cast<size_t>(section)];
+    for (uint32_t callIndex = range.firstCall; callIndex < range.firstCall + range.callCount;
+         ++callIndex)
+    {
+        runCall(stream, stream.calls[callIndex]);
+    }
+}
+
+void TraceInterpreter::runCall(const Stream &stream, const Call &call)
+{
+    uint64_t slots[kBinaryTraceMaxParams];
+    for (size_t paramIndex = 0; paramIndex < call.paramCount; ++paramIndex)
+    {
+        slots[paramIndex] = resolveParam(stream.params[call.firstParam + paramIndex], paramIndex);
+    }
+
+    const Function &function = mFunctions[call.function];
+    if (function.builtin != Builtin::GLCall)
+    {
+        runBuiltin(function.builtin, slots);
+        return;
+    }
+
+    uint64_t result = function.invoke(function.proc, slots);
+    switch (call.resultKind)
+    {
+        case BinaryTraceResultKind::ResourceID:
+            setResourceID(call.resultType, static_cast<GLuint>(call.resultKey),
+                          FromTraceSlot<GLuint>(result));
+            break;
+        case BinaryTraceResultKind::Sync:
+            mSyncs[call.resultKey] = FromTraceSlot<GLsync>(result);
+            break;
+        case BinaryTraceResultKind::MappedBuffer:
+            mMappedBuffers[static_cast<GLuint>(call.resultKey)] = FromTraceSlot<void *>(result);
+            break;
+        default:
+            break;
+    }
+}
+
+void TraceInterpreter::runBuiltin(Builtin builtin, const uint64_t *slots)
+{
+    switch (builtin)
+    {
+        case Builtin::UpdateResourceID:
+        {
+            // The read buffer offset is in bytes, as in the compiled replay.
+            GLuint replayID;
+            size_t readBufferOffset = FromTraceSlot<GLsizei>(slots[2]);
+            memcpy(&replayID, mReadBuffer.data() + readBufferOffset, sizeof(GLuint));
+            setResourceID(FromTraceSlot<uint8_t>(slots[0]), FromTraceSlot<GLuint>(slots[1]),
+                          replayID);
+            break;
+        }
+        case Builtin::UpdateUniformLocation:
+        {
+            GLuint program                = FromTraceSlot<GLuint>(slots[0]);
+            const char *name              = FromTraceSlot<const char *>(slots[1]);
+            GLint location                = FromTraceSlot<GLint>(slots[2]);
+            std::vector<GLint> &locations = mUniformLocations[program];
+            if (static_cast<size_t>(location) >= locations.size())
+            {
+                locations.resize(location + 1, -1);
+            }
+            locations[location] = mGetUniformLocation(program, name);
+            break;
+        }
+        case Builtin::DeleteUniformLocations:
+            mUniformLocations.erase(FromTraceSlot<GLuint>(slots[0]));
+            break;
+        case Builtin::UpdateCurrentProgram:
+            mCurrentProgram = FromTraceSlot<GLuint>(slots[0]);
+            break;
+        case Builtin::UpdateClientArray:
+            memcpy(mClientArrays[slots[0]].data(), FromTraceSlot<const void *>(slots[1]),
+                   static_cast<size_t>(slots[2]));
+            break;
+        case Builtin::UpdateClientBuffer:
+        {
+            auto iter = mMappedBuffers.find(FromTraceSlot<GLuint>(slots[0]));
+            if (iter != mMappedBuffers.end() && iter->second)
+            {
+                memcpy(iter->second, FromTraceSlot<const void *>(slots[1]),
+                       FromTraceSlot<GLsizei>(slots[2]));
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+uint64_t TraceInterpreter::resolveParam(const BinaryTraceParam &param, size_t paramIndex)
+{
+    switch (param.kind)
+    {
+        case BinaryTraceParamKind::ResourceID:
+            return getResourceID(param.resourceType, static_cast<GLuint>(param.value));
+        case BinaryTraceParamKind::ResourceIDArray:
+        {
+            const GLuint *capturedIDs      = reinterpret_cast<const GLuint *>(param.value);
+            std::vector<GLuint> &replayIDs = mScratchIDs[paramIndex];
+            replayIDs.resize(param.count);
+            for (uint32_t idIndex = 0; idIndex < param.count; ++idIndex)
+            {
+                replayIDs[idIndex] = getResourceID(param.resourceType, capturedIDs[idIndex]);
+            }
+            return ToTraceSlot(replayIDs.data());
+        }
+        case BinaryTraceParamKind::Sync:
+        {
+            auto iter = mSyncs.find(param.value);
+            return ToTraceSlot(iter != mSyncs.end() ? iter->second : nullptr);
+        }
+        case BinaryTraceParamKind::UniformLocation:
+        {
+            GLuint program = param.count != 0 ? getResourceID(param.resourceType, param.count)
+                                              : mCurrentProgram;
+            return ToTraceSlot(getUniformLocation(program, FromTraceSlot<GLint>(param.value)));
+        }
+        case BinaryTraceParamKind::ReadBuffer:
+            return ToTraceSlot(mReadBuffer.data());
+        case BinaryTraceParamKind::ClientArray:
+            return ToTraceSlot(mClientArrays[param.count].data());
+        default:
+            return param.value;
+    }
+}
+
+GLuint TraceInterpreter::getResourceID(uint8_t resourceType, GLuint capturedID) const
+{
+    const std::vector<GLuint> &resourceMap = mResourceMaps[resourceType];
+    return capturedID < resourceMap.size() ? resourceMap[capturedID] : 0;
+}
+
+void TraceInterpreter::setResourceID(uint8_t resourceType, GLuint capturedID, GLuint replayID)
+{
+    std::vector<GLuint> &resourceMap = mResourceMaps[resourceType];
+    if (capturedID >= resourceMap.size())
+    {
+        resourceMap.resize(capturedID + 1, 0);
+    }
+    resourceMap[capturedID] = replayID;
+}
+
+GLint TraceInterpreter::getUniformLocation(GLuint program, GLint capturedLocation) const
+{
+    auto iter = mUniformLocations.find(program);
+    if (iter == mUniformLocations.end() || capturedLocation < 0 ||
+        static_cast<size_t>(capturedLocation) >= iter->second.size())
+    {
+        return -1;
+    }
+    return iter->second[capturedLocation];
+}
+}  // namespace angle
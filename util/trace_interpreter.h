@@ -0,0 +1,200 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// trace_interpreter.h:
+//   Replays the binary call streams written by frame capture (ANGLE_CAPTURE_FORMAT=binary)
+//   without first compiling them into a trace library.
+//
+
+#ifndef UTIL_TRACE_INTERPRETER_H_
+#define UTIL_TRACE_INTERPRETER_H_
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "angle_gl.h"
+#include "common/frame_capture_binary_format.h"
+#include "util/util_export.h"
+
+namespace angle
+{
+using GenericProc = void (*)();
+using LoadProc    = GenericProc(KHRONOS_APIENTRY *)(const char *);
+
+// Call arguments and results are passed around as 64-bit slots that hold the value in their low
+// bytes, matching the layout of the call stream.
+template <typename T>
+T FromTraceSlot(uint64_t slot)
+{
+    static_assert(sizeof(T) <= sizeof(uint64_t), "Type doesn't fit a slot");
+    T value;
+    memcpy(&value, &slot, sizeof(T));
+    return value;
+}
+
+template <typename T>
+uint64_t ToTraceSlot(T value)
+{
+    static_assert(sizeof(T) <= sizeof(uint64_t), "Type doesn't fit a slot");
+    uint64_t slot = 0;
+    memcpy(&slot, &value, sizeof(T));
+    return slot;
+}
+
+// Calls |proc| with arguments unpacked from |slots| and returns the packed result.
+using TraceInvokeFunc = uint64_t (*)(GenericProc proc, const uint64_t *slots);
+
+template <typename FuncT>
+struct TraceInvoker;
+
+template <typename R, typename... Args>
+struct TraceInvoker<R(KHRONOS_APIENTRY *)(Args...)>
+{
+    using FuncT = R(KHRONOS_APIENTRY *)(Args...);
+
+    static uint64_t Invoke(GenericProc proc, const uint64_t *slots)
+    {
+        return InvokeWithSlots(reinterpret_cast<FuncT>(proc), slots,
+                               std::index_sequence_for<Args...>());
+    }
+
+  private:
+    template <size_t... Indices>
+    static uint64_t InvokeWithSlots(FuncT func,
+                                    const uint64_t *slots,
+                                    std::index_sequence<Indices...>)
+    {
+        return ToTraceSlot(func(FromTraceSlot<Args>(slots[Indices])...));
+    }
+};
+
+template <typename... Args>
+struct TraceInvoker<void(KHRONOS_APIENTRY *)(Args...)>
+{
+    using FuncT = void(KHRONOS_APIENTRY *)(Args...);
+
+    static uint64_t Invoke(GenericProc proc, const uint64_t *slots)
+    {
+        InvokeWithSlots(reinterpret_cast<FuncT>(proc), slots, std::index_sequence_for<Args...>());
+        return 0;
+    }
+
+  private:
+    template <size_t... Indices>
+    static void InvokeWithSlots(FuncT func, const uint64_t *slots, std::index_sequence<Indices...>)
+    {
+        func(FromTraceSlot<Args>(slots[Indices])...);
+    }
+};
+
+// Returns the invoker of a GLES entry point, or nullptr if |functionName| is unknown. Defined in
+// trace_interpreter_autogen.cpp.
+TraceInvokeFunc GetTraceInvokeFunc(const char *functionName);
+
+class ANGLE_UTIL_EXPORT TraceInterpreter final
+{
+  public:
+    using DecompressCallback = uint8_t *(*)(const std::vector<uint8_t> &);
+
+    TraceInterpreter();
+    ~TraceInterpreter();
+
+    // Loads "<prefix>.angletrace" and the call streams of all the frames it covers. Every call is
+    // decoded and every entry point resolved through |loadProc| up front, so replay only has to
+    // remap resource IDs. |decompress| is required for compressed captures. If loading fails the
+    // replay functions do nothing.
+    bool load(const std::string &indexPath, LoadProc loadProc, DecompressCallback decompress);
+
+    uint32_t getFrameStart() const { return mIndex.frameStart; }
+    uint32_t getFrameEnd() const { return mIndex.frameEnd; }
+    uint32_t getDrawSurfaceWidth() const { return mIndex.drawSurfaceWidth; }
+    uint32_t getDrawSurfaceHeight() const { return mIndex.drawSurfaceHeight; }
+
+    void setupReplay();
+    void replayFrame(uint32_t frameIndex);
+    void resetReplay();
+
+  private:
+    enum class Builtin : uint8_t
+    {
+        GLCall,
+        UpdateResourceID,
+        UpdateUniformLocation,
+        DeleteUniformLocations,
+        UpdateCurrentProgram,
+        UpdateClientArray,
+        UpdateClientBuffer,
+    };
+
+    struct Function
+    {
+        Builtin builtin;
+        TraceInvokeFunc invoke;
+        GenericProc proc;
+    };
+
+    struct Call
+    {
+        uint32_t function;
+        uint32_t firstParam;
+        uint16_t paramCount;
+        BinaryTraceResultKind resultKind;
+        uint8_t resultType;
+        uint64_t resultKey;
+    };
+
+    struct Stream
+    {
+        Stream();
+        ~Stream();
+        Stream(Stream &&other);
+
+        std::unique_ptr<uint8_t[]> storage;
+        BinaryTraceParam *params;
+        BinaryTraceRange sections[static_cast<size_t>(BinaryTraceSection::EnumCount)];
+        std::vector<Call> calls;
+        std::vector<std::vector<const char *>> stringArrays;
+    };
+
+    static constexpr size_t kMaxClientArrays = 16;
+
+    bool loadStream(const std::string &streamPath,
+                    LoadProc loadProc,
+                    DecompressCallback decompress);
+    bool getFunction(const char *name, LoadProc loadProc, uint32_t *functionOut);
+
+    void runSection(const Stream &stream, BinaryTraceSection section);
+    void runCall(const Stream &stream, const Call &call);
+    void runBuiltin(Builtin builtin, const uint64_t *slots);
+    uint64_t resolveParam(const BinaryTraceParam &param, size_t paramIndex);
+
+    GLuint getResourceID(uint8_t resourceType, GLuint capturedID) const;
+    void setResourceID(uint8_t resourceType, GLuint capturedID, GLuint replayID);
+    GLint getUniformLocation(GLuint program, GLint capturedLocation) const;
+
+    BinaryTraceIndex mIndex;
+    std::vector<Stream> mStreams;
+    std::vector<Function> mFunctions;
+    std::unordered_map<std::string, uint32_t> mFunctionIndices;
+    PFNGLGETUNIFORMLOCATIONPROC mGetUniformLocation;
+
+    // Replay state, the interpreted equivalent of the globals in a compiled trace.
+    std::vector<GLuint> mResourceMaps[kBinaryTraceMaxResourceTypes];
+    std::unordered_map<GLuint, std::vector<GLint>> mUniformLocations;
+    GLuint mCurrentProgram;
+    std::unordered_map<uint64_t, GLsync> mSyncs;
+    std::unordered_map<GLuint, void *> mMappedBuffers;
+    std::vector<uint8_t> mReadBuffer;
+    std::vector<uint8_t> mClientArrays[kMaxClientArrays];
+    std::vector<GLuint> mScratchIDs[kBinaryTraceMaxParams];
+};
+}  // namespace angle
+
+#endif  // UTIL_TRACE_INTERPRETER_H_
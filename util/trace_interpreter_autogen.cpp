@@ -0,0 +1,848 @@
+// GENERATED FILE - DO NOT EDIT.
+// Generated by generate_loader.py using data from gl.xml and gl_angle_ext.xml.
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// trace_interpreter_autogen.cpp:
+//   Typed invokers for the GLES entry points replayed by TraceInterpreter.
+
+#include "util/trace_interpreter.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace angle
+{
+namespace
+{
+struct TraceInvokerEntry
+{
+    const char *name;
+    TraceInvokeFunc invoke;
+};
+
+constexpr TraceInvokerEntry kTraceInvokers[] = {
+    {"glActiveShaderProgram", &TraceInvoker<PFNGLACTIVESHADERPROGRAMPROC>::Invoke},
+    {"glActiveShaderProgramEXT", &TraceInvoker<PFNGLACTIVESHADERPROGRAMEXTPROC>::Invoke},
+    {"glActiveTexture", &TraceInvoker<PFNGLACTIVETEXTUREPROC>::Invoke},
+    {"glAlphaFunc", &TraceInvoker<PFNGLALPHAFUNCPROC>::Invoke},
+    {"glAlphaFuncx", &TraceInvoker<PFNGLALPHAFUNCXPROC>::Invoke},
+    {"glAttachShader", &TraceInvoker<PFNGLATTACHSHADERPROC>::Invoke},
+    {"glBeginQuery", &TraceInvoker<PFNGLBEGINQUERYPROC>::Invoke},
+    {"glBeginQueryEXT", &TraceInvoker<PFNGLBEGINQUERYEXTPROC>::Invoke},
+    {"glBeginTransformFeedback", &TraceInvoker<PFNGLBEGINTRANSFORMFEEDBACKPROC>::Invoke},
+    {"glBindAttribLocation", &TraceInvoker<PFNGLBINDATTRIBLOCATIONPROC>::Invoke},
+    {"glBindBuffer", &TraceInvoker<PFNGLBINDBUFFERPROC>::Invoke},
+    {"glBindBufferBase", &TraceInvoker<PFNGLBINDBUFFERBASEPROC>::Invoke},
+    {"glBindBufferRange", &TraceInvoker<PFNGLBINDBUFFERRANGEPROC>::Invoke},
+    {"glBindFragDataLocationEXT", &TraceInvoker<PFNGLBINDFRAGDATALOCATIONEXTPROC>::Invoke},
+    {"glBindFragDataLocationIndexedEXT",
+     &TraceInvoker<PFNGLBINDFRAGDATALOCATIONINDEXEDEXTPROC>::Invoke},
+    {"glBindFramebuffer", &TraceInvoker<PFNGLBINDFRAMEBUFFERPROC>::Invoke},
+    {"glBindFramebufferOES", &TraceInvoker<PFNGLBINDFRAMEBUFFEROESPROC>::Invoke},
+    {"glBindImageTexture", &TraceInvoker<PFNGLBINDIMAGETEXTUREPROC>::Invoke},
+    {"glBindProgramPipeline", &TraceInvoker<PFNGLBINDPROGRAMPIPELINEPROC>::Invoke},
+    {"glBindProgramPipelineEXT", &TraceInvoker<PFNGLBINDPROGRAMPIPELINEEXTPROC>::Invoke},
+    {"glBindRenderbuffer", &TraceInvoker<PFNGLBINDRENDERBUFFERPROC>::Invoke},
+    {"glBindRenderbufferOES", &TraceInvoker<PFNGLBINDRENDERBUFFEROESPROC>::Invoke},
+    {"glBindSampler", &TraceInvoker<PFNGLBINDSAMPLERPROC>::Invoke},
+    {"glBindTexture", &TraceInvoker<PFNGLBINDTEXTUREPROC>::Invoke},
+    {"glBindTransformFeedback", &TraceInvoker<PFNGLBINDTRANSFORMFEEDBACKPROC>::Invoke},
+    {"glBindUniformLocationCHROMIUM", &TraceInvoker<PFNGLBINDUNIFORMLOCATIONCHROMIUMPROC>::Invoke},
+    {"glBindVertexArray", &TraceInvoker<PFNGLBINDVERTEXARRAYPROC>::Invoke},
+    {"glBindVertexArrayOES", &TraceInvoker<PFNGLBINDVERTEXARRAYOESPROC>::Invoke},
+    {"glBindVertexBuffer", &TraceInvoker<PFNGLBINDVERTEXBUFFERPROC>::Invoke},
+    {"glBlendColor", &TraceInvoker<PFNGLBLENDCOLORPROC>::Invoke},
+    {"glBlendEquation", &TraceInvoker<PFNGLBLENDEQUATIONPROC>::Invoke},
+    {"glBlendEquationSeparate", &TraceInvoker<PFNGLBLENDEQUATIONSEPARATEPROC>::Invoke},
+    {"glBlendEquationSeparateiEXT", &TraceInvoker<PFNGLBLENDEQUATIONSEPARATEIEXTPROC>::Invoke},
+    {"glBlendEquationSeparateiOES", &TraceInvoker<PFNGLBLENDEQUATIONSEPARATEIOESPROC>::Invoke},
+    {"glBlendEquationiEXT", &TraceInvoker<PFNGLBLENDEQUATIONIEXTPROC>::Invoke},
+    {"glBlendEquationiOES", &TraceInvoker<PFNGLBLENDEQUATIONIOESPROC>::Invoke},
+    {"glBlendFunc", &TraceInvoker<PFNGLBLENDFUNCPROC>::Invoke},
+    {"glBlendFuncSeparate", &TraceInvoker<PFNGLBLENDFUNCSEPARATEPROC>::Invoke},
+    {"glBlendFuncSeparateiEXT", &TraceInvoker<PFNGLBLENDFUNCSEPARATEIEXTPROC>::Invoke},
+    {"glBlendFuncSeparateiOES", &TraceInvoker<PFNGLBLENDFUNCSEPARATEIOESPROC>::Invoke},
+    {"glBlendFunciEXT", &TraceInvoker<PFNGLBLENDFUNCIEXTPROC>::Invoke},
+    {"glBlendFunciOES", &TraceInvoker<PFNGLBLENDFUNCIOESPROC>::Invoke},
+    {"glBlitFramebuffer", &TraceInvoker<PFNGLBLITFRAMEBUFFERPROC>::Invoke},
+    {"glBlitFramebufferANGLE", &TraceInvoker<PFNGLBLITFRAMEBUFFERANGLEPROC>::Invoke},
+    {"glBufferData", &TraceInvoker<PFNGLBUFFERDATAPROC>::Invoke},
+    {"glBufferStorageEXT", &TraceInvoker<PFNGLBUFFERSTORAGEEXTPROC>::Invoke},
+    {"glBufferStorageExternalEXT", &TraceInvoker<PFNGLBUFFERSTORAGEEXTERNALEXTPROC>::Invoke},
+    {"glBufferStorageMemEXT", &TraceInvoker<PFNGLBUFFERSTORAGEMEMEXTPROC>::Invoke},
+    {"glBufferSubData", &TraceInvoker<PFNGLBUFFERSUBDATAPROC>::Invoke},
+    {"glCheckFramebufferStatus", &TraceInvoker<PFNGLCHECKFRAMEBUFFERSTATUSPROC>::Invoke},
+    {"glCheckFramebufferStatusOES", &TraceInvoker<PFNGLCHECKFRAMEBUFFERSTATUSOESPROC>::Invoke},
+    {"glClear", &TraceInvoker<PFNGLCLEARPROC>::Invoke},
+    {"glClearBufferfi", &TraceInvoker<PFNGLCLEARBUFFERFIPROC>::Invoke},
+    {"glClearBufferfv", &TraceInvoker<PFNGLCLEARBUFFERFVPROC>::Invoke},
+    {"glClearBufferiv", &TraceInvoker<PFNGLCLEARBUFFERIVPROC>::Invoke},
+    {"glClearBufferuiv", &TraceInvoker<PFNGLCLEARBUFFERUIVPROC>::Invoke},
+    {"glClearColor", &TraceInvoker<PFNGLCLEARCOLORPROC>::Invoke},
+    {"glClearColorx", &TraceInvoker<PFNGLCLEARCOLORXPROC>::Invoke},
+    {"glClearDepthf", &TraceInvoker<PFNGLCLEARDEPTHFPROC>::Invoke},
+    {"glClearDepthx", &TraceInvoker<PFNGLCLEARDEPTHXPROC>::Invoke},
+    {"glClearStencil", &TraceInvoker<PFNGLCLEARSTENCILPROC>::Invoke},
+    {"glClientActiveTexture", &TraceInvoker<PFNGLCLIENTACTIVETEXTUREPROC>::Invoke},
+    {"glClientWaitSync", &TraceInvoker<PFNGLCLIENTWAITSYNCPROC>::Invoke},
+    {"glClipPlanef", &TraceInvoker<PFNGLCLIPPLANEFPROC>::Invoke},
+    {"glClipPlanex", &TraceInvoker<PFNGLCLIPPLANEXPROC>::Invoke},
+    {"glColor4f", &TraceInvoker<PFNGLCOLOR4FPROC>::Invoke},
+    {"glColor4ub", &TraceInvoker<PFNGLCOLOR4UBPROC>::Invoke},
+    {"glColor4x", &TraceInvoker<PFNGLCOLOR4XPROC>::Invoke},
+    {"glColorMask", &TraceInvoker<PFNGLCOLORMASKPROC>::Invoke},
+    {"glColorMaskiEXT", &TraceInvoker<PFNGLCOLORMASKIEXTPROC>::Invoke},
+    {"glColorMaskiOES", &TraceInvoker<PFNGLCOLORMASKIOESPROC>::Invoke},
+    {"glColorPointer", &TraceInvoker<PFNGLCOLORPOINTERPROC>::Invoke},
+    {"glCompileShader", &TraceInvoker<PFNGLCOMPILESHADERPROC>::Invoke},
+    {"glCompressedCopyTextureCHROMIUM",
+     &TraceInvoker<PFNGLCOMPRESSEDCOPYTEXTURECHROMIUMPROC>::Invoke},
+    {"glCompressedTexImage2D", &TraceInvoker<PFNGLCOMPRESSEDTEXIMAGE2DPROC>::Invoke},
+    {"glCompressedTexImage2DRobustANGLE",
+     &TraceInvoker<PFNGLCOMPRESSEDTEXIMAGE2DROBUSTANGLEPROC>::Invoke},
+    {"glCompressedTexImage3D", &TraceInvoker<PFNGLCOMPRESSEDTEXIMAGE3DPROC>::Invoke},
+    {"glCompressedTexImage3DOES", &TraceInvoker<PFNGLCOMPRESSEDTEXIMAGE3DOESPROC>::Invoke},
+    {"glCompressedTexImage3DRobustANGLE",
+     &TraceInvoker<PFNGLCOMPRESSEDTEXIMAGE3DROBUSTANGLEPROC>::Invoke},
+    {"glCompressedTexSubImage2D", &TraceInvoker<PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC>::Invoke},
+    {"glCompressedTexSubImage2DRobustANGLE",
+     &TraceInvoker<PFNGLCOMPRESSEDTEXSUBIMAGE2DROBUSTANGLEPROC>::Invoke},
+    {"glCompressedTexSubImage3D", &TraceInvoker<PFNGLCOMPRESSEDTEXSUBIMAGE3DPROC>::Invoke},
+    {"glCompressedTexSubImage3DOES", &TraceInvoker<PFNGLCOMPRESSEDTEXSUBIMAGE3DOESPROC>::Invoke},
+    {"glCompressedTexSubImage3DRobustANGLE",
+     &TraceInvoker<PFNGLCOMPRESSEDTEXSUBIMAGE3DROBUSTANGLEPROC>::Invoke},
+    {"glCopyBufferSubData", &TraceInvoker<PFNGLCOPYBUFFERSUBDATAPROC>::Invoke},
+    {"glCopyImageSubDataEXT", &TraceInvoker<PFNGLCOPYIMAGESUBDATAEXTPROC>::Invoke},
+    {"glCopyImageSubDataOES", &TraceInvoker<PFNGLCOPYIMAGESUBDATAOESPROC>::Invoke},
+    {"glCopySubTexture3DANGLE", &TraceInvoker<PFNGLCOPYSUBTEXTURE3DANGLEPROC>::Invoke},
+    {"glCopySubTextureCHROMIUM", &TraceInvoker<PFNGLCOPYSUBTEXTURECHROMIUMPROC>::Invoke},
+    {"glCopyTexImage2D", &TraceInvoker<PFNGLCOPYTEXIMAGE2DPROC>::Invoke},
+    {"glCopyTexSubImage2D", &TraceInvoker<PFNGLCOPYTEXSUBIMAGE2DPROC>::Invoke},
+    {"glCopyTexSubImage3D", &TraceInvoker<PFNGLCOPYTEXSUBIMAGE3DPROC>::Invoke},
+    {"glCopyTexSubImage3DOES", &TraceInvoker<PFNGLCOPYTEXSUBIMAGE3DOESPROC>::Invoke},
+    {"glCopyTexture3DANGLE", &TraceInvoker<PFNGLCOPYTEXTURE3DANGLEPROC>::Invoke},
+    {"glCopyTextureCHROMIUM", &TraceInvoker<PFNGLCOPYTEXTURECHROMIUMPROC>::Invoke},
+    {"glCoverageModulationCHROMIUM", &TraceInvoker<PFNGLCOVERAGEMODULATIONCHROMIUMPROC>::Invoke},
+    {"glCreateMemoryObjectsEXT", &TraceInvoker<PFNGLCREATEMEMORYOBJECTSEXTPROC>::Invoke},
+    {"glCreateProgram", &TraceInvoker<PFNGLCREATEPROGRAMPROC>::Invoke},
+    {"glCreateShader", &TraceInvoker<PFNGLCREATESHADERPROC>::Invoke},
+    {"glCreateShaderProgramv", &TraceInvoker<PFNGLCREATESHADERPROGRAMVPROC>::Invoke},
+    {"glCreateShaderProgramvEXT", &TraceInvoker<PFNGLCREATESHADERPROGRAMVEXTPROC>::Invoke},
+    {"glCullFace", &TraceInvoker<PFNGLCULLFACEPROC>::Invoke},
+    {"glCurrentPaletteMatrixOES", &TraceInvoker<PFNGLCURRENTPALETTEMATRIXOESPROC>::Invoke},
+    {"glDebugMessageCallbackKHR", &TraceInvoker<PFNGLDEBUGMESSAGECALLBACKKHRPROC>::Invoke},
+    {"glDebugMessageControlKHR", &TraceInvoker<PFNGLDEBUGMESSAGECONTROLKHRPROC>::Invoke},
+    {"glDebugMessageInsertKHR", &TraceInvoker<PFNGLDEBUGMESSAGEINSERTKHRPROC>::Invoke},
+    {"glDeleteBuffers", &TraceInvoker<PFNGLDELETEBUFFERSPROC>::Invoke},
+    {"glDeleteFencesNV", &TraceInvoker<PFNGLDELETEFENCESNVPROC>::Invoke},
+    {"glDeleteFramebuffers", &TraceInvoker<PFNGLDELETEFRAMEBUFFERSPROC>::Invoke},
+    {"glDeleteFramebuffersOES", &TraceInvoker<PFNGLDELETEFRAMEBUFFERSOESPROC>::Invoke},
+    {"glDeleteMemoryObjectsEXT", &TraceInvoker<PFNGLDELETEMEMORYOBJECTSEXTPROC>::Invoke},
+    {"glDeleteProgram", &TraceInvoker<PFNGLDELETEPROGRAMPROC>::Invoke},
+    {"glDeleteProgramPipelines", &TraceInvoker<PFNGLDELETEPROGRAMPIPELINESPROC>::Invoke},
+    {"glDeleteProgramPipelinesEXT", &TraceInvoker<PFNGLDELETEPROGRAMPIPELINESEXTPROC>::Invoke},
+    {"glDeleteQueries", &TraceInvoker<PFNGLDELETEQUERIESPROC>::Invoke},
+    {"glDeleteQueriesEXT", &TraceInvoker<PFNGLDELETEQUERIESEXTPROC>::Invoke},
+    {"glDeleteRenderbuffers", &TraceInvoker<PFNGLDELETERENDERBUFFERSPROC>::Invoke},
+    {"glDeleteRenderbuffersOES", &TraceInvoker<PFNGLDELETERENDERBUFFERSOESPROC>::Invoke},
+    {"glDeleteSamplers", &TraceInvoker<PFNGLDELETESAMPLERSPROC>::Invoke},
+    {"glDeleteSemaphoresEXT", &TraceInvoker<PFNGLDELETESEMAPHORESEXTPROC>::Invoke},
+    {"glDeleteShader", &TraceInvoker<PFNGLDELETESHADERPROC>::Invoke},
+    {"glDeleteSync", &TraceInvoker<PFNGLDELETESYNCPROC>::Invoke},
+    {"glDeleteTextures", &TraceInvoker<PFNGLDELETETEXTURESPROC>::Invoke},
+    {"glDeleteTransformFeedbacks", &TraceInvoker<PFNGLDELETETRANSFORMFEEDBACKSPROC>::Invoke},
+    {"glDeleteVertexArrays", &TraceInvoker<PFNGLDELETEVERTEXARRAYSPROC>::Invoke},
+    {"glDeleteVertexArraysOES", &TraceInvoker<PFNGLDELETEVERTEXARRAYSOESPROC>::Invoke},
+    {"glDepthFunc", &TraceInvoker<PFNGLDEPTHFUNCPROC>::Invoke},
+    {"glDepthMask", &TraceInvoker<PFNGLDEPTHMASKPROC>::Invoke},
+    {"glDepthRangef", &TraceInvoker<PFNGLDEPTHRANGEFPROC>::Invoke},
+    {"glDepthRangex", &TraceInvoker<PFNGLDEPTHRANGEXPROC>::Invoke},
+    {"glDetachShader", &TraceInvoker<PFNGLDETACHSHADERPROC>::Invoke},
+    {"glDisable", &TraceInvoker<PFNGLDISABLEPROC>::Invoke},
+    {"glDisableClientState", &TraceInvoker<PFNGLDISABLECLIENTSTATEPROC>::Invoke},
+    {"glDisableExtensionANGLE", &TraceInvoker<PFNGLDISABLEEXTENSIONANGLEPROC>::Invoke},
+    {"glDisableVertexAttribArray", &TraceInvoker<PFNGLDISABLEVERTEXATTRIBARRAYPROC>::Invoke},
+    {"glDisableiEXT", &TraceInvoker<PFNGLDISABLEIEXTPROC>::Invoke},
+    {"glDisableiOES", &TraceInvoker<PFNGLDISABLEIOESPROC>::Invoke},
+    {"glDiscardFramebufferEXT", &TraceInvoker<PFNGLDISCARDFRAMEBUFFEREXTPROC>::Invoke},
+    {"glDispatchCompute", &TraceInvoker<PFNGLDISPATCHCOMPUTEPROC>::Invoke},
+    {"glDispatchComputeIndirect", &TraceInvoker<PFNGLDISPATCHCOMPUTEINDIRECTPROC>::Invoke},
+    {"glDrawArrays", &TraceInvoker<PFNGLDRAWARRAYSPROC>::Invoke},
+    {"glDrawArraysIndirect", &TraceInvoker<PFNGLDRAWARRAYSINDIRECTPROC>::Invoke},
+    {"glDrawArraysInstanced", &TraceInvoker<PFNGLDRAWARRAYSINSTANCEDPROC>::Invoke},
+    {"glDrawArraysInstancedANGLE", &TraceInvoker<PFNGLDRAWARRAYSINSTANCEDANGLEPROC>::Invoke},
+    {"glDrawArraysInstancedBaseInstanceANGLE",
+     &TraceInvoker<PFNGLDRAWARRAYSINSTANCEDBASEINSTANCEANGLEPROC>::Invoke},
+    {"glDrawArraysInstancedEXT", &TraceInvoker<PFNGLDRAWARRAYSINSTANCEDEXTPROC>::Invoke},
+    {"glDrawBuffers", &TraceInvoker<PFNGLDRAWBUFFERSPROC>::Invoke},
+    {"glDrawBuffersEXT", &TraceInvoker<PFNGLDRAWBUFFERSEXTPROC>::Invoke},
+    {"glDrawElements", &TraceInvoker<PFNGLDRAWELEMENTSPROC>::Invoke},
+    {"glDrawElementsBaseVertexEXT", &TraceInvoker<PFNGLDRAWELEMENTSBASEVERTEXEXTPROC>::Invoke},
+    {"glDrawElementsBaseVertexOES", &TraceInvoker<PFNGLDRAWELEMENTSBASEVERTEXOESPROC>::Invoke},
+    {"glDrawElementsIndirect", &TraceInvoker<PFNGLDRAWELEMENTSINDIRECTPROC>::Invoke},
+    {"glDrawElementsInstanced", &TraceInvoker<PFNGLDRAWELEMENTSINSTANCEDPROC>::Invoke},
+    {"glDrawElementsInstancedANGLE", &TraceInvoker<PFNGLDRAWELEMENTSINSTANCEDANGLEPROC>::Invoke},
+    {"glDrawElementsInstancedBaseVertexBaseInstanceANGLE",
+     &TraceInvoker<PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEANGLEPROC>::Invoke},
+    {"glDrawElementsInstancedBaseVertexEXT",
+     &TraceInvoker<PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXEXTPROC>::Invoke},
+    {"glDrawElementsInstancedBaseVertexOES",
+     &TraceInvoker<PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXOESPROC>::Invoke},
+    {"glDrawElementsInstancedEXT", &TraceInvoker<PFNGLDRAWELEMENTSINSTANCEDEXTPROC>::Invoke},
+    {"glDrawRangeElements", &TraceInvoker<PFNGLDRAWRANGEELEMENTSPROC>::Invoke},
+    {"glDrawRangeElementsBaseVertexEXT",
+     &TraceInvoker<PFNGLDRAWRANGEELEMENTSBASEVERTEXEXTPROC>::Invoke},
+    {"glDrawRangeElementsBaseVertexOES",
+     &TraceInvoker<PFNGLDRAWRANGEELEMENTSBASEVERTEXOESPROC>::Invoke},
+    {"glDrawTexfOES", &TraceInvoker<PFNGLDRAWTEXFOESPROC>::Invoke},
+    {"glDrawTexfvOES", &TraceInvoker<PFNGLDRAWTEXFVOESPROC>::Invoke},
+    {"glDrawTexiOES", &TraceInvoker<PFNGLDRAWTEXIOESPROC>::Invoke},
+    {"glDrawTexivOES", &TraceInvoker<PFNGLDRAWTEXIVOESPROC>::Invoke},
+    {"glDrawTexsOES", &TraceInvoker<PFNGLDRAWTEXSOESPROC>::Invoke},
+    {"glDrawTexsvOES", &TraceInvoker<PFNGLDRAWTEXSVOESPROC>::Invoke},
+    {"glDrawTexxOES", &TraceInvoker<PFNGLDRAWTEXXOESPROC>::Invoke},
+    {"glDrawTexxvOES", &TraceInvoker<PFNGLDRAWTEXXVOESPROC>::Invoke},
+    {"glEGLImageTargetRenderbufferStorageOES",
+     &TraceInvoker<PFNGLEGLIMAGETARGETRENDERBUFFERSTORAGEOESPROC>::Invoke},
+    {"glEGLImageTargetTexture2DOES", &TraceInvoker<PFNGLEGLIMAGETARGETTEXTURE2DOESPROC>::Invoke},
+    {"glEnable", &TraceInvoker<PFNGLENABLEPROC>::Invoke},
+    {"glEnableClientState", &TraceInvoker<PFNGLENABLECLIENTSTATEPROC>::Invoke},
+    {"glEnableVertexAttribArray", &TraceInvoker<PFNGLENABLEVERTEXATTRIBARRAYPROC>::Invoke},
+    {"glEnableiEXT", &TraceInvoker<PFNGLENABLEIEXTPROC>::Invoke},
+    {"glEnableiOES", &TraceInvoker<PFNGLENABLEIOESPROC>::Invoke},
+    {"glEndQuery", &TraceInvoker<PFNGLENDQUERYPROC>::Invoke},
+    {"glEndQueryEXT", &TraceInvoker<PFNGLENDQUERYEXTPROC>::Invoke},
+    {"glEndTransformFeedback", &TraceInvoker<PFNGLENDTRANSFORMFEEDBACKPROC>::Invoke},
+    {"glFenceSync", &TraceInvoker<PFNGLFENCESYNCPROC>::Invoke},
+    {"glFinish", &TraceInvoker<PFNGLFINISHPROC>::Invoke},
+    {"glFinishFenceNV", &TraceInvoker<PFNGLFINISHFENCENVPROC>::Invoke},
+    {"glFlush", &TraceInvoker<PFNGLFLUSHPROC>::Invoke},
+    {"glFlushMappedBufferRange", &TraceInvoker<PFNGLFLUSHMAPPEDBUFFERRANGEPROC>::Invoke},
+    {"glFlushMappedBufferRangeEXT", &TraceInvoker<PFNGLFLUSHMAPPEDBUFFERRANGEEXTPROC>::Invoke},
+    {"glFogf", &TraceInvoker<PFNGLFOGFPROC>::Invoke},
+    {"glFogfv", &TraceInvoker<PFNGLFOGFVPROC>::Invoke},
+    {"glFogx", &TraceInvoker<PFNGLFOGXPROC>::Invoke},
+    {"glFogxv", &TraceInvoker<PFNGLFOGXVPROC>::Invoke},
+    {"glFramebufferParameteri", &TraceInvoker<PFNGLFRAMEBUFFERPARAMETERIPROC>::Invoke},
+    {"glFramebufferRenderbuffer", &TraceInvoker<PFNGLFRAMEBUFFERRENDERBUFFERPROC>::Invoke},
+    {"glFramebufferRenderbufferOES", &TraceInvoker<PFNGLFRAMEBUFFERRENDERBUFFEROESPROC>::Invoke},
+    {"glFramebufferTexture2D", &TraceInvoker<PFNGLFRAMEBUFFERTEXTURE2DPROC>::Invoke},
+    {"glFramebufferTexture2DMultisampleEXT",
+     &TraceInvoker<PFNGLFRAMEBUFFERTEXTURE2DMULTISAMPLEEXTPROC>::Invoke},
+    {"glFramebufferTexture2DOES", &TraceInvoker<PFNGLFRAMEBUFFERTEXTURE2DOESPROC>::Invoke},
+    {"glFramebufferTexture3DOES", &TraceInvoker<PFNGLFRAMEBUFFERTEXTURE3DOESPROC>::Invoke},
+    {"glFramebufferTextureEXT", &TraceInvoker<PFNGLFRAMEBUFFERTEXTUREEXTPROC>::Invoke},
+    {"glFramebufferTextureLayer", &TraceInvoker<PFNGLFRAMEBUFFERTEXTURELAYERPROC>::Invoke},
+    {"glFramebufferTextureMultiviewOVR",
+     &TraceInvoker<PFNGLFRAMEBUFFERTEXTUREMULTIVIEWOVRPROC>::Invoke},
+    {"glFrontFace", &TraceInvoker<PFNGLFRONTFACEPROC>::Invoke},
+    {"glFrustumf", &TraceInvoker<PFNGLFRUSTUMFPROC>::Invoke},
+    {"glFrustumx", &TraceInvoker<PFNGLFRUSTUMXPROC>::Invoke},
+    {"glGenBuffers", &TraceInvoker<PFNGLGENBUFFERSPROC>::Invoke},
+    {"glGenFencesNV", &TraceInvoker<PFNGLGENFENCESNVPROC>::Invoke},
+    {"glGenFramebuffers", &TraceInvoker<PFNGLGENFRAMEBUFFERSPROC>::Invoke},
+    {"glGenFramebuffersOES", &TraceInvoker<PFNGLGENFRAMEBUFFERSOESPROC>::Invoke},
+    {"glGenProgramPipelines", &TraceInvoker<PFNGLGENPROGRAMPIPELINESPROC>::Invoke},
+    {"glGenProgramPipelinesEXT", &TraceInvoker<PFNGLGENPROGRAMPIPELINESEXTPROC>::Invoke},
+    {"glGenQueries", &TraceInvoker<PFNGLGENQUERIESPROC>::Invoke},
+    {"glGenQueriesEXT", &TraceInvoker<PFNGLGENQUERIESEXTPROC>::Invoke},
+    {"glGenRenderbuffers", &TraceInvoker<PFNGLGENRENDERBUFFERSPROC>::Invoke},
+    {"glGenRenderbuffersOES", &TraceInvoker<PFNGLGENRENDERBUFFERSOESPROC>::Invoke},
+    {"glGenSamplers", &TraceInvoker<PFNGLGENSAMPLERSPROC>::Invoke},
+    {"glGenSemaphoresEXT", &TraceInvoker<PFNGLGENSEMAPHORESEXTPROC>::Invoke},
+    {"glGenTextures", &TraceInvoker<PFNGLGENTEXTURESPROC>::Invoke},
+    {"glGenTransformFeedbacks", &TraceInvoker<PFNGLGENTRANSFORMFEEDBACKSPROC>::Invoke},
+    {"glGenVertexArrays", &TraceInvoker<PFNGLGENVERTEXARRAYSPROC>::Invoke},
+    {"glGenVertexArraysOES", &TraceInvoker<PFNGLGENVERTEXARRAYSOESPROC>::Invoke},
+    {"glGenerateMipmap", &TraceInvoker<PFNGLGENERATEMIPMAPPROC>::Invoke},
+    {"glGenerateMipmapOES", &TraceInvoker<PFNGLGENERATEMIPMAPOESPROC>::Invoke},
+    {"glGetActiveAttrib", &TraceInvoker<PFNGLGETACTIVEATTRIBPROC>::Invoke},
+    {"glGetActiveUniform", &TraceInvoker<PFNGLGETACTIVEUNIFORMPROC>::Invoke},
+    {"glGetActiveUniformBlockName", &TraceInvoker<PFNGLGETACTIVEUNIFORMBLOCKNAMEPROC>::Invoke},
+    {"glGetActiveUniformBlockiv", &TraceInvoker<PFNGLGETACTIVEUNIFORMBLOCKIVPROC>::Invoke},
+    {"glGetActiveUniformBlockivRobustANGLE",
+     &TraceInvoker<PFNGLGETACTIVEUNIFORMBLOCKIVROBUSTANGLEPROC>::Invoke},
+    {"glGetActiveUniformsiv", &TraceInvoker<PFNGLGETACTIVEUNIFORMSIVPROC>::Invoke},
+    {"glGetAttachedShaders", &TraceInvoker<PFNGLGETATTACHEDSHADERSPROC>::Invoke},
+    {"glGetAttribLocation", &TraceInvoker<PFNGLGETATTRIBLOCATIONPROC>::Invoke},
+    {"glGetBooleani_v", &TraceInvoker<PFNGLGETBOOLEANI_VPROC>::Invoke},
+    {"glGetBooleani_vRobustANGLE", &TraceInvoker<PFNGLGETBOOLEANI_VROBUSTANGLEPROC>::Invoke},
+    {"glGetBooleanv", &TraceInvoker<PFNGLGETBOOLEANVPROC>::Invoke},
+    {"glGetBooleanvRobustANGLE", &TraceInvoker<PFNGLGETBOOLEANVROBUSTANGLEPROC>::Invoke},
+    {"glGetBufferParameteri64v", &TraceInvoker<PFNGLGETBUFFERPARAMETERI64VPROC>::Invoke},
+    {"glGetBufferParameteri64vRobustANGLE",
+     &TraceInvoker<PFNGLGETBUFFERPARAMETERI64VROBUSTANGLEPROC>::Invoke},
+    {"glGetBufferParameteriv", &TraceInvoker<PFNGLGETBUFFERPARAMETERIVPROC>::Invoke},
+    {"glGetBufferParameterivRobustANGLE",
+     &TraceInvoker<PFNGLGETBUFFERPARAMETERIVROBUSTANGLEPROC>::Invoke},
+    {"glGetBufferPointerv", &TraceInvoker<PFNGLGETBUFFERPOINTERVPROC>::Invoke},
+    {"glGetBufferPointervOES", &TraceInvoker<PFNGLGETBUFFERPOINTERVOESPROC>::Invoke},
+    {"glGetBufferPointervRobustANGLE",
+     &TraceInvoker<PFNGLGETBUFFERPOINTERVROBUSTANGLEPROC>::Invoke},
+    {"glGetClipPlanef", &TraceInvoker<PFNGLGETCLIPPLANEFPROC>::Invoke},
+    {"glGetClipPlanex", &TraceInvoker<PFNGLGETCLIPPLANEXPROC>::Invoke},
+    {"glGetDebugMessageLogKHR", &TraceInvoker<PFNGLGETDEBUGMESSAGELOGKHRPROC>::Invoke},
+    {"glGetError", &TraceInvoker<PFNGLGETERRORPROC>::Invoke},
+    {"glGetFenceivNV", &TraceInvoker<PFNGLGETFENCEIVNVPROC>::Invoke},
+    {"glGetFixedv", &TraceInvoker<PFNGLGETFIXEDVPROC>::Invoke},
+    {"glGetFloatv", &TraceInvoker<PFNGLGETFLOATVPROC>::Invoke},
+    {"glGetFloatvRobustANGLE", &TraceInvoker<PFNGLGETFLOATVROBUSTANGLEPROC>::Invoke},
+    {"glGetFragDataIndexEXT", &TraceInvoker<PFNGLGETFRAGDATAINDEXEXTPROC>::Invoke},
+    {"glGetFragDataLocation", &TraceInvoker<PFNGLGETFRAGDATALOCATIONPROC>::Invoke},
+    {"glGetFramebufferAttachmentParameteriv",
+     &TraceInvoker<PFNGLGETFRAMEBUFFERATTACHMENTPARAMETERIVPROC>::Invoke},
+    {"glGetFramebufferAttachmentParameterivOES",
+     &TraceInvoker<PFNGLGETFRAMEBUFFERATTACHMENTPARAMETERIVOESPROC>::Invoke},
+    {"glGetFramebufferAttachmentParameterivRobustANGLE",
+     &TraceInvoker<PFNGLGETFRAMEBUFFERATTACHMENTPARAMETERIVROBUSTANGLEPROC>::Invoke},
+    {"glGetFramebufferParameteriv", &TraceInvoker<PFNGLGETFRAMEBUFFERPARAMETERIVPROC>::Invoke},
+    {"glGetFramebufferParameterivRobustANGLE",
+     &TraceInvoker<PFNGLGETFRAMEBUFFERPARAMETERIVROBUSTANGLEPROC>::Invoke},
+    {"glGetGraphicsResetStatusEXT", &TraceInvoker<PFNGLGETGRAPHICSRESETSTATUSEXTPROC>::Invoke},
+    {"glGetInteger64i_v", &TraceInvoker<PFNGLGETINTEGER64I_VPROC>::Invoke},
+    {"glGetInteger64i_vRobustANGLE", &TraceInvoker<PFNGLGETINTEGER64I_VROBUSTANGLEPROC>::Invoke},
+    {"glGetInteger64v", &TraceInvoker<PFNGLGETINTEGER64VPROC>::Invoke},
+    {"glGetInteger64vEXT", &TraceInvoker<PFNGLGETINTEGER64VEXTPROC>::Invoke},
+    {"glGetInteger64vRobustANGLE", &TraceInvoker<PFNGLGETINTEGER64VROBUSTANGLEPROC>::Invoke},
+    {"glGetIntegeri_v", &TraceInvoker<PFNGLGETINTEGERI_VPROC>::Invoke},
+    {"glGetIntegeri_vRobustANGLE", &TraceInvoker<PFNGLGETINTEGERI_VROBUSTANGLEPROC>::Invoke},
+    {"glGetIntegerv", &TraceInvoker<PFNGLGETINTEGERVPROC>::Invoke},
+    {"glGetIntegervRobustANGLE", &TraceInvoker<PFNGLGETINTEGERVROBUSTANGLEPROC>::Invoke},
+    {"glGetInternalformativ", &TraceInvoker<PFNGLGETINTERNALFORMATIVPROC>::Invoke},
+    {"glGetInternalformativRobustANGLE",
+     &TraceInvoker<PFNGLGETINTERNALFORMATIVROBUSTANGLEPROC>::Invoke},
+    {"glGetLightfv", &TraceInvoker<PFNGLGETLIGHTFVPROC>::Invoke},
+    {"glGetLightxv", &TraceInvoker<PFNGLGETLIGHTXVPROC>::Invoke},
+    {"glGetMaterialfv", &TraceInvoker<PFNGLGETMATERIALFVPROC>::Invoke},
+    {"glGetMaterialxv", &TraceInvoker<PFNGLGETMATERIALXVPROC>::Invoke},
+    {"glGetMemoryObjectParameterivEXT",
+     &TraceInvoker<PFNGLGETMEMORYOBJECTPARAMETERIVEXTPROC>::Invoke},
+    {"glGetMultisamplefv", &TraceInvoker<PFNGLGETMULTISAMPLEFVPROC>::Invoke},
+    {"glGetMultisamplefvANGLE", &TraceInvoker<PFNGLGETMULTISAMPLEFVANGLEPROC>::Invoke},
+    {"glGetMultisamplefvRobustANGLE", &TraceInvoker<PFNGLGETMULTISAMPLEFVROBUSTANGLEPROC>::Invoke},
+    {"glGetObjectLabelEXT", &TraceInvoker<PFNGLGETOBJECTLABELEXTPROC>::Invoke},
+    {"glGetObjectLabelKHR", &TraceInvoker<PFNGLGETOBJECTLABELKHRPROC>::Invoke},
+    {"glGetObjectPtrLabelKHR", &TraceInvoker<PFNGLGETOBJECTPTRLABELKHRPROC>::Invoke},
+    {"glGetPointerv", &TraceInvoker<PFNGLGETPOINTERVPROC>::Invoke},
+    {"glGetPointervKHR", &TraceInvoker<PFNGLGETPOINTERVKHRPROC>::Invoke},
+    {"glGetPointervRobustANGLERobustANGLE",
+     &TraceInvoker<PFNGLGETPOINTERVROBUSTANGLEROBUSTANGLEPROC>::Invoke},
+    {"glGetProgramBinary", &TraceInvoker<PFNGLGETPROGRAMBINARYPROC>::Invoke},
+    {"glGetProgramBinaryOES", &TraceInvoker<PFNGLGETPROGRAMBINARYOESPROC>::Invoke},
+    {"glGetProgramInfoLog", &TraceInvoker<PFNGLGETPROGRAMINFOLOGPROC>::Invoke},
+    {"glGetProgramInterfaceiv", &TraceInvoker<PFNGLGETPROGRAMINTERFACEIVPROC>::Invoke},
+    {"glGetProgramInterfaceivRobustANGLE",
+     &TraceInvoker<PFNGLGETPROGRAMINTERFACEIVROBUSTANGLEPROC>::Invoke},
+    {"glGetProgramPipelineInfoLog", &TraceInvoker<PFNGLGETPROGRAMPIPELINEINFOLOGPROC>::Invoke},
+    {"glGetProgramPipelineInfoLogEXT",
+     &TraceInvoker<PFNGLGETPROGRAMPIPELINEINFOLOGEXTPROC>::Invoke},
+    {"glGetProgramPipelineiv", &TraceInvoker<PFNGLGETPROGRAMPIPELINEIVPROC>::Invoke},
+    {"glGetProgramPipelineivEXT", &TraceInvoker<PFNGLGETPROGRAMPIPELINEIVEXTPROC>::Invoke},
+    {"glGetProgramResourceIndex", &TraceInvoker<PFNGLGETPROGRAMRESOURCEINDEXPROC>::Invoke},
+    {"glGetProgramResourceLocation", &TraceInvoker<PFNGLGETPROGRAMRESOURCELOCATIONPROC>::Invoke},
+    {"glGetProgramResourceLocationIndexEXT",
+     &TraceInvoker<PFNGLGETPROGRAMRESOURCELOCATIONINDEXEXTPROC>::Invoke},
+    {"glGetProgramResourceName", &TraceInvoker<PFNGLGETPROGRAMRESOURCENAMEPROC>::Invoke},
+    {"glGetProgramResourceiv", &TraceInvoker<PFNGLGETPROGRAMRESOURCEIVPROC>::Invoke},
+    {"glGetProgramiv", &TraceInvoker<PFNGLGETPROGRAMIVPROC>::Invoke},
+    {"glGetProgramivRobustANGLE", &TraceInvoker<PFNGLGETPROGRAMIVROBUSTANGLEPROC>::Invoke},
+    {"glGetQueryObjecti64vEXT", &TraceInvoker<PFNGLGETQUERYOBJECTI64VEXTPROC>::Invoke},
+    {"glGetQueryObjecti64vRobustANGLE",
+     &TraceInvoker<PFNGLGETQUERYOBJECTI64VROBUSTANGLEPROC>::Invoke},
+    {"glGetQueryObjectivEXT", &TraceInvoker<PFNGLGETQUERYOBJECTIVEXTPROC>::Invoke},
+    {"glGetQueryObjectivRobustANGLE", &TraceInvoker<PFNGLGETQUERYOBJECTIVROBUSTANGLEPROC>::Invoke},
+    {"glGetQueryObjectui64vEXT", &TraceInvoker<PFNGLGETQUERYOBJECTUI64VEXTPROC>::Invoke},
+    {"glGetQueryObjectui64vRobustANGLE",
+     &TraceInvoker<PFNGLGETQUERYOBJECTUI64VROBUSTANGLEPROC>::Invoke},
+    {"glGetQueryObjectuiv", &TraceInvoker<PFNGLGETQUERYOBJECTUIVPROC>::Invoke},
+    {"glGetQueryObjectuivEXT", &TraceInvoker<PFNGLGETQUERYOBJECTUIVEXTPROC>::Invoke},
+    {"glGetQueryObjectuivRobustANGLE",
+     &TraceInvoker<PFNGLGETQUERYOBJECTUIVROBUSTANGLEPROC>::Invoke},
+    {"glGetQueryiv", &TraceInvoker<PFNGLGETQUERYIVPROC>::Invoke},
+    {"glGetQueryivEXT", &TraceInvoker<PFNGLGETQUERYIVEXTPROC>::Invoke},
+    {"glGetQueryivRobustANGLE", &TraceInvoker<PFNGLGETQUERYIVROBUSTANGLEPROC>::Invoke},
+    {"glGetRenderbufferImageANGLE", &TraceInvoker<PFNGLGETRENDERBUFFERIMAGEANGLEPROC>::Invoke},
+    {"glGetRenderbufferParameteriv", &TraceInvoker<PFNGLGETRENDERBUFFERPARAMETERIVPROC>::Invoke},
+    {"glGetRenderbufferParameterivOES",
+     &TraceInvoker<PFNGLGETRENDERBUFFERPARAMETERIVOESPROC>::Invoke},
+    {"glGetRenderbufferParameterivRobustANGLE",
+     &TraceInvoker<PFNGLGETRENDERBUFFERPARAMETERIVROBUSTANGLEPROC>::Invoke},
+    {"glGetSamplerParameterIivOES", &TraceInvoker<PFNGLGETSAMPLERPARAMETERIIVOESPROC>::Invoke},
+    {"glGetSamplerParameterIivRobustANGLE",
+     &TraceInvoker<PFNGLGETSAMPLERPARAMETERIIVROBUSTANGLEPROC>::Invoke},
+    {"glGetSamplerParameterIuivOES", &TraceInvoker<PFNGLGETSAMPLERPARAMETERIUIVOESPROC>::Invoke},
+    {"glGetSamplerParameterIuivRobustANGLE",
+     &TraceInvoker<PFNGLGETSAMPLERPARAMETERIUIVROBUSTANGLEPROC>::Invoke},
+    {"glGetSamplerParameterfv", &TraceInvoker<PFNGLGETSAMPLERPARAMETERFVPROC>::Invoke},
+    {"glGetSamplerParameterfvRobustANGLE",
+     &TraceInvoker<PFNGLGETSAMPLERPARAMETERFVROBUSTANGLEPROC>::Invoke},
+    {"glGetSamplerParameteriv", &TraceInvoker<PFNGLGETSAMPLERPARAMETERIVPROC>::Invoke},
+    {"glGetSamplerParameterivRobustANGLE",
+     &TraceInvoker<PFNGLGETSAMPLERPARAMETERIVROBUSTANGLEPROC>::Invoke},
+    {"glGetSemaphoreParameterui64vEXT",
+     &TraceInvoker<PFNGLGETSEMAPHOREPARAMETERUI64VEXTPROC>::Invoke},
+    {"glGetShaderInfoLog", &TraceInvoker<PFNGLGETSHADERINFOLOGPROC>::Invoke},
+    {"glGetShaderPrecisionFormat", &TraceInvoker<PFNGLGETSHADERPRECISIONFORMATPROC>::Invoke},
+    {"glGetShaderSource", &TraceInvoker<PFNGLGETSHADERSOURCEPROC>::Invoke},
+    {"glGetShaderiv", &TraceInvoker<PFNGLGETSHADERIVPROC>::Invoke},
+    {"glGetShaderivRobustANGLE", &TraceInvoker<PFNGLGETSHADERIVROBUSTANGLEPROC>::Invoke},
+    {"glGetString", &TraceInvoker<PFNGLGETSTRINGPROC>::Invoke},
+    {"glGetStringi", &TraceInvoker<PFNGLGETSTRINGIPROC>::Invoke},
+    {"glGetSynciv", &TraceInvoker<PFNGLGETSYNCIVPROC>::Invoke},
+    {"glGetTexEnvfv", &TraceInvoker<PFNGLGETTEXENVFVPROC>::Invoke},
+    {"glGetTexEnviv", &TraceInvoker<PFNGLGETTEXENVIVPROC>::Invoke},
+    {"glGetTexEnvxv", &TraceInvoker<PFNGLGETTEXENVXVPROC>::Invoke},
+    {"glGetTexGenfvOES", &TraceInvoker<PFNGLGETTEXGENFVOESPROC>::Invoke},
+    {"glGetTexGenivOES", &TraceInvoker<PFNGLGETTEXGENIVOESPROC>::Invoke},
+    {"glGetTexGenxvOES", &TraceInvoker<PFNGLGETTEXGENXVOESPROC>::Invoke},
+    {"glGetTexImageANGLE", &TraceInvoker<PFNGLGETTEXIMAGEANGLEPROC>::Invoke},
+    {"glGetTexLevelParameterfv", &TraceInvoker<PFNGLGETTEXLEVELPARAMETERFVPROC>::Invoke},
+    {"glGetTexLevelParameterfvANGLE", &TraceInvoker<PFNGLGETTEXLEVELPARAMETERFVANGLEPROC>::Invoke},
+    {"glGetTexLevelParameterfvRobustANGLE",
+     &TraceInvoker<PFNGLGETTEXLEVELPARAMETERFVROBUSTANGLEPROC>::Invoke},
+    {"glGetTexLevelParameteriv", &TraceInvoker<PFNGLGETTEXLEVELPARAMETERIVPROC>::Invoke},
+    {"glGetTexLevelParameterivANGLE", &TraceInvoker<PFNGLGETTEXLEVELPARAMETERIVANGLEPROC>::Invoke},
+    {"glGetTexLevelParameterivRobustANGLE",
+     &TraceInvoker<PFNGLGETTEXLEVELPARAMETERIVROBUSTANGLEPROC>::Invoke},
+    {"glGetTexParameterIivOES", &TraceInvoker<PFNGLGETTEXPARAMETERIIVOESPROC>::Invoke},
+    {"glGetTexParameterIivRobustANGLE",
+     &TraceInvoker<PFNGLGETTEXPARAMETERIIVROBUSTANGLEPROC>::Invoke},
+    {"glGetTexParameterIuivOES", &TraceInvoker<PFNGLGETTEXPARAMETERIUIVOESPROC>::Invoke},
+    {"glGetTexParameterIuivRobustANGLE",
+     &TraceInvoker<PFNGLGETTEXPARAMETERIUIVROBUSTANGLEPROC>::Invoke},
+    {"glGetTexParameterfv", &TraceInvoker<PFNGLGETTEXPARAMETERFVPROC>::Invoke},
+    {"glGetTexParameterfvRobustANGLE",
+     &TraceInvoker<PFNGLGETTEXPARAMETERFVROBUSTANGLEPROC>::Invoke},
+    {"glGetTexParameteriv", &TraceInvoker<PFNGLGETTEXPARAMETERIVPROC>::Invoke},
+    {"glGetTexParameterivRobustANGLE",
+     &TraceInvoker<PFNGLGETTEXPARAMETERIVROBUSTANGLEPROC>::Invoke},
+    {"glGetTexParameterxv", &TraceInvoker<PFNGLGETTEXPARAMETERXVPROC>::Invoke},
+    {"glGetTransformFeedbackVarying", &TraceInvoker<PFNGLGETTRANSFORMFEEDBACKVARYINGPROC>::Invoke},
+    {"glGetTranslatedShaderSourceANGLE",
+     &TraceInvoker<PFNGLGETTRANSLATEDSHADERSOURCEANGLEPROC>::Invoke},
+    {"glGetUniformBlockIndex", &TraceInvoker<PFNGLGETUNIFORMBLOCKINDEXPROC>::Invoke},
+    {"glGetUniformIndices", &TraceInvoker<PFNGLGETUNIFORMINDICESPROC>::Invoke},
+    {"glGetUniformLocation", &TraceInvoker<PFNGLGETUNIFORMLOCATIONPROC>::Invoke},
+    {"glGetUniformfv", &TraceInvoker<PFNGLGETUNIFORMFVPROC>::Invoke},
+    {"glGetUniformfvRobustANGLE", &TraceInvoker<PFNGLGETUNIFORMFVROBUSTANGLEPROC>::Invoke},
+    {"glGetUniformiv", &TraceInvoker<PFNGLGETUNIFORMIVPROC>::Invoke},
+    {"glGetUniformivRobustANGLE", &TraceInvoker<PFNGLGETUNIFORMIVROBUSTANGLEPROC>::Invoke},
+    {"glGetUniformuiv", &TraceInvoker<PFNGLGETUNIFORMUIVPROC>::Invoke},
+    {"glGetUniformuivRobustANGLE", &TraceInvoker<PFNGLGETUNIFORMUIVROBUSTANGLEPROC>::Invoke},
+    {"glGetUnsignedBytei_vEXT", &TraceInvoker<PFNGLGETUNSIGNEDBYTEI_VEXTPROC>::Invoke},
+    {"glGetUnsignedBytevEXT", &TraceInvoker<PFNGLGETUNSIGNEDBYTEVEXTPROC>::Invoke},
+    {"glGetVertexAttribIiv", &TraceInvoker<PFNGLGETVERTEXATTRIBIIVPROC>::Invoke},
+    {"glGetVertexAttribIivRobustANGLE",
+     &TraceInvoker<PFNGLGETVERTEXATTRIBIIVROBUSTANGLEPROC>::Invoke},
+    {"glGetVertexAttribIuiv", &TraceInvoker<PFNGLGETVERTEXATTRIBIUIVPROC>::Invoke},
+    {"glGetVertexAttribIuivRobustANGLE",
+     &TraceInvoker<PFNGLGETVERTEXATTRIBIUIVROBUSTANGLEPROC>::Invoke},
+    {"glGetVertexAttribPointerv", &TraceInvoker<PFNGLGETVERTEXATTRIBPOINTERVPROC>::Invoke},
+    {"glGetVertexAttribPointervRobustANGLE",
+     &TraceInvoker<PFNGLGETVERTEXATTRIBPOINTERVROBUSTANGLEPROC>::Invoke},
+    {"glGetVertexAttribfv", &TraceInvoker<PFNGLGETVERTEXATTRIBFVPROC>::Invoke},
+    {"glGetVertexAttribfvRobustANGLE",
+     &TraceInvoker<PFNGLGETVERTEXATTRIBFVROBUSTANGLEPROC>::Invoke},
+    {"glGetVertexAttribiv", &TraceInvoker<PFNGLGETVERTEXATTRIBIVPROC>::Invoke},
+    {"glGetVertexAttribivRobustANGLE",
+     &TraceInvoker<PFNGLGETVERTEXATTRIBIVROBUSTANGLEPROC>::Invoke},
+    {"glGetnUniformfvEXT", &TraceInvoker<PFNGLGETNUNIFORMFVEXTPROC>::Invoke},
+    {"glGetnUniformfvRobustANGLE", &TraceInvoker<PFNGLGETNUNIFORMFVROBUSTANGLEPROC>::Invoke},
+    {"glGetnUniformivEXT", &TraceInvoker<PFNGLGETNUNIFORMIVEXTPROC>::Invoke},
+    {"glGetnUniformivRobustANGLE", &TraceInvoker<PFNGLGETNUNIFORMIVROBUSTANGLEPROC>::Invoke},
+    {"glGetnUniformuivRobustANGLE", &TraceInvoker<PFNGLGETNUNIFORMUIVROBUSTANGLEPROC>::Invoke},
+    {"glHint", &TraceInvoker<PFNGLHINTPROC>::Invoke},
+    {"glImportMemoryFdEXT", &TraceInvoker<PFNGLIMPORTMEMORYFDEXTPROC>::Invoke},
+    {"glImportMemoryZirconHandleANGLE",
+     &TraceInvoker<PFNGLIMPORTMEMORYZIRCONHANDLEANGLEPROC>::Invoke},
+    {"glImportSemaphoreFdEXT", &TraceInvoker<PFNGLIMPORTSEMAPHOREFDEXTPROC>::Invoke},
+    {"glImportSemaphoreZirconHandleANGLE",
+     &TraceInvoker<PFNGLIMPORTSEMAPHOREZIRCONHANDLEANGLEPROC>::Invoke},
+    {"glInsertEventMarkerEXT", &TraceInvoker<PFNGLINSERTEVENTMARKEREXTPROC>::Invoke},
+    {"glInvalidateFramebuffer", &TraceInvoker<PFNGLINVALIDATEFRAMEBUFFERPROC>::Invoke},
+    {"glInvalidateSubFramebuffer", &TraceInvoker<PFNGLINVALIDATESUBFRAMEBUFFERPROC>::Invoke},
+    {"glInvalidateTextureANGLE", &TraceInvoker<PFNGLINVALIDATETEXTUREANGLEPROC>::Invoke},
+    {"glIsBuffer", &TraceInvoker<PFNGLISBUFFERPROC>::Invoke},
+    {"glIsEnabled", &TraceInvoker<PFNGLISENABLEDPROC>::Invoke},
+    {"glIsEnablediEXT", &TraceInvoker<PFNGLISENABLEDIEXTPROC>::Invoke},
+    {"glIsEnablediOES", &TraceInvoker<PFNGLISENABLEDIOESPROC>::Invoke},
+    {"glIsFenceNV", &TraceInvoker<PFNGLISFENCENVPROC>::Invoke},
+    {"glIsFramebuffer", &TraceInvoker<PFNGLISFRAMEBUFFERPROC>::Invoke},
+    {"glIsFramebufferOES", &TraceInvoker<PFNGLISFRAMEBUFFEROESPROC>::Invoke},
+    {"glIsMemoryObjectEXT", &TraceInvoker<PFNGLISMEMORYOBJECTEXTPROC>::Invoke},
+    {"glIsProgram", &TraceInvoker<PFNGLISPROGRAMPROC>::Invoke},
+    {"glIsProgramPipeline", &TraceInvoker<PFNGLISPROGRAMPIPELINEPROC>::Invoke},
+    {"glIsProgramPipelineEXT", &TraceInvoker<PFNGLISPROGRAMPIPELINEEXTPROC>::Invoke},
+    {"glIsQuery", &TraceInvoker<PFNGLISQUERYPROC>::Invoke},
+    {"glIsQueryEXT", &TraceInvoker<PFNGLISQUERYEXTPROC>::Invoke},
+    {"glIsRenderbuffer", &TraceInvoker<PFNGLISRENDERBUFFERPROC>::Invoke},
+    {"glIsRenderbufferOES", &TraceInvoker<PFNGLISRENDERBUFFEROESPROC>::Invoke},
+    {"glIsSampler", &TraceInvoker<PFNGLISSAMPLERPROC>::Invoke},
+    {"glIsSemaphoreEXT", &TraceInvoker<PFNGLISSEMAPHOREEXTPROC>::Invoke},
+    {"glIsShader", &TraceInvoker<PFNGLISSHADERPROC>::Invoke},
+    {"glIsSync", &TraceInvoker<PFNGLISSYNCPROC>::Invoke},
+    {"glIsTexture", &TraceInvoker<PFNGLISTEXTUREPROC>::Invoke},
+    {"glIsTransformFeedback", &TraceInvoker<PFNGLISTRANSFORMFEEDBACKPROC>::Invoke},
+    {"glIsVertexArray", &TraceInvoker<PFNGLISVERTEXARRAYPROC>::Invoke},
+    {"glIsVertexArrayOES", &TraceInvoker<PFNGLISVERTEXARRAYOESPROC>::Invoke},
+    {"glLabelObjectEXT", &TraceInvoker<PFNGLLABELOBJECTEXTPROC>::Invoke},
+    {"glLightModelf", &TraceInvoker<PFNGLLIGHTMODELFPROC>::Invoke},
+    {"glLightModelfv", &TraceInvoker<PFNGLLIGHTMODELFVPROC>::Invoke},
+    {"glLightModelx", &TraceInvoker<PFNGLLIGHTMODELXPROC>::Invoke},
+    {"glLightModelxv", &TraceInvoker<PFNGLLIGHTMODELXVPROC>::Invoke},
+    {"glLightf", &TraceInvoker<PFNGLLIGHTFPROC>::Invoke},
+    {"glLightfv", &TraceInvoker<PFNGLLIGHTFVPROC>::Invoke},
+    {"glLightx", &TraceInvoker<PFNGLLIGHTXPROC>::Invoke},
+    {"glLightxv", &TraceInvoker<PFNGLLIGHTXVPROC>::Invoke},
+    {"glLineWidth", &TraceInvoker<PFNGLLINEWIDTHPROC>::Invoke},
+    {"glLineWidthx", &TraceInvoker<PFNGLLINEWIDTHXPROC>::Invoke},
+    {"glLinkProgram", &TraceInvoker<PFNGLLINKPROGRAMPROC>::Invoke},
+    {"glLoadIdentity", &TraceInvoker<PFNGLLOADIDENTITYPROC>::Invoke},
+    {"glLoadMatrixf", &TraceInvoker<PFNGLLOADMATRIXFPROC>::Invoke},
+    {"glLoadMatrixx", &TraceInvoker<PFNGLLOADMATRIXXPROC>::Invoke},
+    {"glLoadPaletteFromModelViewMatrixOES",
+     &TraceInvoker<PFNGLLOADPALETTEFROMMODELVIEWMATRIXOESPROC>::Invoke},
+    {"glLogicOp", &TraceInvoker<PFNGLLOGICOPPROC>::Invoke},
+    {"glLoseContextCHROMIUM", &TraceInvoker<PFNGLLOSECONTEXTCHROMIUMPROC>::Invoke},
+    {"glMapBufferOES", &TraceInvoker<PFNGLMAPBUFFEROESPROC>::Invoke},
+    {"glMapBufferRange", &TraceInvoker<PFNGLMAPBUFFERRANGEPROC>::Invoke},
+    {"glMapBufferRangeEXT", &TraceInvoker<PFNGLMAPBUFFERRANGEEXTPROC>::Invoke},
+    {"glMaterialf", &TraceInvoker<PFNGLMATERIALFPROC>::Invoke},
+    {"glMaterialfv", &TraceInvoker<PFNGLMATERIALFVPROC>::Invoke},
+    {"glMaterialx", &TraceInvoker<PFNGLMATERIALXPROC>::Invoke},
+    {"glMaterialxv", &TraceInvoker<PFNGLMATERIALXVPROC>::Invoke},
+    {"glMatrixIndexPointerOES", &TraceInvoker<PFNGLMATRIXINDEXPOINTEROESPROC>::Invoke},
+    {"glMatrixMode", &TraceInvoker<PFNGLMATRIXMODEPROC>::Invoke},
+    {"glMaxShaderCompilerThreadsKHR", &TraceInvoker<PFNGLMAXSHADERCOMPILERTHREADSKHRPROC>::Invoke},
+    {"glMemoryBarrier", &TraceInvoker<PFNGLMEMORYBARRIERPROC>::Invoke},
+    {"glMemoryBarrierByRegion", &TraceInvoker<PFNGLMEMORYBARRIERBYREGIONPROC>::Invoke},
+    {"glMemoryObjectParameterivEXT", &TraceInvoker<PFNGLMEMORYOBJECTPARAMETERIVEXTPROC>::Invoke},
+    {"glMinSampleShadingOES", &TraceInvoker<PFNGLMINSAMPLESHADINGOESPROC>::Invoke},
+    {"glMultMatrixf", &TraceInvoker<PFNGLMULTMATRIXFPROC>::Invoke},
+    {"glMultMatrixx", &TraceInvoker<PFNGLMULTMATRIXXPROC>::Invoke},
+    {"glMultiDrawArraysANGLE", &TraceInvoker<PFNGLMULTIDRAWARRAYSANGLEPROC>::Invoke},
+    {"glMultiDrawArraysInstancedANGLE",
+     &TraceInvoker<PFNGLMULTIDRAWARRAYSINSTANCEDANGLEPROC>::Invoke},
+    {"glMultiDrawArraysInstancedBaseInstanceANGLE",
+     &TraceInvoker<PFNGLMULTIDRAWARRAYSINSTANCEDBASEINSTANCEANGLEPROC>::Invoke},
+    {"glMultiDrawElementsANGLE", &TraceInvoker<PFNGLMULTIDRAWELEMENTSANGLEPROC>::Invoke},
+    {"glMultiDrawElementsBaseVertexEXT",
+     &TraceInvoker<PFNGLMULTIDRAWELEMENTSBASEVERTEXEXTPROC>::Invoke},
+    {"glMultiDrawElementsInstancedANGLE",
+     &TraceInvoker<PFNGLMULTIDRAWELEMENTSINSTANCEDANGLEPROC>::Invoke},
+    {"glMultiDrawElementsInstancedBaseVertexBaseInstanceANGLE",
+     &TraceInvoker<PFNGLMULTIDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEANGLEPROC>::Invoke},
+    {"glMultiTexCoord4f", &TraceInvoker<PFNGLMULTITEXCOORD4FPROC>::Invoke},
+    {"glMultiTexCoord4x", &TraceInvoker<PFNGLMULTITEXCOORD4XPROC>::Invoke},
+    {"glNamedBufferStorageExternalEXT",
+     &TraceInvoker<PFNGLNAMEDBUFFERSTORAGEEXTERNALEXTPROC>::Invoke},
+    {"glNormal3f", &TraceInvoker<PFNGLNORMAL3FPROC>::Invoke},
+    {"glNormal3x", &TraceInvoker<PFNGLNORMAL3XPROC>::Invoke},
+    {"glNormalPointer", &TraceInvoker<PFNGLNORMALPOINTERPROC>::Invoke},
+    {"glObjectLabelKHR", &TraceInvoker<PFNGLOBJECTLABELKHRPROC>::Invoke},
+    {"glObjectPtrLabelKHR", &TraceInvoker<PFNGLOBJECTPTRLABELKHRPROC>::Invoke},
+    {"glOrthof", &TraceInvoker<PFNGLORTHOFPROC>::Invoke},
+    {"glOrthox", &TraceInvoker<PFNGLORTHOXPROC>::Invoke},
+    {"glPatchParameteriEXT", &TraceInvoker<PFNGLPATCHPARAMETERIEXTPROC>::Invoke},
+    {"glPauseTransformFeedback", &TraceInvoker<PFNGLPAUSETRANSFORMFEEDBACKPROC>::Invoke},
+    {"glPixelStorei", &TraceInvoker<PFNGLPIXELSTOREIPROC>::Invoke},
+    {"glPointParameterf", &TraceInvoker<PFNGLPOINTPARAMETERFPROC>::Invoke},
+    {"glPointParameterfv", &TraceInvoker<PFNGLPOINTPARAMETERFVPROC>::Invoke},
+    {"glPointParameterx", &TraceInvoker<PFNGLPOINTPARAMETERXPROC>::Invoke},
+    {"glPointParameterxv", &TraceInvoker<PFNGLPOINTPARAMETERXVPROC>::Invoke},
+    {"glPointSize", &TraceInvoker<PFNGLPOINTSIZEPROC>::Invoke},
+    {"glPointSizePointerOES", &TraceInvoker<PFNGLPOINTSIZEPOINTEROESPROC>::Invoke},
+    {"glPointSizex", &TraceInvoker<PFNGLPOINTSIZEXPROC>::Invoke},
+    {"glPolygonOffset", &TraceInvoker<PFNGLPOLYGONOFFSETPROC>::Invoke},
+    {"glPolygonOffsetx", &TraceInvoker<PFNGLPOLYGONOFFSETXPROC>::Invoke},
+    {"glPopDebugGroupKHR", &TraceInvoker<PFNGLPOPDEBUGGROUPKHRPROC>::Invoke},
+    {"glPopGroupMarkerEXT", &TraceInvoker<PFNGLPOPGROUPMARKEREXTPROC>::Invoke},
+    {"glPopMatrix", &TraceInvoker<PFNGLPOPMATRIXPROC>::Invoke},
+    {"glProgramBinary", &TraceInvoker<PFNGLPROGRAMBINARYPROC>::Invoke},
+    {"glProgramBinaryOES", &TraceInvoker<PFNGLPROGRAMBINARYOESPROC>::Invoke},
+    {"glProgramParameteri", &TraceInvoker<PFNGLPROGRAMPARAMETERIPROC>::Invoke},
+    {"glProgramParameteriEXT", &TraceInvoker<PFNGLPROGRAMPARAMETERIEXTPROC>::Invoke},
+    {"glProgramUniform1f", &TraceInvoker<PFNGLPROGRAMUNIFORM1FPROC>::Invoke},
+    {"glProgramUniform1fEXT", &TraceInvoker<PFNGLPROGRAMUNIFORM1FEXTPROC>::Invoke},
+    {"glProgramUniform1fv", &TraceInvoker<PFNGLPROGRAMUNIFORM1FVPROC>::Invoke},
+    {"glProgramUniform1fvEXT", &TraceInvoker<PFNGLPROGRAMUNIFORM1FVEXTPROC>::Invoke},
+    {"glProgramUniform1i", &TraceInvoker<PFNGLPROGRAMUNIFORM1IPROC>::Invoke},
+    {"glProgramUniform1iEXT", &TraceInvoker<PFNGLPROGRAMUNIFORM1IEXTPROC>::Invoke},
+    {"glProgramUniform1iv", &TraceInvoker<PFNGLPROGRAMUNIFORM1IVPROC>::Invoke},
+    {"glProgramUniform1ivEXT", &TraceInvoker<PFNGLPROGRAMUNIFORM1IVEXTPROC>::Invoke},
+    {"glProgramUniform1ui", &TraceInvoker<PFNGLPROGRAMUNIFORM1UIPROC>::Invoke},
+    {"glProgramUniform1uiEXT", &TraceInvoker<PFNGLPROGRAMUNIFORM1UIEXTPROC>::Invoke},
+    {"glProgramUniform1uiv", &TraceInvoker<PFNGLPROGRAMUNIFORM1UIVPROC>::Invoke},
+    {"glProgramUniform1uivEXT", &TraceInvoker<PFNGLPROGRAMUNIFORM1UIVEXTPROC>::Invoke},
+    {"glProgramUniform2f", &TraceInvoker<PFNGLPROGRAMUNIFORM2FPROC>::Invoke},
+    {"glProgramUniform2fEXT", &TraceInvoker<PFNGLPROGRAMUNIFORM2FEXTPROC>::Invoke},
+    {"glProgramUniform2fv", &TraceInvoker<PFNGLPROGRAMUNIFORM2FVPROC>::Invoke},
+    {"glProgramUniform2fvEXT", &TraceInvoker<PFNGLPROGRAMUNIFORM2FVEXTPROC>::Invoke},
+    {"glProgramUniform2i", &TraceInvoker<PFNGLPROGRAMUNIFORM2IPROC>::Invoke},
+    {"glProgramUniform2iEXT", &TraceInvoker<PFNGLPROGRAMUNIFORM2IEXTPROC>::Invoke},
+    {"glProgramUniform2iv", &TraceInvoker<PFNGLPROGRAMUNIFORM2IVPROC>::Invoke},
+    {"glProgramUniform2ivEXT", &TraceInvoker<PFNGLPROGRAMUNIFORM2IVEXTPROC>::Invoke},
+    {"glProgramUniform2ui", &TraceInvoker<PFNGLPROGRAMUNIFORM2UIPROC>::Invoke},
+    {"glProgramUniform2uiEXT", &TraceInvoker<PFNGLPROGRAMUNIFORM2UIEXTPROC>::Invoke},
+    {"glProgramUniform2uiv", &TraceInvoker<PFNGLPROGRAMUNIFORM2UIVPROC>::Invoke},
+    {"glProgramUniform2uivEXT", &TraceInvoker<PFNGLPROGRAMUNIFORM2UIVEXTPROC>::Invoke},
+    {"glProgramUniform3f", &TraceInvoker<PFNGLPROGRAMUNIFORM3FPROC>::Invoke},
+    {"glProgramUniform3fEXT", &TraceInvoker<PFNGLPROGRAMUNIFORM3FEXTPROC>::Invoke},
+    {"glProgramUniform3fv", &TraceInvoker<PFNGLPROGRAMUNIFORM3FVPROC>::Invoke},
+    {"glProgramUniform3fvEXT", &TraceInvoker<PFNGLPROGRAMUNIFORM3FVEXTPROC>::Invoke},
+    {"glProgramUniform3i", &TraceInvoker<PFNGLPROGRAMUNIFORM3IPROC>::Invoke},
+    {"glProgramUniform3iEXT", &TraceInvoker<PFNGLPROGRAMUNIFORM3IEXTPROC>::Invoke},
+    {"glProgramUniform3iv", &TraceInvoker<PFNGLPROGRAMUNIFORM3IVPROC>::Invoke},
+    {"glProgramUniform3ivEXT", &TraceInvoker<PFNGLPROGRAMUNIFORM3IVEXTPROC>::Invoke},
+    {"glProgramUniform3ui", &TraceInvoker<PFNGLPROGRAMUNIFORM3UIPROC>::Invoke},
+    {"glProgramUniform3uiEXT", &TraceInvoker<PFNGLPROGRAMUNIFORM3UIEXTPROC>::Invoke},
+    {"glProgramUniform3uiv", &TraceInvoker<PFNGLPROGRAMUNIFORM3UIVPROC>::Invoke},
+    {"glProgramUniform3uivEXT", &TraceInvoker<PFNGLPROGRAMUNIFORM3UIVEXTPROC>::Invoke},
+    {"glProgramUniform4f", &TraceInvoker<PFNGLPROGRAMUNIFORM4FPROC>::Invoke},
+    {"glProgramUniform4fEXT", &TraceInvoker<PFNGLPROGRAMUNIFORM4FEXTPROC>::Invoke},
+    {"glProgramUniform4fv", &TraceInvoker<PFNGLPROGRAMUNIFORM4FVPROC>::Invoke},
+    {"glProgramUniform4fvEXT", &TraceInvoker<PFNGLPROGRAMUNIFORM4FVEXTPROC>::Invoke},
+    {"glProgramUniform4i", &TraceInvoker<PFNGLPROGRAMUNIFORM4IPROC>::Invoke},
+    {"glProgramUniform4iEXT", &TraceInvoker<PFNGLPROGRAMUNIFORM4IEXTPROC>::Invoke},
+    {"glProgramUniform4iv", &TraceInvoker<PFNGLPROGRAMUNIFORM4IVPROC>::Invoke},
+    {"glProgramUniform4ivEXT", &TraceInvoker<PFNGLPROGRAMUNIFORM4IVEXTPROC>::Invoke},
+    {"glProgramUniform4ui", &TraceInvoker<PFNGLPROGRAMUNIFORM4UIPROC>::Invoke},
+    {"glProgramUniform4uiEXT", &TraceInvoker<PFNGLPROGRAMUNIFORM4UIEXTPROC>::Invoke},
+    {"glProgramUniform4uiv", &TraceInvoker<PFNGLPROGRAMUNIFORM4UIVPROC>::Invoke},
+    {"glProgramUniform4uivEXT", &TraceInvoker<PFNGLPROGRAMUNIFORM4UIVEXTPROC>::Invoke},
+    {"glProgramUniformMatrix2fv", &TraceInvoker<PFNGLPROGRAMUNIFORMMATRIX2FVPROC>::Invoke},
+    {"glProgramUniformMatrix2fvEXT", &TraceInvoker<PFNGLPROGRAMUNIFORMMATRIX2FVEXTPROC>::Invoke},
+    {"glProgramUniformMatrix2x3fv", &TraceInvoker<PFNGLPROGRAMUNIFORMMATRIX2X3FVPROC>::Invoke},
+    {"glProgramUniformMatrix2x3fvEXT",
+     &TraceInvoker<PFNGLPROGRAMUNIFORMMATRIX2X3FVEXTPROC>::Invoke},
+    {"glProgramUniformMatrix2x4fv", &TraceInvoker<PFNGLPROGRAMUNIFORMMATRIX2X4FVPROC>::Invoke},
+    {"glProgramUniformMatrix2x4fvEXT",
+     &TraceInvoker<PFNGLPROGRAMUNIFORMMATRIX2X4FVEXTPROC>::Invoke},
+    {"glProgramUniformMatrix3fv", &TraceInvoker<PFNGLPROGRAMUNIFORMMATRIX3FVPROC>::Invoke},
+    {"glProgramUniformMatrix3fvEXT", &TraceInvoker<PFNGLPROGRAMUNIFORMMATRIX3FVEXTPROC>::Invoke},
+    {"glProgramUniformMatrix3x2fv", &TraceInvoker<PFNGLPROGRAMUNIFORMMATRIX3X2FVPROC>::Invoke},
+    {"glProgramUniformMatrix3x2fvEXT",
+     &TraceInvoker<PFNGLPROGRAMUNIFORMMATRIX3X2FVEXTPROC>::Invoke},
+    {"glProgramUniformMatrix3x4fv", &TraceInvoker<PFNGLPROGRAMUNIFORMMATRIX3X4FVPROC>::Invoke},
+    {"glProgramUniformMatrix3x4fvEXT",
+     &TraceInvoker<PFNGLPROGRAMUNIFORMMATRIX3X4FVEXTPROC>::Invoke},
+    {"glProgramUniformMatrix4fv", &TraceInvoker<PFNGLPROGRAMUNIFORMMATRIX4FVPROC>::Invoke},
+    {"glProgramUniformMatrix4fvEXT", &TraceInvoker<PFNGLPROGRAMUNIFORMMATRIX4FVEXTPROC>::Invoke},
+    {"glProgramUniformMatrix4x2fv", &TraceInvoker<PFNGLPROGRAMUNIFORMMATRIX4X2FVPROC>::Invoke},
+    {"glProgramUniformMatrix4x2fvEXT",
+     &TraceInvoker<PFNGLPROGRAMUNIFORMMATRIX4X2FVEXTPROC>::Invoke},
+    {"glProgramUniformMatrix4x3fv", &TraceInvoker<PFNGLPROGRAMUNIFORMMATRIX4X3FVPROC>::Invoke},
+    {"glProgramUniformMatrix4x3fvEXT",
+     &TraceInvoker<PFNGLPROGRAMUNIFORMMATRIX4X3FVEXTPROC>::Invoke},
+    {"glProvokingVertexANGLE", &TraceInvoker<PFNGLPROVOKINGVERTEXANGLEPROC>::Invoke},
+    {"glPushDebugGroupKHR", &TraceInvoker<PFNGLPUSHDEBUGGROUPKHRPROC>::Invoke},
+    {"glPushGroupMarkerEXT", &TraceInvoker<PFNGLPUSHGROUPMARKEREXTPROC>::Invoke},
+    {"glPushMatrix", &TraceInvoker<PFNGLPUSHMATRIXPROC>::Invoke},
+    {"glQueryCounterEXT", &TraceInvoker<PFNGLQUERYCOUNTEREXTPROC>::Invoke},
+    {"glQueryMatrixxOES", &TraceInvoker<PFNGLQUERYMATRIXXOESPROC>::Invoke},
+    {"glReadBuffer", &TraceInvoker<PFNGLREADBUFFERPROC>::Invoke},
+    {"glReadPixels", &TraceInvoker<PFNGLREADPIXELSPROC>::Invoke},
+    {"glReadPixelsRobustANGLE", &TraceInvoker<PFNGLREADPIXELSROBUSTANGLEPROC>::Invoke},
+    {"glReadnPixelsEXT", &TraceInvoker<PFNGLREADNPIXELSEXTPROC>::Invoke},
+    {"glReadnPixelsRobustANGLE", &TraceInvoker<PFNGLREADNPIXELSROBUSTANGLEPROC>::Invoke},
+    {"glReleaseShaderCompiler", &TraceInvoker<PFNGLRELEASESHADERCOMPILERPROC>::Invoke},
+    {"glRenderbufferStorage", &TraceInvoker<PFNGLRENDERBUFFERSTORAGEPROC>::Invoke},
+    {"glRenderbufferStorageMultisample",
+     &TraceInvoker<PFNGLRENDERBUFFERSTORAGEMULTISAMPLEPROC>::Invoke},
+    {"glRenderbufferStorageMultisampleANGLE",
+     &TraceInvoker<PFNGLRENDERBUFFERSTORAGEMULTISAMPLEANGLEPROC>::Invoke},
+    {"glRenderbufferStorageMultisampleEXT",
+     &TraceInvoker<PFNGLRENDERBUFFERSTORAGEMULTISAMPLEEXTPROC>::Invoke},
+    {"glRenderbufferStorageOES", &TraceInvoker<PFNGLRENDERBUFFERSTORAGEOESPROC>::Invoke},
+    {"glRequestExtensionANGLE", &TraceInvoker<PFNGLREQUESTEXTENSIONANGLEPROC>::Invoke},
+    {"glResumeTransformFeedback", &TraceInvoker<PFNGLRESUMETRANSFORMFEEDBACKPROC>::Invoke},
+    {"glRotatef", &TraceInvoker<PFNGLROTATEFPROC>::Invoke},
+    {"glRotatex", &TraceInvoker<PFNGLROTATEXPROC>::Invoke},
+    {"glSampleCoverage", &TraceInvoker<PFNGLSAMPLECOVERAGEPROC>::Invoke},
+    {"glSampleCoveragex", &TraceInvoker<PFNGLSAMPLECOVERAGEXPROC>::Invoke},
+    {"glSampleMaski", &TraceInvoker<PFNGLSAMPLEMASKIPROC>::Invoke},
+    {"glSampleMaskiANGLE", &TraceInvoker<PFNGLSAMPLEMASKIANGLEPROC>::Invoke},
+    {"glSamplerParameterIivOES", &TraceInvoker<PFNGLSAMPLERPARAMETERIIVOESPROC>::Invoke},
+    {"glSamplerParameterIivRobustANGLE",
+     &TraceInvoker<PFNGLSAMPLERPARAMETERIIVROBUSTANGLEPROC>::Invoke},
+    {"glSamplerParameterIuivOES", &TraceInvoker<PFNGLSAMPLERPARAMETERIUIVOESPROC>::Invoke},
+    {"glSamplerParameterIuivRobustANGLE",
+     &TraceInvoker<PFNGLSAMPLERPARAMETERIUIVROBUSTANGLEPROC>::Invoke},
+    {"glSamplerParameterf", &TraceInvoker<PFNGLSAMPLERPARAMETERFPROC>::Invoke},
+    {"glSamplerParameterfv", &TraceInvoker<PFNGLSAMPLERPARAMETERFVPROC>::Invoke},
+    {"glSamplerParameterfvRobustANGLE",
+     &TraceInvoker<PFNGLSAMPLERPARAMETERFVROBUSTANGLEPROC>::Invoke},
+    {"glSamplerParameteri", &TraceInvoker<PFNGLSAMPLERPARAMETERIPROC>::Invoke},
+    {"glSamplerParameteriv", &TraceInvoker<PFNGLSAMPLERPARAMETERIVPROC>::Invoke},
+    {"glSamplerParameterivRobustANGLE",
+     &TraceInvoker<PFNGLSAMPLERPARAMETERIVROBUSTANGLEPROC>::Invoke},
+    {"glScalef", &TraceInvoker<PFNGLSCALEFPROC>::Invoke},
+    {"glScalex", &TraceInvoker<PFNGLSCALEXPROC>::Invoke},
+    {"glScissor", &TraceInvoker<PFNGLSCISSORPROC>::Invoke},
+    {"glSemaphoreParameterui64vEXT", &TraceInvoker<PFNGLSEMAPHOREPARAMETERUI64VEXTPROC>::Invoke},
+    {"glSetFenceNV", &TraceInvoker<PFNGLSETFENCENVPROC>::Invoke},
+    {"glShadeModel", &TraceInvoker<PFNGLSHADEMODELPROC>::Invoke},
+    {"glShaderBinary", &TraceInvoker<PFNGLSHADERBINARYPROC>::Invoke},
+    {"glShaderSource", &TraceInvoker<PFNGLSHADERSOURCEPROC>::Invoke},
+    {"glSignalSemaphoreEXT", &TraceInvoker<PFNGLSIGNALSEMAPHOREEXTPROC>::Invoke},
+    {"glStencilFunc", &TraceInvoker<PFNGLSTENCILFUNCPROC>::Invoke},
+    {"glStencilFuncSeparate", &TraceInvoker<PFNGLSTENCILFUNCSEPARATEPROC>::Invoke},
+    {"glStencilMask", &TraceInvoker<PFNGLSTENCILMASKPROC>::Invoke},
+    {"glStencilMaskSeparate", &TraceInvoker<PFNGLSTENCILMASKSEPARATEPROC>::Invoke},
+    {"glStencilOp", &TraceInvoker<PFNGLSTENCILOPPROC>::Invoke},
+    {"glStencilOpSeparate", &TraceInvoker<PFNGLSTENCILOPSEPARATEPROC>::Invoke},
+    {"glTestFenceNV", &TraceInvoker<PFNGLTESTFENCENVPROC>::Invoke},
+    {"glTexBufferEXT", &TraceInvoker<PFNGLTEXBUFFEREXTPROC>::Invoke},
+    {"glTexBufferOES", &TraceInvoker<PFNGLTEXBUFFEROESPROC>::Invoke},
+    {"glTexBufferRangeEXT", &TraceInvoker<PFNGLTEXBUFFERRANGEEXTPROC>::Invoke},
+    {"glTexBufferRangeOES", &TraceInvoker<PFNGLTEXBUFFERRANGEOESPROC>::Invoke},
+    {"glTexCoordPointer", &TraceInvoker<PFNGLTEXCOORDPOINTERPROC>::Invoke},
+    {"glTexEnvf", &TraceInvoker<PFNGLTEXENVFPROC>::Invoke},
+    {"glTexEnvfv", &TraceInvoker<PFNGLTEXENVFVPROC>::Invoke},
+    {"glTexEnvi", &TraceInvoker<PFNGLTEXENVIPROC>::Invoke},
+    {"glTexEnviv", &TraceInvoker<PFNGLTEXENVIVPROC>::Invoke},
+    {"glTexEnvx", &TraceInvoker<PFNGLTEXENVXPROC>::Invoke},
+    {"glTexEnvxv", &TraceInvoker<PFNGLTEXENVXVPROC>::Invoke},
+    {"glTexGenfOES", &TraceInvoker<PFNGLTEXGENFOESPROC>::Invoke},
+    {"glTexGenfvOES", &TraceInvoker<PFNGLTEXGENFVOESPROC>::Invoke},
+    {"glTexGeniOES", &TraceInvoker<PFNGLTEXGENIOESPROC>::Invoke},
+    {"glTexGenivOES", &TraceInvoker<PFNGLTEXGENIVOESPROC>::Invoke},
+    {"glTexGenxOES", &TraceInvoker<PFNGLTEXGENXOESPROC>::Invoke},
+    {"glTexGenxvOES", &TraceInvoker<PFNGLTEXGENXVOESPROC>::Invoke},
+    {"glTexImage2D", &TraceInvoker<PFNGLTEXIMAGE2DPROC>::Invoke},
+    {"glTexImage2DExternalANGLE", &TraceInvoker<PFNGLTEXIMAGE2DEXTERNALANGLEPROC>::Invoke},
+    {"glTexImage2DRobustANGLE", &TraceInvoker<PFNGLTEXIMAGE2DROBUSTANGLEPROC>::Invoke},
+    {"glTexImage3D", &TraceInvoker<PFNGLTEXIMAGE3DPROC>::Invoke},
+    {"glTexImage3DOES", &TraceInvoker<PFNGLTEXIMAGE3DOESPROC>::Invoke},
+    {"glTexImage3DRobustANGLE", &TraceInvoker<PFNGLTEXIMAGE3DROBUSTANGLEPROC>::Invoke},
+    {"glTexParameterIivOES", &TraceInvoker<PFNGLTEXPARAMETERIIVOESPROC>::Invoke},
+    {"glTexParameterIivRobustANGLE", &TraceInvoker<PFNGLTEXPARAMETERIIVROBUSTANGLEPROC>::Invoke},
+    {"glTexParameterIuivOES", &TraceInvoker<PFNGLTEXPARAMETERIUIVOESPROC>::Invoke},
+    {"glTexParameterIuivRobustANGLE", &TraceInvoker<PFNGLTEXPARAMETERIUIVROBUSTANGLEPROC>::Invoke},
+    {"glTexParameterf", &TraceInvoker<PFNGLTEXPARAMETERFPROC>::Invoke},
+    {"glTexParameterfv", &TraceInvoker<PFNGLTEXPARAMETERFVPROC>::Invoke},
+    {"glTexParameterfvRobustANGLE", &TraceInvoker<PFNGLTEXPARAMETERFVROBUSTANGLEPROC>::Invoke},
+    {"glTexParameteri", &TraceInvoker<PFNGLTEXPARAMETERIPROC>::Invoke},
+    {"glTexParameteriv", &TraceInvoker<PFNGLTEXPARAMETERIVPROC>::Invoke},
+    {"glTexParameterivRobustANGLE", &TraceInvoker<PFNGLTEXPARAMETERIVROBUSTANGLEPROC>::Invoke},
+    {"glTexParameterx", &TraceInvoker<PFNGLTEXPARAMETERXPROC>::Invoke},
+    {"glTexParameterxv", &TraceInvoker<PFNGLTEXPARAMETERXVPROC>::Invoke},
+    {"glTexStorage1DEXT", &TraceInvoker<PFNGLTEXSTORAGE1DEXTPROC>::Invoke},
+    {"glTexStorage2D", &TraceInvoker<PFNGLTEXSTORAGE2DPROC>::Invoke},
+    {"glTexStorage2DEXT", &TraceInvoker<PFNGLTEXSTORAGE2DEXTPROC>::Invoke},
+    {"glTexStorage2DMultisample", &TraceInvoker<PFNGLTEXSTORAGE2DMULTISAMPLEPROC>::Invoke},
+    {"glTexStorage2DMultisampleANGLE",
+     &TraceInvoker<PFNGLTEXSTORAGE2DMULTISAMPLEANGLEPROC>::Invoke},
+    {"glTexStorage3D", &TraceInvoker<PFNGLTEXSTORAGE3DPROC>::Invoke},
+    {"glTexStorage3DEXT", &TraceInvoker<PFNGLTEXSTORAGE3DEXTPROC>::Invoke},
+    {"glTexStorage3DMultisampleOES", &TraceInvoker<PFNGLTEXSTORAGE3DMULTISAMPLEOESPROC>::Invoke},
+    {"glTexStorageMem2DEXT", &TraceInvoker<PFNGLTEXSTORAGEMEM2DEXTPROC>::Invoke},
+    {"glTexStorageMem2DMultisampleEXT",
+     &TraceInvoker<PFNGLTEXSTORAGEMEM2DMULTISAMPLEEXTPROC>::Invoke},
+    {"glTexStorageMem3DEXT", &TraceInvoker<PFNGLTEXSTORAGEMEM3DEXTPROC>::Invoke},
+    {"glTexStorageMem3DMultisampleEXT",
+     &TraceInvoker<PFNGLTEXSTORAGEMEM3DMULTISAMPLEEXTPROC>::Invoke},
+    {"glTexStorageMemFlags2DANGLE", &TraceInvoker<PFNGLTEXSTORAGEMEMFLAGS2DANGLEPROC>::Invoke},
+    {"glTexStorageMemFlags2DMultisampleANGLE",
+     &TraceInvoker<PFNGLTEXSTORAGEMEMFLAGS2DMULTISAMPLEANGLEPROC>::Invoke},
+    {"glTexStorageMemFlags3DANGLE", &TraceInvoker<PFNGLTEXSTORAGEMEMFLAGS3DANGLEPROC>::Invoke},
+    {"glTexStorageMemFlags3DMultisampleANGLE",
+     &TraceInvoker<PFNGLTEXSTORAGEMEMFLAGS3DMULTISAMPLEANGLEPROC>::Invoke},
+    {"glTexSubImage2D", &TraceInvoker<PFNGLTEXSUBIMAGE2DPROC>::Invoke},
+    {"glTexSubImage2DRobustANGLE", &TraceInvoker<PFNGLTEXSUBIMAGE2DROBUSTANGLEPROC>::Invoke},
+    {"glTexSubImage3D", &TraceInvoker<PFNGLTEXSUBIMAGE3DPROC>::Invoke},
+    {"glTexSubImage3DOES", &TraceInvoker<PFNGLTEXSUBIMAGE3DOESPROC>::Invoke},
+    {"glTexSubImage3DRobustANGLE", &TraceInvoker<PFNGLTEXSUBIMAGE3DROBUSTANGLEPROC>::Invoke},
+    {"glTransformFeedbackVaryings", &TraceInvoker<PFNGLTRANSFORMFEEDBACKVARYINGSPROC>::Invoke},
+    {"glTranslatef", &TraceInvoker<PFNGLTRANSLATEFPROC>::Invoke},
+    {"glTranslatex", &TraceInvoker<PFNGLTRANSLATEXPROC>::Invoke},
+    {"glUniform1f", &TraceInvoker<PFNGLUNIFORM1FPROC>::Invoke},
+    {"glUniform1fv", &TraceInvoker<PFNGLUNIFORM1FVPROC>::Invoke},
+    {"glUniform1i", &TraceInvoker<PFNGLUNIFORM1IPROC>::Invoke},
+    {"glUniform1iv", &TraceInvoker<PFNGLUNIFORM1IVPROC>::Invoke},
+    {"glUniform1ui", &TraceInvoker<PFNGLUNIFORM1UIPROC>::Invoke},
+    {"glUniform1uiv", &TraceInvoker<PFNGLUNIFORM1UIVPROC>::Invoke},
+    {"glUniform2f", &TraceInvoker<PFNGLUNIFORM2FPROC>::Invoke},
+    {"glUniform2fv", &TraceInvoker<PFNGLUNIFORM2FVPROC>::Invoke},
+    {"glUniform2i", &TraceInvoker<PFNGLUNIFORM2IPROC>::Invoke},
+    {"glUniform2iv", &TraceInvoker<PFNGLUNIFORM2IVPROC>::Invoke},
+    {"glUniform2ui", &TraceInvoker<PFNGLUNIFORM2UIPROC>::Invoke},
+    {"glUniform2uiv", &TraceInvoker<PFNGLUNIFORM2UIVPROC>::Invoke},
+    {"glUniform3f", &TraceInvoker<PFNGLUNIFORM3FPROC>::Invoke},
+    {"glUniform3fv", &TraceInvoker<PFNGLUNIFORM3FVPROC>::Invoke},
+    {"glUniform3i", &TraceInvoker<PFNGLUNIFORM3IPROC>::Invoke},
+    {"glUniform3iv", &TraceInvoker<PFNGLUNIFORM3IVPROC>::Invoke},
+    {"glUniform3ui", &TraceInvoker<PFNGLUNIFORM3UIPROC>::Invoke},
+    {"glUniform3uiv", &TraceInvoker<PFNGLUNIFORM3UIVPROC>::Invoke},
+    {"glUniform4f", &TraceInvoker<PFNGLUNIFORM4FPROC>::Invoke},
+    {"glUniform4fv", &TraceInvoker<PFNGLUNIFORM4FVPROC>::Invoke},
+    {"glUniform4i", &TraceInvoker<PFNGLUNIFORM4IPROC>::Invoke},
+    {"glUniform4iv", &TraceInvoker<PFNGLUNIFORM4IVPROC>::Invoke},
+    {"glUniform4ui", &TraceInvoker<PFNGLUNIFORM4UIPROC>::Invoke},
+    {"glUniform4uiv", &TraceInvoker<PFNGLUNIFORM4UIVPROC>::Invoke},
+    {"glUniformBlockBinding", &TraceInvoker<PFNGLUNIFORMBLOCKBINDINGPROC>::Invoke},
+    {"glUniformMatrix2fv", &TraceInvoker<PFNGLUNIFORMMATRIX2FVPROC>::Invoke},
+    {"glUniformMatrix2x3fv", &TraceInvoker<PFNGLUNIFORMMATRIX2X3FVPROC>::Invoke},
+    {"glUniformMatrix2x4fv", &TraceInvoker<PFNGLUNIFORMMATRIX2X4FVPROC>::Invoke},
+    {"glUniformMatrix3fv", &TraceInvoker<PFNGLUNIFORMMATRIX3FVPROC>::Invoke},
+    {"glUniformMatrix3x2fv", &TraceInvoker<PFNGLUNIFORMMATRIX3X2FVPROC>::Invoke},
+    {"glUniformMatrix3x4fv", &TraceInvoker<PFNGLUNIFORMMATRIX3X4FVPROC>::Invoke},
+    {"glUniformMatrix4fv", &TraceInvoker<PFNGLUNIFORMMATRIX4FVPROC>::Invoke},
+    {"glUniformMatrix4x2fv", &TraceInvoker<PFNGLUNIFORMMATRIX4X2FVPROC>::Invoke},
+    {"glUniformMatrix4x3fv", &TraceInvoker<PFNGLUNIFORMMATRIX4X3FVPROC>::Invoke},
+    {"glUnmapBuffer", &TraceInvoker<PFNGLUNMAPBUFFERPROC>::Invoke},
+    {"glUnmapBufferOES", &TraceInvoker<PFNGLUNMAPBUFFEROESPROC>::Invoke},
+    {"glUseProgram", &TraceInvoker<PFNGLUSEPROGRAMPROC>::Invoke},
+    {"glUseProgramStages", &TraceInvoker<PFNGLUSEPROGRAMSTAGESPROC>::Invoke},
+    {"glUseProgramStagesEXT", &TraceInvoker<PFNGLUSEPROGRAMSTAGESEXTPROC>::Invoke},
+    {"glValidateProgram", &TraceInvoker<PFNGLVALIDATEPROGRAMPROC>::Invoke},
+    {"glValidateProgramPipeline", &TraceInvoker<PFNGLVALIDATEPROGRAMPIPELINEPROC>::Invoke},
+    {"glValidateProgramPipelineEXT", &TraceInvoker<PFNGLVALIDATEPROGRAMPIPELINEEXTPROC>::Invoke},
+    {"glVertexAttrib1f", &TraceInvoker<PFNGLVERTEXATTRIB1FPROC>::Invoke},
+    {"glVertexAttrib1fv", &TraceInvoker<PFNGLVERTEXATTRIB1FVPROC>::Invoke},
+    {"glVertexAttrib2f", &TraceInvoker<PFNGLVERTEXATTRIB2FPROC>::Invoke},
+    {"glVertexAttrib2fv", &TraceInvoker<PFNGLVERTEXATTRIB2FVPROC>::Invoke},
+    {"glVertexAttrib3f", &TraceInvoker<PFNGLVERTEXATTRIB3FPROC>::Invoke},
+    {"glVertexAttrib3fv", &TraceInvoker<PFNGLVERTEXATTRIB3FVPROC>::Invoke},
+    {"glVertexAttrib4f", &TraceInvoker<PFNGLVERTEXATTRIB4FPROC>::Invoke},
+    {"glVertexAttrib4fv", &TraceInvoker<PFNGLVERTEXATTRIB4FVPROC>::Invoke},
+    {"glVertexAttribBinding", &TraceInvoker<PFNGLVERTEXATTRIBBINDINGPROC>::Invoke},
+    {"glVertexAttribDivisor", &TraceInvoker<PFNGLVERTEXATTRIBDIVISORPROC>::Invoke},
+    {"glVertexAttribDivisorANGLE", &TraceInvoker<PFNGLVERTEXATTRIBDIVISORANGLEPROC>::Invoke},
+    {"glVertexAttribDivisorEXT", &TraceInvoker<PFNGLVERTEXATTRIBDIVISOREXTPROC>::Invoke},
+    {"glVertexAttribFormat", &TraceInvoker<PFNGLVERTEXATTRIBFORMATPROC>::Invoke},
+    {"glVertexAttribI4i", &TraceInvoker<PFNGLVERTEXATTRIBI4IPROC>::Invoke},
+    {"glVertexAttribI4iv", &TraceInvoker<PFNGLVERTEXATTRIBI4IVPROC>::Invoke},
+    {"glVertexAttribI4ui", &TraceInvoker<PFNGLVERTEXATTRIBI4UIPROC>::Invoke},
+    {"glVertexAttribI4uiv", &TraceInvoker<PFNGLVERTEXATTRIBI4UIVPROC>::Invoke},
+    {"glVertexAttribIFormat", &TraceInvoker<PFNGLVERTEXATTRIBIFORMATPROC>::Invoke},
+    {"glVertexAttribIPointer", &TraceInvoker<PFNGLVERTEXATTRIBIPOINTERPROC>::Invoke},
+    {"glVertexAttribPointer", &TraceInvoker<PFNGLVERTEXATTRIBPOINTERPROC>::Invoke},
+    {"glVertexBindingDivisor", &TraceInvoker<PFNGLVERTEXBINDINGDIVISORPROC>::Invoke},
+    {"glVertexPointer", &TraceInvoker<PFNGLVERTEXPOINTERPROC>::Invoke},
+    {"glViewport", &TraceInvoker<PFNGLVIEWPORTPROC>::Invoke},
+    {"glWaitSemaphoreEXT", &TraceInvoker<PFNGLWAITSEMAPHOREEXTPROC>::Invoke},
+    {"glWaitSync", &TraceInvoker<PFNGLWAITSYNCPROC>::Invoke},
+    {"glWeightPointerOES", &TraceInvoker<PFNGLWEIGHTPOINTEROESPROC>::Invoke},
+};
+
+bool CompareInvokerName(const TraceInvokerEntry &entry, const char *name)
+{
+    return strcmp(entry.name, name) < 0;
+}
+}  // anonymous namespace
+
+TraceInvokeFunc GetTraceInvokeFunc(const char *functionName)
+{
+    auto iter = std::lower_bound(std::begin(kTraceInvokers), std::end(kTraceInvokers),
+                                 functionName, CompareInvokerName);
+    if (iter == std::end(kTraceInvokers) || strcmp(iter->name, functionName) != 0)
+    {
+        return nullptr;
+    }
+    return iter->invoke;
+}
+}  // namespace angle
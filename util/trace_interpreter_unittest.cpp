@@ -0,0 +1,325 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// trace_interpreter_unittest.cpp:
+//   Writes small binary call streams and checks the trace interpreter replays them into the
+//   expected GL calls, with resource IDs, uniform locations and data remapped.
+//
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "common/frame_capture_binary_writer.h"
+#include "util/test_utils.h"
+#include "util/trace_interpreter.h"
+
+using namespace angle;
+
+namespace
+{
+// Resource namespaces are opaque to the interpreter. FrameCapture uses ResourceIDType.
+constexpr uint8_t kBufferType  = 0;
+constexpr uint8_t kProgramType = 1;
+
+// Captured IDs, which differ from the IDs the fake GL hands out at replay.
+constexpr GLuint kCapturedBuffer  = 7;
+constexpr GLuint kCapturedProgram = 3;
+constexpr GLuint kReplayBuffer    = 100;
+constexpr GLuint kReplayProgram   = 200;
+constexpr GLint kCapturedLocation = 5;
+constexpr GLint kReplayLocation   = 12;
+
+// The calls made by the interpreter, as text.
+std::vector<std::string> gCalls;
+std::vector<uint8_t> gBufferData;
+
+void KHRONOS_APIENTRY FakeGenBuffers(GLsizei n, GLuint *buffers)
+{
+    gCalls.push_back("glGenBuffers");
+    for (GLsizei index = 0; index < n; ++index)
+    {
+        buffers[index] = kReplayBuffer + index;
+    }
+}
+
+void KHRONOS_APIENTRY FakeBindBuffer(GLenum target, GLuint buffer)
+{
+    gCalls.push_back("glBindBuffer " + std::to_string(buffer));
+}
+
+void KHRONOS_APIENTRY FakeBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage)
+{
+    gCalls.push_back("glBufferData " + std::to_string(size));
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    gBufferData.assign(bytes, bytes + size);
+}
+
+GLuint KHRONOS_APIENTRY FakeCreateProgram()
+{
+    gCalls.push_back("glCreateProgram");
+    return kReplayProgram;
+}
+
+void KHRONOS_APIENTRY FakeUseProgram(GLuint program)
+{
+    gCalls.push_back("glUseProgram " + std::to_string(program));
+}
+
+GLint KHRONOS_APIENTRY FakeGetUniformLocation(GLuint program, const GLchar *name)
+{
+    gCalls.push_back("glGetUniformLocation " + std::to_string(program) + " " + name);
+    return kReplayLocation;
+}
+
+void KHRONOS_APIENTRY FakeUniform1f(GLint location, GLfloat value)
+{
+    std::stringstream call;
+    call << "glUniform1f " << location << " " << value;
+    gCalls.push_back(call.str());
+}
+
+void KHRONOS_APIENTRY FakeDrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+    gCalls.push_back("glDrawArrays " + std::to_string(count));
+}
+
+void KHRONOS_APIENTRY FakeDeleteBuffers(GLsizei n, const GLuint *buffers)
+{
+    gCalls.push_back("glDeleteBuffers " + std::to_string(buffers[0]));
+}
+
+GenericProc KHRONOS_APIENTRY FakeLoadProc(const char *procName)
+{
+    static const std::pair<const char *, GenericProc> kProcs[] = {
+        {"glGenBuffers", reinterpret_cast<GenericProc>(FakeGenBuffers)},
+        {"glBindBuffer", reinterpret_cast<GenericProc>(FakeBindBuffer)},
+        {"glBufferData", reinterpret_cast<GenericProc>(FakeBufferData)},
+        {"glCreateProgram", reinterpret_cast<GenericProc>(FakeCreateProgram)},
+        {"glUseProgram", reinterpret_cast<GenericProc>(FakeUseProgram)},
+        {"glGetUniformLocation", reinterpret_cast<GenericProc>(FakeGetUniformLocation)},
+        {"glUniform1f", reinterpret_cast<GenericProc>(FakeUniform1f)},
+        {"glDrawArrays", reinterpret_cast<GenericProc>(FakeDrawArrays)},
+        {"glDeleteBuffers", reinterpret_cast<GenericProc>(FakeDeleteBuffers)},
+    };
+
+    for (const auto &proc : kProcs)
+    {
+        if (strcmp(procName, proc.first) == 0)
+        {
+            return proc.second;
+        }
+    }
+    return nullptr;
+}
+
+void AddValue(BinaryTraceStreamWriter *writer, uint64_t value)
+{
+    writer->addParam(BinaryTraceParamKind::Value, 0, 0, value);
+}
+
+// Binds the captured buffer, fills it with |vertices| and draws with the captured program.
+void WriteDraw(BinaryTraceStreamWriter *writer, const std::vector<float> &vertices, float uniform)
+{
+    AddValue(writer, GL_ARRAY_BUFFER);
+    writer->addParam(BinaryTraceParamKind::ResourceID, kBufferType, 0, kCapturedBuffer);
+    writer->addCall("glBindBuffer", BinaryTraceResultKind::Unused, 0, 0);
+
+    AddValue(writer, GL_ARRAY_BUFFER);
+    AddValue(writer, vertices.size() * sizeof(float));
+    writer->addParam(BinaryTraceParamKind::Data, 0, 0,
+                     writer->appendData(vertices.data(), vertices.size() * sizeof(float)));
+    AddValue(writer, GL_STATIC_DRAW);
+    writer->addCall("glBufferData", BinaryTraceResultKind::Unused, 0, 0);
+
+    writer->addParam(BinaryTraceParamKind::ResourceID, kProgramType, 0, kCapturedProgram);
+    writer->addCall("glUseProgram", BinaryTraceResultKind::Unused, 0, 0);
+    writer->addParam(BinaryTraceParamKind::ResourceID, kProgramType, 0, kCapturedProgram);
+    writer->addCall(kBinaryTraceUpdateCurrentProgram, BinaryTraceResultKind::Unused, 0, 0);
+
+    // A location of the current program.
+    writer->addParam(BinaryTraceParamKind::UniformLocation, kProgramType, 0, kCapturedLocation);
+    AddValue(writer, ToTraceSlot(uniform));
+    writer->addCall("glUniform1f", BinaryTraceResultKind::Unused, 0, 0);
+
+    AddValue(writer, GL_TRIANGLES);
+    AddValue(writer, 0);
+    AddValue(writer, vertices.size() / 2);
+    writer->addCall("glDrawArrays", BinaryTraceResultKind::Unused, 0, 0);
+}
+
+void WriteSetup(BinaryTraceStreamWriter *writer)
+{
+    writer->beginSection(BinaryTraceSection::Setup);
+
+    // Generated IDs are read back from the read buffer, as in a compiled replay.
+    AddValue(writer, 1);
+    writer->addParam(BinaryTraceParamKind::ReadBuffer, 0, sizeof(GLuint), 0);
+    writer->addCall("glGenBuffers", BinaryTraceResultKind::Unused, 0, 0);
+    AddValue(writer, kBufferType);
+    AddValue(writer, kCapturedBuffer);
+    AddValue(writer, 0);
+    writer->addCall(kBinaryTraceUpdateResourceID, BinaryTraceResultKind::Unused, 0, 0);
+
+    writer->addCall("glCreateProgram", BinaryTraceResultKind::ResourceID, kProgramType,
+                    kCapturedProgram);
+
+    constexpr char kUniformName[] = "uColor";
+    writer->addParam(BinaryTraceParamKind::ResourceID, kProgramType, 0, kCapturedProgram);
+    writer->addParam(BinaryTraceParamKind::Data, 0, 0,
+                     writer->appendData(kUniformName, sizeof(kUniformName)));
+    AddValue(writer, kCapturedLocation);
+    writer->addCall(kBinaryTraceUpdateUniformLocation, BinaryTraceResultKind::Unused, 0, 0);
+
+    writer->endSection(BinaryTraceSection::Setup);
+}
+
+void WriteReset(BinaryTraceStreamWriter *writer)
+{
+    writer->beginSection(BinaryTraceSection::Reset);
+    AddValue(writer, 1);
+    writer->addParam(BinaryTraceParamKind::ResourceIDArray, kBufferType, 1,
+                     writer->appendData(&kCapturedBuffer, sizeof(kCapturedBuffer)));
+    writer->addCall("glDeleteBuffers", BinaryTraceResultKind::Unused, 0, 0);
+    writer->endSection(BinaryTraceSection::Reset);
+}
+
+bool WriteFile(const std::string &path, const void *data, size_t size)
+{
+    FILE *fp = fopen(path.c_str(), "wb");
+    if (!fp)
+    {
+        return false;
+    }
+    bool success = fwrite(data, 1, size, fp) == size;
+    fclose(fp);
+    return success;
+}
+
+class TraceInterpreterTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        gCalls.clear();
+        gBufferData.clear();
+
+        char tempFileName[512];
+        ASSERT_TRUE(CreateTemporaryFile(tempFileName, sizeof(tempFileName)));
+        mPrefix = tempFileName;
+    }
+
+    void TearDown() override
+    {
+        for (const std::string &path : mWrittenFiles)
+        {
+            DeleteFile(path.c_str());
+        }
+        DeleteFile(mPrefix.c_str());
+    }
+
+    std::string writeTrace(const std::vector<std::vector<uint8_t>> &streams)
+    {
+        BinaryTraceIndex index = {};
+        index.magic            = kBinaryTraceIndexMagic;
+        index.version          = kBinaryTraceVersion;
+        index.frameStart       = 1;
+        index.frameEnd         = static_cast<uint32_t>(streams.size());
+
+        std::string indexPath = mPrefix + kBinaryTraceIndexExtension;
+        EXPECT_TRUE(WriteFile(indexPath, &index, sizeof(index)));
+        mWrittenFiles.push_back(indexPath);
+
+        for (size_t frame = 0; frame < streams.size(); ++frame)
+        {
+            char frameSuffix[32];
+            snprintf(frameSuffix, sizeof(frameSuffix), "_frame%03u",
+                     static_cast<unsigned>(frame + 1));
+            std::string streamPath = mPrefix + frameSuffix + kBinaryTraceStreamExtension;
+            EXPECT_TRUE(WriteFile(streamPath, streams[frame].data(), streams[frame].size()));
+            mWrittenFiles.push_back(streamPath);
+        }
+
+        return indexPath;
+    }
+
+    std::string mPrefix;
+    std::vector<std::string> mWrittenFiles;
+};
+
+// Tests a two frame trace replays with its setup and reset calls and remapped IDs.
+TEST_F(TraceInterpreterTest, WriteAndReplay)
+{
+    const std::vector<float> triangle = {-1.0f, -1.0f, 1.0f, -1.0f, 0.0f, 1.0f};
+    const std::vector<float> quad     = {-1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f};
+
+    std::vector<std::vector<uint8_t>> streams(2);
+
+    BinaryTraceStreamWriter frame1;
+    WriteSetup(&frame1);
+    frame1.beginSection(BinaryTraceSection::Frame);
+    WriteDraw(&frame1, triangle, 0.5f);
+    frame1.endSection(BinaryTraceSection::Frame);
+    frame1.serialize(1, &streams[0]);
+
+    BinaryTraceStreamWriter frame2;
+    frame2.beginSection(BinaryTraceSection::Frame);
+    WriteDraw(&frame2, quad, 0.25f);
+    frame2.endSection(BinaryTraceSection::Frame);
+    WriteReset(&frame2);
+    frame2.serialize(2, &streams[1]);
+
+    TraceInterpreter interpreter;
+    ASSERT_TRUE(interpreter.load(writeTrace(streams), FakeLoadProc, nullptr));
+    EXPECT_EQ(1u, interpreter.getFrameStart());
+    EXPECT_EQ(2u, interpreter.getFrameEnd());
+
+    interpreter.setupReplay();
+    const std::vector<std::string> kExpectedSetup = {
+        "glGenBuffers",
+        "glCreateProgram",
+        "glGetUniformLocation 200 uColor",
+    };
+    EXPECT_EQ(kExpectedSetup, gCalls);
+
+    gCalls.clear();
+    interpreter.replayFrame(1);
+    const std::vector<std::string> kExpectedFrame1 = {
+        "glBindBuffer 100", "glBufferData 24", "glUseProgram 200", "glUniform1f 12 0.5",
+        "glDrawArrays 3",
+    };
+    EXPECT_EQ(kExpectedFrame1, gCalls);
+    EXPECT_EQ(0, memcmp(triangle.data(), gBufferData.data(), gBufferData.size()));
+
+    gCalls.clear();
+    interpreter.replayFrame(2);
+    const std::vector<std::string> kExpectedFrame2 = {
+        "glBindBuffer 100", "glBufferData 32", "glUseProgram 200", "glUniform1f 12 0.25",
+        "glDrawArrays 4",
+    };
+    EXPECT_EQ(kExpectedFrame2, gCalls);
+    EXPECT_EQ(0, memcmp(quad.data(), gBufferData.data(), gBufferData.size()));
+
+    gCalls.clear();
+    interpreter.resetReplay();
+    const std::vector<std::string> kExpectedReset = {"glDeleteBuffers 100"};
+    EXPECT_EQ(kExpectedReset, gCalls);
+}
+
+// Tests a stream that calls an entry point the interpreter can't resolve fails to load.
+TEST_F(TraceInterpreterTest, UnknownFunctionFailsToLoad)
+{
+    std::vector<std::vector<uint8_t>> streams(1);
+
+    BinaryTraceStreamWriter writer;
+    writer.beginSection(BinaryTraceSection::Frame);
+    writer.addCall("glNotAnEntryPoint", BinaryTraceResultKind::Unused, 0, 0);
+    writer.endSection(BinaryTraceSection::Frame);
+    writer.serialize(1, &streams[0]);
+
+    TraceInterpreter interpreter;
+    EXPECT_FALSE(interpreter.load(writeTrace(streams), FakeLoadProc, nullptr));
+}
+}  // anonymous namespace